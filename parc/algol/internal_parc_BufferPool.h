@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file internal_parc_BufferPool.h
+ * @ingroup memory
+ * @brief The link between a PARCBuffer and the PARCBufferPool that handed it out.
+ *
+ * A buffer from a pool records its pool and class.
+ * When the last reference to it is released, its destructor offers it back to the pool,
+ * which either keeps it or lets it be deallocated as usual.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_internal_parc_BufferPool_h
+#define libparc_internal_parc_BufferPool_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_BufferPool.h>
+
+/**
+ * Record the pool, and the index of the class within it, to which a buffer returns when it is released.
+ *
+ * @param [in] buffer A pointer to a valid `PARCBuffer` instance.
+ * @param [in] pool The owning `PARCBufferPool`, or NULL if the buffer is deallocated as usual.
+ * @param [in] classIndex The index of the buffer's class in @p pool.
+ *
+ * Example:
+ * @code
+ * {
+ *     internal_parcBuffer_SetPool(buffer, pool, 0);
+ * }
+ * @endcode
+ */
+void internal_parcBuffer_SetPool(PARCBuffer *buffer, PARCBufferPool *pool, size_t classIndex);
+
+/**
+ * Offer a released buffer back to the pool that handed it out.
+ *
+ * The buffer has been resurrected with a single reference.
+ * If the pool keeps it, that reference belongs to the pool;
+ * otherwise the buffer is no longer linked to the pool and the caller deallocates it.
+ *
+ * @param [in] pool The `PARCBufferPool` recorded in the buffer.
+ * @param [in] classIndex The index of the buffer's class in @p pool.
+ * @param [in] buffer A pointer to the released `PARCBuffer` instance.
+ *
+ * @return true The pool kept the buffer.
+ * @return false The buffer must be deallocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (internal_parcBufferPool_Recycle(pool, classIndex, parcObject_Resurrect(buffer))) {
+ *         return false;
+ *     }
+ * }
+ * @endcode
+ */
+bool internal_parcBufferPool_Recycle(PARCBufferPool *pool, size_t classIndex, PARCBuffer *buffer);
+#endif // libparc_internal_parc_BufferPool_h
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <parc/algol/parc_ArenaMemory.h>
+#include <parc/algol/parc_Object.h>
+
+/**
+ * Every allocation is preceded by this prefix.
+ */
+typedef struct {
+    size_t length;          // The length of the allocation, as requested.
+    uint64_t tag;           // _parcArenaMemory_Tag, which distinguishes arena memory from the underlying provider's.
+} _PARCArenaMemoryPrefix;
+
+static const uint64_t _parcArenaMemory_Tag = 0xA7E4A7E4A7E4A7E4ULL;
+
+#define _parcArenaMemory_MinimumAlignment 16
+
+typedef struct parc_arena_memory_chunk {
+    struct parc_arena_memory_chunk *next;
+    size_t length;          // The number of bytes following the chunk header.
+} _PARCArenaMemoryChunk;
+
+// The usable memory of a chunk begins at this offset, so that it is aligned on 16 bytes.
+#define _parcArenaMemory_ChunkHeaderLength \
+    ((sizeof(_PARCArenaMemoryChunk) + _parcArenaMemory_MinimumAlignment - 1) & ~(size_t) (_parcArenaMemory_MinimumAlignment - 1))
+
+struct parc_arena_memory {
+    size_t chunkLength;
+
+    _PARCArenaMemoryChunk *chunks;          // All of the regular chunks, which are kept when the arena is reset.
+    _PARCArenaMemoryChunk *current;         // The chunk being allocated from.
+    size_t offset;                          // The offset of the first free byte in the current chunk.
+    size_t lastOffset;                      // The offset in the current chunk at which the most recent allocation began.
+    _PARCArenaMemoryChunk *large;           // Allocations larger than a chunk, which are freed when the arena is reset.
+
+    size_t usage;
+    size_t peakUsage;
+    size_t capacity;                        // The length of the regular chunks.
+    size_t largeCapacity;                   // The length of the large allocations.
+
+    bool pushed;
+    PARCArenaMemory *below;                         // The arena that was current when this one was pushed.
+    const PARCMemoryInterface *underlying;          // The provider of memory that was not allocated from an arena.
+    const PARCMemoryInterface *threadInterface;     // The calling thread's provider before the first arena was pushed.
+};
+
+static pthread_once_t _parcArenaMemory_Once = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcArenaMemory_CurrentKey;
+
+static void
+_parcArenaMemory_InitOnce(void)
+{
+    pthread_key_create(&_parcArenaMemory_CurrentKey, NULL);
+}
+
+static inline char *
+_chunk_Memory(const _PARCArenaMemoryChunk *chunk)
+{
+    return &((char *) chunk)[_parcArenaMemory_ChunkHeaderLength];
+}
+
+static _PARCArenaMemoryChunk *
+_chunk_Create(size_t length)
+{
+    _PARCArenaMemoryChunk *result = malloc(_parcArenaMemory_ChunkHeaderLength + length);
+    if (result != NULL) {
+        result->next = NULL;
+        result->length = length;
+    }
+    return result;
+}
+
+static void
+_chunk_FreeAll(_PARCArenaMemoryChunk *chunk)
+{
+    while (chunk != NULL) {
+        _PARCArenaMemoryChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+static inline _PARCArenaMemoryPrefix *
+_prefix(const void *memory)
+{
+    return (_PARCArenaMemoryPrefix *) &((char *) memory)[-sizeof(_PARCArenaMemoryPrefix)];
+}
+
+static inline bool
+_isArenaMemory(const void *memory)
+{
+    return _prefix(memory)->tag == _parcArenaMemory_Tag;
+}
+
+/**
+ * The offset, in the memory of @p chunk, of an allocation aligned on @p alignment that begins with a prefix at @p offset.
+ */
+static inline size_t
+_alignedOffset(const _PARCArenaMemoryChunk *chunk, size_t offset, size_t alignment)
+{
+    uintptr_t memory = (uintptr_t) _chunk_Memory(chunk);
+    return ((memory + offset + sizeof(_PARCArenaMemoryPrefix) + alignment - 1) & ~(uintptr_t) (alignment - 1)) - memory;
+}
+
+static void
+_arena_AddUsage(PARCArenaMemory *arena, size_t length)
+{
+    arena->usage += length;
+    if (arena->usage > arena->peakUsage) {
+        arena->peakUsage = arena->usage;
+    }
+}
+
+static void *
+_arena_AllocateLarge(PARCArenaMemory *arena, size_t alignment, size_t size)
+{
+    size_t length = alignment + sizeof(_PARCArenaMemoryPrefix) + size;
+    _PARCArenaMemoryChunk *chunk = _chunk_Create(length);
+    if (chunk == NULL) {
+        return NULL;
+    }
+    chunk->next = arena->large;
+    arena->large = chunk;
+    arena->largeCapacity += length;
+
+    _arena_AddUsage(arena, length);
+    return &_chunk_Memory(chunk)[_alignedOffset(chunk, 0, alignment)];
+}
+
+static void *
+_arena_Allocate(PARCArenaMemory *arena, size_t alignment, size_t size)
+{
+    if (alignment < _parcArenaMemory_MinimumAlignment) {
+        alignment = _parcArenaMemory_MinimumAlignment;
+    }
+
+    char *result;
+    if (alignment + sizeof(_PARCArenaMemoryPrefix) + size > arena->chunkLength) {
+        result = _arena_AllocateLarge(arena, alignment, size);
+    } else {
+        size_t start = (arena->current == NULL) ? 0 : _alignedOffset(arena->current, arena->offset, alignment);
+        while (arena->current == NULL || start + size > arena->current->length) {
+            _PARCArenaMemoryChunk *next = (arena->current == NULL) ? arena->chunks : arena->current->next;
+            if (next == NULL) {
+                next = _chunk_Create(arena->chunkLength);
+                if (next == NULL) {
+                    return NULL;
+                }
+                arena->capacity += arena->chunkLength;
+                if (arena->current == NULL) {
+                    arena->chunks = next;
+                } else {
+                    arena->current->next = next;
+                }
+            }
+            arena->current = next;
+            arena->offset = 0;
+            start = _alignedOffset(next, 0, alignment);
+        }
+
+        _arena_AddUsage(arena, start + size - arena->offset);
+        arena->lastOffset = arena->offset;
+        arena->offset = start + size;
+        result = &_chunk_Memory(arena->current)[start];
+    }
+
+    if (result != NULL) {
+        _PARCArenaMemoryPrefix *prefix = _prefix(result);
+        prefix->length = size;
+        prefix->tag = _parcArenaMemory_Tag;
+    }
+    return result;
+}
+
+/**
+ * Determine if @p memory is the most recent allocation in the current chunk of the arena.
+ */
+static inline bool
+_arena_IsLast(const PARCArenaMemory *arena, const void *memory)
+{
+    return arena->current != NULL
+           && (char *) memory + _prefix(memory)->length == &_chunk_Memory(arena->current)[arena->offset];
+}
+
+static void
+_parcArenaMemory_Destroy(PARCArenaMemory **arenaPtr)
+{
+    PARCArenaMemory *arena = *arenaPtr;
+
+    trapIllegalValueIf(arena->pushed, "PARCArenaMemory@%p is released while it is pushed.", (void *) arena);
+
+    _chunk_FreeAll(arena->chunks);
+    _chunk_FreeAll(arena->large);
+}
+
+parcObject_ExtendPARCObject(PARCArenaMemory, _parcArenaMemory_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(parcArenaMemory, PARCArenaMemory);
+
+parcObject_ImplementRelease(parcArenaMemory, PARCArenaMemory);
+
+PARCArenaMemory *
+parcArenaMemory_Create(size_t chunkLength)
+{
+    PARCArenaMemory *result = parcObject_CreateAndClearInstance(PARCArenaMemory);
+    if (result != NULL) {
+        result->chunkLength = (chunkLength == 0) ? parcArenaMemory_DefaultChunkLength : chunkLength;
+    }
+    return result;
+}
+
+void
+parcArenaMemory_Reset(PARCArenaMemory *arena)
+{
+    _chunk_FreeAll(arena->large);
+    arena->large = NULL;
+    arena->largeCapacity = 0;
+
+    arena->current = NULL;
+    arena->offset = 0;
+    arena->lastOffset = 0;
+    arena->usage = 0;
+}
+
+void
+parcArenaMemory_Push(PARCArenaMemory *arena)
+{
+    trapIllegalValueIf(arena->pushed, "PARCArenaMemory@%p is already pushed.", (void *) arena);
+
+    pthread_once(&_parcArenaMemory_Once, _parcArenaMemory_InitOnce);
+
+    PARCArenaMemory *below = pthread_getspecific(_parcArenaMemory_CurrentKey);
+
+    arena->pushed = true;
+    arena->below = below;
+    if (below == NULL) {
+        arena->threadInterface = parcMemory_SetThreadInterface(&PARCArenaMemoryAsPARCMemory);
+        arena->underlying = (arena->threadInterface != NULL) ? arena->threadInterface : parcMemory_GetInterface();
+    } else {
+        arena->threadInterface = NULL;
+        arena->underlying = below->underlying;
+    }
+
+    pthread_setspecific(_parcArenaMemory_CurrentKey, parcArenaMemory_Acquire(arena));
+}
+
+void
+parcArenaMemory_Pop(void)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Current();
+    trapIllegalValueIf(arena == NULL, "parcArenaMemory_Pop without an arena pushed by this thread.");
+
+    pthread_setspecific(_parcArenaMemory_CurrentKey, arena->below);
+    if (arena->below == NULL) {
+        parcMemory_SetThreadInterface(arena->threadInterface);
+    }
+
+    arena->pushed = false;
+    arena->below = NULL;
+    arena->underlying = NULL;
+    arena->threadInterface = NULL;
+
+    parcArenaMemory_Release(&arena);
+}
+
+PARCArenaMemory *
+parcArenaMemory_Current(void)
+{
+    pthread_once(&_parcArenaMemory_Once, _parcArenaMemory_InitOnce);
+
+    return pthread_getspecific(_parcArenaMemory_CurrentKey);
+}
+
+size_t
+parcArenaMemory_GetUsage(const PARCArenaMemory *arena)
+{
+    return arena->usage;
+}
+
+size_t
+parcArenaMemory_GetPeakUsage(const PARCArenaMemory *arena)
+{
+    return arena->peakUsage;
+}
+
+size_t
+parcArenaMemory_GetCapacity(const PARCArenaMemory *arena)
+{
+    return arena->capacity + arena->largeCapacity;
+}
+
+// The provider functions are only called after parcArenaMemory_Push has created the key.
+static inline PARCArenaMemory *
+_parcArenaMemory_Current(void)
+{
+    PARCArenaMemory *result = pthread_getspecific(_parcArenaMemory_CurrentKey);
+    trapUnexpectedStateIf(result == NULL, "PARCArenaMemoryAsPARCMemory is used by a thread without an arena pushed.");
+    return result;
+}
+
+void *
+parcArenaMemory_Allocate(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    return _arena_Allocate(_parcArenaMemory_Current(), _parcArenaMemory_MinimumAlignment, size);
+}
+
+void *
+parcArenaMemory_AllocateAndClear(size_t size)
+{
+    void *pointer = parcArenaMemory_Allocate(size);
+    if (pointer != NULL) {
+        memset(pointer, 0, size);
+    }
+    return pointer;
+}
+
+int
+parcArenaMemory_MemAlign(void **pointer, size_t alignment, size_t size)
+{
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    if (size == 0) {
+        return EINVAL;
+    }
+
+    *pointer = _arena_Allocate(_parcArenaMemory_Current(), alignment, size);
+    return (*pointer == NULL) ? ENOMEM : 0;
+}
+
+void
+parcArenaMemory_Deallocate(void **pointer)
+{
+    PARCArenaMemory *arena = _parcArenaMemory_Current();
+
+    void *memory = *pointer;
+    if (memory != NULL && _isArenaMemory(memory) == false) {
+        ((PARCMemoryDeallocate *) arena->underlying->Deallocate)(pointer);
+        return;
+    }
+
+    // Give back the most recent allocation, which is common for temporary buffers.
+    if (memory != NULL && _arena_IsLast(arena, memory)) {
+        arena->usage -= arena->offset - arena->lastOffset;
+        arena->offset = arena->lastOffset;
+    }
+    *pointer = NULL;
+}
+
+bool
+parcArenaMemory_ReallocateInPlace(void *pointer, size_t newSize)
+{
+    PARCArenaMemory *arena = _parcArenaMemory_Current();
+
+    if (_isArenaMemory(pointer) == false) {
+        PARCMemoryReallocateInPlace *reallocateInPlace = (PARCMemoryReallocateInPlace *) arena->underlying->ReallocateInPlace;
+        return reallocateInPlace != NULL && reallocateInPlace(pointer, newSize);
+    }
+
+    _PARCArenaMemoryPrefix *prefix = _prefix(pointer);
+
+    // Only the most recent allocation has room after it.
+    if (_arena_IsLast(arena, pointer)) {
+        size_t start = (char *) pointer - _chunk_Memory(arena->current);
+        if (start + newSize <= arena->current->length) {
+            arena->usage = arena->usage - prefix->length + newSize;
+            if (arena->usage > arena->peakUsage) {
+                arena->peakUsage = arena->usage;
+            }
+            arena->offset = start + newSize;
+            prefix->length = newSize;
+            return true;
+        }
+        return false;
+    }
+    return newSize <= prefix->length;
+}
+
+void *
+parcArenaMemory_Reallocate(void *pointer, size_t newSize)
+{
+    PARCArenaMemory *arena = _parcArenaMemory_Current();
+
+    if (pointer == NULL) {
+        return parcArenaMemory_Allocate(newSize);
+    }
+    if (_isArenaMemory(pointer) == false) {
+        return ((PARCMemoryReallocate *) arena->underlying->Reallocate)(pointer, newSize);
+    }
+    if (newSize == 0) {
+        newSize = 1;
+    }
+
+    if (parcArenaMemory_ReallocateInPlace(pointer, newSize)) {
+        return pointer;
+    }
+
+    size_t length = _prefix(pointer)->length;
+    void *result = parcArenaMemory_Allocate(newSize);
+    if (result != NULL) {
+        memcpy(result, pointer, (length < newSize) ? length : newSize);
+    }
+    return result;
+}
+
+size_t
+parcArenaMemory_GoodSize(size_t size)
+{
+    return (size + _parcArenaMemory_MinimumAlignment - 1) & ~((size_t) _parcArenaMemory_MinimumAlignment - 1);
+}
+
+size_t
+parcArenaMemory_UsableSize(const void *pointer)
+{
+    if (_isArenaMemory(pointer) == false) {
+        PARCMemoryUsableSize *usableSize = (PARCMemoryUsableSize *) _parcArenaMemory_Current()->underlying->UsableSize;
+        return (usableSize != NULL) ? usableSize(pointer) : 0;
+    }
+    return _prefix(pointer)->length;
+}
+
+char *
+parcArenaMemory_StringDuplicate(const char *string, size_t length)
+{
+    size_t actualLength = strnlen(string, length);
+
+    char *result = parcArenaMemory_Allocate(actualLength + 1);
+    if (result != NULL) {
+        memcpy(result, string, actualLength);
+        result[actualLength] = 0;
+    }
+    return result;
+}
+
+uint32_t
+parcArenaMemory_Outstanding(void)
+{
+    return ((PARCMemoryOutstanding *) _parcArenaMemory_Current()->underlying->Outstanding)();
+}
+
+PARCMemoryInterface PARCArenaMemoryAsPARCMemory = {
+    .Allocate          = (uintptr_t) parcArenaMemory_Allocate,
+    .AllocateAndClear  = (uintptr_t) parcArenaMemory_AllocateAndClear,
+    .MemAlign          = (uintptr_t) parcArenaMemory_MemAlign,
+    .Deallocate        = (uintptr_t) parcArenaMemory_Deallocate,
+    .Reallocate        = (uintptr_t) parcArenaMemory_Reallocate,
+    .StringDuplicate   = (uintptr_t) parcArenaMemory_StringDuplicate,
+    .Outstanding       = (uintptr_t) parcArenaMemory_Outstanding,
+    .GoodSize          = (uintptr_t) parcArenaMemory_GoodSize,
+    .ReallocateInPlace = (uintptr_t) parcArenaMemory_ReallocateInPlace,
+    .UsableSize        = (uintptr_t) parcArenaMemory_UsableSize
+};
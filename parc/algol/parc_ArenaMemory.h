@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_ArenaMemory.h
+ * @ingroup memory
+ * @brief A PARCMemoryInterface provider that allocates from a region of memory that is reset all at once.
+ *
+ * A `PARCArenaMemory` allocates by advancing a pointer through chunks of memory that it obtains from the C library.
+ * Deallocating memory that it allocated does nothing, except that the most recent allocation is given back.
+ * `parcArenaMemory_Reset` makes all of its memory available again in constant time,
+ * apart from freeing allocations that were too large for a chunk.
+ *
+ * An arena is used by pushing it as the memory provider of the calling thread with `parcArenaMemory_Push`,
+ * so that existing code that uses `parcMemory_Allocate` and its siblings allocates from the arena unchanged,
+ * until `parcArenaMemory_Pop`.
+ * Memory that was allocated by the provider underneath, and is deallocated or reallocated while the arena is pushed,
+ * is passed through to that provider.
+ *
+ * Memory allocated from an arena must not be used after the arena is reset or released,
+ * and must not be deallocated after the arena is popped. Typically the objects created while the arena is pushed
+ * are released before it is popped, or they are abandoned and the arena is reset.
+ * Object pools and `PARCBufferPool` neither hand out nor keep memory while an arena is pushed,
+ * so pooling may be enabled with `parcObjectPool_SetEnabled` while arenas are in use.
+ * The library's own bookkeeping (object statistics, the object pool and reclaimer per-thread state, and object locking state)
+ * is allocated with malloc(3), never from an arena, because it outlives the arena and is freed at thread exit or on other threads.
+ *
+ * An arena may be pushed on only one thread at a time, and only once.
+ * Create arenas while no arena is pushed, so that an arena is not itself allocated from another arena.
+ *
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Create(0);
+ *
+ *     while (...) {
+ *         parcArenaMemory_Push(arena);
+ *         handleRequest(request);
+ *         parcArenaMemory_Pop();
+ *         parcArenaMemory_Reset(arena);
+ *     }
+ *
+ *     parcArenaMemory_Release(&arena);
+ * }
+ * @endcode
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ArenaMemory_h
+#define libparc_parc_ArenaMemory_h
+
+#include <parc/algol/parc_Memory.h>
+
+struct parc_arena_memory;
+typedef struct parc_arena_memory PARCArenaMemory;
+
+extern PARCMemoryInterface PARCArenaMemoryAsPARCMemory;
+
+/**
+ * The length, in bytes, of the chunks of an arena created with a chunk length of 0.
+ */
+#define parcArenaMemory_DefaultChunkLength 65536
+
+/**
+ * Create a `PARCArenaMemory` instance.
+ *
+ * The instance itself is allocated by the current `parcMemory` provider, but its chunks are allocated from the C library.
+ *
+ * @param [in] chunkLength The length, in bytes, of each chunk of memory, or 0 for `parcArenaMemory_DefaultChunkLength`.
+ *
+ * @return non-NULL A pointer to a valid `PARCArenaMemory` instance.
+ * @return NULL Memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Create(0);
+ *
+ *     parcArenaMemory_Release(&arena);
+ * }
+ * @endcode
+ */
+PARCArenaMemory *parcArenaMemory_Create(size_t chunkLength);
+
+/**
+ * Increase the number of references to a `PARCArenaMemory` instance.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory` instance.
+ *
+ * @return The same value as @p arena.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Create(0);
+ *     PARCArenaMemory *reference = parcArenaMemory_Acquire(arena);
+ *
+ *     parcArenaMemory_Release(&arena);
+ *     parcArenaMemory_Release(&reference);
+ * }
+ * @endcode
+ */
+PARCArenaMemory *parcArenaMemory_Acquire(const PARCArenaMemory *arena);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * When the last reference is released, all of the memory of the arena is returned to the C library.
+ *
+ * @param [in,out] arenaPtr A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Create(0);
+ *
+ *     parcArenaMemory_Release(&arena);
+ * }
+ * @endcode
+ */
+void parcArenaMemory_Release(PARCArenaMemory **arenaPtr);
+
+/**
+ * Make all of the memory of the given arena available for allocation again.
+ *
+ * Allocations larger than a chunk are returned to the C library, all other chunks are kept for reuse.
+ * The peak usage of the arena is not reset.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcArenaMemory_Push(arena);
+ *     handleRequest(request);
+ *     parcArenaMemory_Pop();
+ *
+ *     parcArenaMemory_Reset(arena);
+ * }
+ * @endcode
+ */
+void parcArenaMemory_Reset(PARCArenaMemory *arena);
+
+/**
+ * Make the given arena the memory provider of the calling thread.
+ *
+ * Pushes nest: `parcArenaMemory_Pop` restores the provider that was in effect before the push,
+ * whether it was another arena or not.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory` instance that is not pushed.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcArenaMemory_Push(arena);
+ *     PARCBufferComposer *composer = parcBufferComposer_Create();
+ *     ...
+ *     parcArenaMemory_Pop();
+ * }
+ * @endcode
+ *
+ * @see parcArenaMemory_Pop
+ */
+void parcArenaMemory_Push(PARCArenaMemory *arena);
+
+/**
+ * Restore the memory provider of the calling thread that was in effect before the last `parcArenaMemory_Push`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcArenaMemory_Push(arena);
+ *     ...
+ *     parcArenaMemory_Pop();
+ * }
+ * @endcode
+ *
+ * @see parcArenaMemory_Push
+ */
+void parcArenaMemory_Pop(void);
+
+/**
+ * Get the arena that was most recently pushed by the calling thread.
+ *
+ * @return NULL The calling thread has no arena pushed.
+ * @return non-NULL A pointer to the current `PARCArenaMemory` instance of the calling thread.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCArenaMemory *arena = parcArenaMemory_Current();
+ * }
+ * @endcode
+ */
+PARCArenaMemory *parcArenaMemory_Current(void);
+
+/**
+ * Get the number of bytes allocated from the given arena since it was created or last reset,
+ * including the space used to align and to describe each allocation.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory` instance.
+ *
+ * @return The number of bytes in use.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t usage = parcArenaMemory_GetUsage(arena);
+ * }
+ * @endcode
+ */
+size_t parcArenaMemory_GetUsage(const PARCArenaMemory *arena);
+
+/**
+ * Get the largest number of bytes that were in use in the given arena since it was created.
+ *
+ * Use this to choose a chunk length that holds the memory used between resets.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory` instance.
+ *
+ * @return The peak number of bytes in use.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t peak = parcArenaMemory_GetPeakUsage(arena);
+ * }
+ * @endcode
+ */
+size_t parcArenaMemory_GetPeakUsage(const PARCArenaMemory *arena);
+
+/**
+ * Get the number of bytes of memory that the given arena holds from the C library.
+ *
+ * @param [in] arena A pointer to a valid `PARCArenaMemory` instance.
+ *
+ * @return The number of bytes of all of the arena's chunks.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t capacity = parcArenaMemory_GetCapacity(arena);
+ * }
+ * @endcode
+ */
+size_t parcArenaMemory_GetCapacity(const PARCArenaMemory *arena);
+
+/**
+ * Allocate memory from the current arena of the calling thread.
+ *
+ * @param [in] size The size of memory to allocate
+ *
+ * @return A pointer to the allocated memory, aligned on 16 bytes.
+ */
+void *parcArenaMemory_Allocate(size_t size);
+
+/**
+ * Allocate memory from the current arena of the calling thread and clear it.
+ *
+ * @param [in] size Size of memory to allocate
+ *
+ * @return A pointer to the allocated memory
+ */
+void *parcArenaMemory_AllocateAndClear(size_t size);
+
+/**
+ * Allocate aligned memory from the current arena of the calling thread.
+ *
+ * @param [out] pointer A pointer to a `void *` pointer that will be set to the address of the allocated memory.
+ * @param [in] alignment A power of 2 greater than or equal to `sizeof(void *)`
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return 0 Successful
+ * @return EINVAL The alignment parameter is not a power of 2 at least as large as sizeof(void *)
+ * @return ENOMEM Memory allocation error.
+ */
+int parcArenaMemory_MemAlign(void **pointer, size_t alignment, size_t size);
+
+/**
+ * Deallocate the memory pointed to by @p pointer
+ *
+ * If the memory was allocated from an arena, this does nothing unless it was the most recent allocation of the current arena.
+ * Otherwise the memory is deallocated by the provider underneath the current arena.
+ *
+ * @param [in,out] pointer A pointer to a pointer to the memory to be deallocated
+ */
+void parcArenaMemory_Deallocate(void **pointer);
+
+/**
+ * Resize previously allocated memory at @p pointer to @p newSize.
+ *
+ * The most recent allocation of the current arena is resized in place if there is room.
+ *
+ * @param [in,out] pointer A pointer to the memory to be reallocated.
+ * @param [in] newSize The size that the memory to be resized to.
+ *
+ * @return A pointer to the memory
+ */
+void *parcArenaMemory_Reallocate(void *pointer, size_t newSize);
+
+/**
+ * Try to resize previously allocated memory at @p pointer to @p newSize without moving it.
+ *
+ * The most recent allocation of the current arena can grow while its chunk has room, and any allocation can shrink.
+ * Memory not allocated from an arena is resized by the provider underneath the current arena, if it can.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ * @param [in] newSize The size that the memory to be resized to.
+ *
+ * @return true The memory now holds at least @p newSize bytes.
+ * @return false The memory is unchanged.
+ */
+bool parcArenaMemory_ReallocateInPlace(void *pointer, size_t newSize);
+
+/**
+ * Return @p size rounded up to the alignment of arena allocations, which would otherwise be wasted.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return The number of bytes to allocate without waste.
+ */
+size_t parcArenaMemory_GoodSize(size_t size);
+
+/**
+ * Return the number of bytes that the allocation pointed to by @p pointer holds.
+ *
+ * Memory not allocated from an arena is measured by the provider underneath the current arena, if it can.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ *
+ * @return The number of bytes of the allocation, or 0 if it cannot be measured.
+ */
+size_t parcArenaMemory_UsableSize(const void *pointer);
+
+/**
+ * Allocate a copy of at most @p length characters of the string @p string from the current arena.
+ *
+ * The copied string is always null-terminated.
+ *
+ * @param [in] string A pointer to a null-terminated string.
+ * @param [in] length  The maximum allowed length of the resulting copy.
+ *
+ * @return non-NULL A pointer to allocated memory.
+ * @return NULL A an error occurred.
+ */
+char *parcArenaMemory_StringDuplicate(const char *string, size_t length);
+
+/**
+ * Return the number of outstanding allocations of the provider underneath the current arena.
+ *
+ * Memory allocated from an arena is never outstanding, because it is reclaimed by `parcArenaMemory_Reset`.
+ *
+ * @return The number of outstanding allocations of the underlying provider.
+ */
+uint32_t parcArenaMemory_Outstanding(void);
+#endif // libparc_parc_ArenaMemory_h
@@ -84,12 +84,19 @@ _remaining(const PARCArrayList *array)
 static PARCArrayList *
 _ensureCapacity(PARCArrayList *array, size_t newCapacity)
 {
-    void *newArray = parcMemory_Reallocate(array->array, newCapacity * sizeof(void *));
+    // Use all of the memory that the allocator would provide anyway.
+    size_t length = parcMemory_GoodSize(newCapacity * sizeof(void *));
+    newCapacity = length / sizeof(void *);
+    length = newCapacity * sizeof(void *);
 
-    if (newArray == NULL) {
-        return NULL;
+    if (parcMemory_ReallocateInPlace(array->array, length) == false) {
+        void *newArray = parcMemory_Reallocate(array->array, length);
+
+        if (newArray == NULL) {
+            return NULL;
+        }
+        array->array = newArray;
     }
-    array->array = newArray;
     array->limit = newCapacity;
 
     return array;
@@ -295,7 +302,7 @@ parcArrayList_Destroy(PARCArrayList **arrayPtr)
     }
 
     if (array->array != NULL) {
-        parcMemory_Deallocate((void **) &(array->array));
+        parcMemory_DeallocateSized((void **) &(array->array), array->limit * sizeof(void *));
     }
 
     parcMemory_Deallocate((void **) &array);
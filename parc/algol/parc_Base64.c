@@ -49,6 +49,7 @@
 
 #include <config.h>
 
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -57,7 +58,13 @@
 #include <parc/algol/parc_Base64.h>
 #include <parc/algol/parc_Memory.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define PARCBase64_X86 1
+#  include <immintrin.h>
+#endif
+
 const uint8_t base64code[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+const uint8_t base64urlcode[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
 const uint8_t pad = '=';
 
 const uint8_t invalid = '~';       // has ascii value 127, outside base64
@@ -84,77 +91,101 @@ const uint8_t decodeTable[256] = {
     '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~'
 };
 
-#define min(a, b) ((a < b) ? a : b)
+// The same as decodeTable, but '-' and '_' are 62 and 63, and '+' and '/' are invalid.
+const uint8_t decodeURLTable[256] = {
+/*   0 */ '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '_', '~', '~', '_', '~', '~',
+/*  16 */ '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+/*  32 */ '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', 62,  '~', '~',
+/*  48 */ 52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  '~', '~', '~', '~', '~', '~',
+/*  64 */ '~', 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,
+/*  80 */ 15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  '~', '~', '~', '~', 63,
+/*  96 */ '~', 26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+/* 112 */ 41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  '~', '~', '~', '~', '~',
+/* 128 */ '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+    '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+    '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+    '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+    '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+    '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+    '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~',
+    '~',       '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~', '~'
+};
+
+typedef struct {
+    const uint8_t *code;
+    const uint8_t *decodeTable;
+    bool padded;
+} _PARCBase64Alphabet;
+
+static const _PARCBase64Alphabet _alphabets[] = {
+    [PARCBase64Alphabet_Standard] = { .code = base64code,    .decodeTable = decodeTable,    .padded = true  },
+    [PARCBase64Alphabet_URLSafe]  = { .code = base64urlcode, .decodeTable = decodeURLTable, .padded = false },
+};
+
+static const _PARCBase64Alphabet *
+_alphabet(PARCBase64Alphabet alphabet)
+{
+    trapIllegalValueIf(alphabet != PARCBase64Alphabet_Standard && alphabet != PARCBase64Alphabet_URLSafe,
+                       "Unknown PARCBase64Alphabet %d", alphabet);
+    return &_alphabets[alphabet];
+}
 
 /**
  * Encode the 3-byte quantum pointed to by <code>quantum</code> into 4 encoded characters.
- * It includes `padLength` of pad necessary at the end.
+ * It includes `padLength` of pad necessary at the end, unless the alphabet is not padded.
+ *
+ * @return The number of characters written to `output`.
  */
-static void
-_encodeWithPad(PARCBufferComposer *output, const uint8_t *quantum, size_t padLength)
+static size_t
+_encodeWithPad(const _PARCBase64Alphabet *alphabet, uint8_t output[4], const uint8_t *quantum, size_t padLength)
 {
     assertTrue(padLength < 3, "Degenerate case -- should never pad all 3 bytes!");
 
-    unsigned index;
-
     uint8_t paddedQuantum[] = { 0, 0, 0 };
     memcpy(paddedQuantum, quantum, 3 - padLength);
 
-    for (index = 0; index < 4; index++) {
-        if (index + padLength < 4) {
-            /*
-             * The four base64 symbols fall in to these locations in the
-             * 3-byte input
-             *
-             * aaaaaabb | bbbbcccc | ccdddddd
-             *
-             * This switch statement, based on the "a" "b" "c" or "d" case
-             * extracts the corresponding 6 bits from its location in the
-             * byte aray.
-             */
-            int sixbit = 0;
-            switch (index) {
-                case 0: // aaaaaa
-                    sixbit = paddedQuantum[0] >> 2;
-                    break;
-
-                case 1: // bbbbbb
-                    sixbit = ((paddedQuantum[0] & 0x03) << 4) | (paddedQuantum[1] >> 4);
-                    break;
-
-                case 2: // cccccc
-                    sixbit = ((paddedQuantum[1] & 0x0F) << 2) | (paddedQuantum[2] >> 6);
-                    break;
-
-                case 3: // dddddd
-                    sixbit = paddedQuantum[2] & 0x3F;
-                    break;
-            }
-            uint8_t encodedChar = base64code[ sixbit ];
-            parcBufferComposer_PutUint8(output, encodedChar);
-        } else {
-            parcBufferComposer_PutUint8(output, pad);
+    /*
+     * The four base64 symbols fall in to these locations in the
+     * 3-byte input
+     *
+     * aaaaaabb | bbbbcccc | ccdddddd
+     */
+    uint8_t encoded[4] = {
+        alphabet->code[paddedQuantum[0] >> 2],
+        alphabet->code[((paddedQuantum[0] & 0x03) << 4) | (paddedQuantum[1] >> 4)],
+        alphabet->code[((paddedQuantum[1] & 0x0F) << 2) | (paddedQuantum[2] >> 6)],
+        alphabet->code[paddedQuantum[2] & 0x3F]
+    };
+
+    size_t length = 4 - padLength;
+    memcpy(output, encoded, length);
+    if (alphabet->padded) {
+        for (; length < 4; length++) {
+            output[length] = pad;
         }
     }
+    return length;
 }
 
 /**
  * Decode the 4-byte quantum of base64 to binary.
+ *
+ * @return The number of bytes written to `output`, or -1 if the quantum is not base64.
  */
-static bool
-_decode(PARCBufferComposer *output, uint8_t *quantum)
+static int
+_decode(const _PARCBase64Alphabet *alphabet, uint8_t output[3], const uint8_t *quantum)
 {
     uint8_t threebytes[3] = { 0, 0, 0 };
-    size_t length_to_append = 0;
+    int length_to_append = 0;
 
     for (int index = 0; index < 4; index++) {
         uint8_t c = quantum[index];
         if (c != pad) {
-            uint8_t value = decodeTable[c];
+            uint8_t value = alphabet->decodeTable[c];
 
             // if its a non-base64 character, bail out of here
-            if (value == invalid) {
-                return false;
+            if (value >= 64) {
+                return -1;
             }
 
             /*
@@ -194,8 +225,492 @@ _decode(PARCBufferComposer *output, uint8_t *quantum)
         }
     }
 
-    parcBufferComposer_PutArray(output, threebytes, length_to_append);
-    return true;
+    memcpy(output, threebytes, (size_t) length_to_append);
+    return length_to_append;
+}
+
+/*
+ * The bulk encoders and decoders process as many whole blocks of the input as they can,
+ * and return the number of input bytes they consumed, leaving the rest to the caller.
+ * The encoders consume a multiple of 3 bytes, the decoders a multiple of 4 bytes,
+ * and the decoders stop at the first block containing anything other than the 64 symbols of the alphabet.
+ */
+typedef size_t (_PARCBase64Bulk)(const _PARCBase64Alphabet *alphabet, size_t length, const uint8_t *input, uint8_t *output);
+
+typedef struct {
+    _PARCBase64Bulk *encode;
+    _PARCBase64Bulk *decode;
+} _PARCBase64Implementation;
+
+static size_t
+_encode_Scalar(const _PARCBase64Alphabet *alphabet, size_t length, const uint8_t *input, uint8_t *output)
+{
+    const uint8_t *code = alphabet->code;
+
+    size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        uint32_t quantum = ((uint32_t) input[i] << 16) | ((uint32_t) input[i + 1] << 8) | input[i + 2];
+        *output++ = code[(quantum >> 18) & 0x3F];
+        *output++ = code[(quantum >> 12) & 0x3F];
+        *output++ = code[(quantum >> 6) & 0x3F];
+        *output++ = code[quantum & 0x3F];
+    }
+    return i;
+}
+
+static size_t
+_decode_Scalar(const _PARCBase64Alphabet *alphabet, size_t length, const uint8_t *input, uint8_t *output)
+{
+    const uint8_t *table = alphabet->decodeTable;
+
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        uint32_t a = table[input[i]];
+        uint32_t b = table[input[i + 1]];
+        uint32_t c = table[input[i + 2]];
+        uint32_t d = table[input[i + 3]];
+        // Every invalid, skip or pad character has a table value of 64 or more.
+        if ((a | b | c | d) >= 64) {
+            break;
+        }
+        uint32_t quantum = (a << 18) | (b << 12) | (c << 6) | d;
+        *output++ = (uint8_t) (quantum >> 16);
+        *output++ = (uint8_t) (quantum >> 8);
+        *output++ = (uint8_t) quantum;
+    }
+    return i;
+}
+
+static const _PARCBase64Implementation _scalar = {
+    .encode = _encode_Scalar,
+    .decode = _decode_Scalar,
+};
+
+#ifdef PARCBase64_X86
+/*
+ * The vector encoders spread each 3 bytes of input over the 4 bytes of a 32-bit lane,
+ * isolate the four 6-bit values with a pair of multiplies, and translate the values to symbols by adding
+ * an offset chosen, with a byte shuffle, by the range the value falls in:
+ * 0..25 'A'..'Z', 26..51 'a'..'z', 52..61 '0'..'9', 62 and 63.
+ */
+#define _encodeOffsets(code) \
+    (char) ('a' - 26), (char) ('0' - 52), (char) ('0' - 52), (char) ('0' - 52), \
+    (char) ('0' - 52), (char) ('0' - 52), (char) ('0' - 52), (char) ('0' - 52), \
+    (char) ('0' - 52), (char) ('0' - 52), (char) ('0' - 52), (char) (code[62] - 62), \
+    (char) (code[63] - 63), (char) 'A', 0, 0
+
+__attribute__((target("ssse3")))
+static inline __m128i
+_encodeBlock_SSSE3(__m128i input, __m128i offsets)
+{
+    input = _mm_shuffle_epi8(input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+    __m128i ac = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i bd = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    __m128i values = _mm_or_si128(ac, bd);
+
+    // 0 for 'a'..'z', 1..11 for the digits and 62 and 63, 13 for 'A'..'Z'.
+    __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), values);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+
+    return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+}
+
+__attribute__((target("ssse3")))
+static size_t
+_encode_SSSE3(const _PARCBase64Alphabet *alphabet, size_t length, const uint8_t *input, uint8_t *output)
+{
+    const __m128i offsets = _mm_setr_epi8(_encodeOffsets(alphabet->code));
+
+    // Each step reads 16 bytes and encodes the first 12 of them.
+    size_t i = 0;
+    for (; i + 16 <= length; i += 12) {
+        __m128i block = _mm_loadu_si128((const __m128i *) &input[i]);
+        _mm_storeu_si128((__m128i *) output, _encodeBlock_SSSE3(block, offsets));
+        output += 16;
+    }
+    return i + _encode_Scalar(alphabet, length - i, input + i, output);
+}
+
+/*
+ * The vector decoders translate symbols to values with range comparisons, which suits either alphabet,
+ * and then pack each four 6-bit values into 3 bytes with a pair of multiply-adds.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i
+_inRange_SSSE3(__m128i block, char low, char high)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8((char) (low - 1))),
+                         _mm_cmpgt_epi8(_mm_set1_epi8((char) (high + 1)), block));
+}
+
+__attribute__((target("ssse3")))
+static size_t
+_decode_SSSE3(const _PARCBase64Alphabet *alphabet, size_t length, const uint8_t *input, uint8_t *output)
+{
+    const __m128i symbol62 = _mm_set1_epi8((char) alphabet->code[62]);
+    const __m128i symbol63 = _mm_set1_epi8((char) alphabet->code[63]);
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) &input[i]);
+
+        __m128i upper = _inRange_SSSE3(block, 'A', 'Z');
+        __m128i lower = _inRange_SSSE3(block, 'a', 'z');
+        __m128i digit = _inRange_SSSE3(block, '0', '9');
+        __m128i is62 = _mm_cmpeq_epi8(block, symbol62);
+        __m128i is63 = _mm_cmpeq_epi8(block, symbol63);
+
+        __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(is62, is63)));
+        if (_mm_movemask_epi8(valid) != 0xFFFF) {
+            break;
+        }
+
+        __m128i offset = _mm_and_si128(upper, _mm_set1_epi8((char) -'A'));
+        offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8((char) (26 - 'a'))));
+        offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8((char) (52 - '0'))));
+        offset = _mm_or_si128(offset, _mm_and_si128(is62, _mm_set1_epi8((char) (62 - alphabet->code[62]))));
+        offset = _mm_or_si128(offset, _mm_and_si128(is63, _mm_set1_epi8((char) (63 - alphabet->code[63]))));
+        __m128i values = _mm_add_epi8(block, offset);
+
+        __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        __m128i quanta = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        __m128i bytes = _mm_shuffle_epi8(quanta, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        // Store exactly 12 bytes, the output has no room to spare.
+        _mm_storel_epi64((__m128i *) output, bytes);
+        uint32_t last = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+        memcpy(output + 8, &last, sizeof(last));
+        output += 12;
+    }
+    return i + _decode_Scalar(alphabet, length - i, input + i, output);
+}
+
+static const _PARCBase64Implementation _ssse3 = {
+    .encode = _encode_SSSE3,
+    .decode = _decode_SSSE3,
+};
+
+__attribute__((target("avx2")))
+static size_t
+_encode_AVX2(const _PARCBase64Alphabet *alphabet, size_t length, const uint8_t *input, uint8_t *output)
+{
+    const __m256i offsets = _mm256_setr_epi8(_encodeOffsets(alphabet->code), _encodeOffsets(alphabet->code));
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    // Each step encodes 24 bytes, 12 in each 128-bit lane, reading 28 bytes.
+    size_t i = 0;
+    for (; i + 28 <= length; i += 24) {
+        __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) &input[i])),
+                                                _mm_loadu_si128((const __m128i *) &input[i + 12]), 1);
+        block = _mm256_shuffle_epi8(block, spread);
+
+        __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(block, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(block, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        __m256i values = _mm256_or_si256(ac, bd);
+
+        __m256i range = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), values);
+        range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+
+        _mm256_storeu_si256((__m256i *) output, _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range)));
+        output += 32;
+    }
+    return i + _encode_SSSE3(alphabet, length - i, input + i, output);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i
+_inRange_AVX2(__m256i block, char low, char high)
+{
+    return _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8((char) (low - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8((char) (high + 1)), block));
+}
+
+__attribute__((target("avx2")))
+static size_t
+_decode_AVX2(const _PARCBase64Alphabet *alphabet, size_t length, const uint8_t *input, uint8_t *output)
+{
+    const __m256i symbol62 = _mm256_set1_epi8((char) alphabet->code[62]);
+    const __m256i symbol63 = _mm256_set1_epi8((char) alphabet->code[63]);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) &input[i]);
+
+        __m256i upper = _inRange_AVX2(block, 'A', 'Z');
+        __m256i lower = _inRange_AVX2(block, 'a', 'z');
+        __m256i digit = _inRange_AVX2(block, '0', '9');
+        __m256i is62 = _mm256_cmpeq_epi8(block, symbol62);
+        __m256i is63 = _mm256_cmpeq_epi8(block, symbol63);
+
+        __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(is62, is63)));
+        if ((uint32_t) _mm256_movemask_epi8(valid) != 0xFFFFFFFF) {
+            break;
+        }
+
+        __m256i offset = _mm256_and_si256(upper, _mm256_set1_epi8((char) -'A'));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(lower, _mm256_set1_epi8((char) (26 - 'a'))));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8((char) (52 - '0'))));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(is62, _mm256_set1_epi8((char) (62 - alphabet->code[62]))));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(is63, _mm256_set1_epi8((char) (63 - alphabet->code[63]))));
+        __m256i values = _mm256_add_epi8(block, offset);
+
+        __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        __m256i quanta = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        __m256i bytes = _mm256_shuffle_epi8(quanta, pack);
+
+        // Each lane holds 12 bytes; store exactly 24 bytes.
+        __m128i low = _mm256_castsi256_si128(bytes);
+        __m128i high = _mm256_extracti128_si256(bytes, 1);
+        _mm_storel_epi64((__m128i *) output, low);
+        uint32_t word = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(low, 8));
+        memcpy(output + 8, &word, sizeof(word));
+        _mm_storel_epi64((__m128i *) (output + 12), high);
+        word = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(high, 8));
+        memcpy(output + 20, &word, sizeof(word));
+        output += 24;
+    }
+    return i + _decode_SSSE3(alphabet, length - i, input + i, output);
+}
+
+static const _PARCBase64Implementation _avx2 = {
+    .encode = _encode_AVX2,
+    .decode = _decode_AVX2,
+};
+#endif
+
+static pthread_once_t _parcBase64_Once = PTHREAD_ONCE_INIT;
+static PARCBase64Level _parcBase64_Supported = PARCBase64Level_Scalar;
+static PARCBase64Level _parcBase64_Level = PARCBase64Level_Scalar;
+static const _PARCBase64Implementation *_parcBase64_Implementation = &_scalar;
+
+static void
+_parcBase64_Use(PARCBase64Level level)
+{
+    _parcBase64_Level = level;
+    switch (level) {
+#ifdef PARCBase64_X86
+        case PARCBase64Level_AVX2:
+            _parcBase64_Implementation = &_avx2;
+            break;
+        case PARCBase64Level_SSSE3:
+            _parcBase64_Implementation = &_ssse3;
+            break;
+#endif
+        default:
+            _parcBase64_Level = PARCBase64Level_Scalar;
+            _parcBase64_Implementation = &_scalar;
+            break;
+    }
+}
+
+static void
+_parcBase64_Initialize(void)
+{
+#ifdef PARCBase64_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        _parcBase64_Supported = PARCBase64Level_AVX2;
+    } else if (__builtin_cpu_supports("ssse3")) {
+        _parcBase64_Supported = PARCBase64Level_SSSE3;
+    }
+#endif
+    _parcBase64_Use(_parcBase64_Supported);
+}
+
+static inline const _PARCBase64Implementation *
+_implementation(void)
+{
+    pthread_once(&_parcBase64_Once, _parcBase64_Initialize);
+    return _parcBase64_Implementation;
+}
+
+PARCBase64Level
+parcBase64_GetLevel(void)
+{
+    pthread_once(&_parcBase64_Once, _parcBase64_Initialize);
+    return _parcBase64_Level;
+}
+
+PARCBase64Level
+parcBase64_SetLevel(PARCBase64Level level)
+{
+    PARCBase64Level result = parcBase64_GetLevel();
+
+    _parcBase64_Use((level > _parcBase64_Supported) ? _parcBase64_Supported : level);
+    return result;
+}
+
+size_t
+parcBase64_MaximumEncodedLength(size_t length)
+{
+    return ((length + 2) / 3) * 4;
+}
+
+size_t
+parcBase64_MaximumDecodedLength(size_t length)
+{
+    return ((length + 3) / 4) * 3;
+}
+
+PARCBase64Encoder *
+parcBase64Encoder_Init(PARCBase64Encoder *encoder, PARCBase64Alphabet alphabet)
+{
+    _alphabet(alphabet);
+
+    encoder->alphabet = alphabet;
+    encoder->pendingLength = 0;
+    return encoder;
+}
+
+size_t
+parcBase64Encoder_Update(PARCBase64Encoder *encoder, size_t length, const uint8_t input[length], uint8_t *output)
+{
+    const _PARCBase64Alphabet *alphabet = _alphabet(encoder->alphabet);
+    size_t offset = 0;
+    size_t result = 0;
+
+    // Complete the quantum left over from the previous update.
+    if (encoder->pendingLength > 0) {
+        while (encoder->pendingLength < 3 && offset < length) {
+            encoder->pending[encoder->pendingLength++] = input[offset++];
+        }
+        if (encoder->pendingLength < 3) {
+            return 0;
+        }
+        result += _encodeWithPad(alphabet, output, encoder->pending, 0);
+        encoder->pendingLength = 0;
+    }
+
+    size_t consumed = _implementation()->encode(alphabet, length - offset, input + offset, output + result);
+    offset += consumed;
+    result += (consumed / 3) * 4;
+
+    while (offset < length) {
+        encoder->pending[encoder->pendingLength++] = input[offset++];
+    }
+
+    return result;
+}
+
+size_t
+parcBase64Encoder_Finish(PARCBase64Encoder *encoder, uint8_t output[4])
+{
+    size_t result = 0;
+    if (encoder->pendingLength > 0) {
+        result = _encodeWithPad(_alphabet(encoder->alphabet), output, encoder->pending, 3 - encoder->pendingLength);
+    }
+    encoder->pendingLength = 0;
+    return result;
+}
+
+PARCBase64Decoder *
+parcBase64Decoder_Init(PARCBase64Decoder *decoder, PARCBase64Alphabet alphabet)
+{
+    _alphabet(alphabet);
+
+    decoder->alphabet = alphabet;
+    decoder->pendingLength = 0;
+    return decoder;
+}
+
+size_t
+parcBase64Decoder_Update(PARCBase64Decoder *decoder, size_t length, const uint8_t input[length], uint8_t *output)
+{
+    const _PARCBase64Alphabet *alphabet = _alphabet(decoder->alphabet);
+    const _PARCBase64Implementation *implementation = _implementation();
+    size_t offset = 0;
+    size_t result = 0;
+
+    while (offset < length) {
+        // On a quantum boundary, decode as much as possible in bulk.
+        if (decoder->pendingLength == 0) {
+            size_t consumed = implementation->decode(alphabet, length - offset, input + offset, output + result);
+            offset += consumed;
+            result += (consumed / 4) * 3;
+            if (offset == length) {
+                break;
+            }
+        }
+
+        // The bulk decoder stopped at a line break, a pad or an invalid character:
+        // filter out line feeds and carriage returns and collect a 4-byte quantum one character at a time.
+        uint8_t c = input[offset++];
+        uint8_t decoded = alphabet->decodeTable[c];
+
+        if (decoded == skip) {
+            continue;
+        }
+        if (decoded == invalid && c != pad) {
+            return SIZE_MAX;
+        }
+
+        decoder->pending[decoder->pendingLength++] = c;
+        if (decoder->pendingLength == 4) {
+            int n = _decode(alphabet, output + result, decoder->pending);
+            if (n < 0) {
+                return SIZE_MAX;
+            }
+            result += (size_t) n;
+            decoder->pendingLength = 0;
+        }
+    }
+
+    return result;
+}
+
+size_t
+parcBase64Decoder_Finish(PARCBase64Decoder *decoder, uint8_t output[3])
+{
+    const _PARCBase64Alphabet *alphabet = _alphabet(decoder->alphabet);
+
+    size_t pendingLength = decoder->pendingLength;
+    decoder->pendingLength = 0;
+
+    if (pendingLength == 0) {
+        return 0;
+    }
+
+    // Only an unpadded alphabet may end part way through a quantum, and a single character encodes nothing.
+    if (alphabet->padded || pendingLength == 1) {
+        return SIZE_MAX;
+    }
+
+    uint8_t quantum[4] = { pad, pad, pad, pad };
+    memcpy(quantum, decoder->pending, pendingLength);
+    int n = _decode(alphabet, output, quantum);
+    return (n < 0) ? SIZE_MAX : (size_t) n;
+}
+
+size_t
+parcBase64_EncodeToArray(PARCBase64Alphabet alphabet, size_t length, const uint8_t input[length], uint8_t *output)
+{
+    PARCBase64Encoder encoder;
+    parcBase64Encoder_Init(&encoder, alphabet);
+
+    size_t result = parcBase64Encoder_Update(&encoder, length, input, output);
+    result += parcBase64Encoder_Finish(&encoder, output + result);
+    return result;
+}
+
+size_t
+parcBase64_DecodeToArray(PARCBase64Alphabet alphabet, size_t length, const uint8_t input[length], uint8_t *output)
+{
+    PARCBase64Decoder decoder;
+    parcBase64Decoder_Init(&decoder, alphabet);
+
+    size_t result = parcBase64Decoder_Update(&decoder, length, input, output);
+    if (result == SIZE_MAX) {
+        return SIZE_MAX;
+    }
+
+    size_t lastLength = parcBase64Decoder_Finish(&decoder, output + result);
+    return (lastLength == SIZE_MAX) ? SIZE_MAX : result + lastLength;
 }
 
 PARCBufferComposer *
@@ -213,14 +728,15 @@ parcBase64_Encode(PARCBufferComposer *result, PARCBuffer *plainText)
 PARCBufferComposer *
 parcBase64_EncodeArray(PARCBufferComposer *output, size_t length, const uint8_t array[length])
 {
-    size_t offset = 0;
+    return parcBase64_EncodeArrayWithAlphabet(output, PARCBase64Alphabet_Standard, length, array);
+}
 
-    // Encode 3-byte tuples
-    while (offset < length) {
-        const uint8_t *quantum = array + offset;
-        size_t padLength = 3 - min(3, length - offset);
-        _encodeWithPad(output, quantum, padLength);
-        offset += 3;
+PARCBufferComposer *
+parcBase64_EncodeArrayWithAlphabet(PARCBufferComposer *output, PARCBase64Alphabet alphabet, size_t length, const uint8_t array[length])
+{
+    if (length > 0) {
+        uint8_t *span = parcBufferComposer_GetWritableSpan(output, parcBase64_MaximumEncodedLength(length), NULL);
+        parcBufferComposer_Commit(output, parcBase64_EncodeToArray(alphabet, length, array, span));
     }
 
     return output;
@@ -248,56 +764,21 @@ parcBase64_DecodeString(PARCBufferComposer *output, const char *encodedString)
 PARCBufferComposer *
 parcBase64_DecodeArray(PARCBufferComposer *output, size_t length, const uint8_t array[length])
 {
-    size_t offset = 0;
-    bool success = true;
-
-    // if we need to rollback, this is where we go
-    PARCBuffer *outputBuffer = parcBufferComposer_GetBuffer(output);
-    size_t rewind_to = parcBuffer_Position(outputBuffer);
-
-    while (offset < length && success) {
-        // filter out line feeds and carrage returns
-        // parse the input in 4-byte quantums
-        size_t index = 0;
-        uint8_t quantum[4];
-
-        // reset success at the start of each loop.  if we run out of input before
-        // we parse a full quantum, we'll fail the loop and rewind the output buffer.
-        success = false;
-
-        // 4 == quantum length for decode
-        while (index < 4 && offset < length) {
-            uint8_t c = array[offset];
-            uint8_t decoded = decodeTable[c];
-
-            if (decoded < 64 || c == pad) {
-                // this is an artifact from how the code was first written, so we
-                // pass the un-decoded character
-                quantum[index] = c;
-                index++;
-                offset++;
-                continue;
-            }
-
-            if (decoded == skip) {
-                offset++;
-                continue;
-            }
-
-            if (decoded == invalid) {
-                break;
-            }
-        }
+    return parcBase64_DecodeArrayWithAlphabet(output, PARCBase64Alphabet_Standard, length, array);
+}
 
-        if (index == 4) {
-            success = _decode(output, quantum);
-        }
-    }
+PARCBufferComposer *
+parcBase64_DecodeArrayWithAlphabet(PARCBufferComposer *output, PARCBase64Alphabet alphabet, size_t length, const uint8_t array[length])
+{
+    // Decode into the composer's free space, and commit it only if the whole input decodes,
+    // so a failure leaves the output at its starting position.
+    uint8_t *span = parcBufferComposer_GetWritableSpan(output, parcBase64_MaximumDecodedLength(length), NULL);
 
-    if (!success) {
-        parcBuffer_SetPosition(outputBuffer, rewind_to);
+    size_t decodedLength = parcBase64_DecodeToArray(alphabet, length, array, span);
+    if (decodedLength == SIZE_MAX) {
         return NULL;
     }
 
+    parcBufferComposer_Commit(output, decodedLength);
     return output;
 }
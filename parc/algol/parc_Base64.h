@@ -55,6 +55,55 @@
 #include <parc/algol/parc_Buffer.h>
 #include <parc/algol/parc_BufferComposer.h>
 
+/**
+ * @typedef PARCBase64Alphabet
+ * @brief The alphabet of a base64 encoding.
+ *
+ * `PARCBase64Alphabet_Standard` is the alphabet of RFC 4648, Section 4, and is always padded with '='.
+ * `PARCBase64Alphabet_URLSafe` is the "base64url" alphabet of RFC 4648, Section 5, which uses '-' and '_'
+ * in place of '+' and '/'. Its encoding omits the padding, and its decoding accepts input with or without it.
+ */
+typedef enum {
+    PARCBase64Alphabet_Standard = 0,
+    PARCBase64Alphabet_URLSafe = 1
+} PARCBase64Alphabet;
+
+/**
+ * @typedef PARCBase64Level
+ * @brief The instruction set used to encode and decode base64.
+ */
+typedef enum {
+    PARCBase64Level_Scalar = 0,
+    PARCBase64Level_SSSE3 = 1,
+    PARCBase64Level_AVX2 = 2
+} PARCBase64Level;
+
+/**
+ * @typedef PARCBase64Encoder
+ * @brief The state of a base64 encoding of input that arrives in pieces.
+ *
+ * A `PARCBase64Encoder` is not a `PARCObject`, it is meant to live on the stack.
+ * Initialise it with {@link parcBase64Encoder_Init}.
+ */
+typedef struct {
+    PARCBase64Alphabet alphabet;
+    size_t pendingLength;
+    uint8_t pending[3];
+} PARCBase64Encoder;
+
+/**
+ * @typedef PARCBase64Decoder
+ * @brief The state of a base64 decoding of input that arrives in pieces.
+ *
+ * A `PARCBase64Decoder` is not a `PARCObject`, it is meant to live on the stack.
+ * Initialise it with {@link parcBase64Decoder_Init}.
+ */
+typedef struct {
+    PARCBase64Alphabet alphabet;
+    size_t pendingLength;
+    uint8_t pending[4];
+} PARCBase64Decoder;
+
 /**
  * Encode the plaintext buffer to base64, as per RFC 4648, Section 4.
  *
@@ -139,4 +188,307 @@ PARCBufferComposer *parcBase64_DecodeString(PARCBufferComposer *output, const ch
  * @endcode
  */
 PARCBufferComposer *parcBase64_DecodeArray(PARCBufferComposer *output, size_t length, const uint8_t array[length]);
+
+/**
+ * Encode the array to base64 with the given alphabet.
+ *
+ * @param [in,out] output The instance of {@link PARCBufferComposer} to which the encoded @p array is appended
+ * @param [in] alphabet The `PARCBase64Alphabet` of the encoding.
+ * @param [in] length The length of the Array to be encoded
+ * @param [in] array The array to be encoded and appended to @p output
+ *
+ * @return  A pointer to the @p output
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBase64_EncodeArrayWithAlphabet(composer, PARCBase64Alphabet_URLSafe, sizeof(nonce), nonce);
+ * }
+ * @endcode
+ */
+PARCBufferComposer *parcBase64_EncodeArrayWithAlphabet(PARCBufferComposer *output, PARCBase64Alphabet alphabet,
+                                                       size_t length, const uint8_t array[length]);
+
+/**
+ * Base64 decode the array with the given alphabet.
+ *
+ * @param [in,out] output The instance of {@link PARCBufferComposer} to which the decoded @p array is appended
+ * @param [in] alphabet The `PARCBase64Alphabet` of the encoding.
+ * @param [in] length The size of the array.
+ * @param [in] array The array to be decoded and appended to @p output
+ *
+ * @return  A pointer to the @p output, or NULL if the @p array cannot be base64 decoded
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcBase64_DecodeArrayWithAlphabet(composer, PARCBase64Alphabet_URLSafe, length, token) == NULL) {
+ *         printf("Not base64url\n");
+ *     }
+ * }
+ * @endcode
+ */
+PARCBufferComposer *parcBase64_DecodeArrayWithAlphabet(PARCBufferComposer *output, PARCBase64Alphabet alphabet,
+                                                       size_t length, const uint8_t array[length]);
+
+/**
+ * The number of bytes needed to hold the base64 encoding of @p length bytes.
+ *
+ * This is exact for `PARCBase64Alphabet_Standard`.
+ * The unpadded `PARCBase64Alphabet_URLSafe` encoding may be up to 2 bytes shorter.
+ *
+ * @param [in] length The number of bytes to encode.
+ *
+ * @return The maximum length of the encoding.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t *encoded = parcMemory_Allocate(parcBase64_MaximumEncodedLength(length));
+ *     size_t encodedLength = parcBase64_EncodeToArray(PARCBase64Alphabet_Standard, length, array, encoded);
+ * }
+ * @endcode
+ */
+size_t parcBase64_MaximumEncodedLength(size_t length);
+
+/**
+ * The number of bytes needed to hold the decoding of @p length bytes of base64.
+ *
+ * @param [in] length The number of bytes to decode.
+ *
+ * @return The maximum length of the decoding.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t *decoded = parcMemory_Allocate(parcBase64_MaximumDecodedLength(length));
+ *     size_t decodedLength = parcBase64_DecodeToArray(PARCBase64Alphabet_Standard, length, encoded, decoded);
+ * }
+ * @endcode
+ */
+size_t parcBase64_MaximumDecodedLength(size_t length);
+
+/**
+ * Encode @p length bytes of @p input to base64 in the pre-sized @p output.
+ *
+ * @param [in] alphabet The `PARCBase64Alphabet` of the encoding.
+ * @param [in] length The number of bytes to encode.
+ * @param [in] input The bytes to encode.
+ * @param [out] output An array of at least `parcBase64_MaximumEncodedLength(length)` bytes.
+ *
+ * @return The number of bytes written to @p output.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t encoded[parcBase64_MaximumEncodedLength(sizeof(key))];
+ *     size_t encodedLength = parcBase64_EncodeToArray(PARCBase64Alphabet_Standard, sizeof(key), key, encoded);
+ * }
+ * @endcode
+ */
+size_t parcBase64_EncodeToArray(PARCBase64Alphabet alphabet, size_t length, const uint8_t input[length], uint8_t *output);
+
+/**
+ * Decode @p length bytes of base64 in @p input to the pre-sized @p output.
+ *
+ * Carriage returns and line feeds in @p input are skipped.
+ *
+ * @param [in] alphabet The `PARCBase64Alphabet` of the encoding.
+ * @param [in] length The number of bytes to decode.
+ * @param [in] input The base64 to decode.
+ * @param [out] output An array of at least `parcBase64_MaximumDecodedLength(length)` bytes.
+ *
+ * @return The number of bytes written to @p output, or `SIZE_MAX` if @p input is not valid base64.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t decoded[parcBase64_MaximumDecodedLength(length)];
+ *     size_t decodedLength = parcBase64_DecodeToArray(PARCBase64Alphabet_Standard, length, encoded, decoded);
+ *     if (decodedLength == SIZE_MAX) {
+ *         printf("Not base64\n");
+ *     }
+ * }
+ * @endcode
+ */
+size_t parcBase64_DecodeToArray(PARCBase64Alphabet alphabet, size_t length, const uint8_t input[length], uint8_t *output);
+
+/**
+ * Get the instruction set currently used to encode and decode base64.
+ *
+ * The instruction set is chosen once, at the first encoding or decoding, from the features of the processor.
+ * SSSE3 encodes 12 bytes and decodes 16 bytes per step, AVX2 twice as many.
+ *
+ * @return The current `PARCBase64Level`.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcBase64_GetLevel() == PARCBase64Level_Scalar) {
+ *         printf("No vector instructions are available.\n");
+ *     }
+ * }
+ * @endcode
+ */
+PARCBase64Level parcBase64_GetLevel(void);
+
+/**
+ * Set the instruction set used to encode and decode base64.
+ *
+ * If the processor does not support the given level, the highest supported level below it is used.
+ * This is intended for testing and benchmarking, and must not be called while other threads are encoding or decoding.
+ *
+ * @param [in] level The `PARCBase64Level` to use.
+ *
+ * @return The previous `PARCBase64Level`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBase64Level previous = parcBase64_SetLevel(PARCBase64Level_Scalar);
+ *     ...
+ *     parcBase64_SetLevel(previous);
+ * }
+ * @endcode
+ */
+PARCBase64Level parcBase64_SetLevel(PARCBase64Level level);
+
+/**
+ * Initialise a `PARCBase64Encoder` to encode with the given alphabet.
+ *
+ * @param [out] encoder A pointer to the `PARCBase64Encoder` to initialise.
+ * @param [in] alphabet The `PARCBase64Alphabet` of the encoding.
+ *
+ * @return The @p encoder.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBase64Encoder encoder;
+ *     parcBase64Encoder_Init(&encoder, PARCBase64Alphabet_Standard);
+ * }
+ * @endcode
+ */
+PARCBase64Encoder *parcBase64Encoder_Init(PARCBase64Encoder *encoder, PARCBase64Alphabet alphabet);
+
+/**
+ * Encode the next piece of the input.
+ *
+ * Only whole 3-byte quanta are written; up to 2 bytes of the input are held in the encoder
+ * until the next call to `parcBase64Encoder_Update` or {@link parcBase64Encoder_Finish}.
+ *
+ * @param [in,out] encoder A pointer to an initialised `PARCBase64Encoder`.
+ * @param [in] length The number of bytes in @p input.
+ * @param [in] input The next bytes to encode.
+ * @param [out] output An array of at least `parcBase64_MaximumEncodedLength(length)` bytes.
+ *
+ * @return The number of bytes written to @p output.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBase64Encoder encoder;
+ *     parcBase64Encoder_Init(&encoder, PARCBase64Alphabet_Standard);
+ *
+ *     while ((length = read(fd, chunk, sizeof(chunk))) > 0) {
+ *         size_t n = parcBase64Encoder_Update(&encoder, length, chunk, encoded);
+ *         ...
+ *     }
+ *     size_t n = parcBase64Encoder_Finish(&encoder, encoded);
+ * }
+ * @endcode
+ */
+size_t parcBase64Encoder_Update(PARCBase64Encoder *encoder, size_t length, const uint8_t input[length], uint8_t *output);
+
+/**
+ * Encode the bytes held in the encoder, with padding if the alphabet is padded.
+ *
+ * The encoder is re-initialised with the same alphabet and may be used for a new encoding.
+ *
+ * @param [in,out] encoder A pointer to an initialised `PARCBase64Encoder`.
+ * @param [out] output An array of at least 4 bytes.
+ *
+ * @return The number of bytes written to @p output.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t trailer[4];
+ *     size_t n = parcBase64Encoder_Finish(&encoder, trailer);
+ * }
+ * @endcode
+ */
+size_t parcBase64Encoder_Finish(PARCBase64Encoder *encoder, uint8_t output[4]);
+
+/**
+ * Initialise a `PARCBase64Decoder` to decode the given alphabet.
+ *
+ * @param [out] decoder A pointer to the `PARCBase64Decoder` to initialise.
+ * @param [in] alphabet The `PARCBase64Alphabet` of the encoding.
+ *
+ * @return The @p decoder.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBase64Decoder decoder;
+ *     parcBase64Decoder_Init(&decoder, PARCBase64Alphabet_Standard);
+ * }
+ * @endcode
+ */
+PARCBase64Decoder *parcBase64Decoder_Init(PARCBase64Decoder *decoder, PARCBase64Alphabet alphabet);
+
+/**
+ * Decode the next piece of the input.
+ *
+ * Only whole 4-byte quanta are written; up to 3 bytes of the input are held in the decoder
+ * until the next call to `parcBase64Decoder_Update` or {@link parcBase64Decoder_Finish}.
+ * Carriage returns and line feeds are skipped.
+ *
+ * @param [in,out] decoder A pointer to an initialised `PARCBase64Decoder`.
+ * @param [in] length The number of bytes in @p input.
+ * @param [in] input The next bytes to decode.
+ * @param [out] output An array of at least `parcBase64_MaximumDecodedLength(length)` bytes.
+ *
+ * @return The number of bytes written to @p output, or `SIZE_MAX` if @p input is not valid base64.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBase64Decoder decoder;
+ *     parcBase64Decoder_Init(&decoder, PARCBase64Alphabet_Standard);
+ *
+ *     while ((length = read(fd, chunk, sizeof(chunk))) > 0) {
+ *         size_t n = parcBase64Decoder_Update(&decoder, length, chunk, decoded);
+ *         if (n == SIZE_MAX) {
+ *             ...
+ *         }
+ *     }
+ *     size_t n = parcBase64Decoder_Finish(&decoder, decoded);
+ * }
+ * @endcode
+ */
+size_t parcBase64Decoder_Update(PARCBase64Decoder *decoder, size_t length, const uint8_t input[length], uint8_t *output);
+
+/**
+ * Finish a decoding.
+ *
+ * An unpadded final quantum is decoded if the alphabet is `PARCBase64Alphabet_URLSafe`,
+ * otherwise the input must have ended on a quantum boundary.
+ * The decoder is re-initialised with the same alphabet and may be used for a new decoding.
+ *
+ * @param [in,out] decoder A pointer to an initialised `PARCBase64Decoder`.
+ * @param [out] output An array of at least 3 bytes.
+ *
+ * @return The number of bytes written to @p output, or `SIZE_MAX` if the input ended in the middle of a quantum.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t trailer[3];
+ *     size_t n = parcBase64Decoder_Finish(&decoder, trailer);
+ * }
+ * @endcode
+ */
+size_t parcBase64Decoder_Finish(PARCBase64Decoder *decoder, uint8_t output[3]);
 #endif // libparc_parc_Base64_h
@@ -30,16 +30,25 @@
  */
 #include <config.h>
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include <LongBow/runtime.h>
 #include <LongBow/debugging.h>
 
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_BufferCursor.h>
 #include <parc/algol/parc_ByteArray.h>
+#include <parc/algol/parc_ByteScan.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_HashCode.h>
+#include <parc/algol/parc_File.h>
+
+#include "internal_parc_BufferPool.h"
 
 struct parc_buffer {
     PARCByteArray *array;
@@ -61,6 +70,9 @@ struct parc_buffer {
      * If the mark is not defined then invoking the reset function causes a trap.
      */
     size_t mark;
+
+    PARCBufferPool *pool;   // The pool to which the buffer returns when it is released, or NULL.
+    size_t poolClass;       // The index of the buffer's class in its pool.
 };
 
 static inline void
@@ -247,18 +259,40 @@ _parcBuffer_Destructor(PARCBuffer **bufferPtr)
 {
     PARCBuffer *buffer = *bufferPtr;
 
+    if (buffer->pool != NULL) {
+        if (internal_parcBufferPool_Recycle(buffer->pool, buffer->poolClass, parcObject_Resurrect(buffer))) {
+            *bufferPtr = NULL;
+            return false;
+        }
+    }
+
     parcByteArray_Release(&buffer->array);
     return true;
 }
 
+static PARCHashCode
+_parcBuffer_HashCode(const PARCBuffer *buffer)
+{
+    PARCHashCode result = 0;
+
+    size_t remaining = parcBuffer_Remaining(buffer);
+    if (remaining > 0) {
+        result = parcHashCode_Hash(parcByteArray_AddressOfIndex(buffer->array, _effectivePosition(buffer)), remaining);
+    }
+    return result;
+}
+
+parcObject_DeclarePool(PARCBuffer);
+
 parcObject_Override(PARCBuffer, PARCObject,
                     .destructor = (PARCObjectDestructor *) _parcBuffer_Destructor,
                     .copy = (PARCObjectCopy *) parcBuffer_Copy,
                     .toString = (PARCObjectToString *) parcBuffer_ToString,
                     .equals = (PARCObjectEquals *) parcBuffer_Equals,
                     .compare = (PARCObjectCompare *) parcBuffer_Compare,
-                    .hashCode = (PARCObjectHashCode *) parcBuffer_HashCode,
-                    .display = (PARCObjectDisplay *) parcBuffer_Display);
+                    .hashCode = (PARCObjectHashCode *) _parcBuffer_HashCode,
+                    .display = (PARCObjectDisplay *) parcBuffer_Display,
+                    .pool = &parcObject_PoolName(PARCBuffer));
 
 /**
  * Initialise a parcBuffer instance.
@@ -287,6 +321,9 @@ static inline PARCBuffer *
 _parcBuffer_getInstance(void)
 {
     PARCBuffer *result = parcObject_CreateInstance(PARCBuffer);
+    if (result != NULL) {
+        result->pool = NULL;
+    }
 
     return result;
 }
@@ -383,6 +420,7 @@ parcBuffer_Resize(PARCBuffer *buffer, size_t newCapacity)
     buffer->mark = _computeNewMark(buffer->mark, buffer->limit, newCapacity);
     buffer->capacity = newCapacity;
     buffer->position = (buffer->position < buffer->limit) ? buffer->position : buffer->limit;
+    parcObject_InvalidateHashCode(buffer);
 
     parcBuffer_OptionalAssertValid(buffer);
 
@@ -472,10 +510,60 @@ parcBuffer_CreateFromArray(const void *bytes, const size_t length)
     return result;
 }
 
+PARCBuffer *
+parcBuffer_MapFile(const PARCFile *file, PARCByteArrayMap mode)
+{
+    parcFile_OptionalAssertValid(file);
+
+    char *pathName = parcFile_ToString(file);
+    int fd = open(pathName, (mode == PARCByteArrayMap_Shared) ? O_RDWR : O_RDONLY);
+    parcMemory_Deallocate(&pathName);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    PARCBuffer *result = NULL;
+
+    struct stat statbuf;
+    if (fstat(fd, &statbuf) == 0) {
+        if (statbuf.st_size == 0) {
+            result = parcBuffer_Allocate(0);
+        } else {
+            PARCByteArray *array = parcByteArray_MapFile(fd, (size_t) statbuf.st_size, mode);
+            if (array != NULL) {
+                result = parcBuffer_WrapByteArray(array, 0, parcByteArray_Capacity(array));
+                parcByteArray_Release(&array);
+            }
+        }
+    }
+
+    // The mapping does not need the file to stay open.
+    int error = errno;
+    close(fd);
+    errno = error;
+
+    return result;
+}
+
+bool
+parcBuffer_Advise(const PARCBuffer *buffer, PARCByteArrayAdvice advice)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+
+    return parcByteArray_Advise(buffer->array, _effectivePosition(buffer), parcBuffer_Remaining(buffer), advice);
+}
+
 parcObject_ImplementAcquire(parcBuffer, PARCBuffer);
 
 parcObject_ImplementRelease(parcBuffer, PARCBuffer);
 
+void
+internal_parcBuffer_SetPool(PARCBuffer *buffer, PARCBufferPool *pool, size_t classIndex)
+{
+    buffer->pool = pool;
+    buffer->poolClass = classIndex;
+}
+
 size_t
 parcBuffer_Capacity(const PARCBuffer *buffer)
 {
@@ -503,7 +591,16 @@ parcBuffer_Equals(const PARCBuffer *x, const PARCBuffer *y)
         return false;
     }
 
-    return (parcBuffer_Compare(x, y) == 0);
+    // Buffers of different lengths are never equal, so there is no need to compare their content.
+    size_t length = parcBuffer_Remaining(x);
+    if (length != parcBuffer_Remaining(y)) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+
+    return memcmp(parcBuffer_Overlay((PARCBuffer *) x, 0), parcBuffer_Overlay((PARCBuffer *) y, 0), length) == 0;
 }
 
 int
@@ -603,6 +700,7 @@ parcBuffer_Reset(PARCBuffer *buffer)
     assertFalse(_markIsDiscarded(buffer),
                 "The mark has not been set");
     buffer->position = buffer->mark;
+    parcObject_InvalidateHashCode(buffer);
 
     _optionalAssertInvariants(buffer);
 
@@ -646,6 +744,7 @@ parcBuffer_SetLimit(PARCBuffer *buffer, size_t newLimit)
         }
         buffer->limit = newLimit;
     }
+    parcObject_InvalidateHashCode(buffer);
     _optionalAssertInvariants(buffer);
     return buffer;
 }
@@ -686,6 +785,7 @@ parcBuffer_SetPosition(PARCBuffer *buffer, size_t newPosition)
     if (!_markIsDiscarded(buffer) && newPosition < buffer->mark) {
         _discardMark(buffer);
     }
+    parcObject_InvalidateHashCode(buffer);
 
     _optionalAssertInvariants(buffer);
     return buffer;
@@ -698,6 +798,7 @@ parcBuffer_Rewind(PARCBuffer *buffer)
 
     buffer->position = 0;
     _discardMark(buffer);
+    parcObject_InvalidateHashCode(buffer);
 
     _optionalAssertInvariants(buffer);
     return buffer;
@@ -735,6 +836,7 @@ parcBuffer_Flip(PARCBuffer *result)
     size_t position = result->position;
     result->position = 0;
     result->limit = position;
+    parcObject_InvalidateHashCode(result);
 
     _optionalAssertInvariants(result);
 
@@ -759,6 +861,9 @@ parcBuffer_Overlay(PARCBuffer *buffer, size_t length)
 
     uint8_t *result = parcByteArray_AddressOfIndex(buffer->array, _effectiveIndex(buffer, parcBuffer_Position(buffer)));
     buffer->position += length;
+    if (length > 0) {
+        parcObject_InvalidateHashCode(buffer);
+    }
     return result;
 }
 
@@ -770,6 +875,7 @@ parcBuffer_GetUint8(PARCBuffer *buffer)
 
     uint8_t result = parcByteArray_GetByte(buffer->array, _effectivePosition(buffer));
     buffer->position++;
+    parcObject_InvalidateHashCode(buffer);
 
     return result;
 }
@@ -782,39 +888,108 @@ parcBuffer_GetBytes(PARCBuffer *buffer, size_t length, uint8_t array[length])
 
     parcByteArray_GetBytes(buffer->array, _effectivePosition(buffer), length, array);
     buffer->position += length;
+    parcObject_InvalidateHashCode(buffer);
 
     return buffer;
 }
 
-uint16_t
-parcBuffer_GetUint16(PARCBuffer *buffer)
+/*
+ * Check that @p length bytes remain, return the address of the position, and advance the position past them.
+ * There is no address to return for no bytes, which may be at the very end of the array.
+ */
+static inline uint8_t *
+_consume(PARCBuffer *buffer, size_t length)
 {
-    uint8_t high = parcBuffer_GetUint8(buffer);
-    uint8_t low = parcBuffer_GetUint8(buffer);
+    parcBuffer_OptionalAssertValid(buffer);
+    _trapIfBufferUnderflow(buffer, length);
+    if (length == 0) {
+        return NULL;
+    }
 
-    uint16_t result = (high << 8) | low;
+    uint8_t *result = parcByteArray_AddressOfIndex(buffer->array, _effectivePosition(buffer));
+    buffer->position += length;
+    parcObject_InvalidateHashCode(buffer);
+    return result;
+}
+
+/*
+ * Check that @p length bytes can be put, return the address of the position, and advance the position past them.
+ * As with _consume, there is no address for no bytes.
+ */
+static inline uint8_t *
+_produce(PARCBuffer *buffer, size_t length)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+    assertTrue(parcBuffer_Remaining(buffer) >= length,
+               "Buffer overflow");
+    if (length == 0) {
+        return NULL;
+    }
 
+    uint8_t *result = parcByteArray_AddressOfIndex(buffer->array, _effectivePosition(buffer));
+    buffer->position += length;
+    parcObject_InvalidateHashCode(buffer);
     return result;
 }
 
+// The length in bytes of an array of count elements, trapping if it cannot be represented.
+static inline size_t
+_arrayLength(size_t count, size_t elementSize)
+{
+    trapOutOfBoundsIf(count > SIZE_MAX / elementSize, "An array of %zd elements is too large.", count);
+    return count * elementSize;
+}
+
+uint16_t
+parcBuffer_GetUint16(PARCBuffer *buffer)
+{
+    return _parcBufferCursor_Load16(_consume(buffer, sizeof(uint16_t)));
+}
+
 uint32_t
 parcBuffer_GetUint32(PARCBuffer *buffer)
 {
-    uint32_t result = 0;
-    for (int i = 0; i < sizeof(uint32_t); i++) {
-        result = result << 8 | parcBuffer_GetUint8(buffer);
-    }
-    return result;
+    return _parcBufferCursor_Load32(_consume(buffer, sizeof(uint32_t)));
 }
 
 uint64_t
 parcBuffer_GetUint64(PARCBuffer *buffer)
 {
-    uint64_t result = 0;
-    for (int i = 0; i < sizeof(uint64_t); i++) {
-        result = result << 8 | parcBuffer_GetUint8(buffer);
+    return _parcBufferCursor_Load64(_consume(buffer, sizeof(uint64_t)));
+}
+
+/*
+ * The array functions check the bounds once and then convert each element with a plain indexed loop,
+ * which the compiler vectorizes into byte shuffles.
+ */
+PARCBuffer *
+parcBuffer_GetUint16Array(PARCBuffer *buffer, size_t count, uint16_t values[count])
+{
+    const uint8_t *bytes = _consume(buffer, _arrayLength(count, sizeof(uint16_t)));
+    for (size_t i = 0; i < count; i++) {
+        values[i] = _parcBufferCursor_Load16(&bytes[i * sizeof(uint16_t)]);
     }
-    return result;
+    return buffer;
+}
+
+PARCBuffer *
+parcBuffer_GetUint32Array(PARCBuffer *buffer, size_t count, uint32_t values[count])
+{
+    const uint8_t *bytes = _consume(buffer, _arrayLength(count, sizeof(uint32_t)));
+    for (size_t i = 0; i < count; i++) {
+        values[i] = _parcBufferCursor_Load32(&bytes[i * sizeof(uint32_t)]);
+    }
+    return buffer;
+}
+
+PARCBuffer *
+parcBuffer_GetUint64Array(PARCBuffer *buffer, size_t count, uint64_t values[count])
+{
+    const uint8_t *bytes = _consume(buffer, _arrayLength(count, sizeof(uint64_t)));
+    for (size_t i = 0; i < count; i++) {
+        values[i] = _parcBufferCursor_Load64(&bytes[i * sizeof(uint64_t)]);
+    }
+    return buffer;
 }
 
 PARCBuffer *
@@ -826,43 +1001,58 @@ parcBuffer_PutUint8(PARCBuffer *buffer, uint8_t value)
 
     parcByteArray_PutByte(buffer->array, _effectivePosition(buffer), value);
     buffer->position++;
+    parcObject_InvalidateHashCode(buffer);
     return buffer;
 }
 
 PARCBuffer *
 parcBuffer_PutUint16(PARCBuffer *buffer, uint16_t value)
 {
-    assertTrue(parcBuffer_Remaining(buffer) >= sizeof(uint16_t),
-               "Buffer overflow");
-
-    parcBuffer_PutUint8(buffer, (value >> 8) & 0xFF);
-    parcBuffer_PutUint8(buffer, value & 0xFF);
+    _parcBufferCursor_Store16(_produce(buffer, sizeof(uint16_t)), value);
     return buffer;
 }
 
 PARCBuffer *
 parcBuffer_PutUint32(PARCBuffer *buffer, uint32_t value)
 {
-    assertTrue(parcBuffer_Remaining(buffer) >= sizeof(uint32_t),
-               "Buffer overflow");
-    for (int i = sizeof(uint32_t) - 1; i > 0; i--) {
-        uint8_t b = value >> (i * 8) & 0xFF;
-        parcBuffer_PutUint8(buffer, b);
-    }
-    parcBuffer_PutUint8(buffer, value & 0xFF);
+    _parcBufferCursor_Store32(_produce(buffer, sizeof(uint32_t)), value);
     return buffer;
 }
 
 PARCBuffer *
 parcBuffer_PutUint64(PARCBuffer *buffer, uint64_t value)
 {
-    assertTrue(parcBuffer_Remaining(buffer) >= sizeof(uint64_t),
-               "Buffer overflow");
-    for (int i = sizeof(uint64_t) - 1; i > 0; i--) {
-        uint8_t b = value >> (i * 8) & 0xFF;
-        parcBuffer_PutUint8(buffer, b);
+    _parcBufferCursor_Store64(_produce(buffer, sizeof(uint64_t)), value);
+    return buffer;
+}
+
+PARCBuffer *
+parcBuffer_PutUint16Array(PARCBuffer *buffer, size_t count, const uint16_t values[count])
+{
+    uint8_t *bytes = _produce(buffer, _arrayLength(count, sizeof(uint16_t)));
+    for (size_t i = 0; i < count; i++) {
+        _parcBufferCursor_Store16(&bytes[i * sizeof(uint16_t)], values[i]);
+    }
+    return buffer;
+}
+
+PARCBuffer *
+parcBuffer_PutUint32Array(PARCBuffer *buffer, size_t count, const uint32_t values[count])
+{
+    uint8_t *bytes = _produce(buffer, _arrayLength(count, sizeof(uint32_t)));
+    for (size_t i = 0; i < count; i++) {
+        _parcBufferCursor_Store32(&bytes[i * sizeof(uint32_t)], values[i]);
+    }
+    return buffer;
+}
+
+PARCBuffer *
+parcBuffer_PutUint64Array(PARCBuffer *buffer, size_t count, const uint64_t values[count])
+{
+    uint8_t *bytes = _produce(buffer, _arrayLength(count, sizeof(uint64_t)));
+    for (size_t i = 0; i < count; i++) {
+        _parcBufferCursor_Store64(&bytes[i * sizeof(uint64_t)], values[i]);
     }
-    parcBuffer_PutUint8(buffer, value & 0xFF);
     return buffer;
 }
 
@@ -873,6 +1063,7 @@ parcBuffer_PutAtIndex(PARCBuffer *buffer, size_t index, uint8_t value)
     assertTrue(_effectiveIndex(buffer, index) < parcBuffer_Limit(buffer), "Buffer overflow");
 
     parcByteArray_PutByte(buffer->array, _effectiveIndex(buffer, index), value);
+    parcObject_InvalidateHashCode(buffer);
     return buffer;
 }
 
@@ -909,24 +1100,35 @@ parcBuffer_PutBuffer(PARCBuffer *result, const PARCBuffer *buffer)
 PARCHashCode
 parcBuffer_HashCode(const PARCBuffer *buffer)
 {
-    PARCHashCode result = 0;
+    // A frozen buffer's hashcode is remembered by parcObject_HashCode.
+    return parcObject_HashCode(buffer);
+}
 
+size_t
+parcBuffer_FindUint8(const PARCBuffer *buffer, uint8_t byte)
+{
     size_t remaining = parcBuffer_Remaining(buffer);
-    if (remaining > 0) {
-        result = parcHashCode_Hash(parcBuffer_Overlay((PARCBuffer *) buffer, 0), parcBuffer_Remaining(buffer));
+    if (remaining == 0) {
+        return SIZE_MAX;
     }
-    return result;
+
+    size_t index = parcByteScan_FindByte(remaining, parcBuffer_Overlay((PARCBuffer *) buffer, 0), byte);
+    return (index == SIZE_MAX) ? SIZE_MAX : parcBuffer_Position(buffer) + index;
 }
 
 size_t
-parcBuffer_FindUint8(const PARCBuffer *buffer, uint8_t byte)
+parcBuffer_FindBytes(const PARCBuffer *buffer, size_t length, const uint8_t pattern[length])
 {
-    for (size_t i = parcBuffer_Position(buffer); i < parcBuffer_Limit(buffer); i++) {
-        if (parcBuffer_GetAtIndex(buffer, i) == byte) {
-            return i;
-        }
+    size_t remaining = parcBuffer_Remaining(buffer);
+    if (length == 0) {
+        return parcBuffer_Position(buffer);
+    }
+    if (remaining < length) {
+        return SIZE_MAX;
     }
-    return SIZE_MAX;
+
+    size_t index = parcByteScan_FindBytes(remaining, parcBuffer_Overlay((PARCBuffer *) buffer, 0), length, pattern);
+    return (index == SIZE_MAX) ? SIZE_MAX : parcBuffer_Position(buffer) + index;
 }
 
 char *
@@ -990,33 +1192,41 @@ parcBuffer_ToHexString(const PARCBuffer *buffer)
     return result;
 }
 
+/*
+ * Advance the position of the buffer to the given index, relative to the position,
+ * or to the limit if the index is SIZE_MAX.
+ */
+static bool
+_skipToIndex(PARCBuffer *buffer, size_t index)
+{
+    if (index == SIZE_MAX) {
+        parcBuffer_SetPosition(buffer, parcBuffer_Limit(buffer));
+        return false;
+    }
+    parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) + index);
+    return true;
+}
+
 bool
 parcBuffer_SkipOver(PARCBuffer *buffer, size_t length, const uint8_t bytesToSkipOver[length])
 {
-    while (parcBuffer_Remaining(buffer) > 0) {
-        uint8_t character = parcBuffer_GetUint8(buffer);
-        if (memchr(bytesToSkipOver, character, length) == NULL) {
-            parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) - 1);
-            return true;
-        }
+    size_t remaining = parcBuffer_Remaining(buffer);
+    if (remaining == 0) {
+        return false;
     }
-    return false;
+
+    return _skipToIndex(buffer, parcByteScan_FindNotAny(remaining, parcBuffer_Overlay(buffer, 0), length, bytesToSkipOver));
 }
 
 bool
 parcBuffer_SkipTo(PARCBuffer *buffer, size_t length, const uint8_t bytesToSkipTo[length])
 {
-    bool result = false;
-
-    while (parcBuffer_Remaining(buffer) > 0) {
-        uint8_t character = parcBuffer_GetUint8(buffer);
-        if (memchr(bytesToSkipTo, character, length) != NULL) {
-            parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) - 1);
-            result = true;
-            break;
-        }
+    size_t remaining = parcBuffer_Remaining(buffer);
+    if (remaining == 0) {
+        return false;
     }
-    return result;
+
+    return _skipToIndex(buffer, parcByteScan_FindAny(remaining, parcBuffer_Overlay(buffer, 0), length, bytesToSkipTo));
 }
 
 uint8_t
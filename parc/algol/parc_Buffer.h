@@ -132,6 +132,11 @@
  * * {@link parcBuffer_GetUint64},
  * * {@link parcBuffer_GetAtIndex}
  *
+ * Arrays of network-order integers are put and got in one call with {@link parcBuffer_PutUint32Array},
+ * {@link parcBuffer_GetUint32Array} and their 16- and 64-bit equivalents.
+ * Encoders and decoders that handle many small fields can check the bounds of a whole region once,
+ * and then read and write it without further checks, with a `PARCBufferCursor` (see parc_BufferCursor.h).
+ *
  * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
  * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
  */
@@ -377,6 +382,67 @@ PARCBuffer *parcBuffer_AllocateCString(const char *string);
  */
 PARCBuffer *parcBuffer_CreateFromArray(const void *bytes, size_t length);
 
+// parc_File.h includes this file, so PARCFile is referred to by its structure.
+struct parc_file;
+
+/**
+ * Create a `PARCBuffer` whose content is the content of @p file, mapped into memory rather than read.
+ *
+ * Pages of the file are read when they are first accessed, so mapping a large file costs nothing up front,
+ * and the pages are shared with the file system cache rather than copied into the heap.
+ * The result is positioned at 0 with its limit at the size of the file,
+ * and can be used anywhere a `PARCBuffer` is accepted.
+ * The mapping is released when the last `PARCBuffer` or `PARCByteArray` that refers to it is released.
+ *
+ * An empty file results in an empty buffer, which is not mapped.
+ * A `PARCByteArrayMap_ReadOnly` buffer must not be written to: that terminates the process with SIGSEGV.
+ *
+ * @param [in] file A pointer to a valid `PARCFile` instance.
+ * @param [in] mode How the memory relates to the file.
+ *
+ * @return non-NULL A pointer to a `PARCBuffer` instance.
+ * @return NULL The file could not be opened or mapped, and errno is set.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCFile *file = parcFile_Create("content.json");
+ *     PARCBuffer *buffer = parcBuffer_MapFile(file, PARCByteArrayMap_ReadOnly);
+ *     parcBuffer_Advise(buffer, PARCByteArrayAdvice_Sequential);
+ *
+ *     PARCJSON *json = parcJSON_ParseBuffer(buffer);
+ *
+ *     parcJSON_Release(&json);
+ *     parcBuffer_Release(&buffer);
+ *     parcFile_Release(&file);
+ * }
+ * @endcode
+ *
+ * @see parcByteArray_MapFile
+ */
+PARCBuffer *parcBuffer_MapFile(const struct parc_file *file, PARCByteArrayMap mode);
+
+/**
+ * Advise the kernel how the remaining bytes of a buffer mapped by {@link parcBuffer_MapFile} will be accessed.
+ *
+ * @param [in] buffer A pointer to a valid `PARCBuffer` instance.
+ * @param [in] advice How the bytes will be accessed.
+ *
+ * @return true The advice was given.
+ * @return false The buffer is not mapped from a file, or the kernel did not accept the advice.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_MapFile(file, PARCByteArrayMap_ReadOnly);
+ *     parcBuffer_Advise(buffer, PARCByteArrayAdvice_Random);
+ * }
+ * @endcode
+ *
+ * @see parcByteArray_Advise
+ */
+bool parcBuffer_Advise(const PARCBuffer *buffer, PARCByteArrayAdvice advice);
+
 /**
  * Parse a null-terminated hexadecimal string to create a new `PARCBuffer` instance.
  *
@@ -1179,6 +1245,87 @@ uint32_t parcBuffer_GetUint32(PARCBuffer *buffer);
  */
 uint64_t parcBuffer_GetUint64(PARCBuffer *buffer);
 
+/**
+ * Read @p count unsigned 16-bit values in network order, starting at the buffer's current position,
+ * into the given array in host order, and then increment the position by 2 times @p count.
+ *
+ * The bounds are checked once for the whole array.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the values.
+ * @param [in] count The number of values to read.
+ * @param [out] values The array to receive the values.
+ *
+ * @return The `PARCBuffer`
+ *
+ * @throws LongBowTrapOutOfBounds If fewer than 2 times @p count bytes remain.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint16_t values[4];
+ *     parcBuffer_GetUint16Array(buffer, 4, values);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_GetUint16
+ * @see parcBufferCursor_Open
+ */
+PARCBuffer *parcBuffer_GetUint16Array(PARCBuffer *buffer, size_t count, uint16_t values[count]);
+
+/**
+ * Read @p count unsigned 32-bit values in network order, starting at the buffer's current position,
+ * into the given array in host order, and then increment the position by 4 times @p count.
+ *
+ * The bounds are checked once for the whole array.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the values.
+ * @param [in] count The number of values to read.
+ * @param [out] values The array to receive the values.
+ *
+ * @return The `PARCBuffer`
+ *
+ * @throws LongBowTrapOutOfBounds If fewer than 4 times @p count bytes remain.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t values[4];
+ *     parcBuffer_GetUint32Array(buffer, 4, values);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_GetUint32
+ * @see parcBufferCursor_Open
+ */
+PARCBuffer *parcBuffer_GetUint32Array(PARCBuffer *buffer, size_t count, uint32_t values[count]);
+
+/**
+ * Read @p count unsigned 64-bit values in network order, starting at the buffer's current position,
+ * into the given array in host order, and then increment the position by 8 times @p count.
+ *
+ * The bounds are checked once for the whole array.
+ *
+ * @param [in,out] buffer The pointer to the instance of `PARCBuffer` containing the values.
+ * @param [in] count The number of values to read.
+ * @param [out] values The array to receive the values.
+ *
+ * @return The `PARCBuffer`
+ *
+ * @throws LongBowTrapOutOfBounds If fewer than 8 times @p count bytes remain.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t values[4];
+ *     parcBuffer_GetUint64Array(buffer, 4, values);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_GetUint64
+ * @see parcBufferCursor_Open
+ */
+PARCBuffer *parcBuffer_GetUint64Array(PARCBuffer *buffer, size_t count, uint64_t values[count]);
+
 /**
  * Read an array of length bytes from the given PARCBuffer, copying them to an array.
  *
@@ -1289,6 +1436,81 @@ PARCBuffer *parcBuffer_PutUint32(PARCBuffer *buffer, uint32_t value);
  */
 PARCBuffer *parcBuffer_PutUint64(PARCBuffer *buffer, uint64_t value);
 
+/**
+ * Insert @p count unsigned 16-bit values into the given `PARCBuffer` at the current position,
+ * in big-endian, network-byte-order.
+ *
+ * Advance the current position by 2 times @p count.
+ * The bounds are checked once for the whole array.
+ *
+ * @param [in,out] buffer A pointer to the `PARCBuffer` instance.
+ * @param [in] count The number of values to insert.
+ * @param [in] values The values to be inserted, in host order.
+ * @return The `PARCBuffer`
+ *
+ * Example:
+ * @code
+ * {
+ *     uint16_t values[] = { 1, 2, 3, 4 };
+ *     parcBuffer_PutUint16Array(buffer, 4, values);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_PutUint16
+ * @see parcBufferCursor_Open
+ */
+PARCBuffer *parcBuffer_PutUint16Array(PARCBuffer *buffer, size_t count, const uint16_t values[count]);
+
+/**
+ * Insert @p count unsigned 32-bit values into the given `PARCBuffer` at the current position,
+ * in big-endian, network-byte-order.
+ *
+ * Advance the current position by 4 times @p count.
+ * The bounds are checked once for the whole array.
+ *
+ * @param [in,out] buffer A pointer to the `PARCBuffer` instance.
+ * @param [in] count The number of values to insert.
+ * @param [in] values The values to be inserted, in host order.
+ * @return The `PARCBuffer`
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t values[] = { 1, 2, 3, 4 };
+ *     parcBuffer_PutUint32Array(buffer, 4, values);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_PutUint32
+ * @see parcBufferCursor_Open
+ */
+PARCBuffer *parcBuffer_PutUint32Array(PARCBuffer *buffer, size_t count, const uint32_t values[count]);
+
+/**
+ * Insert @p count unsigned 64-bit values into the given `PARCBuffer` at the current position,
+ * in big-endian, network-byte-order.
+ *
+ * Advance the current position by 8 times @p count.
+ * The bounds are checked once for the whole array.
+ *
+ * @param [in,out] buffer A pointer to the `PARCBuffer` instance.
+ * @param [in] count The number of values to insert.
+ * @param [in] values The values to be inserted, in host order.
+ * @return The `PARCBuffer`
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t values[] = { 1, 2, 3, 4 };
+ *     parcBuffer_PutUint64Array(buffer, 4, values);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_PutUint64
+ * @see parcBufferCursor_Open
+ */
+PARCBuffer *parcBuffer_PutUint64Array(PARCBuffer *buffer, size_t count, const uint64_t values[count]);
+
 /**
  * Insert unsigned 8-bit value to the given `PARCBuffer` at given index.
  *
@@ -1405,6 +1627,10 @@ PARCBuffer *parcBuffer_PutBuffer(PARCBuffer *buffer, const PARCBuffer *source);
  * then calling the `parcBuffer_HashCode`
  * method on each of the two objects must produce distinct integer results.
  *
+ * The hashcode of a buffer frozen with `parcObject_Freeze` is computed once,
+ * and again only after the buffer's position, limit, or contents are changed by a `PARCBuffer` function.
+ * The contents of a frozen buffer must not be changed by other means, such as through a shared `PARCByteArray`.
+ *
  * @param [in] buffer A pointer to the `PARCBuffer` instance.
  *
  * @return The hashcode for the given instance.
@@ -1450,6 +1676,34 @@ PARCHashCode parcBuffer_HashCode(const PARCBuffer *buffer);
  */
 size_t parcBuffer_FindUint8(const PARCBuffer *buffer, uint8_t byte);
 
+/**
+ * Return the position of the first occurrence of the given sequence of bytes.
+ *
+ * If the sequence does not occur between the current position and the limit,
+ * return `SIZE_MAX` (<stdint.h>).
+ * An empty sequence is found at the current position.
+ *
+ * @param [in] buffer A pointer to a `PARCBuffer` instance.
+ * @param [in] length The number of bytes in @p pattern.
+ * @param [in] pattern The sequence of bytes to search for within the buffer.
+ *
+ * @return The index of the first byte of the first occurrence of @p pattern, or `SIZE_MAX` (<stdint.h>)
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_WrapCString("GET / HTTP/1.1\r\nHost: parc.com\r\n\r\n");
+ *
+ *     size_t endOfHeaders = parcBuffer_FindBytes(buffer, 4, (uint8_t *) "\r\n\r\n");
+ *
+ *     // endOfHeaders is equal to 30.
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_FindUint8
+ */
+size_t parcBuffer_FindBytes(const PARCBuffer *buffer, size_t length, const uint8_t pattern[length]);
+
 /**
  * Produce a null-terminated string representation of the specified `PARCBuffer`
  * from the current position to the limit.
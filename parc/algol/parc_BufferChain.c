@@ -0,0 +1,682 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <string.h>
+
+#include <parc/algol/parc_BufferChain.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_DisplayIndented.h>
+
+/**
+ * A fragment is a slice of the memory of a PARCByteArray, at an index of the chain.
+ */
+typedef struct {
+    PARCBuffer *buffer;     // The slice, with position 0 and limit length.
+    uint8_t *bytes;         // The first byte of the slice.
+    size_t start;           // The index, in the chain, of the first byte of the slice.
+    size_t length;
+} _PARCBufferChainFragment;
+
+struct parc_buffer_chain {
+    _PARCBufferChainFragment *fragments;
+    size_t count;
+    size_t allocated;
+
+    size_t capacity;
+    size_t position;
+    size_t limit;
+
+    // The index of the fragment last read or written, where sequential access finds the next byte.
+    size_t cursor;
+};
+
+#define _parcBufferChain_InitialFragments 4
+
+static void
+_parcBufferChain_Destroy(PARCBufferChain **chainPtr)
+{
+    PARCBufferChain *chain = *chainPtr;
+
+    for (size_t i = 0; i < chain->count; i++) {
+        parcBuffer_Release(&chain->fragments[i].buffer);
+    }
+    if (chain->fragments != NULL) {
+        parcMemory_Deallocate(&chain->fragments);
+    }
+}
+
+parcObject_ExtendPARCObject(PARCBufferChain, _parcBufferChain_Destroy, NULL, NULL, parcBufferChain_Equals, NULL, parcBufferChain_HashCode, NULL);
+
+/**
+ * Return the index of the fragment that holds the byte at @p index of the chain, trying the fragment @p hint
+ * and the one after it before searching.
+ *
+ * @p index must be less than the capacity.
+ */
+static size_t
+_find(const PARCBufferChain *chain, size_t index, size_t hint)
+{
+    for (size_t i = hint; i < chain->count && i <= hint + 1; i++) {
+        const _PARCBufferChainFragment *fragment = &chain->fragments[i];
+        if (index >= fragment->start && index < fragment->start + fragment->length) {
+            return i;
+        }
+    }
+
+    size_t low = 0;
+    size_t high = chain->count;
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (chain->fragments[middle].start <= index) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * Copy @p length bytes of the chain, beginning at @p index, to @p array.
+ *
+ * @return The index of the fragment that holds the last byte copied.
+ */
+static size_t
+_copyOut(const PARCBufferChain *chain, size_t index, size_t length, uint8_t *array)
+{
+    size_t i = _find(chain, index, chain->cursor);
+    while (length > 0) {
+        const _PARCBufferChainFragment *fragment = &chain->fragments[i];
+        size_t offset = index - fragment->start;
+        size_t span = fragment->length - offset;
+        if (span > length) {
+            span = length;
+        }
+        memcpy(array, &fragment->bytes[offset], span);
+        array += span;
+        index += span;
+        length -= span;
+        if (length > 0) {
+            i++;
+        }
+    }
+    return i;
+}
+
+/**
+ * Copy @p length bytes of @p array into the chain, beginning at @p index.
+ *
+ * @return The index of the fragment that holds the last byte copied.
+ */
+static size_t
+_copyIn(PARCBufferChain *chain, size_t index, size_t length, const uint8_t *array)
+{
+    size_t i = _find(chain, index, chain->cursor);
+    while (length > 0) {
+        _PARCBufferChainFragment *fragment = &chain->fragments[i];
+        size_t offset = index - fragment->start;
+        size_t span = fragment->length - offset;
+        if (span > length) {
+            span = length;
+        }
+        memcpy(&fragment->bytes[offset], array, span);
+        array += span;
+        index += span;
+        length -= span;
+        if (length > 0) {
+            i++;
+        }
+    }
+    return i;
+}
+
+/**
+ * Read an integer of @p size bytes in network byte order at the position.
+ */
+static uint64_t
+_getBigEndian(PARCBufferChain *chain, size_t size)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(size > chain->limit - chain->position,
+                      "%zd bytes required, %zd bytes remaining.", size, chain->limit - chain->position);
+
+    const uint8_t *bytes;
+    uint8_t copy[sizeof(uint64_t)];
+
+    size_t i = _find(chain, chain->position, chain->cursor);
+    _PARCBufferChainFragment *fragment = &chain->fragments[i];
+    size_t offset = chain->position - fragment->start;
+    if (offset + size <= fragment->length) {
+        bytes = &fragment->bytes[offset];
+        chain->cursor = i;
+    } else {
+        chain->cursor = _copyOut(chain, chain->position, size, copy);
+        bytes = copy;
+    }
+
+    uint64_t result = 0;
+    for (size_t b = 0; b < size; b++) {
+        result = (result << 8) | bytes[b];
+    }
+    chain->position += size;
+    return result;
+}
+
+/**
+ * Write the integer @p value of @p size bytes in network byte order at the position.
+ */
+static PARCBufferChain *
+_putBigEndian(PARCBufferChain *chain, size_t size, uint64_t value)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(size > chain->limit - chain->position,
+                      "%zd bytes required, %zd bytes remaining.", size, chain->limit - chain->position);
+
+    uint8_t bytes[sizeof(uint64_t)];
+    for (size_t b = size; b > 0; b--) {
+        bytes[b - 1] = (uint8_t) value;
+        value >>= 8;
+    }
+
+    size_t i = _find(chain, chain->position, chain->cursor);
+    _PARCBufferChainFragment *fragment = &chain->fragments[i];
+    size_t offset = chain->position - fragment->start;
+    if (offset + size <= fragment->length) {
+        memcpy(&fragment->bytes[offset], bytes, size);
+        chain->cursor = i;
+    } else {
+        chain->cursor = _copyIn(chain, chain->position, size, bytes);
+    }
+    chain->position += size;
+    return chain;
+}
+
+/**
+ * Append a fragment of @p length bytes of @p byteArray beginning at @p offset.
+ */
+static PARCBufferChain *
+_appendRange(PARCBufferChain *chain, PARCByteArray *byteArray, size_t offset, size_t length)
+{
+    if (length == 0) {
+        return chain;
+    }
+
+    if (chain->count == chain->allocated) {
+        size_t allocated = (chain->allocated == 0) ? _parcBufferChain_InitialFragments : chain->allocated * 2;
+        _PARCBufferChainFragment *fragments =
+            parcMemory_Reallocate(chain->fragments, allocated * sizeof(_PARCBufferChainFragment));
+        assertNotNull(fragments, "parcMemory_Reallocate(%zu) returned NULL", allocated * sizeof(_PARCBufferChainFragment));
+        chain->fragments = fragments;
+        chain->allocated = allocated;
+    }
+
+    PARCBuffer *whole = parcBuffer_WrapByteArray(byteArray, offset, offset + length);
+    assertNotNull(whole, "Cannot wrap %zd bytes at %zd of a PARCByteArray", length, offset);
+    PARCBuffer *slice = parcBuffer_Slice(whole);
+    parcBuffer_Release(&whole);
+
+    _PARCBufferChainFragment *fragment = &chain->fragments[chain->count++];
+    fragment->buffer = slice;
+    fragment->bytes = parcByteArray_AddressOfIndex(byteArray, offset);
+    fragment->start = chain->capacity;
+    fragment->length = length;
+
+    chain->capacity += length;
+    chain->limit = chain->capacity;
+    return chain;
+}
+
+PARCBufferChain *
+parcBufferChain_Create(void)
+{
+    PARCBufferChain *result = parcObject_CreateInstance(PARCBufferChain);
+    if (result != NULL) {
+        result->fragments = NULL;
+        result->count = 0;
+        result->allocated = 0;
+        result->capacity = 0;
+        result->position = 0;
+        result->limit = 0;
+        result->cursor = 0;
+    }
+    return result;
+}
+
+parcObject_ImplementAcquire(parcBufferChain, PARCBufferChain);
+
+parcObject_ImplementRelease(parcBufferChain, PARCBufferChain);
+
+bool
+parcBufferChain_IsValid(const PARCBufferChain *chain)
+{
+    bool result = false;
+
+    if (chain != NULL) {
+        if (chain->position <= chain->limit && chain->limit <= chain->capacity && chain->count <= chain->allocated) {
+            result = true;
+        }
+    }
+    return result;
+}
+
+void
+parcBufferChain_AssertValid(const PARCBufferChain *chain)
+{
+    trapIllegalValueIf(parcBufferChain_IsValid(chain) == false, "PARCBufferChain instance is invalid.");
+}
+
+PARCBufferChain *
+parcBufferChain_Append(PARCBufferChain *chain, const PARCBuffer *buffer)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    parcBuffer_OptionalAssertValid(buffer);
+
+    return _appendRange(chain, parcBuffer_Array(buffer),
+                        parcBuffer_ArrayOffset(buffer) + parcBuffer_Position(buffer), parcBuffer_Remaining(buffer));
+}
+
+PARCBufferChain *
+parcBufferChain_AppendByteArray(PARCBufferChain *chain, PARCByteArray *byteArray, size_t offset, size_t length)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    parcByteArray_OptionalAssertValid(byteArray);
+    trapOutOfBoundsIf(offset > parcByteArray_Capacity(byteArray) || length > parcByteArray_Capacity(byteArray) - offset,
+                      "%zd bytes at %zd exceed the capacity %zd of the PARCByteArray",
+                      length, offset, parcByteArray_Capacity(byteArray));
+
+    return _appendRange(chain, byteArray, offset, length);
+}
+
+PARCBufferChain *
+parcBufferChain_AppendChain(PARCBufferChain *chain, const PARCBufferChain *other)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    parcBufferChain_OptionalAssertValid(other);
+
+    // Appending to chain may move its fragments, when other is chain, so they are indexed afresh each time.
+    size_t index = other->position;
+    size_t limit = other->limit;
+    if (index < limit) {
+        size_t i = _find(other, index, other->cursor);
+        while (index < limit) {
+            const _PARCBufferChainFragment *fragment = &other->fragments[i];
+            size_t offset = index - fragment->start;
+            size_t end = fragment->start + fragment->length;
+            size_t span = ((end < limit) ? end : limit) - index;
+
+            PARCBuffer *buffer = fragment->buffer;
+            _appendRange(chain, parcBuffer_Array(buffer), parcBuffer_ArrayOffset(buffer) + offset, span);
+            index += span;
+            i++;
+        }
+    }
+    return chain;
+}
+
+size_t
+parcBufferChain_GetFragmentCount(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    return chain->count;
+}
+
+PARCBuffer *
+parcBufferChain_GetFragment(const PARCBufferChain *chain, size_t index)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(index >= chain->count, "The index %zd exceeds the number of fragments %zd", index, chain->count);
+
+    return chain->fragments[index].buffer;
+}
+
+size_t
+parcBufferChain_Capacity(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    return chain->capacity;
+}
+
+size_t
+parcBufferChain_Position(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    return chain->position;
+}
+
+PARCBufferChain *
+parcBufferChain_SetPosition(PARCBufferChain *chain, size_t newPosition)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(newPosition > chain->limit, "The new position %zd exceeds the limit %zd", newPosition, chain->limit);
+
+    chain->position = newPosition;
+    return chain;
+}
+
+size_t
+parcBufferChain_Limit(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    return chain->limit;
+}
+
+PARCBufferChain *
+parcBufferChain_SetLimit(PARCBufferChain *chain, size_t newLimit)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(newLimit > chain->capacity, "The new limit %zd exceeds the capacity %zd", newLimit, chain->capacity);
+
+    chain->limit = newLimit;
+    if (chain->position > newLimit) {
+        chain->position = newLimit;
+    }
+    return chain;
+}
+
+size_t
+parcBufferChain_Remaining(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    return chain->limit - chain->position;
+}
+
+bool
+parcBufferChain_HasRemaining(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    return chain->limit != chain->position;
+}
+
+PARCBufferChain *
+parcBufferChain_Flip(PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    chain->limit = chain->position;
+    chain->position = 0;
+    return chain;
+}
+
+PARCBufferChain *
+parcBufferChain_Rewind(PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    chain->position = 0;
+    return chain;
+}
+
+PARCBufferChain *
+parcBufferChain_Clear(PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    chain->position = 0;
+    chain->limit = chain->capacity;
+    return chain;
+}
+
+uint8_t
+parcBufferChain_GetAtIndex(const PARCBufferChain *chain, size_t index)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(index >= chain->limit, "The index %zd exceeds the limit %zd", index, chain->limit);
+
+    const _PARCBufferChainFragment *fragment = &chain->fragments[_find(chain, index, chain->cursor)];
+    return fragment->bytes[index - fragment->start];
+}
+
+uint8_t
+parcBufferChain_GetUint8(PARCBufferChain *chain)
+{
+    return (uint8_t) _getBigEndian(chain, sizeof(uint8_t));
+}
+
+uint16_t
+parcBufferChain_GetUint16(PARCBufferChain *chain)
+{
+    return (uint16_t) _getBigEndian(chain, sizeof(uint16_t));
+}
+
+uint32_t
+parcBufferChain_GetUint32(PARCBufferChain *chain)
+{
+    return (uint32_t) _getBigEndian(chain, sizeof(uint32_t));
+}
+
+uint64_t
+parcBufferChain_GetUint64(PARCBufferChain *chain)
+{
+    return _getBigEndian(chain, sizeof(uint64_t));
+}
+
+PARCBufferChain *
+parcBufferChain_GetBytes(PARCBufferChain *chain, size_t length, uint8_t array[length])
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(length > chain->limit - chain->position,
+                      "%zd bytes required, %zd bytes remaining.", length, chain->limit - chain->position);
+
+    if (length > 0) {
+        chain->cursor = _copyOut(chain, chain->position, length, array);
+        chain->position += length;
+    }
+    return chain;
+}
+
+PARCBufferChain *
+parcBufferChain_PutUint8(PARCBufferChain *chain, uint8_t value)
+{
+    return _putBigEndian(chain, sizeof(uint8_t), value);
+}
+
+PARCBufferChain *
+parcBufferChain_PutUint16(PARCBufferChain *chain, uint16_t value)
+{
+    return _putBigEndian(chain, sizeof(uint16_t), value);
+}
+
+PARCBufferChain *
+parcBufferChain_PutUint32(PARCBufferChain *chain, uint32_t value)
+{
+    return _putBigEndian(chain, sizeof(uint32_t), value);
+}
+
+PARCBufferChain *
+parcBufferChain_PutUint64(PARCBufferChain *chain, uint64_t value)
+{
+    return _putBigEndian(chain, sizeof(uint64_t), value);
+}
+
+PARCBufferChain *
+parcBufferChain_PutArray(PARCBufferChain *chain, size_t length, const uint8_t array[length])
+{
+    parcBufferChain_OptionalAssertValid(chain);
+    trapOutOfBoundsIf(length > chain->limit - chain->position,
+                      "%zd bytes required, %zd bytes remaining.", length, chain->limit - chain->position);
+
+    if (length > 0) {
+        chain->cursor = _copyIn(chain, chain->position, length, array);
+        chain->position += length;
+    }
+    return chain;
+}
+
+size_t
+parcBufferChain_GetIOVec(const PARCBufferChain *chain, size_t count, struct iovec iov[count])
+{
+    parcBufferChain_OptionalAssertValid(chain);
+
+    size_t result = 0;
+
+    size_t index = chain->position;
+    if (index < chain->limit) {
+        size_t i = _find(chain, index, chain->cursor);
+        while (index < chain->limit) {
+            const _PARCBufferChainFragment *fragment = &chain->fragments[i];
+            size_t offset = index - fragment->start;
+            size_t end = fragment->start + fragment->length;
+            size_t span = ((end < chain->limit) ? end : chain->limit) - index;
+
+            if (result < count) {
+                iov[result].iov_base = &fragment->bytes[offset];
+                iov[result].iov_len = span;
+            }
+            result++;
+            index += span;
+            i++;
+        }
+    }
+    return result;
+}
+
+PARCBuffer *
+parcBufferChain_Flatten(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+
+    size_t remaining = chain->limit - chain->position;
+    if (remaining == 0) {
+        return parcBuffer_Allocate(0);
+    }
+
+    const _PARCBufferChainFragment *fragment = &chain->fragments[_find(chain, chain->position, chain->cursor)];
+    size_t offset = chain->position - fragment->start;
+    if (offset + remaining <= fragment->length) {
+        PARCBuffer *buffer = fragment->buffer;
+        PARCBuffer *whole = parcBuffer_WrapByteArray(parcBuffer_Array(buffer), parcBuffer_ArrayOffset(buffer) + offset,
+                                                     parcBuffer_ArrayOffset(buffer) + offset + remaining);
+        PARCBuffer *result = parcBuffer_Slice(whole);
+        parcBuffer_Release(&whole);
+        return result;
+    }
+
+    PARCBuffer *result = parcBuffer_Allocate(remaining);
+    if (result != NULL) {
+        _copyOut(chain, chain->position, remaining, parcByteArray_Array(parcBuffer_Array(result)));
+    }
+    return result;
+}
+
+bool
+parcBufferChain_Equals(const PARCBufferChain *x, const PARCBufferChain *y)
+{
+    if (x == y) {
+        return true;
+    }
+    if (x == NULL || y == NULL) {
+        return false;
+    }
+
+    size_t length = x->limit - x->position;
+    if (length != y->limit - y->position) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+
+    size_t xIndex = x->position;
+    size_t yIndex = y->position;
+    size_t xi = _find(x, xIndex, x->cursor);
+    size_t yi = _find(y, yIndex, y->cursor);
+    while (length > 0) {
+        const _PARCBufferChainFragment *xFragment = &x->fragments[xi];
+        const _PARCBufferChainFragment *yFragment = &y->fragments[yi];
+        size_t xSpan = xFragment->start + xFragment->length - xIndex;
+        size_t ySpan = yFragment->start + yFragment->length - yIndex;
+        size_t span = (xSpan < ySpan) ? xSpan : ySpan;
+        if (span > length) {
+            span = length;
+        }
+
+        if (memcmp(&xFragment->bytes[xIndex - xFragment->start], &yFragment->bytes[yIndex - yFragment->start], span) != 0) {
+            return false;
+        }
+
+        xIndex += span;
+        yIndex += span;
+        length -= span;
+        if (span == xSpan) {
+            xi++;
+        }
+        if (span == ySpan) {
+            yi++;
+        }
+    }
+    return true;
+}
+
+PARCHashCode
+parcBufferChain_HashCode(const PARCBufferChain *chain)
+{
+    parcBufferChain_OptionalAssertValid(chain);
+
+    PARCHashCode result = 0;
+
+    size_t index = chain->position;
+    if (index < chain->limit) {
+        // The hash is computed incrementally, so hashing each fragment in turn hashes the whole.
+        result = parcHashCode_InitialValue;
+        size_t i = _find(chain, index, chain->cursor);
+        while (index < chain->limit) {
+            const _PARCBufferChainFragment *fragment = &chain->fragments[i];
+            size_t offset = index - fragment->start;
+            size_t end = fragment->start + fragment->length;
+            size_t span = ((end < chain->limit) ? end : chain->limit) - index;
+
+            result = parcHashCode_HashImpl(&fragment->bytes[offset], span, result);
+            index += span;
+            i++;
+        }
+    }
+    return result;
+}
+
+void
+parcBufferChain_Display(const PARCBufferChain *chain, int indentation)
+{
+    if (chain == NULL) {
+        parcDisplayIndented_PrintLine(indentation, "PARCBufferChain@NULL");
+    } else {
+        parcDisplayIndented_PrintLine(indentation, "PARCBufferChain@%p {", (void *) chain);
+        parcDisplayIndented_PrintLine(indentation + 1,
+                                      ".capacity=%zd .position=%zd .limit=%zd .fragments=%zd",
+                                      chain->capacity, chain->position, chain->limit, chain->count);
+        for (size_t i = 0; i < chain->count; i++) {
+            parcDisplayIndented_PrintLine(indentation + 1, "[%zd] .start=%zd .length=%zd",
+                                          i, chain->fragments[i].start, chain->fragments[i].length);
+            parcBuffer_Display(chain->fragments[i].buffer, indentation + 2);
+        }
+        parcDisplayIndented_PrintLine(indentation, "}");
+    }
+}
@@ -0,0 +1,524 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_BufferChain.h
+ * @ingroup memory
+ * @brief A sequence of bytes made of slices of other buffers, without copying them.
+ *
+ * A `PARCBufferChain` (a rope) links the remaining bytes of existing `PARCBuffer` and `PARCByteArray` instances,
+ * its fragments, into one logical sequence of bytes.
+ * Appending a fragment acquires a reference to its memory and never copies it,
+ * so a message can be assembled from a header, a large payload, and a trailer in constant time.
+ *
+ * Like a `PARCBuffer`, a chain has a capacity, a limit, and a position,
+ * where the capacity is the total length of its fragments:
+ * _0 <= position <= limit <= capacity_
+ *
+ * The `Get` and `Put` functions read and write in network byte order at the position,
+ * crossing fragment boundaries where necessary, and advance the position.
+ * The fragments share their memory with the buffers they were appended from,
+ * so putting bytes into a chain changes those buffers too.
+ *
+ * The remaining bytes of a chain are handed to the operating system as an array of `struct iovec`
+ * with {@link parcBufferChain_GetIOVec}, for writev(2) or sendmsg(2),
+ * and are only copied into one contiguous `PARCBuffer` when {@link parcBufferChain_Flatten} is called.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_BufferChain_h
+#define libparc_parc_BufferChain_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_ByteArray.h>
+#include <parc/algol/parc_HashCode.h>
+
+struct parc_buffer_chain;
+typedef struct parc_buffer_chain PARCBufferChain;
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcBufferChain_OptionalAssertValid(_instance_)
+#else
+#  define parcBufferChain_OptionalAssertValid(_instance_) parcBufferChain_AssertValid(_instance_)
+#endif
+
+/**
+ * Create an empty `PARCBufferChain`.
+ *
+ * The capacity, limit, and position of the chain are 0.
+ *
+ * @return non-NULL A pointer to a valid `PARCBufferChain` instance.
+ * @return NULL Memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferChain *chain = parcBufferChain_Create();
+ *
+ *     parcBufferChain_Release(&chain);
+ * }
+ * @endcode
+ */
+PARCBufferChain *parcBufferChain_Create(void);
+
+/**
+ * Increase the number of references to a `PARCBufferChain`.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_Acquire(const PARCBufferChain *chain);
+
+/**
+ * Release a previously acquired reference to the specified `PARCBufferChain`.
+ *
+ * When the last reference is released, the references the chain holds to the memory of its fragments are released.
+ *
+ * @param [in,out] chainPtr A pointer to a pointer to the instance to release, which is set to NULL.
+ */
+void parcBufferChain_Release(PARCBufferChain **chainPtr);
+
+/**
+ * Determine if an instance of `PARCBufferChain` is valid.
+ *
+ * @param [in] chain A pointer to a `PARCBufferChain` instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ */
+bool parcBufferChain_IsValid(const PARCBufferChain *chain);
+
+/**
+ * Assert that an instance of `PARCBufferChain` is valid.
+ *
+ * If the instance is not valid, terminate via `trapIllegalValue()`
+ *
+ * @param [in] chain A pointer to a `PARCBufferChain` instance.
+ */
+void parcBufferChain_AssertValid(const PARCBufferChain *chain);
+
+/**
+ * Append the remaining bytes of @p buffer to the end of @p chain, without copying them.
+ *
+ * The position and limit of @p buffer are not changed, and later changes to them do not affect the chain.
+ * The capacity of the chain grows by the number of bytes appended, and its limit is set to its new capacity.
+ * A buffer with no remaining bytes is not appended.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] buffer A pointer to a valid `PARCBuffer` instance.
+ *
+ * @return The value of @p chain.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferChain *chain = parcBufferChain_Create();
+ *     parcBufferChain_Append(chain, header);
+ *     parcBufferChain_Append(chain, payload);
+ *
+ *     parcBufferChain_Release(&chain);
+ * }
+ * @endcode
+ */
+PARCBufferChain *parcBufferChain_Append(PARCBufferChain *chain, const PARCBuffer *buffer);
+
+/**
+ * Append @p length bytes of @p byteArray, starting at @p offset, to the end of @p chain, without copying them.
+ *
+ * The capacity of the chain grows by @p length, and its limit is set to its new capacity.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] byteArray A pointer to a valid `PARCByteArray` instance.
+ * @param [in] offset The index of the first byte of @p byteArray to append.
+ * @param [in] length The number of bytes to append.
+ *
+ * @return The value of @p chain.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCByteArray *array = parcByteArray_Allocate(1024);
+ *
+ *     PARCBufferChain *chain = parcBufferChain_Create();
+ *     parcBufferChain_AppendByteArray(chain, array, 0, 512);
+ *
+ *     parcBufferChain_Release(&chain);
+ *     parcByteArray_Release(&array);
+ * }
+ * @endcode
+ */
+PARCBufferChain *parcBufferChain_AppendByteArray(PARCBufferChain *chain, PARCByteArray *byteArray, size_t offset, size_t length);
+
+/**
+ * Append the remaining bytes of @p other to the end of @p chain, without copying them.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] other A pointer to a valid `PARCBufferChain` instance, which may be @p chain.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_AppendChain(PARCBufferChain *chain, const PARCBufferChain *other);
+
+/**
+ * Get the number of fragments of the chain.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The number of fragments.
+ */
+size_t parcBufferChain_GetFragmentCount(const PARCBufferChain *chain);
+
+/**
+ * Get the fragment of the chain at @p index.
+ *
+ * The result is a slice of the bytes appended, with the position 0 and the limit at its length.
+ * It is not acquired, and is valid while the chain is.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] index The index of the fragment, less than {@link parcBufferChain_GetFragmentCount}.
+ *
+ * @return A pointer to the `PARCBuffer` of the fragment.
+ */
+PARCBuffer *parcBufferChain_GetFragment(const PARCBufferChain *chain, size_t index);
+
+/**
+ * Get the capacity of the chain, which is the total length of its fragments.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The capacity of the chain.
+ */
+size_t parcBufferChain_Capacity(const PARCBufferChain *chain);
+
+/**
+ * Get the position of the chain.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The position of the chain.
+ */
+size_t parcBufferChain_Position(const PARCBufferChain *chain);
+
+/**
+ * Set the position of the chain.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] newPosition The new position, which must not exceed the limit.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_SetPosition(PARCBufferChain *chain, size_t newPosition);
+
+/**
+ * Get the limit of the chain.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The limit of the chain.
+ */
+size_t parcBufferChain_Limit(const PARCBufferChain *chain);
+
+/**
+ * Set the limit of the chain.
+ *
+ * If the position is larger than the new limit, it is set to the new limit.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] newLimit The new limit, which must not exceed the capacity.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_SetLimit(PARCBufferChain *chain, size_t newLimit);
+
+/**
+ * Get the number of bytes between the position and the limit of the chain.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The number of bytes remaining.
+ */
+size_t parcBufferChain_Remaining(const PARCBufferChain *chain);
+
+/**
+ * Determine if there are any bytes between the position and the limit of the chain.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return true There are bytes remaining.
+ * @return false There are no bytes remaining.
+ */
+bool parcBufferChain_HasRemaining(const PARCBufferChain *chain);
+
+/**
+ * Set the limit to the position, and the position to 0.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_Flip(PARCBufferChain *chain);
+
+/**
+ * Set the position to 0, leaving the limit unchanged.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_Rewind(PARCBufferChain *chain);
+
+/**
+ * Set the position to 0 and the limit to the capacity.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_Clear(PARCBufferChain *chain);
+
+/**
+ * Get the byte at @p index of the chain, without changing the position.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] index The index of the byte, less than the limit.
+ *
+ * @return The byte at @p index.
+ */
+uint8_t parcBufferChain_GetAtIndex(const PARCBufferChain *chain, size_t index);
+
+/**
+ * Read the byte at the position of the chain and advance the position by 1.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The byte read.
+ */
+uint8_t parcBufferChain_GetUint8(PARCBufferChain *chain);
+
+/**
+ * Read a 16-bit integer in network byte order at the position of the chain and advance the position by 2.
+ *
+ * The bytes of the integer may be in different fragments.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The integer read.
+ */
+uint16_t parcBufferChain_GetUint16(PARCBufferChain *chain);
+
+/**
+ * Read a 32-bit integer in network byte order at the position of the chain and advance the position by 4.
+ *
+ * The bytes of the integer may be in different fragments.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The integer read.
+ */
+uint32_t parcBufferChain_GetUint32(PARCBufferChain *chain);
+
+/**
+ * Read a 64-bit integer in network byte order at the position of the chain and advance the position by 8.
+ *
+ * The bytes of the integer may be in different fragments.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The integer read.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t first[] = { 0x01, 0x02, 0x03 };
+ *     uint8_t second[] = { 0x04, 0x05, 0x06, 0x07, 0x08 };
+ *     PARCBuffer *a = parcBuffer_Wrap(first, sizeof(first), 0, sizeof(first));
+ *     PARCBuffer *b = parcBuffer_Wrap(second, sizeof(second), 0, sizeof(second));
+ *
+ *     PARCBufferChain *chain = parcBufferChain_Create();
+ *     parcBufferChain_Append(chain, a);
+ *     parcBufferChain_Append(chain, b);
+ *
+ *     uint64_t value = parcBufferChain_GetUint64(chain);
+ *     // value is 0x0102030405060708
+ *
+ *     parcBufferChain_Release(&chain);
+ *     parcBuffer_Release(&a);
+ *     parcBuffer_Release(&b);
+ * }
+ * @endcode
+ */
+uint64_t parcBufferChain_GetUint64(PARCBufferChain *chain);
+
+/**
+ * Copy @p length bytes at the position of the chain into @p array and advance the position by @p length.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] length The number of bytes to copy, no more than the bytes remaining.
+ * @param [out] array The array to receive the bytes.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_GetBytes(PARCBufferChain *chain, size_t length, uint8_t array[length]);
+
+/**
+ * Write a byte at the position of the chain and advance the position by 1.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] value The byte to write.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_PutUint8(PARCBufferChain *chain, uint8_t value);
+
+/**
+ * Write a 16-bit integer in network byte order at the position of the chain and advance the position by 2.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] value The integer to write.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_PutUint16(PARCBufferChain *chain, uint16_t value);
+
+/**
+ * Write a 32-bit integer in network byte order at the position of the chain and advance the position by 4.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] value The integer to write.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_PutUint32(PARCBufferChain *chain, uint32_t value);
+
+/**
+ * Write a 64-bit integer in network byte order at the position of the chain and advance the position by 8.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] value The integer to write.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_PutUint64(PARCBufferChain *chain, uint64_t value);
+
+/**
+ * Copy @p length bytes of @p array to the position of the chain and advance the position by @p length.
+ *
+ * @param [in,out] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] length The number of bytes to copy, no more than the bytes remaining.
+ * @param [in] array The bytes to copy.
+ *
+ * @return The value of @p chain.
+ */
+PARCBufferChain *parcBufferChain_PutArray(PARCBufferChain *chain, size_t length, const uint8_t array[length]);
+
+/**
+ * Describe the remaining bytes of the chain as an array of `struct iovec`, one for each fragment they span.
+ *
+ * At most @p count elements of @p iov are filled in.
+ * The position of the chain is not changed.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ * @param [in] count The number of elements of @p iov.
+ * @param [out] iov The array to fill in, which may be NULL if @p count is 0.
+ *
+ * @return The number of elements needed to describe all of the remaining bytes, which may exceed @p count.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t count = parcBufferChain_GetIOVec(chain, 0, NULL);
+ *     struct iovec iov[count];
+ *     parcBufferChain_GetIOVec(chain, count, iov);
+ *
+ *     ssize_t written = writev(fd, iov, (int) count);
+ *     if (written > 0) {
+ *         parcBufferChain_SetPosition(chain, parcBufferChain_Position(chain) + written);
+ *     }
+ * }
+ * @endcode
+ */
+size_t parcBufferChain_GetIOVec(const PARCBufferChain *chain, size_t count, struct iovec iov[count]);
+
+/**
+ * Create a `PARCBuffer` with the remaining bytes of the chain, with the position 0 and the limit at their length.
+ *
+ * If the remaining bytes are all in one fragment, the result shares their memory and nothing is copied.
+ * Otherwise they are copied into a new contiguous buffer.
+ * The position of the chain is not changed.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return A pointer to a `PARCBuffer` that must be released.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *message = parcBufferChain_Flatten(chain);
+ *
+ *     parcBuffer_Release(&message);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBufferChain_Flatten(const PARCBufferChain *chain);
+
+/**
+ * Determine if two `PARCBufferChain` instances have the same remaining bytes.
+ *
+ * The fragments of the chains need not be the same.
+ *
+ * @param [in] x A pointer to a `PARCBufferChain` instance.
+ * @param [in] y A pointer to a `PARCBufferChain` instance.
+ *
+ * @return true The remaining bytes are equal.
+ * @return false The remaining bytes are not equal.
+ */
+bool parcBufferChain_Equals(const PARCBufferChain *x, const PARCBufferChain *y);
+
+/**
+ * Return a hash code of the remaining bytes of the chain.
+ *
+ * The hash code equals the one of a `PARCBuffer` with the same remaining bytes.
+ *
+ * @param [in] chain A pointer to a valid `PARCBufferChain` instance.
+ *
+ * @return The hash code.
+ */
+PARCHashCode parcBufferChain_HashCode(const PARCBufferChain *chain);
+
+/**
+ * Print a human readable representation of the chain.
+ *
+ * @param [in] chain A pointer to a `PARCBufferChain` instance.
+ * @param [in] indentation The level of indentation to use to pretty-print the output.
+ */
+void parcBufferChain_Display(const PARCBufferChain *chain, int indentation);
+#endif // libparc_parc_BufferChain_h
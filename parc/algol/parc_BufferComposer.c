@@ -36,6 +36,7 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Object.h>
@@ -44,6 +45,7 @@
 
 struct parc_buffer_composer {
     size_t incrementHeuristic;
+    double growthFactor;
     PARCBuffer *buffer;
 };
 
@@ -74,6 +76,9 @@ _create(void)
  * of the underlying `PARCBuffer` is less than the required number of bytes,
  * the underlying PARCBuffer is expanded with sufficient space to accomodate the required number of bytes.
  *
+ * The capacity is multiplied by the growth factor, so that appending n bytes a few at a time copies O(n) bytes in all,
+ * but grows by at least the increment heuristic and by at least enough for the required number of bytes.
+ *
  * The position, limit, and mark remain unchanged.
  * The capacity is increased.
  */
@@ -85,13 +90,19 @@ _ensureRemaining(PARCBufferComposer *composer, size_t required)
     size_t remainingCapacity = parcBuffer_Capacity(composer->buffer) - parcBuffer_Position(composer->buffer);
 
     if (remainingCapacity < required) {
-        size_t incrementAmount = required;
-        if (incrementAmount < composer->incrementHeuristic) {
-            incrementAmount = composer->incrementHeuristic;
+        size_t capacity = parcBuffer_Capacity(composer->buffer);
+        size_t newCapacity = (size_t) (capacity * composer->growthFactor);
+        if (newCapacity < capacity + composer->incrementHeuristic) {
+            newCapacity = capacity + composer->incrementHeuristic;
+        }
+        if (newCapacity < parcBuffer_Position(composer->buffer) + required) {
+            newCapacity = parcBuffer_Position(composer->buffer) + required;
         }
-        size_t newCapacity = parcBuffer_Capacity(composer->buffer) + incrementAmount;
 
         PARCBuffer *newBuffer = parcBuffer_Allocate(newCapacity);
+        if (newBuffer == NULL) {
+            return NULL;
+        }
         parcBuffer_Flip(composer->buffer);
         parcBuffer_PutBuffer(newBuffer, composer->buffer);
         parcBuffer_Release(&composer->buffer);
@@ -106,6 +117,7 @@ parcBufferComposer_AssertValid(const PARCBufferComposer *composer)
 {
     trapIllegalValueIf(composer == NULL, "Parameter must be a non-null pointer to a valid PARCBufferComposer.");
     trapIllegalValueIf(composer->incrementHeuristic < sizeof(void *), "Heuristic cannot be < sizeof(void *) (%zd), actual %zd", sizeof(void *), composer->incrementHeuristic);
+    trapIllegalValueIf(composer->growthFactor < 1.0, "Growth factor cannot be < 1.0, actual %f", composer->growthFactor);
 }
 
 PARCBufferComposer *
@@ -121,6 +133,7 @@ parcBufferComposer_Allocate(size_t size)
     if (result != NULL) {
         result->buffer = parcBuffer_Allocate(size);
         result->incrementHeuristic = parcMemory_RoundUpToCacheLine(size);
+        result->growthFactor = parcBufferComposer_DefaultGrowthFactor;
         if (result->buffer == NULL) {
             result->incrementHeuristic = sizeof(void *); // minimum size
             parcBufferComposer_Release(&result);
@@ -133,6 +146,55 @@ parcObject_ImplementAcquire(parcBufferComposer, PARCBufferComposer);
 
 parcObject_ImplementRelease(parcBufferComposer, PARCBufferComposer);
 
+PARCBufferComposer *
+parcBufferComposer_SetGrowthFactor(PARCBufferComposer *composer, double factor)
+{
+    parcBufferComposer_OptionalAssertValid(composer);
+    trapIllegalValueIf(factor < 1.0, "Growth factor cannot be < 1.0, actual %f", factor);
+
+    composer->growthFactor = factor;
+    return composer;
+}
+
+double
+parcBufferComposer_GetGrowthFactor(const PARCBufferComposer *composer)
+{
+    parcBufferComposer_OptionalAssertValid(composer);
+
+    return composer->growthFactor;
+}
+
+PARCBufferComposer *
+parcBufferComposer_Reserve(PARCBufferComposer *composer, size_t length)
+{
+    return _ensureRemaining(composer, length);
+}
+
+uint8_t *
+parcBufferComposer_GetWritableSpan(PARCBufferComposer *composer, size_t minimum, size_t *available)
+{
+    // Reserve at least one byte, so that there is a byte to take the address of.
+    if (_ensureRemaining(composer, (minimum > 0) ? minimum : 1) == NULL) {
+        return NULL;
+    }
+
+    if (available != NULL) {
+        *available = parcBuffer_Remaining(composer->buffer);
+    }
+    return parcBuffer_Overlay(composer->buffer, 0);
+}
+
+PARCBufferComposer *
+parcBufferComposer_Commit(PARCBufferComposer *composer, size_t length)
+{
+    parcBufferComposer_OptionalAssertValid(composer);
+    trapOutOfBoundsIf(length > parcBuffer_Remaining(composer->buffer),
+                      "Committing %zd bytes exceeds the %zd bytes of the writable span.", length, parcBuffer_Remaining(composer->buffer));
+
+    parcBuffer_SetPosition(composer->buffer, parcBuffer_Position(composer->buffer) + length);
+    return composer;
+}
+
 bool
 parcBufferComposer_Equals(const PARCBufferComposer *x, const PARCBufferComposer *y)
 {
@@ -229,16 +291,7 @@ parcBufferComposer_PutBuffer(PARCBufferComposer *composer, const PARCBuffer *sou
 PARCBufferComposer *
 parcBufferComposer_PutString(PARCBufferComposer *composer, const char *string)
 {
-    PARCBuffer *wrapper = parcBuffer_AllocateCString(string);
-
-    composer = _ensureRemaining(composer, parcBuffer_Remaining(wrapper));
-    if (composer != NULL) {
-        parcBuffer_PutBuffer(composer->buffer, wrapper);
-    }
-
-    parcBuffer_Release(&wrapper);
-
-    return composer;
+    return parcBufferComposer_PutArray(composer, (const unsigned char *) string, strlen(string));
 }
 
 PARCBufferComposer *
@@ -256,20 +309,38 @@ parcBufferComposer_PutStrings(PARCBufferComposer *composer, ...)
     return composer;
 }
 
+/*
+ * Format directly into the composer's buffer.
+ * If the formatted string does not fit in the remaining capacity, vsnprintf reports its length,
+ * and it is formatted again after making room for it.
+ */
 PARCBufferComposer *
 parcBufferComposer_Format(PARCBufferComposer *composer, const char *format, ...)
 {
+    size_t available;
+    char *span = (char *) parcBufferComposer_GetWritableSpan(composer, 1, &available);
+    if (span == NULL) {
+        return NULL;
+    }
+
     va_list ap;
     va_start(ap, format);
-    char *cString;
-    ssize_t written = vasprintf(&cString, format, ap);
-    assertTrue(written >= 0, "Got error from vasprintf");
+    int written = vsnprintf(span, available, format, ap);
     va_end(ap);
+    assertTrue(written >= 0, "Got error from vsnprintf");
 
-    parcBufferComposer_PutString(composer, cString);
-    free(cString);
+    // vsnprintf needs room for the terminating nul, which is not committed.
+    if ((size_t) written >= available) {
+        span = (char *) parcBufferComposer_GetWritableSpan(composer, (size_t) written + 1, &available);
+        if (span == NULL) {
+            return NULL;
+        }
+        va_start(ap, format);
+        vsnprintf(span, available, format, ap);
+        va_end(ap);
+    }
 
-    return composer;
+    return parcBufferComposer_Commit(composer, (size_t) written);
 }
 
 PARCBuffer *
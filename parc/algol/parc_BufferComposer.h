@@ -51,6 +51,12 @@
 struct parc_buffer_composer;
 typedef struct parc_buffer_composer PARCBufferComposer;
 
+/**
+ * The factor by which a `PARCBufferComposer` multiplies its capacity when it must grow,
+ * unless it is changed with {@link parcBufferComposer_SetGrowthFactor}.
+ */
+#define parcBufferComposer_DefaultGrowthFactor 2.0
+
 /**
  * Create an empty (zero-length) `PARCBufferComposer`.
  *
@@ -415,17 +421,129 @@ PARCBufferComposer *parcBufferComposer_PutString(PARCBufferComposer *composer, c
  */
 PARCBufferComposer *parcBufferComposer_PutStrings(PARCBufferComposer *composer, ...);
 
+/**
+ * Set the factor by which the given `PARCBufferComposer` multiplies its capacity when it must grow.
+ *
+ * Growing geometrically means that appending n bytes, however small the pieces, copies O(n) bytes in all.
+ * A factor of 1.0 grows the capacity by a fixed increment each time, which uses less memory but copies O(n^2) bytes.
+ * Whatever the factor, the capacity always grows by enough for the bytes being appended.
+ *
+ * @param [in,out] composer A pointer to a valid `PARCBufferComposer` instance.
+ * @param [in] factor The growth factor, at least 1.0.
+ *
+ * @return The value of @p composer.
+ *
+ * @throws LongBowTrapIllegalValue If @p factor is less than 1.0.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferComposer *composer = parcBufferComposer_Create();
+ *     parcBufferComposer_SetGrowthFactor(composer, 1.5);
+ * }
+ * @endcode
+ */
+PARCBufferComposer *parcBufferComposer_SetGrowthFactor(PARCBufferComposer *composer, double factor);
+
+/**
+ * Get the factor by which the given `PARCBufferComposer` multiplies its capacity when it must grow.
+ *
+ * @param [in] composer A pointer to a valid `PARCBufferComposer` instance.
+ *
+ * @return The growth factor.
+ *
+ * Example:
+ * @code
+ * {
+ *     double factor = parcBufferComposer_GetGrowthFactor(composer);
+ * }
+ * @endcode
+ */
+double parcBufferComposer_GetGrowthFactor(const PARCBufferComposer *composer);
+
+/**
+ * Ensure that at least @p length more bytes can be appended to the given `PARCBufferComposer` without it growing.
+ *
+ * Reserving the final size before appending many small pieces avoids growing, and copying, along the way.
+ *
+ * @param [in,out] composer A pointer to a valid `PARCBufferComposer` instance.
+ * @param [in] length The number of bytes to reserve.
+ *
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL The value of @p composer.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferComposer_Reserve(composer, count * sizeof(uint32_t));
+ *     for (size_t i = 0; i < count; i++) {
+ *         parcBufferComposer_PutUint32(composer, values[i]);
+ *     }
+ * }
+ * @endcode
+ */
+PARCBufferComposer *parcBufferComposer_Reserve(PARCBufferComposer *composer, size_t length);
+
+/**
+ * Get a pointer to memory, following the content of the given `PARCBufferComposer`, that the caller may write directly.
+ *
+ * The span has room for at least @p minimum bytes, and @p available is set to its actual length.
+ * Nothing is appended until the number of bytes written is committed with {@link parcBufferComposer_Commit}.
+ * The pointer is invalidated by any other call that appends to the composer.
+ *
+ * @param [in,out] composer A pointer to a valid `PARCBufferComposer` instance.
+ * @param [in] minimum The minimum length of the span.
+ * @param [out] available If not NULL, set to the length of the span, which is at least @p minimum.
+ *
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL A pointer to the first byte of the span.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t available;
+ *     uint8_t *span = parcBufferComposer_GetWritableSpan(composer, 64, &available);
+ *     size_t length = encode(span, available);
+ *     parcBufferComposer_Commit(composer, length);
+ * }
+ * @endcode
+ */
+uint8_t *parcBufferComposer_GetWritableSpan(PARCBufferComposer *composer, size_t minimum, size_t *available);
+
+/**
+ * Append the first @p length bytes written to the span returned by {@link parcBufferComposer_GetWritableSpan}.
+ *
+ * @param [in,out] composer A pointer to a valid `PARCBufferComposer` instance.
+ * @param [in] length The number of bytes written, at most the length of the span.
+ *
+ * @return The value of @p composer.
+ *
+ * @throws LongBowTrapOutOfBounds If @p length exceeds the length of the span.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t available;
+ *     char *span = (char *) parcBufferComposer_GetWritableSpan(composer, 20, &available);
+ *     parcBufferComposer_Commit(composer, (size_t) sprintf(span, "%" PRIu64, value));
+ * }
+ * @endcode
+ */
+PARCBufferComposer *parcBufferComposer_Commit(PARCBufferComposer *composer, size_t length);
+
 /**
  * Append a formatted nul-terminated, C string string to the given `PARCBufferComposer` instance.
  * The input `PARCBufferComposer` instance is modified.
  *
- * The format string is a nul-terminated C string compatible with the `vasprintf(3)` C library function.
+ * The format string is a nul-terminated C string compatible with the `vsnprintf(3)` C library function.
+ * The string is formatted directly into the composer, with no intermediate copy.
  *
  * @param [in,out] composer A pointer to `PARCBufferComposer`.
- * @param [in] format The format string compatible with the `vasprintf(3)` C library function.
+ * @param [in] format The format string compatible with the `vsnprintf(3)` C library function.
  * @param [in] ... Remaining parameters used to format the string.
  *
- * @return The same pointer as the `composer` parameter.
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL The same pointer as the `composer` parameter.
  *
  * Example:
  * @code
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_BufferCursor.h>
+
+// An empty region may be at the very end of the array, where there is no byte to take the address of.
+static uint8_t _parcBufferCursor_Empty;
+
+void
+parcBufferCursor_Open(PARCBufferCursor *cursor, PARCBuffer *buffer, size_t length)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+    trapOutOfBoundsIf(length > parcBuffer_Remaining(buffer),
+                      "The cursor length (%zd) exceeds the remaining bytes (%zd) of the PARCBuffer.",
+                      length, parcBuffer_Remaining(buffer));
+
+    cursor->buffer = buffer;
+    cursor->start = (length == 0) ? &_parcBufferCursor_Empty : parcBuffer_Overlay(buffer, 0);
+    cursor->next = cursor->start;
+    cursor->end = cursor->start + length;
+}
+
+PARCBuffer *
+parcBufferCursor_Close(PARCBufferCursor *cursor)
+{
+    PARCBuffer *result = cursor->buffer;
+
+    trapOutOfBoundsIf(cursor->next > cursor->end,
+                      "The cursor was advanced %zd bytes beyond the end of its region.", (size_t) (cursor->next - cursor->end));
+
+    parcBuffer_SetPosition(result, parcBuffer_Position(result) + parcBufferCursor_Consumed(cursor));
+    cursor->buffer = NULL;
+    return result;
+}
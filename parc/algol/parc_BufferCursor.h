@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_BufferCursor.h
+ * @ingroup memory
+ * @brief Read and write a region of a PARCBuffer without checking bounds on every access.
+ *
+ * Every `PARCBuffer` get and put function validates the buffer and checks its bounds.
+ * In an encoder or decoder that handles many small fields, those checks can cost more than the work itself.
+ *
+ * A `PARCBufferCursor` checks the bounds of a whole region of a buffer once, when it is opened,
+ * and then reads and writes the region with inline functions that do no checking at all.
+ * The caller is responsible for not reading or writing beyond the length of the region
+ * ({@link parcBufferCursor_Remaining} tells how much is left).
+ * Closing the cursor advances the position of the buffer past the bytes that were read or written.
+ *
+ * A cursor is a small structure, normally on the stack, and does not hold a reference to its buffer:
+ * the buffer must not be released, or have its position or limit changed, while the cursor is open.
+ *
+ * Like the `PARCBuffer` functions, multi-byte values are read and written in network byte order.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_BufferCursor_h
+#define libparc_parc_BufferCursor_h
+
+#include <stdint.h>
+#include <string.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+/**
+ * @typedef PARCBufferCursor
+ * @brief A region of a `PARCBuffer` that is read and written without checking bounds.
+ *
+ * The members are public only so the accessors can be inline; use the functions to manipulate them.
+ */
+typedef struct parc_buffer_cursor {
+    PARCBuffer *buffer;
+    uint8_t *start;
+    uint8_t *next;
+    uint8_t *end;
+} PARCBufferCursor;
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#  define _parcBufferCursor_Network16(_value_) (_value_)
+#  define _parcBufferCursor_Network32(_value_) (_value_)
+#  define _parcBufferCursor_Network64(_value_) (_value_)
+#else
+#  define _parcBufferCursor_Network16(_value_) __builtin_bswap16(_value_)
+#  define _parcBufferCursor_Network32(_value_) __builtin_bswap32(_value_)
+#  define _parcBufferCursor_Network64(_value_) __builtin_bswap64(_value_)
+#endif
+
+/*
+ * Load and store network byte order values at any alignment.
+ * The compiler turns the memcpy and byte swap into a single load or store and a bswap (or movbe) instruction.
+ */
+static inline uint16_t
+_parcBufferCursor_Load16(const uint8_t *bytes)
+{
+    uint16_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return _parcBufferCursor_Network16(value);
+}
+
+static inline uint32_t
+_parcBufferCursor_Load32(const uint8_t *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return _parcBufferCursor_Network32(value);
+}
+
+static inline uint64_t
+_parcBufferCursor_Load64(const uint8_t *bytes)
+{
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return _parcBufferCursor_Network64(value);
+}
+
+static inline void
+_parcBufferCursor_Store16(uint8_t *bytes, uint16_t value)
+{
+    value = _parcBufferCursor_Network16(value);
+    memcpy(bytes, &value, sizeof(value));
+}
+
+static inline void
+_parcBufferCursor_Store32(uint8_t *bytes, uint32_t value)
+{
+    value = _parcBufferCursor_Network32(value);
+    memcpy(bytes, &value, sizeof(value));
+}
+
+static inline void
+_parcBufferCursor_Store64(uint8_t *bytes, uint64_t value)
+{
+    value = _parcBufferCursor_Network64(value);
+    memcpy(bytes, &value, sizeof(value));
+}
+
+/**
+ * Open a cursor over the next @p length bytes of the given `PARCBuffer`, starting at its position.
+ *
+ * This is the only place the bounds of the region are checked.
+ *
+ * @param [out] cursor A pointer to the `PARCBufferCursor` to initialise.
+ * @param [in] buffer A pointer to a valid `PARCBuffer` instance.
+ * @param [in] length The number of bytes of the region, which must not exceed the remaining bytes of @p buffer.
+ *
+ * @throws LongBowTrapOutOfBounds If @p length exceeds the remaining bytes of @p buffer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferCursor cursor;
+ *     parcBufferCursor_Open(&cursor, buffer, 4 + 2 + length);
+ *     parcBufferCursor_PutUint32(&cursor, type);
+ *     parcBufferCursor_PutUint16(&cursor, length);
+ *     parcBufferCursor_PutArray(&cursor, length, value);
+ *     parcBufferCursor_Close(&cursor);
+ * }
+ * @endcode
+ *
+ * @see parcBufferCursor_Close
+ */
+void parcBufferCursor_Open(PARCBufferCursor *cursor, PARCBuffer *buffer, size_t length);
+
+/**
+ * Close the given cursor, advancing the position of its buffer past the bytes that were read or written.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ *
+ * @return The `PARCBuffer` the cursor was opened on.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferCursor cursor;
+ *     parcBufferCursor_Open(&cursor, buffer, 8);
+ *     uint32_t type = parcBufferCursor_GetUint32(&cursor);
+ *     uint32_t length = parcBufferCursor_GetUint32(&cursor);
+ *     parcBufferCursor_Close(&cursor);
+ * }
+ * @endcode
+ *
+ * @see parcBufferCursor_Open
+ */
+PARCBuffer *parcBufferCursor_Close(PARCBufferCursor *cursor);
+
+/**
+ * Return the number of bytes of the region that have not been read or written.
+ *
+ * @param [in] cursor A pointer to an open `PARCBufferCursor`.
+ *
+ * @return The number of bytes remaining in the region.
+ *
+ * Example:
+ * @code
+ * {
+ *     while (parcBufferCursor_Remaining(&cursor) >= 4) {
+ *         sum += parcBufferCursor_GetUint32(&cursor);
+ *     }
+ * }
+ * @endcode
+ */
+static inline size_t
+parcBufferCursor_Remaining(const PARCBufferCursor *cursor)
+{
+    return (size_t) (cursor->end - cursor->next);
+}
+
+/**
+ * Return the number of bytes of the region that have been read or written.
+ *
+ * @param [in] cursor A pointer to an open `PARCBufferCursor`.
+ *
+ * @return The number of bytes consumed from the region.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t fieldStart = parcBufferCursor_Consumed(&cursor);
+ * }
+ * @endcode
+ */
+static inline size_t
+parcBufferCursor_Consumed(const PARCBufferCursor *cursor)
+{
+    return (size_t) (cursor->next - cursor->start);
+}
+
+/**
+ * Advance the cursor over @p length bytes without reading them.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ * @param [in] length The number of bytes to skip.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferCursor_Skip(&cursor, 2); // reserved
+ * }
+ * @endcode
+ */
+static inline void
+parcBufferCursor_Skip(PARCBufferCursor *cursor, size_t length)
+{
+    cursor->next += length;
+}
+
+/**
+ * Read the next byte of the region.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ *
+ * @return The byte.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t version = parcBufferCursor_GetUint8(&cursor);
+ * }
+ * @endcode
+ */
+static inline uint8_t
+parcBufferCursor_GetUint8(PARCBufferCursor *cursor)
+{
+    return *cursor->next++;
+}
+
+/**
+ * Read the next 2 bytes of the region as a network byte order `uint16_t`.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ *
+ * @return The value in host byte order.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint16_t length = parcBufferCursor_GetUint16(&cursor);
+ * }
+ * @endcode
+ */
+static inline uint16_t
+parcBufferCursor_GetUint16(PARCBufferCursor *cursor)
+{
+    uint16_t result = _parcBufferCursor_Load16(cursor->next);
+    cursor->next += sizeof(uint16_t);
+    return result;
+}
+
+/**
+ * Read the next 4 bytes of the region as a network byte order `uint32_t`.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ *
+ * @return The value in host byte order.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t type = parcBufferCursor_GetUint32(&cursor);
+ * }
+ * @endcode
+ */
+static inline uint32_t
+parcBufferCursor_GetUint32(PARCBufferCursor *cursor)
+{
+    uint32_t result = _parcBufferCursor_Load32(cursor->next);
+    cursor->next += sizeof(uint32_t);
+    return result;
+}
+
+/**
+ * Read the next 8 bytes of the region as a network byte order `uint64_t`.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ *
+ * @return The value in host byte order.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t sequence = parcBufferCursor_GetUint64(&cursor);
+ * }
+ * @endcode
+ */
+static inline uint64_t
+parcBufferCursor_GetUint64(PARCBufferCursor *cursor)
+{
+    uint64_t result = _parcBufferCursor_Load64(cursor->next);
+    cursor->next += sizeof(uint64_t);
+    return result;
+}
+
+/**
+ * Copy the next @p length bytes of the region into @p array.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ * @param [in] length The number of bytes to copy.
+ * @param [out] array The array to copy the bytes into.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t name[16];
+ *     parcBufferCursor_GetArray(&cursor, sizeof(name), name);
+ * }
+ * @endcode
+ */
+static inline void
+parcBufferCursor_GetArray(PARCBufferCursor *cursor, size_t length, uint8_t array[length])
+{
+    memcpy(array, cursor->next, length);
+    cursor->next += length;
+}
+
+/**
+ * Write a byte to the region.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ * @param [in] value The byte to write.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferCursor_PutUint8(&cursor, 1);
+ * }
+ * @endcode
+ */
+static inline void
+parcBufferCursor_PutUint8(PARCBufferCursor *cursor, uint8_t value)
+{
+    *cursor->next++ = value;
+}
+
+/**
+ * Write a `uint16_t` to the region in network byte order.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ * @param [in] value The value to write, in host byte order.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferCursor_PutUint16(&cursor, length);
+ * }
+ * @endcode
+ */
+static inline void
+parcBufferCursor_PutUint16(PARCBufferCursor *cursor, uint16_t value)
+{
+    _parcBufferCursor_Store16(cursor->next, value);
+    cursor->next += sizeof(uint16_t);
+}
+
+/**
+ * Write a `uint32_t` to the region in network byte order.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ * @param [in] value The value to write, in host byte order.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferCursor_PutUint32(&cursor, type);
+ * }
+ * @endcode
+ */
+static inline void
+parcBufferCursor_PutUint32(PARCBufferCursor *cursor, uint32_t value)
+{
+    _parcBufferCursor_Store32(cursor->next, value);
+    cursor->next += sizeof(uint32_t);
+}
+
+/**
+ * Write a `uint64_t` to the region in network byte order.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ * @param [in] value The value to write, in host byte order.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferCursor_PutUint64(&cursor, sequence);
+ * }
+ * @endcode
+ */
+static inline void
+parcBufferCursor_PutUint64(PARCBufferCursor *cursor, uint64_t value)
+{
+    _parcBufferCursor_Store64(cursor->next, value);
+    cursor->next += sizeof(uint64_t);
+}
+
+/**
+ * Copy @p length bytes from @p array into the region.
+ *
+ * @param [in,out] cursor A pointer to an open `PARCBufferCursor`.
+ * @param [in] length The number of bytes to copy.
+ * @param [in] array The bytes to copy.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferCursor_PutArray(&cursor, 5, (uint8_t *) "hello");
+ * }
+ * @endcode
+ */
+static inline void
+parcBufferCursor_PutArray(PARCBufferCursor *cursor, size_t length, const uint8_t array[length])
+{
+    memcpy(cursor->next, array, length);
+    cursor->next += length;
+}
+#endif // libparc_parc_BufferCursor_h
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <pthread.h>
+#include <string.h>
+
+#include <parc/algol/parc_BufferPool.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#include "internal_parc_BufferPool.h"
+
+/*
+ * The idle buffers of each class are divided between this many shards,
+ * each with its own lock, and each thread takes and returns buffers through its own shard first.
+ */
+#define _shardCount 8
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t count;
+    PARCBuffer **buffers;   // Room for the capacity of the class, which is the most any one shard can hold.
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t recycled;
+    uint64_t discarded;
+} _PARCBufferPoolShard;
+
+/**
+ * The buffers handed out by a class record its pool and index,
+ * so that the PARCBuffer destructor offers them back to the class.
+ */
+typedef struct {
+    PARCBufferPool *pool;
+
+    size_t size;
+    size_t capacity;
+
+    size_t idle;            // The number of buffers in all of the shards.
+    size_t outstanding;
+    size_t highWater;
+
+    _PARCBufferPoolShard shards[_shardCount];
+} _PARCBufferPoolClass;
+
+struct parc_buffer_pool {
+    size_t classCount;
+    _PARCBufferPoolClass *classes;
+};
+
+static pthread_once_t _parcBufferPool_Once = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcBufferPool_ShardKey;
+static unsigned _parcBufferPool_NextShard = 0;
+
+static void
+_parcBufferPool_Initialize(void)
+{
+    pthread_key_create(&_parcBufferPool_ShardKey, NULL);
+}
+
+// The index of the calling thread's shard, assigned in turn to each thread as it first uses a pool.
+static unsigned
+_threadShard(void)
+{
+    pthread_once(&_parcBufferPool_Once, _parcBufferPool_Initialize);
+
+    uintptr_t shard = (uintptr_t) pthread_getspecific(_parcBufferPool_ShardKey);
+    if (shard == 0) {
+        shard = (__sync_fetch_and_add(&_parcBufferPool_NextShard, 1) % _shardCount) + 1;
+        pthread_setspecific(_parcBufferPool_ShardKey, (void *) shard);
+    }
+    return (unsigned) (shard - 1);
+}
+
+static PARCBuffer *
+_shard_Pop(_PARCBufferPoolShard *shard)
+{
+    PARCBuffer *result = NULL;
+    if (shard->count > 0) {
+        result = shard->buffers[--shard->count];
+    }
+    return result;
+}
+
+// Take an idle buffer from the thread's shard, or else from any other shard that is not locked.
+static PARCBuffer *
+_class_Pop(_PARCBufferPoolClass *class, unsigned home)
+{
+    _PARCBufferPoolShard *shard = &class->shards[home];
+    pthread_mutex_lock(&shard->lock);
+    PARCBuffer *result = _shard_Pop(shard);
+    if (result != NULL) {
+        shard->hits++;
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    for (unsigned i = 1; result == NULL && i < _shardCount; i++) {
+        _PARCBufferPoolShard *other = &class->shards[(home + i) % _shardCount];
+        if (other->count > 0 && pthread_mutex_trylock(&other->lock) == 0) {
+            result = _shard_Pop(other);
+            if (result != NULL) {
+                other->hits++;
+            }
+            pthread_mutex_unlock(&other->lock);
+        }
+    }
+
+    if (result != NULL) {
+        __sync_fetch_and_sub(&class->idle, 1);
+    }
+    return result;
+}
+
+// Keep the buffer in the thread's shard, unless the class already holds its capacity of idle buffers.
+static bool
+_class_Push(_PARCBufferPoolClass *class, unsigned home, PARCBuffer *buffer)
+{
+    if (__sync_add_and_fetch(&class->idle, 1) > class->capacity) {
+        __sync_fetch_and_sub(&class->idle, 1);
+        return false;
+    }
+
+    _PARCBufferPoolShard *shard = &class->shards[home];
+    pthread_mutex_lock(&shard->lock);
+    shard->buffers[shard->count++] = buffer;
+    shard->recycled++;
+    pthread_mutex_unlock(&shard->lock);
+    return true;
+}
+
+/*
+ * A buffer can only be reused if nothing else refers to its memory, and it has not been resized.
+ * A resized buffer has a new array of exactly its new capacity, so the capacity is enough to tell.
+ */
+static bool
+_class_IsRecyclable(const _PARCBufferPoolClass *class, PARCBuffer *buffer)
+{
+    return parcBuffer_Capacity(buffer) == class->size
+           && parcObject_GetReferenceCount(parcBuffer_Array(buffer)) == 1;
+}
+
+static PARCBuffer *
+_class_Allocate(_PARCBufferPoolClass *class)
+{
+    PARCBuffer *result = parcBuffer_Allocate(class->size);
+    if (result != NULL) {
+        internal_parcBuffer_SetPool(result, class->pool, (size_t) (class - class->pool->classes));
+    }
+    return result;
+}
+
+/*
+ * A class with outstanding buffers holds one reference to its pool,
+ * acquired when the first is handed out and released when the last is returned.
+ */
+static void
+_class_CountOutstanding(_PARCBufferPoolClass *class)
+{
+    size_t outstanding = __sync_add_and_fetch(&class->outstanding, 1);
+    if (outstanding == 1) {
+        parcBufferPool_Acquire(class->pool);
+    }
+
+    size_t highWater = class->highWater;
+    while (outstanding > highWater) {
+        highWater = __sync_val_compare_and_swap(&class->highWater, highWater, outstanding);
+    }
+}
+
+/*
+ * Invoked by the PARCBuffer destructor when the last reference to a buffer handed out by a class is released.
+ * The buffer is kept, with a single reference owned by the class, or it is unlinked from the pool to be deallocated.
+ */
+bool
+internal_parcBufferPool_Recycle(PARCBufferPool *pool, size_t classIndex, PARCBuffer *buffer)
+{
+    _PARCBufferPoolClass *class = &pool->classes[classIndex];
+    unsigned home = _threadShard();
+
+    bool result = _class_IsRecyclable(class, buffer) && _class_Push(class, home, buffer);
+    if (!result) {
+        __sync_fetch_and_add(&class->shards[home].discarded, 1);
+        internal_parcBuffer_SetPool(buffer, NULL, 0);
+    }
+
+    // This must be last: releasing the reference held by the class may deallocate the pool.
+    if (__sync_sub_and_fetch(&class->outstanding, 1) == 0) {
+        parcBufferPool_Release(&pool);
+    }
+    return result;
+}
+
+static size_t
+_parcBufferPool_Drain(PARCBufferPool *pool)
+{
+    size_t result = 0;
+
+    for (size_t i = 0; i < pool->classCount; i++) {
+        _PARCBufferPoolClass *class = &pool->classes[i];
+        for (unsigned s = 0; s < _shardCount; s++) {
+            _PARCBufferPoolShard *shard = &class->shards[s];
+            pthread_mutex_lock(&shard->lock);
+            PARCBuffer *buffer;
+            while ((buffer = _shard_Pop(shard)) != NULL) {
+                internal_parcBuffer_SetPool(buffer, NULL, 0);
+                parcBuffer_Release(&buffer);
+                __sync_fetch_and_sub(&class->idle, 1);
+                result++;
+            }
+            pthread_mutex_unlock(&shard->lock);
+        }
+    }
+    return result;
+}
+
+static void
+_parcBufferPool_Destroy(PARCBufferPool **poolPtr)
+{
+    PARCBufferPool *pool = *poolPtr;
+
+    _parcBufferPool_Drain(pool);
+
+    for (size_t i = 0; i < pool->classCount; i++) {
+        _PARCBufferPoolClass *class = &pool->classes[i];
+        for (unsigned s = 0; s < _shardCount; s++) {
+            pthread_mutex_destroy(&class->shards[s].lock);
+            if (class->shards[s].buffers != NULL) {
+                parcMemory_Deallocate(&class->shards[s].buffers);
+            }
+        }
+    }
+    if (pool->classes != NULL) {
+        parcMemory_Deallocate(&pool->classes);
+    }
+}
+
+parcObject_ExtendPARCObject(PARCBufferPool, _parcBufferPool_Destroy, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static bool
+_class_Init(_PARCBufferPoolClass *class, PARCBufferPool *pool, const PARCBufferPoolClass *configuration)
+{
+    class->pool = pool;
+    class->size = configuration->size;
+    class->capacity = configuration->capacity;
+    class->idle = 0;
+    class->outstanding = 0;
+    class->highWater = 0;
+
+    bool result = true;
+    for (unsigned s = 0; s < _shardCount; s++) {
+        _PARCBufferPoolShard *shard = &class->shards[s];
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->count = 0;
+        shard->hits = shard->misses = shard->recycled = shard->discarded = 0;
+        shard->buffers = parcMemory_Allocate(sizeof(PARCBuffer *) * (class->capacity > 0 ? class->capacity : 1));
+        if (shard->buffers == NULL) {
+            result = false;
+        }
+    }
+
+    size_t preallocate = (configuration->preallocate < class->capacity) ? configuration->preallocate : class->capacity;
+    for (size_t i = 0; result && i < preallocate; i++) {
+        PARCBuffer *buffer = _class_Allocate(class);
+        if (buffer == NULL) {
+            result = false;
+        } else {
+            _PARCBufferPoolShard *shard = &class->shards[i % _shardCount];
+            shard->buffers[shard->count++] = buffer;
+            class->idle++;
+        }
+    }
+    return result;
+}
+
+PARCBufferPool *
+parcBufferPool_Create(size_t classCount, const PARCBufferPoolClass classes[classCount])
+{
+    trapIllegalValueIf(classCount == 0, "A PARCBufferPool must have at least one class.");
+    for (size_t i = 1; i < classCount; i++) {
+        trapIllegalValueIf(classes[i].size <= classes[i - 1].size,
+                           "The classes must be in strictly ascending order of size, class %zd is %zd bytes after %zd bytes",
+                           i, classes[i].size, classes[i - 1].size);
+    }
+
+    PARCBufferPool *result = parcObject_CreateInstance(PARCBufferPool);
+    if (result != NULL) {
+        result->classCount = 0;
+        result->classes = parcMemory_AllocateAndClear(sizeof(_PARCBufferPoolClass) * classCount);
+        if (result->classes == NULL) {
+            parcBufferPool_Release(&result);
+            return NULL;
+        }
+
+        for (size_t i = 0; i < classCount; i++) {
+            bool initialised = _class_Init(&result->classes[i], result, &classes[i]);
+            result->classCount++;
+            if (!initialised) {
+                parcBufferPool_Release(&result);
+                return NULL;
+            }
+        }
+    }
+    return result;
+}
+
+parcObject_ImplementAcquire(parcBufferPool, PARCBufferPool);
+
+parcObject_ImplementRelease(parcBufferPool, PARCBufferPool);
+
+bool
+parcBufferPool_IsValid(const PARCBufferPool *pool)
+{
+    bool result = false;
+
+    if (pool != NULL) {
+        if (parcObject_IsValid(pool)) {
+            if (pool->classCount > 0 && pool->classes != NULL) {
+                result = true;
+            }
+        }
+    }
+    return result;
+}
+
+void
+parcBufferPool_AssertValid(const PARCBufferPool *pool)
+{
+    trapIllegalValueIf(parcBufferPool_IsValid(pool) == false, "PARCBufferPool instance is invalid.");
+}
+
+// The smallest class whose buffers hold at least size bytes, or NULL if there is none.
+static _PARCBufferPoolClass *
+_findClass(const PARCBufferPool *pool, size_t size)
+{
+    for (size_t i = 0; i < pool->classCount; i++) {
+        if (pool->classes[i].size >= size) {
+            return &pool->classes[i];
+        }
+    }
+    return NULL;
+}
+
+PARCBuffer *
+parcBufferPool_GetInstance(PARCBufferPool *pool, size_t size)
+{
+    parcBufferPool_OptionalAssertValid(pool);
+
+    // A buffer allocated while the thread has its own memory interface, such as an arena, must not be kept by the pool.
+    _PARCBufferPoolClass *class = _findClass(pool, size);
+    if (class == NULL || parcMemory_GetThreadInterface() != NULL) {
+        return parcBuffer_Allocate(size);
+    }
+
+    unsigned home = _threadShard();
+    PARCBuffer *result = _class_Pop(class, home);
+    if (result == NULL) {
+        result = _class_Allocate(class);
+        if (result == NULL) {
+            return NULL;
+        }
+        __sync_fetch_and_add(&class->shards[home].misses, 1);
+    }
+
+    _class_CountOutstanding(class);
+
+    parcBuffer_Clear(result);
+    parcBuffer_SetLimit(result, size);
+    return result;
+}
+
+size_t
+parcBufferPool_GetClassCount(const PARCBufferPool *pool)
+{
+    parcBufferPool_OptionalAssertValid(pool);
+
+    return pool->classCount;
+}
+
+size_t
+parcBufferPool_GetClassSize(const PARCBufferPool *pool, size_t index)
+{
+    parcBufferPool_OptionalAssertValid(pool);
+    trapOutOfBoundsIf(index >= pool->classCount, "Class index %zd exceeds the number of classes %zd", index, pool->classCount);
+
+    return pool->classes[index].size;
+}
+
+void
+parcBufferPool_GetStatistics(const PARCBufferPool *pool, size_t index, PARCBufferPoolStatistics *statistics)
+{
+    parcBufferPool_OptionalAssertValid(pool);
+    trapOutOfBoundsIf(index >= pool->classCount, "Class index %zd exceeds the number of classes %zd", index, pool->classCount);
+
+    const _PARCBufferPoolClass *class = &pool->classes[index];
+
+    memset(statistics, 0, sizeof(*statistics));
+    for (unsigned s = 0; s < _shardCount; s++) {
+        statistics->hits += class->shards[s].hits;
+        statistics->misses += class->shards[s].misses;
+        statistics->recycled += class->shards[s].recycled;
+        statistics->discarded += class->shards[s].discarded;
+    }
+    statistics->idle = class->idle;
+    statistics->outstanding = class->outstanding;
+    statistics->highWater = class->highWater;
+}
+
+size_t
+parcBufferPool_Drain(PARCBufferPool *pool)
+{
+    parcBufferPool_OptionalAssertValid(pool);
+
+    return _parcBufferPool_Drain(pool);
+}
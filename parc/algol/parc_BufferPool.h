@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_BufferPool.h
+ * @ingroup memory
+ * @brief A pool of recycled PARCBuffer instances of fixed sizes.
+ *
+ * Allocating a `PARCBuffer` allocates the buffer, its `PARCByteArray`, and the bytes of the array,
+ * and releasing it deallocates all three.
+ * A `PARCBufferPool` keeps released buffers of a set of configured sizes (classes) and hands them out again,
+ * so that a steady flow of packets through buffers from a pool allocates no memory at all.
+ *
+ * Buffers from a pool are ordinary `PARCBuffer` instances and are released with `parcBuffer_Release`.
+ * When the last reference to one is released it is returned to its pool instead of being deallocated,
+ * unless the pool already holds the maximum number of idle buffers of its class,
+ * or its memory is still shared with another buffer (a slice or a duplicate) or has been replaced.
+ *
+ * A pool lives until it has been released and all of its outstanding buffers have been released.
+ *
+ * While the calling thread has its own memory interface, such as an arena (see `parcMemory_SetThreadInterface`),
+ * the pool hands out ordinary buffers that are not returned to it, so that it never keeps the thread's memory.
+ *
+ * The idle buffers of each class are kept in several independently locked shards,
+ * and each thread uses its own shard first, so that threads do not contend for the same lock.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_BufferPool_h
+#define libparc_parc_BufferPool_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+struct parc_buffer_pool;
+typedef struct parc_buffer_pool PARCBufferPool;
+
+/**
+ * @typedef PARCBufferPoolClass
+ * @brief The configuration of one size of buffer in a `PARCBufferPool`.
+ */
+typedef struct parc_buffer_pool_class {
+    size_t size;            // The capacity of the buffers of the class.
+    size_t capacity;        // The maximum number of idle buffers of the class the pool keeps.
+    size_t preallocate;     // The number of buffers allocated when the pool is created, at most capacity.
+} PARCBufferPoolClass;
+
+/**
+ * @typedef PARCBufferPoolStatistics
+ * @brief Counters of the use of one class of a `PARCBufferPool`.
+ */
+typedef struct parc_buffer_pool_statistics {
+    uint64_t hits;          // Buffers handed out from the idle buffers of the pool.
+    uint64_t misses;        // Buffers allocated because the pool had no idle buffer.
+    uint64_t recycled;      // Released buffers kept by the pool.
+    uint64_t discarded;     // Released buffers deallocated, because the pool was full or their memory was shared.
+    size_t idle;            // Buffers held by the pool now.
+    size_t outstanding;     // Buffers handed out and not yet released now.
+    size_t highWater;       // The largest number of buffers that have been outstanding at once.
+} PARCBufferPoolStatistics;
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcBufferPool_OptionalAssertValid(_instance_)
+#else
+#  define parcBufferPool_OptionalAssertValid(_instance_) parcBufferPool_AssertValid(_instance_)
+#endif
+
+/**
+ * Create a `PARCBufferPool` with the given classes of buffer.
+ *
+ * The classes must be in strictly ascending order of size.
+ *
+ * @param [in] classCount The number of classes.
+ * @param [in] classes The configuration of each class.
+ *
+ * @return non-NULL A pointer to a valid `PARCBufferPool` instance.
+ * @return NULL Memory could not be allocated.
+ *
+ * @throws LongBowTrapIllegalValue If there are no classes, or they are not in strictly ascending order of size.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferPoolClass classes[] = {
+ *         { .size = 128,  .capacity = 256, .preallocate = 64 },
+ *         { .size = 1500, .capacity = 256, .preallocate = 64 },
+ *         { .size = 9000, .capacity = 16,  .preallocate = 0 },
+ *     };
+ *     PARCBufferPool *pool = parcBufferPool_Create(3, classes);
+ *
+ *     parcBufferPool_Release(&pool);
+ * }
+ * @endcode
+ */
+PARCBufferPool *parcBufferPool_Create(size_t classCount, const PARCBufferPoolClass classes[classCount]);
+
+/**
+ * Increase the number of references to a `PARCBufferPool`.
+ *
+ * @param [in] pool A pointer to a valid `PARCBufferPool` instance.
+ *
+ * @return The same value as @p pool.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferPool *pool = parcBufferPool_Acquire(instance);
+ *
+ *     parcBufferPool_Release(&pool);
+ * }
+ * @endcode
+ */
+PARCBufferPool *parcBufferPool_Acquire(const PARCBufferPool *pool);
+
+/**
+ * Release a previously acquired reference to the given `PARCBufferPool` instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pool, and its idle buffers, are deallocated when it has no references
+ * and none of its buffers are outstanding.
+ *
+ * @param [in,out] poolPtr A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferPool_Release(&pool);
+ * }
+ * @endcode
+ */
+void parcBufferPool_Release(PARCBufferPool **poolPtr);
+
+/**
+ * Determine if an instance of `PARCBufferPool` is valid.
+ *
+ * @param [in] pool A pointer to a `PARCBufferPool` instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcBufferPool_IsValid(pool)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool parcBufferPool_IsValid(const PARCBufferPool *pool);
+
+/**
+ * Assert that the given `PARCBufferPool` instance is valid.
+ *
+ * @param [in] pool A pointer to a valid `PARCBufferPool` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferPool_AssertValid(pool);
+ * }
+ * @endcode
+ */
+void parcBufferPool_AssertValid(const PARCBufferPool *pool);
+
+/**
+ * Get a `PARCBuffer` of at least @p size bytes from the given pool.
+ *
+ * The buffer comes from the smallest class whose size is at least @p size.
+ * Its capacity is the size of the class, its position is 0 and its limit is @p size.
+ * Its content is undefined: it may hold the bytes of a previous use.
+ *
+ * If @p size is larger than every class, a buffer is allocated with `parcBuffer_Allocate`, and is not pooled.
+ *
+ * @param [in] pool A pointer to a valid `PARCBufferPool` instance.
+ * @param [in] size The number of bytes required.
+ *
+ * @return non-NULL A pointer to a valid `PARCBuffer` instance, which must be released with `parcBuffer_Release`.
+ * @return NULL Memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *packet = parcBufferPool_GetInstance(pool, 1500);
+ *     ssize_t length = recv(socket, parcBuffer_Overlay(packet, 0), parcBuffer_Remaining(packet), 0);
+ *     ...
+ *     parcBuffer_Release(&packet); // Returns the buffer to the pool.
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBufferPool_GetInstance(PARCBufferPool *pool, size_t size);
+
+/**
+ * Return the number of classes of the given pool.
+ *
+ * @param [in] pool A pointer to a valid `PARCBufferPool` instance.
+ *
+ * @return The number of classes.
+ *
+ * Example:
+ * @code
+ * {
+ *     for (size_t i = 0; i < parcBufferPool_GetClassCount(pool); i++) {
+ *         printf("%zd\n", parcBufferPool_GetClassSize(pool, i));
+ *     }
+ * }
+ * @endcode
+ */
+size_t parcBufferPool_GetClassCount(const PARCBufferPool *pool);
+
+/**
+ * Return the size of the buffers of the class at the given index.
+ *
+ * @param [in] pool A pointer to a valid `PARCBufferPool` instance.
+ * @param [in] index The index of the class, less than `parcBufferPool_GetClassCount`.
+ *
+ * @return The size, in bytes, of the buffers of the class.
+ *
+ * @throws LongBowTrapOutOfBounds If @p index is not the index of a class.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t smallest = parcBufferPool_GetClassSize(pool, 0);
+ * }
+ * @endcode
+ */
+size_t parcBufferPool_GetClassSize(const PARCBufferPool *pool, size_t index);
+
+/**
+ * Get the statistics of the class at the given index.
+ *
+ * The counters are updated without locking and may be slightly out of date while other threads use the pool.
+ *
+ * @param [in] pool A pointer to a valid `PARCBufferPool` instance.
+ * @param [in] index The index of the class, less than `parcBufferPool_GetClassCount`.
+ * @param [out] statistics A pointer to a `PARCBufferPoolStatistics` to fill in.
+ *
+ * @throws LongBowTrapOutOfBounds If @p index is not the index of a class.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferPoolStatistics statistics;
+ *     parcBufferPool_GetStatistics(pool, 0, &statistics);
+ *     printf("%" PRIu64 " hits, %" PRIu64 " misses, %zd high water\n", statistics.hits, statistics.misses, statistics.highWater);
+ * }
+ * @endcode
+ */
+void parcBufferPool_GetStatistics(const PARCBufferPool *pool, size_t index, PARCBufferPoolStatistics *statistics);
+
+/**
+ * Deallocate all of the idle buffers held by the given pool.
+ *
+ * Outstanding buffers are not affected, and are returned to the pool as usual when they are released.
+ *
+ * @param [in] pool A pointer to a valid `PARCBufferPool` instance.
+ *
+ * @return The number of buffers deallocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t drained = parcBufferPool_Drain(pool);
+ * }
+ * @endcode
+ */
+size_t parcBufferPool_Drain(PARCBufferPool *pool);
+#endif // libparc_parc_BufferPool_h
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <string.h>
+
+#include <parc/algol/parc_BufferView.h>
+#include <parc/algol/parc_ByteScan.h>
+#include <parc/algol/parc_Memory.h>
+
+PARCBufferView *
+parcBufferView_Init(PARCBufferView *view, size_t length, const uint8_t bytes[length])
+{
+    assertTrue(length == 0 || bytes != NULL, "If the bytes are NULL, then length MUST be zero.");
+
+    view->bytes = bytes;
+    view->offset = 0;
+    view->length = length;
+    return view;
+}
+
+PARCBufferView *
+parcBufferView_InitFromBuffer(PARCBufferView *view, const PARCBuffer *buffer)
+{
+    parcBuffer_OptionalAssertValid(buffer);
+
+    // The remaining bytes may end at the very end of the array, where there is no byte to take the address of.
+    size_t remaining = parcBuffer_Remaining(buffer);
+    const uint8_t *bytes = (remaining == 0) ? NULL : parcBuffer_Overlay((PARCBuffer *) buffer, 0);
+    return parcBufferView_Init(view, remaining, bytes);
+}
+
+PARCBufferView *
+parcBufferView_Slice(PARCBufferView *slice, const PARCBufferView *view, size_t length)
+{
+    trapOutOfBoundsIf(length > parcBufferView_Remaining(view),
+                      "The slice length (%zd) exceeds the remaining bytes (%zd) of the view.", length, parcBufferView_Remaining(view));
+
+    return parcBufferView_Init(slice, length, parcBufferView_Overlay(view));
+}
+
+PARCBufferView *
+parcBufferView_GetBytes(PARCBufferView *view, size_t length, uint8_t array[length])
+{
+    if (length > 0) {
+        memcpy(array, _parcBufferView_Consume(view, length), length);
+    }
+    return view;
+}
+
+// Compare the remaining bytes of the view with length bytes of memory.
+static bool
+_parcBufferView_EqualsBytes(const PARCBufferView *view, size_t length, const uint8_t *bytes)
+{
+    if (parcBufferView_Remaining(view) != length) {
+        return false;
+    }
+    return length == 0 || memcmp(parcBufferView_Overlay(view), bytes, length) == 0;
+}
+
+bool
+parcBufferView_Equals(const PARCBufferView *x, const PARCBufferView *y)
+{
+    if (x == y) {
+        return true;
+    }
+    if (x == NULL || y == NULL) {
+        return false;
+    }
+    return _parcBufferView_EqualsBytes(x, parcBufferView_Remaining(y), parcBufferView_Overlay(y));
+}
+
+bool
+parcBufferView_EqualsBuffer(const PARCBufferView *view, const PARCBuffer *buffer)
+{
+    PARCBufferView other;
+    parcBufferView_InitFromBuffer(&other, buffer);
+
+    return parcBufferView_Equals(view, &other);
+}
+
+bool
+parcBufferView_EqualsCString(const PARCBufferView *view, const char *string)
+{
+    return _parcBufferView_EqualsBytes(view, strlen(string), (const uint8_t *) string);
+}
+
+PARCHashCode
+parcBufferView_HashCode(const PARCBufferView *view)
+{
+    PARCHashCode result = 0;
+
+    size_t remaining = parcBufferView_Remaining(view);
+    if (remaining > 0) {
+        result = parcHashCode_Hash(parcBufferView_Overlay(view), remaining);
+    }
+    return result;
+}
+
+size_t
+parcBufferView_FindUint8(const PARCBufferView *view, uint8_t byte)
+{
+    size_t remaining = parcBufferView_Remaining(view);
+    if (remaining == 0) {
+        return SIZE_MAX;
+    }
+
+    size_t index = parcByteScan_FindByte(remaining, parcBufferView_Overlay(view), byte);
+    return (index == SIZE_MAX) ? SIZE_MAX : view->offset + index;
+}
+
+char *
+parcBufferView_ToString(const PARCBufferView *view)
+{
+    size_t remaining = parcBufferView_Remaining(view);
+
+    char *result = parcMemory_Allocate(remaining + 1);
+    if (result != NULL) {
+        if (remaining > 0) {
+            memcpy(result, parcBufferView_Overlay(view), remaining);
+        }
+        result[remaining] = 0;
+    }
+    return result;
+}
+
+PARCBuffer *
+parcBufferView_ToBuffer(const PARCBufferView *view)
+{
+    size_t remaining = parcBufferView_Remaining(view);
+
+    PARCBuffer *result = parcBuffer_Allocate(remaining);
+    if (result != NULL && remaining > 0) {
+        parcBuffer_PutArray(result, remaining, parcBufferView_Overlay(view));
+        parcBuffer_Flip(result);
+    }
+    return result;
+}
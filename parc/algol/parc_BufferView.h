@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_BufferView.h
+ * @ingroup memory
+ * @brief A read-only window on a region of memory that is a value, not an object.
+ *
+ * `parcBuffer_Slice` and `parcBuffer_Duplicate` each allocate a new reference counted `PARCBuffer`
+ * just to have a different position and limit on the same memory.
+ * A parser that takes apart its input that way allocates, and releases, an object for every token.
+ *
+ * A `PARCBufferView` is a small structure, normally on the stack: a pointer to the first byte of a region,
+ * the length of the region, and the offset of the next byte to read.
+ * Making, slicing and copying a view allocate nothing; duplicating a view is an assignment.
+ * The reading functions have the same names and behaviour as their `PARCBuffer` counterparts,
+ * and, like them, check bounds and read multi-byte values in network byte order.
+ *
+ * A view does not hold a reference to the memory it refers to, which must outlive the view.
+ * A view that must outlive its memory, or be stored in a data structure, is promoted to a `PARCBuffer`
+ * with {@link parcBufferView_ToBuffer}, the only function that allocates.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_BufferView_h
+#define libparc_parc_BufferView_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_BufferCursor.h>
+#include <parc/algol/parc_HashCode.h>
+
+/**
+ * @typedef PARCBufferView
+ * @brief A read-only window on a region of memory.
+ *
+ * The members are public only so the view can live on the stack and the accessors can be inline;
+ * use the functions to manipulate them.
+ */
+typedef struct parc_buffer_view {
+    const uint8_t *bytes;   // The first byte of the region.
+    size_t offset;          // The offset of the next byte to read, at most length.
+    size_t length;          // The number of bytes of the region.
+} PARCBufferView;
+
+/**
+ * Initialise a view of @p length bytes of memory.
+ *
+ * @param [out] view A pointer to the `PARCBufferView` to initialise.
+ * @param [in] length The number of bytes of the region.
+ * @param [in] bytes A pointer to the first byte of the region, which may be NULL if @p length is 0.
+ *
+ * @return The value of @p view.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferView view;
+ *     parcBufferView_Init(&view, strlen(string), (const uint8_t *) string);
+ * }
+ * @endcode
+ */
+PARCBufferView *parcBufferView_Init(PARCBufferView *view, size_t length, const uint8_t bytes[length]);
+
+/**
+ * Initialise a view of the remaining bytes of a `PARCBuffer`, from its position to its limit.
+ *
+ * The view refers to the memory of the buffer, which must not be released or resized while the view is in use.
+ * The position of the buffer is not changed.
+ *
+ * @param [out] view A pointer to the `PARCBufferView` to initialise.
+ * @param [in] buffer A pointer to a valid `PARCBuffer` instance.
+ *
+ * @return The value of @p view.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferView view;
+ *     parcBufferView_InitFromBuffer(&view, buffer);
+ * }
+ * @endcode
+ */
+PARCBufferView *parcBufferView_InitFromBuffer(PARCBufferView *view, const PARCBuffer *buffer);
+
+/**
+ * Initialise @p slice as a view of the next @p length bytes of @p view.
+ *
+ * This is the counterpart of `parcBuffer_Slice`, limited to @p length bytes.
+ * The offset of @p view is not changed.
+ *
+ * @param [out] slice A pointer to the `PARCBufferView` to initialise.
+ * @param [in] view A pointer to a `PARCBufferView`.
+ * @param [in] length The number of bytes of the slice.
+ *
+ * @return The value of @p slice.
+ *
+ * @throws LongBowTrapOutOfBounds If @p length exceeds the remaining bytes of @p view.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferView name;
+ *     parcBufferView_Slice(&name, &view, nameLength);
+ *     parcBufferView_Skip(&view, nameLength);
+ * }
+ * @endcode
+ */
+PARCBufferView *parcBufferView_Slice(PARCBufferView *slice, const PARCBufferView *view, size_t length);
+
+/**
+ * Return the number of bytes between the offset and the end of the view.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ *
+ * @return The number of remaining bytes.
+ *
+ * Example:
+ * @code
+ * {
+ *     while (parcBufferView_Remaining(&view) > 0) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+static inline size_t
+parcBufferView_Remaining(const PARCBufferView *view)
+{
+    return view->length - view->offset;
+}
+
+/**
+ * Return the offset of the next byte to read.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ *
+ * @return The offset, from 0 to the length of the view.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t start = parcBufferView_Position(&view);
+ * }
+ * @endcode
+ */
+static inline size_t
+parcBufferView_Position(const PARCBufferView *view)
+{
+    return view->offset;
+}
+
+/**
+ * Set the offset of the next byte to read.
+ *
+ * @param [in,out] view A pointer to a `PARCBufferView`.
+ * @param [in] position The new offset, at most the length of the view.
+ *
+ * @return The value of @p view.
+ *
+ * @throws LongBowTrapOutOfBounds If @p position exceeds the length of the view.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferView_SetPosition(&view, start);
+ * }
+ * @endcode
+ */
+static inline PARCBufferView *
+parcBufferView_SetPosition(PARCBufferView *view, size_t position)
+{
+    trapOutOfBoundsIf(position > view->length, "Position %zd exceeds the length %zd of the view.", position, view->length);
+    view->offset = position;
+    return view;
+}
+
+/**
+ * Advance the offset of the view over @p length bytes without reading them.
+ *
+ * @param [in,out] view A pointer to a `PARCBufferView`.
+ * @param [in] length The number of bytes to skip.
+ *
+ * @return The value of @p view.
+ *
+ * @throws LongBowTrapOutOfBounds If @p length exceeds the remaining bytes of the view.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferView_Skip(&view, 2);
+ * }
+ * @endcode
+ */
+static inline PARCBufferView *
+parcBufferView_Skip(PARCBufferView *view, size_t length)
+{
+    trapOutOfBoundsIf(length > parcBufferView_Remaining(view),
+                      "Skipping %zd bytes exceeds the remaining %zd bytes of the view.", length, parcBufferView_Remaining(view));
+    view->offset += length;
+    return view;
+}
+
+/**
+ * Return a pointer to the next byte of the view, without changing the offset.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ *
+ * @return A pointer to the next byte, which is not valid to read if the view has no remaining bytes.
+ *
+ * Example:
+ * @code
+ * {
+ *     fwrite(parcBufferView_Overlay(&view), 1, parcBufferView_Remaining(&view), stdout);
+ * }
+ * @endcode
+ */
+static inline const uint8_t *
+parcBufferView_Overlay(const PARCBufferView *view)
+{
+    return view->bytes + view->offset;
+}
+
+// Check that @p length bytes remain, returning a pointer to them and advancing the offset past them.
+static inline const uint8_t *
+_parcBufferView_Consume(PARCBufferView *view, size_t length)
+{
+    trapOutOfBoundsIf(length > parcBufferView_Remaining(view),
+                      "Reading %zd bytes exceeds the remaining %zd bytes of the view.", length, parcBufferView_Remaining(view));
+    const uint8_t *result = view->bytes + view->offset;
+    view->offset += length;
+    return result;
+}
+
+/**
+ * Read the byte at the offset of the view, without changing the offset.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ *
+ * @return The byte.
+ *
+ * @throws LongBowTrapOutOfBounds If the view has no remaining bytes.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcBufferView_PeekByte(&view) == '"') {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+static inline uint8_t
+parcBufferView_PeekByte(const PARCBufferView *view)
+{
+    trapOutOfBoundsIf(view->offset >= view->length, "The view has no remaining bytes.");
+    return view->bytes[view->offset];
+}
+
+/**
+ * Read the next byte of the view.
+ *
+ * @param [in,out] view A pointer to a `PARCBufferView`.
+ *
+ * @return The byte.
+ *
+ * @throws LongBowTrapOutOfBounds If the view has no remaining bytes.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t type = parcBufferView_GetUint8(&view);
+ * }
+ * @endcode
+ */
+static inline uint8_t
+parcBufferView_GetUint8(PARCBufferView *view)
+{
+    return *_parcBufferView_Consume(view, sizeof(uint8_t));
+}
+
+/**
+ * Read the next 2 bytes of the view as a network byte order `uint16_t`.
+ *
+ * @param [in,out] view A pointer to a `PARCBufferView`.
+ *
+ * @return The value in host byte order.
+ *
+ * @throws LongBowTrapOutOfBounds If fewer than 2 bytes remain.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint16_t length = parcBufferView_GetUint16(&view);
+ * }
+ * @endcode
+ */
+static inline uint16_t
+parcBufferView_GetUint16(PARCBufferView *view)
+{
+    return _parcBufferCursor_Load16(_parcBufferView_Consume(view, sizeof(uint16_t)));
+}
+
+/**
+ * Read the next 4 bytes of the view as a network byte order `uint32_t`.
+ *
+ * @param [in,out] view A pointer to a `PARCBufferView`.
+ *
+ * @return The value in host byte order.
+ *
+ * @throws LongBowTrapOutOfBounds If fewer than 4 bytes remain.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t sequence = parcBufferView_GetUint32(&view);
+ * }
+ * @endcode
+ */
+static inline uint32_t
+parcBufferView_GetUint32(PARCBufferView *view)
+{
+    return _parcBufferCursor_Load32(_parcBufferView_Consume(view, sizeof(uint32_t)));
+}
+
+/**
+ * Read the next 8 bytes of the view as a network byte order `uint64_t`.
+ *
+ * @param [in,out] view A pointer to a `PARCBufferView`.
+ *
+ * @return The value in host byte order.
+ *
+ * @throws LongBowTrapOutOfBounds If fewer than 8 bytes remain.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t timestamp = parcBufferView_GetUint64(&view);
+ * }
+ * @endcode
+ */
+static inline uint64_t
+parcBufferView_GetUint64(PARCBufferView *view)
+{
+    return _parcBufferCursor_Load64(_parcBufferView_Consume(view, sizeof(uint64_t)));
+}
+
+/**
+ * Copy the next @p length bytes of the view into @p array.
+ *
+ * @param [in,out] view A pointer to a `PARCBufferView`.
+ * @param [in] length The number of bytes to copy.
+ * @param [out] array The destination of the bytes.
+ *
+ * @return The value of @p view.
+ *
+ * @throws LongBowTrapOutOfBounds If fewer than @p length bytes remain.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t digest[32];
+ *     parcBufferView_GetBytes(&view, sizeof(digest), digest);
+ * }
+ * @endcode
+ */
+PARCBufferView *parcBufferView_GetBytes(PARCBufferView *view, size_t length, uint8_t array[length]);
+
+/**
+ * Determine if the remaining bytes of two views are equal.
+ *
+ * Like `parcBuffer_Equals`, only the remaining bytes are compared, not the offsets or the memory the views refer to.
+ *
+ * @param [in] x A pointer to a `PARCBufferView`, or NULL.
+ * @param [in] y A pointer to a `PARCBufferView`, or NULL.
+ *
+ * @return true The remaining bytes of the views are equal, or both are NULL.
+ * @return false The remaining bytes of the views are not equal.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcBufferView_Equals(&name, &expected)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool parcBufferView_Equals(const PARCBufferView *x, const PARCBufferView *y);
+
+/**
+ * Determine if the remaining bytes of a view are equal to the remaining bytes of a `PARCBuffer`.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ * @param [in] buffer A pointer to a valid `PARCBuffer` instance.
+ *
+ * @return true The remaining bytes are equal.
+ * @return false The remaining bytes are not equal.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcBufferView_EqualsBuffer(&name, keyword)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool parcBufferView_EqualsBuffer(const PARCBufferView *view, const PARCBuffer *buffer);
+
+/**
+ * Determine if the remaining bytes of a view are equal to a nul-terminated C string, without the nul.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ * @param [in] string A pointer to a nul-terminated C string.
+ *
+ * @return true The remaining bytes are equal to the string.
+ * @return false The remaining bytes are not equal to the string.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcBufferView_EqualsCString(&token, "true")) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool parcBufferView_EqualsCString(const PARCBufferView *view, const char *string);
+
+/**
+ * Return the hash code of the remaining bytes of the view.
+ *
+ * The hash code is the same as that of a `PARCBuffer` with the same remaining bytes,
+ * so a view can be used to look up a `PARCBuffer` key without making one.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ *
+ * @return The hash code.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashCode hashCode = parcBufferView_HashCode(&view);
+ * }
+ * @endcode
+ */
+PARCHashCode parcBufferView_HashCode(const PARCBufferView *view);
+
+/**
+ * Find the first occurrence of @p byte in the remaining bytes of the view.
+ *
+ * Like `parcBuffer_FindUint8`, the offset of the view is not changed.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ * @param [in] byte The byte to find.
+ *
+ * @return The offset of the byte in the view, or `SIZE_MAX` if it does not occur in the remaining bytes.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t end = parcBufferView_FindUint8(&view, '"');
+ *     if (end != SIZE_MAX) {
+ *         PARCBufferView string;
+ *         parcBufferView_Slice(&string, &view, end - parcBufferView_Position(&view));
+ *     }
+ * }
+ * @endcode
+ */
+size_t parcBufferView_FindUint8(const PARCBufferView *view, uint8_t byte);
+
+/**
+ * Produce a nul-terminated C string containing the remaining bytes of the view.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ *
+ * @return A pointer to an allocated C string that must be deallocated with `parcMemory_Deallocate`.
+ *
+ * Example:
+ * @code
+ * {
+ *     char *string = parcBufferView_ToString(&view);
+ *     printf("%s\n", string);
+ *     parcMemory_Deallocate(&string);
+ * }
+ * @endcode
+ */
+char *parcBufferView_ToString(const PARCBufferView *view);
+
+/**
+ * Promote the remaining bytes of the view to a `PARCBuffer`.
+ *
+ * The bytes are copied, so the buffer is independent of the memory the view refers to.
+ * The position of the buffer is 0 and its limit and capacity are the remaining bytes of the view.
+ *
+ * @param [in] view A pointer to a `PARCBufferView`.
+ *
+ * @return non-NULL A pointer to a valid `PARCBuffer` instance, which must be released with `parcBuffer_Release`.
+ * @return NULL Memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *name = parcBufferView_ToBuffer(&view);
+ *     ...
+ *     parcBuffer_Release(&name);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcBufferView_ToBuffer(const PARCBufferView *view);
+#endif // libparc_parc_BufferView_h
@@ -33,6 +33,8 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include <LongBow/runtime.h>
 
@@ -45,7 +47,7 @@
 struct parc_byte_array {
     uint8_t *array;
     size_t length;
-    void (*freeFunction)(void **);
+    void (*freeFunction)(void **, size_t);
 };
 #define MAGIC 0x0ddba11c1a55e5
 
@@ -62,19 +64,22 @@ _parcByteArray_Destructor(PARCByteArray **byteArrayPtr)
 
     if (byteArray->freeFunction != NULL) {
         if (byteArray->array != NULL) {
-            byteArray->freeFunction((void **) &(byteArray->array));
+            byteArray->freeFunction((void **) &(byteArray->array), byteArray->length);
         }
     }
     return true;
 }
 
+parcObject_DeclarePool(PARCByteArray);
+
 parcObject_Override(PARCByteArray, PARCObject,
                     .destructor = (PARCObjectDestructor *) _parcByteArray_Destructor,
                     .copy       = (PARCObjectCopy *) parcByteArray_Copy,
                     .equals     = (PARCObjectEquals *) parcByteArray_Equals,
                     .compare    = (PARCObjectCompare *) parcByteArray_Compare,
                     .hashCode   = (PARCObjectHashCode *) parcByteArray_HashCode,
-                    .display    = (PARCObjectDisplay *) parcByteArray_Display);
+                    .display    = (PARCObjectDisplay *) parcByteArray_Display,
+                    .pool       = &parcObject_PoolName(PARCByteArray));
 
 void
 parcByteArray_AssertValid(const PARCByteArray *instance)
@@ -112,10 +117,10 @@ parcByteArray_Allocate(const size_t length)
     if (result != NULL) {
         result->array = array;
         result->length = length;
-        result->freeFunction = parcMemory_DeallocateImpl;
+        result->freeFunction = parcMemory_DeallocateSizedImpl;
         return result;
     } else {
-        parcMemory_Deallocate(&array);
+        parcMemory_DeallocateSized(&array, length);
     }
     return NULL;
 }
@@ -135,6 +140,98 @@ parcByteArray_Wrap(const size_t length, uint8_t array[length])
     return NULL;
 }
 
+static void
+_parcByteArray_Unmap(void **array, size_t length)
+{
+    munmap(*array, length);
+    *array = NULL;
+}
+
+PARCByteArray *
+parcByteArray_MapFile(int fileDescriptor, size_t capacity, PARCByteArrayMap mode)
+{
+    trapIllegalValueIf(capacity == 0, "A PARCByteArray of no bytes cannot be mapped.");
+
+    int protection = PROT_READ;
+    int flags = MAP_PRIVATE;
+    switch (mode) {
+        case PARCByteArrayMap_ReadOnly:
+            break;
+        case PARCByteArrayMap_CopyOnWrite:
+            protection |= PROT_WRITE;
+            break;
+        case PARCByteArrayMap_Shared:
+            protection |= PROT_WRITE;
+            flags = MAP_SHARED;
+            break;
+        default:
+            trapIllegalValue(mode, "Unknown PARCByteArrayMap %d", mode);
+    }
+
+    void *array = mmap(NULL, capacity, protection, flags, fileDescriptor, 0);
+    if (array == MAP_FAILED) {
+        return NULL;
+    }
+
+    PARCByteArray *result = parcObject_CreateInstance(PARCByteArray);
+    if (result != NULL) {
+        result->array = array;
+        result->length = capacity;
+        result->freeFunction = _parcByteArray_Unmap;
+    } else {
+        munmap(array, capacity);
+    }
+    return result;
+}
+
+bool
+parcByteArray_IsMapped(const PARCByteArray *byteArray)
+{
+    parcByteArray_OptionalAssertValid(byteArray);
+    return byteArray->freeFunction == _parcByteArray_Unmap;
+}
+
+bool
+parcByteArray_Advise(const PARCByteArray *byteArray, size_t offset, size_t length, PARCByteArrayAdvice advice)
+{
+    parcByteArray_OptionalAssertValid(byteArray);
+    trapOutOfBoundsIf(offset > byteArray->length || length > byteArray->length - offset,
+                      "%zd bytes at %zd exceed the length %zd", length, offset, byteArray->length);
+
+    if (parcByteArray_IsMapped(byteArray) == false || length == 0) {
+        return false;
+    }
+
+    int kernelAdvice = MADV_NORMAL;
+    switch (advice) {
+        case PARCByteArrayAdvice_Normal:
+            kernelAdvice = MADV_NORMAL;
+            break;
+        case PARCByteArrayAdvice_Sequential:
+            kernelAdvice = MADV_SEQUENTIAL;
+            break;
+        case PARCByteArrayAdvice_Random:
+            kernelAdvice = MADV_RANDOM;
+            break;
+        case PARCByteArrayAdvice_WillNeed:
+            kernelAdvice = MADV_WILLNEED;
+            break;
+        case PARCByteArrayAdvice_DontNeed:
+            kernelAdvice = MADV_DONTNEED;
+            break;
+        default:
+            trapIllegalValue(advice, "Unknown PARCByteArrayAdvice %d", advice);
+    }
+
+    // madvise(2) requires the address to be aligned on a page, so the advice is widened to whole pages.
+    uintptr_t pageSize = (uintptr_t) sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t) &byteArray->array[offset];
+    uintptr_t end = start + length;
+    start &= ~(pageSize - 1);
+
+    return madvise((void *) start, end - start, kernelAdvice) == 0;
+}
+
 parcObject_ImplementAcquire(parcByteArray, PARCByteArray);
 
 parcObject_ImplementRelease(parcByteArray, PARCByteArray);
@@ -172,6 +172,95 @@ PARCByteArray *parcByteArray_Allocate(const size_t capacity);
  */
 PARCByteArray *parcByteArray_Wrap(size_t capacity, uint8_t array[capacity]);
 
+/**
+ * @typedef PARCByteArrayMap
+ * @brief How the memory of a `PARCByteArray` created by {@link parcByteArray_MapFile} relates to the file.
+ */
+typedef enum {
+    PARCByteArrayMap_ReadOnly,      ///< The memory can only be read, and writing to it terminates the process with SIGSEGV.
+    PARCByteArrayMap_CopyOnWrite,   ///< The memory can be written, and the changes are private to the process.
+    PARCByteArrayMap_Shared         ///< The memory can be written, and the changes are written to the file.
+} PARCByteArrayMap;
+
+/**
+ * @typedef PARCByteArrayAdvice
+ * @brief How the memory of a mapped `PARCByteArray` will be accessed, so that the kernel can read ahead or drop pages.
+ */
+typedef enum {
+    PARCByteArrayAdvice_Normal,     ///< No particular order, the default.
+    PARCByteArrayAdvice_Sequential, ///< In order from low to high indices: read ahead aggressively and drop pages soon after.
+    PARCByteArrayAdvice_Random,     ///< In random order: do not read ahead.
+    PARCByteArrayAdvice_WillNeed,   ///< Soon: start reading the pages now.
+    PARCByteArrayAdvice_DontNeed    ///< Not soon: the pages may be dropped and read again when needed.
+} PARCByteArrayAdvice;
+
+/**
+ * Create a `PARCByteArray` whose memory is the first @p capacity bytes of the open file @p fileDescriptor, mapped with mmap(2).
+ *
+ * Pages of the file are read when they are first accessed, so mapping a large file costs nothing up front,
+ * and the pages are shared with the file system cache rather than copied into the heap.
+ * The mapping is unmapped when the last reference to the `PARCByteArray` is released,
+ * and remains valid after @p fileDescriptor is closed.
+ *
+ * @param [in] fileDescriptor A file descriptor open for reading, and for writing if @p mode is `PARCByteArrayMap_Shared`.
+ * @param [in] capacity The number of bytes to map, which must be greater than 0.
+ * @param [in] mode How the memory relates to the file.
+ *
+ * @return non-NULL A pointer to a `PARCByteArray` instance.
+ * @return NULL The file could not be mapped, and errno is set.
+ *
+ * Example:
+ * @code
+ * {
+ *     int fd = open("content.bin", O_RDONLY);
+ *     struct stat statbuf;
+ *     fstat(fd, &statbuf);
+ *
+ *     PARCByteArray *byteArray = parcByteArray_MapFile(fd, statbuf.st_size, PARCByteArrayMap_ReadOnly);
+ *     close(fd);
+ *
+ *     parcByteArray_Release(&byteArray);
+ * }
+ * @endcode
+ *
+ * @see parcBuffer_MapFile
+ */
+PARCByteArray *parcByteArray_MapFile(int fileDescriptor, size_t capacity, PARCByteArrayMap mode);
+
+/**
+ * Determine if the memory of a `PARCByteArray` was mapped from a file by {@link parcByteArray_MapFile}.
+ *
+ * @param [in] byteArray A pointer to a valid `PARCByteArray` instance.
+ *
+ * @return true The memory is mapped from a file.
+ * @return false The memory is not mapped from a file.
+ */
+bool parcByteArray_IsMapped(const PARCByteArray *byteArray);
+
+/**
+ * Advise the kernel how the @p length bytes at @p offset of a mapped `PARCByteArray` will be accessed.
+ *
+ * The advice applies to the whole pages that contain the bytes.
+ * Memory that is not mapped from a file is not affected.
+ * Note that `PARCByteArrayAdvice_DontNeed` discards the changes made to a `PARCByteArrayMap_CopyOnWrite` mapping.
+ *
+ * @param [in] byteArray A pointer to a valid `PARCByteArray` instance.
+ * @param [in] offset The index of the first byte.
+ * @param [in] length The number of bytes.
+ * @param [in] advice How the bytes will be accessed.
+ *
+ * @return true The advice was given.
+ * @return false The memory is not mapped from a file, or the kernel did not accept the advice.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcByteArray_Advise(byteArray, 0, parcByteArray_Capacity(byteArray), PARCByteArrayAdvice_Sequential);
+ * }
+ * @endcode
+ */
+bool parcByteArray_Advise(const PARCByteArray *byteArray, size_t offset, size_t length, PARCByteArrayAdvice advice);
+
 /**
  * Returns the pointer to the `uint8_t` array that backs this `PARCByteArray`.
  *
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <parc/algol/parc_ByteScan.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define PARCByteScan_X86 1
+#  include <immintrin.h>
+#endif
+
+/*
+ * The vector implementations of FindAny compare each block against every byte of the set,
+ * so larger sets are searched one byte at a time with a table of the members of the set.
+ */
+#define _maxVectorSetLength 16
+
+typedef size_t (_PARCByteScanFindAny)(size_t length, const uint8_t *array, size_t setLength, const uint8_t *set, bool inSet);
+typedef size_t (_PARCByteScanFindBytes)(size_t length, const uint8_t *array, size_t patternLength, const uint8_t *pattern);
+
+typedef struct {
+    _PARCByteScanFindAny *findAny;
+    _PARCByteScanFindBytes *findBytes;
+} _PARCByteScanImplementation;
+
+// Add @p offset to the result of a search, unless nothing was found.
+static inline size_t
+_offset(size_t offset, size_t result)
+{
+    return (result == SIZE_MAX) ? SIZE_MAX : offset + result;
+}
+
+static size_t
+_findAny_Scalar(size_t length, const uint8_t *array, size_t setLength, const uint8_t *set, bool inSet)
+{
+    if (inSet && setLength == 1) {
+        const uint8_t *found = memchr(array, set[0], length);
+        return (found == NULL) ? SIZE_MAX : (size_t) (found - array);
+    }
+
+    bool member[256] = { false };
+    for (size_t i = 0; i < setLength; i++) {
+        member[set[i]] = true;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        if (member[array[i]] == inSet) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+static size_t
+_findBytes_Scalar(size_t length, const uint8_t *array, size_t patternLength, const uint8_t *pattern)
+{
+    if (patternLength > length) {
+        return SIZE_MAX;
+    }
+
+    // Find each occurrence of the first byte of the pattern, and compare the rest.
+    const uint8_t *end = array + (length - patternLength + 1);
+    for (const uint8_t *candidate = array; candidate < end; candidate++) {
+        candidate = memchr(candidate, pattern[0], (size_t) (end - candidate));
+        if (candidate == NULL) {
+            break;
+        }
+        if (memcmp(candidate + 1, pattern + 1, patternLength - 1) == 0) {
+            return (size_t) (candidate - array);
+        }
+    }
+    return SIZE_MAX;
+}
+
+static const _PARCByteScanImplementation _scalar = {
+    .findAny   = _findAny_Scalar,
+    .findBytes = _findBytes_Scalar,
+};
+
+#ifdef PARCByteScan_X86
+/*
+ * Each block of the array is compared with every byte of the set, and the results are or'ed together,
+ * so that a bit of the movemask is set for each byte of the block that is in the set.
+ */
+__attribute__((target("sse2")))
+static size_t
+_findAny_SSE2(size_t length, const uint8_t *array, size_t setLength, const uint8_t *set, bool inSet)
+{
+    if (setLength > _maxVectorSetLength) {
+        return _findAny_Scalar(length, array, setLength, set, inSet);
+    }
+
+    __m128i members[_maxVectorSetLength];
+    for (size_t n = 0; n < setLength; n++) {
+        members[n] = _mm_set1_epi8((char) set[n]);
+    }
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) &array[i]);
+        __m128i matches = _mm_setzero_si128();
+        for (size_t n = 0; n < setLength; n++) {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, members[n]));
+        }
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(matches);
+        if (!inSet) {
+            mask = ~mask & 0xFFFF;
+        }
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return _offset(i, _findAny_Scalar(length - i, &array[i], setLength, set, inSet));
+}
+
+/*
+ * Compare each block with the first byte of the pattern, and the block (pattern length - 1) bytes later
+ * with the last byte of the pattern.
+ * Only the candidates where both match are compared in full.
+ */
+__attribute__((target("sse2")))
+static size_t
+_findBytes_SSE2(size_t length, const uint8_t *array, size_t patternLength, const uint8_t *pattern)
+{
+    if (patternLength < 2) {
+        return _findBytes_Scalar(length, array, patternLength, pattern);
+    }
+
+    size_t last = patternLength - 1;
+    __m128i first = _mm_set1_epi8((char) pattern[0]);
+    __m128i final = _mm_set1_epi8((char) pattern[last]);
+
+    size_t i = 0;
+    for (; i + last + 16 <= length; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i *) &array[i]);
+        __m128i blockLast = _mm_loadu_si128((const __m128i *) &array[i + last]);
+        __m128i matches = _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, final));
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(matches);
+        while (mask != 0) {
+            size_t candidate = i + (size_t) __builtin_ctz(mask);
+            if (memcmp(&array[candidate + 1], &pattern[1], last - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return _offset(i, _findBytes_Scalar(length - i, &array[i], patternLength, pattern));
+}
+
+static const _PARCByteScanImplementation _sse2 = {
+    .findAny   = _findAny_SSE2,
+    .findBytes = _findBytes_SSE2,
+};
+
+__attribute__((target("avx2")))
+static size_t
+_findAny_AVX2(size_t length, const uint8_t *array, size_t setLength, const uint8_t *set, bool inSet)
+{
+    if (setLength > _maxVectorSetLength) {
+        return _findAny_Scalar(length, array, setLength, set, inSet);
+    }
+
+    __m256i members[_maxVectorSetLength];
+    for (size_t n = 0; n < setLength; n++) {
+        members[n] = _mm256_set1_epi8((char) set[n]);
+    }
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) &array[i]);
+        __m256i matches = _mm256_setzero_si256();
+        for (size_t n = 0; n < setLength; n++) {
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, members[n]));
+        }
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(matches);
+        if (!inSet) {
+            mask = ~mask;
+        }
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return _offset(i, _findAny_SSE2(length - i, &array[i], setLength, set, inSet));
+}
+
+__attribute__((target("avx2")))
+static size_t
+_findBytes_AVX2(size_t length, const uint8_t *array, size_t patternLength, const uint8_t *pattern)
+{
+    if (patternLength < 2) {
+        return _findBytes_Scalar(length, array, patternLength, pattern);
+    }
+
+    size_t last = patternLength - 1;
+    __m256i first = _mm256_set1_epi8((char) pattern[0]);
+    __m256i final = _mm256_set1_epi8((char) pattern[last]);
+
+    size_t i = 0;
+    for (; i + last + 32 <= length; i += 32) {
+        __m256i blockFirst = _mm256_loadu_si256((const __m256i *) &array[i]);
+        __m256i blockLast = _mm256_loadu_si256((const __m256i *) &array[i + last]);
+        __m256i matches = _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, final));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(matches);
+        while (mask != 0) {
+            size_t candidate = i + (size_t) __builtin_ctz(mask);
+            if (memcmp(&array[candidate + 1], &pattern[1], last - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return _offset(i, _findBytes_SSE2(length - i, &array[i], patternLength, pattern));
+}
+
+static const _PARCByteScanImplementation _avx2 = {
+    .findAny   = _findAny_AVX2,
+    .findBytes = _findBytes_AVX2,
+};
+#endif
+
+static pthread_once_t _parcByteScan_Once = PTHREAD_ONCE_INIT;
+static PARCByteScanLevel _parcByteScan_Supported = PARCByteScanLevel_Scalar;
+static PARCByteScanLevel _parcByteScan_Level = PARCByteScanLevel_Scalar;
+static const _PARCByteScanImplementation *_parcByteScan_Implementation = &_scalar;
+
+static void
+_parcByteScan_Use(PARCByteScanLevel level)
+{
+    _parcByteScan_Level = level;
+    switch (level) {
+#ifdef PARCByteScan_X86
+        case PARCByteScanLevel_AVX2:
+            _parcByteScan_Implementation = &_avx2;
+            break;
+        case PARCByteScanLevel_SSE2:
+            _parcByteScan_Implementation = &_sse2;
+            break;
+#endif
+        default:
+            _parcByteScan_Level = PARCByteScanLevel_Scalar;
+            _parcByteScan_Implementation = &_scalar;
+            break;
+    }
+}
+
+static void
+_parcByteScan_Initialize(void)
+{
+#ifdef PARCByteScan_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        _parcByteScan_Supported = PARCByteScanLevel_AVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        _parcByteScan_Supported = PARCByteScanLevel_SSE2;
+    }
+#endif
+    _parcByteScan_Use(_parcByteScan_Supported);
+}
+
+static inline const _PARCByteScanImplementation *
+_implementation(void)
+{
+    pthread_once(&_parcByteScan_Once, _parcByteScan_Initialize);
+    return _parcByteScan_Implementation;
+}
+
+PARCByteScanLevel
+parcByteScan_GetLevel(void)
+{
+    pthread_once(&_parcByteScan_Once, _parcByteScan_Initialize);
+    return _parcByteScan_Level;
+}
+
+PARCByteScanLevel
+parcByteScan_SetLevel(PARCByteScanLevel level)
+{
+    PARCByteScanLevel result = parcByteScan_GetLevel();
+
+    _parcByteScan_Use((level > _parcByteScan_Supported) ? _parcByteScan_Supported : level);
+    return result;
+}
+
+size_t
+parcByteScan_FindByte(size_t length, const uint8_t array[length], uint8_t byte)
+{
+    // The C library's memchr is already vectorized on every platform that has vector instructions.
+    const uint8_t *found = memchr(array, byte, length);
+    return (found == NULL) ? SIZE_MAX : (size_t) (found - array);
+}
+
+size_t
+parcByteScan_FindAny(size_t length, const uint8_t array[length], size_t setLength, const uint8_t set[setLength])
+{
+    return _implementation()->findAny(length, array, setLength, set, true);
+}
+
+size_t
+parcByteScan_FindNotAny(size_t length, const uint8_t array[length], size_t setLength, const uint8_t set[setLength])
+{
+    return _implementation()->findAny(length, array, setLength, set, false);
+}
+
+size_t
+parcByteScan_FindBytes(size_t length, const uint8_t array[length], size_t patternLength, const uint8_t pattern[patternLength])
+{
+    if (patternLength == 0) {
+        return 0;
+    }
+    return _implementation()->findBytes(length, array, patternLength, pattern);
+}
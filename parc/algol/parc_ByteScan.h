@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_ByteScan.h
+ * @ingroup memory
+ * @brief Search arrays of bytes for a byte, a set of bytes, or a sequence of bytes.
+ *
+ * These functions are the searching primitives beneath `PARCBuffer` functions such as
+ * {@link parcBuffer_FindUint8}, {@link parcBuffer_FindBytes}, {@link parcBuffer_SkipOver} and {@link parcBuffer_SkipTo}.
+ *
+ * Each search examines 16 (SSE2) or 32 (AVX2) bytes per step where the processor supports it,
+ * and one byte per step otherwise.
+ * The instruction set is chosen once, at the first search, from the features of the processor,
+ * and may be lowered with {@link parcByteScan_SetLevel} to compare implementations.
+ *
+ * All of the functions return the index of what they find, or `SIZE_MAX` (<stdint.h>) if it is not found.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ByteScan_h
+#define libparc_parc_ByteScan_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @typedef PARCByteScanLevel
+ * @brief The instruction set used to search arrays of bytes.
+ */
+typedef enum {
+    PARCByteScanLevel_Scalar = 0,
+    PARCByteScanLevel_SSE2 = 1,
+    PARCByteScanLevel_AVX2 = 2
+} PARCByteScanLevel;
+
+/**
+ * Get the instruction set currently used to search arrays of bytes.
+ *
+ * @return The current `PARCByteScanLevel`.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcByteScan_GetLevel() == PARCByteScanLevel_Scalar) {
+ *         printf("No vector instructions are available.\n");
+ *     }
+ * }
+ * @endcode
+ */
+PARCByteScanLevel parcByteScan_GetLevel(void);
+
+/**
+ * Set the instruction set used to search arrays of bytes.
+ *
+ * If the processor does not support the given level, the highest supported level below it is used.
+ * This is intended for testing and benchmarking, and must not be called while other threads are searching.
+ *
+ * @param [in] level The `PARCByteScanLevel` to use.
+ *
+ * @return The previous `PARCByteScanLevel`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCByteScanLevel previous = parcByteScan_SetLevel(PARCByteScanLevel_Scalar);
+ *     ...
+ *     parcByteScan_SetLevel(previous);
+ * }
+ * @endcode
+ */
+PARCByteScanLevel parcByteScan_SetLevel(PARCByteScanLevel level);
+
+/**
+ * Return the index of the first byte in @p array equal to @p byte.
+ *
+ * @param [in] length The number of bytes in @p array.
+ * @param [in] array The bytes to search.
+ * @param [in] byte The byte to find.
+ *
+ * @return The index of the first byte equal to @p byte, or `SIZE_MAX` (<stdint.h>).
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t index = parcByteScan_FindByte(11, (uint8_t *) "Hello World", 'o');
+ *
+ *     // index is 4
+ * }
+ * @endcode
+ */
+size_t parcByteScan_FindByte(size_t length, const uint8_t array[length], uint8_t byte);
+
+/**
+ * Return the index of the first byte in @p array that is one of the bytes in @p set.
+ *
+ * Sets of up to 16 bytes are searched with vector instructions.
+ *
+ * @param [in] length The number of bytes in @p array.
+ * @param [in] array The bytes to search.
+ * @param [in] setLength The number of bytes in @p set.
+ * @param [in] set The bytes to find.
+ *
+ * @return The index of the first byte in @p set, or `SIZE_MAX` (<stdint.h>).
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t index = parcByteScan_FindAny(11, (uint8_t *) "Hello World", 2, (uint8_t *) " W");
+ *
+ *     // index is 5
+ * }
+ * @endcode
+ *
+ * @see parcByteScan_FindNotAny
+ */
+size_t parcByteScan_FindAny(size_t length, const uint8_t array[length], size_t setLength, const uint8_t set[setLength]);
+
+/**
+ * Return the index of the first byte in @p array that is not one of the bytes in @p set.
+ *
+ * Sets of up to 16 bytes are searched with vector instructions.
+ *
+ * @param [in] length The number of bytes in @p array.
+ * @param [in] array The bytes to search.
+ * @param [in] setLength The number of bytes in @p set.
+ * @param [in] set The bytes to skip.
+ *
+ * @return The index of the first byte not in @p set, or `SIZE_MAX` (<stdint.h>).
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t index = parcByteScan_FindNotAny(8, (uint8_t *) " \t\n{ }\n", 3, (uint8_t *) " \t\n");
+ *
+ *     // index is 3
+ * }
+ * @endcode
+ *
+ * @see parcByteScan_FindAny
+ */
+size_t parcByteScan_FindNotAny(size_t length, const uint8_t array[length], size_t setLength, const uint8_t set[setLength]);
+
+/**
+ * Return the index of the first occurrence of @p pattern in @p array.
+ *
+ * An empty pattern is found at index 0.
+ *
+ * @param [in] length The number of bytes in @p array.
+ * @param [in] array The bytes to search.
+ * @param [in] patternLength The number of bytes in @p pattern.
+ * @param [in] pattern The sequence of bytes to find.
+ *
+ * @return The index of the first byte of the first occurrence of @p pattern, or `SIZE_MAX` (<stdint.h>).
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t index = parcByteScan_FindBytes(11, (uint8_t *) "Hello World", 3, (uint8_t *) "orl");
+ *
+ *     // index is 7
+ * }
+ * @endcode
+ */
+size_t parcByteScan_FindBytes(size_t length, const uint8_t array[length], size_t patternLength, const uint8_t pattern[patternLength]);
+#endif // libparc_parc_ByteScan_h
@@ -167,6 +167,9 @@ bool parcFileInputStream_Read(PARCFileInputStream *inputStream, PARCBuffer *buff
 /**
  * Read the content of a `PARCFileInputStream` into a {@link PARCBuffer}.
  *
+ * The whole file is read into memory allocated for the buffer.
+ * For a large file, {@link parcBuffer_MapFile} avoids both the time to read it and the copy of it in the heap.
+ *
  * @param [in] inputStream The `PARCFileInputStream` to read.
  *
  * @return non-NULL A pointer to a `PARCBuffer` instance containing the content of the `PARCFileInputStream`.
@@ -178,6 +181,8 @@ bool parcFileInputStream_Read(PARCFileInputStream *inputStream, PARCBuffer *buff
  *     <#example#>
  * }
  * @endcode
+ *
+ * @see parcBuffer_MapFile
  */
 PARCBuffer *parcFileInputStream_ReadFile(PARCFileInputStream *inputStream);
 #endif // libparc_parc_FileInputStream_h
@@ -30,8 +30,11 @@
  */
 #include <config.h>
 
+#include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <sys/uio.h>
 
 #include <LongBow/runtime.h>
 
@@ -41,7 +44,8 @@
 PARCOutputStreamInterface *PARCFileOutputStreamAsPARCInputStream = &(PARCOutputStreamInterface) {
     .Acquire = (PARCOutputStream * (*)(PARCOutputStream *))parcFileOutputStream_Acquire,
     .Release = (void (*)(PARCOutputStream **))parcFileOutputStream_Release,
-    .Write = (size_t (*)(PARCOutputStream *, PARCBuffer *))parcFileOutputStream_Write
+    .Write = (size_t (*)(PARCOutputStream *, PARCBuffer *))parcFileOutputStream_Write,
+    .WriteVector = (bool (*)(PARCOutputStream *, size_t, PARCBuffer **))parcFileOutputStream_WriteVector
 };
 
 struct parc_file_output_stream {
@@ -85,14 +89,67 @@ parcFileOutputStream_Write(PARCFileOutputStream *outputStream, PARCBuffer *buffe
     const size_t maximumChunkSize = 1024 * 1024;
 
     while (parcBuffer_HasRemaining(buffer)) {
+        size_t position = parcBuffer_Position(buffer);
         size_t remaining = parcBuffer_Remaining(buffer);
         size_t chunkSize = remaining > maximumChunkSize ? maximumChunkSize : remaining;
-        void *buf = parcBuffer_Overlay(buffer, chunkSize);
+        void *buf = parcBuffer_Overlay(buffer, 0);
         ssize_t nwritten = write(outputStream->fd, buf, chunkSize);
-        if (nwritten == -1) {
+        if (nwritten == -1 && errno == EINTR) {
+            continue;
+        }
+        // A write that makes no progress would otherwise be retried forever.
+        if (nwritten <= 0) {
             break;
         }
+        parcBuffer_SetPosition(buffer, position + (size_t) nwritten);
     }
 
     return parcBuffer_HasRemaining(buffer) == false;
 }
+
+#ifndef IOV_MAX
+#define IOV_MAX 16
+#endif
+
+bool
+parcFileOutputStream_WriteVector(PARCFileOutputStream *outputStream, size_t count, PARCBuffer *buffers[count])
+{
+    size_t first = 0;
+
+    while (true) {
+        // Skip the buffers that are already completely written.
+        while (first < count && parcBuffer_HasRemaining(buffers[first]) == false) {
+            first++;
+        }
+        if (first == count) {
+            return true;
+        }
+
+        struct iovec vector[IOV_MAX];
+        int vectorLength = 0;
+        for (size_t i = first; i < count && vectorLength < IOV_MAX; i++) {
+            if (parcBuffer_HasRemaining(buffers[i])) {
+                vector[vectorLength].iov_len = parcBuffer_Remaining(buffers[i]);
+                vector[vectorLength].iov_base = parcBuffer_Overlay(buffers[i], 0);
+                vectorLength++;
+            }
+        }
+
+        ssize_t nwritten = writev(outputStream->fd, vector, vectorLength);
+        if (nwritten == -1 && errno == EINTR) {
+            continue;
+        }
+        if (nwritten <= 0) {
+            return false;
+        }
+
+        // Account for a possibly short write by advancing each buffer by the bytes it gave up.
+        size_t written = (size_t) nwritten;
+        for (size_t i = first; i < count && written > 0; i++) {
+            size_t length = parcBuffer_Remaining(buffers[i]);
+            size_t consumed = written < length ? written : length;
+            parcBuffer_SetPosition(buffers[i], parcBuffer_Position(buffers[i]) + consumed);
+            written -= consumed;
+        }
+    }
+}
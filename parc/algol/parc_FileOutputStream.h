@@ -152,4 +152,32 @@ void parcFileOutputStream_Release(PARCFileOutputStream **streamPtr);
  * @endcode
  */
 bool parcFileOutputStream_Write(PARCFileOutputStream *outputStream, PARCBuffer *buffer);
+
+/**
+ * Write the contents of several {@link PARCBuffer} instances, in order, to the given `PARCFileOutputStream`.
+ *
+ * The buffers are written with writev(2), so a message kept as separate header, payload and trailer
+ * buffers is normally emitted in a single system call.
+ * Short writes and interrupted system calls are retried until every buffer is written or an error occurs.
+ * When this function returns the position of each buffer is set to the end of its last successfully written byte.
+ *
+ * @param [in,out] outputStream The `PARCFileOutputStream` to write to.
+ * @param [in] count The number of elements in @p buffers.
+ * @param [in] buffers An array of pointers to `PARCBuffer` instances, each written from its position to its limit.
+ *
+ * @return true The entire contents of every `PARCBuffer` were written.
+ * @return false The entire contents of one or more `PARCBuffer` instances were not written.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffers[3] = { header, payload, trailer };
+ *
+ *     parcFileOutputStream_WriteVector(stream, 3, buffers);
+ *
+ *     assertFalse(parcBuffer_HasRemaining(payload), "Expected the payload to be emtpy");
+ * }
+ * @endcode
+ */
+bool parcFileOutputStream_WriteVector(PARCFileOutputStream *outputStream, size_t count, PARCBuffer *buffers[count]);
 #endif // libparc_parc_FileOutputStream_h
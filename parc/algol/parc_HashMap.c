@@ -121,7 +121,7 @@ _parcHashMap_GetEntry(const PARCHashMap *hashMap, const PARCObject *key)
 
 static parcObject_ImplementRelease(_parcHashMapEntry, _PARCHashMapEntry);
 
-parcObject_ExtendPARCObject(_PARCHashMapEntry, _parcHashMapEntry_Finalize, NULL, NULL, _parcHashMapEntry_Equals, NULL, _parcHashMapEntry_HashCode, NULL);
+parcObject_ExtendPARCObjectPooled(_PARCHashMapEntry, _parcHashMapEntry_Finalize, NULL, NULL, _parcHashMapEntry_Equals, NULL, _parcHashMapEntry_HashCode, NULL);
 
 static _PARCHashMapEntry *
 _parcHashMapEntry_Create(const PARCObject *key, const PARCObject *value)
@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <parc/algol/parc_HugePageMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/**
+ * Every large allocation begins its mapping with this header.
+ */
+typedef struct {
+    size_t mappedLength;    // The length of the mapping.
+    size_t offset;          // The distance from the beginning of the mapping to the allocation.
+    size_t length;          // The length of the allocation, as requested.
+    bool hugeTLB;           // The mapping is from the kernel's huge page pool.
+} _PARCHugePageMemoryHeader;
+
+/**
+ * A live large allocation, as recorded in the registry.
+ */
+typedef struct {
+    const void *memory;                 // The address returned to the caller.
+    _PARCHugePageMemoryHeader *header;  // The beginning of its mapping.
+} _PARCHugePageMemoryMapping;
+
+/**
+ * The live large allocations, sorted by address.
+ *
+ * Membership is decided only by this registry, never by the memory before an allocation,
+ * which the preceding allocation of the standard library is free to overwrite.
+ */
+static struct {
+    pthread_mutex_t lock;
+    _PARCHugePageMemoryMapping *mappings;
+    size_t count;
+    size_t capacity;
+} _parcHugePageMemory_Registry = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+// Large allocations begin at least this far into their mapping, which keeps them aligned on a cache line.
+#define _parcHugePageMemory_MinimumOffset 64
+
+// The most NUMA nodes that a node mask describes.
+#define _parcHugePageMemory_MaximumNodes 1024
+
+static pthread_once_t _parcHugePageMemory_Once = PTHREAD_ONCE_INIT;
+
+static PARCHugePageMemoryConfiguration _parcHugePageMemory_Configuration = {
+    .mode      = PARCHugePageMemoryMode_Transparent,
+    .numa      = PARCHugePageMemoryNUMA_Off,
+    .threshold = parcHugePageMemory_DefaultThreshold
+};
+
+static PARCHugePageMemoryStatistics _parcHugePageMemory_Statistics;
+
+static void
+_parcHugePageMemory_InitOnce(void)
+{
+    parcHugePageMemory_ReadEnvironment();
+}
+
+static inline const PARCHugePageMemoryConfiguration *
+_configuration(void)
+{
+    pthread_once(&_parcHugePageMemory_Once, _parcHugePageMemory_InitOnce);
+    return &_parcHugePageMemory_Configuration;
+}
+
+static bool
+_parseSize(const char *string, size_t *result)
+{
+    char *end;
+    errno = 0;
+    unsigned long long value = strtoull(string, &end, 10);
+    if (errno != 0 || end == string) {
+        return false;
+    }
+
+    switch (toupper((unsigned char) *end)) {
+        case 'G':
+            value <<= 10;
+        // fall through
+        case 'M':
+            value <<= 10;
+        // fall through
+        case 'K':
+            value <<= 10;
+            end++;
+            break;
+        default:
+            break;
+    }
+    if (*end != 0 || value == 0) {
+        return false;
+    }
+
+    *result = (size_t) value;
+    return true;
+}
+
+void
+parcHugePageMemory_ReadEnvironment(void)
+{
+    PARCHugePageMemoryConfiguration configuration = {
+        .mode      = PARCHugePageMemoryMode_Transparent,
+        .numa      = PARCHugePageMemoryNUMA_Off,
+        .threshold = parcHugePageMemory_DefaultThreshold
+    };
+
+    const char *mode = getenv("PARC_HUGEPAGE_MODE");
+    if (mode != NULL) {
+        if (strcasecmp(mode, "off") == 0) {
+            configuration.mode = PARCHugePageMemoryMode_Off;
+        } else if (strcasecmp(mode, "hugetlb") == 0) {
+            configuration.mode = PARCHugePageMemoryMode_HugeTLB;
+        }
+    }
+
+    const char *threshold = getenv("PARC_HUGEPAGE_THRESHOLD");
+    if (threshold != NULL) {
+        _parseSize(threshold, &configuration.threshold);
+    }
+
+    const char *numa = getenv("PARC_HUGEPAGE_NUMA");
+    if (numa != NULL) {
+        if (strcasecmp(numa, "local") == 0) {
+            configuration.numa = PARCHugePageMemoryNUMA_Local;
+        } else if (strcasecmp(numa, "interleave") == 0) {
+            configuration.numa = PARCHugePageMemoryNUMA_Interleave;
+        }
+    }
+
+    _parcHugePageMemory_Configuration = configuration;
+}
+
+void
+parcHugePageMemory_Configure(const PARCHugePageMemoryConfiguration *configuration)
+{
+    trapIllegalValueIf(configuration->threshold == 0, "The threshold must be greater than 0.");
+
+    pthread_once(&_parcHugePageMemory_Once, _parcHugePageMemory_InitOnce);
+    _parcHugePageMemory_Configuration = *configuration;
+}
+
+PARCHugePageMemoryConfiguration
+parcHugePageMemory_GetConfiguration(void)
+{
+    return *_configuration();
+}
+
+PARCHugePageMemoryStatistics
+parcHugePageMemory_GetStatistics(void)
+{
+    PARCHugePageMemoryStatistics result;
+    result.mappings = __sync_add_and_fetch(&_parcHugePageMemory_Statistics.mappings, 0);
+    result.mappedBytes = __sync_add_and_fetch(&_parcHugePageMemory_Statistics.mappedBytes, 0);
+    result.hugeTLBMappings = __sync_add_and_fetch(&_parcHugePageMemory_Statistics.hugeTLBMappings, 0);
+    result.bindFailures = __sync_add_and_fetch(&_parcHugePageMemory_Statistics.bindFailures, 0);
+    return result;
+}
+
+/**
+ * Return the index in the registry of the first mapping at or after @p memory.
+ * The caller holds the registry lock.
+ */
+static size_t
+_registryIndex(const void *memory)
+{
+    size_t low = 0;
+    size_t high = _parcHugePageMemory_Registry.count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if ((uintptr_t) _parcHugePageMemory_Registry.mappings[middle].memory < (uintptr_t) memory) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static bool
+_register(const void *memory, _PARCHugePageMemoryHeader *header)
+{
+    bool result = true;
+
+    pthread_mutex_lock(&_parcHugePageMemory_Registry.lock);
+    if (_parcHugePageMemory_Registry.count == _parcHugePageMemory_Registry.capacity) {
+        size_t capacity = (_parcHugePageMemory_Registry.capacity == 0) ? 64 : 2 * _parcHugePageMemory_Registry.capacity;
+        _PARCHugePageMemoryMapping *mappings =
+            realloc(_parcHugePageMemory_Registry.mappings, capacity * sizeof(_PARCHugePageMemoryMapping));
+        if (mappings == NULL) {
+            result = false;
+        } else {
+            _parcHugePageMemory_Registry.mappings = mappings;
+            _parcHugePageMemory_Registry.capacity = capacity;
+        }
+    }
+    if (result) {
+        size_t index = _registryIndex(memory);
+        memmove(&_parcHugePageMemory_Registry.mappings[index + 1], &_parcHugePageMemory_Registry.mappings[index],
+                (_parcHugePageMemory_Registry.count - index) * sizeof(_PARCHugePageMemoryMapping));
+        _parcHugePageMemory_Registry.mappings[index].memory = memory;
+        _parcHugePageMemory_Registry.mappings[index].header = header;
+        __atomic_store_n(&_parcHugePageMemory_Registry.count, _parcHugePageMemory_Registry.count + 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&_parcHugePageMemory_Registry.lock);
+
+    return result;
+}
+
+/**
+ * Large allocations begin a power of two, and at least `_parcHugePageMemory_MinimumOffset` bytes, into a mapping
+ * aligned on a huge page, or begin on a huge page boundary.
+ * This rejects most memory of the standard library without taking the registry lock.
+ */
+static inline bool
+_mayBeLarge(const void *memory)
+{
+    if (__atomic_load_n(&_parcHugePageMemory_Registry.count, __ATOMIC_RELAXED) == 0) {
+        return false;
+    }
+    uintptr_t offset = (uintptr_t) memory & (parcHugePageMemory_PageSize - 1);
+    return offset == 0 || (offset >= _parcHugePageMemory_MinimumOffset && (offset & (offset - 1)) == 0);
+}
+
+/**
+ * Find the header of the large allocation @p memory, or NULL if it is not a live large allocation.
+ * If @p unregister is true, the allocation is removed from the registry.
+ */
+static _PARCHugePageMemoryHeader *
+_lookup(const void *memory, bool unregister)
+{
+    if (!_mayBeLarge(memory)) {
+        return NULL;
+    }
+
+    _PARCHugePageMemoryHeader *result = NULL;
+
+    pthread_mutex_lock(&_parcHugePageMemory_Registry.lock);
+    size_t index = _registryIndex(memory);
+    if (index < _parcHugePageMemory_Registry.count && _parcHugePageMemory_Registry.mappings[index].memory == memory) {
+        result = _parcHugePageMemory_Registry.mappings[index].header;
+        if (unregister) {
+            memmove(&_parcHugePageMemory_Registry.mappings[index], &_parcHugePageMemory_Registry.mappings[index + 1],
+                    (_parcHugePageMemory_Registry.count - index - 1) * sizeof(_PARCHugePageMemoryMapping));
+            __atomic_store_n(&_parcHugePageMemory_Registry.count, _parcHugePageMemory_Registry.count - 1, __ATOMIC_RELAXED);
+        }
+    }
+    pthread_mutex_unlock(&_parcHugePageMemory_Registry.lock);
+
+    return result;
+}
+
+static inline _PARCHugePageMemoryHeader *
+_header(const void *memory)
+{
+    return _lookup(memory, false);
+}
+
+static inline bool
+_isLarge(const void *memory)
+{
+    return _header(memory) != NULL;
+}
+
+static inline size_t
+_capacity(const _PARCHugePageMemoryHeader *header)
+{
+    return header->mappedLength - header->offset;
+}
+
+/**
+ * Bind the pages of a new mapping according to the NUMA configuration, before they are touched.
+ */
+static void
+_bind(void *mapping, size_t length, PARCHugePageMemoryNUMA numa)
+{
+    if (numa == PARCHugePageMemoryNUMA_Off) {
+        return;
+    }
+
+    bool bound = false;
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    unsigned long nodes[_parcHugePageMemory_MaximumNodes / (8 * sizeof(unsigned long))];
+    memset(nodes, 0, sizeof(nodes));
+
+    int policy;
+    if (numa == PARCHugePageMemoryNUMA_Local) {
+        unsigned int cpu;
+        unsigned int node;
+        if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && node < _parcHugePageMemory_MaximumNodes) {
+            nodes[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+        }
+        policy = MPOL_PREFERRED;
+    } else {
+        syscall(SYS_get_mempolicy, NULL, nodes, _parcHugePageMemory_MaximumNodes, NULL, MPOL_F_MEMS_ALLOWED);
+        policy = MPOL_INTERLEAVE;
+    }
+
+    bound = syscall(SYS_mbind, mapping, length, policy, nodes, _parcHugePageMemory_MaximumNodes, 0) == 0;
+#endif
+
+    if (!bound) {
+        __sync_add_and_fetch(&_parcHugePageMemory_Statistics.bindFailures, 1);
+    }
+}
+
+/**
+ * Map @p length bytes of ordinary memory aligned on @p alignment bytes,
+ * by mapping more than necessary and unmapping the excess.
+ */
+static void *
+_mapAligned(size_t length, size_t alignment)
+{
+    char *mapping = mmap(NULL, length + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    char *result = (char *) (((uintptr_t) mapping + alignment - 1) & ~(uintptr_t) (alignment - 1));
+    if (result > mapping) {
+        munmap(mapping, result - mapping);
+    }
+    size_t tail = (mapping + length + alignment) - (result + length);
+    if (tail > 0) {
+        munmap(result + length, tail);
+    }
+
+#if defined(MADV_HUGEPAGE)
+    madvise(result, length, MADV_HUGEPAGE);
+#endif
+    return result;
+}
+
+static void *
+_allocateLarge(size_t alignment, size_t size)
+{
+    const PARCHugePageMemoryConfiguration *configuration = _configuration();
+
+    size_t offset = (alignment > _parcHugePageMemory_MinimumOffset) ? alignment : _parcHugePageMemory_MinimumOffset;
+    if (size > SIZE_MAX - offset - 2 * parcHugePageMemory_PageSize - alignment) {
+        return NULL;
+    }
+    size_t mappedLength = (offset + size + parcHugePageMemory_PageSize - 1) & ~(parcHugePageMemory_PageSize - 1);
+
+    char *mapping = NULL;
+    bool hugeTLB = false;
+#if defined(MAP_HUGETLB)
+    if (configuration->mode == PARCHugePageMemoryMode_HugeTLB && alignment <= parcHugePageMemory_PageSize) {
+        mapping = mmap(NULL, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapping == MAP_FAILED) {
+            mapping = NULL;
+        } else {
+            hugeTLB = true;
+        }
+    }
+#endif
+    if (mapping == NULL) {
+        mapping = _mapAligned(mappedLength, (alignment > parcHugePageMemory_PageSize) ? alignment : parcHugePageMemory_PageSize);
+        if (mapping == NULL) {
+            return NULL;
+        }
+    }
+
+    _bind(mapping, mappedLength, configuration->numa);
+
+    _PARCHugePageMemoryHeader *header = (_PARCHugePageMemoryHeader *) mapping;
+    header->mappedLength = mappedLength;
+    header->offset = offset;
+    header->length = size;
+    header->hugeTLB = hugeTLB;
+
+    void *result = &mapping[offset];
+    if (!_register(result, header)) {
+        munmap(mapping, mappedLength);
+        return NULL;
+    }
+
+    __sync_add_and_fetch(&_parcHugePageMemory_Statistics.mappings, 1);
+    __sync_add_and_fetch(&_parcHugePageMemory_Statistics.mappedBytes, mappedLength);
+    if (hugeTLB) {
+        __sync_add_and_fetch(&_parcHugePageMemory_Statistics.hugeTLBMappings, 1);
+    }
+    return result;
+}
+
+/**
+ * Unmap a large allocation that has already been removed from the registry.
+ */
+static void
+_deallocateLarge(_PARCHugePageMemoryHeader *header)
+{
+    size_t mappedLength = header->mappedLength;
+
+    __sync_sub_and_fetch(&_parcHugePageMemory_Statistics.mappings, 1);
+    __sync_sub_and_fetch(&_parcHugePageMemory_Statistics.mappedBytes, mappedLength);
+    if (header->hugeTLB) {
+        __sync_sub_and_fetch(&_parcHugePageMemory_Statistics.hugeTLBMappings, 1);
+    }
+
+    munmap(header, mappedLength);
+}
+
+static inline bool
+_isLargeSize(const PARCHugePageMemoryConfiguration *configuration, size_t size)
+{
+    return configuration->mode != PARCHugePageMemoryMode_Off && size >= configuration->threshold;
+}
+
+void *
+parcHugePageMemory_Allocate(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    if (_isLargeSize(_configuration(), size)) {
+        return _allocateLarge(sizeof(void *), size);
+    }
+    return parcStdlibMemory_Allocate(size);
+}
+
+void *
+parcHugePageMemory_AllocateAndClear(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    // New mappings are already clear.
+    if (_isLargeSize(_configuration(), size)) {
+        return _allocateLarge(sizeof(void *), size);
+    }
+    return parcStdlibMemory_AllocateAndClear(size);
+}
+
+int
+parcHugePageMemory_MemAlign(void **pointer, size_t alignment, size_t size)
+{
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0 || size == 0) {
+        return EINVAL;
+    }
+
+    if (_isLargeSize(_configuration(), size)) {
+        *pointer = _allocateLarge(alignment, size);
+        return (*pointer == NULL) ? ENOMEM : 0;
+    }
+    return parcStdlibMemory_MemAlign(pointer, alignment, size);
+}
+
+void
+parcHugePageMemory_Deallocate(void **pointer)
+{
+    void *memory = *pointer;
+    _PARCHugePageMemoryHeader *header = (memory != NULL) ? _lookup(memory, true) : NULL;
+    if (header != NULL) {
+        _deallocateLarge(header);
+        *pointer = NULL;
+    } else {
+        parcStdlibMemory_Deallocate(pointer);
+    }
+}
+
+bool
+parcHugePageMemory_ReallocateInPlace(void *pointer, size_t newSize)
+{
+    _PARCHugePageMemoryHeader *header = _header(pointer);
+    if (header != NULL) {
+        if (newSize > _capacity(header)) {
+            return false;
+        }
+        header->length = newSize;
+        return true;
+    }
+    return parcStdlibMemory_ReallocateInPlace(pointer, newSize);
+}
+
+size_t
+parcHugePageMemory_UsableSize(const void *pointer)
+{
+    _PARCHugePageMemoryHeader *header = _header(pointer);
+    if (header != NULL) {
+        return _capacity(header);
+    }
+    return parcStdlibMemory_UsableSize(pointer);
+}
+
+void *
+parcHugePageMemory_Reallocate(void *pointer, size_t newSize)
+{
+    if (pointer == NULL) {
+        return parcHugePageMemory_Allocate(newSize);
+    }
+    if (newSize == 0) {
+        newSize = 1;
+    }
+
+    _PARCHugePageMemoryHeader *header = _header(pointer);
+    if (header != NULL) {
+        if (newSize <= _capacity(header)) {
+            header->length = newSize;
+            return pointer;
+        }
+        void *result = parcHugePageMemory_Allocate(newSize);
+        if (result != NULL) {
+            memcpy(result, pointer, (header->length < newSize) ? header->length : newSize);
+            _deallocateLarge(_lookup(pointer, true));
+        }
+        return result;
+    }
+
+#if defined(__APPLE__) || defined(__GLIBC__)
+    // Move a growing allocation to huge pages once it reaches the threshold.
+    if (_isLargeSize(_configuration(), newSize)) {
+#if defined(__APPLE__)
+        size_t length = malloc_size(pointer);
+#else
+        size_t length = malloc_usable_size(pointer);
+#endif
+        void *result = _allocateLarge(sizeof(void *), newSize);
+        if (result != NULL) {
+            memcpy(result, pointer, (length < newSize) ? length : newSize);
+            parcStdlibMemory_Deallocate(&pointer);
+        }
+        return result;
+    }
+#endif
+    return parcStdlibMemory_Reallocate(pointer, newSize);
+}
+
+size_t
+parcHugePageMemory_GoodSize(size_t size)
+{
+    if (_isLargeSize(_configuration(), size)) {
+        size_t mappedLength = (_parcHugePageMemory_MinimumOffset + size + parcHugePageMemory_PageSize - 1) & ~(parcHugePageMemory_PageSize - 1);
+        return mappedLength - _parcHugePageMemory_MinimumOffset;
+    }
+    return parcStdlibMemory_GoodSize(size);
+}
+
+char *
+parcHugePageMemory_StringDuplicate(const char *string, size_t length)
+{
+    return parcStdlibMemory_StringDuplicate(string, length);
+}
+
+uint32_t
+parcHugePageMemory_Outstanding(void)
+{
+    return parcStdlibMemory_Outstanding() + (uint32_t) __sync_add_and_fetch(&_parcHugePageMemory_Statistics.mappings, 0);
+}
+
+PARCMemoryInterface PARCHugePageMemoryAsPARCMemory = {
+    .Allocate          = (uintptr_t) parcHugePageMemory_Allocate,
+    .AllocateAndClear  = (uintptr_t) parcHugePageMemory_AllocateAndClear,
+    .MemAlign          = (uintptr_t) parcHugePageMemory_MemAlign,
+    .Deallocate        = (uintptr_t) parcHugePageMemory_Deallocate,
+    .Reallocate        = (uintptr_t) parcHugePageMemory_Reallocate,
+    .StringDuplicate   = (uintptr_t) parcHugePageMemory_StringDuplicate,
+    .Outstanding       = (uintptr_t) parcHugePageMemory_Outstanding,
+    .GoodSize          = (uintptr_t) parcHugePageMemory_GoodSize,
+    .ReallocateInPlace = (uintptr_t) parcHugePageMemory_ReallocateInPlace,
+    .UsableSize        = (uintptr_t) parcHugePageMemory_UsableSize
+};
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_HugePageMemory.h
+ * @ingroup memory
+ * @brief A PARCMemoryInterface provider that serves large allocations from huge pages.
+ *
+ * Large in-memory tables suffer TLB misses when they are mapped with small pages.
+ * This provider maps each allocation of at least a threshold number of bytes on its own,
+ * aligned on and rounded up to `parcHugePageMemory_PageSize` so that the kernel can back it with huge pages,
+ * and optionally binds the mapping to the NUMA node of the allocating thread, or interleaves it across all nodes.
+ * Smaller allocations are served by {@link PARCStdlibMemoryAsPARCMemory}.
+ *
+ * The provider is configured by the following environment variables,
+ * which are read once, when the provider is first used after `parcMemory_SetInterface`:
+ *
+ * * `PARC_HUGEPAGE_MODE`: `transparent` (the default) maps ordinary memory and advises the kernel to use transparent huge pages;
+ *   `hugetlb` uses pages reserved in the kernel's huge page pool, falling back to `transparent` when the pool is empty;
+ *   `off` serves every allocation from the standard library.
+ * * `PARC_HUGEPAGE_THRESHOLD`: The least number of bytes of an allocation served from huge pages,
+ *   optionally followed by `K`, `M` or `G`. The default is `parcHugePageMemory_DefaultThreshold`.
+ * * `PARC_HUGEPAGE_NUMA`: `off` (the default) leaves placement to the kernel;
+ *   `local` prefers the NUMA node of the allocating thread; `interleave` interleaves the pages across all nodes.
+ *
+ * @code
+ * {
+ *     // PARC_HUGEPAGE_NUMA=local ./myapp
+ *     parcMemory_SetInterface(&PARCHugePageMemoryAsPARCMemory);
+ *
+ *     PARCHashCodeTable *table = parcHashCodeTable_Create_Size(...);
+ * }
+ * @endcode
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_HugePageMemory_h
+#define libparc_parc_HugePageMemory_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_Memory.h>
+
+extern PARCMemoryInterface PARCHugePageMemoryAsPARCMemory;
+
+/**
+ * The size of a huge page, which is the alignment and the granularity of large allocations.
+ */
+#define parcHugePageMemory_PageSize ((size_t) 2 * 1024 * 1024)
+
+/**
+ * The threshold unless `PARC_HUGEPAGE_THRESHOLD` is set.
+ * Rounding up to a whole huge page wastes less than half of an allocation of at least this size.
+ */
+#define parcHugePageMemory_DefaultThreshold (2 * parcHugePageMemory_PageSize)
+
+/**
+ * How large allocations are mapped.
+ */
+typedef enum {
+    PARCHugePageMemoryMode_Off,         // Every allocation is served by the standard library.
+    PARCHugePageMemoryMode_Transparent, // Ordinary memory, which the kernel is advised to back with transparent huge pages.
+    PARCHugePageMemoryMode_HugeTLB      // Pages of the kernel's huge page pool, or transparent huge pages when the pool is empty.
+} PARCHugePageMemoryMode;
+
+/**
+ * Where the pages of large allocations are placed.
+ */
+typedef enum {
+    PARCHugePageMemoryNUMA_Off,         // The kernel's default policy.
+    PARCHugePageMemoryNUMA_Local,       // Preferably on the NUMA node of the allocating thread.
+    PARCHugePageMemoryNUMA_Interleave   // Interleaved across every NUMA node the process may use.
+} PARCHugePageMemoryNUMA;
+
+typedef struct {
+    PARCHugePageMemoryMode mode;
+    PARCHugePageMemoryNUMA numa;
+    size_t threshold;                   // The least number of bytes of an allocation served from huge pages.
+} PARCHugePageMemoryConfiguration;
+
+typedef struct {
+    size_t mappings;                    // The number of large allocations currently mapped.
+    size_t mappedBytes;                 // The number of bytes of those mappings.
+    size_t hugeTLBMappings;             // The number of those mappings from the kernel's huge page pool.
+    size_t bindFailures;                // The number of mappings that could not be bound to NUMA nodes.
+} PARCHugePageMemoryStatistics;
+
+/**
+ * Read the configuration from the environment variables `PARC_HUGEPAGE_MODE`, `PARC_HUGEPAGE_THRESHOLD` and `PARC_HUGEPAGE_NUMA`.
+ *
+ * This is done automatically the first time the provider is used.
+ * Variables that are not set, or not understood, take their default values.
+ * The new configuration applies to subsequent allocations.
+ *
+ * Example:
+ * @code
+ * {
+ *     setenv("PARC_HUGEPAGE_THRESHOLD", "64M", 1);
+ *     parcHugePageMemory_ReadEnvironment();
+ * }
+ * @endcode
+ */
+void parcHugePageMemory_ReadEnvironment(void);
+
+/**
+ * Set the configuration of the provider, overriding the environment.
+ *
+ * The new configuration applies to subsequent allocations.
+ *
+ * @param [in] configuration A pointer to a valid `PARCHugePageMemoryConfiguration`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHugePageMemoryConfiguration configuration = parcHugePageMemory_GetConfiguration();
+ *     configuration.numa = PARCHugePageMemoryNUMA_Local;
+ *     parcHugePageMemory_Configure(&configuration);
+ * }
+ * @endcode
+ */
+void parcHugePageMemory_Configure(const PARCHugePageMemoryConfiguration *configuration);
+
+/**
+ * Get the configuration of the provider.
+ *
+ * @return The configuration in effect.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t threshold = parcHugePageMemory_GetConfiguration().threshold;
+ * }
+ * @endcode
+ */
+PARCHugePageMemoryConfiguration parcHugePageMemory_GetConfiguration(void);
+
+/**
+ * Get the statistics of the large allocations of the provider.
+ *
+ * @return The statistics at the time of the call.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHugePageMemoryStatistics statistics = parcHugePageMemory_GetStatistics();
+ *     printf("%zd bytes in %zd mappings\n", statistics.mappedBytes, statistics.mappings);
+ * }
+ * @endcode
+ */
+PARCHugePageMemoryStatistics parcHugePageMemory_GetStatistics(void);
+
+/**
+ * Allocate memory.
+ *
+ * @param [in] size The size of memory to allocate
+ *
+ * @return A pointer to the allocated memory, or NULL if @p size is 0 or the memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcHugePageMemory_Allocate(64 * 1024 * 1024);
+ *     parcHugePageMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcHugePageMemory_Allocate(size_t size);
+
+/**
+ * Allocate memory of size @p size and clear it.
+ *
+ * Large allocations are mapped already clear, so they are not written until they are used.
+ *
+ * @param [in] size Size of memory to allocate
+ *
+ * @return A pointer to the allocated memory
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcHugePageMemory_AllocateAndClear(64 * 1024 * 1024);
+ *     parcHugePageMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcHugePageMemory_AllocateAndClear(size_t size);
+
+/**
+ * Allocate aligned memory.
+ *
+ * @param [out] pointer A pointer to a `void *` pointer that will be set to the address of the allocated memory.
+ * @param [in] alignment A power of 2 greater than or equal to `sizeof(void *)`
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return 0 Successful
+ * @return EINVAL The alignment parameter is not a power of 2 at least as large as sizeof(void *), or @p size is 0.
+ * @return ENOMEM Memory allocation error.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory;
+ *     if (parcHugePageMemory_MemAlign(&memory, 4096, 64 * 1024 * 1024) == 0) {
+ *         parcHugePageMemory_Deallocate(&memory);
+ *     }
+ * }
+ * @endcode
+ */
+int parcHugePageMemory_MemAlign(void **pointer, size_t alignment, size_t size);
+
+/**
+ * Deallocate the memory pointed to by @p pointer
+ *
+ * @param [in,out] pointer A pointer to a pointer to the memory to be deallocated
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcHugePageMemory_Allocate(100);
+ *     parcHugePageMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void parcHugePageMemory_Deallocate(void **pointer);
+
+/**
+ * Resize previously allocated memory at @p pointer to @p newSize.
+ *
+ * A large allocation is resized in place while it fits in its mapping.
+ * A small allocation that grows to the threshold is moved to huge pages.
+ *
+ * @param [in,out] pointer A pointer to the memory to be reallocated.
+ * @param [in] newSize The size that the memory to be resized to.
+ *
+ * @return A pointer to the memory
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcHugePageMemory_Allocate(100);
+ *     memory = parcHugePageMemory_Reallocate(memory, 64 * 1024 * 1024);
+ *     parcHugePageMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcHugePageMemory_Reallocate(void *pointer, size_t newSize);
+
+/**
+ * Try to resize previously allocated memory at @p pointer to @p newSize without moving it.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ * @param [in] newSize The size that the memory to be resized to.
+ *
+ * @return true The memory now holds at least @p newSize bytes.
+ * @return false The memory is unchanged.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcHugePageMemory_Allocate(64 * 1024 * 1024);
+ *     bool resized = parcHugePageMemory_ReallocateInPlace(memory, 65 * 1024 * 1024);
+ *     parcHugePageMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+bool parcHugePageMemory_ReallocateInPlace(void *pointer, size_t newSize);
+
+/**
+ * Return the number of bytes, at least @p size, that an allocation of @p size bytes provides.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return The number of bytes to allocate without waste.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t capacity = parcHugePageMemory_GoodSize(64 * 1024 * 1024);
+ * }
+ * @endcode
+ */
+size_t parcHugePageMemory_GoodSize(size_t size);
+
+/**
+ * Return the number of bytes that the allocation pointed to by @p pointer holds.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ *
+ * @return The number of bytes of the allocation, or 0 if it cannot be measured.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcHugePageMemory_Allocate(64 * 1024 * 1024);
+ *     size_t size = parcHugePageMemory_UsableSize(memory);
+ *     parcHugePageMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+size_t parcHugePageMemory_UsableSize(const void *pointer);
+
+/**
+ * Allocate sufficient memory for a copy of the string @p string,
+ * copy at most n characters from the string @p string into the allocated memory,
+ * and return the pointer to allocated memory.
+ *
+ * @param [in] string A pointer to a null-terminated string.
+ * @param [in] length  The maximum allowed length of the resulting copy.
+ *
+ * @return non-NULL A pointer to allocated memory.
+ * @return NULL A an error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     char *copy = parcHugePageMemory_StringDuplicate("this is a string", 16);
+ *     parcHugePageMemory_Deallocate((void **) &copy);
+ * }
+ * @endcode
+ */
+char *parcHugePageMemory_StringDuplicate(const char *string, size_t length);
+
+/**
+ * Return the number of outstanding allocations, both large and small.
+ *
+ * @return The number of memory allocations still outstanding (remaining to be deallocated).
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t numberOfAllocations = parcHugePageMemory_Outstanding();
+ * }
+ * @endcode
+ */
+uint32_t parcHugePageMemory_Outstanding(void);
+#endif // libparc_parc_HugePageMemory_h
@@ -38,6 +38,7 @@
 #include <parc/algol/parc_JSONParser.h>
 
 #include <parc/algol/parc_BufferComposer.h>
+#include <parc/algol/parc_BufferView.h>
 #include <parc/algol/parc_Object.h>
 
 struct parc_buffer_parser {
@@ -144,12 +145,53 @@ parcJSONParser_RequireString(PARCJSONParser *parser, const char *string)
     return true;
 }
 
+/*
+ * Most strings have no escaped or control characters,
+ * so they are found with a view of the input and copied to the result all at once.
+ *
+ * @return NULL The string is not a plain string, and the position of the buffer is unchanged.
+ */
+static PARCBuffer *
+_parcJSONParser_ParsePlainString(PARCBuffer *buffer)
+{
+    PARCBufferView view;
+    parcBufferView_InitFromBuffer(&view, buffer);
+
+    if (parcBufferView_Remaining(&view) == 0 || parcBufferView_GetUint8(&view) != '"') {
+        return NULL;
+    }
+
+    size_t end = parcBufferView_FindUint8(&view, '"');
+    if (end == SIZE_MAX) {
+        return NULL;
+    }
+
+    PARCBufferView string;
+    parcBufferView_Slice(&string, &view, end - parcBufferView_Position(&view));
+    const uint8_t *bytes = parcBufferView_Overlay(&string);
+    for (size_t i = 0; i < parcBufferView_Remaining(&string); i++) {
+        if (bytes[i] == '\\' || iscntrl(bytes[i])) {
+            return NULL;
+        }
+    }
+
+    PARCBuffer *result = parcBufferView_ToBuffer(&string);
+    if (result != NULL) {
+        parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) + end + 1);
+    }
+    return result;
+}
+
 PARCBuffer *
 parcJSONParser_ParseString(PARCJSONParser *parser)
 {
-    PARCBuffer *result = NULL;
-
     PARCBuffer *buffer = _getBuffer(parser);
+
+    PARCBuffer *result = _parcJSONParser_ParsePlainString(buffer);
+    if (result != NULL) {
+        return result;
+    }
+
     if (parcBuffer_GetUint8(buffer) == '"') { // skip the initial '"' character starting the string.
         PARCBufferComposer *composer = parcBufferComposer_Create();
 
@@ -37,6 +37,7 @@
 #include <stdarg.h>
 #include <string.h>
 #include <stdio.h>
+#include <pthread.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -47,6 +48,36 @@
 
 static const PARCMemoryInterface *parcMemory = &PARCStdlibMemoryAsPARCMemory;
 
+static pthread_once_t _parcMemory_ThreadInterfaceOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcMemory_ThreadInterfaceKey;
+
+// The number of threads that have set their own interface, so that other threads need not look for one.
+static unsigned int _parcMemory_ThreadInterfaceCount = 0;
+
+static void
+_parcMemory_ThreadInterfaceExit(void *memoryProvider __attribute__((unused)))
+{
+    __sync_sub_and_fetch(&_parcMemory_ThreadInterfaceCount, 1);
+}
+
+static void
+_parcMemory_ThreadInterfaceInitOnce(void)
+{
+    pthread_key_create(&_parcMemory_ThreadInterfaceKey, _parcMemory_ThreadInterfaceExit);
+}
+
+static inline const PARCMemoryInterface *
+_parcMemory_Interface(void)
+{
+    if (_parcMemory_ThreadInterfaceCount != 0) {
+        const PARCMemoryInterface *result = pthread_getspecific(_parcMemory_ThreadInterfaceKey);
+        if (result != NULL) {
+            return result;
+        }
+    }
+    return parcMemory;
+}
+
 const PARCMemoryInterface *
 parcMemory_SetInterface(const PARCMemoryInterface *memoryProvider)
 {
@@ -58,6 +89,254 @@ parcMemory_SetInterface(const PARCMemoryInterface *memoryProvider)
     return result;
 }
 
+const PARCMemoryInterface *
+parcMemory_GetInterface(void)
+{
+    return parcMemory;
+}
+
+const PARCMemoryInterface *
+parcMemory_SetThreadInterface(const PARCMemoryInterface *memoryProvider)
+{
+    assertFalse(memoryProvider == &PARCMemoryAsPARCMemory,
+                "You cannot use PARCMemoryAsPARCMemory as a memory provider for parcMemory.");
+
+    pthread_once(&_parcMemory_ThreadInterfaceOnce, _parcMemory_ThreadInterfaceInitOnce);
+
+    const PARCMemoryInterface *result = pthread_getspecific(_parcMemory_ThreadInterfaceKey);
+    if (result == NULL && memoryProvider != NULL) {
+        __sync_add_and_fetch(&_parcMemory_ThreadInterfaceCount, 1);
+    } else if (result != NULL && memoryProvider == NULL) {
+        __sync_sub_and_fetch(&_parcMemory_ThreadInterfaceCount, 1);
+    }
+    pthread_setspecific(_parcMemory_ThreadInterfaceKey, memoryProvider);
+
+    return result;
+}
+
+const PARCMemoryInterface *
+parcMemory_GetThreadInterface(void)
+{
+    if (_parcMemory_ThreadInterfaceCount != 0) {
+        return pthread_getspecific(_parcMemory_ThreadInterfaceKey);
+    }
+    return NULL;
+}
+
+// The soft limit, while it is not 0 the bytes allocated through parcMemory are counted.
+static size_t _parcMemory_SoftLimit = 0;
+
+// The bytes in use, to which each thread adds its own count in steps of at least parcMemory_UsageGranularity.
+static int64_t _parcMemory_Usage = 0;
+
+static pthread_once_t _parcMemory_UsageOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcMemory_UsageKey;
+
+typedef struct parc_memory_pressure_callback {
+    PARCMemoryPressureCallback *callback;
+    void *context;
+    unsigned int percent;
+    bool armed;
+    struct parc_memory_pressure_callback *next;
+} _PARCMemoryPressureCallback;
+
+static pthread_mutex_t _parcMemory_PressureMutex = PTHREAD_MUTEX_INITIALIZER;
+static _PARCMemoryPressureCallback *_parcMemory_PressureCallbacks = NULL;
+static size_t _parcMemory_PressureCallbackCount = 0;
+
+static void
+_parcMemory_CheckPressure(int64_t usage)
+{
+    size_t softLimit = _parcMemory_SoftLimit;
+    if (softLimit == 0 || _parcMemory_PressureCallbackCount == 0) {
+        return;
+    }
+    if (usage < 0) {
+        usage = 0;
+    }
+
+    // The callbacks are invoked without the lock held, so that they may allocate, deallocate and remove themselves.
+    pthread_mutex_lock(&_parcMemory_PressureMutex);
+    size_t count = _parcMemory_PressureCallbackCount;
+    struct {
+        PARCMemoryPressureCallback *callback;
+        void *context;
+    } fire[count + 1];
+    size_t nFire = 0;
+
+    for (_PARCMemoryPressureCallback *entry = _parcMemory_PressureCallbacks; entry != NULL; entry = entry->next) {
+        uint64_t threshold = (uint64_t) softLimit * entry->percent / 100;
+        if ((uint64_t) usage >= threshold) {
+            if (entry->armed) {
+                entry->armed = false;
+                fire[nFire].callback = entry->callback;
+                fire[nFire].context = entry->context;
+                nFire++;
+            }
+        } else {
+            entry->armed = true;
+        }
+    }
+    pthread_mutex_unlock(&_parcMemory_PressureMutex);
+
+    for (size_t i = 0; i < nFire; i++) {
+        fire[i].callback(fire[i].context, (size_t) usage, softLimit);
+    }
+}
+
+static void
+_parcMemory_UsageThreadExit(void *state)
+{
+    int64_t *delta = state;
+    __sync_add_and_fetch(&_parcMemory_Usage, *delta);
+    free(delta);
+}
+
+static void
+_parcMemory_UsageInitOnce(void)
+{
+    pthread_key_create(&_parcMemory_UsageKey, _parcMemory_UsageThreadExit);
+}
+
+static int64_t *
+_parcMemory_UsageDelta(void)
+{
+    int64_t *result = pthread_getspecific(_parcMemory_UsageKey);
+    if (result == NULL) {
+        // Not allocated through parcMemory, which would count it.
+        result = calloc(1, sizeof(int64_t));
+        if (result != NULL) {
+            pthread_setspecific(_parcMemory_UsageKey, result);
+        }
+    }
+    return result;
+}
+
+static void
+_parcMemory_UsageFold(int64_t *delta)
+{
+    int64_t usage = __sync_add_and_fetch(&_parcMemory_Usage, *delta);
+    *delta = 0;
+    _parcMemory_CheckPressure(usage);
+}
+
+static void
+_parcMemory_Account(int64_t bytes)
+{
+    int64_t *delta = _parcMemory_UsageDelta();
+    if (delta != NULL) {
+        *delta += bytes;
+        if (*delta >= parcMemory_UsageGranularity || *delta <= -parcMemory_UsageGranularity) {
+            _parcMemory_UsageFold(delta);
+        }
+    } else {
+        _parcMemory_CheckPressure(__sync_add_and_fetch(&_parcMemory_Usage, bytes));
+    }
+}
+
+static inline int64_t
+_parcMemory_UsableSize(const PARCMemoryInterface *memory, const void *pointer)
+{
+    if (pointer == NULL || memory->UsableSize == 0) {
+        return 0;
+    }
+    return (int64_t) ((PARCMemoryUsableSize *) memory->UsableSize)(pointer);
+}
+
+size_t
+parcMemory_SetSoftLimit(size_t bytes)
+{
+    pthread_once(&_parcMemory_UsageOnce, _parcMemory_UsageInitOnce);
+
+    pthread_mutex_lock(&_parcMemory_PressureMutex);
+    size_t result = _parcMemory_SoftLimit;
+    _parcMemory_SoftLimit = bytes;
+    if (bytes == 0) {
+        // Memory deallocated while not counting is not subtracted, so start again from nothing.
+        __sync_lock_test_and_set(&_parcMemory_Usage, 0);
+        int64_t *delta = pthread_getspecific(_parcMemory_UsageKey);
+        if (delta != NULL) {
+            *delta = 0;
+        }
+    }
+    for (_PARCMemoryPressureCallback *entry = _parcMemory_PressureCallbacks; entry != NULL; entry = entry->next) {
+        entry->armed = true;
+    }
+    pthread_mutex_unlock(&_parcMemory_PressureMutex);
+
+    if (bytes != 0) {
+        _parcMemory_CheckPressure(_parcMemory_Usage);
+    }
+
+    return result;
+}
+
+size_t
+parcMemory_GetSoftLimit(void)
+{
+    return _parcMemory_SoftLimit;
+}
+
+size_t
+parcMemory_GetUsage(void)
+{
+    if (_parcMemory_SoftLimit == 0) {
+        return 0;
+    }
+
+    int64_t *delta = _parcMemory_UsageDelta();
+    if (delta != NULL && *delta != 0) {
+        _parcMemory_UsageFold(delta);
+    }
+
+    int64_t usage = _parcMemory_Usage;
+    return usage < 0 ? 0 : (size_t) usage;
+}
+
+void
+parcMemory_AddPressureCallback(unsigned int percent, PARCMemoryPressureCallback *callback, void *context)
+{
+    assertNotNull(callback, "Parameter callback must be a non-null pointer to a PARCMemoryPressureCallback");
+
+    // Not allocated through parcMemory, which would count it and might be the provider under pressure.
+    _PARCMemoryPressureCallback *entry = malloc(sizeof(_PARCMemoryPressureCallback));
+    assertNotNull(entry, "Cannot allocate a pressure callback");
+
+    entry->callback = callback;
+    entry->context = context;
+    entry->percent = percent;
+    entry->armed = true;
+
+    pthread_mutex_lock(&_parcMemory_PressureMutex);
+    entry->next = _parcMemory_PressureCallbacks;
+    _parcMemory_PressureCallbacks = entry;
+    _parcMemory_PressureCallbackCount++;
+    pthread_mutex_unlock(&_parcMemory_PressureMutex);
+}
+
+bool
+parcMemory_RemovePressureCallback(PARCMemoryPressureCallback *callback, void *context)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&_parcMemory_PressureMutex);
+    _PARCMemoryPressureCallback **link = &_parcMemory_PressureCallbacks;
+    while (*link != NULL) {
+        _PARCMemoryPressureCallback *entry = *link;
+        if (entry->callback == callback && entry->context == context) {
+            *link = entry->next;
+            free(entry);
+            _parcMemory_PressureCallbackCount--;
+            result = true;
+        } else {
+            link = &entry->next;
+        }
+    }
+    pthread_mutex_unlock(&_parcMemory_PressureMutex);
+
+    return result;
+}
+
 size_t
 parcMemory_RoundUpToCacheLine(const size_t size)
 {
@@ -85,43 +364,124 @@ parcMemory_RoundUpToMultiple(const size_t size, const size_t multiple)
 void *
 parcMemory_Allocate(const size_t size)
 {
-    return ((PARCMemoryAllocate *) parcMemory->Allocate)(size);
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    void *result = ((PARCMemoryAllocate *) memory->Allocate)(size);
+    if (_parcMemory_SoftLimit != 0) {
+        _parcMemory_Account(_parcMemory_UsableSize(memory, result));
+    }
+    return result;
 }
 
 void *
 parcMemory_AllocateAndClear(const size_t size)
 {
-    return ((PARCMemoryAllocateAndClear *) parcMemory->AllocateAndClear)(size);
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    void *result = ((PARCMemoryAllocateAndClear *) memory->AllocateAndClear)(size);
+    if (_parcMemory_SoftLimit != 0) {
+        _parcMemory_Account(_parcMemory_UsableSize(memory, result));
+    }
+    return result;
 }
 
 int
 parcMemory_MemAlign(void **pointer, const size_t alignment, const size_t size)
 {
-    return ((PARCMemoryMemAlign *) parcMemory->MemAlign)(pointer, alignment, size);
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    int result = ((PARCMemoryMemAlign *) memory->MemAlign)(pointer, alignment, size);
+    if (_parcMemory_SoftLimit != 0 && result == 0) {
+        _parcMemory_Account(_parcMemory_UsableSize(memory, *pointer));
+    }
+    return result;
 }
 
 void
 parcMemory_DeallocateImpl(void **pointer)
 {
-    ((PARCMemoryDeallocate *) parcMemory->Deallocate)(pointer);
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    if (_parcMemory_SoftLimit != 0) {
+        _parcMemory_Account(-_parcMemory_UsableSize(memory, *pointer));
+    }
+    ((PARCMemoryDeallocate *) memory->Deallocate)(pointer);
+}
+
+void
+parcMemory_DeallocateSizedImpl(void **pointer, size_t size)
+{
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    if (_parcMemory_SoftLimit != 0) {
+        _parcMemory_Account(-_parcMemory_UsableSize(memory, *pointer));
+    }
+    if (memory->DeallocateSized != 0) {
+        ((PARCMemoryDeallocateSized *) memory->DeallocateSized)(pointer, size);
+    } else {
+        ((PARCMemoryDeallocate *) memory->Deallocate)(pointer);
+    }
+}
+
+size_t
+parcMemory_GoodSize(size_t size)
+{
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    if (memory->GoodSize != 0) {
+        return ((PARCMemoryGoodSize *) memory->GoodSize)(size);
+    }
+    return size;
+}
+
+size_t
+parcMemory_UsableSize(const void *pointer)
+{
+    return (size_t) _parcMemory_UsableSize(_parcMemory_Interface(), pointer);
+}
+
+bool
+parcMemory_ReallocateInPlace(void *pointer, size_t newSize)
+{
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    if (pointer == NULL || memory->ReallocateInPlace == 0) {
+        return false;
+    }
+    if (_parcMemory_SoftLimit != 0) {
+        int64_t oldSize = _parcMemory_UsableSize(memory, pointer);
+        bool result = ((PARCMemoryReallocateInPlace *) memory->ReallocateInPlace)(pointer, newSize);
+        if (result) {
+            _parcMemory_Account(_parcMemory_UsableSize(memory, pointer) - oldSize);
+        }
+        return result;
+    }
+    return ((PARCMemoryReallocateInPlace *) memory->ReallocateInPlace)(pointer, newSize);
 }
 
 void *
 parcMemory_Reallocate(void *pointer, size_t newSize)
 {
-    return ((PARCMemoryReallocate *) parcMemory->Reallocate)(pointer, newSize);
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    if (_parcMemory_SoftLimit != 0) {
+        int64_t oldSize = _parcMemory_UsableSize(memory, pointer);
+        void *result = ((PARCMemoryReallocate *) memory->Reallocate)(pointer, newSize);
+        if (result != NULL) {
+            _parcMemory_Account(_parcMemory_UsableSize(memory, result) - oldSize);
+        }
+        return result;
+    }
+    return ((PARCMemoryReallocate *) memory->Reallocate)(pointer, newSize);
 }
 
 char *
 parcMemory_StringDuplicate(const char *string, const size_t length)
 {
-    return ((PARCMemoryStringDuplicate *) parcMemory->StringDuplicate)(string, length);
+    const PARCMemoryInterface *memory = _parcMemory_Interface();
+    char *result = ((PARCMemoryStringDuplicate *) memory->StringDuplicate)(string, length);
+    if (_parcMemory_SoftLimit != 0) {
+        _parcMemory_Account(_parcMemory_UsableSize(memory, result));
+    }
+    return result;
 }
 
 uint32_t
 parcMemory_Outstanding(void)
 {
-    return ((PARCMemoryOutstanding *) parcMemory->Outstanding)();
+    return ((PARCMemoryOutstanding *) _parcMemory_Interface()->Outstanding)();
 }
 
 char *
@@ -147,11 +507,15 @@ parcMemory_Format(const char *format, ...)
 }
 
 PARCMemoryInterface PARCMemoryAsPARCMemory = {
-    .Allocate         = (uintptr_t) parcMemory_Allocate,
-    .AllocateAndClear = (uintptr_t) parcMemory_AllocateAndClear,
-    .MemAlign         = (uintptr_t) parcMemory_MemAlign,
-    .Deallocate       = (uintptr_t) parcMemory_DeallocateImpl,
-    .Reallocate       = (uintptr_t) parcMemory_Reallocate,
-    .StringDuplicate  = (uintptr_t) parcMemory_StringDuplicate,
-    .Outstanding      = (uintptr_t) parcMemory_Outstanding
+    .Allocate          = (uintptr_t) parcMemory_Allocate,
+    .AllocateAndClear  = (uintptr_t) parcMemory_AllocateAndClear,
+    .MemAlign          = (uintptr_t) parcMemory_MemAlign,
+    .Deallocate        = (uintptr_t) parcMemory_DeallocateImpl,
+    .Reallocate        = (uintptr_t) parcMemory_Reallocate,
+    .StringDuplicate   = (uintptr_t) parcMemory_StringDuplicate,
+    .Outstanding       = (uintptr_t) parcMemory_Outstanding,
+    .DeallocateSized   = (uintptr_t) parcMemory_DeallocateSizedImpl,
+    .GoodSize          = (uintptr_t) parcMemory_GoodSize,
+    .ReallocateInPlace = (uintptr_t) parcMemory_ReallocateInPlace,
+    .UsableSize        = (uintptr_t) parcMemory_UsableSize
 };
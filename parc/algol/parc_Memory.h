@@ -42,6 +42,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * @typedef PARCMemoryAllocate
@@ -62,6 +63,26 @@ typedef char *(PARCMemoryStringDuplicate)(const char *string, size_t length);
 
 typedef uint32_t (PARCMemoryOutstanding)(void);
 
+typedef void (PARCMemoryDeallocateSized)(void **pointer, size_t size);
+
+typedef size_t (PARCMemoryGoodSize)(size_t size);
+
+typedef bool (PARCMemoryReallocateInPlace)(void *pointer, size_t newSize);
+
+typedef size_t (PARCMemoryUsableSize)(const void *pointer);
+
+/**
+ * @typedef PARCMemoryPressureCallback
+ * @brief Function signature of a callback invoked when the memory in use crosses a threshold of the soft limit.
+ *
+ * @param [in] context The context given when the callback was added.
+ * @param [in] usage The number of bytes in use.
+ * @param [in] softLimit The soft limit in bytes.
+ *
+ * @see parcMemory_AddPressureCallback
+ */
+typedef void (PARCMemoryPressureCallback)(void *context, size_t usage, size_t softLimit);
+
 /**
  * @typedef PARCMemoryInterface
  * @brief A structure containing pointers to functions that implement a PARC Memory manager.
@@ -184,6 +205,66 @@ typedef struct parc_memory_interface {
      * @return The number of outstanding allocations known to this `PARCMemoryInterface`.
      */
     uintptr_t Outstanding;
+
+    /**
+     * Optional.
+     * Deallocate memory previously allocated with exactly @p size bytes,
+     * which spares the implementation from looking up the size of the allocation.
+     *
+     * If this is 0, `Deallocate` is used instead.
+     *
+     * @param [in,out] pointer A pointer to a `void *` pointer to the address of the allocated memory that will be set to zero.
+     * @param [in] size The number of bytes requested when the memory was allocated, or its latest reallocation.
+     *
+     * @see Deallocate
+     */
+    uintptr_t DeallocateSized;
+
+    /**
+     * Optional.
+     * Return the number of bytes, at least @p size, that the implementation would actually provide
+     * for an allocation of @p size bytes.
+     * Allocating this many bytes costs the same as allocating @p size bytes.
+     *
+     * If this is 0, the size is used as it is.
+     *
+     * @param [in] size The number of bytes to allocate.
+     *
+     * @return The number of bytes to allocate without waste.
+     */
+    uintptr_t GoodSize;
+
+    /**
+     * Optional.
+     * Try to change the size of the allocation pointed to by @p pointer to @p newSize without moving it.
+     *
+     * If this is 0, no allocation can be resized in place.
+     *
+     * @param [in] pointer A pointer to previously allocated memory.
+     * @param [in] newSize The size of the allocated memory.
+     *
+     * @return true The allocation now holds at least @p newSize bytes at the same address, with its content preserved.
+     * @return false The allocation is unchanged.
+     *
+     * @see Reallocate
+     */
+    uintptr_t ReallocateInPlace;
+
+    /**
+     * Optional.
+     * Return the number of bytes that the allocation pointed to by @p pointer occupies,
+     * which is at least the number of bytes requested.
+     * The result must not change until the allocation is deallocated or resized.
+     *
+     * If this is 0, the memory in use cannot be counted.
+     *
+     * @param [in] pointer A pointer to previously allocated memory.
+     *
+     * @return The number of bytes of the allocation.
+     *
+     * @see parcMemory_GetUsage
+     */
+    uintptr_t UsableSize;
 } PARCMemoryInterface;
 
 /**
@@ -213,6 +294,69 @@ extern PARCMemoryInterface PARCMemoryAsPARCMemory;
  */
 const PARCMemoryInterface *parcMemory_SetInterface(const PARCMemoryInterface *memoryProvider);
 
+/**
+ * Get the memory allocation interface that is used by threads that have not set their own.
+ *
+ * @return A pointer to the current process-wide `PARCMemoryInterface` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     const PARCMemoryInterface *provider = parcMemory_GetInterface();
+ * }
+ * @endcode
+ *
+ * @see parcMemory_SetInterface
+ * @see parcMemory_SetThreadInterface
+ */
+const PARCMemoryInterface *parcMemory_GetInterface(void);
+
+/**
+ * Set the memory allocation interface of the calling thread, overriding the process-wide interface.
+ *
+ * Memory must be deallocated through the interface that allocated it,
+ * so memory allocated while a thread interface is set must not outlive it,
+ * unless the thread interface forwards to the interface that will deallocate the memory.
+ *
+ * @param [in] memoryProvider A pointer to a {@link PARCMemoryInterface} instance, or NULL to use the process-wide interface.
+ *
+ * @return A pointer to the previous `PARCMemoryInterface` instance of the calling thread, or NULL if it had none.
+ *
+ * Example:
+ * @code
+ * {
+ *     const PARCMemoryInterface *previous = parcMemory_SetThreadInterface(&PARCSafeMemoryAsPARCMemory);
+ *     ...
+ *     parcMemory_SetThreadInterface(previous);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_SetInterface
+ * @see parcArenaMemory_Push
+ */
+const PARCMemoryInterface *parcMemory_SetThreadInterface(const PARCMemoryInterface *memoryProvider);
+
+/**
+ * Get the memory allocation interface set by the calling thread.
+ *
+ * Caches that keep memory beyond the life of the calling thread's interface, such as object pools,
+ * use this to leave alone the memory allocated while a thread interface, such as an arena, is set.
+ *
+ * @return A pointer to the `PARCMemoryInterface` instance of the calling thread, or NULL if it has none.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcMemory_GetThreadInterface() == NULL) {
+ *         // Memory allocated now comes from the process-wide interface.
+ *     }
+ * }
+ * @endcode
+ *
+ * @see parcMemory_SetThreadInterface
+ */
+const PARCMemoryInterface *parcMemory_GetThreadInterface(void);
+
 /**
  * Allocate memory.
  *
@@ -323,6 +467,83 @@ void parcMemory_DeallocateImpl(void **pointer);
 
 #define parcMemory_Deallocate(_pointer_) parcMemory_DeallocateImpl((void **) _pointer_)
 
+/**
+ * Deallocate memory that was allocated with exactly @p size bytes.
+ *
+ * Memory providers that know the size of an allocation at the time it is deallocated may skip looking it up.
+ * Providers that do not implement `DeallocateSized` behave as {@link parcMemory_Deallocate}.
+ *
+ * The size must be the number of bytes requested by the allocation, or its latest reallocation.
+ *
+ * @param [in,out] pointer A pointer to a `void *` pointer to the address of the allocated memory that will be set to zero.
+ * @param [in] size The number of bytes requested when the memory was allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *allocatedMemory = parcMemory_Allocate(100);
+ *
+ *     parcMemory_DeallocateSized(&allocatedMemory, 100);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_Deallocate
+ */
+void parcMemory_DeallocateSizedImpl(void **pointer, size_t size);
+
+#define parcMemory_DeallocateSized(_pointer_, _size_) parcMemory_DeallocateSizedImpl((void **) _pointer_, _size_)
+
+/**
+ * Return the number of bytes, at least @p size, that the memory provider would actually provide for an allocation of @p size bytes.
+ *
+ * Growable containers use this to round their capacity up to the real size of the allocation,
+ * so that the slack is used rather than wasted.
+ * Providers that do not implement `GoodSize` return @p size.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return The number of bytes to allocate without waste.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t capacity = parcMemory_GoodSize(100 * sizeof(void *)) / sizeof(void *);
+ *     void **array = parcMemory_Allocate(capacity * sizeof(void *));
+ * }
+ * @endcode
+ */
+size_t parcMemory_GoodSize(size_t size);
+
+/**
+ * Try to change the size of the allocation pointed to by @p pointer to @p newSize without moving it.
+ *
+ * Unlike {@link parcMemory_Reallocate}, this never copies the content.
+ * If it fails, the caller may choose to reallocate, or to continue with the allocation it has.
+ * Providers that do not implement `ReallocateInPlace` always fail.
+ *
+ * @param [in] pointer A pointer to previously allocated memory, or NULL.
+ * @param [in] newSize The size of the allocated memory.
+ *
+ * @return true The allocation now holds at least @p newSize bytes at the same address, with its content preserved.
+ * @return false The allocation is unchanged.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *allocatedMemory = parcMemory_Allocate(100);
+ *
+ *     if (parcMemory_ReallocateInPlace(allocatedMemory, 200) == false) {
+ *         allocatedMemory = parcMemory_Reallocate(allocatedMemory, 200);
+ *     }
+ *
+ *     parcMemory_Deallocate(&allocatedMemory);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_Reallocate
+ */
+bool parcMemory_ReallocateInPlace(void *pointer, size_t newSize);
+
 /**
  * Try to change the size of the allocation pointed to by @p pointer to @p newSize, and returns ptr.
  * If there is not enough room to enlarge the memory allocation pointed to by @p pointer,
@@ -363,6 +584,135 @@ void parcMemory_DeallocateImpl(void **pointer);
  */
 void *parcMemory_Reallocate(void *pointer, size_t newSize);
 
+/**
+ * Return the number of bytes that the allocation pointed to by @p pointer occupies.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ *
+ * @return The number of bytes of the allocation, at least the number requested.
+ * @return 0 The memory provider cannot tell.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcMemory_Allocate(100);
+ *     size_t size = parcMemory_UsableSize(memory);
+ *     parcMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+size_t parcMemory_UsableSize(const void *pointer);
+
+/**
+ * Set a soft limit on the number of bytes of memory allocated through parcMemory.
+ *
+ * While the soft limit is not 0, parcMemory counts the bytes allocated and deallocated through it,
+ * and invokes the pressure callbacks added with {@link parcMemory_AddPressureCallback}
+ * when the count crosses their thresholds.
+ * Nothing prevents allocating beyond the soft limit: it is for caches to shrink before the process runs out of memory.
+ *
+ * Each thread accumulates its own count and adds it to the shared count whenever it differs by
+ * `parcMemory_UsageGranularity` bytes, so the shared count lags by at most that much per thread.
+ *
+ * Only memory allocated while the limit is set is counted,
+ * so a limit should be set before the memory it limits is allocated.
+ * A memory provider that does not implement `UsableSize` is not counted.
+ *
+ * @param [in] bytes The soft limit in bytes, or 0 to stop counting.
+ *
+ * @return The previous soft limit.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcMemory_SetSoftLimit((size_t) 512 * 1024 * 1024);
+ * }
+ * @endcode
+ */
+size_t parcMemory_SetSoftLimit(size_t bytes);
+
+/**
+ * Get the soft limit set by {@link parcMemory_SetSoftLimit}.
+ *
+ * @return The soft limit in bytes, or 0 if there is none.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t limit = parcMemory_GetSoftLimit();
+ * }
+ * @endcode
+ */
+size_t parcMemory_GetSoftLimit(void);
+
+/**
+ * The number of bytes by which the count of a thread may differ before it is added to the shared count.
+ */
+#define parcMemory_UsageGranularity (64 * 1024)
+
+/**
+ * Get the number of bytes allocated through parcMemory and not yet deallocated, while a soft limit is set.
+ *
+ * The count of the calling thread is exact, and the count of each other thread lags by at most `parcMemory_UsageGranularity`.
+ *
+ * @return The number of bytes in use.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t usage = parcMemory_GetUsage();
+ * }
+ * @endcode
+ */
+size_t parcMemory_GetUsage(void);
+
+/**
+ * Add a callback that is invoked when the memory in use rises to @p percent of the soft limit.
+ *
+ * The callback is invoked once each time the usage rises to the threshold,
+ * and not again until the usage has fallen below it.
+ * It is invoked on the thread whose allocation crossed the threshold, without any lock held,
+ * so it may deallocate memory, for example by evicting the entries of a cache.
+ *
+ * @param [in] percent The threshold as a percentage of the soft limit, which may exceed 100.
+ * @param [in] callback The function to invoke.
+ * @param [in] context The first argument of the callback.
+ *
+ * Example:
+ * @code
+ * static void
+ * _evict(void *cache, size_t usage, size_t softLimit)
+ * {
+ *     myCache_EvictHalf(cache);
+ * }
+ *
+ * {
+ *     parcMemory_AddPressureCallback(90, _evict, cache);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_RemovePressureCallback
+ */
+void parcMemory_AddPressureCallback(unsigned int percent, PARCMemoryPressureCallback *callback, void *context);
+
+/**
+ * Remove every callback added with {@link parcMemory_AddPressureCallback} for @p callback and @p context.
+ *
+ * @param [in] callback The function given when the callback was added.
+ * @param [in] context The context given when the callback was added.
+ *
+ * @return true At least one callback was removed.
+ * @return false No such callback was found.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcMemory_RemovePressureCallback(_evict, cache);
+ * }
+ * @endcode
+ */
+bool parcMemory_RemovePressureCallback(PARCMemoryPressureCallback *callback, void *context);
+
 /**
  * Allocate sufficient memory for a copy of the string @p string,
  * copy at most n characters from the string @p string into the allocated memory,
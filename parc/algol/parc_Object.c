@@ -48,6 +48,9 @@
 
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_ObjectPool.h>
+#include <parc/algol/parc_ObjectReclaimer.h>
+#include <parc/algol/parc_ObjectStatistics.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Hash.h>
 #include <parc/concurrent/parc_AtomicUint64.h>
@@ -65,18 +68,18 @@ typedef struct parc_object_locking {
     bool notified;
 } _PARCObjectLocking;
 
+typedef enum {
+    _PARCObjectFlag_Frozen = 0x01,              // The object's hashcode may be remembered.
+    _PARCObjectFlag_HashCodeValid = _PARCObjectHeaderFlag_HashCodeValid  // The header's hashCode is the object's hashcode.
+} _PARCObjectFlag;
+
 /**
- * This is the per-object header.
+ * This is the per-object header, which is declared in parc_Object.h for `parcObject_DeclareImmortal`.
+ *
+ * The locking state is only needed by the few instances that are actually locked, waited, or notified upon,
+ * so the header holds a pointer to it which is allocated on the first use (see `_objectHeader_Locking`).
  */
-typedef struct object_header {
-    PARCReferenceCount references;
-    PARCObjectDescriptor *descriptor;
-    size_t objectLength;               // The number of bytes which is >= the length to store the object.
-
-    _PARCObjectLocking locking;
-
-    unsigned char objectAlignment;    // The required aligment.  Must be a power of 2 and >= sizeof(void *).
-} _PARCObjectHeader;
+typedef struct parc_object_header _PARCObjectHeader;
 
 /**
  * Return true if the given alignment value is greater than or equal to
@@ -127,6 +130,25 @@ _parcObject_PrefixLength(const size_t alignment)
     return (sizeof(_PARCObjectHeader) + (alignment - 1)) & - alignment;
 }
 
+/**
+ * Compute the number of bytes allocated for an object of the given length and alignment, including its header.
+ *
+ * An instance with more than the minimum alignment occupies whole alignment units,
+ * so that it shares no cache line with any other memory.
+ * The header records only the requested length, so the padding is never part of the object's value.
+ *
+ * @param [in] alignment Cache alignment
+ * @param [in] objectLength The length of the object as requested by the caller.
+ *
+ * @return The size of the memory holding the header and the object.
+ */
+static inline size_t
+_parcObject_AllocationLength(const size_t alignment, const size_t objectLength)
+{
+    size_t paddedLength = (alignment > sizeof(void *)) ? (objectLength + alignment - 1) & -alignment : objectLength;
+    return _parcObject_PrefixLength(alignment) + paddedLength;
+}
+
 /**
  * Given the memory address, return a pointer to the corresponding _PARCObjectHeader structure.
  *
@@ -146,10 +168,58 @@ _objectHeader_Descriptor(const PARCObject *object)
     return (_parcObject_Header(object)->descriptor);
 }
 
+static _PARCObjectLocking *
+_parcObjectLocking_Create(void)
+{
+    _PARCObjectLocking *result = calloc(1, sizeof(_PARCObjectLocking));
+    assertNotNull(result, "calloc(%zu) returned NULL", sizeof(_PARCObjectLocking));
+
+    pthread_mutexattr_init(&result->lockAttributes);
+    pthread_mutexattr_settype(&result->lockAttributes, PTHREAD_MUTEX_NORMAL);
+
+    pthread_mutex_init(&result->lock, &result->lockAttributes);
+
+    result->locker = (pthread_t) NULL;
+    pthread_cond_init(&result->notification, NULL);
+    result->notified = false;
+
+    return result;
+}
+
+static void
+_parcObjectLocking_Destroy(_PARCObjectLocking **lockingPtr)
+{
+    _PARCObjectLocking *locking = *lockingPtr;
+
+    pthread_cond_destroy(&locking->notification);
+    pthread_mutex_destroy(&locking->lock);
+    pthread_mutexattr_destroy(&locking->lockAttributes);
+
+    free(locking);
+    *lockingPtr = NULL;
+}
+
+/**
+ * Get the locking state of the given object, creating it if this is the first use.
+ *
+ * Concurrent first uses race to install their locking state and the losers discard their own.
+ */
 static inline _PARCObjectLocking *
 _objectHeader_Locking(const PARCObject *object)
 {
-    return &(_parcObject_Header(object)->locking);
+    _PARCObjectHeader *header = _parcObject_Header(object);
+
+    _PARCObjectLocking *result = header->locking;
+    if (result == NULL) {
+        _PARCObjectLocking *locking = _parcObjectLocking_Create();
+        if (__sync_bool_compare_and_swap(&header->locking, NULL, locking)) {
+            result = locking;
+        } else {
+            _parcObjectLocking_Destroy(&locking);
+            result = header->locking;
+        }
+    }
+    return result;
 }
 
 static inline bool
@@ -182,9 +252,63 @@ _parcObject_Origin(const void *object)
     return _pointerAdd(object, -_parcObject_PrefixLength(header->objectAlignment));
 }
 
+#define _parcObjectDescriptor_ResolveMethod(_vtable, _descriptor, _method) \
+    for (const PARCObjectDescriptor *d = _descriptor; d != NULL; d = d->super) { \
+        if (d->_method != NULL) { \
+            _vtable->_method = d->_method; \
+            break; \
+        } \
+    }
+
+/**
+ * Resolve the methods of the given descriptor, including those inherited from its supertypes,
+ * into the descriptor's vtable.
+ *
+ * Concurrent resolutions of the same descriptor store identical values,
+ * so the vtable is marked resolved only after all of its methods are stored.
+ *
+ * @return The resolved vtable, or NULL if the descriptor has no storage for one.
+ */
+static const _PARCObjectVTable *
+_parcObjectDescriptor_Resolve(const PARCObjectDescriptor *descriptor)
+{
+    _PARCObjectVTable *vtable = descriptor->vtable;
+
+    if (vtable != NULL) {
+        _parcObjectDescriptor_ResolveMethod(vtable, descriptor, copy);
+        _parcObjectDescriptor_ResolveMethod(vtable, descriptor, toString);
+        _parcObjectDescriptor_ResolveMethod(vtable, descriptor, equals);
+        _parcObjectDescriptor_ResolveMethod(vtable, descriptor, compare);
+        _parcObjectDescriptor_ResolveMethod(vtable, descriptor, hashCode);
+        _parcObjectDescriptor_ResolveMethod(vtable, descriptor, toJSON);
+        _parcObjectDescriptor_ResolveMethod(vtable, descriptor, display);
+
+        // Publish the methods: a reader that sees resolved (with acquire) also sees every method stored above.
+        __atomic_store_n(&vtable->resolved, true, __ATOMIC_RELEASE);
+    }
+
+    return vtable;
+}
+
+static inline const _PARCObjectVTable *
+_parcObjectDescriptor_VTable(const PARCObjectDescriptor *descriptor)
+{
+    const _PARCObjectVTable *vtable = descriptor->vtable;
+
+    if (vtable == NULL || !__atomic_load_n(&vtable->resolved, __ATOMIC_ACQUIRE)) {
+        vtable = _parcObjectDescriptor_Resolve(descriptor);
+    }
+    return vtable;
+}
+
 static inline PARCObjectEquals *
 _parcObject_ResolveEquals(const PARCObjectDescriptor *descriptor)
 {
+    const _PARCObjectVTable *vtable = _parcObjectDescriptor_VTable(descriptor);
+    if (vtable != NULL) {
+        return vtable->equals;
+    }
+
     while (descriptor->equals == NULL) {
         descriptor = descriptor->super;
     }
@@ -194,6 +318,11 @@ _parcObject_ResolveEquals(const PARCObjectDescriptor *descriptor)
 static inline PARCObjectCopy *
 _parcObject_ResolveCopy(const PARCObjectDescriptor *descriptor)
 {
+    const _PARCObjectVTable *vtable = _parcObjectDescriptor_VTable(descriptor);
+    if (vtable != NULL) {
+        return vtable->copy;
+    }
+
     while (descriptor->copy == NULL) {
         descriptor = descriptor->super;
     }
@@ -203,6 +332,11 @@ _parcObject_ResolveCopy(const PARCObjectDescriptor *descriptor)
 static inline PARCObjectToString *
 _parcObject_ResolveToString(const PARCObjectDescriptor *descriptor)
 {
+    const _PARCObjectVTable *vtable = _parcObjectDescriptor_VTable(descriptor);
+    if (vtable != NULL) {
+        return vtable->toString;
+    }
+
     while (descriptor->toString == NULL) {
         descriptor = descriptor->super;
     }
@@ -212,12 +346,59 @@ _parcObject_ResolveToString(const PARCObjectDescriptor *descriptor)
 static inline PARCObjectToJSON *
 _parcObject_ResolveToJSON(const PARCObjectDescriptor *descriptor)
 {
+    const _PARCObjectVTable *vtable = _parcObjectDescriptor_VTable(descriptor);
+    if (vtable != NULL) {
+        return vtable->toJSON;
+    }
+
     while (descriptor->toJSON == NULL) {
         descriptor = descriptor->super;
     }
     return descriptor->toJSON;
 }
 
+static inline PARCObjectCompare *
+_parcObject_ResolveCompare(const PARCObjectDescriptor *descriptor)
+{
+    const _PARCObjectVTable *vtable = _parcObjectDescriptor_VTable(descriptor);
+    if (vtable != NULL) {
+        return vtable->compare;
+    }
+
+    while (descriptor->compare == NULL) {
+        descriptor = descriptor->super;
+    }
+    return descriptor->compare;
+}
+
+static inline PARCObjectHashCode *
+_parcObject_ResolveHashCode(const PARCObjectDescriptor *descriptor)
+{
+    const _PARCObjectVTable *vtable = _parcObjectDescriptor_VTable(descriptor);
+    if (vtable != NULL) {
+        return vtable->hashCode;
+    }
+
+    while (descriptor->hashCode == NULL) {
+        descriptor = descriptor->super;
+    }
+    return descriptor->hashCode;
+}
+
+static inline PARCObjectDisplay *
+_parcObject_ResolveDisplay(const PARCObjectDescriptor *descriptor)
+{
+    const _PARCObjectVTable *vtable = _parcObjectDescriptor_VTable(descriptor);
+    if (vtable != NULL) {
+        return vtable->display;
+    }
+
+    while (descriptor->display == NULL) {
+        descriptor = descriptor->super;
+    }
+    return descriptor->display;
+}
+
 static bool
 _parcObjectType_Destructor(const PARCObjectDescriptor *descriptor, PARCObject **object)
 {
@@ -390,20 +571,13 @@ parcObject_Acquire(const PARCObject *object)
 
     _PARCObjectHeader *header = _parcObject_Header(object);
 
-    parcAtomicUint64_Increment(&header->references);
+    if (header->references != parcObject_ImmortalReferenceCount) {
+        parcAtomicUint64_Increment(&header->references);
+    }
 
     return (PARCObject *) object;
 }
 
-static inline PARCObjectCompare *
-_parcObject_ResolveCompare(const PARCObjectDescriptor *descriptor)
-{
-    while (descriptor->compare == NULL) {
-        descriptor = descriptor->super;
-    }
-    return descriptor->compare;
-}
-
 int
 parcObject_Compare(const PARCObject *x, const PARCObject *y)
 {
@@ -463,33 +637,43 @@ parcObject_Equals(const PARCObject *x, const PARCObject *y)
     return result;
 }
 
-static inline PARCObjectHashCode *
-_parcObject_ResolveHashCode(const PARCObjectDescriptor *descriptor)
-{
-    while (descriptor->hashCode == NULL) {
-        descriptor = descriptor->super;
-    }
-    return descriptor->hashCode;
-}
-
 PARCHashCode
 parcObject_HashCode(const PARCObject *object)
 {
     parcObject_OptionalAssertValid(object);
 
     _PARCObjectHeader *header = _parcObject_Header(object);
+
+    unsigned char flags = header->flags;
+    if (flags & _PARCObjectFlag_HashCodeValid) {
+        return header->hashCode;
+    }
+
     PARCObjectHashCode *hashCode = _parcObject_ResolveHashCode(header->descriptor);
+    PARCHashCode result = hashCode(object);
+
+    if (flags & _PARCObjectFlag_Frozen) {
+        header->hashCode = result;
+        __sync_fetch_and_or(&header->flags, _PARCObjectFlag_HashCodeValid);
+    }
 
-    return hashCode(object);
+    return result;
 }
 
-static inline PARCObjectDisplay *
-_parcObject_ResolveDisplay(const PARCObjectDescriptor *descriptor)
+void
+parcObject_Freeze(const PARCObject *object)
 {
-    while (descriptor->display == NULL) {
-        descriptor = descriptor->super;
-    }
-    return descriptor->display;
+    parcObject_OptionalAssertValid(object);
+
+    __sync_fetch_and_or(&_parcObject_Header(object)->flags, _PARCObjectFlag_Frozen);
+}
+
+bool
+parcObject_IsFrozen(const PARCObject *object)
+{
+    parcObject_OptionalAssertValid(object);
+
+    return (_parcObject_Header(object)->flags & _PARCObjectFlag_Frozen) != 0;
 }
 
 void
@@ -542,23 +726,59 @@ PARCObject *
 parcObject_CreateAndClearInstanceImpl(const size_t objectLength, const PARCObjectDescriptor *descriptor)
 {
     PARCObject *result = parcObject_CreateInstanceImpl(objectLength, descriptor);
-    memset(result, 0, objectLength);
+    if (result != NULL) {
+        memset(result, 0, objectLength);
+    }
     return result;
 }
 
+PARCObject *
+parcObject_CreateAndClearAlignedInstanceImpl(const size_t objectLength, const size_t alignment,
+                                             const PARCObjectDescriptor *descriptor)
+{
+    PARCObject *result = parcObject_CreateAlignedInstanceImpl(objectLength, alignment, descriptor);
+    if (result != NULL) {
+        memset(result, 0, objectLength);
+    }
+    return result;
+}
+
+/**
+ * The alignment of instances of the given descriptor.
+ */
+static inline size_t
+_parcObjectDescriptor_Alignment(const PARCObjectDescriptor *descriptor)
+{
+    return (descriptor == NULL || descriptor->alignment == 0) ? sizeof(void *) : descriptor->alignment;
+}
+
 PARCObject *
 parcObject_CreateInstanceImpl(const size_t objectLength, const PARCObjectDescriptor *descriptor)
 {
-    if (objectLength == 0) {
+    return parcObject_CreateAlignedInstanceImpl(objectLength, _parcObjectDescriptor_Alignment(descriptor), descriptor);
+}
+
+PARCObject *
+parcObject_CreateAlignedInstanceImpl(const size_t length, const size_t alignment, const PARCObjectDescriptor *descriptor)
+{
+    if (length == 0 || _alignmentIsValid(alignment) == false || alignment > parcObject_MaximumAlignment) {
         errno = EINVAL;
         return NULL;
     }
 
-    size_t prefixLength = _parcObject_PrefixLength(sizeof(void *));
-    size_t totalMemoryLength = prefixLength + objectLength;
+    size_t prefixLength = _parcObject_PrefixLength(alignment);
+    size_t totalMemoryLength = _parcObject_AllocationLength(alignment, length);
+
+    // Pooled memory was allocated with the alignment of the descriptor, so only instances with that alignment may use it.
+    bool pooled = descriptor != NULL && descriptor->pool != NULL && alignment == _parcObjectDescriptor_Alignment(descriptor);
 
     void *origin = NULL;
-    parcMemory_MemAlign(&origin, sizeof(void *), totalMemoryLength);
+    if (pooled) {
+        origin = parcObjectPool_Get(descriptor, totalMemoryLength);
+    }
+    if (origin == NULL) {
+        parcMemory_MemAlign(&origin, alignment, totalMemoryLength);
+    }
 
     if (origin == NULL) {
         errno = ENOMEM;
@@ -569,20 +789,14 @@ parcObject_CreateInstanceImpl(const size_t objectLength, const PARCObjectDescrip
     // of the aligned prefix region.
     _PARCObjectHeader *header = (_PARCObjectHeader *) &((char *) origin)[prefixLength - sizeof(_PARCObjectHeader)];
     header->references = 1;
-    header->objectLength = objectLength;
-    header->objectAlignment = sizeof(void *);
+    header->objectLength = length;
+    header->objectAlignment = (unsigned char) alignment;
     header->descriptor = (PARCObjectDescriptor *) descriptor;
+    header->locking = NULL;
+    header->flags = 0;
 
-    _PARCObjectLocking *locking = &header->locking;
-    if (locking != NULL) {
-        pthread_mutexattr_init(&locking->lockAttributes);
-        pthread_mutexattr_settype(&locking->lockAttributes, PTHREAD_MUTEX_NORMAL);
-
-        pthread_mutex_init(&locking->lock, &locking->lockAttributes);
-
-        locking->locker = (pthread_t) NULL;
-        pthread_cond_init(&locking->notification, NULL);
-        locking->notified = false;
+    if (descriptor != NULL && parcObjectStatistics_IsEnabled()) {
+        parcObjectStatistics_CountCreate(descriptor, totalMemoryLength);
     }
 
     errno = 0;
@@ -610,13 +824,30 @@ parcObject_Release(PARCObject **objectPointer)
 
     parcObject_OptionalAssertValid(object);
 
+    if (header->references == parcObject_ImmortalReferenceCount) {
+        *objectPointer = NULL;
+        return parcObject_ImmortalReferenceCount;
+    }
 
     PARCReferenceCount result = parcAtomicUint64_Decrement(&header->references);
 
     if (result == 0) {
+        // No other reference exists, so nothing can hold or be waiting on the lock.
+        if (header->locking != NULL) {
+            _parcObjectLocking_Destroy(&header->locking);
+        }
+
         if (_parcObjectType_Destructor(header->descriptor, objectPointer)) {
             void *origin = _parcObject_Origin(object);
-            parcMemory_Deallocate(&origin);
+            const PARCObjectDescriptor *descriptor = header->descriptor;
+            size_t length = _parcObject_AllocationLength(header->objectAlignment, header->objectLength);
+            if (descriptor != NULL && parcObjectStatistics_IsEnabled()) {
+                parcObjectStatistics_CountRelease(descriptor, length);
+            }
+            bool pooled = descriptor != NULL && descriptor->pool != NULL && header->objectAlignment == _parcObjectDescriptor_Alignment(descriptor);
+            if (!pooled || !parcObjectPool_Put(descriptor, origin, length)) {
+                parcMemory_DeallocateSized(&origin, length);
+            }
             assertNotNull(*objectPointer, "Class implementation unnecessarily clears the object pointer.");
         } else {
             assertNull(*objectPointer, "Class implementation must clear the object pointer.");
@@ -627,6 +858,52 @@ parcObject_Release(PARCObject **objectPointer)
     return result;
 }
 
+PARCObject *
+parcObject_Resurrect(PARCObject *object)
+{
+    _PARCObjectHeader *header = _parcObject_Header(object);
+
+    trapIllegalValueIf(header->references != 0, "PARCObject@%p still has %" PRIu64 " references", object, (uint64_t) header->references);
+
+    header->references = 1;
+    header->flags = 0;
+    return object;
+}
+
+PARCReferenceCount
+parcObject_ReleaseDeferred(PARCObject **objectPointer)
+{
+    PARCObject *object = *objectPointer;
+
+    _PARCObjectHeader *header = _parcObject_Header(object);
+
+    trapIllegalValueIf(header->references == 0, "PARCObject@%p references must be > 0", object);
+
+    parcObject_OptionalAssertValid(object);
+
+    PARCReferenceCount result;
+    while (true) {
+        PARCReferenceCount references = header->references;
+        if (references == parcObject_ImmortalReferenceCount) {
+            result = references;
+            break;
+        }
+        if (references == 1) {
+            // This is the last reference, so the reclaimer releases it.
+            parcObjectReclaimer_Retire(object, _parcObject_AllocationLength(header->objectAlignment, header->objectLength));
+            result = 0;
+            break;
+        }
+        if (parcAtomicUint64_CompareAndSwap(&header->references, references, references - 1)) {
+            result = references - 1;
+            break;
+        }
+    }
+
+    *objectPointer = NULL;
+    return result;
+}
+
 PARCReferenceCount
 parcObject_GetReferenceCount(const PARCObject *object)
 {
@@ -637,6 +914,35 @@ parcObject_GetReferenceCount(const PARCObject *object)
     return header->references;
 }
 
+PARCObject *
+parcObject_MakeImmortal(PARCObject *object)
+{
+    parcObject_OptionalAssertValid(object);
+
+    _PARCObjectHeader *header = _parcObject_Header(object);
+
+    header->references = parcObject_ImmortalReferenceCount;
+    __sync_synchronize();
+
+    return object;
+}
+
+bool
+parcObject_IsImmortal(const PARCObject *object)
+{
+    parcObject_OptionalAssertValid(object);
+
+    return _parcObject_Header(object)->references == parcObject_ImmortalReferenceCount;
+}
+
+const PARCObjectDescriptor *
+parcObject_GetDescriptor(const PARCObject *object)
+{
+    parcObject_OptionalAssertValid(object);
+
+    return _objectHeader_Descriptor(object);
+}
+
 PARCObjectDescriptor *
 parcObject_SetDescriptor(PARCObject *object, const PARCObjectDescriptor *descriptor)
 {
@@ -665,7 +971,8 @@ parcObjectDescriptor_Create(const char *name,
 {
     assertNotNull(super, "Supertype descriptor cannot be NULL.");
 
-    PARCObjectDescriptor *result = parcMemory_AllocateAndClear(sizeof(PARCObjectDescriptor));
+    // The storage for the resolved methods follows the descriptor in the same allocation.
+    PARCObjectDescriptor *result = parcMemory_AllocateAndClear(sizeof(PARCObjectDescriptor) + sizeof(_PARCObjectVTable));
     if (result != NULL) {
         strncpy(result->name, name, sizeof(result->name));
         result->destroy = NULL;
@@ -679,6 +986,9 @@ parcObjectDescriptor_Create(const char *name,
         result->toJSON = toJSON;
         result->display = display;
         result->super = super;
+        result->pool = NULL;
+        result->vtable = (_PARCObjectVTable *) &result[1];
+        result->alignment = 0;
     }
     return result;
 }
@@ -686,6 +996,7 @@ parcObjectDescriptor_Create(const char *name,
 void
 parcObjectDescriptor_Destroy(PARCObjectDescriptor **descriptorPointer)
 {
+    parcObjectStatistics_ForgetDescriptor(*descriptorPointer);
     parcMemory_Deallocate(descriptorPointer);
 }
 
@@ -696,9 +1007,11 @@ parcObject_Unlock(const PARCObject *object)
 
     bool result = false;
 
-    _PARCObjectLocking *locking = _objectHeader_Locking(object);
-    locking->locker = (pthread_t) NULL;
-    result = (pthread_mutex_unlock(&locking->lock) == 0);
+    _PARCObjectLocking *locking = _parcObject_Header(object)->locking;
+    if (locking != NULL) {
+        locking->locker = (pthread_t) NULL;
+        result = (pthread_mutex_unlock(&locking->lock) == 0);
+    }
 
     return result;
 }
@@ -746,8 +1059,8 @@ bool
 parcObject_IsLocked(const PARCObject *object)
 {
     parcObject_OptionalAssertValid(object);
-    _PARCObjectLocking *locking = _objectHeader_Locking(object);
-    return locking->locker != (pthread_t) NULL;
+    _PARCObjectLocking *locking = _parcObject_Header(object)->locking;
+    return locking != NULL && locking->locker != (pthread_t) NULL;
 }
 
 void
@@ -771,13 +1084,13 @@ parcObject_WaitUntil(const PARCObject *object, const struct timespec *time)
 {
     parcObject_OptionalAssertValid(object);
 
-    _PARCObjectHeader *header = _parcObject_Header(object);
+    _PARCObjectLocking *locking = _objectHeader_Locking(object);
 
-    trapUnexpectedStateIf(header->locking.locker == (pthread_t) NULL,
+    trapUnexpectedStateIf(locking->locker == (pthread_t) NULL,
                           "You must Lock the object %p before calling parcObject_Wait", (void *) object);
 
-    header->locking.notified = false;
-    pthread_cond_timedwait(&header->locking.notification, &header->locking.lock, time);
+    locking->notified = false;
+    pthread_cond_timedwait(&locking->notification, &locking->lock, time);
 }
 
 void
@@ -785,9 +1098,9 @@ parcObject_WaitFor(const PARCObject *object, const uint64_t nanoSeconds)
 {
     parcObject_OptionalAssertValid(object);
 
-    _PARCObjectHeader *header = _parcObject_Header(object);
+    _PARCObjectLocking *locking = _objectHeader_Locking(object);
 
-    trapUnexpectedStateIf(header->locking.locker == (pthread_t) NULL,
+    trapUnexpectedStateIf(locking->locker == (pthread_t) NULL,
                           "You must Lock the object %p before calling parcObject_Wait", (void *) object);
     struct timeval now;
     gettimeofday(&now, NULL);
@@ -801,7 +1114,7 @@ parcObject_WaitFor(const PARCObject *object, const uint64_t nanoSeconds)
     time.tv_sec += time.tv_nsec / 1000000000;
     time.tv_nsec = time.tv_nsec % 1000000000;
 
-    pthread_cond_timedwait(&header->locking.notification, &header->locking.lock, &time);
+    pthread_cond_timedwait(&locking->notification, &locking->lock, &time);
 }
 
 void
@@ -809,11 +1122,11 @@ parcObject_Notify(const PARCObject *object)
 {
     parcObject_OptionalAssertValid(object);
 
-    _PARCObjectHeader *header = _parcObject_Header(object);
+    _PARCObjectLocking *locking = _objectHeader_Locking(object);
 
-    trapUnexpectedStateIf(header->locking.locker == (pthread_t) NULL,
+    trapUnexpectedStateIf(locking->locker == (pthread_t) NULL,
                           "You must Lock the object %p before calling parcObject_Notify", (void *) object);
 
-    header->locking.notified = true;
-    pthread_cond_signal(&header->locking.notification);
+    locking->notified = true;
+    pthread_cond_signal(&locking->notification);
 }
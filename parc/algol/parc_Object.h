@@ -52,6 +52,7 @@
 #ifndef libparc_parc_Object_h
 #define libparc_parc_Object_h
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <time.h>
 
@@ -133,6 +134,24 @@ typedef void (PARCObjectDisplay)(const PARCObject *object, const int indentation
  */
 typedef PARCJSON *(PARCObjectToJSON)(const PARCObject *);
 
+struct parc_object_pool;
+
+/**
+ * The methods of a `PARCObjectDescriptor`, including those it inherits from its supertypes,
+ * resolved once so that dispatching a method does not search the chain of supertypes.
+ * It is private to the implementation of `PARCObject`.
+ */
+typedef struct parc_object_vtable {
+    bool resolved;
+    PARCObjectCopy *copy;
+    PARCObjectToString *toString;
+    PARCObjectEquals *equals;
+    PARCObjectCompare *compare;
+    PARCObjectHashCode *hashCode;
+    PARCObjectToJSON *toJSON;
+    PARCObjectDisplay *display;
+} _PARCObjectVTable;
+
 typedef struct PARCObjectDescriptor {
     char name[32];
     PARCObjectDestroy *destroy;
@@ -146,6 +165,9 @@ typedef struct PARCObjectDescriptor {
     PARCObjectToJSON *toJSON;
     PARCObjectDisplay *display;
     struct PARCObjectDescriptor *super;
+    struct parc_object_pool **pool;     // If non-NULL, instances recycle their memory (see parc_ObjectPool.h)
+    _PARCObjectVTable *vtable;          // If non-NULL, the storage for the resolved methods of this descriptor.
+    size_t alignment;                   // If non-zero, the alignment of instances (see parcObject_CreateAlignedInstance)
 } PARCObjectDescriptor;
 
 /*!
@@ -158,6 +180,39 @@ typedef struct PARCObjectDescriptor {
 
 extern PARCObjectDescriptor parcObject_DescriptorName(PARCObject);
 
+/**
+ * The reference count of an immortal object.
+ *
+ * `parcObject_Acquire` and `parcObject_Release` do not change the reference count of an immortal object,
+ * and it is never finalized or deallocated.
+ *
+ * @see parcObject_MakeImmortal
+ * @see parcObject_DeclareImmortal
+ */
+#define parcObject_ImmortalReferenceCount UINT64_MAX
+
+/**
+ * The header that precedes every PARCObject in memory.
+ *
+ * It is declared here only so that `parcObject_DeclareImmortal` can initialize instances statically.
+ * It is not part of the API; use the parcObject functions to access it.
+ */
+struct parc_object_header {
+    PARCReferenceCount references;
+    PARCObjectDescriptor *descriptor;
+    size_t objectLength;                    // The number of bytes which is >= the length to store the object.
+
+    struct parc_object_locking *locking;    // NULL until the object is first locked, waited upon, or notified.
+
+    PARCHashCode hashCode;                  // The remembered hashcode of a frozen object.
+
+    unsigned char objectAlignment;          // The required aligment.  Must be a power of 2 and >= sizeof(void *).
+    unsigned char flags;                    // A set of flags private to the PARCObject implementation.
+};
+
+// The flag of `struct parc_object_header` that marks its hashCode as remembered, tested by `parcObject_InvalidateHashCode`.
+#define _PARCObjectHeaderFlag_HashCodeValid 0x02
+
 /**
  * Assert that an instance of PARC Object is valid.
  *
@@ -288,6 +343,9 @@ bool parcObject_Equals(const PARCObject *x, const PARCObject *y);
  * of the base object pointer. Otherwise, the hashcode is computed by the
  * provided hashcode function.
  *
+ * The hashcode of a frozen object is computed once and remembered until it is invalidated
+ * (see `parcObject_Freeze` and `parcObject_InvalidateHashCode`).
+ *
  * @param [in] object An object.
  *
  * @return uint32_t The object hashcode
@@ -306,6 +364,90 @@ bool parcObject_Equals(const PARCObject *x, const PARCObject *y);
  */
 PARCHashCode parcObject_HashCode(const PARCObject *object);
 
+/**
+ * Mark the given object as frozen, so that its hashcode is computed once and remembered.
+ *
+ * Freezing an object is a promise that the contents its hashcode depends upon will change only through
+ * functions of the object's own type that call `parcObject_InvalidateHashCode`.
+ * This is useful for objects, such as names and keys, whose hashcode is computed many times and is costly to compute.
+ * An object cannot be unfrozen.
+ *
+ * @param [in] object A pointer to a valid PARCObject instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *key = parcBuffer_WrapCString("a/long/name");
+ *     parcObject_Freeze(key);
+ *
+ *     parcHashMap_Put(map, key, value);   // Computes the hashcode of key.
+ *     parcHashMap_Get(map, key);          // Uses the remembered hashcode.
+ *
+ *     parcBuffer_Release(&key);
+ * }
+ * @endcode
+ *
+ * @see parcObject_IsFrozen
+ * @see parcObject_InvalidateHashCode
+ */
+void parcObject_Freeze(const PARCObject *object);
+
+/**
+ * Determine if the given object is frozen.
+ *
+ * @param [in] object A pointer to a valid PARCObject instance.
+ *
+ * @return true The object is frozen.
+ * @return false The object is not frozen.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *key = parcBuffer_WrapCString("a/long/name");
+ *     parcObject_Freeze(key);
+ *
+ *     bool frozen = parcObject_IsFrozen(key);
+ *
+ *     parcBuffer_Release(&key);
+ * }
+ * @endcode
+ *
+ * @see parcObject_Freeze
+ */
+bool parcObject_IsFrozen(const PARCObject *object);
+
+/**
+ * Discard the remembered hashcode of the given object, if any.
+ *
+ * The functions of a type that modify the contents an instance's hashcode depends upon call this,
+ * so that the next call to `parcObject_HashCode` computes the hashcode again.
+ * It is inline, and only an object with a remembered hashcode pays for more than a test of its header.
+ *
+ * @param [in] object A pointer to a valid PARCObject instance.
+ *
+ * Example:
+ * @code
+ * PARCBuffer *
+ * parcBuffer_SetPosition(PARCBuffer *buffer, size_t newPosition)
+ * {
+ *     buffer->position = newPosition;
+ *     parcObject_InvalidateHashCode(buffer);
+ *     return buffer;
+ * }
+ * @endcode
+ *
+ * @see parcObject_Freeze
+ */
+static inline void
+parcObject_InvalidateHashCode(const PARCObject *object)
+{
+    struct parc_object_header *header = (struct parc_object_header *) ((const char *) object - sizeof(struct parc_object_header));
+
+    if (header->flags & _PARCObjectHeaderFlag_HashCodeValid) {
+        __sync_fetch_and_and(&header->flags, (unsigned char) ~_PARCObjectHeaderFlag_HashCodeValid);
+    }
+}
+
 /**
  * Create a C string containing a human readable representation of the given object.
  *
@@ -355,7 +497,7 @@ PARCJSON *parcObject_ToJSON(const PARCObject *object);
 /**
  * Acquire a new reference to an object.
  *
- * The reference count to the object is incremented.
+ * The reference count to the object is incremented, unless the object is immortal.
  *
  * @param [in] object The object to which to refer.
  *
@@ -389,6 +531,9 @@ PARCObject *parcObject_Acquire(const PARCObject *object);
  * The contents of the dealloced memory used for the PARC object are undefined.
  * Do not reference the object after the last release.
  *
+ * Releasing a reference to an immortal object does nothing other than set the pointer to NULL,
+ * and returns `parcObject_ImmortalReferenceCount`.
+ *
  * @param [in] objectPointer A pointer to a pointer to the instance to release.
  *
  * @return The number of remaining references to the object.
@@ -407,6 +552,68 @@ PARCObject *parcObject_Acquire(const PARCObject *object);
  */
 PARCReferenceCount parcObject_Release(PARCObject **objectPointer);
 
+/**
+ * Restore the single reference of an instance whose last reference has been released,
+ * from within the `PARCObjectDestructor` of its descriptor.
+ *
+ * A destructor that keeps the instance for reuse, rather than letting it be deallocated,
+ * calls this function before it uses the instance again, and then returns `false`.
+ * The instance is restored as if it had just been created: it has one reference and is not frozen.
+ *
+ * @param [in] object A pointer to an instance with no references.
+ *
+ * @return The same pointer as @p object.
+ *
+ * @throws LongBowTrapIllegalValue If the instance still has references.
+ *
+ * Example:
+ * @code
+ * static bool
+ * _myType_Destructor(MyType **instancePtr)
+ * {
+ *     MyType *instance = parcObject_Resurrect(*instancePtr);
+ *     _myCache_Put(instance);
+ *     *instancePtr = NULL;
+ *     return false;
+ * }
+ * @endcode
+ *
+ * @see PARCObjectDestructor
+ */
+PARCObject *parcObject_Resurrect(PARCObject *object);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * deferring the finalization of the instance if this is the last reference.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If this is not the last reference, this is equivalent to `parcObject_Release`.
+ * Otherwise the last reference is retired to the reclaimer (see parc_ObjectReclaimer.h),
+ * and the instance is finalized and deallocated later by `parcObjectReclaimer_Reclaim`,
+ * on the thread that calls it or on the reclaimer's background thread.
+ * The calling thread never runs the instance's finalizer.
+ *
+ * @param [in] objectPointer A pointer to a pointer to the instance to release.
+ *
+ * @return The number of remaining references to the object, which is 0 if the last reference was retired.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashMap *map = parcHashMap_Create();
+ *     ...
+ *     parcObject_ReleaseDeferred((PARCObject **) &map);
+ *     ...
+ *     parcObjectReclaimer_Reclaim();
+ * }
+ * @endcode
+ *
+ * @see parcObject_Release
+ * @see parcObjectReclaimer_Reclaim
+ */
+PARCReferenceCount parcObject_ReleaseDeferred(PARCObject **objectPointer);
+
 /**
  * Get the current `PARCReferenceCount` for the specified object.
  *
@@ -432,6 +639,57 @@ PARCReferenceCount parcObject_Release(PARCObject **objectPointer);
  */
 PARCReferenceCount parcObject_GetReferenceCount(const PARCObject *object);
 
+/**
+ * Make the given object immortal.
+ *
+ * Subsequent calls to `parcObject_Acquire` and `parcObject_Release` for the object
+ * do not modify its reference count, so that threads sharing it do not contend for it.
+ * The object is never finalized or deallocated,
+ * and its memory remains outstanding until the process exits.
+ *
+ * Make an object immortal before it is shared with other threads.
+ *
+ * @param [in] object A pointer to a valid PARCObject instance.
+ *
+ * @return The same value as the input parameter @p object
+ *
+ * Example:
+ * @code
+ * static PARCBuffer *_emptyName;
+ *
+ * static void
+ * _initialize(void)
+ * {
+ *     _emptyName = parcObject_MakeImmortal(parcBuffer_Allocate(0));
+ * }
+ * @endcode
+ *
+ * @see parcObject_IsImmortal
+ * @see parcObject_DeclareImmortal
+ */
+PARCObject *parcObject_MakeImmortal(PARCObject *object);
+
+/**
+ * Determine if the given object is immortal.
+ *
+ * @param [in] object A pointer to a valid PARCObject instance.
+ *
+ * @return true The object is immortal.
+ * @return false The object is reference counted.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcObject_MakeImmortal(parcBuffer_Allocate(0));
+ *
+ *     bool immortal = parcObject_IsImmortal(buffer);
+ * }
+ * @endcode
+ *
+ * @see parcObject_MakeImmortal
+ */
+bool parcObject_IsImmortal(const PARCObject *object);
+
 /**
  * Print a human readable representation of the given `PARC Object.
  *
@@ -452,6 +710,26 @@ PARCReferenceCount parcObject_GetReferenceCount(const PARCObject *object);
  */
 void parcObject_Display(const PARCObject *object, const int indentation);
 
+/**
+ * Get the `PARCObjectDescriptor` of the given `PARCObject`.
+ *
+ * @param [in] object A pointer to a valid PARCObject instance
+ *
+ * @return A pointer to the PARCObjectDescriptor of the given PARCObject.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcBuffer_Allocate(10);
+ *
+ *     const PARCObjectDescriptor *descriptor = parcObject_GetDescriptor(buffer);
+ *
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+const PARCObjectDescriptor *parcObject_GetDescriptor(const PARCObject *object);
+
 /**
  * <#One Line Description#>
  *
@@ -485,11 +763,17 @@ PARCObjectDescriptor *parcObject_SetDescriptor(PARCObject *object, const PARCObj
     (objectType)->hashCode = NULL, \
     (objectType)->toJSON = NULL, \
     (objectType)->display = NULL, \
-    (objectType)->super = NULL
+    (objectType)->super = NULL, \
+    (objectType)->pool = NULL, \
+    (objectType)->vtable = NULL, \
+    (objectType)->alignment = 0
 
 /**
  * Create an allocated instance of `PARCObjectDescriptor`.
  *
+ * The methods of the descriptor, including those it inherits, are resolved when it is first used to dispatch a method.
+ * Neither the descriptor nor its supertypes may be modified after that.
+ *
  * @param [in] name    A nul-terminated, C string containing the name of the object descriptor.
  * @param [in] destructor The callback function to call when the last `parcObject_Release()` is invoked (replaces @p destroy).
  * @param [in] release The callback function to call when `parcObject_Release()` is invoked.
@@ -625,6 +909,7 @@ void parcObjectDescriptor_Destroy(PARCObjectDescriptor **descriptorPointer);
 /** \endcond */
 
 #define parcObject_Override(_subtype, _superType, ...) \
+    static _PARCObjectVTable parcCMacro_Cat(_subtype, _VTable); \
     LongBowCompiler_IgnoreInitializerOverrides \
     static const PARCObjectDescriptor parcObject_DescriptorName(_subtype) = {          \
         .destroy = NULL,    \
@@ -637,7 +922,10 @@ void parcObjectDescriptor_Destroy(PARCObjectDescriptor **descriptorPointer);
         .hashCode = NULL,   \
         .toJSON   = NULL,   \
         .display  = NULL,   \
-        .super = &parcObject_DescriptorName(_superType),    \
+        .pool     = NULL,   \
+        .alignment = 0,     \
+        .vtable   = &parcCMacro_Cat(_subtype, _VTable), \
+        .super = (PARCObjectDescriptor *) &parcObject_DescriptorName(_superType), \
         .name = #_subtype,     \
         __VA_ARGS__         \
     }; \
@@ -683,6 +971,115 @@ void parcObjectDescriptor_Destroy(PARCObjectDescriptor **descriptorPointer);
         .toJSON   = parcCMacro_IfElse(NULL, _autowrap_toJSON_##_type, _autowrap_##_toJSON()), \
         .display  = NULL)
 
+/**
+ * @define parcObject_DeclareImmortal
+ *
+ * Statically declare an immortal instance of a subtype, named @p _name, in read-only data.
+ *
+ * The subtype must be completely defined and its descriptor declared (e.g. via `parcObject_ExtendPARCObject`)
+ * before this macro is used. The remaining parameters are the initializer of the instance.
+ *
+ * Because the instance is in read-only memory, it must not be modified,
+ * nor may it be frozen, locked, waited upon, or notified.
+ * The alignment of the subtype must not be greater than 16 bytes.
+ *
+ * Example:
+ * @code
+ * typedef struct {
+ *     const char *name;
+ *     size_t length;
+ * } WellKnownName;
+ *
+ * parcObject_ExtendPARCObject(WellKnownName, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+ *
+ * parcObject_DeclareImmortal(WellKnownName, _rootName, { .name = "/", .length = 1 });
+ *
+ * WellKnownName *
+ * wellKnownName_Root(void)
+ * {
+ *     return parcObject_Acquire(_rootName); // Does not modify the instance.
+ * }
+ * @endcode
+ *
+ * @see parcObject_MakeImmortal
+ */
+#define parcObject_DeclareImmortal(_type, _name, ...) \
+    static const struct { \
+        struct parc_object_header header; \
+        _type object; \
+    } parcCMacro_Cat(_name, _Immortal) = { \
+        .header = { \
+            .references = parcObject_ImmortalReferenceCount, \
+            .descriptor = (PARCObjectDescriptor *) &parcObject_DescriptorName(_type), \
+            .objectLength = sizeof(_type), \
+            .locking = NULL, \
+            .hashCode = 0, \
+            .objectAlignment = sizeof(void *), \
+            .flags = 0 \
+        }, \
+        .object = __VA_ARGS__ \
+    }; \
+    static _type *const _name = (_type *) &parcCMacro_Cat(_name, _Immortal).object
+
+/**
+ * @define parcObject_PoolName
+ *
+ * Creates a subtype specific name for the storage of a subtype's `PARCObjectPool`.
+ */
+#define parcObject_PoolName(_type) parcCMacro_Cat(_type, _Pool)
+
+/**
+ * @define parcObject_DeclarePool
+ *
+ * Declare the storage for the `PARCObjectPool` of a subtype that is described with `parcObject_Override`.
+ * The subtype's descriptor then names it with `.pool = &parcObject_PoolName(_type)`.
+ *
+ * Example:
+ * @code
+ * parcObject_DeclarePool(PARCBuffer);
+ *
+ * parcObject_Override(PARCBuffer, PARCObject,
+ *                     .destructor = (PARCObjectDestructor *) _parcBuffer_Destructor,
+ *                     .pool = &parcObject_PoolName(PARCBuffer));
+ * @endcode
+ *
+ * @see parc_ObjectPool.h
+ */
+#define parcObject_DeclarePool(_type) \
+    static struct parc_object_pool *parcObject_PoolName(_type) = NULL
+
+/**
+ * @define parcObject_ExtendPARCObjectPooled
+ *
+ * @discussion parcObject_ExtendPARCObjectPooled is equivalent to `parcObject_ExtendPARCObject`,
+ * and additionally declares a pool in which the memory of released instances is kept for reuse
+ * by subsequently created instances of the same type.
+ *
+ * @see parcObject_ExtendPARCObject
+ * @see parc_ObjectPool.h
+ */
+#define parcObject_ExtendPARCObjectPooled(_type, _destroy, _copy, _toString, _equals, _compare, _hashCode, _toJSON) \
+    parcObject_DeclarePool(_type); \
+    parcCMacro_IfElse(, parcObject_DestroyWrapper(_type, _destroy), _autowrap_##_destroy()) \
+    parcCMacro_IfElse(, parcObject_CopyWrapper(_type, _copy), _autowrap_##_copy()) \
+    parcCMacro_IfElse(, parcObject_ToStringWrapper(_type, _toString), _autowrap_##_toString()) \
+    parcCMacro_IfElse(, parcObject_EqualsWrapper(_type, _equals), _autowrap_##_equals()) \
+    parcCMacro_IfElse(, parcObject_CompareWrapper(_type, _compare), _autowrap_##_compare()) \
+    parcCMacro_IfElse(, parcObject_HashCodeWrapper(_type, _hashCode), _autowrap_##_hashCode()) \
+    parcCMacro_IfElse(, parcObject_ToJSONWrapper(_type, _toJSON), _autowrap_##_toJSON()) \
+    parcObject_Override(_type, PARCObject, \
+        .destroy = parcCMacro_IfElse(NULL, _autowrap_destroy_##_type, _autowrap_##_destroy()), \
+        .destructor = NULL, \
+        .release  = NULL,                                               \
+        .copy     = parcCMacro_IfElse(NULL, _autowrap_copy_##_type, _autowrap_##_copy()), \
+        .toString = parcCMacro_IfElse(NULL, _autowrap_toString_##_type, _autowrap_##_toString()), \
+        .equals   = parcCMacro_IfElse(NULL, _autowrap_equals_##_type, _autowrap_##_equals()), \
+        .compare  = parcCMacro_IfElse(NULL, _autowrap_compare_##_type, _autowrap_##_compare()), \
+        .hashCode = parcCMacro_IfElse(NULL, _autowrap_hashCode_##_type, _autowrap_##_hashCode()), \
+        .toJSON   = parcCMacro_IfElse(NULL, _autowrap_toJSON_##_type, _autowrap_##_toJSON()), \
+        .display  = NULL, \
+        .pool     = &parcObject_PoolName(_type))
+
 #define parcObject_Create(_subtype) \
     (_subtype *) parcObject_CreateImpl(sizeof(_subtype))
 
@@ -729,6 +1126,83 @@ PARCObject *parcObject_CreateAndClearImpl(const size_t objectLength);
 
 PARCObject *parcObject_CreateInstanceImpl(const size_t objectLength, const PARCObjectDescriptor *descriptor);
 
+/**
+ * The largest alignment that may be requested for an instance.
+ */
+#define parcObject_MaximumAlignment 128
+
+/**
+ * @define parcObject_CreateAlignedInstance
+ *
+ * `parcObject_CreateAlignedInstance` is a helper C-macro that creates an instance of a PARCObject subtype
+ * aligned on a boundary of @p _alignment bytes, using `parcObject_CreateAlignedInstanceImpl`.
+ *
+ * @param [in] _subtype A subtype's type string (e.g. PARCBuffer)
+ * @param [in] _alignment A power of 2 greater than or equal to `sizeof(void *)` and at most `parcObject_MaximumAlignment`.
+ */
+#define parcObject_CreateAlignedInstance(_subtype, _alignment) \
+    parcObject_CreateAlignedInstanceImpl(sizeof(_subtype), _alignment, &parcObject_DescriptorName(_subtype))
+
+/**
+ * @define parcObject_CreateAndClearAlignedInstance
+ *
+ * `parcObject_CreateAndClearAlignedInstance` is equivalent to `parcObject_CreateAlignedInstance`,
+ * and fills the instance with zero bytes.
+ *
+ * @param [in] _subtype A subtype's type string (e.g. PARCBuffer)
+ * @param [in] _alignment A power of 2 greater than or equal to `sizeof(void *)` and at most `parcObject_MaximumAlignment`.
+ */
+#define parcObject_CreateAndClearAlignedInstance(_subtype, _alignment) \
+    (_subtype *) parcObject_CreateAndClearAlignedInstanceImpl(sizeof(_subtype), _alignment, &parcObject_DescriptorName(_subtype))
+
+/**
+ * Create a reference counted segment of memory of at least @p objectLength long,
+ * aligned on a boundary of @p alignment bytes.
+ *
+ * When @p alignment is greater than `sizeof(void *)`, the length of the instance is also rounded up to a multiple of @p alignment,
+ * so that an instance aligned on a cache line boundary shares no cache line with any other memory.
+ *
+ * The instances of a descriptor with a non-zero `alignment` are created with that alignment by `parcObject_CreateInstanceImpl`.
+ *
+ * If @p alignment is not valid, `errno` is set to EINVAL.
+ * If memory cannot be allocated, `errno` is set to ENOMEM.
+ *
+ * @param [in] objectLength The length, in bytes, of the memory to allocate.
+ * @param [in] alignment A power of 2 greater than or equal to `sizeof(void *)` and at most `parcObject_MaximumAlignment`.
+ * @param [in] descriptor Either NULL, or a pointer to a `PARCObjectDescriptor` structure.
+ *
+ * @return NULL The memory could not be allocated.
+ * @return non-NULL A pointer to reference counted memory of at least length bytes.
+ *
+ * Example:
+ * @code
+ * {
+ *     PerThreadStatistics *statistics = parcObject_CreateAlignedInstanceImpl(sizeof(PerThreadStatistics), 64,
+ *                                                                           &PerThreadStatistics_Descriptor);
+ * }
+ * @endcode
+ *
+ * @see parcObject_CreateAlignedInstance
+ */
+PARCObject *parcObject_CreateAlignedInstanceImpl(const size_t objectLength, const size_t alignment,
+                                                 const PARCObjectDescriptor *descriptor);
+
+/**
+ * Create a reference counted segment of memory of at least @p objectLength long,
+ * aligned on a boundary of @p alignment bytes and filled with zero bytes.
+ *
+ * @param [in] objectLength The length, in bytes, of the memory to allocate.
+ * @param [in] alignment A power of 2 greater than or equal to `sizeof(void *)` and at most `parcObject_MaximumAlignment`.
+ * @param [in] descriptor Either NULL, or a pointer to a `PARCObjectDescriptor` structure.
+ *
+ * @return NULL The memory could not be allocated.
+ * @return non-NULL A pointer to reference counted memory of at least length bytes.
+ *
+ * @see parcObject_CreateAlignedInstanceImpl
+ */
+PARCObject *parcObject_CreateAndClearAlignedInstanceImpl(const size_t objectLength, const size_t alignment,
+                                                         const PARCObjectDescriptor *descriptor);
+
 /**
  * @define parcObject_CreateAndClearInstance
  *
@@ -835,6 +1309,9 @@ PARCObject *parcObject_CreateAndClearInstanceImpl(const size_t objectLength, con
  *
  * Implementors must avoid deadlock by attempting to lock the object a second time within the same calling thread.
  *
+ * The state necessary for locking is allocated when an object is first locked, waited upon, or notified,
+ * and is deallocated with the object.
+ *
  * @param [in] object A pointer to a valid `PARCObject` instance.
  *
  * @return true The lock was obtained successfully.
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <parc/algol/parc_ObjectPool.h>
+#include <parc/algol/parc_Memory.h>
+
+typedef struct parc_object_pool_magazine {
+    struct parc_object_pool_magazine *next;
+    size_t count;
+    void *blocks[PARCObjectPool_MagazineCapacity];
+} _PARCObjectPoolMagazine;
+
+struct parc_object_pool {
+    const PARCObjectDescriptor *descriptor;
+    unsigned int index;
+    size_t blockLength;                 // Only allocations of exactly this length are recycled.
+
+    pthread_mutex_t lock;               // Guards the depot and the retired statistics.
+    _PARCObjectPoolMagazine *full;      // The depot of magazines containing blocks.
+    size_t fullCount;
+    _PARCObjectPoolMagazine *empty;     // The depot of empty magazines.
+
+    PARCObjectPoolStatistics retired;   // The statistics of threads that have exited or flushed.
+};
+
+/**
+ * The per-thread state: a magazine and statistics for each pool.
+ */
+typedef struct parc_object_pool_thread {
+    struct parc_object_pool_thread *next;
+    _PARCObjectPoolMagazine *magazine[PARCObjectPool_MaxPools];
+    PARCObjectPoolStatistics statistics[PARCObjectPool_MaxPools];
+} _PARCObjectPoolThread;
+
+static bool _parcObjectPool_Enabled = false;
+
+static struct parc_object_pool _parcObjectPool_Pools[PARCObjectPool_MaxPools];
+static unsigned int _parcObjectPool_PoolCount = 0;
+
+static pthread_mutex_t _parcObjectPool_Registry = PTHREAD_MUTEX_INITIALIZER;  // Guards pool creation and the threads list.
+static _PARCObjectPoolThread *_parcObjectPool_Threads = NULL;
+
+static pthread_once_t _parcObjectPool_Once = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcObjectPool_ThreadKey;
+
+static inline void
+_statistics_Add(PARCObjectPoolStatistics *sum, const PARCObjectPoolStatistics *statistics)
+{
+    sum->hits += statistics->hits;
+    sum->misses += statistics->misses;
+    sum->recycled += statistics->recycled;
+    sum->returned += statistics->returned;
+}
+
+static void
+_magazine_Destroy(_PARCObjectPoolMagazine **magazinePtr)
+{
+    _PARCObjectPoolMagazine *magazine = *magazinePtr;
+    for (size_t i = 0; i < magazine->count; i++) {
+        parcMemory_Deallocate(&magazine->blocks[i]);
+    }
+    free(magazine);
+    *magazinePtr = NULL;
+}
+
+/**
+ * Give a thread's magazine to the depot of the given pool.
+ * If the depot is full, or pooling is disabled, the magazine and its blocks are deallocated.
+ */
+static void
+_pool_Retire(PARCObjectPool *pool, _PARCObjectPoolMagazine *magazine, const PARCObjectPoolStatistics *statistics)
+{
+    pthread_mutex_lock(&pool->lock);
+    _statistics_Add(&pool->retired, statistics);
+    if (magazine != NULL) {
+        if (_parcObjectPool_Enabled && magazine->count > 0 && pool->fullCount < PARCObjectPool_DepotCapacity) {
+            magazine->next = pool->full;
+            pool->full = magazine;
+            pool->fullCount++;
+            magazine = NULL;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (magazine != NULL) {
+        _magazine_Destroy(&magazine);
+    }
+}
+
+static void
+_thread_Destroy(_PARCObjectPoolThread **threadPtr)
+{
+    _PARCObjectPoolThread *thread = *threadPtr;
+
+    pthread_mutex_lock(&_parcObjectPool_Registry);
+    _PARCObjectPoolThread **link = &_parcObjectPool_Threads;
+    while (*link != thread) {
+        link = &(*link)->next;
+    }
+    *link = thread->next;
+    unsigned int poolCount = _parcObjectPool_PoolCount;
+    pthread_mutex_unlock(&_parcObjectPool_Registry);
+
+    for (unsigned int i = 0; i < poolCount; i++) {
+        _pool_Retire(&_parcObjectPool_Pools[i], thread->magazine[i], &thread->statistics[i]);
+    }
+
+    free(thread);
+    *threadPtr = NULL;
+}
+
+static void
+_thread_Exit(void *thread)
+{
+    _thread_Destroy((_PARCObjectPoolThread **) &thread);
+}
+
+static void
+_parcObjectPool_InitOnce(void)
+{
+    pthread_key_create(&_parcObjectPool_ThreadKey, _thread_Exit);
+}
+
+static _PARCObjectPoolThread *
+_thread_Get(bool create)
+{
+    pthread_once(&_parcObjectPool_Once, _parcObjectPool_InitOnce);
+
+    _PARCObjectPoolThread *result = pthread_getspecific(_parcObjectPool_ThreadKey);
+    if (result == NULL && create) {
+        result = calloc(1, sizeof(_PARCObjectPoolThread));
+        if (result != NULL) {
+            pthread_setspecific(_parcObjectPool_ThreadKey, result);
+
+            pthread_mutex_lock(&_parcObjectPool_Registry);
+            result->next = _parcObjectPool_Threads;
+            _parcObjectPool_Threads = result;
+            pthread_mutex_unlock(&_parcObjectPool_Registry);
+        }
+    }
+    return result;
+}
+
+/**
+ * Get, creating if necessary, the pool for the given descriptor.
+ *
+ * The size of the blocks in the pool is fixed by the first allocation.
+ */
+static PARCObjectPool *
+_pool_Get(const PARCObjectDescriptor *descriptor, size_t length)
+{
+    PARCObjectPool *result = *descriptor->pool;
+
+    if (result == NULL && _parcObjectPool_PoolCount < PARCObjectPool_MaxPools) {
+        pthread_mutex_lock(&_parcObjectPool_Registry);
+        result = *descriptor->pool;
+        if (result == NULL && _parcObjectPool_PoolCount < PARCObjectPool_MaxPools) {
+            result = &_parcObjectPool_Pools[_parcObjectPool_PoolCount];
+            result->descriptor = descriptor;
+            result->index = _parcObjectPool_PoolCount;
+            result->blockLength = length;
+            pthread_mutex_init(&result->lock, NULL);
+            result->full = NULL;
+            result->fullCount = 0;
+            result->empty = NULL;
+            memset(&result->retired, 0, sizeof(result->retired));
+
+            __sync_synchronize();
+            *descriptor->pool = result;
+            _parcObjectPool_PoolCount++;
+        }
+        pthread_mutex_unlock(&_parcObjectPool_Registry);
+    }
+
+    return result;
+}
+
+/**
+ * Exchange the given (empty or NULL) magazine for one containing blocks from the depot.
+ *
+ * @return The magazine to use, which is the original one if the depot has no blocks.
+ */
+static _PARCObjectPoolMagazine *
+_pool_ExchangeForFull(PARCObjectPool *pool, _PARCObjectPoolMagazine *magazine)
+{
+    _PARCObjectPoolMagazine *result = magazine;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->full != NULL) {
+        result = pool->full;
+        pool->full = result->next;
+        pool->fullCount--;
+        if (magazine != NULL) {
+            magazine->next = pool->empty;
+            pool->empty = magazine;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return result;
+}
+
+/**
+ * Exchange the given (full or NULL) magazine for an empty one, giving the full one to the depot.
+ *
+ * @return The magazine to use, which is the original one if the depot has no room for it.
+ */
+static _PARCObjectPoolMagazine *
+_pool_ExchangeForEmpty(PARCObjectPool *pool, _PARCObjectPoolMagazine *magazine)
+{
+    _PARCObjectPoolMagazine *result = magazine;
+
+    pthread_mutex_lock(&pool->lock);
+    if (magazine == NULL || pool->fullCount < PARCObjectPool_DepotCapacity) {
+        result = pool->empty;
+        if (result != NULL) {
+            pool->empty = result->next;
+        } else {
+            result = malloc(sizeof(_PARCObjectPoolMagazine));
+        }
+        if (result != NULL) {
+            result->count = 0;
+            if (magazine != NULL) {
+                magazine->next = pool->full;
+                pool->full = magazine;
+                pool->fullCount++;
+            }
+        } else {
+            result = magazine;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return result;
+}
+
+bool
+parcObjectPool_SetEnabled(bool enabled)
+{
+    bool result = _parcObjectPool_Enabled;
+    _parcObjectPool_Enabled = enabled;
+    if (enabled == false) {
+        parcObjectPool_Flush();
+    }
+    return result;
+}
+
+bool
+parcObjectPool_IsEnabled(void)
+{
+    return _parcObjectPool_Enabled;
+}
+
+void
+parcObjectPool_Flush(void)
+{
+    _PARCObjectPoolThread *thread = _thread_Get(false);
+    if (thread != NULL) {
+        pthread_setspecific(_parcObjectPool_ThreadKey, NULL);
+        for (unsigned int i = 0; i < _parcObjectPool_PoolCount; i++) {
+            if (thread->magazine[i] != NULL) {
+                _magazine_Destroy(&thread->magazine[i]);
+            }
+        }
+        _thread_Destroy(&thread);
+    }
+
+    for (unsigned int i = 0; i < _parcObjectPool_PoolCount; i++) {
+        PARCObjectPool *pool = &_parcObjectPool_Pools[i];
+
+        pthread_mutex_lock(&pool->lock);
+        _PARCObjectPoolMagazine *full = pool->full;
+        _PARCObjectPoolMagazine *empty = pool->empty;
+        pool->full = NULL;
+        pool->fullCount = 0;
+        pool->empty = NULL;
+        pthread_mutex_unlock(&pool->lock);
+
+        while (full != NULL) {
+            _PARCObjectPoolMagazine *next = full->next;
+            _magazine_Destroy(&full);
+            full = next;
+        }
+        while (empty != NULL) {
+            _PARCObjectPoolMagazine *next = empty->next;
+            _magazine_Destroy(&empty);
+            empty = next;
+        }
+    }
+}
+
+void *
+parcObjectPool_Get(const PARCObjectDescriptor *descriptor, size_t length)
+{
+    // Memory allocated while the thread has its own interface, such as an arena, must not outlive it.
+    if (_parcObjectPool_Enabled == false || parcMemory_GetThreadInterface() != NULL) {
+        return NULL;
+    }
+
+    PARCObjectPool *pool = _pool_Get(descriptor, length);
+    if (pool == NULL || pool->blockLength != length) {
+        return NULL;
+    }
+
+    _PARCObjectPoolThread *thread = _thread_Get(true);
+    if (thread == NULL) {
+        return NULL;
+    }
+
+    void *result = NULL;
+
+    _PARCObjectPoolMagazine *magazine = thread->magazine[pool->index];
+    if (magazine == NULL || magazine->count == 0) {
+        magazine = _pool_ExchangeForFull(pool, magazine);
+        thread->magazine[pool->index] = magazine;
+    }
+
+    if (magazine != NULL && magazine->count > 0) {
+        result = magazine->blocks[--magazine->count];
+        thread->statistics[pool->index].hits++;
+    } else {
+        thread->statistics[pool->index].misses++;
+    }
+
+    return result;
+}
+
+bool
+parcObjectPool_Put(const PARCObjectDescriptor *descriptor, void *origin, size_t length)
+{
+    if (_parcObjectPool_Enabled == false || parcMemory_GetThreadInterface() != NULL) {
+        return false;
+    }
+
+    PARCObjectPool *pool = *descriptor->pool;
+    if (pool == NULL || pool->blockLength != length) {
+        return false;
+    }
+
+    _PARCObjectPoolThread *thread = _thread_Get(true);
+    if (thread == NULL) {
+        return false;
+    }
+
+    bool result = false;
+
+    _PARCObjectPoolMagazine *magazine = thread->magazine[pool->index];
+    if (magazine == NULL || magazine->count == PARCObjectPool_MagazineCapacity) {
+        magazine = _pool_ExchangeForEmpty(pool, magazine);
+        thread->magazine[pool->index] = magazine;
+    }
+
+    if (magazine != NULL && magazine->count < PARCObjectPool_MagazineCapacity) {
+        magazine->blocks[magazine->count++] = origin;
+        thread->statistics[pool->index].recycled++;
+        result = true;
+    } else {
+        thread->statistics[pool->index].returned++;
+    }
+
+    return result;
+}
+
+bool
+parcObjectPool_GetThreadStatistics(const PARCObjectDescriptor *descriptor, PARCObjectPoolStatistics *statistics)
+{
+    PARCObjectPool *pool = (descriptor->pool == NULL) ? NULL : *descriptor->pool;
+    if (pool == NULL) {
+        return false;
+    }
+
+    memset(statistics, 0, sizeof(PARCObjectPoolStatistics));
+
+    _PARCObjectPoolThread *thread = _thread_Get(false);
+    if (thread != NULL) {
+        *statistics = thread->statistics[pool->index];
+    }
+    return true;
+}
+
+bool
+parcObjectPool_GetStatistics(const PARCObjectDescriptor *descriptor, PARCObjectPoolStatistics *statistics)
+{
+    PARCObjectPool *pool = (descriptor->pool == NULL) ? NULL : *descriptor->pool;
+    if (pool == NULL) {
+        return false;
+    }
+
+    memset(statistics, 0, sizeof(PARCObjectPoolStatistics));
+
+    pthread_mutex_lock(&_parcObjectPool_Registry);
+    for (_PARCObjectPoolThread *thread = _parcObjectPool_Threads; thread != NULL; thread = thread->next) {
+        _statistics_Add(statistics, &thread->statistics[pool->index]);
+    }
+    pthread_mutex_unlock(&_parcObjectPool_Registry);
+
+    pthread_mutex_lock(&pool->lock);
+    _statistics_Add(statistics, &pool->retired);
+    pthread_mutex_unlock(&pool->lock);
+
+    return true;
+}
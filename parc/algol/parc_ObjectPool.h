@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_ObjectPool.h
+ * @ingroup memory
+ * @brief Per-descriptor caches of recycled PARCObject memory.
+ *
+ * Types that are created and released at a high rate may declare a pool for their `PARCObjectDescriptor`
+ * (see `parcObject_ExtendPARCObjectPooled` and `parcObject_DeclarePool`).
+ * When pooling is enabled, the memory of a released instance of a pooled type is kept for reuse
+ * instead of being returned to `parcMemory`, and the next creation of an instance of the same type and size
+ * takes it from the pool.
+ *
+ * Each thread has a small cache (a magazine) of blocks for each pool, which it uses without locking.
+ * When a thread's magazine is empty, or full, it is exchanged for another one in the pool's shared depot.
+ * Blocks are returned to `parcMemory` only when both the magazine and the depot are full,
+ * when a thread exits while pooling is disabled, or when the pools are flushed.
+ *
+ * Pooling is disabled by default, so that the accounting of `parcMemory_Outstanding`
+ * (and of the SafeMemory provider) is exact for every allocation.
+ * Applications enable it once, at startup, with `parcObjectPool_SetEnabled`.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ObjectPool_h
+#define libparc_parc_ObjectPool_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <parc/algol/parc_Object.h>
+
+/**
+ * The maximum number of `PARCObjectDescriptor` instances that may have a pool.
+ * Instances of pooled types declared beyond this number are allocated and deallocated as usual.
+ */
+#define PARCObjectPool_MaxPools 32
+
+/**
+ * The number of blocks held by each thread's magazine.
+ */
+#define PARCObjectPool_MagazineCapacity 64
+
+/**
+ * The maximum number of magazines of blocks held in a pool's shared depot.
+ */
+#define PARCObjectPool_DepotCapacity 16
+
+struct parc_object_pool;
+typedef struct parc_object_pool PARCObjectPool;
+
+/**
+ * Counters of the use of a pool.
+ */
+typedef struct parc_object_pool_statistics {
+    uint64_t hits;      // Instances created from recycled memory.
+    uint64_t misses;    // Instances created from memory allocated by parcMemory.
+    uint64_t recycled;  // Released instances whose memory was kept for reuse.
+    uint64_t returned;  // Released instances whose memory was deallocated because the pool was full.
+} PARCObjectPoolStatistics;
+
+/**
+ * Enable, or disable, the recycling of the memory of pooled types.
+ *
+ * Disabling pooling flushes the depots and the calling thread's magazines (see `parcObjectPool_Flush`).
+ * Pooling must be enabled and disabled while no other thread is creating or releasing instances of pooled types,
+ * and while the same `PARCMemoryInterface` is in use as when the recycled memory was allocated.
+ *
+ * @param [in] enabled `true` to enable pooling, `false` to disable it.
+ *
+ * @return The previous setting.
+ *
+ * Example:
+ * @code
+ * int
+ * main(int argc, char *argv[])
+ * {
+ *     parcObjectPool_SetEnabled(true);
+ *     ...
+ * }
+ * @endcode
+ */
+bool parcObjectPool_SetEnabled(bool enabled);
+
+/**
+ * Determine if the recycling of the memory of pooled types is enabled.
+ *
+ * @return true Pooling is enabled.
+ * @return false Pooling is disabled.
+ */
+bool parcObjectPool_IsEnabled(void);
+
+/**
+ * Deallocate all of the memory held by the pools' depots and by the calling thread's magazines.
+ *
+ * Memory held by the magazines of other threads is not affected.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcObjectPool_Flush();
+ *     assertTrue(parcMemory_Outstanding() == 0, "Leaked memory");
+ * }
+ * @endcode
+ */
+void parcObjectPool_Flush(void);
+
+/**
+ * Get memory of @p length bytes for a new instance of the type described by @p descriptor.
+ *
+ * This is used by `parcObject_CreateInstanceImpl` and is not intended to be called otherwise.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor` with a non-NULL pool.
+ * @param [in] length The length, in bytes, of the whole allocation including the object header.
+ *
+ * @return NULL No recycled memory is available, or the calling thread has its own memory interface, the caller must allocate it.
+ * @return non-NULL A pointer to recycled memory of @p length bytes.
+ */
+void *parcObjectPool_Get(const PARCObjectDescriptor *descriptor, size_t length);
+
+/**
+ * Offer the memory of a released instance of the type described by @p descriptor for reuse.
+ *
+ * This is used by `parcObject_Release` and is not intended to be called otherwise.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor` with a non-NULL pool.
+ * @param [in] origin A pointer to the origin of the memory of the released instance.
+ * @param [in] length The length, in bytes, of the whole allocation including the object header.
+ *
+ * @return true The memory was kept for reuse.
+ * @return false The memory was not kept, because the pool is full or the calling thread has its own memory interface,
+ *               and the caller must deallocate it.
+ */
+bool parcObjectPool_Put(const PARCObjectDescriptor *descriptor, void *origin, size_t length);
+
+/**
+ * Get the statistics of the calling thread's use of the pool for the given `PARCObjectDescriptor`.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor`.
+ * @param [out] statistics A pointer to a `PARCObjectPoolStatistics` to fill in.
+ *
+ * @return true The descriptor has a pool and @p statistics was filled in.
+ * @return false The descriptor is not pooled, or its pool has not been used yet.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCObjectPoolStatistics statistics;
+ *     if (parcObjectPool_GetThreadStatistics(&PARCBuffer_Descriptor, &statistics)) {
+ *         printf("%" PRIu64 " hits, %" PRIu64 " misses\n", statistics.hits, statistics.misses);
+ *     }
+ * }
+ * @endcode
+ */
+bool parcObjectPool_GetThreadStatistics(const PARCObjectDescriptor *descriptor, PARCObjectPoolStatistics *statistics);
+
+/**
+ * Get the statistics of all threads' use of the pool for the given `PARCObjectDescriptor`.
+ *
+ * This includes threads that have exited.
+ * The counters of other running threads are read without synchronisation and may be slightly out of date.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor`.
+ * @param [out] statistics A pointer to a `PARCObjectPoolStatistics` to fill in.
+ *
+ * @return true The descriptor has a pool and @p statistics was filled in.
+ * @return false The descriptor is not pooled, or its pool has not been used yet.
+ */
+bool parcObjectPool_GetStatistics(const PARCObjectDescriptor *descriptor, PARCObjectPoolStatistics *statistics);
+#endif // libparc_parc_ObjectPool_h
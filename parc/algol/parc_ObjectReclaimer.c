@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <parc/algol/parc_ObjectReclaimer.h>
+#include <parc/algol/parc_Memory.h>
+
+/**
+ * A retired object, and the epoch in which it was retired.
+ */
+typedef struct parc_object_reclaimer_entry {
+    struct parc_object_reclaimer_entry *next;
+    PARCObject *object;
+    size_t length;
+    uint64_t epoch;
+} _PARCObjectReclaimerEntry;
+
+/**
+ * A registered thread, and the epoch of its most recent quiescent state.
+ */
+typedef struct parc_object_reclaimer_thread {
+    struct parc_object_reclaimer_thread *next;
+    volatile uint64_t epoch;
+} _PARCObjectReclaimerThread;
+
+static volatile uint64_t _parcObjectReclaimer_Epoch = 1;
+
+// Objects are retired onto this stack without locking, and are taken all at once by a reclamation.
+static _PARCObjectReclaimerEntry *volatile _parcObjectReclaimer_Retired = NULL;
+static volatile uint64_t _parcObjectReclaimer_Pending = 0;
+static volatile uint64_t _parcObjectReclaimer_PendingBytes = 0;
+
+static pthread_mutex_t _parcObjectReclaimer_Lock = PTHREAD_MUTEX_INITIALIZER;  // Guards the following.
+static _PARCObjectReclaimerEntry *_parcObjectReclaimer_Limbo = NULL;            // Taken, but not yet safe to release.
+static _PARCObjectReclaimerThread *_parcObjectReclaimer_Threads = NULL;
+static PARCObjectReclaimerStatistics _parcObjectReclaimer_Statistics;
+
+static pthread_once_t _parcObjectReclaimer_Once = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcObjectReclaimer_ThreadKey;
+
+static pthread_mutex_t _parcObjectReclaimer_ControlLock = PTHREAD_MUTEX_INITIALIZER;  // Guards the background thread.
+static pthread_cond_t _parcObjectReclaimer_Wakeup = PTHREAD_COND_INITIALIZER;
+static pthread_t _parcObjectReclaimer_Thread;
+static bool _parcObjectReclaimer_Running = false;
+static uint64_t _parcObjectReclaimer_Interval = 0;
+
+static void
+_thread_Unregister(_PARCObjectReclaimerThread *thread)
+{
+    pthread_mutex_lock(&_parcObjectReclaimer_Lock);
+    _PARCObjectReclaimerThread **link = &_parcObjectReclaimer_Threads;
+    while (*link != thread) {
+        link = &(*link)->next;
+    }
+    *link = thread->next;
+    pthread_mutex_unlock(&_parcObjectReclaimer_Lock);
+
+    free(thread);
+}
+
+static void
+_thread_Exit(void *thread)
+{
+    _thread_Unregister(thread);
+}
+
+static void
+_parcObjectReclaimer_InitOnce(void)
+{
+    pthread_key_create(&_parcObjectReclaimer_ThreadKey, _thread_Exit);
+}
+
+static _PARCObjectReclaimerThread *
+_thread_Get(void)
+{
+    pthread_once(&_parcObjectReclaimer_Once, _parcObjectReclaimer_InitOnce);
+    return pthread_getspecific(_parcObjectReclaimer_ThreadKey);
+}
+
+void
+parcObjectReclaimer_Retire(PARCObject *object, size_t length)
+{
+    _PARCObjectReclaimerEntry *entry = malloc(sizeof(_PARCObjectReclaimerEntry));
+    if (entry == NULL) {
+        // Without memory to defer it, the object is released now.
+        parcObject_Release(&object);
+        return;
+    }
+
+    entry->object = object;
+    entry->length = length;
+    entry->epoch = _parcObjectReclaimer_Epoch;
+
+    __sync_fetch_and_add(&_parcObjectReclaimer_Pending, 1);
+    __sync_fetch_and_add(&_parcObjectReclaimer_PendingBytes, length);
+
+    _PARCObjectReclaimerEntry *head;
+    do {
+        head = _parcObjectReclaimer_Retired;
+        entry->next = head;
+    } while (!__sync_bool_compare_and_swap(&_parcObjectReclaimer_Retired, head, entry));
+}
+
+size_t
+parcObjectReclaimer_Reclaim(void)
+{
+    _PARCObjectReclaimerThread *self = _thread_Get();
+
+    pthread_mutex_lock(&_parcObjectReclaimer_Lock);
+
+    _PARCObjectReclaimerEntry *taken = __sync_lock_test_and_set(&_parcObjectReclaimer_Retired, NULL);
+    while (taken != NULL) {
+        _PARCObjectReclaimerEntry *next = taken->next;
+        taken->next = _parcObjectReclaimer_Limbo;
+        _parcObjectReclaimer_Limbo = taken;
+        taken = next;
+    }
+
+    uint64_t endedEpoch = __sync_fetch_and_add(&_parcObjectReclaimer_Epoch, 1);
+    uint64_t safeEpoch = endedEpoch + 1;
+
+    if (self != NULL) {
+        self->epoch = safeEpoch;
+    }
+
+    // An object retired in an epoch before every registered thread's most recent quiescent state is unreachable.
+    for (_PARCObjectReclaimerThread *thread = _parcObjectReclaimer_Threads; thread != NULL; thread = thread->next) {
+        if (thread->epoch < safeEpoch) {
+            safeEpoch = thread->epoch;
+        }
+    }
+
+    _PARCObjectReclaimerEntry *ready = NULL;
+    _PARCObjectReclaimerEntry **link = &_parcObjectReclaimer_Limbo;
+    while (*link != NULL) {
+        _PARCObjectReclaimerEntry *entry = *link;
+        if (entry->epoch < safeEpoch) {
+            *link = entry->next;
+            entry->next = ready;
+            ready = entry;
+        } else {
+            link = &entry->next;
+        }
+    }
+
+    pthread_mutex_unlock(&_parcObjectReclaimer_Lock);
+
+    // The finalizers run without holding the lock, so that they may themselves defer releases.
+    size_t count = 0;
+    uint64_t bytes = 0;
+    while (ready != NULL) {
+        _PARCObjectReclaimerEntry *entry = ready;
+        ready = entry->next;
+
+        parcObject_Release(&entry->object);
+        count++;
+        bytes += entry->length;
+        free(entry);
+    }
+
+    __sync_fetch_and_sub(&_parcObjectReclaimer_Pending, count);
+    __sync_fetch_and_sub(&_parcObjectReclaimer_PendingBytes, bytes);
+
+    pthread_mutex_lock(&_parcObjectReclaimer_Lock);
+    _parcObjectReclaimer_Statistics.reclaimed += count;
+    _parcObjectReclaimer_Statistics.reclaimedBytes += bytes;
+    _parcObjectReclaimer_Statistics.lastEpoch = endedEpoch;
+    _parcObjectReclaimer_Statistics.lastReclaimed = count;
+    _parcObjectReclaimer_Statistics.lastReclaimedBytes = bytes;
+    pthread_mutex_unlock(&_parcObjectReclaimer_Lock);
+
+    return count;
+}
+
+void
+parcObjectReclaimer_RegisterThread(void)
+{
+    if (_thread_Get() == NULL) {
+        _PARCObjectReclaimerThread *thread = calloc(1, sizeof(_PARCObjectReclaimerThread));
+        assertNotNull(thread, "calloc(%zu) returned NULL", sizeof(_PARCObjectReclaimerThread));
+
+        pthread_mutex_lock(&_parcObjectReclaimer_Lock);
+        thread->epoch = _parcObjectReclaimer_Epoch;
+        thread->next = _parcObjectReclaimer_Threads;
+        _parcObjectReclaimer_Threads = thread;
+        pthread_mutex_unlock(&_parcObjectReclaimer_Lock);
+
+        pthread_setspecific(_parcObjectReclaimer_ThreadKey, thread);
+    }
+}
+
+void
+parcObjectReclaimer_UnregisterThread(void)
+{
+    _PARCObjectReclaimerThread *thread = _thread_Get();
+    if (thread != NULL) {
+        pthread_setspecific(_parcObjectReclaimer_ThreadKey, NULL);
+        _thread_Unregister(thread);
+    }
+}
+
+void
+parcObjectReclaimer_Quiescent(void)
+{
+    _PARCObjectReclaimerThread *thread = _thread_Get();
+    if (thread != NULL) {
+        // Complete this thread's reads of shared objects before announcing the quiescent state.
+        __sync_synchronize();
+        thread->epoch = _parcObjectReclaimer_Epoch;
+    }
+}
+
+static void *
+_parcObjectReclaimer_Run(void *unused __attribute__((unused)))
+{
+    pthread_mutex_lock(&_parcObjectReclaimer_ControlLock);
+    while (_parcObjectReclaimer_Running) {
+        struct timeval now;
+        gettimeofday(&now, NULL);
+
+        uint64_t microseconds = now.tv_usec + _parcObjectReclaimer_Interval;
+        struct timespec deadline = {
+            .tv_sec  = now.tv_sec + (time_t) (microseconds / 1000000),
+            .tv_nsec = (long) (microseconds % 1000000) * 1000
+        };
+
+        int status = 0;
+        while (_parcObjectReclaimer_Running && status != ETIMEDOUT) {
+            status = pthread_cond_timedwait(&_parcObjectReclaimer_Wakeup, &_parcObjectReclaimer_ControlLock, &deadline);
+        }
+
+        if (_parcObjectReclaimer_Running) {
+            pthread_mutex_unlock(&_parcObjectReclaimer_ControlLock);
+            parcObjectReclaimer_Reclaim();
+            pthread_mutex_lock(&_parcObjectReclaimer_ControlLock);
+        }
+    }
+    pthread_mutex_unlock(&_parcObjectReclaimer_ControlLock);
+
+    return NULL;
+}
+
+bool
+parcObjectReclaimer_Start(uint64_t intervalMicroseconds)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&_parcObjectReclaimer_ControlLock);
+    if (_parcObjectReclaimer_Running == false) {
+        _parcObjectReclaimer_Interval = intervalMicroseconds;
+        _parcObjectReclaimer_Running = true;
+        if (pthread_create(&_parcObjectReclaimer_Thread, NULL, _parcObjectReclaimer_Run, NULL) == 0) {
+            result = true;
+        } else {
+            _parcObjectReclaimer_Running = false;
+        }
+    }
+    pthread_mutex_unlock(&_parcObjectReclaimer_ControlLock);
+
+    return result;
+}
+
+bool
+parcObjectReclaimer_Stop(void)
+{
+    pthread_mutex_lock(&_parcObjectReclaimer_ControlLock);
+    bool result = _parcObjectReclaimer_Running;
+    _parcObjectReclaimer_Running = false;
+    pthread_cond_signal(&_parcObjectReclaimer_Wakeup);
+    pthread_mutex_unlock(&_parcObjectReclaimer_ControlLock);
+
+    if (result) {
+        pthread_join(_parcObjectReclaimer_Thread, NULL);
+    }
+    return result;
+}
+
+void
+parcObjectReclaimer_GetStatistics(PARCObjectReclaimerStatistics *statistics)
+{
+    pthread_mutex_lock(&_parcObjectReclaimer_Lock);
+    *statistics = _parcObjectReclaimer_Statistics;
+    pthread_mutex_unlock(&_parcObjectReclaimer_Lock);
+
+    statistics->epoch = _parcObjectReclaimer_Epoch;
+    statistics->pending = _parcObjectReclaimer_Pending;
+    statistics->pendingBytes = _parcObjectReclaimer_PendingBytes;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_ObjectReclaimer.h
+ * @ingroup memory
+ * @brief Deferred, batched, release of PARCObject instances using quiescent-state based reclamation.
+ *
+ * Releasing the last reference to an object runs its finalizer, which may in turn release
+ * the last references to many other objects (for example a `PARCHashMap` of `PARCLinkedList` instances).
+ * A thread that must not incur that cost, such as the producer side of a `PARCRingBufferNxM`,
+ * uses `parcObject_ReleaseDeferred` instead of `parcObject_Release`.
+ * The last reference is then retired to the reclaimer, and the finalizers of the retired objects
+ * are run later in bulk, either at a safe point chosen by the application (`parcObjectReclaimer_Reclaim`),
+ * or by a background thread (`parcObjectReclaimer_Start`).
+ *
+ * Time is divided into epochs. Each call to `parcObjectReclaimer_Reclaim` begins a new epoch.
+ * Threads that read shared objects without holding a reference register with `parcObjectReclaimer_RegisterThread`
+ * and periodically announce, with `parcObjectReclaimer_Quiescent`, that they hold no such pointers.
+ * An object retired during an epoch is finalized only after every registered thread
+ * has announced a quiescent state in a later epoch.
+ * When no thread is registered, every retired object is finalized by the next reclamation.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ObjectReclaimer_h
+#define libparc_parc_ObjectReclaimer_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <parc/algol/parc_Object.h>
+
+/**
+ * Counters of the activity of the reclaimer.
+ *
+ * The byte counts are of the retired objects themselves, including their headers,
+ * and not of the objects that their finalizers release in turn.
+ */
+typedef struct parc_object_reclaimer_statistics {
+    uint64_t epoch;                 // The current epoch.
+    uint64_t pending;               // Objects retired and not yet finalized.
+    uint64_t pendingBytes;          // The bytes of the pending objects.
+    uint64_t reclaimed;             // Objects finalized since the process started.
+    uint64_t reclaimedBytes;        // The bytes of the objects finalized since the process started.
+    uint64_t lastEpoch;             // The epoch ended by the most recent reclamation.
+    uint64_t lastReclaimed;         // Objects finalized by the most recent reclamation.
+    uint64_t lastReclaimedBytes;    // The bytes of the objects finalized by the most recent reclamation.
+} PARCObjectReclaimerStatistics;
+
+/**
+ * Retire the last reference to the given object, to be released by a later reclamation.
+ *
+ * This is used by `parcObject_ReleaseDeferred` and is not intended to be called otherwise.
+ * It does not block, and does not run any finalizer.
+ *
+ * @param [in] object A pointer to a valid PARCObject instance whose reference count is 1.
+ * @param [in] length The number of bytes occupied by the object, including its header.
+ */
+void parcObjectReclaimer_Retire(PARCObject *object, size_t length);
+
+/**
+ * Begin a new epoch, and release every retired object that no registered thread can still be reading.
+ *
+ * If the calling thread is registered, it is first taken to be in a quiescent state.
+ * The finalizers of the released objects run on the calling thread.
+ *
+ * @return The number of retired objects released.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcObject_ReleaseDeferred(&object);
+ *     ...
+ *     size_t released = parcObjectReclaimer_Reclaim();
+ * }
+ * @endcode
+ */
+size_t parcObjectReclaimer_Reclaim(void);
+
+/**
+ * Register the calling thread as one that reads shared objects without holding references to them.
+ *
+ * A registered thread must periodically call `parcObjectReclaimer_Quiescent`,
+ * otherwise no retired object will ever be released.
+ * A thread's registration ends when it calls `parcObjectReclaimer_UnregisterThread`, or when it exits.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcObjectReclaimer_RegisterThread();
+ *     while (running) {
+ *         // read shared objects
+ *         parcObjectReclaimer_Quiescent();
+ *     }
+ *     parcObjectReclaimer_UnregisterThread();
+ * }
+ * @endcode
+ */
+void parcObjectReclaimer_RegisterThread(void);
+
+/**
+ * End the registration of the calling thread.
+ *
+ * It is not an error if the thread is not registered.
+ */
+void parcObjectReclaimer_UnregisterThread(void);
+
+/**
+ * Announce that the calling thread holds no pointers to shared objects that it does not hold references for.
+ *
+ * It is inexpensive, and is not an error if the thread is not registered.
+ */
+void parcObjectReclaimer_Quiescent(void);
+
+/**
+ * Start a background thread that calls `parcObjectReclaimer_Reclaim` every @p intervalMicroseconds.
+ *
+ * @param [in] intervalMicroseconds The interval between reclamations.
+ *
+ * @return true The thread was started.
+ * @return false The thread is already running, or could not be started.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcObjectReclaimer_Start(1000);
+ *     ...
+ *     parcObjectReclaimer_Stop();
+ * }
+ * @endcode
+ */
+bool parcObjectReclaimer_Start(uint64_t intervalMicroseconds);
+
+/**
+ * Stop the background thread started by `parcObjectReclaimer_Start`, and wait for it to exit.
+ *
+ * Objects that remain retired are released by the next call to `parcObjectReclaimer_Reclaim`.
+ *
+ * @return true The thread was stopped.
+ * @return false The thread was not running.
+ */
+bool parcObjectReclaimer_Stop(void);
+
+/**
+ * Get a snapshot of the counters of the activity of the reclaimer.
+ *
+ * @param [out] statistics A pointer to the `PARCObjectReclaimerStatistics` to fill in.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCObjectReclaimerStatistics statistics;
+ *     parcObjectReclaimer_GetStatistics(&statistics);
+ *     printf("%" PRIu64 " objects pending\n", statistics.pending);
+ * }
+ * @endcode
+ */
+void parcObjectReclaimer_GetStatistics(PARCObjectReclaimerStatistics *statistics);
+#endif // libparc_parc_ObjectReclaimer_h
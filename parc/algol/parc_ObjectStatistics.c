@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <parc/algol/parc_ObjectStatistics.h>
+#include <parc/algol/parc_Memory.h>
+
+/**
+ * Monotonic counters, so that an instance created by one thread and released by another
+ * is counted correctly when the shards of all threads are summed.
+ */
+typedef struct {
+    uint64_t created;
+    uint64_t released;
+    uint64_t createdBytes;
+    uint64_t releasedBytes;
+} _PARCObjectStatisticsCounters;
+
+typedef struct parc_object_statistics_shard {
+    struct parc_object_statistics_shard *next;
+    _PARCObjectStatisticsCounters counters[PARCObjectStatistics_MaxTypes];
+} _PARCObjectStatisticsShard;
+
+/**
+ * The index of a type's counters, cached for each descriptor of that type.
+ */
+typedef struct {
+    const PARCObjectDescriptor *volatile descriptor;
+    unsigned int index;
+} _PARCObjectStatisticsSlot;
+
+#define _PARCObjectStatistics_Slots (PARCObjectStatistics_MaxTypes * 2)
+
+// No descriptor is cached once this many slots are occupied, so that probing always finds an empty slot.
+#define _PARCObjectStatistics_SlotLimit ((_PARCObjectStatistics_Slots * 3) / 4)
+
+// Marks the slot of a destroyed descriptor. It keeps probe sequences intact and may be reused.
+#define _PARCObjectStatistics_Forgotten ((const PARCObjectDescriptor *) &_parcObjectStatistics_Slots)
+
+static bool _parcObjectStatistics_Enabled = false;
+
+static pthread_mutex_t _parcObjectStatistics_Lock = PTHREAD_MUTEX_INITIALIZER;  // Guards the following.
+static char _parcObjectStatistics_Names[PARCObjectStatistics_MaxTypes][sizeof(((PARCObjectDescriptor *) 0)->name)];
+static unsigned int _parcObjectStatistics_TypeCount = 0;
+static _PARCObjectStatisticsSlot _parcObjectStatistics_Slots[_PARCObjectStatistics_Slots];
+static unsigned int _parcObjectStatistics_SlotCount = 0;
+static _PARCObjectStatisticsShard *_parcObjectStatistics_Shards = NULL;
+static _PARCObjectStatisticsCounters _parcObjectStatistics_Retired[PARCObjectStatistics_MaxTypes];
+
+static pthread_once_t _parcObjectStatistics_Once = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcObjectStatistics_ShardKey;
+
+static pthread_mutex_t _parcObjectStatistics_LoggingLock = PTHREAD_MUTEX_INITIALIZER;  // Guards the logging thread.
+static pthread_cond_t _parcObjectStatistics_LoggingWakeup = PTHREAD_COND_INITIALIZER;
+static pthread_t _parcObjectStatistics_LoggingThread;
+static bool _parcObjectStatistics_Logging = false;
+static PARCLog *_parcObjectStatistics_Log = NULL;
+static unsigned int _parcObjectStatistics_LoggingInterval = 0;
+
+static inline void
+_counters_Add(_PARCObjectStatisticsCounters *sum, const _PARCObjectStatisticsCounters *counters)
+{
+    sum->created += counters->created;
+    sum->released += counters->released;
+    sum->createdBytes += counters->createdBytes;
+    sum->releasedBytes += counters->releasedBytes;
+}
+
+static void
+_shard_Destroy(_PARCObjectStatisticsShard **shardPtr)
+{
+    _PARCObjectStatisticsShard *shard = *shardPtr;
+
+    pthread_mutex_lock(&_parcObjectStatistics_Lock);
+    _PARCObjectStatisticsShard **link = &_parcObjectStatistics_Shards;
+    while (*link != shard) {
+        link = &(*link)->next;
+    }
+    *link = shard->next;
+
+    for (unsigned int i = 0; i < _parcObjectStatistics_TypeCount; i++) {
+        _counters_Add(&_parcObjectStatistics_Retired[i], &shard->counters[i]);
+    }
+    pthread_mutex_unlock(&_parcObjectStatistics_Lock);
+
+    free(shard);
+    *shardPtr = NULL;
+}
+
+static void
+_shard_Exit(void *shard)
+{
+    _shard_Destroy((_PARCObjectStatisticsShard **) &shard);
+}
+
+static void
+_parcObjectStatistics_InitOnce(void)
+{
+    pthread_key_create(&_parcObjectStatistics_ShardKey, _shard_Exit);
+}
+
+static _PARCObjectStatisticsShard *
+_shard_Get(bool create)
+{
+    pthread_once(&_parcObjectStatistics_Once, _parcObjectStatistics_InitOnce);
+
+    _PARCObjectStatisticsShard *result = pthread_getspecific(_parcObjectStatistics_ShardKey);
+    if (result == NULL && create) {
+        result = calloc(1, sizeof(_PARCObjectStatisticsShard));
+        if (result != NULL) {
+            pthread_setspecific(_parcObjectStatistics_ShardKey, result);
+
+            pthread_mutex_lock(&_parcObjectStatistics_Lock);
+            result->next = _parcObjectStatistics_Shards;
+            _parcObjectStatistics_Shards = result;
+            pthread_mutex_unlock(&_parcObjectStatistics_Lock);
+        }
+    }
+    return result;
+}
+
+static inline size_t
+_slot_Hash(const PARCObjectDescriptor *descriptor)
+{
+    return (((uintptr_t) descriptor) >> 3) % _PARCObjectStatistics_Slots;
+}
+
+/**
+ * Find the slot caching the given descriptor.
+ *
+ * @return The index of the slot, or _PARCObjectStatistics_Slots if the descriptor is not cached.
+ */
+static size_t
+_slot_Find(const PARCObjectDescriptor *descriptor)
+{
+    size_t i = _slot_Hash(descriptor);
+    for (size_t probes = 0; probes < _PARCObjectStatistics_Slots; probes++) {
+        const PARCObjectDescriptor *cached = _parcObjectStatistics_Slots[i].descriptor;
+        if (cached == descriptor) {
+            return i;
+        }
+        if (cached == NULL) {
+            break;
+        }
+        i = (i + 1) % _PARCObjectStatistics_Slots;
+    }
+    return _PARCObjectStatistics_Slots;
+}
+
+/**
+ * Cache the index of the counters of the given descriptor, if there is room.
+ *
+ * The caller must hold _parcObjectStatistics_Lock.
+ */
+static void
+_slot_Insert(const PARCObjectDescriptor *descriptor, unsigned int index)
+{
+    size_t i = _slot_Hash(descriptor);
+    for (size_t probes = 0; probes < _PARCObjectStatistics_Slots; probes++) {
+        const PARCObjectDescriptor *cached = _parcObjectStatistics_Slots[i].descriptor;
+        if (cached == _PARCObjectStatistics_Forgotten
+            || (cached == NULL && _parcObjectStatistics_SlotCount < _PARCObjectStatistics_SlotLimit)) {
+            if (cached == NULL) {
+                _parcObjectStatistics_SlotCount++;
+            }
+            _parcObjectStatistics_Slots[i].index = index;
+            __sync_synchronize();
+            _parcObjectStatistics_Slots[i].descriptor = descriptor;
+            return;
+        }
+        if (cached == NULL) {
+            return;
+        }
+        i = (i + 1) % _PARCObjectStatistics_Slots;
+    }
+}
+
+/**
+ * Find, or assign, the index of the counters of the type of the given descriptor.
+ *
+ * @return The index, or PARCObjectStatistics_MaxTypes if there is no room for another type.
+ */
+static unsigned int
+_parcObjectStatistics_Index(const PARCObjectDescriptor *descriptor)
+{
+    // The common case: the descriptor has been seen before, and is found without locking.
+    size_t slot = _slot_Find(descriptor);
+    if (slot < _PARCObjectStatistics_Slots) {
+        return _parcObjectStatistics_Slots[slot].index;
+    }
+
+    unsigned int result = PARCObjectStatistics_MaxTypes;
+
+    pthread_mutex_lock(&_parcObjectStatistics_Lock);
+    slot = _slot_Find(descriptor);
+    if (slot < _PARCObjectStatistics_Slots) {
+        result = _parcObjectStatistics_Slots[slot].index;
+    } else {
+        // Once the table is full, descriptors are matched to their type by name, under the lock.
+        for (unsigned int t = 0; t < _parcObjectStatistics_TypeCount; t++) {
+            if (strncmp(_parcObjectStatistics_Names[t], descriptor->name, sizeof(descriptor->name)) == 0) {
+                result = t;
+                break;
+            }
+        }
+        if (result == PARCObjectStatistics_MaxTypes && _parcObjectStatistics_TypeCount < PARCObjectStatistics_MaxTypes) {
+            result = _parcObjectStatistics_TypeCount;
+            strncpy(_parcObjectStatistics_Names[result], descriptor->name, sizeof(descriptor->name));
+            _parcObjectStatistics_Names[result][sizeof(descriptor->name) - 1] = 0;
+            _parcObjectStatistics_TypeCount++;
+        }
+
+        if (result < PARCObjectStatistics_MaxTypes) {
+            _slot_Insert(descriptor, result);
+        }
+    }
+    pthread_mutex_unlock(&_parcObjectStatistics_Lock);
+
+    return result;
+}
+
+void
+parcObjectStatistics_ForgetDescriptor(const PARCObjectDescriptor *descriptor)
+{
+    pthread_mutex_lock(&_parcObjectStatistics_Lock);
+    size_t slot = _slot_Find(descriptor);
+    if (slot < _PARCObjectStatistics_Slots) {
+        _parcObjectStatistics_Slots[slot].descriptor = _PARCObjectStatistics_Forgotten;
+    }
+    pthread_mutex_unlock(&_parcObjectStatistics_Lock);
+}
+
+bool
+parcObjectStatistics_SetEnabled(bool enabled)
+{
+    bool result = _parcObjectStatistics_Enabled;
+    _parcObjectStatistics_Enabled = enabled;
+
+    if (enabled == false) {
+        _PARCObjectStatisticsShard *shard = _shard_Get(false);
+        if (shard != NULL) {
+            pthread_setspecific(_parcObjectStatistics_ShardKey, NULL);
+            _shard_Destroy(&shard);
+        }
+    }
+    return result;
+}
+
+bool
+parcObjectStatistics_IsEnabled(void)
+{
+    return _parcObjectStatistics_Enabled;
+}
+
+void
+parcObjectStatistics_CountCreate(const PARCObjectDescriptor *descriptor, size_t length)
+{
+    unsigned int index = _parcObjectStatistics_Index(descriptor);
+    if (index < PARCObjectStatistics_MaxTypes) {
+        _PARCObjectStatisticsShard *shard = _shard_Get(true);
+        if (shard != NULL) {
+            shard->counters[index].created++;
+            shard->counters[index].createdBytes += length;
+        }
+    }
+}
+
+void
+parcObjectStatistics_CountRelease(const PARCObjectDescriptor *descriptor, size_t length)
+{
+    unsigned int index = _parcObjectStatistics_Index(descriptor);
+    if (index < PARCObjectStatistics_MaxTypes) {
+        _PARCObjectStatisticsShard *shard = _shard_Get(true);
+        if (shard != NULL) {
+            shard->counters[index].released++;
+            shard->counters[index].releasedBytes += length;
+        }
+    }
+}
+
+/**
+ * Sum the counters of every thread for the type with the given index.
+ *
+ * The caller must hold _parcObjectStatistics_Lock.
+ */
+static void
+_parcObjectStatistics_Sum(unsigned int index, PARCObjectTypeStatistics *statistics)
+{
+    _PARCObjectStatisticsCounters sum = _parcObjectStatistics_Retired[index];
+    for (_PARCObjectStatisticsShard *shard = _parcObjectStatistics_Shards; shard != NULL; shard = shard->next) {
+        _counters_Add(&sum, &shard->counters[index]);
+    }
+
+    // The shards are read while their threads update them, so a snapshot may momentarily count
+    // a release without its creation.
+    statistics->created = sum.created;
+    statistics->createdBytes = sum.createdBytes;
+    statistics->live = (sum.created > sum.released) ? sum.created - sum.released : 0;
+    statistics->liveBytes = (sum.createdBytes > sum.releasedBytes) ? sum.createdBytes - sum.releasedBytes : 0;
+}
+
+bool
+parcObjectStatistics_Get(const char *name, PARCObjectTypeStatistics *statistics)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&_parcObjectStatistics_Lock);
+    for (unsigned int i = 0; i < _parcObjectStatistics_TypeCount; i++) {
+        if (strncmp(_parcObjectStatistics_Names[i], name, sizeof(_parcObjectStatistics_Names[i])) == 0) {
+            _parcObjectStatistics_Sum(i, statistics);
+            result = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&_parcObjectStatistics_Lock);
+
+    return result;
+}
+
+PARCJSON *
+parcObjectStatistics_ToJSON(void)
+{
+    // Take the snapshot first: building the JSON creates PARCObjects, which may need the lock to be counted.
+    static PARCObjectTypeStatistics snapshot[PARCObjectStatistics_MaxTypes];
+    static pthread_mutex_t snapshotLock = PTHREAD_MUTEX_INITIALIZER;
+
+    PARCJSON *result = parcJSON_Create();
+
+    pthread_mutex_lock(&snapshotLock);
+
+    pthread_mutex_lock(&_parcObjectStatistics_Lock);
+    unsigned int typeCount = _parcObjectStatistics_TypeCount;
+    for (unsigned int i = 0; i < typeCount; i++) {
+        _parcObjectStatistics_Sum(i, &snapshot[i]);
+    }
+    pthread_mutex_unlock(&_parcObjectStatistics_Lock);
+
+    for (unsigned int i = 0; i < typeCount; i++) {
+        PARCJSON *type = parcJSON_Create();
+        parcJSON_AddInteger(type, "live", (int64_t) snapshot[i].live);
+        parcJSON_AddInteger(type, "created", (int64_t) snapshot[i].created);
+        parcJSON_AddInteger(type, "liveBytes", (int64_t) snapshot[i].liveBytes);
+        parcJSON_AddInteger(type, "createdBytes", (int64_t) snapshot[i].createdBytes);
+        // Names are never changed once assigned, so they can be read without the lock.
+        parcJSON_AddObject(result, _parcObjectStatistics_Names[i], type);
+        parcJSON_Release(&type);
+    }
+
+    pthread_mutex_unlock(&snapshotLock);
+
+    return result;
+}
+
+bool
+parcObjectStatistics_Log(PARCLog *log)
+{
+    PARCJSON *report = parcObjectStatistics_ToJSON();
+    char *string = parcJSON_ToCompactString(report);
+
+    bool result = parcLog_Info(log, "PARCObject statistics %s", string);
+
+    parcMemory_Deallocate((void **) &string);
+    parcJSON_Release(&report);
+
+    return result;
+}
+
+static void *
+_parcObjectStatistics_RunLogging(void *unused __attribute__((unused)))
+{
+    pthread_mutex_lock(&_parcObjectStatistics_LoggingLock);
+    while (_parcObjectStatistics_Logging) {
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        struct timespec deadline = {
+            .tv_sec  = now.tv_sec + _parcObjectStatistics_LoggingInterval,
+            .tv_nsec = now.tv_usec * 1000
+        };
+
+        int status = 0;
+        while (_parcObjectStatistics_Logging && status != ETIMEDOUT) {
+            status = pthread_cond_timedwait(&_parcObjectStatistics_LoggingWakeup, &_parcObjectStatistics_LoggingLock, &deadline);
+        }
+
+        if (_parcObjectStatistics_Logging) {
+            parcObjectStatistics_Log(_parcObjectStatistics_Log);
+        }
+    }
+    pthread_mutex_unlock(&_parcObjectStatistics_LoggingLock);
+
+    return NULL;
+}
+
+bool
+parcObjectStatistics_StartLogging(PARCLog *log, unsigned int intervalSeconds)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&_parcObjectStatistics_LoggingLock);
+    if (_parcObjectStatistics_Logging == false) {
+        _parcObjectStatistics_Log = parcLog_Acquire(log);
+        _parcObjectStatistics_LoggingInterval = intervalSeconds;
+        _parcObjectStatistics_Logging = true;
+        if (pthread_create(&_parcObjectStatistics_LoggingThread, NULL, _parcObjectStatistics_RunLogging, NULL) == 0) {
+            result = true;
+        } else {
+            _parcObjectStatistics_Logging = false;
+            parcLog_Release(&_parcObjectStatistics_Log);
+        }
+    }
+    pthread_mutex_unlock(&_parcObjectStatistics_LoggingLock);
+
+    return result;
+}
+
+bool
+parcObjectStatistics_StopLogging(void)
+{
+    pthread_mutex_lock(&_parcObjectStatistics_LoggingLock);
+    bool result = _parcObjectStatistics_Logging;
+    _parcObjectStatistics_Logging = false;
+    pthread_cond_signal(&_parcObjectStatistics_LoggingWakeup);
+    pthread_mutex_unlock(&_parcObjectStatistics_LoggingLock);
+
+    if (result) {
+        pthread_join(_parcObjectStatistics_LoggingThread, NULL);
+        parcLog_Release(&_parcObjectStatistics_Log);
+    }
+    return result;
+}
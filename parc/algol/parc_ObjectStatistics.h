@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_ObjectStatistics.h
+ * @ingroup memory
+ * @brief Counters of the instances of each PARCObject type.
+ *
+ * When enabled, `parcObject_CreateInstanceImpl` and `parcObject_Release` count, for each type,
+ * the instances created and released and the bytes they occupy.
+ * Types are identified by the name in their `PARCObjectDescriptor`,
+ * and descriptors with the same name are counted together.
+ *
+ * The counters are kept per thread, so that counting does not contend between threads,
+ * and are summed when a snapshot is taken (see `parcObjectStatistics_ToJSON`).
+ * A running process can report its snapshot periodically to a `PARCLog` (see `parcObjectStatistics_StartLogging`).
+ *
+ * Counting is disabled by default. Because it counts only the instances created and released while it is enabled,
+ * it should be enabled when the process starts.
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ObjectStatistics_h
+#define libparc_parc_ObjectStatistics_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_JSON.h>
+#include <parc/logging/parc_Log.h>
+
+/**
+ * The maximum number of distinct type names that are counted.
+ * Instances of types beyond this number are not counted.
+ */
+#define PARCObjectStatistics_MaxTypes 256
+
+/**
+ * The counters for one type.
+ */
+typedef struct parc_object_type_statistics {
+    uint64_t live;          // Instances created and not yet released.
+    uint64_t created;       // Instances created.
+    uint64_t liveBytes;     // Bytes occupied by the live instances, including their headers.
+    uint64_t createdBytes;  // Bytes occupied by the created instances, including their headers.
+} PARCObjectTypeStatistics;
+
+/**
+ * Enable, or disable, counting.
+ *
+ * Disabling counting deallocates the calling thread's counters, after adding them to the totals.
+ *
+ * @param [in] enabled `true` to enable counting, `false` to disable it.
+ *
+ * @return The previous setting.
+ *
+ * Example:
+ * @code
+ * int
+ * main(int argc, char *argv[])
+ * {
+ *     parcObjectStatistics_SetEnabled(true);
+ *     ...
+ * }
+ * @endcode
+ */
+bool parcObjectStatistics_SetEnabled(bool enabled);
+
+/**
+ * Determine if counting is enabled.
+ *
+ * @return true Counting is enabled.
+ * @return false Counting is disabled.
+ */
+bool parcObjectStatistics_IsEnabled(void);
+
+/**
+ * Count the creation of an instance of the type described by @p descriptor.
+ *
+ * This is used by `parcObject_CreateInstanceImpl` and is not intended to be called otherwise.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor`.
+ * @param [in] length The number of bytes occupied by the instance, including its header.
+ */
+void parcObjectStatistics_CountCreate(const PARCObjectDescriptor *descriptor, size_t length);
+
+/**
+ * Count the release of the last reference to an instance of the type described by @p descriptor.
+ *
+ * This is used by `parcObject_Release` and is not intended to be called otherwise.
+ *
+ * @param [in] descriptor A pointer to a valid `PARCObjectDescriptor`.
+ * @param [in] length The number of bytes occupied by the instance, including its header.
+ */
+void parcObjectStatistics_CountRelease(const PARCObjectDescriptor *descriptor, size_t length);
+
+/**
+ * Forget the cached type of @p descriptor, so that a descriptor later allocated at the same address
+ * is counted under its own name.
+ *
+ * This is used by `parcObjectDescriptor_Destroy` and is not intended to be called otherwise.
+ *
+ * @param [in] descriptor A pointer to a `PARCObjectDescriptor` that is about to be destroyed.
+ */
+void parcObjectStatistics_ForgetDescriptor(const PARCObjectDescriptor *descriptor);
+
+/**
+ * Get a snapshot of the counters of the type with the given name.
+ *
+ * @param [in] name The name of a type, as given in its `PARCObjectDescriptor`.
+ * @param [out] statistics A pointer to the `PARCObjectTypeStatistics` to fill in.
+ *
+ * @return true The type has been counted, and @p statistics is filled in.
+ * @return false No instance of the type has been counted.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCObjectTypeStatistics statistics;
+ *     if (parcObjectStatistics_Get("PARCBuffer", &statistics)) {
+ *         printf("%" PRIu64 " live PARCBuffer instances\n", statistics.live);
+ *     }
+ * }
+ * @endcode
+ */
+bool parcObjectStatistics_Get(const char *name, PARCObjectTypeStatistics *statistics);
+
+/**
+ * Create a PARCJSON report of a snapshot of the counters of every type that has been counted.
+ *
+ * The report is an object with a member for each type name, whose value is an object
+ * with the members "live", "created", "liveBytes", and "createdBytes".
+ *
+ * @return A pointer to a `PARCJSON` instance that must be released via `parcJSON_Release`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCJSON *report = parcObjectStatistics_ToJSON();
+ *     char *string = parcJSON_ToString(report);
+ *     printf("%s\n", string);
+ *     parcMemory_Deallocate(&string);
+ *     parcJSON_Release(&report);
+ * }
+ * @endcode
+ */
+PARCJSON *parcObjectStatistics_ToJSON(void);
+
+/**
+ * Report a snapshot of the counters to the given `PARCLog` as an informational message.
+ *
+ * @param [in] log A pointer to a valid `PARCLog` instance.
+ *
+ * @return true The message was logged.
+ * @return false The message was not logged, for example because the log's level excludes it.
+ */
+bool parcObjectStatistics_Log(PARCLog *log);
+
+/**
+ * Start a background thread that reports a snapshot of the counters to the given `PARCLog`
+ * every @p intervalSeconds.
+ *
+ * The thread holds a reference to the log until it is stopped.
+ *
+ * @param [in] log A pointer to a valid `PARCLog` instance.
+ * @param [in] intervalSeconds The interval between reports.
+ *
+ * @return true The thread was started.
+ * @return false The thread is already running, or could not be started.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcObjectStatistics_SetEnabled(true);
+ *     parcObjectStatistics_StartLogging(log, 60);
+ *     ...
+ *     parcObjectStatistics_StopLogging();
+ * }
+ * @endcode
+ */
+bool parcObjectStatistics_StartLogging(PARCLog *log, unsigned int intervalSeconds);
+
+/**
+ * Stop the background thread started by `parcObjectStatistics_StartLogging`, and wait for it to exit.
+ *
+ * @return true The thread was stopped.
+ * @return false The thread was not running.
+ */
+bool parcObjectStatistics_StopLogging(void);
+#endif // libparc_parc_ObjectStatistics_h
@@ -69,6 +69,22 @@ parcOutputStream_Write(PARCOutputStream *stream, PARCBuffer *buffer)
     return (stream->interface->Write)(stream->instance, buffer);
 }
 
+bool
+parcOutputStream_WriteVector(PARCOutputStream *stream, size_t count, PARCBuffer *buffers[count])
+{
+    if (stream->interface->WriteVector != NULL) {
+        return (stream->interface->WriteVector)(stream->instance, count, buffers);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        (stream->interface->Write)(stream->instance, buffers[i]);
+        if (parcBuffer_HasRemaining(buffers[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 size_t
 parcOutputStream_WriteCStrings(PARCOutputStream *stream, ...)
 {
@@ -81,6 +97,8 @@ parcOutputStream_WriteCStrings(PARCOutputStream *stream, ...)
         result += parcOutputStream_WriteCString(stream, string);
     }
 
+    va_end(ap);
+
     return result;
 }
 
@@ -49,6 +49,13 @@ typedef struct parc_output_stream_interface {
     PARCOutputStream *(*Acquire)(PARCOutputStream * stream);
 
     void (*Release)(PARCOutputStream **streamPtr);
+
+    /**
+     * Optional, and last so that existing implementations keep their layout.
+     * Write the remaining contents of several buffers in one gather operation.
+     * If NULL, `parcOutputStream_WriteVector` falls back to one `Write` per buffer.
+     */
+    bool (*WriteVector)(PARCOutputStream *stream, size_t count, PARCBuffer *buffers[count]);
 } PARCOutputStreamInterface;
 
 /**
@@ -97,6 +104,35 @@ PARCOutputStream *parcOutputStream_Create(void *instance, const PARCOutputStream
  */
 size_t parcOutputStream_Write(PARCOutputStream *stream, PARCBuffer *buffer);
 
+/**
+ * Write the contents of several `PARCBuffer` instances, in order, to the output stream.
+ *
+ * Each buffer contributes the bytes from its position to its limit.
+ * Implementations that support gather writes (for example `PARCFileOutputStream`) emit the buffers
+ * with as few system calls as possible, so a header, payload and trailer kept in separate buffers
+ * need not be copied into one buffer first.
+ * Otherwise each buffer is written in turn with `parcOutputStream_Write`.
+ *
+ * When this function returns, the position of each buffer is set to the end of its last successfully written byte.
+ *
+ * @param [in] stream A pointer to a valid `PARCOutputStream` instance.
+ * @param [in] count The number of elements in @p buffers.
+ * @param [in] buffers An array of pointers to valid `PARCBuffer` instances.
+ *
+ * @return true The remaining contents of every buffer were written.
+ * @return false The remaining contents of one or more buffers were not written.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffers[3] = { header, payload, trailer };
+ *
+ *     parcOutputStream_WriteVector(output, 3, buffers);
+ * }
+ * @endcode
+ */
+bool parcOutputStream_WriteVector(PARCOutputStream *stream, size_t count, PARCBuffer *buffers[count]);
+
 /**
  * Write a nul-terminated C string to the given `PARCOutputStream`.
  *
@@ -0,0 +1,678 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__APPLE__) || defined(__linux)
+#  include <execinfo.h>
+#else
+#  define backtrace(...) (0)
+#  define backtrace_symbols(...) NULL
+#endif
+
+#include <parc/algol/parc_ProfilingMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#define _parcProfilingMemory_MaximumFrames 32
+
+// The frames of the profiler itself at the top of each recorded call stack:
+// _parcProfilingMemory_RecordSample, _parcProfilingMemory_AllocateAligned and the provider's public function.
+#define _parcProfilingMemory_ProfilerFrames 3
+
+/**
+ * The statistics of one distinct call stack.
+ * Sites are never freed, so a sampled allocation can refer to its site for as long as it lives.
+ */
+typedef struct parc_profiling_memory_site {
+    struct parc_profiling_memory_site *next;    // The next site in the same hash bucket.
+    uint64_t hash;
+    int frameCount;
+    void *frames[_parcProfilingMemory_MaximumFrames];
+
+    uint64_t allocations;           // The number of sampled allocations made from this call stack.
+    uint64_t allocatedBytes;        // The number of bytes requested by those allocations.
+    uint64_t frees;                 // The number of those allocations that were deallocated.
+    uint64_t freedBytes;            // The number of bytes of those allocations that were deallocated.
+} _PARCProfilingMemorySite;
+
+#define _parcProfilingMemory_Buckets 4096
+
+static _PARCProfilingMemorySite *_parcProfilingMemory_Sites[_parcProfilingMemory_Buckets];
+static pthread_mutex_t _parcProfilingMemory_SitesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Every allocation is preceded by this prefix.
+ */
+typedef struct {
+    _PARCProfilingMemorySite *site;     // The site of a sampled allocation, or NULL.
+    size_t length;                      // The number of bytes the caller requested.
+    size_t prefixLength;                // The number of bytes from the origin of the allocation to the caller's memory.
+    uint64_t tag;                       // _parcProfilingMemory_Tag.
+} _PARCProfilingMemoryPrefix;
+
+static const uint64_t _parcProfilingMemory_Tag = 0x9F0F11E9F0F11E00ULL;
+
+#define _parcProfilingMemory_DefaultAlignment 16
+
+static PARCMemoryInterface *_parcMemory = &PARCStdlibMemoryAsPARCMemory;
+
+static size_t _parcProfilingMemory_SampleInterval = parcProfilingMemory_DefaultSampleInterval;
+
+typedef struct {
+    int64_t bytesUntilSample;
+    size_t interval;                    // The interval from which bytesUntilSample was drawn.
+    uint64_t random;
+} _PARCProfilingMemorySampling;
+
+static pthread_once_t _parcProfilingMemory_Once = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcProfilingMemory_SamplingKey;
+
+static void
+_parcProfilingMemory_InitOnce(void)
+{
+    pthread_key_create(&_parcProfilingMemory_SamplingKey, free);
+}
+
+static int64_t
+_parcProfilingMemory_NextSampleDistance(_PARCProfilingMemorySampling *sampling)
+{
+    // xorshift64*, which is plenty for choosing samples.
+    sampling->random ^= sampling->random >> 12;
+    sampling->random ^= sampling->random << 25;
+    sampling->random ^= sampling->random >> 27;
+    uint64_t random = sampling->random * 0x2545F4914F6CDD1DULL;
+
+    // An exponentially distributed distance with a mean of the interval, from a uniform value in (0, 1].
+    double uniform = ((random >> 11) + 1) * (1.0 / 9007199254740992.0);
+    return (int64_t) (-log(uniform) * sampling->interval) + 1;
+}
+
+static bool
+_parcProfilingMemory_IsSampled(size_t length)
+{
+    pthread_once(&_parcProfilingMemory_Once, _parcProfilingMemory_InitOnce);
+
+    _PARCProfilingMemorySampling *sampling = pthread_getspecific(_parcProfilingMemory_SamplingKey);
+    if (sampling == NULL) {
+        sampling = malloc(sizeof(_PARCProfilingMemorySampling));
+        if (sampling == NULL) {
+            return false;
+        }
+        sampling->random = ((uintptr_t) sampling * 0x9E3779B97F4A7C15ULL) | 1;
+        sampling->interval = 0;
+        pthread_setspecific(_parcProfilingMemory_SamplingKey, sampling);
+    }
+
+    size_t interval = _parcProfilingMemory_SampleInterval;
+    if (sampling->interval != interval) {
+        sampling->interval = interval;
+        sampling->bytesUntilSample = _parcProfilingMemory_NextSampleDistance(sampling);
+    }
+
+    sampling->bytesUntilSample -= (int64_t) length;
+    if (sampling->bytesUntilSample > 0) {
+        return false;
+    }
+    sampling->bytesUntilSample = _parcProfilingMemory_NextSampleDistance(sampling);
+    return true;
+}
+
+size_t
+parcProfilingMemory_SetSampleInterval(size_t bytes)
+{
+    trapIllegalValueIf(bytes == 0, "The sample interval must be greater than 0");
+
+    return __sync_lock_test_and_set(&_parcProfilingMemory_SampleInterval, bytes);
+}
+
+size_t
+parcProfilingMemory_GetSampleInterval(void)
+{
+    return _parcProfilingMemory_SampleInterval;
+}
+
+static uint64_t
+_parcProfilingMemory_Hash(void *const *frames, int frameCount)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i = 0; i < frameCount; i++) {
+        hash = (hash ^ (uintptr_t) frames[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static _PARCProfilingMemorySite *
+_parcProfilingMemory_FindSite(void *const *frames, int frameCount)
+{
+    uint64_t hash = _parcProfilingMemory_Hash(frames, frameCount);
+    _PARCProfilingMemorySite **bucket = &_parcProfilingMemory_Sites[hash % _parcProfilingMemory_Buckets];
+
+    pthread_mutex_lock(&_parcProfilingMemory_SitesMutex);
+
+    _PARCProfilingMemorySite *site = *bucket;
+    while (site != NULL) {
+        if (site->hash == hash && site->frameCount == frameCount
+            && memcmp(site->frames, frames, frameCount * sizeof(void *)) == 0) {
+            break;
+        }
+        site = site->next;
+    }
+
+    if (site == NULL) {
+        site = calloc(1, sizeof(_PARCProfilingMemorySite));
+        if (site != NULL) {
+            site->hash = hash;
+            site->frameCount = frameCount;
+            memcpy(site->frames, frames, frameCount * sizeof(void *));
+            site->next = *bucket;
+            *bucket = site;
+        }
+    }
+
+    pthread_mutex_unlock(&_parcProfilingMemory_SitesMutex);
+    return site;
+}
+
+static __attribute__((noinline)) _PARCProfilingMemorySite *
+_parcProfilingMemory_RecordSample(size_t length)
+{
+    void *frames[_parcProfilingMemory_MaximumFrames + _parcProfilingMemory_ProfilerFrames];
+    int frameCount = backtrace(frames, _parcProfilingMemory_MaximumFrames + _parcProfilingMemory_ProfilerFrames);
+
+    int skip = (frameCount > _parcProfilingMemory_ProfilerFrames) ? _parcProfilingMemory_ProfilerFrames : 0;
+
+    _PARCProfilingMemorySite *site = _parcProfilingMemory_FindSite(&frames[skip], frameCount - skip);
+    if (site != NULL) {
+        __sync_add_and_fetch(&site->allocations, 1);
+        __sync_add_and_fetch(&site->allocatedBytes, length);
+    }
+    return site;
+}
+
+static inline _PARCProfilingMemoryPrefix *
+_prefix(const void *memory)
+{
+    return (_PARCProfilingMemoryPrefix *) &((char *) memory)[-sizeof(_PARCProfilingMemoryPrefix)];
+}
+
+static __attribute__((noinline)) void *
+_parcProfilingMemory_AllocateAligned(size_t alignment, size_t size)
+{
+    if (alignment < _parcProfilingMemory_DefaultAlignment) {
+        alignment = _parcProfilingMemory_DefaultAlignment;
+    }
+    size_t prefixLength = (sizeof(_PARCProfilingMemoryPrefix) + alignment - 1) & ~(alignment - 1);
+    size_t totalLength = prefixLength + size;
+    if (totalLength < size) {
+        return NULL;
+    }
+
+    void *origin = NULL;
+    if (alignment > _parcProfilingMemory_DefaultAlignment) {
+        if (((PARCMemoryMemAlign *) _parcMemory->MemAlign)(&origin, alignment, totalLength) != 0) {
+            origin = NULL;
+        }
+    } else {
+        origin = ((PARCMemoryAllocate *) _parcMemory->Allocate)(totalLength);
+    }
+    if (origin == NULL) {
+        return NULL;
+    }
+
+    void *result = &((char *) origin)[prefixLength];
+    _PARCProfilingMemoryPrefix *prefix = _prefix(result);
+    prefix->site = _parcProfilingMemory_IsSampled(size) ? _parcProfilingMemory_RecordSample(size) : NULL;
+    prefix->length = size;
+    prefix->prefixLength = prefixLength;
+    prefix->tag = _parcProfilingMemory_Tag;
+
+    return result;
+}
+
+static _PARCProfilingMemoryPrefix *
+_parcProfilingMemory_ValidPrefix(const void *memory)
+{
+    _PARCProfilingMemoryPrefix *prefix = _prefix(memory);
+    trapIllegalValueIf(prefix->tag != _parcProfilingMemory_Tag,
+                       "Memory %p was not allocated by PARCProfilingMemory, or was already deallocated", memory);
+    return prefix;
+}
+
+static void
+_parcProfilingMemory_RecordFree(_PARCProfilingMemoryPrefix *prefix)
+{
+    if (prefix->site != NULL) {
+        __sync_add_and_fetch(&prefix->site->frees, 1);
+        __sync_add_and_fetch(&prefix->site->freedBytes, prefix->length);
+    }
+}
+
+void *
+parcProfilingMemory_Allocate(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    return _parcProfilingMemory_AllocateAligned(_parcProfilingMemory_DefaultAlignment, size);
+}
+
+void *
+parcProfilingMemory_AllocateAndClear(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    void *result = _parcProfilingMemory_AllocateAligned(_parcProfilingMemory_DefaultAlignment, size);
+    if (result != NULL) {
+        memset(result, 0, size);
+    }
+    return result;
+}
+
+int
+parcProfilingMemory_MemAlign(void **pointer, size_t alignment, size_t size)
+{
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    if (size == 0) {
+        return EINVAL;
+    }
+
+    *pointer = _parcProfilingMemory_AllocateAligned(alignment, size);
+    return (*pointer == NULL) ? ENOMEM : 0;
+}
+
+void
+parcProfilingMemory_Deallocate(void **pointer)
+{
+    void *memory = *pointer;
+    if (memory == NULL) {
+        return;
+    }
+
+    _PARCProfilingMemoryPrefix *prefix = _parcProfilingMemory_ValidPrefix(memory);
+    _parcProfilingMemory_RecordFree(prefix);
+
+    void *origin = &((char *) memory)[-prefix->prefixLength];
+    prefix->tag = 0;
+    ((PARCMemoryDeallocate *) _parcMemory->Deallocate)(&origin);
+
+    *pointer = NULL;
+}
+
+void *
+parcProfilingMemory_Reallocate(void *pointer, size_t newSize)
+{
+    if (pointer == NULL) {
+        return parcProfilingMemory_Allocate(newSize);
+    }
+
+    _PARCProfilingMemoryPrefix *prefix = _parcProfilingMemory_ValidPrefix(pointer);
+
+    // Memory that was not sampled, and does not become sampled, is resized by the underlying allocator.
+    if (prefix->site == NULL && prefix->prefixLength == sizeof(_PARCProfilingMemoryPrefix)
+        && newSize > 0 && !_parcProfilingMemory_IsSampled(newSize)) {
+        void *origin = ((PARCMemoryReallocate *) _parcMemory->Reallocate)(&((char *) pointer)[-prefix->prefixLength],
+                                                                           prefix->prefixLength + newSize);
+        if (origin == NULL) {
+            return NULL;
+        }
+        void *result = &((char *) origin)[sizeof(_PARCProfilingMemoryPrefix)];
+        _prefix(result)->length = newSize;
+        return result;
+    }
+
+    void *result = _parcProfilingMemory_AllocateAligned(_parcProfilingMemory_DefaultAlignment, (newSize == 0) ? 1 : newSize);
+    if (result != NULL) {
+        memcpy(result, pointer, (prefix->length < newSize) ? prefix->length : newSize);
+        parcProfilingMemory_Deallocate(&pointer);
+    }
+    return result;
+}
+
+char *
+parcProfilingMemory_StringDuplicate(const char *string, size_t length)
+{
+    size_t actualLength = strnlen(string, length);
+
+    char *result = _parcProfilingMemory_AllocateAligned(_parcProfilingMemory_DefaultAlignment, actualLength + 1);
+    if (result != NULL) {
+        memcpy(result, string, actualLength);
+        result[actualLength] = 0;
+    }
+    return result;
+}
+
+size_t
+parcProfilingMemory_UsableSize(const void *pointer)
+{
+    return _prefix(pointer)->length;
+}
+
+uint32_t
+parcProfilingMemory_Outstanding(void)
+{
+    return ((PARCMemoryOutstanding *) _parcMemory->Outstanding)();
+}
+
+/**
+ * The factor by which the sampled counts of a site are multiplied to estimate the counts of all of its allocations,
+ * as pprof computes it from the average size of the sampled allocations.
+ */
+static double
+_parcProfilingMemory_Scale(uint64_t count, uint64_t bytes, size_t interval)
+{
+    if (count == 0 || bytes == 0) {
+        return 1.0;
+    }
+    double average = (double) bytes / (double) count;
+    return 1.0 / (1.0 - exp(-average / (double) interval));
+}
+
+static bool
+_parcProfilingMemory_WriteMappedLibraries(int outputFd)
+{
+    if (dprintf(outputFd, "\nMAPPED_LIBRARIES:\n") < 0) {
+        return false;
+    }
+
+    int maps = open("/proc/self/maps", O_RDONLY);
+    if (maps >= 0) {
+        char buffer[4096];
+        ssize_t length;
+        while ((length = read(maps, buffer, sizeof(buffer))) > 0) {
+            if (write(outputFd, buffer, length) != length) {
+                close(maps);
+                return false;
+            }
+        }
+        close(maps);
+    }
+    return true;
+}
+
+static bool
+_parcProfilingMemory_WritePprof(int outputFd, size_t interval)
+{
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t live = 0;
+    uint64_t liveBytes = 0;
+    for (int i = 0; i < _parcProfilingMemory_Buckets; i++) {
+        for (_PARCProfilingMemorySite *site = _parcProfilingMemory_Sites[i]; site != NULL; site = site->next) {
+            allocations += site->allocations;
+            allocatedBytes += site->allocatedBytes;
+            live += site->allocations - site->frees;
+            liveBytes += site->allocatedBytes - site->freedBytes;
+        }
+    }
+
+    if (dprintf(outputFd, "heap profile: %6" PRIu64 ": %8" PRIu64 " [%6" PRIu64 ": %8" PRIu64 "] @ heap_v2/%zu\n",
+                live, liveBytes, allocations, allocatedBytes, interval) < 0) {
+        return false;
+    }
+
+    for (int i = 0; i < _parcProfilingMemory_Buckets; i++) {
+        for (_PARCProfilingMemorySite *site = _parcProfilingMemory_Sites[i]; site != NULL; site = site->next) {
+            dprintf(outputFd, "%6" PRIu64 ": %8" PRIu64 " [%6" PRIu64 ": %8" PRIu64 "] @",
+                    site->allocations - site->frees, site->allocatedBytes - site->freedBytes,
+                    site->allocations, site->allocatedBytes);
+            for (int f = 0; f < site->frameCount; f++) {
+                dprintf(outputFd, " %p", site->frames[f]);
+            }
+            if (dprintf(outputFd, "\n") < 0) {
+                return false;
+            }
+        }
+    }
+
+    return _parcProfilingMemory_WriteMappedLibraries(outputFd);
+}
+
+/**
+ * Write the name of the function in a line from `backtrace_symbols`, such as "./app(main+0x1d) [0x4005bd]",
+ * or the address of the frame if the line names no function.
+ */
+static void
+_parcProfilingMemory_WriteFrameName(int outputFd, const char *symbol, const void *frame)
+{
+    const char *start = (symbol != NULL) ? strchr(symbol, '(') : NULL;
+    if (start != NULL) {
+        start++;
+        size_t length = strcspn(start, "+)");
+        if (length > 0) {
+            dprintf(outputFd, "%.*s", (int) length, start);
+            return;
+        }
+    }
+    dprintf(outputFd, "%p", frame);
+}
+
+static bool
+_parcProfilingMemory_WriteFlameGraph(int outputFd, size_t interval, bool live)
+{
+    for (int i = 0; i < _parcProfilingMemory_Buckets; i++) {
+        for (_PARCProfilingMemorySite *site = _parcProfilingMemory_Sites[i]; site != NULL; site = site->next) {
+            double scale = _parcProfilingMemory_Scale(site->allocations, site->allocatedBytes, interval);
+            uint64_t bytes = live ? site->allocatedBytes - site->freedBytes : site->allocatedBytes;
+            uint64_t estimate = (uint64_t) (bytes * scale + 0.5);
+            if (estimate == 0) {
+                continue;
+            }
+
+            char **symbols = backtrace_symbols(site->frames, site->frameCount);
+
+            // Folded stacks begin with the outermost frame.
+            for (int f = site->frameCount - 1; f >= 0; f--) {
+                _parcProfilingMemory_WriteFrameName(outputFd, (symbols != NULL) ? symbols[f] : NULL, site->frames[f]);
+                if (f > 0) {
+                    dprintf(outputFd, ";");
+                }
+            }
+            free(symbols);
+
+            if (dprintf(outputFd, " %" PRIu64 "\n", estimate) < 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool
+parcProfilingMemory_WriteProfile(int outputFd, PARCProfilingMemoryFormat format)
+{
+    size_t interval = _parcProfilingMemory_SampleInterval;
+
+    // Holding the lock keeps the list of sites still while it is written; the counts may still change.
+    pthread_mutex_lock(&_parcProfilingMemory_SitesMutex);
+
+    bool result = false;
+    switch (format) {
+        case PARCProfilingMemoryFormat_Pprof:
+            result = _parcProfilingMemory_WritePprof(outputFd, interval);
+            break;
+        case PARCProfilingMemoryFormat_FlameGraphLive:
+            result = _parcProfilingMemory_WriteFlameGraph(outputFd, interval, true);
+            break;
+        case PARCProfilingMemoryFormat_FlameGraphAllocated:
+            result = _parcProfilingMemory_WriteFlameGraph(outputFd, interval, false);
+            break;
+    }
+
+    pthread_mutex_unlock(&_parcProfilingMemory_SitesMutex);
+    return result;
+}
+
+bool
+parcProfilingMemory_WriteProfileToFile(const char *path, PARCProfilingMemoryFormat format)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool result = parcProfilingMemory_WriteProfile(fd, format);
+    if (close(fd) != 0) {
+        result = false;
+    }
+    return result;
+}
+
+static struct {
+    pthread_mutex_t mutex;
+    bool running;
+    int signalNumber;
+    struct sigaction previous;
+    int pipe[2];
+    pthread_t thread;
+    char *pathPrefix;
+    unsigned int sequence;
+} _parcProfilingMemory_SignalDump = { .mutex = PTHREAD_MUTEX_INITIALIZER, .running = false };
+
+// Only wake the writing thread: writing a profile is not safe in a signal handler.
+static void
+_parcProfilingMemory_SignalHandler(int signalNumber)
+{
+    int savedErrno = errno;
+    char command = 'w';
+    if (write(_parcProfilingMemory_SignalDump.pipe[1], &command, 1) < 0) {
+        // Nothing can be done here, and a missed profile is harmless.
+    }
+    errno = savedErrno;
+}
+
+static void *
+_parcProfilingMemory_SignalDumpThread(void *unused)
+{
+    for (;;) {
+        char command;
+        ssize_t length = read(_parcProfilingMemory_SignalDump.pipe[0], &command, 1);
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length != 1 || command == 'q') {
+            break;
+        }
+
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "%s.%d.%04u.heap",
+                 _parcProfilingMemory_SignalDump.pathPrefix, (int) getpid(), _parcProfilingMemory_SignalDump.sequence++);
+        parcProfilingMemory_WriteProfileToFile(path, PARCProfilingMemoryFormat_Pprof);
+    }
+    return NULL;
+}
+
+bool
+parcProfilingMemory_StartSignalDump(int signalNumber, const char *pathPrefix)
+{
+    bool result = false;
+
+    pthread_mutex_lock(&_parcProfilingMemory_SignalDump.mutex);
+    if (!_parcProfilingMemory_SignalDump.running && pipe(_parcProfilingMemory_SignalDump.pipe) == 0) {
+        _parcProfilingMemory_SignalDump.pathPrefix = strdup(pathPrefix);
+        _parcProfilingMemory_SignalDump.sequence = 0;
+        _parcProfilingMemory_SignalDump.signalNumber = signalNumber;
+
+        if (pthread_create(&_parcProfilingMemory_SignalDump.thread, NULL, _parcProfilingMemory_SignalDumpThread, NULL) == 0) {
+            struct sigaction action;
+            memset(&action, 0, sizeof(action));
+            action.sa_handler = _parcProfilingMemory_SignalHandler;
+            action.sa_flags = SA_RESTART;
+            sigemptyset(&action.sa_mask);
+
+            if (sigaction(signalNumber, &action, &_parcProfilingMemory_SignalDump.previous) == 0) {
+                _parcProfilingMemory_SignalDump.running = true;
+                result = true;
+            } else {
+                char command = 'q';
+                if (write(_parcProfilingMemory_SignalDump.pipe[1], &command, 1) == 1) {
+                    pthread_join(_parcProfilingMemory_SignalDump.thread, NULL);
+                }
+            }
+        }
+
+        if (!result) {
+            close(_parcProfilingMemory_SignalDump.pipe[0]);
+            close(_parcProfilingMemory_SignalDump.pipe[1]);
+            free(_parcProfilingMemory_SignalDump.pathPrefix);
+            _parcProfilingMemory_SignalDump.pathPrefix = NULL;
+        }
+    }
+    pthread_mutex_unlock(&_parcProfilingMemory_SignalDump.mutex);
+
+    return result;
+}
+
+void
+parcProfilingMemory_StopSignalDump(void)
+{
+    pthread_mutex_lock(&_parcProfilingMemory_SignalDump.mutex);
+    if (_parcProfilingMemory_SignalDump.running) {
+        sigaction(_parcProfilingMemory_SignalDump.signalNumber, &_parcProfilingMemory_SignalDump.previous, NULL);
+
+        char command = 'q';
+        if (write(_parcProfilingMemory_SignalDump.pipe[1], &command, 1) == 1) {
+            pthread_join(_parcProfilingMemory_SignalDump.thread, NULL);
+        }
+
+        close(_parcProfilingMemory_SignalDump.pipe[0]);
+        close(_parcProfilingMemory_SignalDump.pipe[1]);
+        free(_parcProfilingMemory_SignalDump.pathPrefix);
+        _parcProfilingMemory_SignalDump.pathPrefix = NULL;
+        _parcProfilingMemory_SignalDump.running = false;
+    }
+    pthread_mutex_unlock(&_parcProfilingMemory_SignalDump.mutex);
+}
+
+PARCMemoryInterface PARCProfilingMemoryAsPARCMemory = {
+    .Allocate         = (uintptr_t) parcProfilingMemory_Allocate,
+    .AllocateAndClear = (uintptr_t) parcProfilingMemory_AllocateAndClear,
+    .MemAlign         = (uintptr_t) parcProfilingMemory_MemAlign,
+    .Deallocate       = (uintptr_t) parcProfilingMemory_Deallocate,
+    .Reallocate       = (uintptr_t) parcProfilingMemory_Reallocate,
+    .StringDuplicate  = (uintptr_t) parcProfilingMemory_StringDuplicate,
+    .Outstanding      = (uintptr_t) parcProfilingMemory_Outstanding,
+    .UsableSize       = (uintptr_t) parcProfilingMemory_UsableSize
+};
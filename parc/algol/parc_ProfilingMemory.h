@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_ProfilingMemory.h
+ * @ingroup memory
+ * @brief A PARCMemoryInterface provider that profiles allocations by the call stack that made them.
+ *
+ * Allocations are sampled, the way heap profilers sample: each thread records the call stack of an allocation
+ * each time it has allocated, on average, the sample interval's number of bytes since the last recorded allocation.
+ * For each distinct call stack the profiler counts the sampled allocations and their bytes,
+ * both in total and still live, and the frees of them.
+ * Allocations that are not sampled cost little more than the C library's allocator.
+ *
+ * The profile is written on demand with `parcProfilingMemory_WriteProfile`,
+ * or each time the process receives a signal chosen with `parcProfilingMemory_StartSignalDump`, in one of two formats:
+ *
+ * * `PARCProfilingMemoryFormat_Pprof` is the text heap profile format of gperftools,
+ *   which `pprof` reads and scales up by the sample interval.
+ * * `PARCProfilingMemoryFormat_FlameGraphLive` and `PARCProfilingMemoryFormat_FlameGraphAllocated` are the
+ *   folded stack format that `flamegraph.pl` reads, with the estimated live or total allocated bytes of each call stack.
+ *
+ * @code
+ * {
+ *     parcMemory_SetInterface(&PARCProfilingMemoryAsPARCMemory);
+ *     parcProfilingMemory_StartSignalDump(SIGUSR2, "/tmp/myapp");
+ *     ...
+ *     // kill -USR2 <pid> writes /tmp/myapp.<pid>.0000.heap
+ *     // pprof --text ./myapp /tmp/myapp.<pid>.0000.heap
+ * }
+ * @endcode
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ProfilingMemory_h
+#define libparc_parc_ProfilingMemory_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_Memory.h>
+
+extern PARCMemoryInterface PARCProfilingMemoryAsPARCMemory;
+
+/**
+ * The sample interval, in bytes, until `parcProfilingMemory_SetSampleInterval` is called.
+ */
+#define parcProfilingMemory_DefaultSampleInterval (512 * 1024)
+
+/**
+ * The formats in which a profile is written.
+ */
+typedef enum {
+    PARCProfilingMemoryFormat_Pprof,                // The gperftools text heap profile, read by pprof.
+    PARCProfilingMemoryFormat_FlameGraphLive,       // Folded stacks with their estimated live bytes, read by flamegraph.pl.
+    PARCProfilingMemoryFormat_FlameGraphAllocated   // Folded stacks with their estimated total allocated bytes.
+} PARCProfilingMemoryFormat;
+
+/**
+ * Set the average number of bytes allocated by a thread between allocations that are sampled.
+ *
+ * An interval of 1 samples every allocation.
+ * Changing the interval does not affect memory that is already allocated,
+ * but a profile is scaled by the interval in effect when it is written.
+ *
+ * @param [in] bytes The sample interval in bytes, which must be greater than 0.
+ *
+ * @return The previous sample interval.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcProfilingMemory_SetSampleInterval(128 * 1024);
+ * }
+ * @endcode
+ */
+size_t parcProfilingMemory_SetSampleInterval(size_t bytes);
+
+/**
+ * Get the sample interval set by `parcProfilingMemory_SetSampleInterval`.
+ *
+ * @return The sample interval in bytes.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t interval = parcProfilingMemory_GetSampleInterval();
+ * }
+ * @endcode
+ */
+size_t parcProfilingMemory_GetSampleInterval(void);
+
+/**
+ * Write the profile of the allocations made so far to the file descriptor @p outputFd.
+ *
+ * @param [in] outputFd The file descriptor to write to.
+ * @param [in] format The format of the profile.
+ *
+ * @return true The profile was written.
+ * @return false The profile could not be written.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcProfilingMemory_WriteProfile(STDOUT_FILENO, PARCProfilingMemoryFormat_FlameGraphLive);
+ * }
+ * @endcode
+ */
+bool parcProfilingMemory_WriteProfile(int outputFd, PARCProfilingMemoryFormat format);
+
+/**
+ * Write the profile of the allocations made so far to the file named @p path, replacing it if it exists.
+ *
+ * @param [in] path The name of the file.
+ * @param [in] format The format of the profile.
+ *
+ * @return true The profile was written.
+ * @return false The profile could not be written.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcProfilingMemory_WriteProfileToFile("/tmp/myapp.heap", PARCProfilingMemoryFormat_Pprof);
+ * }
+ * @endcode
+ */
+bool parcProfilingMemory_WriteProfileToFile(const char *path, PARCProfilingMemoryFormat format);
+
+/**
+ * Write a profile in the `PARCProfilingMemoryFormat_Pprof` format each time the process receives the signal @p signalNumber.
+ *
+ * The signal handler only wakes a thread that writes the profile to a new file named
+ * `<pathPrefix>.<pid>.<sequence>.heap`, where the sequence number counts from 0000.
+ * Only one signal may be used at a time.
+ *
+ * @param [in] signalNumber The number of the signal, for example `SIGUSR2`.
+ * @param [in] pathPrefix The beginning of the names of the profile files.
+ *
+ * @return true The signal handler was installed.
+ * @return false A signal is already in use, or the handler or thread could not be created.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcProfilingMemory_StartSignalDump(SIGUSR2, "/tmp/myapp");
+ *     ...
+ *     parcProfilingMemory_StopSignalDump();
+ * }
+ * @endcode
+ */
+bool parcProfilingMemory_StartSignalDump(int signalNumber, const char *pathPrefix);
+
+/**
+ * Restore the signal's previous handler and stop the thread started by `parcProfilingMemory_StartSignalDump`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcProfilingMemory_StopSignalDump();
+ * }
+ * @endcode
+ */
+void parcProfilingMemory_StopSignalDump(void);
+
+/**
+ * Allocate memory, and sample the allocation.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, aligned on 16 bytes, or NULL if @p size is 0 or memory is exhausted.
+ */
+void *parcProfilingMemory_Allocate(size_t size);
+
+/**
+ * Allocate memory of size @p size and clear it.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL if @p size is 0 or memory is exhausted.
+ */
+void *parcProfilingMemory_AllocateAndClear(size_t size);
+
+/**
+ * Allocate aligned memory.
+ *
+ * @param [out] pointer A pointer to a `void *` pointer that will be set to the address of the allocated memory.
+ * @param [in] alignment A power of 2 greater than or equal to `sizeof(void *)`
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return 0 Successful
+ * @return EINVAL The alignment parameter is not a power of 2 at least as large as sizeof(void *), or @p size is 0.
+ * @return ENOMEM Memory allocation error.
+ */
+int parcProfilingMemory_MemAlign(void **pointer, size_t alignment, size_t size);
+
+/**
+ * Deallocate the memory pointed to by @p pointer, and count the free if the allocation was sampled.
+ *
+ * @param [in,out] pointer A pointer to a pointer to the memory to be deallocated, which is set to NULL.
+ */
+void parcProfilingMemory_Deallocate(void **pointer);
+
+/**
+ * Resize previously allocated memory at @p pointer to @p newSize.
+ *
+ * @param [in] pointer A pointer to the memory to be reallocated, or NULL.
+ * @param [in] newSize The size that the memory is to be resized to.
+ *
+ * @return A pointer to the memory.
+ */
+void *parcProfilingMemory_Reallocate(void *pointer, size_t newSize);
+
+/**
+ * Allocate a copy of at most @p length characters of the string @p string.
+ *
+ * @param [in] string A pointer to a null-terminated string.
+ * @param [in] length The maximum allowed length of the resulting copy.
+ *
+ * @return A pointer to the null-terminated copy.
+ */
+char *parcProfilingMemory_StringDuplicate(const char *string, size_t length);
+
+/**
+ * Return the number of bytes requested for the allocation pointed to by @p pointer.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ *
+ * @return The number of bytes requested.
+ */
+size_t parcProfilingMemory_UsableSize(const void *pointer);
+
+/**
+ * Return the number of outstanding allocations managed by this allocator.
+ *
+ * @return The number of memory allocations still outstanding.
+ */
+uint32_t parcProfilingMemory_Outstanding(void);
+#endif // libparc_parc_ProfilingMemory_h
@@ -86,6 +86,7 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdbool.h>
+#include <math.h>
 
 #include <parc/algol/parc_StdlibMemory.h>
 #include <parc/algol/parc_SafeMemory.h>
@@ -111,17 +112,29 @@ typedef struct memory_prefix {
     size_t actualLength;          // The number of bytes >= requestedLength to ensure the right alignment for the suffix.
     size_t alignment;             // The aligment required by the caller.  Must be a power of 2 and >= sizeof(void *).
     _MemoryBacktrace *backtrace;  // A record of the caller's stack trace at the time of allocation.
+    size_t sampleInterval;        // The sample interval when this allocation was sampled, or 0 if every allocation was tracked.
+    LIST_ENTRY(memory_prefix) entries; // The allocation's place in the list of its shard of all allocations.
     uint64_t guard;               // Try to detect underrun of the allocated memory.
 } _MemoryPrefix;
 
+// Allocations that are not sampled carry only this prefix, and no suffix, backtrace or record.
+// Its guard is in the same place, relative to the memory usable by the caller, as the guard of a _MemoryPrefix.
+static const uint64_t _parcSafeMemory_UntrackedGuard = 0x5afe5afe5afe5afeULL;
+typedef struct memory_untracked_prefix {
+    size_t requestedLength;       // The number of bytes the caller requested.
+    size_t prefixLength;          // The number of bytes from the origin of the allocation to the memory usable by the caller.
+    size_t reserved;              // Keeps the usable memory aligned on 16 bytes for the default alignment.
+    uint64_t guard;               // _parcSafeMemory_UntrackedGuard, or _parcSafeMemory_GuardAlreadyFreed.
+} _MemoryUntrackedPrefix;
+
+#define _parcSafeMemory_BacktraceDepth 20
+
 typedef void *PARCSafeMemoryOrigin;
 
 typedef void *PARCSafeMemoryUsable;
 
 static PARCMemoryInterface *_parcMemory = &PARCStdlibMemoryAsPARCMemory;
 
-static pthread_mutex_t _parcSafeMemory_Mutex = PTHREAD_MUTEX_INITIALIZER;
-
 
 /**
  * Return true if the given alignment value is greater than or equal to {@code sizeof(void *)} and
@@ -275,53 +288,227 @@ _backtraceReport(const _MemoryBacktrace *backtrace, int outputFd)
     }
 }
 
-// This is a list of all memory allocations that were created by calls to Safe Memory.
-// Each element of the list is the pointer to the result returned to the caller of the memory allocation,
-// not a pointer to the base.
-struct safememory_entry {
-    LIST_ENTRY(safememory_entry) entries;      // List
-    void *memory;
+// All of the memory allocations that were created by calls to Safe Memory are kept in lists of their prefixes,
+// so that adding and removing an allocation takes constant time.
+// The allocations are spread over shards by their address, each with its own lock,
+// so that threads allocating and deallocating at the same time seldom contend.
+#define _parcSafeMemory_Shards 64
+
+typedef struct {
+    pthread_mutex_t mutex;
+    LIST_HEAD(, memory_prefix) head;
+} _MemoryShard;
+
+static _MemoryShard _parcSafeMemory_Allocations[_parcSafeMemory_Shards] = {
+    [0 ... _parcSafeMemory_Shards - 1] = { .mutex = PTHREAD_MUTEX_INITIALIZER, .head = LIST_HEAD_INITIALIZER(head) }
 };
-LIST_HEAD(, safememory_entry) head = LIST_HEAD_INITIALIZER(head);
-static pthread_mutex_t head_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static _MemoryShard *
+_parcSafeMemory_Shard(const void *memory)
+{
+    uintptr_t hash = ((uintptr_t) memory >> 4) * 0x9E3779B97F4A7C15ULL;
+    return &_parcSafeMemory_Allocations[(hash >> 32) % _parcSafeMemory_Shards];
+}
 
 static void
 _parcSafeMemory_AddAllocation(void *memory)
 {
-    if (parcSafeMemory_Outstanding() == 0) {
-        LIST_INIT(&head); // Initialize the list.
+    _MemoryShard *shard = _parcSafeMemory_Shard(memory);
+    _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(memory);
+
+    pthread_mutex_lock(&shard->mutex);
+    LIST_INSERT_HEAD(&shard->head, prefix, entries);
+    pthread_mutex_unlock(&shard->mutex);
+}
+
+static void
+_parcSafeMemory_RemoveAllocation(void *memory)
+{
+    // Only memory with an intact prefix can be in a list.
+    if (_parcSafeMemory_GetPrefixState(memory) != PARCSafeMemoryState_OK) {
+        fprintf(stderr, "parcSafeMemory_RemoveAllocation: Destroying memory (%p) which is NOT in the allocated memory record. Double free?\n", memory);
+        return;
     }
 
-    struct safememory_entry *e = malloc(sizeof(struct safememory_entry)); // Insert this at the head.
-    e->memory = memory;
+    _MemoryShard *shard = _parcSafeMemory_Shard(memory);
+    _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(memory);
 
-    pthread_mutex_lock(&head_mutex);
-    LIST_INSERT_HEAD(&head, e, entries);
-    pthread_mutex_unlock(&head_mutex);
+    pthread_mutex_lock(&shard->mutex);
+    LIST_REMOVE(prefix, entries);
+    pthread_mutex_unlock(&shard->mutex);
 }
 
+/**
+ * Given a _MemoryPrefix structure, return the safe memory address.
+ */
+static PARCSafeMemoryUsable *
+_parcSafeMemory_PrefixToUsable(const _MemoryPrefix *prefix)
+{
+    return _pointerAdd(prefix, sizeof(_MemoryPrefix));
+}
+
+// The sampling of allocations.
+// With a sample interval of 0, every allocation is tracked.
+// Otherwise an allocation is tracked each time the calling thread has allocated, on average,
+// the sample interval's number of bytes since the last tracked allocation.
+// The distance to the next sample is drawn from an exponential distribution,
+// so that the chance of an allocation being sampled is proportional to its size.
+static size_t _parcSafeMemory_SampleInterval = 0;
+
+typedef struct {
+    int64_t bytesUntilSample;
+    size_t interval;              // The interval from which bytesUntilSample was drawn.
+    uint64_t random;
+} _SamplingState;
+
+static pthread_once_t _parcSafeMemory_SamplingOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcSafeMemory_SamplingKey;
+
 static void
-_parcSafeMemory_RemoveAllocation(void *memory)
+_parcSafeMemory_SamplingInitOnce(void)
+{
+    pthread_key_create(&_parcSafeMemory_SamplingKey, free);
+}
+
+static int64_t
+_parcSafeMemory_NextSampleDistance(_SamplingState *state, size_t interval)
+{
+    // xorshift64*, which is plenty for choosing samples.
+    state->random ^= state->random >> 12;
+    state->random ^= state->random << 25;
+    state->random ^= state->random >> 27;
+    uint64_t random = state->random * 0x2545F4914F6CDD1DULL;
+
+    // A uniform value in (0, 1], from the top 53 bits.
+    double uniform = ((random >> 11) + 1) * (1.0 / 9007199254740992.0);
+    return (int64_t) (-log(uniform) * interval) + 1;
+}
+
+static bool
+_parcSafeMemory_IsSampled(size_t requestedLength, size_t interval)
+{
+    if (interval == 0) {
+        return true;
+    }
+
+    // parcSafeMemory_SetSampleInterval created the key before setting a non-zero interval.
+    _SamplingState *state = pthread_getspecific(_parcSafeMemory_SamplingKey);
+    if (state == NULL) {
+        state = malloc(sizeof(_SamplingState));
+        if (state == NULL) {
+            // Without the sampling state, err on the side of tracking the allocation.
+            return true;
+        }
+        state->random = ((uintptr_t) state * 0x9E3779B97F4A7C15ULL) | 1;
+        state->interval = 0;
+        pthread_setspecific(_parcSafeMemory_SamplingKey, state);
+    }
+    if (state->interval != interval) {
+        state->interval = interval;
+        state->bytesUntilSample = _parcSafeMemory_NextSampleDistance(state, interval);
+    }
+
+    state->bytesUntilSample -= (int64_t) requestedLength;
+    if (state->bytesUntilSample > 0) {
+        return false;
+    }
+    state->bytesUntilSample = _parcSafeMemory_NextSampleDistance(state, interval);
+    return true;
+}
+
+size_t
+parcSafeMemory_SetSampleInterval(size_t bytes)
+{
+    pthread_once(&_parcSafeMemory_SamplingOnce, _parcSafeMemory_SamplingInitOnce);
+
+    return __sync_lock_test_and_set(&_parcSafeMemory_SampleInterval, bytes);
+}
+
+size_t
+parcSafeMemory_GetSampleInterval(void)
+{
+    return _parcSafeMemory_SampleInterval;
+}
+
+static _MemoryUntrackedPrefix *
+_parcSafeMemory_GetUntrackedPrefix(const PARCSafeMemoryUsable *usable)
+{
+    return _pointerAdd(usable, -sizeof(_MemoryUntrackedPrefix));
+}
+
+static bool
+_parcSafeMemory_IsUntracked(const PARCSafeMemoryUsable *usable)
 {
-    struct safememory_entry *e;
-    pthread_mutex_lock(&head_mutex);
-    LIST_FOREACH(e, &head, entries)
-    {
-        if (e->memory == memory) {
-            LIST_REMOVE(e, entries);
-            free(e);
-            pthread_mutex_unlock(&head_mutex);
-            return;
+    return _parcSafeMemory_GetUntrackedPrefix(usable)->guard == _parcSafeMemory_UntrackedGuard;
+}
+
+static size_t
+_computeUntrackedPrefixLength(const size_t alignment)
+{
+    return (sizeof(_MemoryUntrackedPrefix) + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * Allocate memory that is not tracked, using the underlying allocator's `MemAlign` if @p alignment is larger than a pointer.
+ */
+static PARCSafeMemoryUsable *
+_parcSafeMemory_AllocateUntracked(size_t requestedLength, size_t alignment)
+{
+    size_t prefixLength = _computeUntrackedPrefixLength(alignment);
+    size_t totalLength = prefixLength + requestedLength;
+    if (totalLength < requestedLength) {
+        return NULL;
+    }
+
+    void *base = NULL;
+    if (alignment > sizeof(void *)) {
+        if (((PARCMemoryMemAlign *) _parcMemory->MemAlign)(&base, alignment, totalLength) != 0) {
+            base = NULL;
         }
+    } else {
+        base = ((PARCMemoryAllocate *) _parcMemory->Allocate)(totalLength);
     }
+    if (base == NULL) {
+        return NULL;
+    }
+
+    PARCSafeMemoryUsable *result = _pointerAdd(base, prefixLength);
+    _MemoryUntrackedPrefix *prefix = _parcSafeMemory_GetUntrackedPrefix(result);
+    prefix->requestedLength = requestedLength;
+    prefix->prefixLength = prefixLength;
+    prefix->reserved = 0;
+    prefix->guard = _parcSafeMemory_UntrackedGuard;
+
+    return result;
+}
 
-    pthread_mutex_unlock(&head_mutex);
-    fprintf(stderr, "parcSafeMemory_RemoveAllocation: Destroying memory (%p) which is NOT in the allocated memory record. Double free?\n", memory);
+static void
+_parcSafeMemory_DeallocateUntracked(PARCSafeMemoryUsable *usable)
+{
+    _MemoryUntrackedPrefix *prefix = _parcSafeMemory_GetUntrackedPrefix(usable);
+    void *base = _pointerAdd(usable, -prefix->prefixLength);
+
+    prefix->guard = _parcSafeMemory_GuardAlreadyFreed;
+
+    ((PARCMemoryDeallocate *) _parcMemory->Deallocate)(&base);
+}
+
+static size_t
+_parcSafeMemory_GetRequestedLength(const PARCSafeMemoryUsable *usable)
+{
+    if (_parcSafeMemory_IsUntracked(usable)) {
+        return _parcSafeMemory_GetUntrackedPrefix(usable)->requestedLength;
+    }
+    return _parcSafeMemory_GetPrefix(usable)->requestedLength;
 }
 
 static PARCSafeMemoryState
 _parcSafeMemory_GetState(const PARCSafeMemoryUsable *memory)
 {
+    if (_parcSafeMemory_IsUntracked(memory)) {
+        return PARCSafeMemoryState_OK;
+    }
+
     PARCSafeMemoryState prefixState = _parcSafeMemory_GetPrefixState(memory);
     if (prefixState != PARCSafeMemoryState_OK) {
         return prefixState;
@@ -362,27 +549,182 @@ uint32_t
 parcSafeMemory_ReportAllocation(int outputFd)
 {
     uint32_t index = 0;
-    struct safememory_entry *e;
-
-    pthread_mutex_lock(&head_mutex);
-    LIST_FOREACH(e, &head, entries)
-    {
-        _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(e->memory);
-        if (outputFd != -1) {
-            int charactersPrinted = dprintf(outputFd,
-                                            "\n%u SafeMemory@%p: %p={ .requestedLength=%zd, .actualLength=%zd, .alignment=%zd }\n",
-                                            index, e->memory, (void *) prefix, prefix->requestedLength, prefix->actualLength, prefix->alignment);
-            trapUnexpectedStateIf(charactersPrinted < 0, "Cannot write to file descriptor %d", outputFd) {
-                pthread_mutex_unlock(&head_mutex);
+
+    for (int i = 0; i < _parcSafeMemory_Shards; i++) {
+        _MemoryShard *shard = &_parcSafeMemory_Allocations[i];
+        _MemoryPrefix *prefix;
+
+        pthread_mutex_lock(&shard->mutex);
+        LIST_FOREACH(prefix, &shard->head, entries)
+        {
+            PARCSafeMemoryUsable *memory = _parcSafeMemory_PrefixToUsable(prefix);
+            if (outputFd != -1) {
+                int charactersPrinted = dprintf(outputFd,
+                                                "\n%u SafeMemory@%p: %p={ .requestedLength=%zd, .actualLength=%zd, .alignment=%zd }\n",
+                                                index, (void *) memory, (void *) prefix, prefix->requestedLength, prefix->actualLength, prefix->alignment);
+                trapUnexpectedStateIf(charactersPrinted < 0, "Cannot write to file descriptor %d", outputFd) {
+                    pthread_mutex_unlock(&shard->mutex);
+                }
             }
+            _parcSafeMemory_Report(memory, outputFd);
+            index++;
         }
-        _parcSafeMemory_Report(e->memory, outputFd);
-        index++;
+        pthread_mutex_unlock(&shard->mutex);
     }
-    pthread_mutex_unlock(&head_mutex);
     return parcSafeMemory_Outstanding();
 }
 
+// One call stack in a profile of the live, tracked allocations.
+typedef struct {
+    void *callstack[_parcSafeMemory_BacktraceDepth];
+    int frameCount;
+    size_t allocations;           // The number of tracked allocations made from the call stack.
+    size_t bytes;                 // The number of bytes requested by those allocations.
+    double estimatedAllocations;  // The estimated number of all allocations made from the call stack, tracked or not.
+    double estimatedBytes;        // The estimated number of bytes requested by those allocations.
+} _ProfileEntry;
+
+typedef struct {
+    _ProfileEntry *entries;
+    size_t count;
+    size_t capacity;
+} _Profile;
+
+static int
+_profileEntry_CompareCallstack(const void *a, const void *b)
+{
+    const _ProfileEntry *x = a;
+    const _ProfileEntry *y = b;
+    if (x->frameCount != y->frameCount) {
+        return (x->frameCount < y->frameCount) ? -1 : 1;
+    }
+    return memcmp(x->callstack, y->callstack, x->frameCount * sizeof(void *));
+}
+
+static int
+_profileEntry_CompareEstimatedBytes(const void *a, const void *b)
+{
+    const _ProfileEntry *x = a;
+    const _ProfileEntry *y = b;
+    if (x->estimatedBytes != y->estimatedBytes) {
+        return (x->estimatedBytes > y->estimatedBytes) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Collect the live, tracked allocations into @p profile, one entry per distinct call stack,
+ * in descending order of estimated bytes.
+ *
+ * A sampled allocation of `n` bytes, sampled at an interval of `i` bytes, stands for `1 / (1 - exp(-n / i))` allocations.
+ */
+static void
+_parcSafeMemory_CollectProfile(_Profile *profile)
+{
+    profile->entries = NULL;
+    profile->count = 0;
+    profile->capacity = 0;
+
+    for (int i = 0; i < _parcSafeMemory_Shards; i++) {
+        _MemoryShard *shard = &_parcSafeMemory_Allocations[i];
+        _MemoryPrefix *prefix;
+
+        pthread_mutex_lock(&shard->mutex);
+        LIST_FOREACH(prefix, &shard->head, entries)
+        {
+            if (profile->count == profile->capacity) {
+                profile->capacity = (profile->capacity == 0) ? 64 : profile->capacity * 2;
+                profile->entries = realloc(profile->entries, profile->capacity * sizeof(_ProfileEntry));
+                trapOutOfMemoryIf(profile->entries == NULL, "Cannot allocate a heap profile") {
+                    pthread_mutex_unlock(&shard->mutex);
+                }
+            }
+            _ProfileEntry *entry = &profile->entries[profile->count++];
+
+            entry->frameCount = prefix->backtrace->actualFrameCount;
+            if (entry->frameCount > _parcSafeMemory_BacktraceDepth) {
+                entry->frameCount = _parcSafeMemory_BacktraceDepth;
+            }
+            memcpy(entry->callstack, prefix->backtrace->callstack, entry->frameCount * sizeof(void *));
+
+            double weight = 1.0;
+            if (prefix->sampleInterval != 0) {
+                weight = 1.0 / (1.0 - exp(-(double) prefix->requestedLength / (double) prefix->sampleInterval));
+            }
+            entry->allocations = 1;
+            entry->bytes = prefix->requestedLength;
+            entry->estimatedAllocations = weight;
+            entry->estimatedBytes = weight * prefix->requestedLength;
+        }
+        pthread_mutex_unlock(&shard->mutex);
+    }
+
+    if (profile->count == 0) {
+        return;
+    }
+
+    // Merge the entries with the same call stack.
+    qsort(profile->entries, profile->count, sizeof(_ProfileEntry), _profileEntry_CompareCallstack);
+    size_t merged = 0;
+    for (size_t i = 1; i < profile->count; i++) {
+        _ProfileEntry *last = &profile->entries[merged];
+        _ProfileEntry *entry = &profile->entries[i];
+        if (_profileEntry_CompareCallstack(last, entry) == 0) {
+            last->allocations += entry->allocations;
+            last->bytes += entry->bytes;
+            last->estimatedAllocations += entry->estimatedAllocations;
+            last->estimatedBytes += entry->estimatedBytes;
+        } else {
+            profile->entries[++merged] = *entry;
+        }
+    }
+    profile->count = merged + 1;
+
+    qsort(profile->entries, profile->count, sizeof(_ProfileEntry), _profileEntry_CompareEstimatedBytes);
+}
+
+uint32_t
+parcSafeMemory_ReportProfile(int outputFd)
+{
+    _Profile profile;
+    _parcSafeMemory_CollectProfile(&profile);
+
+    size_t allocations = 0;
+    size_t bytes = 0;
+    double estimatedAllocations = 0;
+    double estimatedBytes = 0;
+    for (size_t i = 0; i < profile.count; i++) {
+        allocations += profile.entries[i].allocations;
+        bytes += profile.entries[i].bytes;
+        estimatedAllocations += profile.entries[i].estimatedAllocations;
+        estimatedBytes += profile.entries[i].estimatedBytes;
+    }
+
+    if (outputFd != -1) {
+        int charactersPrinted = dprintf(outputFd,
+                                        "SafeMemory heap profile: %zd call stacks, %zd tracked allocations of %zd bytes, "
+                                        "estimated %.0f allocations of %.0f bytes (sample interval %zd)\n",
+                                        profile.count, allocations, bytes, estimatedAllocations, estimatedBytes,
+                                        _parcSafeMemory_SampleInterval);
+        trapUnexpectedStateIf(charactersPrinted < 0, "Cannot write to file descriptor %d", outputFd) {
+            free(profile.entries);
+        }
+
+        for (size_t i = 0; i < profile.count; i++) {
+            _ProfileEntry *entry = &profile.entries[i];
+            dprintf(outputFd, "\n%.0f bytes in %.0f allocations (tracked %zd allocations of %zd bytes)\n",
+                    entry->estimatedBytes, entry->estimatedAllocations, entry->allocations, entry->bytes);
+            // Ignore the first entry as it points to _backtraceCreate.
+            if (entry->frameCount > 1) {
+                backtrace_symbols_fd(&entry->callstack[1], entry->frameCount - 1, outputFd);
+            }
+        }
+    }
+
+    free(profile.entries);
+    return (uint32_t) profile.count;
+}
+
 static void
 _backtraceDestroy(_MemoryBacktrace **backtrace)
 {
@@ -394,13 +736,16 @@ _backtraceDestroy(_MemoryBacktrace **backtrace)
 static PARCSafeMemoryState
 _parcSafeMemory_Destroy(void **memoryPointer)
 {
-    pthread_mutex_lock(&_parcSafeMemory_Mutex);
-
     if (parcSafeMemory_Outstanding() == 0) {
-        pthread_mutex_unlock(&_parcSafeMemory_Mutex);
         return PARCSafeMemoryState_NOTHINGALLOCATED;
     }
 
+    if (_parcSafeMemory_IsUntracked(*memoryPointer)) {
+        _parcSafeMemory_DeallocateUntracked(*memoryPointer);
+        *memoryPointer = 0;
+        return PARCSafeMemoryState_OK;
+    }
+
     _parcSafeMemory_RemoveAllocation(*memoryPointer);
 
     PARCSafeMemoryUsable *memory = *memoryPointer;
@@ -408,10 +753,7 @@ _parcSafeMemory_Destroy(void **memoryPointer)
     PARCSafeMemoryState state = _parcSafeMemory_GetState(memory);
     trapUnexpectedStateIf(state != PARCSafeMemoryState_OK,
                           "Expected PARCSafeMemoryState_OK, actual %s (see parc_SafeMemory.h)",
-                          _parcSafeMemory_StateToString(state)) {
-
-        pthread_mutex_unlock(&_parcSafeMemory_Mutex);
-    }
+                          _parcSafeMemory_StateToString(state));
 
     _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(memory);
     _backtraceDestroy(&prefix->backtrace);
@@ -425,7 +767,6 @@ _parcSafeMemory_Destroy(void **memoryPointer)
 
     *memoryPointer = 0;
 
-    pthread_mutex_unlock(&_parcSafeMemory_Mutex);
     return PARCSafeMemoryState_OK;
 }
 
@@ -433,14 +774,18 @@ __attribute__((unused))
 static void
 _parcSafeMemory_DeallocateAll(void)
 {
-    struct safememory_entry *e;
-
-    pthread_mutex_lock(&head_mutex);
-    LIST_FOREACH(e, &head, entries)
-    {
-        _parcSafeMemory_Destroy(&e->memory);
+    for (int i = 0; i < _parcSafeMemory_Shards; i++) {
+        _MemoryShard *shard = &_parcSafeMemory_Allocations[i];
+
+        pthread_mutex_lock(&shard->mutex);
+        while (!LIST_EMPTY(&shard->head)) {
+            void *memory = _parcSafeMemory_PrefixToUsable(LIST_FIRST(&shard->head));
+            pthread_mutex_unlock(&shard->mutex);
+            _parcSafeMemory_Destroy(&memory);
+            pthread_mutex_lock(&shard->mutex);
+        }
+        pthread_mutex_unlock(&shard->mutex);
     }
-    pthread_mutex_unlock(&head_mutex);
 }
 
 static _MemoryBacktrace *
@@ -466,8 +811,6 @@ _backtraceCreate(int maximumFrameCount)
 static PARCSafeMemoryUsable *
 _parcSafeMemory_FormatPrefix(PARCSafeMemoryOrigin *origin, size_t requestedLength, size_t alignment)
 {
-    int backTraceDepth = 20;
-
     if (!_alignmentIsValid(alignment)) {
         return NULL;
     }
@@ -475,13 +818,14 @@ _parcSafeMemory_FormatPrefix(PARCSafeMemoryOrigin *origin, size_t requestedLengt
 
     // This abuts the prefix to the user memory, it does not start at the beginning
     // of the aligned prefix region.
-    _MemoryPrefix *prefix = (_MemoryPrefix *) (origin + (prefixSize - sizeof(_MemoryPrefix)));
+    _MemoryPrefix *prefix = (_MemoryPrefix *) _pointerAdd(origin, prefixSize - sizeof(_MemoryPrefix));
 
     prefix->magic = _parcSafeMemory_PrefixMagic;
     prefix->requestedLength = requestedLength;
     prefix->actualLength = _computeUsableMemoryLength(requestedLength, sizeof(void*));
     prefix->alignment = alignment;
-    prefix->backtrace = _backtraceCreate(backTraceDepth);
+    prefix->backtrace = _backtraceCreate(_parcSafeMemory_BacktraceDepth);
+    prefix->sampleInterval = 0;
     prefix->guard = _parcSafeMemory_Guard;
 
     PARCSafeMemoryUsable *result = _pointerAdd(origin, prefixSize);
@@ -521,20 +865,23 @@ parcSafeMemory_MemAlign(void **memptr, size_t alignment, size_t requestedSize)
         return ERANGE;
     }
 
-    pthread_mutex_lock(&_parcSafeMemory_Mutex);
+    size_t interval = _parcSafeMemory_SampleInterval;
+    if (!_parcSafeMemory_IsSampled(requestedSize, interval)) {
+        *memptr = _parcSafeMemory_AllocateUntracked(requestedSize, alignment);
+        return (*memptr == NULL) ? ENOMEM : 0;
+    }
 
     void *base;
     int failure = ((PARCMemoryMemAlign *) _parcMemory->MemAlign)(&base, alignment, totalSize);
 
     if (failure != 0 || base == NULL) {
-        pthread_mutex_unlock(&_parcSafeMemory_Mutex);
         return ENOMEM;
     }
 
     *memptr = _parcSafeMemory_FormatMemory(base, requestedSize, alignment);
+    _parcSafeMemory_GetPrefix(*memptr)->sampleInterval = interval;
 
     _parcSafeMemory_AddAllocation(*memptr);
-    pthread_mutex_unlock(&_parcSafeMemory_Mutex);
 
     return 0;
 }
@@ -548,15 +895,18 @@ parcSafeMemory_Allocate(size_t requestedSize)
         size_t totalSize = _computeMemoryTotalLength(requestedSize, sizeof(void *));
 
         if (totalSize >= requestedSize) {
-            pthread_mutex_lock(&_parcSafeMemory_Mutex);
+            size_t interval = _parcSafeMemory_SampleInterval;
+            if (!_parcSafeMemory_IsSampled(requestedSize, interval)) {
+                return _parcSafeMemory_AllocateUntracked(requestedSize, sizeof(void *));
+            }
 
             void *base = ((PARCMemoryAllocate *) _parcMemory->Allocate)(totalSize);
             if (base != NULL) {
                 result = _parcSafeMemory_FormatMemory(base, requestedSize, sizeof(void *));
+                _parcSafeMemory_GetPrefix(result)->sampleInterval = interval;
 
                 _parcSafeMemory_AddAllocation(result);
             }
-            pthread_mutex_unlock(&_parcSafeMemory_Mutex);
         }
     }
     return result;
@@ -604,10 +954,9 @@ parcSafeMemory_Reallocate(void *original, size_t newSize)
     }
 
     if (result != NULL) {
-        _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(original);
-        size_t originalSize = prefix->requestedLength;
+        size_t originalSize = _parcSafeMemory_GetRequestedLength(original);
 
-        memcpy(result, original, originalSize);
+        memcpy(result, original, (originalSize < newSize) ? originalSize : newSize);
         parcSafeMemory_Deallocate(&original);
     }
     return result;
@@ -635,11 +984,35 @@ parcSafeMemory_Deallocate(void **pointer)
     _parcSafeMemory_Destroy(pointer);
 }
 
+void
+parcSafeMemory_DeallocateSized(void **pointer, size_t size)
+{
+    if (*pointer != NULL) {
+        size_t requestedLength = _parcSafeMemory_GetRequestedLength(*pointer);
+        trapIllegalValueIf(size != requestedLength,
+                           "Memory %p was deallocated with size %zd, but %zd bytes were requested.", *pointer, size, requestedLength);
+    }
+    _parcSafeMemory_Destroy(pointer);
+}
+
+size_t
+parcSafeMemory_UsableSize(const void *pointer)
+{
+    return _parcSafeMemory_GetRequestedLength((const PARCSafeMemoryUsable *) pointer);
+}
+
 void
 parcSafeMemory_Display(const void *memory, int indentation)
 {
     if (memory == NULL) {
         parcDisplayIndented_PrintLine(indentation, "PARCSafeMemory@NULL");
+    } else if (_parcSafeMemory_IsUntracked(memory)) {
+        _MemoryUntrackedPrefix *prefix = _parcSafeMemory_GetUntrackedPrefix(memory);
+
+        parcDisplayIndented_PrintLine(indentation, "PARCSafeMemory@%p {", (void *) memory);
+        parcDisplayIndented_PrintLine(indentation + 1, "untracked requestedLength=%zd", prefix->requestedLength);
+        parcDisplayIndented_PrintMemory(indentation + 1, prefix->requestedLength, memory);
+        parcDisplayIndented_PrintLine(indentation, "}");
     } else {
         _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(memory);
 
@@ -666,5 +1039,7 @@ PARCMemoryInterface PARCSafeMemoryAsPARCMemory = {
     .Deallocate       = (uintptr_t) parcSafeMemory_Deallocate,
     .Reallocate       = (uintptr_t) parcSafeMemory_Reallocate,
     .Outstanding      = (uintptr_t) parcSafeMemory_Outstanding,
-    .StringDuplicate  = (uintptr_t) parcSafeMemory_StringDuplicate
+    .StringDuplicate  = (uintptr_t) parcSafeMemory_StringDuplicate,
+    .DeallocateSized  = (uintptr_t) parcSafeMemory_DeallocateSized,
+    .UsableSize       = (uintptr_t) parcSafeMemory_UsableSize
 };
@@ -49,6 +49,13 @@
  * Where '-' indicates padding, 'P' indicates the prefix data structure, 'm'
  * indicates contiguous memory for use by the caller, and 'S" indicates the suffix data structure.
  *
+ * Tracking every allocation is expensive, so Safe Memory can instead sample allocations
+ * (see {@link parcSafeMemory_SetSampleInterval}).
+ * Allocations that are not sampled have only a small prefix with a guard, which still detects most underruns and double frees,
+ * and are not reported by {@link parcSafeMemory_ReportAllocation}.
+ * {@link parcSafeMemory_ReportProfile} reports the sampled allocations aggregated by the call stack that allocated them,
+ * with an estimate of all of the live memory allocated from each call stack.
+ *
  * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
  * @copyright 2013-2014, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
  */
@@ -195,6 +202,53 @@ int parcSafeMemory_MemAlign(void **pointer, size_t alignment, size_t size);
  */
 void parcSafeMemory_Deallocate(void **pointer);
 
+/**
+ * Deallocate memory previously allocated with {@link parcSafeMemory_Allocate} with exactly @p size bytes.
+ *
+ * The value pointed to by @p pointer will be set to NULL.
+ * This traps if @p size is not the number of bytes requested for the memory,
+ * which catches callers that keep the wrong size for their allocations.
+ *
+ * @param [in,out] pointer A pointer to a pointer to the allocated memory.
+ * @param [in] size The number of bytes requested when the memory was allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t size = 100;
+ *     void *memory = parcSafeMemory_Allocate(size);
+ *
+ *     parcSafeMemory_DeallocateSized(&memory, size);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_DeallocateSized
+ */
+void parcSafeMemory_DeallocateSized(void **pointer, size_t size);
+
+/**
+ * Return the number of bytes requested for the memory pointed to by @p pointer.
+ *
+ * The guard bytes around the memory are not included.
+ *
+ * @param [in] pointer A pointer to memory previously allocated with {@link parcSafeMemory_Allocate}.
+ *
+ * @return The number of bytes requested.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcSafeMemory_Allocate(100);
+ *     size_t size = parcSafeMemory_UsableSize(memory);
+ *     // size is 100
+ *     parcSafeMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_UsableSize
+ */
+size_t parcSafeMemory_UsableSize(const void *pointer);
+
 /**
  * A (mostly) suitable replacement for realloc(3).
  * The primary difference is that it is an error if newSize is zero.
@@ -256,6 +310,8 @@ uint32_t parcSafeMemory_Outstanding(void);
 /**
  * Display information about outstanding memory allocations.
  *
+ * Only tracked allocations are displayed (see {@link parcSafeMemory_SetSampleInterval}).
+ *
  * @param [in] outputFd Output file descriptor.
  *
  * @return The number of currenly outstanding allocations.
@@ -271,6 +327,65 @@ uint32_t parcSafeMemory_Outstanding(void);
  */
 uint32_t parcSafeMemory_ReportAllocation(int outputFd);
 
+/**
+ * Set the average number of bytes allocated by a thread between allocations that are tracked.
+ *
+ * An interval of 0, the default, tracks every allocation.
+ * Otherwise allocations are sampled in proportion to their size, the way heap profilers sample,
+ * so that a few tracked allocations give an unbiased estimate of all of the live memory.
+ * Allocations that are not tracked use little more than the underlying allocator.
+ *
+ * Changing the interval does not affect memory that is already allocated.
+ *
+ * @param [in] bytes The sample interval in bytes, or 0 to track every allocation.
+ *
+ * @return The previous sample interval.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcSafeMemory_SetSampleInterval(512 * 1024);
+ * }
+ * @endcode
+ */
+size_t parcSafeMemory_SetSampleInterval(size_t bytes);
+
+/**
+ * Get the sample interval set by {@link parcSafeMemory_SetSampleInterval}.
+ *
+ * @return The sample interval in bytes, or 0 if every allocation is tracked.
+ *
+ * Example:
+ * @code
+ * {
+ *     bool sampling = parcSafeMemory_GetSampleInterval() != 0;
+ * }
+ * @endcode
+ */
+size_t parcSafeMemory_GetSampleInterval(void);
+
+/**
+ * Print a profile of the live, tracked allocations, aggregated by the call stack that allocated them.
+ *
+ * Each call stack is printed with the number of tracked allocations and bytes,
+ * and with the estimated number of all allocations and bytes that it accounts for when allocations are sampled,
+ * in descending order of estimated bytes.
+ *
+ * @param [in] outputFd Output file descriptor, or -1 to only count the call stacks.
+ *
+ * @return The number of distinct call stacks.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcSafeMemory_SetSampleInterval(512 * 1024);
+ *     ...
+ *     parcSafeMemory_ReportProfile(STDERR_FILENO);
+ * }
+ * @endcode
+ */
+uint32_t parcSafeMemory_ReportProfile(int outputFd);
+
 /**
  * Determine if a pointer to Safe Memory is valid.
  *
@@ -38,6 +38,12 @@
 #include <strings.h>
 #include <pthread.h>
 
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 #include <LongBow/runtime.h>
 
 #include <parc/algol/parc_AtomicInteger.h>
@@ -158,13 +164,59 @@ parcStdlibMemory_Outstanding(void)
     return _parcStdlibMemory_OutstandingAllocations;
 }
 
+size_t
+parcStdlibMemory_GoodSize(size_t size)
+{
+#if defined(__APPLE__)
+    return malloc_good_size(size);
+#elif defined(__GLIBC__)
+    // A glibc chunk holds the requested bytes and a size word, rounded up to the malloc alignment,
+    // and the size word of the next chunk is usable while this chunk is in use.
+    const size_t alignment = (2 * sizeof(size_t) < __alignof__(long double)) ? __alignof__(long double) : 2 * sizeof(size_t);
+    const size_t minimum = (4 * sizeof(size_t) + alignment - 1) & ~(alignment - 1);
+
+    size_t chunk = (size + sizeof(size_t) + alignment - 1) & ~(alignment - 1);
+    if (chunk < minimum) {
+        chunk = minimum;
+    }
+    size_t result = chunk - sizeof(size_t);
+    return (result < size) ? size : result;
+#else
+    return size;
+#endif
+}
+
+size_t
+parcStdlibMemory_UsableSize(const void *pointer)
+{
+#if defined(__APPLE__)
+    return malloc_size(pointer);
+#elif defined(__GLIBC__)
+    return malloc_usable_size((void *) pointer);
+#else
+    return 0;
+#endif
+}
+
+bool
+parcStdlibMemory_ReallocateInPlace(void *pointer, size_t newSize)
+{
+#if defined(__APPLE__) || defined(__GLIBC__)
+    return newSize <= parcStdlibMemory_UsableSize(pointer);
+#else
+    return false;
+#endif
+}
 
 PARCMemoryInterface PARCStdlibMemoryAsPARCMemory = {
-    .Allocate         = (uintptr_t) parcStdlibMemory_Allocate,
-    .AllocateAndClear = (uintptr_t) parcStdlibMemory_AllocateAndClear,
-    .MemAlign         = (uintptr_t) parcStdlibMemory_MemAlign,
-    .Deallocate       = (uintptr_t) parcStdlibMemory_Deallocate,
-    .Reallocate       = (uintptr_t) parcStdlibMemory_Reallocate,
-    .StringDuplicate  = (uintptr_t) parcStdlibMemory_StringDuplicate,
-    .Outstanding      = (uintptr_t) parcStdlibMemory_Outstanding
+    .Allocate          = (uintptr_t) parcStdlibMemory_Allocate,
+    .AllocateAndClear  = (uintptr_t) parcStdlibMemory_AllocateAndClear,
+    .MemAlign          = (uintptr_t) parcStdlibMemory_MemAlign,
+    .Deallocate        = (uintptr_t) parcStdlibMemory_Deallocate,
+    .Reallocate        = (uintptr_t) parcStdlibMemory_Reallocate,
+    .StringDuplicate   = (uintptr_t) parcStdlibMemory_StringDuplicate,
+    .Outstanding       = (uintptr_t) parcStdlibMemory_Outstanding,
+    .GoodSize          = (uintptr_t) parcStdlibMemory_GoodSize,
+    .ReallocateInPlace = (uintptr_t) parcStdlibMemory_ReallocateInPlace,
+    .UsableSize        = (uintptr_t) parcStdlibMemory_UsableSize
 };
@@ -180,6 +180,73 @@ char *parcStdlibMemory_StringDuplicate(const char *string, size_t length);
  */
 uint32_t parcStdlibMemory_Outstanding(void);
 
+/**
+ * Return the number of bytes, at least @p size, that the C library actually provides for an allocation of @p size bytes.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return The number of bytes to allocate without waste.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t capacity = parcStdlibMemory_GoodSize(100);
+ *     void *memory = parcStdlibMemory_Allocate(capacity);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_GoodSize
+ */
+size_t parcStdlibMemory_GoodSize(size_t size);
+
+/**
+ * Determine if the allocation pointed to by @p pointer already holds at least @p newSize bytes.
+ *
+ * The C library cannot grow an allocation in place without the possibility of moving it,
+ * so this succeeds only within the slack of the allocation.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ * @param [in] newSize The size of the allocated memory.
+ *
+ * @return true The allocation holds at least @p newSize bytes.
+ * @return false The allocation is unchanged.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcStdlibMemory_Allocate(100);
+ *     if (parcStdlibMemory_ReallocateInPlace(memory, 104)) {
+ *         // The allocation had room for 104 bytes.
+ *     }
+ *     parcStdlibMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_ReallocateInPlace
+ */
+bool parcStdlibMemory_ReallocateInPlace(void *pointer, size_t newSize);
+
+/**
+ * Return the number of bytes that the allocation pointed to by @p pointer holds.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ *
+ * @return The number of usable bytes of the allocation, or 0 if the C library cannot tell.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcStdlibMemory_Allocate(100);
+ *     size_t size = parcStdlibMemory_UsableSize(memory);
+ *     // size is at least 100
+ *     parcStdlibMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_UsableSize
+ */
+size_t parcStdlibMemory_UsableSize(const void *pointer);
+
 
 /**
  * Replacement function for realloc(3).
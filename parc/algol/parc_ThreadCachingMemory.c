@@ -0,0 +1,490 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <parc/algol/parc_ThreadCachingMemory.h>
+
+/**
+ * Every block is preceded by this prefix, which tells Deallocate where the block came from.
+ */
+typedef struct {
+    uint32_t sizeClass;     // The size class of the block, or _parcThreadCachingMemory_Uncached.
+    uint32_t offset;        // For an uncached block, the distance from the address returned by the C library to the block.
+    uint64_t length;        // For an uncached block, the usable length of the block.
+} _PARCThreadCachingMemoryPrefix;
+
+#define _parcThreadCachingMemory_Uncached UINT32_MAX
+
+// 8 classes of 16 byte multiples up to 128 bytes, then 4 classes per power of 2 up to the maximum cached size.
+#define _parcThreadCachingMemory_SizeClasses 40
+
+// The most free blocks of a size class, in bytes, that a thread keeps before returning half of them to the central heap.
+#define _parcThreadCachingMemory_CacheBytes 65536
+
+typedef struct {
+    void *head;             // The first free block. Each free block holds a pointer to the next.
+    size_t count;
+} _PARCThreadCachingMemoryFreeList;
+
+typedef struct parc_thread_caching_memory_cache {
+    struct parc_thread_caching_memory_cache *next;
+    int64_t outstanding;    // Allocations less deallocations by this thread, which may be negative.
+    _PARCThreadCachingMemoryFreeList freeLists[_parcThreadCachingMemory_SizeClasses];
+} _PARCThreadCachingMemoryCache;
+
+static pthread_once_t _parcThreadCachingMemory_Once = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcThreadCachingMemory_CacheKey;
+
+static pthread_mutex_t _parcThreadCachingMemory_HeapLock = PTHREAD_MUTEX_INITIALIZER;   // Guards the central heap.
+static _PARCThreadCachingMemoryFreeList _parcThreadCachingMemory_Heap[_parcThreadCachingMemory_SizeClasses];
+
+static pthread_mutex_t _parcThreadCachingMemory_RegistryLock = PTHREAD_MUTEX_INITIALIZER; // Guards the following.
+static _PARCThreadCachingMemoryCache *_parcThreadCachingMemory_Caches = NULL;
+static int64_t _parcThreadCachingMemory_RetiredOutstanding = 0;
+
+static inline unsigned int
+_sizeClass(size_t size)
+{
+    if (size <= 128) {
+        return (unsigned int) ((size + 15) / 16) - 1;
+    }
+    unsigned int log2 = (unsigned int) (sizeof(unsigned long long) * 8 - 1) - __builtin_clzll(size - 1);
+    size_t quarter = (size - 1 - ((size_t) 1 << log2)) >> (log2 - 2);
+    return 8 + (log2 - 7) * 4 + (unsigned int) quarter;
+}
+
+static inline size_t
+_sizeClass_Length(unsigned int sizeClass)
+{
+    if (sizeClass < 8) {
+        return 16 * (sizeClass + 1);
+    }
+    unsigned int log2 = 7 + (sizeClass - 8) / 4;
+    return ((size_t) 1 << log2) + ((sizeClass - 8) % 4 + 1) * ((size_t) 1 << (log2 - 2));
+}
+
+static inline size_t
+_sizeClass_Limit(unsigned int sizeClass)
+{
+    size_t result = _parcThreadCachingMemory_CacheBytes / _sizeClass_Length(sizeClass);
+    return (result < 8) ? 8 : (result > 512) ? 512 : result;
+}
+
+static inline _PARCThreadCachingMemoryPrefix *
+_prefix(const void *memory)
+{
+    return (_PARCThreadCachingMemoryPrefix *) &((char *) memory)[-sizeof(_PARCThreadCachingMemoryPrefix)];
+}
+
+static inline void *
+_freeList_Next(const void *block)
+{
+    return *(void **) block;
+}
+
+static inline void
+_freeList_Push(_PARCThreadCachingMemoryFreeList *list, void *block)
+{
+    *(void **) block = list->head;
+    list->head = block;
+    list->count++;
+}
+
+/**
+ * Move at most @p count blocks from the front of @p from to the front of @p to.
+ */
+static size_t
+_freeList_Move(_PARCThreadCachingMemoryFreeList *to, _PARCThreadCachingMemoryFreeList *from, size_t count)
+{
+    if (count == 0 || from->head == NULL) {
+        return 0;
+    }
+
+    void *first = from->head;
+    void *last = first;
+    size_t moved = 1;
+    while (moved < count && _freeList_Next(last) != NULL) {
+        last = _freeList_Next(last);
+        moved++;
+    }
+
+    from->head = _freeList_Next(last);
+    from->count -= moved;
+
+    *(void **) last = to->head;
+    to->head = first;
+    to->count += moved;
+
+    return moved;
+}
+
+static void
+_freeList_Free(_PARCThreadCachingMemoryFreeList *list)
+{
+    while (list->head != NULL) {
+        void *block = list->head;
+        list->head = _freeList_Next(block);
+        free(_prefix(block));
+    }
+    list->count = 0;
+}
+
+/**
+ * Return every free block of the given cache to the central heap.
+ */
+static void
+_cache_Return(_PARCThreadCachingMemoryCache *cache)
+{
+    pthread_mutex_lock(&_parcThreadCachingMemory_HeapLock);
+    for (unsigned int i = 0; i < _parcThreadCachingMemory_SizeClasses; i++) {
+        _freeList_Move(&_parcThreadCachingMemory_Heap[i], &cache->freeLists[i], cache->freeLists[i].count);
+    }
+    pthread_mutex_unlock(&_parcThreadCachingMemory_HeapLock);
+}
+
+static void
+_cache_Exit(void *cache)
+{
+    _PARCThreadCachingMemoryCache *exiting = cache;
+
+    _cache_Return(exiting);
+
+    pthread_mutex_lock(&_parcThreadCachingMemory_RegistryLock);
+    _PARCThreadCachingMemoryCache **link = &_parcThreadCachingMemory_Caches;
+    while (*link != exiting) {
+        link = &(*link)->next;
+    }
+    *link = exiting->next;
+    _parcThreadCachingMemory_RetiredOutstanding += exiting->outstanding;
+    pthread_mutex_unlock(&_parcThreadCachingMemory_RegistryLock);
+
+    free(exiting);
+}
+
+static void
+_parcThreadCachingMemory_InitOnce(void)
+{
+    pthread_key_create(&_parcThreadCachingMemory_CacheKey, _cache_Exit);
+}
+
+static inline _PARCThreadCachingMemoryCache *
+_cache(void)
+{
+    pthread_once(&_parcThreadCachingMemory_Once, _parcThreadCachingMemory_InitOnce);
+
+    _PARCThreadCachingMemoryCache *result = pthread_getspecific(_parcThreadCachingMemory_CacheKey);
+    if (result == NULL) {
+        result = calloc(1, sizeof(_PARCThreadCachingMemoryCache));
+        trapOutOfMemoryIf(result == NULL, "Cannot allocate a thread cache.");
+        pthread_setspecific(_parcThreadCachingMemory_CacheKey, result);
+
+        pthread_mutex_lock(&_parcThreadCachingMemory_RegistryLock);
+        result->next = _parcThreadCachingMemory_Caches;
+        _parcThreadCachingMemory_Caches = result;
+        pthread_mutex_unlock(&_parcThreadCachingMemory_RegistryLock);
+    }
+    return result;
+}
+
+/**
+ * Fill an empty free list of the given cache with a batch of blocks,
+ * taken from the central heap if it has any, otherwise from the C library.
+ */
+static void
+_cache_Refill(_PARCThreadCachingMemoryCache *cache, unsigned int sizeClass)
+{
+    size_t batch = _sizeClass_Limit(sizeClass) / 2;
+
+    pthread_mutex_lock(&_parcThreadCachingMemory_HeapLock);
+    size_t moved = _freeList_Move(&cache->freeLists[sizeClass], &_parcThreadCachingMemory_Heap[sizeClass], batch);
+    pthread_mutex_unlock(&_parcThreadCachingMemory_HeapLock);
+
+    if (moved == 0) {
+        size_t length = sizeof(_PARCThreadCachingMemoryPrefix) + _sizeClass_Length(sizeClass);
+        for (size_t i = 0; i < batch; i++) {
+            _PARCThreadCachingMemoryPrefix *prefix = malloc(length);
+            if (prefix == NULL) {
+                break;
+            }
+            prefix->sizeClass = sizeClass;
+            prefix->offset = sizeof(_PARCThreadCachingMemoryPrefix);
+            prefix->length = 0;
+            _freeList_Push(&cache->freeLists[sizeClass], &prefix[1]);
+        }
+    }
+}
+
+/**
+ * Allocate a block that is not cached, aligned on @p alignment bytes (at least 16).
+ */
+static void *
+_allocateUncached(_PARCThreadCachingMemoryCache *cache, size_t alignment, size_t size)
+{
+    void *origin;
+    if (alignment <= sizeof(_PARCThreadCachingMemoryPrefix)) {
+        alignment = sizeof(_PARCThreadCachingMemoryPrefix);
+        origin = malloc(alignment + size);
+    } else if (posix_memalign(&origin, alignment, alignment + size) != 0) {
+        origin = NULL;
+    }
+
+    if (origin == NULL) {
+        return NULL;
+    }
+
+    void *result = &((char *) origin)[alignment];
+    _PARCThreadCachingMemoryPrefix *prefix = _prefix(result);
+    prefix->sizeClass = _parcThreadCachingMemory_Uncached;
+    prefix->offset = (uint32_t) alignment;
+    prefix->length = size;
+
+    cache->outstanding++;
+    return result;
+}
+
+void *
+parcThreadCachingMemory_Allocate(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+
+    _PARCThreadCachingMemoryCache *cache = _cache();
+
+    if (size > parcThreadCachingMemory_MaximumCachedSize) {
+        return _allocateUncached(cache, sizeof(_PARCThreadCachingMemoryPrefix), size);
+    }
+
+    unsigned int sizeClass = _sizeClass(size);
+    _PARCThreadCachingMemoryFreeList *list = &cache->freeLists[sizeClass];
+    if (list->head == NULL) {
+        _cache_Refill(cache, sizeClass);
+        if (list->head == NULL) {
+            return NULL;
+        }
+    }
+
+    void *result = list->head;
+    list->head = _freeList_Next(result);
+    list->count--;
+
+    cache->outstanding++;
+    return result;
+}
+
+void *
+parcThreadCachingMemory_AllocateAndClear(size_t size)
+{
+    void *pointer = parcThreadCachingMemory_Allocate(size);
+    if (pointer != NULL) {
+        memset(pointer, 0, size);
+    }
+    return pointer;
+}
+
+int
+parcThreadCachingMemory_MemAlign(void **pointer, size_t alignment, size_t size)
+{
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0 || alignment > UINT32_MAX) {
+        return EINVAL;
+    }
+    if (size == 0) {
+        return EINVAL;
+    }
+
+    // Every block is aligned on 16 bytes.
+    if (alignment <= sizeof(_PARCThreadCachingMemoryPrefix)) {
+        *pointer = parcThreadCachingMemory_Allocate(size);
+    } else {
+        *pointer = _allocateUncached(_cache(), alignment, size);
+    }
+
+    return (*pointer == NULL) ? ENOMEM : 0;
+}
+
+void
+parcThreadCachingMemory_Deallocate(void **pointer)
+{
+    void *memory = *pointer;
+    *pointer = NULL;
+    if (memory == NULL) {
+        return;
+    }
+
+    _PARCThreadCachingMemoryCache *cache = _cache();
+    cache->outstanding--;
+
+    _PARCThreadCachingMemoryPrefix *prefix = _prefix(memory);
+    if (prefix->sizeClass == _parcThreadCachingMemory_Uncached) {
+        free(&((char *) memory)[-(ptrdiff_t) prefix->offset]);
+    } else {
+        trapIllegalValueIf(prefix->sizeClass >= _parcThreadCachingMemory_SizeClasses,
+                           "Memory %p was not allocated by parcThreadCachingMemory (or its prefix was overwritten).", memory);
+
+        _PARCThreadCachingMemoryFreeList *list = &cache->freeLists[prefix->sizeClass];
+        _freeList_Push(list, memory);
+
+        size_t limit = _sizeClass_Limit(prefix->sizeClass);
+        if (list->count > limit) {
+            pthread_mutex_lock(&_parcThreadCachingMemory_HeapLock);
+            _freeList_Move(&_parcThreadCachingMemory_Heap[prefix->sizeClass], list, limit / 2);
+            pthread_mutex_unlock(&_parcThreadCachingMemory_HeapLock);
+        }
+    }
+}
+
+void *
+parcThreadCachingMemory_Reallocate(void *pointer, size_t newSize)
+{
+    if (pointer == NULL) {
+        return parcThreadCachingMemory_Allocate(newSize);
+    }
+    if (newSize == 0) {
+        newSize = 1;
+    }
+
+    _PARCThreadCachingMemoryPrefix *prefix = _prefix(pointer);
+
+    size_t length;
+    if (prefix->sizeClass == _parcThreadCachingMemory_Uncached) {
+        length = prefix->length;
+        if (prefix->offset == sizeof(_PARCThreadCachingMemoryPrefix) && newSize > parcThreadCachingMemory_MaximumCachedSize) {
+            // Still uncached and not specially aligned, so the C library can resize it in place.
+            _PARCThreadCachingMemoryPrefix *resized = realloc(prefix, sizeof(_PARCThreadCachingMemoryPrefix) + newSize);
+            if (resized == NULL) {
+                return NULL;
+            }
+            resized->length = newSize;
+            return &resized[1];
+        }
+    } else {
+        length = _sizeClass_Length(prefix->sizeClass);
+        if (newSize <= length && _sizeClass(newSize) == prefix->sizeClass) {
+            return pointer;
+        }
+    }
+
+    void *result = parcThreadCachingMemory_Allocate(newSize);
+    if (result != NULL) {
+        memcpy(result, pointer, (length < newSize) ? length : newSize);
+        parcThreadCachingMemory_Deallocate(&pointer);
+    }
+    return result;
+}
+
+size_t
+parcThreadCachingMemory_GoodSize(size_t size)
+{
+    if (size == 0 || size > parcThreadCachingMemory_MaximumCachedSize) {
+        return size;
+    }
+    return _sizeClass_Length(_sizeClass(size));
+}
+
+size_t
+parcThreadCachingMemory_UsableSize(const void *pointer)
+{
+    _PARCThreadCachingMemoryPrefix *prefix = _prefix(pointer);
+
+    if (prefix->sizeClass == _parcThreadCachingMemory_Uncached) {
+        return prefix->length;
+    }
+    return _sizeClass_Length(prefix->sizeClass);
+}
+
+bool
+parcThreadCachingMemory_ReallocateInPlace(void *pointer, size_t newSize)
+{
+    return newSize <= parcThreadCachingMemory_UsableSize(pointer);
+}
+
+char *
+parcThreadCachingMemory_StringDuplicate(const char *string, size_t length)
+{
+    size_t actualLength = strnlen(string, length);
+
+    char *result = parcThreadCachingMemory_Allocate(actualLength + 1);
+    if (result != NULL) {
+        memcpy(result, string, actualLength);
+        result[actualLength] = 0;
+    }
+    return result;
+}
+
+uint32_t
+parcThreadCachingMemory_Outstanding(void)
+{
+    pthread_mutex_lock(&_parcThreadCachingMemory_RegistryLock);
+    int64_t result = _parcThreadCachingMemory_RetiredOutstanding;
+    for (_PARCThreadCachingMemoryCache *cache = _parcThreadCachingMemory_Caches; cache != NULL; cache = cache->next) {
+        result += cache->outstanding;
+    }
+    pthread_mutex_unlock(&_parcThreadCachingMemory_RegistryLock);
+
+    return (result < 0) ? 0 : (uint32_t) result;
+}
+
+void
+parcThreadCachingMemory_Flush(void)
+{
+    _cache_Return(_cache());
+
+    _PARCThreadCachingMemoryFreeList heap[_parcThreadCachingMemory_SizeClasses];
+
+    pthread_mutex_lock(&_parcThreadCachingMemory_HeapLock);
+    memcpy(heap, _parcThreadCachingMemory_Heap, sizeof(heap));
+    memset(_parcThreadCachingMemory_Heap, 0, sizeof(_parcThreadCachingMemory_Heap));
+    pthread_mutex_unlock(&_parcThreadCachingMemory_HeapLock);
+
+    for (unsigned int i = 0; i < _parcThreadCachingMemory_SizeClasses; i++) {
+        _freeList_Free(&heap[i]);
+    }
+}
+
+PARCMemoryInterface PARCThreadCachingMemoryAsPARCMemory = {
+    .Allocate          = (uintptr_t) parcThreadCachingMemory_Allocate,
+    .AllocateAndClear  = (uintptr_t) parcThreadCachingMemory_AllocateAndClear,
+    .MemAlign          = (uintptr_t) parcThreadCachingMemory_MemAlign,
+    .Deallocate        = (uintptr_t) parcThreadCachingMemory_Deallocate,
+    .Reallocate        = (uintptr_t) parcThreadCachingMemory_Reallocate,
+    .StringDuplicate   = (uintptr_t) parcThreadCachingMemory_StringDuplicate,
+    .Outstanding       = (uintptr_t) parcThreadCachingMemory_Outstanding,
+    .GoodSize          = (uintptr_t) parcThreadCachingMemory_GoodSize,
+    .ReallocateInPlace = (uintptr_t) parcThreadCachingMemory_ReallocateInPlace,
+    .UsableSize        = (uintptr_t) parcThreadCachingMemory_UsableSize
+};
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file parc_ThreadCachingMemory.h
+ * @ingroup memory
+ * @brief A PARCMemoryInterface provider that caches freed memory per thread.
+ *
+ * Memory is allocated in size classes. Each thread keeps a cache of free blocks for each size class,
+ * so most allocations and deallocations take no lock and touch no memory shared with other threads.
+ * When a thread's cache of a size class grows too large, or is empty, the thread exchanges a batch of blocks
+ * with a central heap in one locked operation.
+ * Allocations larger than the largest size class, or aligned on more than 16 bytes, are passed through to the C library.
+ *
+ * Each thread counts its own outstanding allocations,
+ * and `parcThreadCachingMemory_Outstanding` sums the counts of all threads when it is called.
+ *
+ * Free blocks are kept until `parcThreadCachingMemory_Flush` is called,
+ * so the memory in use by the process does not shrink when the application frees memory.
+ *
+ * @code
+ * {
+ *     parcMemory_SetInterface(&PARCThreadCachingMemoryAsPARCMemory);
+ *     ...
+ * }
+ * @endcode
+ *
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_ThreadCachingMemory_h
+#define libparc_parc_ThreadCachingMemory_h
+
+#include <parc/algol/parc_Memory.h>
+
+extern PARCMemoryInterface PARCThreadCachingMemoryAsPARCMemory;
+
+/**
+ * The size, in bytes, of the largest allocation that is cached.
+ */
+#define parcThreadCachingMemory_MaximumCachedSize 32768
+
+/**
+ * Allocate memory.
+ *
+ * @param [in] size The size of memory to allocate
+ *
+ * @return A pointer to the allocated memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcThreadCachingMemory_Allocate(100);
+ *     parcThreadCachingMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcThreadCachingMemory_Allocate(size_t size);
+
+/**
+ * Allocate memory of size @p size and clear it.
+ *
+ * @param [in] size Size of memory to allocate
+ *
+ * @return A pointer to the allocated memory
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcThreadCachingMemory_AllocateAndClear(100);
+ *     parcThreadCachingMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcThreadCachingMemory_AllocateAndClear(size_t size);
+
+/**
+ * Allocate aligned memory.
+ *
+ * Allocates @p size bytes of memory such that the allocation's
+ * base address is an exact multiple of alignment,
+ * and returns the allocation in the value pointed to by @p pointer.
+ *
+ * The requested alignment must be a power of 2 greater than or equal to `sizeof(void *)`.
+ *
+ * @param [out] pointer A pointer to a `void *` pointer that will be set to the address of the allocated memory.
+ * @param [in] alignment A power of 2 greater than or equal to `sizeof(void *)`
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return 0 Successful
+ * @return EINVAL The alignment parameter is not a power of 2 at least as large as sizeof(void *)
+ * @return ENOMEM Memory allocation error.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *allocatedMemory;
+ *
+ *     int failure = parcThreadCachingMemory_MemAlign(&allocatedMemory, sizeof(void *), 100);
+ *     if (failure == 0) {
+ *         parcThreadCachingMemory_Deallocate(&allocatedMemory);
+ *     }
+ * }
+ * @endcode
+ */
+int parcThreadCachingMemory_MemAlign(void **pointer, size_t alignment, size_t size);
+
+/**
+ * Deallocate the memory pointed to by @p pointer
+ *
+ * Memory allocated by one thread may be deallocated by another.
+ *
+ * @param [in,out] pointer A pointer to a pointer to the memory to be deallocated
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcThreadCachingMemory_Allocate(100);
+ *     parcThreadCachingMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void parcThreadCachingMemory_Deallocate(void **pointer);
+
+/**
+ * Resizes previously allocated memory at @p pointer to @p newSize. If necessary,
+ * new memory is allocated and the content copied from the old memory to the
+ * new memory and the old memory is deallocated.
+ *
+ * @param [in,out] pointer A pointer to the memory to be reallocated.
+ * @param [in] newSize The size that the memory to be resized to.
+ *
+ * @return A pointer to the memory
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcThreadCachingMemory_Allocate(100);
+ *     memory = parcThreadCachingMemory_Reallocate(memory, 200);
+ *     parcThreadCachingMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ */
+void *parcThreadCachingMemory_Reallocate(void *pointer, size_t newSize);
+
+/**
+ * Return the length of the size class that serves an allocation of @p size bytes.
+ *
+ * Sizes larger than `parcThreadCachingMemory_MaximumCachedSize` are not cached and are returned unchanged.
+ *
+ * @param [in] size The number of bytes to allocate.
+ *
+ * @return The number of bytes to allocate without waste.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t capacity = parcThreadCachingMemory_GoodSize(100);
+ *     // capacity is 112
+ * }
+ * @endcode
+ *
+ * @see parcMemory_GoodSize
+ */
+size_t parcThreadCachingMemory_GoodSize(size_t size);
+
+/**
+ * Determine if the block pointed to by @p pointer can hold @p newSize bytes without moving it.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ * @param [in] newSize The size of the allocated memory.
+ *
+ * @return true The block holds at least @p newSize bytes.
+ * @return false The block is unchanged.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcThreadCachingMemory_Allocate(100);
+ *     bool resized = parcThreadCachingMemory_ReallocateInPlace(memory, 112);
+ *     // resized is true, because the block was taken from the 112 byte size class.
+ *     parcThreadCachingMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_ReallocateInPlace
+ */
+bool parcThreadCachingMemory_ReallocateInPlace(void *pointer, size_t newSize);
+
+/**
+ * Return the number of bytes that the block pointed to by @p pointer holds.
+ *
+ * @param [in] pointer A pointer to previously allocated memory.
+ *
+ * @return The length of the size class of the block, or the requested length if it is not cached.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *memory = parcThreadCachingMemory_Allocate(100);
+ *     size_t size = parcThreadCachingMemory_UsableSize(memory);
+ *     // size is 112
+ *     parcThreadCachingMemory_Deallocate(&memory);
+ * }
+ * @endcode
+ *
+ * @see parcMemory_UsableSize
+ */
+size_t parcThreadCachingMemory_UsableSize(const void *pointer);
+
+/**
+ * Allocate sufficient memory for a copy of the string @p string,
+ * copy at most n characters from the string @p string into the allocated memory,
+ * and return the pointer to allocated memory.
+ *
+ * The copied string is always null-terminated.
+ *
+ * @param [in] string A pointer to a null-terminated string.
+ * @param [in] length  The maximum allowed length of the resulting copy.
+ *
+ * @return non-NULL A pointer to allocated memory.
+ * @return NULL A an error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     char *copy = parcThreadCachingMemory_StringDuplicate("this is a string", 16);
+ *     parcThreadCachingMemory_Deallocate((void **) &copy);
+ * }
+ * @endcode
+ */
+char *parcThreadCachingMemory_StringDuplicate(const char *string, size_t length);
+
+/**
+ * Return the number of outstanding allocations managed by this allocator.
+ *
+ * This sums the counts of every thread, so it is more expensive than the other functions of this allocator.
+ * While other threads are allocating and deallocating memory, the result is approximate.
+ *
+ * @return The number of memory allocations still outstanding (remaining to be deallocated).
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t numberOfAllocations = parcThreadCachingMemory_Outstanding();
+ * }
+ * @endcode
+ */
+uint32_t parcThreadCachingMemory_Outstanding(void);
+
+/**
+ * Return the free memory held by the calling thread's cache and by the central heap to the C library.
+ *
+ * The caches of other threads are not affected.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcThreadCachingMemory_Flush();
+ * }
+ * @endcode
+ */
+void parcThreadCachingMemory_Flush(void);
+#endif // libparc_parc_ThreadCachingMemory_h
@@ -162,8 +162,10 @@ parcURISegment_Parse(const char *string, const char **pointer)
 {
     assertFalse(*string == '/', "Input parameter '%s' must NOT point to an initial '/' character.", string);
 
-    unsigned char *segment = parcMemory_AllocateAndClear((strlen(string) + 1) * sizeof(unsigned char));
-    assertNotNull(segment, "parcMemory_AllocateAndClear(%zu) returned NULL", (strlen(string) + 1) * sizeof(unsigned char));
+    // The decoded segment is never longer than its encoding, which ends at the first delimiter, not the end of the string.
+    size_t encodedLength = strcspn(string, "/?#");
+    unsigned char *segment = parcMemory_Allocate((encodedLength + 1) * sizeof(unsigned char));
+    assertNotNull(segment, "parcMemory_Allocate(%zu) returned NULL", (encodedLength + 1) * sizeof(unsigned char));
     size_t length = 0;
 
     unsigned char *r = segment;
@@ -0,0 +1,708 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_ArenaMemory.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_BufferPool.h>
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_ObjectPool.h>
+#include <parc/algol/parc_ObjectReclaimer.h>
+#include <parc/algol/parc_ObjectStatistics.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+LONGBOW_TEST_RUNNER(parc_ArenaMemory)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ArenaMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ArenaMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Create);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Push);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Push_Nested);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate_Zero);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate_Large);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Allocate_Chunks);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_AllocateAndClear);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_MemAlign);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_MemAlign_BadAlignment);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Deallocate_Last);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Deallocate_Underlying);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reallocate_InPlace);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reallocate_Copy);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reallocate_Underlying);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_ReallocateInPlace);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_GoodSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_UsableSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Reset);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Objects);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Objects_Bookkeeping);
+    LONGBOW_RUN_TEST_CASE(Global, parcArenaMemory_Objects_Pooled);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Create)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0);
+    assertNotNull(arena, "Expected non-NULL result from parcArenaMemory_Create");
+
+    assertTrue(arena->chunkLength == parcArenaMemory_DefaultChunkLength,
+               "Expected the default chunk length, actual %zd", arena->chunkLength);
+    assertTrue(parcArenaMemory_GetUsage(arena) == 0, "Expected no usage.");
+    assertTrue(parcArenaMemory_GetCapacity(arena) == 0, "Expected no capacity before the first allocation.");
+
+    parcArenaMemory_Release(&arena);
+    assertNull(arena, "Expected parcArenaMemory_Release to NULL the pointer.");
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_AcquireRelease)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    PARCArenaMemory *reference = parcArenaMemory_Acquire(arena);
+    assertTrue(reference == arena, "Expected the acquired reference to be equal to the original.");
+
+    parcArenaMemory_Release(&reference);
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Push)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    const PARCMemoryInterface *global = parcMemory_GetInterface();
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    assertNull(parcArenaMemory_Current(), "Expected no current arena.");
+
+    parcArenaMemory_Push(arena);
+    assertTrue(parcArenaMemory_Current() == arena, "Expected the pushed arena to be current.");
+
+    void *memory = parcMemory_Allocate(100);
+    assertTrue(_isArenaMemory(memory), "Expected parcMemory_Allocate to allocate from the arena.");
+    assertTrue(parcMemory_Outstanding() == outstanding,
+               "Expected arena allocations not to be outstanding in the underlying provider.");
+    parcMemory_Deallocate(&memory);
+
+    parcArenaMemory_Pop();
+
+    assertNull(parcArenaMemory_Current(), "Expected no current arena after parcArenaMemory_Pop.");
+    assertTrue(parcMemory_GetInterface() == global, "Expected the global interface to be unchanged.");
+    assertNull(parcMemory_SetThreadInterface(NULL), "Expected the thread interface to be restored.");
+
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Push_Nested)
+{
+    PARCArenaMemory *outer = parcArenaMemory_Create(1024);
+    PARCArenaMemory *inner = parcArenaMemory_Create(1024);
+
+    parcArenaMemory_Push(outer);
+    void *outerMemory = parcMemory_Allocate(10);
+
+    parcArenaMemory_Push(inner);
+    assertTrue(parcArenaMemory_Current() == inner, "Expected the inner arena to be current.");
+    void *innerMemory = parcMemory_Allocate(200);
+    assertTrue(parcArenaMemory_GetUsage(inner) >= 200, "Expected the inner arena to be used.");
+    assertTrue(parcArenaMemory_GetUsage(outer) < 200, "Expected the outer arena not to be used.");
+    parcArenaMemory_Pop();
+
+    assertTrue(parcArenaMemory_Current() == outer, "Expected the outer arena to be current again.");
+    parcMemory_Deallocate(&outerMemory);
+    parcArenaMemory_Pop();
+
+    assertNull(parcArenaMemory_Current(), "Expected no current arena.");
+    assertNotNull(innerMemory, "Expected non-NULL allocation from the inner arena.");
+
+    parcArenaMemory_Release(&inner);
+    parcArenaMemory_Release(&outer);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    void *first = parcArenaMemory_Allocate(10);
+    void *second = parcArenaMemory_Allocate(10);
+
+    assertTrue(((uintptr_t) first & 15) == 0, "Expected %p to be aligned on 16 bytes.", first);
+    assertTrue(((uintptr_t) second & 15) == 0, "Expected %p to be aligned on 16 bytes.", second);
+    assertTrue((char *) second > (char *) first, "Expected allocations to advance through the chunk.");
+    assertTrue(parcArenaMemory_GetUsage(arena) >= 20, "Expected at least 20 bytes used, actual %zd", parcArenaMemory_GetUsage(arena));
+    memset(first, 0xff, 10);
+    memset(second, 0xff, 10);
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate_Zero)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    void *result = parcArenaMemory_Allocate(0);
+    assertNull(result, "Expected NULL for a zero length allocation.");
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate_Large)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    char *result = parcArenaMemory_Allocate(5000);
+    assertNotNull(result, "Expected non-NULL result for an allocation larger than a chunk.");
+    assertTrue(_isArenaMemory(result), "Expected a large allocation to belong to the arena.");
+    memset(result, 0xff, 5000);
+    assertTrue(parcArenaMemory_GetCapacity(arena) >= 5000, "Expected the capacity to include the large allocation.");
+
+    parcArenaMemory_Reset(arena);
+    assertTrue(parcArenaMemory_GetCapacity(arena) == 0, "Expected large allocations to be freed by a reset.");
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Allocate_Chunks)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(256);
+    parcArenaMemory_Push(arena);
+
+    for (int i = 0; i < 100; i++) {
+        char *memory = parcArenaMemory_Allocate(100);
+        memset(memory, i, 100);
+    }
+    assertTrue(parcArenaMemory_GetCapacity(arena) >= 100 * 100, "Expected the arena to grow by chunks.");
+
+    size_t capacity = parcArenaMemory_GetCapacity(arena);
+    parcArenaMemory_Reset(arena);
+    for (int i = 0; i < 100; i++) {
+        char *memory = parcArenaMemory_Allocate(100);
+        memset(memory, i, 100);
+    }
+    assertTrue(parcArenaMemory_GetCapacity(arena) == capacity,
+               "Expected the chunks to be reused after a reset, capacity %zd, actual %zd", capacity, parcArenaMemory_GetCapacity(arena));
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_AllocateAndClear)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    // Dirty the arena first, so that the cleared allocation reuses it.
+    unsigned char *dirty = parcArenaMemory_Allocate(100);
+    memset(dirty, 0xff, 100);
+    parcArenaMemory_Reset(arena);
+
+    unsigned char *result = parcArenaMemory_AllocateAndClear(100);
+    for (int i = 0; i < 100; i++) {
+        assertTrue(result[i] == 0, "Expected byte %d to be cleared.", i);
+    }
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_MemAlign)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    for (size_t alignment = sizeof(void *); alignment <= 4096; alignment <<= 1) {
+        parcArenaMemory_Allocate(1);
+
+        void *result;
+        int failure = parcArenaMemory_MemAlign(&result, alignment, 100);
+        assertTrue(failure == 0, "parcArenaMemory_MemAlign failed: %d", failure);
+        assertTrue(((uintptr_t) result & (alignment - 1)) == 0, "Expected %p to be aligned on %zd bytes", result, alignment);
+        memset(result, 0xff, 100);
+    }
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_MemAlign_BadAlignment)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    void *result;
+    int failure = parcArenaMemory_MemAlign(&result, 3, 100);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a bad alignment, actual %d", failure);
+
+    failure = parcArenaMemory_MemAlign(&result, sizeof(void *), 0);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a zero size, actual %d", failure);
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Deallocate_Last)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    void *first = parcArenaMemory_Allocate(10);
+    size_t usage = parcArenaMemory_GetUsage(arena);
+
+    void *second = parcArenaMemory_Allocate(100);
+    void *expected = second;
+    parcArenaMemory_Deallocate(&second);
+    assertNull(second, "Expected the pointer to be set to NULL.");
+    assertTrue(parcArenaMemory_GetUsage(arena) == usage,
+               "Expected the most recent allocation to be given back, usage %zd, actual %zd", usage, parcArenaMemory_GetUsage(arena));
+
+    void *third = parcArenaMemory_Allocate(100);
+    assertTrue(third == expected, "Expected the given back memory to be reused.");
+
+    // Deallocating an earlier allocation does nothing.
+    usage = parcArenaMemory_GetUsage(arena);
+    parcArenaMemory_Deallocate(&first);
+    assertNull(first, "Expected the pointer to be set to NULL.");
+    assertTrue(parcArenaMemory_GetUsage(arena) == usage, "Expected the usage to be unchanged.");
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Deallocate_Underlying)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+
+    void *memory = parcMemory_Allocate(100);
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    parcArenaMemory_Push(arena);
+    parcMemory_Deallocate(&memory);
+    assertTrue(parcMemory_Outstanding() == outstanding - 1,
+               "Expected the deallocation to be passed to the underlying provider.");
+    parcArenaMemory_Pop();
+
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reallocate_InPlace)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    unsigned char *memory = parcArenaMemory_Allocate(10);
+    for (int i = 0; i < 10; i++) {
+        memory[i] = (unsigned char) i;
+    }
+
+    unsigned char *result = parcArenaMemory_Reallocate(memory, 500);
+    assertTrue(result == memory, "Expected the most recent allocation to grow in place.");
+    assertTrue(_prefix(result)->length == 500, "Expected the length to be 500, actual %zd", _prefix(result)->length);
+    memset(&result[10], 0xff, 490);
+
+    result = parcArenaMemory_Reallocate(result, 20);
+    assertTrue(result == memory, "Expected the most recent allocation to shrink in place.");
+    for (int i = 0; i < 10; i++) {
+        assertTrue(result[i] == (unsigned char) i, "Expected byte %d to be preserved.", i);
+    }
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reallocate_Copy)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    unsigned char *memory = parcArenaMemory_Allocate(10);
+    for (int i = 0; i < 10; i++) {
+        memory[i] = (unsigned char) i;
+    }
+    parcArenaMemory_Allocate(10);
+
+    unsigned char *result = parcArenaMemory_Reallocate(memory, 2000);
+    assertTrue(result != memory, "Expected an earlier allocation to be copied.");
+    for (int i = 0; i < 10; i++) {
+        assertTrue(result[i] == (unsigned char) i, "Expected byte %d to be preserved.", i);
+    }
+    memset(&result[10], 0xff, 1990);
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reallocate_Underlying)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+
+    char *memory = parcMemory_StringDuplicate("Hello", 5);
+
+    parcArenaMemory_Push(arena);
+    memory = parcMemory_Reallocate(memory, 100);
+    assertFalse(_isArenaMemory(memory), "Expected underlying memory to be reallocated by the underlying provider.");
+    assertTrue(strcmp(memory, "Hello") == 0, "Expected the content to be preserved, actual '%s'", memory);
+    parcArenaMemory_Pop();
+
+    parcMemory_Deallocate(&memory);
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_ReallocateInPlace)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    void *first = parcMemory_Allocate(100);
+    void *last = parcMemory_Allocate(100);
+
+    assertFalse(parcMemory_ReallocateInPlace(first, 200), "Expected an allocation followed by another not to grow.");
+    assertTrue(parcMemory_ReallocateInPlace(first, 50), "Expected an allocation to shrink in place.");
+
+    size_t usage = parcArenaMemory_GetUsage(arena);
+    assertTrue(parcMemory_ReallocateInPlace(last, 500), "Expected the last allocation to grow in place.");
+    assertTrue(parcArenaMemory_GetUsage(arena) == usage + 400,
+               "Expected the usage to grow by 400 bytes, actual %zd", parcArenaMemory_GetUsage(arena) - usage);
+    assertFalse(parcMemory_ReallocateInPlace(last, 2000), "Expected the last allocation not to grow beyond its chunk.");
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_GoodSize)
+{
+    assertTrue(parcArenaMemory_GoodSize(1) == 16, "Expected 16, actual %zd", parcArenaMemory_GoodSize(1));
+    assertTrue(parcArenaMemory_GoodSize(16) == 16, "Expected 16, actual %zd", parcArenaMemory_GoodSize(16));
+    assertTrue(parcArenaMemory_GoodSize(17) == 32, "Expected 32, actual %zd", parcArenaMemory_GoodSize(17));
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_UsableSize)
+{
+    void *foreign = parcMemory_Allocate(100);
+
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    void *memory = parcMemory_Allocate(100);
+    assertTrue(parcMemory_UsableSize(memory) == 100, "Expected 100, actual %zd", parcMemory_UsableSize(memory));
+
+    size_t actual = parcMemory_UsableSize(foreign);
+    size_t expected = parcArenaMemory_UsableSize(foreign);
+    assertTrue(actual == expected, "Expected the underlying provider's size %zd, actual %zd", expected, actual);
+    parcMemory_Deallocate(&foreign);
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_StringDuplicate)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    char *expected = "Hello World";
+
+    char *actual = parcArenaMemory_StringDuplicate(expected, 5);
+    assertTrue(strcmp(actual, "Hello") == 0, "Expected %s, actual %s", "Hello", actual);
+
+    actual = parcArenaMemory_StringDuplicate(expected, 100);
+    assertTrue(strcmp(actual, expected) == 0, "Expected %s, actual %s", expected, actual);
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Reset)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(1024);
+    parcArenaMemory_Push(arena);
+
+    void *first = parcArenaMemory_Allocate(100);
+    parcArenaMemory_Allocate(200);
+    size_t peak = parcArenaMemory_GetUsage(arena);
+
+    parcArenaMemory_Reset(arena);
+    assertTrue(parcArenaMemory_GetUsage(arena) == 0, "Expected no usage after a reset.");
+    assertTrue(parcArenaMemory_GetPeakUsage(arena) == peak,
+               "Expected the peak usage %zd to be kept, actual %zd", peak, parcArenaMemory_GetPeakUsage(arena));
+
+    void *again = parcArenaMemory_Allocate(100);
+    assertTrue(again == first, "Expected the memory to be reused after a reset.");
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Objects)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0);
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    for (int i = 0; i < 10; i++) {
+        parcArenaMemory_Push(arena);
+
+        PARCJSON *json = parcJSON_Create();
+        parcJSON_AddInteger(json, "count", i);
+        parcJSON_AddString(json, "name", "arena");
+        PARCBuffer *buffer = parcBuffer_AllocateCString("Hello World");
+        char *string = parcJSON_ToString(json);
+        assertNotNull(string, "Expected non-NULL string.");
+
+        // Abandon the objects, rather than releasing them.
+        assertTrue(parcMemory_Outstanding() == outstanding, "Expected no allocations from the underlying provider.");
+        assertNotNull(buffer, "Expected non-NULL buffer.");
+
+        parcArenaMemory_Pop();
+        parcArenaMemory_Reset(arena);
+    }
+
+    parcArenaMemory_Release(&arena);
+}
+
+/*
+ * The library's own per-thread and per-object bookkeeping, created while an arena is pushed,
+ * outlives the arena and is freed at thread exit. It must not come from the arena.
+ */
+static void *
+_bookkeepingInArena(void *data)
+{
+    PARCBuffer *locked = data;
+    PARCArenaMemory *arena = parcArenaMemory_Create(0);
+
+    parcArenaMemory_Push(arena);
+
+    PARCBuffer *buffer = parcBuffer_Allocate(10);
+    parcBuffer_Release(&buffer);
+
+    parcObjectReclaimer_RegisterThread();
+
+    parcObject_Lock(locked);
+    parcObject_Unlock(locked);
+
+    parcArenaMemory_Pop();
+
+    // Overwrite whatever the thread allocated from the arena.
+    parcArenaMemory_Reset(arena);
+    parcArenaMemory_Push(arena);
+    memset(parcMemory_Allocate(4096), 0xA5, 4096);
+    parcArenaMemory_Pop();
+
+    parcArenaMemory_Release(&arena);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Objects_Bookkeeping)
+{
+    bool previous = parcObjectStatistics_SetEnabled(true);
+    PARCBuffer *locked = parcBuffer_Allocate(10);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _bookkeepingInArena, locked);
+    pthread_join(thread, NULL);
+
+    parcBuffer_Release(&locked);
+    parcObjectStatistics_SetEnabled(previous);
+}
+
+/*
+ * With pooling enabled, the memory of objects released while an arena is pushed must not be kept by a pool,
+ * which would hand it out again after the arena is reset.
+ */
+LONGBOW_TEST_CASE(Global, parcArenaMemory_Objects_Pooled)
+{
+    bool previous = parcObjectPool_SetEnabled(true);
+
+    PARCBufferPoolClass classes[] = { { .size = 100, .capacity = 4, .preallocate = 0 } };
+    PARCBufferPool *bufferPool = parcBufferPool_Create(1, classes);
+    PARCArenaMemory *arena = parcArenaMemory_Create(0);
+
+    // Create the PARCBuffer pool outside of the arena.
+    PARCBuffer *buffer = parcBuffer_Allocate(10);
+    const PARCObjectDescriptor *descriptor = parcObject_GetDescriptor(buffer);
+    parcBuffer_Release(&buffer);
+
+    parcArenaMemory_Push(arena);
+
+    buffer = parcBuffer_Allocate(10);
+
+    PARCObjectPoolStatistics before;
+    assertTrue(parcObjectPool_GetThreadStatistics(descriptor, &before), "Expected PARCBuffer to be pooled.");
+    parcBuffer_Release(&buffer);
+    PARCObjectPoolStatistics after;
+    parcObjectPool_GetThreadStatistics(descriptor, &after);
+    assertTrue(after.recycled == before.recycled, "Expected the object pool not to keep memory from the arena.");
+
+    PARCBuffer *pooled = parcBufferPool_GetInstance(bufferPool, 100);
+    parcBuffer_Release(&pooled);
+
+    parcArenaMemory_Pop();
+    parcArenaMemory_Reset(arena);
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(bufferPool, 0, &statistics);
+    assertTrue(statistics.idle == 0, "Expected the buffer pool not to keep a buffer from the arena, it holds %zd", statistics.idle);
+    assertTrue(statistics.outstanding == 0, "Expected no outstanding buffers, actual %zd", statistics.outstanding);
+
+    parcArenaMemory_Release(&arena);
+    parcBufferPool_Release(&bufferPool);
+
+    parcObjectPool_SetEnabled(previous);
+    parcObjectPool_Flush();
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, Arena_vs_Stdlib);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _Requests 100000
+#define _AllocationsPerRequest 32
+
+static double
+_elapsed(const struct timeval *start)
+{
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    return (end.tv_sec - start->tv_sec) + (end.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+static void
+_request(bool deallocate)
+{
+    static const size_t sizes[] = { 16, 48, 64, 100, 200, 512 };
+
+    void *memory[_AllocationsPerRequest];
+    for (int i = 0; i < _AllocationsPerRequest; i++) {
+        memory[i] = parcMemory_Allocate(sizes[i % (sizeof(sizes) / sizeof(sizes[0]))]);
+    }
+    if (deallocate) {
+        for (int i = 0; i < _AllocationsPerRequest; i++) {
+            parcMemory_Deallocate(&memory[i]);
+        }
+    }
+}
+
+static double
+_arenaTime(bool deallocate)
+{
+    PARCArenaMemory *arena = parcArenaMemory_Create(0);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int r = 0; r < _Requests; r++) {
+        parcArenaMemory_Push(arena);
+        _request(deallocate);
+        parcArenaMemory_Pop();
+        parcArenaMemory_Reset(arena);
+    }
+    double result = _elapsed(&start);
+
+    parcArenaMemory_Release(&arena);
+    return result;
+}
+
+LONGBOW_TEST_CASE(Performance, Arena_vs_Stdlib)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int r = 0; r < _Requests; r++) {
+        _request(true);
+    }
+    double stdlibTime = _elapsed(&start);
+
+    double arenaTime = _arenaTime(true);
+    double abandonTime = _arenaTime(false);
+
+    parcMemory_SetInterface(original);
+
+    printf("%d requests of %d allocations: stdlib %.3fs, arena %.3fs (%.2fx), arena without deallocation %.3fs (%.2fx)\n",
+           _Requests, _AllocationsPerRequest, stdlibTime,
+           arenaTime, stdlibTime / arenaTime, abandonTime, stdlibTime / abandonTime);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ArenaMemory);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -31,6 +31,7 @@
 #include <string.h>
 
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_ThreadCachingMemory.h>
 #include <parc/testing/parc_ObjectTesting.h>
 
 #include <parc/algol/parc_Buffer.h>
@@ -324,6 +325,30 @@ LONGBOW_TEST_CASE(Local, PARC_ArrayList_EnsureRemaining_NonEmpty)
     parcArrayList_Destroy(&array);
 }
 
+LONGBOW_TEST_CASE(Local, PARC_ArrayList_EnsureRemaining_GoodSize)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCThreadCachingMemoryAsPARCMemory);
+
+    PARCArrayList *array = parcArrayList_Create(NULL);
+    _ensureRemaining(array, 5);
+
+    // The capacity is rounded up to fill the 48 byte size class.
+    size_t expected = parcThreadCachingMemory_GoodSize(5 * sizeof(void *)) / sizeof(void *);
+    assertTrue(array->limit == expected, "Expected a capacity of %zd, actual %zd", expected, array->limit);
+
+    for (size_t i = 0; i < 1000; i++) {
+        parcArrayList_Add(array, (void *) i);
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        assertTrue(parcArrayList_Get(array, i) == (void *) i, "Expected element %zd to be preserved.", i);
+    }
+    parcArrayList_Destroy(&array);
+
+    assertTrue(parcThreadCachingMemory_Outstanding() == 0,
+               "Expected no outstanding allocations, actual %u", parcThreadCachingMemory_Outstanding());
+    parcMemory_SetInterface(original);
+}
+
 LONGBOW_TEST_CASE(Global, PARC_ArrayList_FromInitialCapacity)
 {
     PARCArrayList *array = parcArrayList_Create_Capacity(NULL, parcArrayList_StdlibFreeFunction, 10);
@@ -610,6 +635,7 @@ LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, PARC_ArrayList_EnsureRemaining_Empty);
     LONGBOW_RUN_TEST_CASE(Local, PARC_ArrayList_EnsureRemaining_NonEmpty);
+    LONGBOW_RUN_TEST_CASE(Local, PARC_ArrayList_EnsureRemaining_GoodSize);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -31,6 +31,7 @@
 // This permits internal static functions to be visible to this Test Framework.
 #include "../parc_Base64.c"
 #include <parc/algol/parc_SafeMemory.h>
+#include <sys/time.h>
 
 LONGBOW_TEST_RUNNER(parc_Base64)
 {
@@ -39,6 +40,7 @@ LONGBOW_TEST_RUNNER(parc_Base64)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -59,6 +61,17 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcBase64_Decode_Linefeeds);
     LONGBOW_RUN_TEST_CASE(Global, parcBase64_Encode);
     LONGBOW_RUN_TEST_CASE(Global, parcBase64_Encode_Binary);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_Decode_Invalid);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_Decode_Truncated);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_URLSafe);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_MaximumLengths);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_SetLevel);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_EncodeToArray_Levels);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodeToArray_Levels);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodeToArray_LineBreaks);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64_DecodeToArray_InvalidAnywhere);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64Encoder_Chunks);
+    LONGBOW_RUN_TEST_CASE(Global, parcBase64Decoder_Chunks);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -227,6 +240,291 @@ LONGBOW_TEST_CASE(Global, parcBase64_Encode_Binary)
     }
 }
 
+static const PARCBase64Level _levels[] = { PARCBase64Level_Scalar, PARCBase64Level_SSSE3, PARCBase64Level_AVX2 };
+
+#define _levelCount (sizeof(_levels) / sizeof(_levels[0]))
+
+// Fill the array with arbitrary, but repeatable, bytes.
+static void
+_fill(size_t length, uint8_t array[length], uint32_t seed)
+{
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        array[i] = (uint8_t) (seed >> 16);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_Decode_Invalid)
+{
+    PARCBufferComposer *output = parcBufferComposer_Create();
+    parcBufferComposer_PutString(output, "abc");
+
+    assertNull(parcBase64_DecodeString(output, "Zm9vYmFy@m9v"), "Expected NULL for a non-base64 character");
+    assertTrue(parcBuffer_Position(parcBufferComposer_GetBuffer(output)) == 3,
+               "Expected the output to be left at its starting position");
+
+    parcBufferComposer_Release(&output);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_Decode_Truncated)
+{
+    PARCBufferComposer *output = parcBufferComposer_Create();
+
+    assertNull(parcBase64_DecodeString(output, "Zm9vYmE"), "Expected NULL for a padded encoding missing its padding");
+    assertNull(parcBase64_DecodeString(output, "Zm9vY"), "Expected NULL for a padded encoding missing its padding");
+    assertTrue(parcBuffer_Position(parcBufferComposer_GetBuffer(output)) == 0,
+               "Expected the output to be left at its starting position");
+
+    parcBufferComposer_Release(&output);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_URLSafe)
+{
+    uint8_t plaintext[] = { 0xFB, 0xFF, 0xBF, 0xFB, 0xFF };
+
+    PARCBufferComposer *standard = parcBufferComposer_Create();
+    parcBase64_EncodeArray(standard, sizeof(plaintext), plaintext);
+    char *standardString = parcBufferComposer_ToString(standard);
+    assertTrue(strcmp(standardString, "+/+/+/8=") == 0, "Expected '+/+/+/8=', actual '%s'", standardString);
+
+    PARCBufferComposer *urlSafe = parcBufferComposer_Create();
+    parcBase64_EncodeArrayWithAlphabet(urlSafe, PARCBase64Alphabet_URLSafe, sizeof(plaintext), plaintext);
+    char *urlSafeString = parcBufferComposer_ToString(urlSafe);
+    assertTrue(strcmp(urlSafeString, "-_-_-_8") == 0, "Expected '-_-_-_8', actual '%s'", urlSafeString);
+
+    // The URL-safe decoding accepts the encoding with or without its padding, but not the standard symbols.
+    const char *encodings[] = { "-_-_-_8", "-_-_-_8=" };
+    for (size_t i = 0; i < 2; i++) {
+        uint8_t decoded[6];
+        size_t length = parcBase64_DecodeToArray(PARCBase64Alphabet_URLSafe, strlen(encodings[i]), (uint8_t *) encodings[i], decoded);
+        assertTrue(length == sizeof(plaintext), "Expected %zd bytes from '%s', actual %zd", sizeof(plaintext), encodings[i], length);
+        assertTrue(memcmp(decoded, plaintext, sizeof(plaintext)) == 0, "Wrong decoding of '%s'", encodings[i]);
+    }
+
+    uint8_t decoded[6];
+    assertTrue(parcBase64_DecodeToArray(PARCBase64Alphabet_URLSafe, 8, (uint8_t *) standardString, decoded) == SIZE_MAX,
+               "Expected the URL-safe alphabet to reject '+' and '/'");
+    assertTrue(parcBase64_DecodeToArray(PARCBase64Alphabet_Standard, 7, (uint8_t *) urlSafeString, decoded) == SIZE_MAX,
+               "Expected the standard alphabet to reject '-' and '_'");
+    assertTrue(parcBase64_DecodeToArray(PARCBase64Alphabet_URLSafe, 5, (uint8_t *) "Zm9vY", decoded) == SIZE_MAX,
+               "Expected a single trailing character to be rejected");
+
+    parcMemory_Deallocate((void **) &standardString);
+    parcMemory_Deallocate((void **) &urlSafeString);
+    parcBufferComposer_Release(&standard);
+    parcBufferComposer_Release(&urlSafe);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_MaximumLengths)
+{
+    assertTrue(parcBase64_MaximumEncodedLength(0) == 0, "Expected 0");
+    assertTrue(parcBase64_MaximumEncodedLength(1) == 4, "Expected 4");
+    assertTrue(parcBase64_MaximumEncodedLength(3) == 4, "Expected 4");
+    assertTrue(parcBase64_MaximumEncodedLength(4) == 8, "Expected 8");
+
+    assertTrue(parcBase64_MaximumDecodedLength(0) == 0, "Expected 0");
+    assertTrue(parcBase64_MaximumDecodedLength(3) == 3, "Expected 3");
+    assertTrue(parcBase64_MaximumDecodedLength(4) == 3, "Expected 3");
+    assertTrue(parcBase64_MaximumDecodedLength(5) == 6, "Expected 6");
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_SetLevel)
+{
+    PARCBase64Level supported = parcBase64_GetLevel();
+
+    PARCBase64Level previous = parcBase64_SetLevel(PARCBase64Level_Scalar);
+    assertTrue(previous == supported, "Expected the previous level %d, actual %d", supported, previous);
+    assertTrue(parcBase64_GetLevel() == PARCBase64Level_Scalar, "Expected the scalar level");
+
+    parcBase64_SetLevel(PARCBase64Level_AVX2);
+    assertTrue(parcBase64_GetLevel() == supported, "Expected the level to be limited to %d, actual %d", supported, parcBase64_GetLevel());
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_EncodeToArray_Levels)
+{
+    uint8_t plaintext[300];
+    _fill(sizeof(plaintext), plaintext, 1);
+
+    PARCBase64Level previous = parcBase64_GetLevel();
+
+    for (int a = PARCBase64Alphabet_Standard; a <= PARCBase64Alphabet_URLSafe; a++) {
+        for (size_t length = 0; length <= sizeof(plaintext); length++) {
+            uint8_t expected[400];
+            parcBase64_SetLevel(PARCBase64Level_Scalar);
+            size_t expectedLength = parcBase64_EncodeToArray(a, length, plaintext, expected);
+
+            for (size_t i = 1; i < _levelCount; i++) {
+                parcBase64_SetLevel(_levels[i]);
+                uint8_t actual[400];
+                size_t actualLength = parcBase64_EncodeToArray(a, length, plaintext, actual);
+                assertTrue(actualLength == expectedLength && memcmp(actual, expected, expectedLength) == 0,
+                           "Level %d differs from the scalar encoding of %zd bytes", _levels[i], length);
+            }
+
+            // Check the scalar encoding against the decoder of a single quantum.
+            size_t decodedLength = 0;
+            uint8_t decoded[300];
+            for (size_t i = 0; i < expectedLength; i += 4) {
+                uint8_t quantum[4] = { pad, pad, pad, pad };
+                memcpy(quantum, &expected[i], (expectedLength - i < 4) ? expectedLength - i : 4);
+                decodedLength += _decode(_alphabet(a), &decoded[decodedLength], quantum);
+            }
+            assertTrue(decodedLength == length && memcmp(decoded, plaintext, length) == 0,
+                       "The encoding of %zd bytes does not decode", length);
+        }
+    }
+
+    parcBase64_SetLevel(previous);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodeToArray_Levels)
+{
+    uint8_t plaintext[300];
+    _fill(sizeof(plaintext), plaintext, 2);
+
+    PARCBase64Level previous = parcBase64_GetLevel();
+
+    for (int a = PARCBase64Alphabet_Standard; a <= PARCBase64Alphabet_URLSafe; a++) {
+        for (size_t length = 0; length <= sizeof(plaintext); length++) {
+            uint8_t encoded[400];
+            size_t encodedLength = parcBase64_EncodeToArray(a, length, plaintext, encoded);
+
+            for (size_t i = 0; i < _levelCount; i++) {
+                parcBase64_SetLevel(_levels[i]);
+                uint8_t decoded[300];
+                size_t decodedLength = parcBase64_DecodeToArray(a, encodedLength, encoded, decoded);
+                assertTrue(decodedLength == length && memcmp(decoded, plaintext, length) == 0,
+                           "Level %d failed to decode %zd bytes", _levels[i], length);
+            }
+        }
+    }
+
+    parcBase64_SetLevel(previous);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodeToArray_LineBreaks)
+{
+    uint8_t plaintext[240];
+    _fill(sizeof(plaintext), plaintext, 3);
+
+    uint8_t encoded[320];
+    size_t encodedLength = parcBase64_EncodeToArray(PARCBase64Alphabet_Standard, sizeof(plaintext), plaintext, encoded);
+
+    PARCBase64Level previous = parcBase64_GetLevel();
+
+    // A line break at every position, which is not necessarily a quantum boundary.
+    for (size_t breakAt = 0; breakAt <= encodedLength; breakAt++) {
+        uint8_t broken[330];
+        memcpy(broken, encoded, breakAt);
+        broken[breakAt] = '\r';
+        broken[breakAt + 1] = '\n';
+        memcpy(&broken[breakAt + 2], &encoded[breakAt], encodedLength - breakAt);
+
+        for (size_t i = 0; i < _levelCount; i++) {
+            parcBase64_SetLevel(_levels[i]);
+            uint8_t decoded[sizeof(plaintext) + 3];
+            size_t decodedLength = parcBase64_DecodeToArray(PARCBase64Alphabet_Standard, encodedLength + 2, broken, decoded);
+            assertTrue(decodedLength == sizeof(plaintext) && memcmp(decoded, plaintext, sizeof(plaintext)) == 0,
+                       "Level %d failed with a line break at %zd", _levels[i], breakAt);
+        }
+    }
+
+    parcBase64_SetLevel(previous);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64_DecodeToArray_InvalidAnywhere)
+{
+    uint8_t plaintext[240];
+    _fill(sizeof(plaintext), plaintext, 4);
+
+    uint8_t encoded[320];
+    size_t encodedLength = parcBase64_EncodeToArray(PARCBase64Alphabet_Standard, sizeof(plaintext), plaintext, encoded);
+
+    PARCBase64Level previous = parcBase64_GetLevel();
+
+    const uint8_t invalidCharacters[] = { '@', '-', '_', ' ', 0x80, 0xFF, 0 };
+    for (size_t position = 0; position < encodedLength; position++) {
+        for (size_t c = 0; c < sizeof(invalidCharacters); c++) {
+            uint8_t corrupt[320];
+            memcpy(corrupt, encoded, encodedLength);
+            corrupt[position] = invalidCharacters[c];
+
+            for (size_t i = 0; i < _levelCount; i++) {
+                parcBase64_SetLevel(_levels[i]);
+                uint8_t decoded[sizeof(plaintext)];
+                size_t decodedLength = parcBase64_DecodeToArray(PARCBase64Alphabet_Standard, encodedLength, corrupt, decoded);
+                assertTrue(decodedLength == SIZE_MAX, "Level %d decoded 0x%02x at %zd", _levels[i], invalidCharacters[c], position);
+            }
+        }
+    }
+
+    parcBase64_SetLevel(previous);
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64Encoder_Chunks)
+{
+    uint8_t plaintext[1000];
+    _fill(sizeof(plaintext), plaintext, 5);
+
+    for (int a = PARCBase64Alphabet_Standard; a <= PARCBase64Alphabet_URLSafe; a++) {
+        uint8_t expected[1400];
+        size_t expectedLength = parcBase64_EncodeToArray(a, sizeof(plaintext), plaintext, expected);
+
+        for (size_t chunk = 1; chunk <= 50; chunk++) {
+            PARCBase64Encoder encoder;
+            parcBase64Encoder_Init(&encoder, a);
+
+            uint8_t actual[1400];
+            size_t actualLength = 0;
+            for (size_t offset = 0; offset < sizeof(plaintext); offset += chunk) {
+                size_t length = (sizeof(plaintext) - offset < chunk) ? sizeof(plaintext) - offset : chunk;
+                actualLength += parcBase64Encoder_Update(&encoder, length, &plaintext[offset], &actual[actualLength]);
+            }
+            actualLength += parcBase64Encoder_Finish(&encoder, &actual[actualLength]);
+
+            assertTrue(actualLength == expectedLength && memcmp(actual, expected, expectedLength) == 0,
+                       "Encoding in chunks of %zd differs from encoding at once", chunk);
+        }
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcBase64Decoder_Chunks)
+{
+    uint8_t plaintext[1000];
+    _fill(sizeof(plaintext), plaintext, 6);
+
+    for (int a = PARCBase64Alphabet_Standard; a <= PARCBase64Alphabet_URLSafe; a++) {
+        uint8_t encoded[1400];
+        size_t encodedLength = parcBase64_EncodeToArray(a, sizeof(plaintext), plaintext, encoded);
+
+        for (size_t chunk = 1; chunk <= 50; chunk++) {
+            PARCBase64Decoder decoder;
+            parcBase64Decoder_Init(&decoder, a);
+
+            uint8_t decoded[1000 + 3];
+            size_t decodedLength = 0;
+            for (size_t offset = 0; offset < encodedLength; offset += chunk) {
+                size_t length = (encodedLength - offset < chunk) ? encodedLength - offset : chunk;
+                size_t n = parcBase64Decoder_Update(&decoder, length, &encoded[offset], &decoded[decodedLength]);
+                assertTrue(n != SIZE_MAX, "Decoding failed in chunks of %zd at %zd", chunk, offset);
+                decodedLength += n;
+            }
+            size_t n = parcBase64Decoder_Finish(&decoder, &decoded[decodedLength]);
+            assertTrue(n != SIZE_MAX, "Finishing failed in chunks of %zd", chunk);
+            decodedLength += n;
+
+            assertTrue(decodedLength == sizeof(plaintext) && memcmp(decoded, plaintext, sizeof(plaintext)) == 0,
+                       "Decoding in chunks of %zd differs from the plaintext", chunk);
+        }
+    }
+
+    PARCBase64Decoder decoder;
+    parcBase64Decoder_Init(&decoder, PARCBase64Alphabet_Standard);
+    uint8_t decoded[3];
+    assertTrue(parcBase64Decoder_Update(&decoder, 3, (uint8_t *) "Zm9", decoded) == 0, "Expected an incomplete quantum to be held");
+    assertTrue(parcBase64Decoder_Finish(&decoder, decoded) == SIZE_MAX, "Expected an incomplete padded quantum to fail");
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, encodeWithPad_0);
@@ -264,7 +562,9 @@ LONGBOW_TEST_CASE(Local, encodeWithPad_0)
     parcBufferComposer_PutString(truth, "Zm9v");
     PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
 
-    _encodeWithPad(output, input, 0);
+    uint8_t encoded[4];
+    size_t encodedLength = _encodeWithPad(_alphabet(PARCBase64Alphabet_Standard), encoded, input, 0);
+    parcBufferComposer_PutArray(output, encoded, encodedLength);
     PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
     assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
                "Failed 3-byte encode, expected '%s' got '%s'",
@@ -289,7 +589,9 @@ LONGBOW_TEST_CASE(Local, encodeWithPad_1)
     parcBufferComposer_PutString(truth, "Zm8=");
     PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
 
-    _encodeWithPad(output, input, 1);
+    uint8_t encoded[4];
+    size_t encodedLength = _encodeWithPad(_alphabet(PARCBase64Alphabet_Standard), encoded, input, 1);
+    parcBufferComposer_PutArray(output, encoded, encodedLength);
     PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
 
     assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
@@ -315,7 +617,9 @@ LONGBOW_TEST_CASE(Local, encodeWithPad_2)
     parcBufferComposer_PutString(truth, "Zg==");
     PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
 
-    _encodeWithPad(output, input, 2);
+    uint8_t encoded[4];
+    size_t encodedLength = _encodeWithPad(_alphabet(PARCBase64Alphabet_Standard), encoded, input, 2);
+    parcBufferComposer_PutArray(output, encoded, encodedLength);
     PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
 
     assertTrue(parcBuffer_Equals(truthBuffer, outputBuffer),
@@ -339,7 +643,12 @@ LONGBOW_TEST_CASE(Local, decode_1)
     parcBufferComposer_PutString(truth, "f");
     PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
 
-    bool success = _decode(output, input);
+    uint8_t decoded[3];
+    int decodedLength = _decode(_alphabet(PARCBase64Alphabet_Standard), decoded, input);
+    bool success = decodedLength >= 0;
+    if (success) {
+        parcBufferComposer_PutArray(output, decoded, (size_t) decodedLength);
+    }
     assertTrue(success, "Valid base64 failed decode");
 
     PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
@@ -363,7 +672,12 @@ LONGBOW_TEST_CASE(Local, decode_2)
     parcBufferComposer_PutString(truth, "fo");
     PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
 
-    bool success = _decode(output, input);
+    uint8_t decoded[3];
+    int decodedLength = _decode(_alphabet(PARCBase64Alphabet_Standard), decoded, input);
+    bool success = decodedLength >= 0;
+    if (success) {
+        parcBufferComposer_PutArray(output, decoded, (size_t) decodedLength);
+    }
     assertTrue(success, "Valid base64 failed decode");
 
     PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
@@ -388,7 +702,12 @@ LONGBOW_TEST_CASE(Local, decode_3)
     parcBufferComposer_PutString(truth, "foo");
     PARCBuffer *truthBuffer = parcBufferComposer_ProduceBuffer(truth);
 
-    bool success = _decode(output, input);
+    uint8_t decoded[3];
+    int decodedLength = _decode(_alphabet(PARCBase64Alphabet_Standard), decoded, input);
+    bool success = decodedLength >= 0;
+    if (success) {
+        parcBufferComposer_PutArray(output, decoded, (size_t) decodedLength);
+    }
     assertTrue(success, "Valid base64 failed decode");
     PARCBuffer *outputBuffer = parcBufferComposer_ProduceBuffer(output);
 
@@ -409,12 +728,160 @@ LONGBOW_TEST_CASE(Local, decode_invalid)
     PARCBufferComposer *output = parcBufferComposer_Create();
     uint8_t input[] = "@@@@";
 
-    bool success = _decode(output, input);
+    uint8_t decoded[3];
+    int decodedLength = _decode(_alphabet(PARCBase64Alphabet_Standard), decoded, input);
+    bool success = decodedLength >= 0;
+    if (success) {
+        parcBufferComposer_PutArray(output, decoded, (size_t) decodedLength);
+    }
     assertFalse(success, "Invalid base64 somehow decoded");
 
     parcBufferComposer_Release(&output);
 }
 
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, Encode);
+    LONGBOW_RUN_TEST_CASE(Performance, Decode);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static const size_t _sizes[] = { 32, 1024, 1024 * 1024 };
+
+// Encode or decode this many bytes in total for each size.
+#define _bytesPerMeasurement (256 * 1024 * 1024)
+
+static double
+_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+static void
+_report(const char *name, PARCBase64Level level, size_t size, double seconds)
+{
+    static const char *levelNames[] = { "scalar", "SSSE3", "AVX2" };
+    printf("%-20s %-6s %8zd bytes %8.3f GB/s\n", name, levelNames[level], size, _bytesPerMeasurement / seconds / 1e9);
+}
+
+// The implementation of parcBase64_EncodeArray before it encoded into the composer's free space.
+static void
+_previousEncodeArray(PARCBufferComposer *output, size_t length, const uint8_t array[length])
+{
+    for (size_t offset = 0; offset < length; offset += 3) {
+        size_t padLength = (length - offset < 3) ? 3 - (length - offset) : 0;
+        uint8_t quantum[3] = { 0, 0, 0 };
+        memcpy(quantum, &array[offset], 3 - padLength);
+        for (size_t index = 0; index < 4; index++) {
+            int sixbit = 0;
+            switch (index) {
+                case 0: sixbit = quantum[0] >> 2; break;
+                case 1: sixbit = ((quantum[0] & 0x03) << 4) | (quantum[1] >> 4); break;
+                case 2: sixbit = ((quantum[1] & 0x0F) << 2) | (quantum[2] >> 6); break;
+                case 3: sixbit = quantum[2] & 0x3F; break;
+            }
+            parcBufferComposer_PutUint8(output, (index + padLength < 4) ? base64code[sixbit] : pad);
+        }
+    }
+}
+
+LONGBOW_TEST_CASE(Performance, Encode)
+{
+    PARCBase64Level previous = parcBase64_GetLevel();
+
+    for (size_t s = 0; s < sizeof(_sizes) / sizeof(_sizes[0]); s++) {
+        size_t size = _sizes[s];
+        size_t iterations = _bytesPerMeasurement / size;
+
+        uint8_t *plaintext = parcMemory_Allocate(size);
+        _fill(size, plaintext, 7);
+        uint8_t *encoded = parcMemory_Allocate(parcBase64_MaximumEncodedLength(size));
+
+        PARCBufferComposer *composer = parcBufferComposer_Allocate(parcBase64_MaximumEncodedLength(size));
+        double start = _seconds();
+        for (size_t i = 0; i < iterations / 16; i++) {
+            parcBuffer_SetPosition(parcBufferComposer_GetBuffer(composer), 0);
+            _previousEncodeArray(composer, size, plaintext);
+        }
+        printf("%-20s %-6s %8zd bytes %8.3f GB/s\n", "Encode previous", "", size,
+               (double) (iterations / 16) * size / (_seconds() - start) / 1e9);
+
+        for (size_t l = 0; l < _levelCount; l++) {
+            parcBase64_SetLevel(_levels[l]);
+            if (parcBase64_GetLevel() != _levels[l]) {
+                continue;
+            }
+
+            start = _seconds();
+            for (size_t i = 0; i < iterations; i++) {
+                parcBase64_EncodeToArray(PARCBase64Alphabet_Standard, size, plaintext, encoded);
+            }
+            _report("EncodeToArray", _levels[l], size, _seconds() - start);
+
+            start = _seconds();
+            for (size_t i = 0; i < iterations; i++) {
+                parcBuffer_SetPosition(parcBufferComposer_GetBuffer(composer), 0);
+                parcBase64_EncodeArray(composer, size, plaintext);
+            }
+            _report("EncodeArray", _levels[l], size, _seconds() - start);
+        }
+
+        parcBufferComposer_Release(&composer);
+        parcMemory_Deallocate((void **) &encoded);
+        parcMemory_Deallocate((void **) &plaintext);
+    }
+
+    parcBase64_SetLevel(previous);
+}
+
+LONGBOW_TEST_CASE(Performance, Decode)
+{
+    PARCBase64Level previous = parcBase64_GetLevel();
+
+    for (size_t s = 0; s < sizeof(_sizes) / sizeof(_sizes[0]); s++) {
+        size_t size = _sizes[s];
+        size_t iterations = _bytesPerMeasurement / size;
+
+        uint8_t *plaintext = parcMemory_Allocate(size);
+        _fill(size, plaintext, 8);
+        uint8_t *encoded = parcMemory_Allocate(parcBase64_MaximumEncodedLength(size));
+        size_t encodedLength = parcBase64_EncodeToArray(PARCBase64Alphabet_Standard, size, plaintext, encoded);
+        uint8_t *decoded = parcMemory_Allocate(parcBase64_MaximumDecodedLength(encodedLength));
+
+        // Report decoding in bytes of output, like encoding, for comparison.
+        for (size_t l = 0; l < _levelCount; l++) {
+            parcBase64_SetLevel(_levels[l]);
+            if (parcBase64_GetLevel() != _levels[l]) {
+                continue;
+            }
+
+            double start = _seconds();
+            for (size_t i = 0; i < iterations; i++) {
+                size_t length = parcBase64_DecodeToArray(PARCBase64Alphabet_Standard, encodedLength, encoded, decoded);
+                assertTrue(length == size, "Expected %zd bytes, actual %zd", size, length);
+            }
+            _report("DecodeToArray", _levels[l], size, _seconds() - start);
+        }
+
+        parcMemory_Deallocate((void **) &decoded);
+        parcMemory_Deallocate((void **) &encoded);
+        parcMemory_Deallocate((void **) &plaintext);
+    }
+
+    parcBase64_SetLevel(previous);
+}
+
 int
 main(int argc, char *argv[])
 {
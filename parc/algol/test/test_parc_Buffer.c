@@ -42,6 +42,11 @@
 // This permits internal static functions to be visible to this Test Framework.
 #include "../parc_Buffer.c"
 
+#include <sys/time.h>
+
+#include <parc/algol/parc_HashMap.h>
+#include <parc/algol/parc_JSON.h>
+
 LONGBOW_TEST_RUNNER(parcBuffer)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -80,6 +85,11 @@ LONGBOW_TEST_FIXTURE(CreateDestroy)
     LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_Wrap_NULL);
     LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_Wrap_WithOffset);
     LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_AllocateCString);
+    LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_MapFile);
+    LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_MapFile_Empty);
+    LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_MapFile_NotFound);
+    LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_MapFile_Shared);
+    LONGBOW_RUN_TEST_CASE(CreateDestroy, parcBuffer_MapFile_JSON);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(CreateDestroy)
@@ -162,6 +172,108 @@ LONGBOW_TEST_CASE(CreateDestroy, parcBuffer_AllocateCString)
     parcBuffer_Release(&buffer);
 }
 
+/**
+ * Create a temporary file with the content @p content, and return a PARCFile of it.
+ */
+static PARCFile *
+_createMappableFile(char *pathName, const char *content)
+{
+    int fd = mkstemp(pathName);
+    assertTrue(fd >= 0, "mkstemp(%s) failed: %s", pathName, strerror(errno));
+    ssize_t written = write(fd, content, strlen(content));
+    assertTrue(written == (ssize_t) strlen(content), "write failed: %s", strerror(errno));
+    close(fd);
+
+    return parcFile_Create(pathName);
+}
+
+LONGBOW_TEST_CASE(CreateDestroy, parcBuffer_MapFile)
+{
+    char pathName[] = "/tmp/test_parc_Buffer_XXXXXX";
+    PARCFile *file = _createMappableFile(pathName, "Hello World");
+
+    PARCBuffer *actual = parcBuffer_MapFile(file, PARCByteArrayMap_ReadOnly);
+    unlink(pathName);
+
+    assertNotNull(actual, "Expected the file to be mapped.");
+    assertTrue(parcByteArray_IsMapped(parcBuffer_Array(actual)), "Expected the buffer to be mapped.");
+    assertTrue(parcBuffer_Position(actual) == 0, "Expected position 0, actual %zd", parcBuffer_Position(actual));
+
+    PARCBuffer *expected = parcBuffer_WrapCString("Hello World");
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the content of the file.");
+    assertTrue(parcBuffer_Advise(actual, PARCByteArrayAdvice_Sequential), "Expected the advice to be accepted.");
+    assertFalse(parcBuffer_Advise(expected, PARCByteArrayAdvice_Sequential), "Expected no advice for a buffer that is not mapped.");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&actual);
+    parcFile_Release(&file);
+}
+
+LONGBOW_TEST_CASE(CreateDestroy, parcBuffer_MapFile_Empty)
+{
+    char pathName[] = "/tmp/test_parc_Buffer_XXXXXX";
+    PARCFile *file = _createMappableFile(pathName, "");
+
+    PARCBuffer *actual = parcBuffer_MapFile(file, PARCByteArrayMap_ReadOnly);
+    unlink(pathName);
+
+    assertNotNull(actual, "Expected an empty buffer for an empty file.");
+    assertTrue(parcBuffer_Remaining(actual) == 0, "Expected nothing remaining, actual %zd", parcBuffer_Remaining(actual));
+
+    parcBuffer_Release(&actual);
+    parcFile_Release(&file);
+}
+
+LONGBOW_TEST_CASE(CreateDestroy, parcBuffer_MapFile_NotFound)
+{
+    PARCFile *file = parcFile_Create("/tmp/test_parc_Buffer_does_not_exist");
+
+    PARCBuffer *actual = parcBuffer_MapFile(file, PARCByteArrayMap_ReadOnly);
+    assertNull(actual, "Expected NULL for a file that does not exist.");
+    assertTrue(errno == ENOENT, "Expected errno ENOENT, actual %d", errno);
+
+    parcFile_Release(&file);
+}
+
+LONGBOW_TEST_CASE(CreateDestroy, parcBuffer_MapFile_Shared)
+{
+    char pathName[] = "/tmp/test_parc_Buffer_XXXXXX";
+    PARCFile *file = _createMappableFile(pathName, "Hello World");
+
+    PARCBuffer *buffer = parcBuffer_MapFile(file, PARCByteArrayMap_Shared);
+    parcBuffer_PutUint8(buffer, 'J');
+    parcBuffer_Release(&buffer);
+
+    buffer = parcBuffer_MapFile(file, PARCByteArrayMap_ReadOnly);
+    unlink(pathName);
+
+    char *actual = parcBuffer_ToString(buffer);
+    assertTrue(strcmp(actual, "Jello World") == 0, "Expected the change to be written to the file, actual %s", actual);
+
+    parcMemory_Deallocate(&actual);
+    parcBuffer_Release(&buffer);
+    parcFile_Release(&file);
+}
+
+LONGBOW_TEST_CASE(CreateDestroy, parcBuffer_MapFile_JSON)
+{
+    char pathName[] = "/tmp/test_parc_Buffer_XXXXXX";
+    PARCFile *file = _createMappableFile(pathName, "{ \"name\" : \"value\" }");
+
+    PARCBuffer *buffer = parcBuffer_MapFile(file, PARCByteArrayMap_ReadOnly);
+    unlink(pathName);
+
+    PARCJSON *json = parcJSON_ParseBuffer(buffer);
+    assertNotNull(json, "Expected a mapped buffer to be parsed.");
+
+    const PARCJSONValue *value = parcJSON_GetValueByName(json, "name");
+    assertNotNull(value, "Expected the member 'name'.");
+
+    parcJSON_Release(&json);
+    parcBuffer_Release(&buffer);
+    parcFile_Release(&file);
+}
+
 LONGBOW_TEST_CASE(CreateDestroy, parcBuffer_Allocate_AcquireRelease)
 {
     PARCBuffer *expected = parcBuffer_Allocate(10);
@@ -244,6 +356,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_HasRemaining);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_HashCode);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_HashCode_ZeroRemaining);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_HashCode_Frozen);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_Mark);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_Resize_Growing);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_Resize_Growing_AtLimit);
@@ -274,6 +387,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_SkipTo);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindUint8);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindUint8_NotFound);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindUint8_Slice);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindBytes);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_FindBytes_NotFound);
+    LONGBOW_RUN_TEST_CASE(Global, parcBuffer_SkipOver_Long);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_IsValid_True);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_ParseNumeric_Decimal);
     LONGBOW_RUN_TEST_CASE(Global, parcBuffer_ParseNumeric_Hexadecimal);
@@ -1078,6 +1195,46 @@ LONGBOW_TEST_CASE(Global, parcBuffer_HashCode_ZeroRemaining)
     parcBuffer_Release(&buffer1);
 }
 
+LONGBOW_TEST_CASE(Global, parcBuffer_HashCode_Frozen)
+{
+    uint8_t array[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, sizeof(array), 0, sizeof(array));
+    parcObject_Freeze(buffer);
+    assertTrue(parcObject_IsFrozen(buffer), "Expected the buffer to be frozen.");
+
+    PARCHashCode expected = _parcBuffer_HashCode(buffer);
+    assertTrue(parcBuffer_HashCode(buffer) == expected, "Expected the computed hashcode.");
+    assertTrue(parcBuffer_HashCode(buffer) == expected, "Expected the remembered hashcode.");
+
+    parcBuffer_SetPosition(buffer, 1);
+    expected = _parcBuffer_HashCode(buffer);
+    PARCHashCode actual = parcBuffer_HashCode(buffer);
+    assertTrue(actual == expected, "Expected SetPosition to invalidate the hashcode.");
+
+    parcBuffer_SetLimit(buffer, 5);
+    expected = _parcBuffer_HashCode(buffer);
+    actual = parcBuffer_HashCode(buffer);
+    assertTrue(actual == expected, "Expected SetLimit to invalidate the hashcode.");
+
+    parcBuffer_PutAtIndex(buffer, 2, 0xFF);
+    expected = _parcBuffer_HashCode(buffer);
+    actual = parcBuffer_HashCode(buffer);
+    assertTrue(actual == expected, "Expected PutAtIndex to invalidate the hashcode.");
+
+    parcBuffer_GetUint8(buffer);
+    expected = _parcBuffer_HashCode(buffer);
+    actual = parcBuffer_HashCode(buffer);
+    assertTrue(actual == expected, "Expected GetUint8 to invalidate the hashcode.");
+
+    parcBuffer_Flip(buffer);
+    expected = _parcBuffer_HashCode(buffer);
+    actual = parcBuffer_HashCode(buffer);
+    assertTrue(actual == expected, "Expected Flip to invalidate the hashcode.");
+
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(Global, parcBuffer_ToString)
 {
     uint8_t array[] = { 'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd', 'x' };
@@ -1187,6 +1344,76 @@ LONGBOW_TEST_CASE(Global, parcBuffer_FindUint8_NotFound)
     parcBuffer_Release(&buffer);
 }
 
+LONGBOW_TEST_CASE(Global, parcBuffer_FindUint8_Slice)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+    parcBuffer_SetPosition(buffer, 5);
+    PARCBuffer *slice = parcBuffer_Slice(buffer);
+
+    size_t index = parcBuffer_FindUint8(buffer, 'o');
+    assertTrue(index == 7, "Expected the index from the start of the buffer 7, actual %zu", index);
+
+    parcBuffer_SetPosition(slice, 1);
+    index = parcBuffer_FindUint8(slice, 'o');
+    assertTrue(index == 2, "Expected the index from the start of the slice 2, actual %zu", index);
+
+    parcBuffer_Release(&slice);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_FindBytes)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("GET / HTTP/1.1\r\nHost: parc.com\r\n\r\nbody\r\n\r\n");
+
+    size_t index = parcBuffer_FindBytes(buffer, 4, (uint8_t *) "\r\n\r\n");
+    assertTrue(index == 30, "Expected index to be 30, actual %zu", index);
+
+    parcBuffer_SetPosition(buffer, 31);
+    index = parcBuffer_FindBytes(buffer, 4, (uint8_t *) "\r\n\r\n");
+    assertTrue(index == 38, "Expected index to be 38, actual %zu", index);
+
+    index = parcBuffer_FindBytes(buffer, 0, NULL);
+    assertTrue(index == 31, "Expected an empty sequence at the position 31, actual %zu", index);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_FindBytes_NotFound)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+
+    size_t index = parcBuffer_FindBytes(buffer, 5, (uint8_t *) "World");
+    parcBuffer_SetLimit(buffer, 10);
+    size_t truncated = parcBuffer_FindBytes(buffer, 5, (uint8_t *) "World");
+
+    assertTrue(index == 6, "Expected index to be 6, actual %zu", index);
+    assertTrue(truncated == SIZE_MAX, "Expected SIZE_MAX beyond the limit, actual %zu", truncated);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBuffer_SkipOver_Long)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1000);
+    for (size_t i = 0; i < 1000; i++) {
+        parcBuffer_PutUint8(buffer, (i % 2) ? ' ' : '\t');
+    }
+    parcBuffer_PutAtIndex(buffer, 777, '{');
+    parcBuffer_Flip(buffer);
+    parcBuffer_SetPosition(buffer, 3);
+
+    bool actual = parcBuffer_SkipOver(buffer, 2, (uint8_t *) " \t");
+    assertTrue(actual, "Expected parcBuffer_SkipOver to return true.");
+    assertTrue(parcBuffer_Position(buffer) == 777, "Expected position 777, actual %zd", parcBuffer_Position(buffer));
+
+    parcBuffer_SetPosition(buffer, 0);
+    actual = parcBuffer_SkipTo(buffer, 1, (uint8_t *) "{");
+    assertTrue(actual, "Expected parcBuffer_SkipTo to return true.");
+    assertTrue(parcBuffer_Position(buffer) == 777, "Expected position 777, actual %zd", parcBuffer_Position(buffer));
+
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(Global, parcBuffer_IsValid_True)
 {
     PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
@@ -1247,6 +1474,10 @@ LONGBOW_TEST_FIXTURE(GettersSetters)
     LONGBOW_RUN_TEST_CASE(GettersSetters, parcPutGetUint16);
     LONGBOW_RUN_TEST_CASE(GettersSetters, parcPutGetUint32);
     LONGBOW_RUN_TEST_CASE(GettersSetters, parcPutGetUint64);
+    LONGBOW_RUN_TEST_CASE(GettersSetters, parcPutGetUint16Array);
+    LONGBOW_RUN_TEST_CASE(GettersSetters, parcPutGetUint32Array);
+    LONGBOW_RUN_TEST_CASE(GettersSetters, parcPutGetUint64Array);
+    LONGBOW_RUN_TEST_CASE(GettersSetters, parcGetUint32Array_Unaligned);
     LONGBOW_RUN_TEST_CASE(GettersSetters, parcBuffer_ToHexString);
     LONGBOW_RUN_TEST_CASE(GettersSetters, parcBuffer_ToHexString_NULLBuffer);
     LONGBOW_RUN_TEST_CASE(GettersSetters, parcBuffer_Display);
@@ -1323,6 +1554,88 @@ LONGBOW_TEST_CASE(GettersSetters, parcPutGetUint64)
     assertTrue(expected == actual, "Expected %" PRIu64 ", actual %" PRIu64 "", expected, actual);
 }
 
+LONGBOW_TEST_CASE(GettersSetters, parcPutGetUint16Array)
+{
+    uint16_t expected[] = { 0x0102, 0x0304, 0xFFFE, 0, 0x8000 };
+    size_t count = sizeof(expected) / sizeof(expected[0]);
+
+    PARCBuffer *buffer = parcBuffer_Allocate(sizeof(expected));
+    parcBuffer_PutUint16Array(buffer, count, expected);
+    assertTrue(parcBuffer_Position(buffer) == sizeof(expected), "Expected position %zd, actual %zd", sizeof(expected), parcBuffer_Position(buffer));
+    parcBuffer_Flip(buffer);
+
+    assertTrue(parcBuffer_GetAtIndex(buffer, 0) == 0x01 && parcBuffer_GetAtIndex(buffer, 1) == 0x02, "Expected network byte order.");
+
+    uint16_t actual[5];
+    parcBuffer_GetUint16Array(buffer, count, actual);
+    assertTrue(memcmp(expected, actual, sizeof(expected)) == 0, "Expected the values put to be got.");
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected nothing remaining, actual %zd", parcBuffer_Remaining(buffer));
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(GettersSetters, parcPutGetUint32Array)
+{
+    uint32_t expected[100];
+    for (uint32_t i = 0; i < 100; i++) {
+        expected[i] = i * 0x01010101;
+    }
+
+    PARCBuffer *buffer = parcBuffer_Allocate(sizeof(expected));
+    parcBuffer_PutUint32Array(buffer, 100, expected);
+    parcBuffer_Flip(buffer);
+
+    // The array is encoded exactly as if each value had been put on its own.
+    for (size_t i = 0; i < 100; i++) {
+        uint32_t actual = parcBuffer_GetUint32(buffer);
+        assertTrue(actual == expected[i], "Expected %u at %zd, actual %u", expected[i], i, actual);
+    }
+
+    parcBuffer_Rewind(buffer);
+    uint32_t actual[100];
+    parcBuffer_GetUint32Array(buffer, 100, actual);
+    assertTrue(memcmp(expected, actual, sizeof(expected)) == 0, "Expected the values put to be got.");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(GettersSetters, parcPutGetUint64Array)
+{
+    uint64_t expected[] = { 0x0102030405060708, UINT64_MAX, 0 };
+
+    PARCBuffer *buffer = parcBuffer_Allocate(sizeof(expected));
+    parcBuffer_PutUint64Array(buffer, 3, expected);
+    parcBuffer_Flip(buffer);
+
+    assertTrue(parcBuffer_GetAtIndex(buffer, 0) == 0x01 && parcBuffer_GetAtIndex(buffer, 7) == 0x08, "Expected network byte order.");
+
+    uint64_t actual[3];
+    parcBuffer_GetUint64Array(buffer, 3, actual);
+    assertTrue(memcmp(expected, actual, sizeof(expected)) == 0, "Expected the values put to be got.");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(GettersSetters, parcGetUint32Array_Unaligned)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1 + 3 * sizeof(uint32_t));
+    parcBuffer_PutUint8(buffer, 0xAA);
+    parcBuffer_PutUint32(buffer, 1);
+    parcBuffer_PutUint32(buffer, 2);
+    parcBuffer_PutUint32(buffer, 3);
+    parcBuffer_Flip(buffer);
+    parcBuffer_GetUint8(buffer);
+
+    uint32_t actual[3];
+    parcBuffer_GetUint32Array(buffer, 3, actual);
+    assertTrue(actual[0] == 1 && actual[1] == 2 && actual[2] == 3, "Expected 1, 2, 3, actual %u, %u, %u", actual[0], actual[1], actual[2]);
+
+    parcBuffer_GetUint32Array(buffer, 0, actual);
+    assertFalse(parcBuffer_HasRemaining(buffer), "Expected an empty array to be got at the end of the buffer.");
+
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(GettersSetters, parcBuffer_ToHexString)
 {
     PARCBuffer *buffer = longBowTestCase_GetClipBoardData(testCase);
@@ -1362,6 +1675,9 @@ LONGBOW_TEST_CASE(GettersSetters, parcBuffer_Display_NULL)
 LONGBOW_TEST_FIXTURE(Errors)
 {
     LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetByte_Underflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetUint32_Underflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_GetUint16Array_Underflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_PutUint64Array_Overflow);
     LONGBOW_RUN_TEST_CASE(Errors, parcBuffer_Mark_mark_exceeds_position);
 }
 
@@ -1407,6 +1723,33 @@ LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetByte_Underflow, .event = &LongBo
     parcBuffer_GetUint8(buffer); // this will fail.
 }
 
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetUint32_Underflow, .event = &LongBowTrapOutOfBounds)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    parcBuffer_SetPosition(buffer, 7);
+    parcBuffer_GetUint32(buffer); // this will fail.
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_GetUint16Array_Underflow, .event = &LongBowTrapOutOfBounds)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    uint16_t values[6];
+    parcBuffer_GetUint16Array(buffer, 6, values); // this will fail.
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_PutUint64Array_Overflow, .event = &LongBowAssertEvent)
+{
+    parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = testData->buffer;
+
+    uint64_t values[2] = { 1, 2 };
+    parcBuffer_PutUint64Array(buffer, 2, values); // this will fail.
+}
+
 LONGBOW_TEST_CASE_EXPECTS(Errors, parcBuffer_Mark_mark_exceeds_position, .event = &LongBowAssertEvent)
 {
     parcBuffer_LongBowClipBoard *testData = longBowTestCase_GetClipBoardData(testCase);
@@ -1475,6 +1818,7 @@ LONGBOW_TEST_CASE(Static, _digittoint)
 LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
 {
     LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_Create);
+    LONGBOW_RUN_TEST_CASE(Performance, parcBuffer_HashMap_Get_Frozen);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -1505,6 +1849,39 @@ LONGBOW_TEST_CASE(Performance, parcBuffer_Create)
     }
 }
 
+LONGBOW_TEST_CASE(Performance, parcBuffer_HashMap_Get_Frozen)
+{
+    const size_t keyLength = 1024;
+    const int lookups = 1000000;
+
+    PARCHashMap *map = parcHashMap_Create();
+
+    for (int frozen = 0; frozen < 2; frozen++) {
+        PARCBuffer *key = parcBuffer_Allocate(keyLength);
+        memset(parcBuffer_Overlay(key, 0), frozen, keyLength);
+        if (frozen) {
+            parcObject_Freeze(key);
+        }
+        parcHashMap_Put(map, key, key);
+
+        struct timeval start;
+        gettimeofday(&start, NULL);
+        for (int i = 0; i < lookups; i++) {
+            parcHashMap_Get(map, key);
+        }
+        struct timeval end;
+        gettimeofday(&end, NULL);
+
+        double seconds = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+        printf("parcHashMap_Get with a %zd byte key, %s: %.0f lookups/s\n",
+               keyLength, frozen ? "frozen" : "not frozen", lookups / seconds);
+
+        parcBuffer_Release(&key);
+    }
+
+    parcHashMap_Release(&map);
+}
+
 int
 main(int argc, char *argv[argc])
 {
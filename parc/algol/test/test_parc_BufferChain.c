@@ -0,0 +1,700 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_BufferChain.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_BufferComposer.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+/**
+ * Create a chain of the three fragments "ABC", "DE" and "FGHIJKLM".
+ */
+static PARCBufferChain *
+_createChain(void)
+{
+    PARCBuffer *a = parcBuffer_Flip(parcBuffer_CreateFromArray("ABC", 3));
+    PARCBuffer *b = parcBuffer_Flip(parcBuffer_CreateFromArray("DE", 2));
+    PARCBuffer *c = parcBuffer_Flip(parcBuffer_CreateFromArray("FGHIJKLM", 8));
+
+    PARCBufferChain *result = parcBufferChain_Create();
+    parcBufferChain_Append(result, a);
+    parcBufferChain_Append(result, b);
+    parcBufferChain_Append(result, c);
+
+    parcBuffer_Release(&a);
+    parcBuffer_Release(&b);
+    parcBuffer_Release(&c);
+    return result;
+}
+
+LONGBOW_TEST_RUNNER(parc_BufferChain)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Errors);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_BufferChain)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_BufferChain)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Create);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Append);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Append_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Append_ZeroCopy);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Append_Many);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_AppendByteArray);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_AppendChain);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_AppendChain_Self);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetFragment);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_SetLimit);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Flip);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetAtIndex);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetUint8);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetUint16);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetUint32);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetUint64);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetBytes);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_PutUint);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_PutArray);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetIOVec);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_GetIOVec_Partial);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Flatten);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Flatten_OneFragment);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Flatten_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Equals);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_HashCode);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferChain_Display);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Create)
+{
+    PARCBufferChain *chain = parcBufferChain_Create();
+    parcBufferChain_AssertValid(chain);
+
+    assertTrue(parcBufferChain_Capacity(chain) == 0, "Expected capacity 0, actual %zd", parcBufferChain_Capacity(chain));
+    assertTrue(parcBufferChain_Position(chain) == 0, "Expected position 0, actual %zd", parcBufferChain_Position(chain));
+    assertTrue(parcBufferChain_Limit(chain) == 0, "Expected limit 0, actual %zd", parcBufferChain_Limit(chain));
+    assertFalse(parcBufferChain_HasRemaining(chain), "Expected no bytes remaining.");
+    assertTrue(parcBufferChain_GetFragmentCount(chain) == 0, "Expected no fragments.");
+
+    parcBufferChain_Release(&chain);
+    assertNull(chain, "Expected the pointer to be set to NULL.");
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_AcquireRelease)
+{
+    PARCBufferChain *chain = _createChain();
+    parcObjectTesting_AssertAcquireReleaseImpl(chain);
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Append)
+{
+    PARCBufferChain *chain = _createChain();
+
+    assertTrue(parcBufferChain_Capacity(chain) == 13, "Expected capacity 13, actual %zd", parcBufferChain_Capacity(chain));
+    assertTrue(parcBufferChain_Limit(chain) == 13, "Expected limit 13, actual %zd", parcBufferChain_Limit(chain));
+    assertTrue(parcBufferChain_Position(chain) == 0, "Expected position 0, actual %zd", parcBufferChain_Position(chain));
+    assertTrue(parcBufferChain_GetFragmentCount(chain) == 3, "Expected 3 fragments, actual %zd", parcBufferChain_GetFragmentCount(chain));
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Append_Empty)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(10);
+    parcBuffer_SetPosition(buffer, 10);
+
+    PARCBufferChain *chain = parcBufferChain_Create();
+    parcBufferChain_Append(chain, buffer);
+    assertTrue(parcBufferChain_GetFragmentCount(chain) == 0, "Expected a buffer with nothing remaining not to be appended.");
+
+    parcBufferChain_Release(&chain);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Append_ZeroCopy)
+{
+    PARCBuffer *buffer = parcBuffer_Flip(parcBuffer_CreateFromArray("Hello World", 11));
+    parcBuffer_SetPosition(buffer, 6);
+
+    PARCBufferChain *chain = parcBufferChain_Create();
+    parcBufferChain_Append(chain, buffer);
+
+    // Later changes to the position of the buffer do not affect the chain, but changes to its content do.
+    parcBuffer_SetPosition(buffer, 0);
+    parcBuffer_PutAtIndex(buffer, 6, 'w');
+
+    assertTrue(parcBufferChain_Capacity(chain) == 5, "Expected capacity 5, actual %zd", parcBufferChain_Capacity(chain));
+    assertTrue(parcBufferChain_GetAtIndex(chain, 0) == 'w', "Expected the chain to share the memory of the buffer.");
+
+    struct iovec iov[1];
+    parcBufferChain_GetIOVec(chain, 1, iov);
+    assertTrue(iov[0].iov_base == parcByteArray_AddressOfIndex(parcBuffer_Array(buffer), 6),
+               "Expected the fragment to point into the memory of the buffer.");
+
+    parcBufferChain_Release(&chain);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Append_Many)
+{
+    PARCBuffer *buffer = parcBuffer_Flip(parcBuffer_CreateFromArray("0123456789", 10));
+
+    PARCBufferChain *chain = parcBufferChain_Create();
+    for (int i = 0; i < 100; i++) {
+        parcBufferChain_Append(chain, buffer);
+    }
+
+    assertTrue(parcBufferChain_GetFragmentCount(chain) == 100, "Expected 100 fragments, actual %zd", parcBufferChain_GetFragmentCount(chain));
+    for (size_t i = 0; i < 1000; i++) {
+        uint8_t actual = parcBufferChain_GetAtIndex(chain, i);
+        assertTrue(actual == '0' + i % 10, "Expected %c at %zd, actual %c", (char) ('0' + i % 10), i, actual);
+    }
+
+    parcBufferChain_Release(&chain);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_AppendByteArray)
+{
+    PARCByteArray *array = parcByteArray_Allocate(10);
+    for (size_t i = 0; i < 10; i++) {
+        parcByteArray_PutByte(array, i, (uint8_t) i);
+    }
+
+    PARCBufferChain *chain = parcBufferChain_Create();
+    parcBufferChain_AppendByteArray(chain, array, 2, 5);
+    parcBufferChain_AppendByteArray(chain, array, 0, 0);
+
+    assertTrue(parcBufferChain_Capacity(chain) == 5, "Expected capacity 5, actual %zd", parcBufferChain_Capacity(chain));
+    assertTrue(parcBufferChain_GetFragmentCount(chain) == 1, "Expected an empty range not to be appended.");
+    assertTrue(parcBufferChain_GetUint8(chain) == 2, "Expected the first byte to be at the offset.");
+
+    parcBufferChain_Release(&chain);
+    parcByteArray_Release(&array);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_AppendChain)
+{
+    PARCBufferChain *other = _createChain();
+    parcBufferChain_SetPosition(other, 4);
+    parcBufferChain_SetLimit(other, 7);
+
+    PARCBufferChain *chain = parcBufferChain_Create();
+    parcBufferChain_AppendChain(chain, other);
+
+    uint8_t actual[3];
+    parcBufferChain_GetBytes(chain, sizeof(actual), actual);
+    assertTrue(memcmp(actual, "EFG", 3) == 0, "Expected EFG, actual %.3s", actual);
+    assertTrue(parcBufferChain_GetFragmentCount(chain) == 2, "Expected 2 fragments, actual %zd", parcBufferChain_GetFragmentCount(chain));
+
+    parcBufferChain_Release(&chain);
+    parcBufferChain_Release(&other);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_AppendChain_Self)
+{
+    PARCBufferChain *chain = _createChain();
+    parcBufferChain_AppendChain(chain, chain);
+    parcBufferChain_AppendChain(chain, chain);
+
+    assertTrue(parcBufferChain_Capacity(chain) == 52, "Expected capacity 52, actual %zd", parcBufferChain_Capacity(chain));
+    for (size_t i = 0; i < 52; i++) {
+        uint8_t actual = parcBufferChain_GetAtIndex(chain, i);
+        assertTrue(actual == 'A' + i % 13, "Expected %c at %zd, actual %c", (char) ('A' + i % 13), i, actual);
+    }
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetFragment)
+{
+    PARCBufferChain *chain = _createChain();
+
+    PARCBuffer *fragment = parcBufferChain_GetFragment(chain, 1);
+    PARCBuffer *expected = parcBuffer_Flip(parcBuffer_CreateFromArray("DE", 2));
+    assertTrue(parcBuffer_Equals(fragment, expected), "Expected the second fragment to be DE");
+    assertTrue(parcBuffer_Position(fragment) == 0, "Expected the fragment at position 0.");
+
+    parcBuffer_Release(&expected);
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_SetLimit)
+{
+    PARCBufferChain *chain = _createChain();
+
+    parcBufferChain_SetPosition(chain, 10);
+    parcBufferChain_SetLimit(chain, 5);
+    assertTrue(parcBufferChain_Position(chain) == 5, "Expected the position to be set to the limit, actual %zd", parcBufferChain_Position(chain));
+    assertTrue(parcBufferChain_Remaining(chain) == 0, "Expected nothing remaining.");
+
+    parcBufferChain_Clear(chain);
+    assertTrue(parcBufferChain_Position(chain) == 0, "Expected position 0, actual %zd", parcBufferChain_Position(chain));
+    assertTrue(parcBufferChain_Limit(chain) == 13, "Expected limit 13, actual %zd", parcBufferChain_Limit(chain));
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Flip)
+{
+    PARCBufferChain *chain = _createChain();
+
+    parcBufferChain_SetPosition(chain, 4);
+    parcBufferChain_Flip(chain);
+    assertTrue(parcBufferChain_Position(chain) == 0, "Expected position 0, actual %zd", parcBufferChain_Position(chain));
+    assertTrue(parcBufferChain_Limit(chain) == 4, "Expected limit 4, actual %zd", parcBufferChain_Limit(chain));
+
+    parcBufferChain_SetPosition(chain, 2);
+    parcBufferChain_Rewind(chain);
+    assertTrue(parcBufferChain_Position(chain) == 0, "Expected position 0, actual %zd", parcBufferChain_Position(chain));
+    assertTrue(parcBufferChain_Limit(chain) == 4, "Expected limit 4, actual %zd", parcBufferChain_Limit(chain));
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetAtIndex)
+{
+    PARCBufferChain *chain = _createChain();
+
+    const char *expected = "ABCDEFGHIJKLM";
+    for (size_t i = 13; i > 0; i--) {
+        uint8_t actual = parcBufferChain_GetAtIndex(chain, i - 1);
+        assertTrue(actual == expected[i - 1], "Expected %c at %zd, actual %c", expected[i - 1], i - 1, actual);
+    }
+    assertTrue(parcBufferChain_Position(chain) == 0, "Expected the position not to change.");
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetUint8)
+{
+    PARCBufferChain *chain = _createChain();
+
+    const char *expected = "ABCDEFGHIJKLM";
+    for (size_t i = 0; i < 13; i++) {
+        uint8_t actual = parcBufferChain_GetUint8(chain);
+        assertTrue(actual == expected[i], "Expected %c, actual %c", expected[i], actual);
+    }
+    assertFalse(parcBufferChain_HasRemaining(chain), "Expected nothing remaining.");
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetUint16)
+{
+    PARCBufferChain *chain = _createChain();
+
+    // "AB" is within a fragment, "CD" spans two.
+    uint16_t actual = parcBufferChain_GetUint16(chain);
+    assertTrue(actual == 0x4142, "Expected 0x4142, actual 0x%04x", actual);
+    actual = parcBufferChain_GetUint16(chain);
+    assertTrue(actual == 0x4344, "Expected 0x4344, actual 0x%04x", actual);
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetUint32)
+{
+    PARCBufferChain *chain = _createChain();
+
+    // "ABCD" spans two fragments, "EFGH" spans two, "IJKL" is within a fragment.
+    uint32_t actual = parcBufferChain_GetUint32(chain);
+    assertTrue(actual == 0x41424344, "Expected 0x41424344, actual 0x%08x", actual);
+    actual = parcBufferChain_GetUint32(chain);
+    assertTrue(actual == 0x45464748, "Expected 0x45464748, actual 0x%08x", actual);
+    actual = parcBufferChain_GetUint32(chain);
+    assertTrue(actual == 0x494A4B4C, "Expected 0x494A4B4C, actual 0x%08x", actual);
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetUint64)
+{
+    PARCBufferChain *chain = _createChain();
+
+    parcBufferChain_SetPosition(chain, 1);
+
+    // "BCDEFGHI" spans all three fragments.
+    uint64_t actual = parcBufferChain_GetUint64(chain);
+    assertTrue(actual == 0x4243444546474849ULL, "Expected 0x4243444546474849, actual 0x%016" PRIx64, actual);
+    assertTrue(parcBufferChain_Position(chain) == 9, "Expected position 9, actual %zd", parcBufferChain_Position(chain));
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetBytes)
+{
+    PARCBufferChain *chain = _createChain();
+
+    uint8_t actual[13];
+    parcBufferChain_GetBytes(chain, sizeof(actual), actual);
+    assertTrue(memcmp(actual, "ABCDEFGHIJKLM", 13) == 0, "Expected ABCDEFGHIJKLM, actual %.13s", actual);
+    assertFalse(parcBufferChain_HasRemaining(chain), "Expected nothing remaining.");
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_PutUint)
+{
+    PARCBufferChain *chain = _createChain();
+
+    parcBufferChain_PutUint8(chain, 0x01);
+    parcBufferChain_PutUint16(chain, 0x0203);
+    parcBufferChain_PutUint16(chain, 0x0405);
+    parcBufferChain_PutUint64(chain, 0x060708090A0B0C0DULL);
+    assertFalse(parcBufferChain_HasRemaining(chain), "Expected nothing remaining.");
+
+    parcBufferChain_Rewind(chain);
+    assertTrue(parcBufferChain_GetUint32(chain) == 0x01020304, "Expected the bytes written across fragments.");
+    assertTrue(parcBufferChain_GetUint8(chain) == 0x05, "Expected the bytes written across fragments.");
+    assertTrue(parcBufferChain_GetUint64(chain) == 0x060708090A0B0C0DULL, "Expected the bytes written across fragments.");
+
+    parcBufferChain_SetPosition(chain, 1);
+    parcBufferChain_PutUint32(chain, 0x11121314);
+    assertTrue(parcBufferChain_GetAtIndex(chain, 4) == 0x14, "Expected the last byte in the third fragment.");
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_PutArray)
+{
+    PARCBufferChain *chain = _createChain();
+
+    parcBufferChain_SetPosition(chain, 2);
+    parcBufferChain_PutArray(chain, 5, (const uint8_t *) "cdefg");
+    assertTrue(parcBufferChain_Position(chain) == 7, "Expected position 7, actual %zd", parcBufferChain_Position(chain));
+
+    parcBufferChain_Rewind(chain);
+    uint8_t actual[13];
+    parcBufferChain_GetBytes(chain, sizeof(actual), actual);
+    assertTrue(memcmp(actual, "ABcdefgHIJKLM", 13) == 0, "Expected ABcdefgHIJKLM, actual %.13s", actual);
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetIOVec)
+{
+    PARCBufferChain *chain = _createChain();
+
+    parcBufferChain_SetPosition(chain, 1);
+    parcBufferChain_SetLimit(chain, 7);
+
+    size_t count = parcBufferChain_GetIOVec(chain, 0, NULL);
+    assertTrue(count == 3, "Expected 3 elements, actual %zd", count);
+
+    struct iovec iov[3];
+    parcBufferChain_GetIOVec(chain, 3, iov);
+    assertTrue(iov[0].iov_len == 2 && memcmp(iov[0].iov_base, "BC", 2) == 0, "Expected BC in the first element.");
+    assertTrue(iov[1].iov_len == 2 && memcmp(iov[1].iov_base, "DE", 2) == 0, "Expected DE in the second element.");
+    assertTrue(iov[2].iov_len == 2 && memcmp(iov[2].iov_base, "FG", 2) == 0, "Expected FG in the third element.");
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_GetIOVec_Partial)
+{
+    PARCBufferChain *chain = _createChain();
+
+    struct iovec iov[2] = { { NULL, 0 }, { NULL, 0 } };
+    size_t count = parcBufferChain_GetIOVec(chain, 1, iov);
+    assertTrue(count == 3, "Expected 3 elements needed, actual %zd", count);
+    assertTrue(iov[0].iov_len == 3, "Expected the first element to be filled in.");
+    assertNull(iov[1].iov_base, "Expected no more than count elements to be filled in.");
+
+    parcBufferChain_SetPosition(chain, 13);
+    count = parcBufferChain_GetIOVec(chain, 2, iov);
+    assertTrue(count == 0, "Expected no elements for nothing remaining, actual %zd", count);
+
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Flatten)
+{
+    PARCBufferChain *chain = _createChain();
+    parcBufferChain_SetPosition(chain, 2);
+
+    PARCBuffer *actual = parcBufferChain_Flatten(chain);
+    PARCBuffer *expected = parcBuffer_Flip(parcBuffer_CreateFromArray("CDEFGHIJKLM", 11));
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the remaining bytes of the chain.");
+    assertTrue(parcBufferChain_Position(chain) == 2, "Expected the position not to change.");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&actual);
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Flatten_OneFragment)
+{
+    PARCBufferChain *chain = _createChain();
+    parcBufferChain_SetPosition(chain, 6);
+    parcBufferChain_SetLimit(chain, 9);
+
+    PARCBuffer *actual = parcBufferChain_Flatten(chain);
+    PARCBuffer *expected = parcBuffer_Flip(parcBuffer_CreateFromArray("GHI", 3));
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the remaining bytes of the chain.");
+    assertTrue(parcBuffer_Array(actual) == parcBuffer_Array(parcBufferChain_GetFragment(chain, 2)),
+               "Expected the bytes of one fragment not to be copied.");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&actual);
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Flatten_Empty)
+{
+    PARCBufferChain *chain = parcBufferChain_Create();
+
+    PARCBuffer *actual = parcBufferChain_Flatten(chain);
+    assertTrue(parcBuffer_Remaining(actual) == 0, "Expected an empty buffer.");
+
+    parcBuffer_Release(&actual);
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Equals)
+{
+    PARCBufferChain *x = _createChain();
+
+    PARCBuffer *whole = parcBuffer_Flip(parcBuffer_CreateFromArray("ABCDEFGHIJKLM", 13));
+    PARCBufferChain *y = parcBufferChain_Create();
+    parcBufferChain_Append(y, whole);
+
+    PARCBuffer *start = parcBuffer_Flip(parcBuffer_CreateFromArray("ABCDEFG", 7));
+    PARCBuffer *end = parcBuffer_Flip(parcBuffer_CreateFromArray("HIJKLM", 6));
+    PARCBufferChain *z = parcBufferChain_Create();
+    parcBufferChain_Append(z, start);
+    parcBufferChain_Append(z, end);
+
+    PARCBufferChain *u1 = _createChain();
+    parcBufferChain_SetPosition(u1, 1);
+
+    PARCBufferChain *u2 = _createChain();
+    parcBufferChain_SetPosition(u2, 12);
+    parcBufferChain_PutUint8(u2, 'X');
+    parcBufferChain_Rewind(u2);
+
+    parcObjectTesting_AssertEquals(x, y, z, u1, u2, NULL);
+
+    parcBufferChain_Release(&u2);
+    parcBufferChain_Release(&u1);
+    parcBufferChain_Release(&z);
+    parcBuffer_Release(&end);
+    parcBuffer_Release(&start);
+    parcBufferChain_Release(&y);
+    parcBuffer_Release(&whole);
+    parcBufferChain_Release(&x);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_HashCode)
+{
+    PARCBufferChain *chain = _createChain();
+    PARCBuffer *buffer = parcBuffer_Flip(parcBuffer_CreateFromArray("ABCDEFGHIJKLM", 13));
+
+    PARCHashCode expected = parcBuffer_HashCode(buffer);
+    PARCHashCode actual = parcBufferChain_HashCode(chain);
+    assertTrue(expected == actual, "Expected the hash code of a PARCBuffer with the same bytes.");
+
+    parcBufferChain_SetPosition(chain, 13);
+    assertTrue(parcBufferChain_HashCode(chain) == 0, "Expected 0 for nothing remaining.");
+
+    parcBuffer_Release(&buffer);
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferChain_Display)
+{
+    PARCBufferChain *chain = _createChain();
+    parcBufferChain_Display(chain, 0);
+    parcBufferChain_Display(NULL, 0);
+    parcBufferChain_Release(&chain);
+}
+
+LONGBOW_TEST_FIXTURE(Errors)
+{
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferChain_GetUint32_Underflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferChain_PutUint8_Overflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferChain_SetLimit_BeyondCapacity);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferChain_AppendByteArray_OutOfBounds);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Errors)
+{
+    PARCBufferChain *chain = _createChain();
+    longBowTestCase_SetClipBoardData(testCase, chain);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Errors)
+{
+    PARCBufferChain *chain = longBowTestCase_GetClipBoardData(testCase);
+    parcBufferChain_Release(&chain);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferChain_GetUint32_Underflow, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferChain *chain = longBowTestCase_GetClipBoardData(testCase);
+    parcBufferChain_SetPosition(chain, 10);
+    parcBufferChain_GetUint32(chain);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferChain_PutUint8_Overflow, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferChain *chain = longBowTestCase_GetClipBoardData(testCase);
+    parcBufferChain_SetPosition(chain, 13);
+    parcBufferChain_PutUint8(chain, 0);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferChain_SetLimit_BeyondCapacity, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferChain *chain = longBowTestCase_GetClipBoardData(testCase);
+    parcBufferChain_SetLimit(chain, 14);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferChain_AppendByteArray_OutOfBounds, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferChain *chain = longBowTestCase_GetClipBoardData(testCase);
+    PARCByteArray *array = parcByteArray_Allocate(10);
+    parcBufferChain_AppendByteArray(chain, array, 8, 3);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, AssembleMessage);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, AssembleMessage)
+{
+    const size_t payloadLength = 1024 * 1024;
+    const int messages = 1000;
+
+    PARCBuffer *header = parcBuffer_Allocate(16);
+    PARCBuffer *payload = parcBuffer_Allocate(payloadLength);
+    PARCBuffer *trailer = parcBuffer_Allocate(32);
+
+    double start = _seconds();
+    size_t composed = 0;
+    for (int i = 0; i < messages; i++) {
+        PARCBufferComposer *composer = parcBufferComposer_Create();
+        parcBufferComposer_PutBuffer(composer, header);
+        parcBufferComposer_PutBuffer(composer, payload);
+        parcBufferComposer_PutBuffer(composer, trailer);
+        PARCBuffer *message = parcBufferComposer_ProduceBuffer(composer);
+        composed += parcBuffer_Remaining(message);
+        parcBuffer_Release(&message);
+        parcBufferComposer_Release(&composer);
+    }
+    double composerTime = _seconds() - start;
+
+    start = _seconds();
+    size_t chained = 0;
+    for (int i = 0; i < messages; i++) {
+        PARCBufferChain *chain = parcBufferChain_Create();
+        parcBufferChain_Append(chain, header);
+        parcBufferChain_Append(chain, payload);
+        parcBufferChain_Append(chain, trailer);
+
+        struct iovec iov[3];
+        parcBufferChain_GetIOVec(chain, 3, iov);
+        chained += iov[0].iov_len + iov[1].iov_len + iov[2].iov_len;
+        parcBufferChain_Release(&chain);
+    }
+    double chainTime = _seconds() - start;
+
+    assertTrue(composed == chained, "Expected the same number of bytes, %zd and %zd", composed, chained);
+
+    printf("%d messages of %zd bytes: PARCBufferComposer %.3fs, PARCBufferChain %.6fs\n",
+           messages, composed / messages, composerTime, chainTime);
+
+    parcBuffer_Release(&trailer);
+    parcBuffer_Release(&payload);
+    parcBuffer_Release(&header);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_BufferChain);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -30,6 +30,7 @@
 #include "../parc_BufferComposer.c"
 
 #include <inttypes.h>
+#include <sys/time.h>
 #include <LongBow/unit-test.h>
 #include <LongBow/debugging.h>
 
@@ -72,6 +73,8 @@ LONGBOW_TEST_RUNNER(parc_BufferComposer)
     // Test Fixtures are run in the order specified, but all tests should be idempotent.
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Errors);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -105,12 +108,19 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_PutString);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_PutStrings);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_Format);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_Format_Extend);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_Format_Fill);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_PutChar);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_GetBuffer);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_CreateBuffer);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_ProduceBuffer);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_PutString_Extend);
     LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_ToString);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_GrowthFactor);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_GrowthFactor_Linear);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_Reserve);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_GetWritableSpan);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferComposer_GetWritableSpan_Zero);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -449,6 +459,230 @@ LONGBOW_TEST_CASE(Global, parcBufferComposer_PutString_Extend)
     parcBufferComposer_Release(&composer);
 }
 
+LONGBOW_TEST_CASE(Global, parcBufferComposer_Format_Extend)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(8);
+    parcBufferComposer_PutString(composer, "<");
+    parcBufferComposer_Format(composer, "%s %d %s", "a longer string than the capacity", 42, "of the composer");
+    parcBufferComposer_PutString(composer, ">");
+
+    char *actual = parcBufferComposer_ToString(composer);
+    char *expected = "<a longer string than the capacity 42 of the composer>";
+    assertTrue(strcmp(expected, actual) == 0, "Expected '%s', actual '%s'", expected, actual);
+
+    parcMemory_Deallocate((void **) &actual);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferComposer_Format_Fill)
+{
+    // The formatted string exactly fills the capacity, leaving no room for the nul vsnprintf writes.
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(8);
+    parcBufferComposer_Format(composer, "%08d", 1234);
+    parcBufferComposer_Format(composer, "%s", "");
+    parcBufferComposer_PutChar(composer, '!');
+
+    char *actual = parcBufferComposer_ToString(composer);
+    assertTrue(strcmp("00001234!", actual) == 0, "Expected '00001234!', actual '%s'", actual);
+
+    parcMemory_Deallocate((void **) &actual);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferComposer_GrowthFactor)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(64);
+    assertTrue(parcBufferComposer_GetGrowthFactor(composer) == parcBufferComposer_DefaultGrowthFactor,
+               "Expected the default growth factor, actual %f", parcBufferComposer_GetGrowthFactor(composer));
+
+    for (int i = 0; i < 65; i++) {
+        parcBufferComposer_PutUint8(composer, (uint8_t) i);
+    }
+    size_t capacity = parcBuffer_Capacity(parcBufferComposer_GetBuffer(composer));
+    assertTrue(capacity == 128, "Expected the capacity to double to 128, actual %zd", capacity);
+
+    parcBufferComposer_SetGrowthFactor(composer, 1.5);
+    for (int i = 0; i < 64; i++) {
+        parcBufferComposer_PutUint8(composer, (uint8_t) i);
+    }
+    capacity = parcBuffer_Capacity(parcBufferComposer_GetBuffer(composer));
+    assertTrue(capacity == 192, "Expected the capacity to grow by half to 192, actual %zd", capacity);
+
+    unsigned char bytes[1000] = { 0 };
+    parcBufferComposer_PutArray(composer, bytes, sizeof(bytes));
+    capacity = parcBuffer_Capacity(parcBufferComposer_GetBuffer(composer));
+    assertTrue(capacity == 1129, "Expected the capacity to grow by enough for the bytes, actual %zd", capacity);
+
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferComposer_GrowthFactor_Linear)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(64);
+    parcBufferComposer_SetGrowthFactor(composer, 1.0);
+
+    for (int i = 0; i < 200; i++) {
+        parcBufferComposer_PutUint8(composer, (uint8_t) i);
+    }
+    size_t capacity = parcBuffer_Capacity(parcBufferComposer_GetBuffer(composer));
+    assertTrue(capacity == 256, "Expected the capacity to grow by the 64 byte increment to 256, actual %zd", capacity);
+
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferComposer_Reserve)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(8);
+    parcBufferComposer_PutString(composer, "abc");
+
+    PARCBufferComposer *result = parcBufferComposer_Reserve(composer, 1000);
+    assertTrue(result == composer, "Expected parcBufferComposer_Reserve to return its argument.");
+
+    PARCBuffer *buffer = parcBufferComposer_GetBuffer(composer);
+    assertTrue(parcBuffer_Capacity(buffer) - parcBuffer_Position(buffer) >= 1000,
+               "Expected room for 1000 bytes, actual %zd", parcBuffer_Capacity(buffer) - parcBuffer_Position(buffer));
+
+    for (int i = 0; i < 1000; i++) {
+        parcBufferComposer_PutChar(composer, 'x');
+    }
+    assertTrue(parcBufferComposer_GetBuffer(composer) == buffer, "Expected the composer not to grow within its reservation.");
+
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferComposer_GetWritableSpan)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(4);
+    parcBufferComposer_PutString(composer, "ab");
+
+    size_t available;
+    uint8_t *span = parcBufferComposer_GetWritableSpan(composer, 10, &available);
+    assertNotNull(span, "Expected a non-NULL span.");
+    assertTrue(available >= 10, "Expected at least 10 bytes available, actual %zd", available);
+
+    memcpy(span, "cdefgh", 6);
+    parcBufferComposer_Commit(composer, 4);
+    parcBufferComposer_PutString(composer, "!");
+
+    char *actual = parcBufferComposer_ToString(composer);
+    assertTrue(strcmp("abcdef!", actual) == 0, "Expected only the committed bytes to be appended, actual '%s'", actual);
+
+    parcMemory_Deallocate((void **) &actual);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferComposer_GetWritableSpan_Zero)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(2);
+    parcBufferComposer_PutString(composer, "ab");
+
+    uint8_t *span = parcBufferComposer_GetWritableSpan(composer, 0, NULL);
+    assertNotNull(span, "Expected a non-NULL span, even of a full composer.");
+    parcBufferComposer_Commit(composer, 0);
+
+    char *actual = parcBufferComposer_ToString(composer);
+    assertTrue(strcmp("ab", actual) == 0, "Expected 'ab', actual '%s'", actual);
+
+    parcMemory_Deallocate((void **) &actual);
+    parcBufferComposer_Release(&composer);
+}
+
+LONGBOW_TEST_FIXTURE(Errors)
+{
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferComposer_Commit_TooLong);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferComposer_SetGrowthFactor_TooSmall);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Errors)
+{
+    TestData *data = commonSetup();
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Errors)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    uint32_t outstandingAllocations = commonTearDown(data);
+
+    if (outstandingAllocations != 0) {
+        printf("%s leaks %d memory allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferComposer_Commit_TooLong, .event = &LongBowTrapOutOfBounds)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    size_t available;
+    parcBufferComposer_GetWritableSpan(data->composer, 1, &available);
+    parcBufferComposer_Commit(data->composer, available + 1);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferComposer_SetGrowthFactor_TooSmall, .event = &LongBowTrapIllegalValue)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    parcBufferComposer_SetGrowthFactor(data->composer, 0.5);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, Compose1MB);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+#define _composedLength (1024 * 1024)
+
+// Build a 1 MB string from small strings and formatted numbers, starting from the default allocation.
+static double
+_compose(double growthFactor, size_t reserve)
+{
+    double start = _seconds();
+
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcBufferComposer_SetGrowthFactor(composer, growthFactor);
+    parcBufferComposer_Reserve(composer, reserve);
+
+    PARCBuffer *buffer = parcBufferComposer_GetBuffer(composer);
+    for (int i = 0; parcBuffer_Position(buffer) < _composedLength; i++) {
+        parcBufferComposer_PutString(composer, "fragment ");
+        parcBufferComposer_Format(composer, "%d, ", i);
+        buffer = parcBufferComposer_GetBuffer(composer);
+    }
+    parcBufferComposer_Release(&composer);
+
+    return _seconds() - start;
+}
+
+LONGBOW_TEST_CASE(Performance, Compose1MB)
+{
+    printf("growth factor 1.0 (fixed increment) %8.3f ms\n", _compose(1.0, 0) * 1000);
+    printf("growth factor 1.5                   %8.3f ms\n", _compose(1.5, 0) * 1000);
+    printf("growth factor 2.0                   %8.3f ms\n", _compose(2.0, 0) * 1000);
+    printf("reserved 1 MB                       %8.3f ms\n", _compose(2.0, _composedLength + 64) * 1000);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_BufferCursor.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/testing/parc_MemoryTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_BufferCursor)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Errors);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_BufferCursor)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_BufferCursor)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_Open);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_Open_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_Close);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_Get);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_Put);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_GetArray);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_PutArray);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_Skip);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferCursor_Slice);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_Open)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(20);
+    parcBuffer_SetPosition(buffer, 5);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 10);
+
+    assertTrue(cursor.buffer == buffer, "Expected the cursor to refer to the buffer.");
+    assertTrue(parcBufferCursor_Remaining(&cursor) == 10, "Expected 10 remaining, actual %zd", parcBufferCursor_Remaining(&cursor));
+    assertTrue(parcBufferCursor_Consumed(&cursor) == 0, "Expected 0 consumed, actual %zd", parcBufferCursor_Consumed(&cursor));
+    assertTrue(parcBuffer_Position(buffer) == 5, "Expected opening a cursor not to move the position, actual %zd", parcBuffer_Position(buffer));
+
+    parcBufferCursor_Close(&cursor);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_Open_Empty)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(4);
+    parcBuffer_SetPosition(buffer, 4);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 0);
+    assertTrue(parcBufferCursor_Remaining(&cursor) == 0, "Expected 0 remaining, actual %zd", parcBufferCursor_Remaining(&cursor));
+    parcBufferCursor_Close(&cursor);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_Close)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(20);
+    parcBuffer_SetPosition(buffer, 2);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 10);
+    parcBufferCursor_PutUint32(&cursor, 1);
+    parcBufferCursor_PutUint16(&cursor, 2);
+
+    PARCBuffer *actual = parcBufferCursor_Close(&cursor);
+    assertTrue(actual == buffer, "Expected the buffer to be returned.");
+    assertTrue(parcBuffer_Position(buffer) == 8, "Expected the position to advance to 8, actual %zd", parcBuffer_Position(buffer));
+    assertNull(cursor.buffer, "Expected a closed cursor to refer to no buffer.");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_Get)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1 + 2 + 4 + 8);
+    parcBuffer_PutUint8(buffer, 0x01);
+    parcBuffer_PutUint16(buffer, 0x0203);
+    parcBuffer_PutUint32(buffer, 0x04050607);
+    parcBuffer_PutUint64(buffer, 0x08090A0B0C0D0E0F);
+    parcBuffer_Flip(buffer);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, parcBuffer_Remaining(buffer));
+
+    uint8_t u8 = parcBufferCursor_GetUint8(&cursor);
+    uint16_t u16 = parcBufferCursor_GetUint16(&cursor);
+    uint32_t u32 = parcBufferCursor_GetUint32(&cursor);
+    uint64_t u64 = parcBufferCursor_GetUint64(&cursor);
+
+    assertTrue(u8 == 0x01, "Expected 0x01, actual 0x%x", u8);
+    assertTrue(u16 == 0x0203, "Expected 0x0203, actual 0x%x", u16);
+    assertTrue(u32 == 0x04050607, "Expected 0x04050607, actual 0x%x", u32);
+    assertTrue(u64 == 0x08090A0B0C0D0E0F, "Expected 0x08090A0B0C0D0E0F, actual 0x%" PRIx64, u64);
+    assertTrue(parcBufferCursor_Remaining(&cursor) == 0, "Expected 0 remaining, actual %zd", parcBufferCursor_Remaining(&cursor));
+
+    parcBufferCursor_Close(&cursor);
+    assertFalse(parcBuffer_HasRemaining(buffer), "Expected the buffer to be consumed.");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_Put)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1 + 2 + 4 + 8);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, parcBuffer_Remaining(buffer));
+    parcBufferCursor_PutUint8(&cursor, 0x01);
+    parcBufferCursor_PutUint16(&cursor, 0x0203);
+    parcBufferCursor_PutUint32(&cursor, 0x04050607);
+    parcBufferCursor_PutUint64(&cursor, 0x08090A0B0C0D0E0F);
+    parcBufferCursor_Close(&cursor);
+
+    parcBuffer_Flip(buffer);
+    for (uint8_t i = 1; i <= 15; i++) {
+        uint8_t actual = parcBuffer_GetUint8(buffer);
+        assertTrue(actual == i, "Expected %d, actual %d", i, actual);
+    }
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_GetArray)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 5);
+    uint8_t actual[5];
+    parcBufferCursor_GetArray(&cursor, 5, actual);
+    parcBufferCursor_Close(&cursor);
+
+    assertTrue(memcmp(actual, "Hello", 5) == 0, "Expected Hello");
+    assertTrue(parcBuffer_Position(buffer) == 5, "Expected position 5, actual %zd", parcBuffer_Position(buffer));
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_PutArray)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(5);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 5);
+    parcBufferCursor_PutArray(&cursor, 5, (uint8_t *) "Hello");
+    parcBufferCursor_Close(&cursor);
+
+    parcBuffer_Flip(buffer);
+    char *actual = parcBuffer_ToString(buffer);
+    assertTrue(strcmp(actual, "Hello") == 0, "Expected Hello, actual %s", actual);
+
+    parcMemory_Deallocate(&actual);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_Skip)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 11);
+    parcBufferCursor_Skip(&cursor, 6);
+    uint8_t actual = parcBufferCursor_GetUint8(&cursor);
+
+    assertTrue(actual == 'W', "Expected W, actual %c", actual);
+    assertTrue(parcBufferCursor_Consumed(&cursor) == 7, "Expected 7 consumed, actual %zd", parcBufferCursor_Consumed(&cursor));
+    assertTrue(parcBufferCursor_Remaining(&cursor) == 4, "Expected 4 remaining, actual %zd", parcBufferCursor_Remaining(&cursor));
+
+    parcBufferCursor_Close(&cursor);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferCursor_Slice)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+    parcBuffer_SetPosition(buffer, 6);
+    PARCBuffer *slice = parcBuffer_Slice(buffer);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, slice, 5);
+    uint8_t actual = parcBufferCursor_GetUint8(&cursor);
+    parcBufferCursor_Close(&cursor);
+
+    assertTrue(actual == 'W', "Expected the cursor to start at the position of the slice, actual %c", actual);
+
+    parcBuffer_Release(&slice);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_FIXTURE(Errors)
+{
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferCursor_Open_TooLong);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferCursor_Close_Overrun);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Errors)
+{
+    longBowTestCase_SetClipBoardData(testCase, parcBuffer_Allocate(10));
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Errors)
+{
+    PARCBuffer *buffer = longBowTestCase_GetClipBoardData(testCase);
+    parcBuffer_Release(&buffer);
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferCursor_Open_TooLong, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBuffer *buffer = longBowTestCase_GetClipBoardData(testCase);
+    parcBuffer_SetPosition(buffer, 5);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 6);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferCursor_Close_Overrun, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBuffer *buffer = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCBufferCursor cursor;
+    parcBufferCursor_Open(&cursor, buffer, 4);
+    parcBufferCursor_Skip(&cursor, 5);
+    parcBufferCursor_Close(&cursor);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, EncodeFields);
+    LONGBOW_RUN_TEST_CASE(Performance, DecodeFields);
+    LONGBOW_RUN_TEST_CASE(Performance, EncodeArray);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+// Each TLV is a 2 byte type, a 2 byte length and a 4 byte value.
+#define _tlvCount 1000
+#define _tlvLength 8
+#define _iterations 20000
+
+// The implementation of parcBuffer_PutUint16 and parcBuffer_PutUint32 before they checked the bounds once.
+static void
+_previousPutUint16(PARCBuffer *buffer, uint16_t value)
+{
+    parcBuffer_PutUint8(buffer, (value >> 8) & 0xFF);
+    parcBuffer_PutUint8(buffer, value & 0xFF);
+}
+
+static void
+_previousPutUint32(PARCBuffer *buffer, uint32_t value)
+{
+    for (int i = sizeof(uint32_t) - 1; i >= 0; i--) {
+        parcBuffer_PutUint8(buffer, value >> (i * 8) & 0xFF);
+    }
+}
+
+static void
+_report(const char *name, double seconds)
+{
+    double fields = (double) _iterations * _tlvCount * 3;
+    printf("%-28s %8.3fs %8.2f ns/field\n", name, seconds, seconds * 1e9 / fields);
+}
+
+LONGBOW_TEST_CASE(Performance, EncodeFields)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(_tlvCount * _tlvLength);
+
+    double start = _seconds();
+    for (int n = 0; n < _iterations; n++) {
+        parcBuffer_Clear(buffer);
+        for (uint16_t i = 0; i < _tlvCount; i++) {
+            _previousPutUint16(buffer, i);
+            _previousPutUint16(buffer, 4);
+            _previousPutUint32(buffer, i);
+        }
+    }
+    _report("Encode previous PutUint*", _seconds() - start);
+    PARCBuffer *expected = parcBuffer_Copy(parcBuffer_Flip(buffer));
+
+    start = _seconds();
+    for (int n = 0; n < _iterations; n++) {
+        parcBuffer_Clear(buffer);
+        for (uint16_t i = 0; i < _tlvCount; i++) {
+            parcBuffer_PutUint16(buffer, i);
+            parcBuffer_PutUint16(buffer, 4);
+            parcBuffer_PutUint32(buffer, i);
+        }
+    }
+    _report("Encode PutUint*", _seconds() - start);
+    assertTrue(parcBuffer_Equals(expected, parcBuffer_Flip(buffer)), "Expected the same encoding.");
+
+    start = _seconds();
+    for (int n = 0; n < _iterations; n++) {
+        parcBuffer_Clear(buffer);
+        PARCBufferCursor cursor;
+        parcBufferCursor_Open(&cursor, buffer, _tlvCount * _tlvLength);
+        for (uint16_t i = 0; i < _tlvCount; i++) {
+            parcBufferCursor_PutUint16(&cursor, i);
+            parcBufferCursor_PutUint16(&cursor, 4);
+            parcBufferCursor_PutUint32(&cursor, i);
+        }
+        parcBufferCursor_Close(&cursor);
+    }
+    _report("Encode PARCBufferCursor", _seconds() - start);
+    assertTrue(parcBuffer_Equals(expected, parcBuffer_Flip(buffer)), "Expected the same encoding.");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Performance, DecodeFields)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(_tlvCount * _tlvLength);
+    for (uint16_t i = 0; i < _tlvCount; i++) {
+        parcBuffer_PutUint16(buffer, i);
+        parcBuffer_PutUint16(buffer, 4);
+        parcBuffer_PutUint32(buffer, i);
+    }
+    parcBuffer_Flip(buffer);
+
+    uint64_t sum = 0;
+    double start = _seconds();
+    for (int n = 0; n < _iterations; n++) {
+        parcBuffer_Rewind(buffer);
+        for (uint16_t i = 0; i < _tlvCount; i++) {
+            sum += parcBuffer_GetUint16(buffer);
+            sum += parcBuffer_GetUint16(buffer);
+            sum += parcBuffer_GetUint32(buffer);
+        }
+    }
+    _report("Decode GetUint*", _seconds() - start);
+
+    start = _seconds();
+    for (int n = 0; n < _iterations; n++) {
+        parcBuffer_Rewind(buffer);
+        PARCBufferCursor cursor;
+        parcBufferCursor_Open(&cursor, buffer, parcBuffer_Remaining(buffer));
+        for (uint16_t i = 0; i < _tlvCount; i++) {
+            sum -= parcBufferCursor_GetUint16(&cursor);
+            sum -= parcBufferCursor_GetUint16(&cursor);
+            sum -= parcBufferCursor_GetUint32(&cursor);
+        }
+        parcBufferCursor_Close(&cursor);
+    }
+    _report("Decode PARCBufferCursor", _seconds() - start);
+
+    assertTrue(sum == 0, "Expected both decoders to read the same values.");
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Performance, EncodeArray)
+{
+    uint32_t values[_tlvCount * 2];
+    for (size_t i = 0; i < _tlvCount * 2; i++) {
+        values[i] = (uint32_t) i;
+    }
+    PARCBuffer *buffer = parcBuffer_Allocate(sizeof(values));
+
+    double start = _seconds();
+    for (int n = 0; n < _iterations; n++) {
+        parcBuffer_Clear(buffer);
+        for (size_t i = 0; i < _tlvCount * 2; i++) {
+            parcBuffer_PutUint32(buffer, values[i]);
+        }
+    }
+    double seconds = _seconds() - start;
+    printf("%-28s %8.3fs %8.2f ns/value\n", "Encode PutUint32", seconds, seconds * 1e9 / _iterations / (_tlvCount * 2));
+
+    start = _seconds();
+    for (int n = 0; n < _iterations; n++) {
+        parcBuffer_Clear(buffer);
+        parcBuffer_PutUint32Array(buffer, _tlvCount * 2, values);
+    }
+    seconds = _seconds() - start;
+    printf("%-28s %8.3fs %8.2f ns/value\n", "Encode PutUint32Array", seconds, seconds * 1e9 / _iterations / (_tlvCount * 2));
+
+    parcBuffer_Release(&buffer);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_BufferCursor);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
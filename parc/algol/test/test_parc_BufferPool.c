@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_BufferPool.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_HashMap.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/testing/parc_MemoryTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_BufferPool)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Errors);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_BufferPool)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_BufferPool)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static const PARCBufferPoolClass _classes[] = {
+    { .size = 128,  .capacity = 4, .preallocate = 2 },
+    { .size = 1500, .capacity = 2, .preallocate = 0 },
+};
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Create);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_GetInstance);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_GetInstance_Oversize);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_GetInstance_HashMapKey);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Recycle);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Recycle_Acquired);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Recycle_Slice);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Recycle_Capacity);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_GetStatistics);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Drain);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Release_Outstanding);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferPool_Threads);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Create)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+    assertNotNull(pool, "Expected parcBufferPool_Create to return a non-NULL value.");
+    parcBufferPool_AssertValid(pool);
+
+    assertTrue(parcBufferPool_GetClassCount(pool) == 2, "Expected 2 classes, actual %zd", parcBufferPool_GetClassCount(pool));
+    assertTrue(parcBufferPool_GetClassSize(pool, 0) == 128, "Expected 128, actual %zd", parcBufferPool_GetClassSize(pool, 0));
+    assertTrue(parcBufferPool_GetClassSize(pool, 1) == 1500, "Expected 1500, actual %zd", parcBufferPool_GetClassSize(pool, 1));
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(pool, 0, &statistics);
+    assertTrue(statistics.idle == 2, "Expected 2 preallocated buffers, actual %zd", statistics.idle);
+    parcBufferPool_GetStatistics(pool, 1, &statistics);
+    assertTrue(statistics.idle == 0, "Expected no preallocated buffers, actual %zd", statistics.idle);
+
+    parcBufferPool_Release(&pool);
+    assertNull(pool, "Expected parcBufferPool_Release to set the pointer to NULL.");
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_AcquireRelease)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBufferPool *reference = parcBufferPool_Acquire(pool);
+    assertTrue(reference == pool, "Expected the acquired reference to be equal to the original.");
+
+    parcBufferPool_Release(&pool);
+    parcBufferPool_AssertValid(reference);
+    parcBufferPool_Release(&reference);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_GetInstance)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *small = parcBufferPool_GetInstance(pool, 100);
+    assertTrue(parcBuffer_Capacity(small) == 128, "Expected capacity 128, actual %zd", parcBuffer_Capacity(small));
+    assertTrue(parcBuffer_Position(small) == 0, "Expected position 0, actual %zd", parcBuffer_Position(small));
+    assertTrue(parcBuffer_Limit(small) == 100, "Expected limit 100, actual %zd", parcBuffer_Limit(small));
+
+    PARCBuffer *large = parcBufferPool_GetInstance(pool, 129);
+    assertTrue(parcBuffer_Capacity(large) == 1500, "Expected capacity 1500, actual %zd", parcBuffer_Capacity(large));
+    assertTrue(parcBuffer_Limit(large) == 129, "Expected limit 129, actual %zd", parcBuffer_Limit(large));
+
+    parcBuffer_PutUint32(large, 0x01020304);
+    parcBuffer_Flip(large);
+    assertTrue(parcBuffer_GetUint32(large) == 0x01020304, "Expected a pooled buffer to work as any other.");
+
+    parcBuffer_Release(&small);
+    parcBuffer_Release(&large);
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_GetInstance_Oversize)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool, 1501);
+    assertTrue(parcBuffer_Capacity(buffer) == 1501, "Expected capacity 1501, actual %zd", parcBuffer_Capacity(buffer));
+    parcBuffer_Release(&buffer);
+
+    for (size_t i = 0; i < parcBufferPool_GetClassCount(pool); i++) {
+        PARCBufferPoolStatistics statistics;
+        parcBufferPool_GetStatistics(pool, i, &statistics);
+        assertTrue(statistics.hits == 0 && statistics.misses == 0 && statistics.recycled == 0,
+                   "Expected a buffer larger than every class not to be counted by any class.");
+    }
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_GetInstance_HashMapKey)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *pooled = parcBufferPool_GetInstance(pool, 5);
+    parcBuffer_Flip(parcBuffer_PutArray(pooled, 5, (const uint8_t *) "Hello"));
+    PARCBuffer *plain = parcBuffer_WrapCString("Hello");
+
+    assertTrue(parcObject_GetDescriptor(pooled) == parcObject_GetDescriptor(plain),
+               "Expected a pooled buffer to have the PARCBuffer descriptor.");
+    assertTrue(parcObject_Equals(pooled, plain), "Expected a pooled buffer to equal a plain buffer with the same contents.");
+    assertTrue(parcObject_Equals(plain, pooled), "Expected a plain buffer to equal a pooled buffer with the same contents.");
+
+    PARCHashMap *map = parcHashMap_Create();
+    PARCBuffer *value = parcBuffer_WrapCString("World");
+
+    parcHashMap_Put(map, pooled, value);
+    assertTrue(parcHashMap_Get(map, plain) == value, "Expected a plain buffer to find the value put with a pooled key.");
+    parcHashMap_Release(&map);
+
+    map = parcHashMap_Create();
+    parcHashMap_Put(map, plain, value);
+    assertTrue(parcHashMap_Get(map, pooled) == value, "Expected a pooled buffer to find the value put with a plain key.");
+    parcHashMap_Release(&map);
+
+    parcBuffer_Release(&value);
+    parcBuffer_Release(&plain);
+    parcBuffer_Release(&pooled);
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Recycle)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool, 1000);
+    PARCBuffer *original = buffer;
+    parcBuffer_SetPosition(buffer, 10);
+    parcBuffer_Release(&buffer);
+    assertNull(buffer, "Expected parcBuffer_Release to set the pointer to NULL.");
+
+    buffer = parcBufferPool_GetInstance(pool, 500);
+    assertTrue(buffer == original, "Expected the released buffer to be reused.");
+    assertTrue(parcBuffer_Position(buffer) == 0, "Expected position 0, actual %zd", parcBuffer_Position(buffer));
+    assertTrue(parcBuffer_Limit(buffer) == 500, "Expected limit 500, actual %zd", parcBuffer_Limit(buffer));
+    assertTrue(parcObject_GetReferenceCount(buffer) == 1, "Expected 1 reference, actual %" PRIu64, parcObject_GetReferenceCount(buffer));
+    parcBuffer_Release(&buffer);
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Recycle_Acquired)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool, 1000);
+    PARCBuffer *reference = parcBuffer_Acquire(buffer);
+    parcBuffer_Release(&buffer);
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(pool, 1, &statistics);
+    assertTrue(statistics.recycled == 0, "Expected the buffer not to be recycled while a reference remains.");
+    assertTrue(statistics.outstanding == 1, "Expected 1 outstanding, actual %zd", statistics.outstanding);
+
+    parcBuffer_Release(&reference);
+    parcBufferPool_GetStatistics(pool, 1, &statistics);
+    assertTrue(statistics.recycled == 1, "Expected 1 recycled, actual %" PRIu64, statistics.recycled);
+    assertTrue(statistics.outstanding == 0, "Expected 0 outstanding, actual %zd", statistics.outstanding);
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Recycle_Slice)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool, 1000);
+    parcBuffer_PutUint8(buffer, 42);
+    parcBuffer_Flip(buffer);
+    PARCBuffer *slice = parcBuffer_Slice(buffer);
+    parcBuffer_Release(&buffer);
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(pool, 1, &statistics);
+    assertTrue(statistics.discarded == 1, "Expected a buffer sharing its memory to be discarded, actual %" PRIu64, statistics.discarded);
+    assertTrue(statistics.idle == 0, "Expected 0 idle, actual %zd", statistics.idle);
+
+    assertTrue(parcBuffer_GetUint8(slice) == 42, "Expected the slice to outlive the discarded buffer.");
+    parcBuffer_Release(&slice);
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Recycle_Capacity)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffers[3];
+    for (int i = 0; i < 3; i++) {
+        buffers[i] = parcBufferPool_GetInstance(pool, 1500);
+    }
+    for (int i = 0; i < 3; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(pool, 1, &statistics);
+    assertTrue(statistics.recycled == 2, "Expected 2 recycled, actual %" PRIu64, statistics.recycled);
+    assertTrue(statistics.discarded == 1, "Expected 1 discarded, actual %" PRIu64, statistics.discarded);
+    assertTrue(statistics.idle == 2, "Expected the class to hold its capacity of 2, actual %zd", statistics.idle);
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_GetStatistics)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffers[3];
+    for (int i = 0; i < 3; i++) {
+        buffers[i] = parcBufferPool_GetInstance(pool, 64);
+    }
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(pool, 0, &statistics);
+    assertTrue(statistics.hits == 2, "Expected 2 hits from the preallocated buffers, actual %" PRIu64, statistics.hits);
+    assertTrue(statistics.misses == 1, "Expected 1 miss, actual %" PRIu64, statistics.misses);
+    assertTrue(statistics.outstanding == 3, "Expected 3 outstanding, actual %zd", statistics.outstanding);
+    assertTrue(statistics.idle == 0, "Expected 0 idle, actual %zd", statistics.idle);
+
+    for (int i = 0; i < 3; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+    buffers[0] = parcBufferPool_GetInstance(pool, 64);
+
+    parcBufferPool_GetStatistics(pool, 0, &statistics);
+    assertTrue(statistics.hits == 3, "Expected 3 hits, actual %" PRIu64, statistics.hits);
+    assertTrue(statistics.recycled == 3, "Expected 3 recycled, actual %" PRIu64, statistics.recycled);
+    assertTrue(statistics.outstanding == 1, "Expected 1 outstanding, actual %zd", statistics.outstanding);
+    assertTrue(statistics.highWater == 3, "Expected high water 3, actual %zd", statistics.highWater);
+    assertTrue(statistics.idle == 2, "Expected 2 idle, actual %zd", statistics.idle);
+
+    parcBuffer_Release(&buffers[0]);
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Drain)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool, 1500);
+    parcBuffer_Release(&buffer);
+
+    size_t drained = parcBufferPool_Drain(pool);
+    assertTrue(drained == 3, "Expected 3 buffers drained, actual %zd", drained);
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(pool, 0, &statistics);
+    assertTrue(statistics.idle == 0, "Expected 0 idle, actual %zd", statistics.idle);
+
+    buffer = parcBufferPool_GetInstance(pool, 10);
+    parcBuffer_Release(&buffer);
+    parcBufferPool_GetStatistics(pool, 0, &statistics);
+    assertTrue(statistics.idle == 1, "Expected a drained pool to keep recycling, actual %zd idle", statistics.idle);
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Release_Outstanding)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool, 100);
+    parcBufferPool_Release(&pool);
+
+    parcBuffer_PutUint8(buffer, 1);
+    assertTrue(parcBuffer_Position(buffer) == 1, "Expected an outstanding buffer to outlive the released pool.");
+
+    // Releasing the last buffer deallocates the pool.
+    parcBuffer_Release(&buffer);
+}
+
+#define _threadCount 4
+#define _threadIterations 10000
+
+static void *
+_exercise(void *data)
+{
+    PARCBufferPool *pool = data;
+
+    for (int i = 0; i < _threadIterations; i++) {
+        PARCBuffer *first = parcBufferPool_GetInstance(pool, (i % 2) ? 100 : 1000);
+        PARCBuffer *second = parcBufferPool_GetInstance(pool, 128);
+        parcBuffer_PutUint64(second, i);
+        parcBuffer_Release(&first);
+        parcBuffer_Release(&second);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferPool_Threads)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(2, _classes);
+
+    pthread_t threads[_threadCount];
+    for (int i = 0; i < _threadCount; i++) {
+        pthread_create(&threads[i], NULL, _exercise, pool);
+    }
+    for (int i = 0; i < _threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (size_t i = 0; i < parcBufferPool_GetClassCount(pool); i++) {
+        PARCBufferPoolStatistics statistics;
+        parcBufferPool_GetStatistics(pool, i, &statistics);
+        assertTrue(statistics.outstanding == 0, "Expected 0 outstanding, actual %zd", statistics.outstanding);
+        assertTrue(statistics.hits + statistics.misses == statistics.recycled + statistics.discarded,
+                   "Expected every buffer handed out to be recycled or discarded.");
+        assertTrue(statistics.idle <= _classes[i].capacity, "Expected at most %zd idle, actual %zd", _classes[i].capacity, statistics.idle);
+    }
+
+    parcBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_FIXTURE(Errors)
+{
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferPool_Create_Descending);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferPool_GetClassSize_OutOfBounds);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferPool_GetStatistics_OutOfBounds);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Errors)
+{
+    longBowTestCase_SetClipBoardData(testCase, parcBufferPool_Create(2, _classes));
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Errors)
+{
+    PARCBufferPool *pool = longBowTestCase_GetClipBoardData(testCase);
+    parcBufferPool_Release(&pool);
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferPool_Create_Descending, .event = &LongBowTrapIllegalValue)
+{
+    PARCBufferPoolClass classes[] = {
+        { .size = 1500, .capacity = 1 },
+        { .size = 128,  .capacity = 1 },
+    };
+    parcBufferPool_Create(2, classes);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferPool_GetClassSize_OutOfBounds, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferPool *pool = longBowTestCase_GetClipBoardData(testCase);
+
+    parcBufferPool_GetClassSize(pool, 2);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferPool_GetStatistics_OutOfBounds, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferPool *pool = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCBufferPoolStatistics statistics;
+    parcBufferPool_GetStatistics(pool, 2, &statistics);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, AllocateRelease);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+#define _iterations 1000000
+
+static void
+_report(const char *name, double seconds)
+{
+    printf("%-28s %8.3fs %8.2f ns/buffer\n", name, seconds, seconds * 1e9 / _iterations);
+}
+
+LONGBOW_TEST_CASE(Performance, AllocateRelease)
+{
+    double start = _seconds();
+    for (int i = 0; i < _iterations; i++) {
+        PARCBuffer *buffer = parcBuffer_Allocate(1500);
+        parcBuffer_PutUint8(buffer, 1);
+        parcBuffer_Release(&buffer);
+    }
+    _report("parcBuffer_Allocate", _seconds() - start);
+
+    PARCBufferPoolClass classes[] = { { .size = 1500, .capacity = 64, .preallocate = 1 } };
+    PARCBufferPool *pool = parcBufferPool_Create(1, classes);
+
+    start = _seconds();
+    for (int i = 0; i < _iterations; i++) {
+        PARCBuffer *buffer = parcBufferPool_GetInstance(pool, 1500);
+        parcBuffer_PutUint8(buffer, 1);
+        parcBuffer_Release(&buffer);
+    }
+    _report("parcBufferPool_GetInstance", _seconds() - start);
+
+    parcBufferPool_Release(&pool);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_BufferPool);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
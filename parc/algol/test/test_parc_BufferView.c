@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_BufferView.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/testing/parc_MemoryTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_BufferView)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Errors);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_BufferView)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_BufferView)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static const uint8_t _bytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F };
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_Init);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_InitFromBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_InitFromBuffer_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_Slice);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_SetPosition);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_Get);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_GetBytes);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_Equals);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_EqualsBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_EqualsCString);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_HashCode);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_FindUint8);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_ToString);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_ToBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcBufferView_ToBuffer_Empty);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_Init)
+{
+    PARCBufferView view;
+    PARCBufferView *result = parcBufferView_Init(&view, sizeof(_bytes), _bytes);
+
+    assertTrue(result == &view, "Expected parcBufferView_Init to return its argument.");
+    assertTrue(parcBufferView_Remaining(&view) == sizeof(_bytes), "Expected %zd remaining, actual %zd", sizeof(_bytes), parcBufferView_Remaining(&view));
+    assertTrue(parcBufferView_Position(&view) == 0, "Expected position 0, actual %zd", parcBufferView_Position(&view));
+    assertTrue(parcBufferView_Overlay(&view) == _bytes, "Expected the view to refer to the bytes, not a copy.");
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_InitFromBuffer)
+{
+    PARCBuffer *buffer = parcBuffer_Wrap((uint8_t *) _bytes, sizeof(_bytes), 2, 10);
+
+    PARCBufferView view;
+    parcBufferView_InitFromBuffer(&view, buffer);
+
+    assertTrue(parcBufferView_Remaining(&view) == 8, "Expected 8 remaining, actual %zd", parcBufferView_Remaining(&view));
+    assertTrue(parcBufferView_GetUint8(&view) == 0x03, "Expected the view to start at the position of the buffer.");
+    assertTrue(parcBuffer_Position(buffer) == 2, "Expected reading the view not to move the buffer, actual %zd", parcBuffer_Position(buffer));
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_InitFromBuffer_Empty)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(4);
+    parcBuffer_SetPosition(buffer, 4);
+
+    PARCBufferView view;
+    parcBufferView_InitFromBuffer(&view, buffer);
+    assertTrue(parcBufferView_Remaining(&view) == 0, "Expected 0 remaining, actual %zd", parcBufferView_Remaining(&view));
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_Slice)
+{
+    PARCBufferView view;
+    parcBufferView_Init(&view, sizeof(_bytes), _bytes);
+    parcBufferView_Skip(&view, 4);
+
+    PARCBufferView slice;
+    parcBufferView_Slice(&slice, &view, 3);
+
+    assertTrue(parcBufferView_Position(&view) == 4, "Expected slicing not to move the view, actual %zd", parcBufferView_Position(&view));
+    assertTrue(parcBufferView_Remaining(&slice) == 3, "Expected 3 remaining, actual %zd", parcBufferView_Remaining(&slice));
+    assertTrue(parcBufferView_GetUint8(&slice) == 0x05, "Expected the slice to start at the position of the view.");
+
+    PARCBufferView duplicate = slice;
+    parcBufferView_GetUint8(&duplicate);
+    assertTrue(parcBufferView_Position(&slice) == 1, "Expected a duplicate to be independent, actual %zd", parcBufferView_Position(&slice));
+    assertTrue(parcBufferView_Position(&duplicate) == 2, "Expected position 2, actual %zd", parcBufferView_Position(&duplicate));
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_SetPosition)
+{
+    PARCBufferView view;
+    parcBufferView_Init(&view, sizeof(_bytes), _bytes);
+
+    parcBufferView_SetPosition(&view, sizeof(_bytes));
+    assertTrue(parcBufferView_Remaining(&view) == 0, "Expected 0 remaining, actual %zd", parcBufferView_Remaining(&view));
+
+    parcBufferView_SetPosition(&view, 1);
+    assertTrue(parcBufferView_PeekByte(&view) == 0x02, "Expected 0x02, actual %02x", parcBufferView_PeekByte(&view));
+    assertTrue(parcBufferView_Position(&view) == 1, "Expected peeking not to move the view, actual %zd", parcBufferView_Position(&view));
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_Get)
+{
+    PARCBuffer *buffer = parcBuffer_Wrap((uint8_t *) _bytes, sizeof(_bytes), 0, sizeof(_bytes));
+
+    PARCBufferView view;
+    parcBufferView_Init(&view, sizeof(_bytes), _bytes);
+
+    assertTrue(parcBufferView_GetUint8(&view) == parcBuffer_GetUint8(buffer), "Expected GetUint8 to match the PARCBuffer.");
+    assertTrue(parcBufferView_GetUint16(&view) == parcBuffer_GetUint16(buffer), "Expected GetUint16 to match the PARCBuffer.");
+    assertTrue(parcBufferView_GetUint32(&view) == parcBuffer_GetUint32(buffer), "Expected GetUint32 to match the PARCBuffer.");
+    assertTrue(parcBufferView_GetUint64(&view) == parcBuffer_GetUint64(buffer), "Expected GetUint64 to match the PARCBuffer.");
+    assertTrue(parcBufferView_Remaining(&view) == 0, "Expected 0 remaining, actual %zd", parcBufferView_Remaining(&view));
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_GetBytes)
+{
+    PARCBufferView view;
+    parcBufferView_Init(&view, sizeof(_bytes), _bytes);
+    parcBufferView_Skip(&view, 1);
+
+    uint8_t actual[4];
+    parcBufferView_GetBytes(&view, sizeof(actual), actual);
+
+    assertTrue(memcmp(actual, &_bytes[1], sizeof(actual)) == 0, "Expected the bytes following the position.");
+    assertTrue(parcBufferView_Position(&view) == 5, "Expected position 5, actual %zd", parcBufferView_Position(&view));
+
+    parcBufferView_GetBytes(&view, 0, actual);
+    assertTrue(parcBufferView_Position(&view) == 5, "Expected getting no bytes not to move the view, actual %zd", parcBufferView_Position(&view));
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_Equals)
+{
+    uint8_t copy[sizeof(_bytes)];
+    memcpy(copy, _bytes, sizeof(_bytes));
+
+    PARCBufferView x, y, z, shorter;
+    parcBufferView_Init(&x, sizeof(_bytes), _bytes);
+    parcBufferView_Init(&y, sizeof(copy), copy);
+    parcBufferView_Init(&z, sizeof(copy), copy);
+    parcBufferView_Init(&shorter, sizeof(_bytes) - 1, _bytes);
+
+    PARCBufferView different;
+    parcBufferView_Init(&different, sizeof(_bytes), _bytes);
+    parcBufferView_Skip(&different, 1);
+
+    assertTrue(parcBufferView_Equals(&x, &y), "Expected views of equal bytes to be equal.");
+    assertTrue(parcBufferView_Equals(&y, &x), "Expected equality to be symmetric.");
+    assertTrue(parcBufferView_Equals(&y, &z) && parcBufferView_Equals(&x, &z), "Expected equality to be transitive.");
+    assertTrue(parcBufferView_Equals(NULL, NULL), "Expected NULL to equal NULL.");
+    assertFalse(parcBufferView_Equals(&x, NULL), "Expected a view not to equal NULL.");
+    assertFalse(parcBufferView_Equals(&x, &shorter), "Expected views of different lengths not to be equal.");
+    assertFalse(parcBufferView_Equals(&x, &different), "Expected views of different bytes not to be equal.");
+
+    parcBufferView_Skip(&x, 1);
+    assertTrue(parcBufferView_Equals(&x, &different), "Expected only the remaining bytes to be compared.");
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_EqualsBuffer)
+{
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+
+    PARCBufferView view;
+    parcBufferView_Init(&view, 5, (const uint8_t *) "Hello");
+
+    assertFalse(parcBufferView_EqualsBuffer(&view, buffer), "Expected the view not to equal the whole buffer.");
+    parcBuffer_SetLimit(buffer, 5);
+    assertTrue(parcBufferView_EqualsBuffer(&view, buffer), "Expected the view to equal the remaining bytes of the buffer.");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_EqualsCString)
+{
+    PARCBufferView view;
+    parcBufferView_Init(&view, 11, (const uint8_t *) "Hello World");
+    parcBufferView_Skip(&view, 6);
+
+    assertTrue(parcBufferView_EqualsCString(&view, "World"), "Expected the view to equal \"World\".");
+    assertFalse(parcBufferView_EqualsCString(&view, "Worl"), "Expected the view not to equal a prefix.");
+    assertFalse(parcBufferView_EqualsCString(&view, "Worlds"), "Expected the view not to equal a longer string.");
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_HashCode)
+{
+    PARCBuffer *buffer = parcBuffer_Wrap((uint8_t *) _bytes, sizeof(_bytes), 3, 12);
+
+    PARCBufferView view;
+    parcBufferView_InitFromBuffer(&view, buffer);
+
+    assertTrue(parcBufferView_HashCode(&view) == parcBuffer_HashCode(buffer),
+               "Expected the hash code of a view to equal the hash code of a PARCBuffer with the same bytes.");
+
+    parcBufferView_SetPosition(&view, parcBufferView_Remaining(&view));
+    assertTrue(parcBufferView_HashCode(&view) == 0, "Expected the hash code of no bytes to be 0.");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_FindUint8)
+{
+    PARCBufferView view;
+    parcBufferView_Init(&view, 11, (const uint8_t *) "Hello World");
+
+    assertTrue(parcBufferView_FindUint8(&view, 'o') == 4, "Expected 4, actual %zd", parcBufferView_FindUint8(&view, 'o'));
+    parcBufferView_Skip(&view, 5);
+    assertTrue(parcBufferView_FindUint8(&view, 'o') == 7, "Expected the offset in the view, actual %zd", parcBufferView_FindUint8(&view, 'o'));
+    assertTrue(parcBufferView_FindUint8(&view, 'H') == SIZE_MAX, "Expected SIZE_MAX for a byte before the position.");
+
+    parcBufferView_SetPosition(&view, 11);
+    assertTrue(parcBufferView_FindUint8(&view, 'd') == SIZE_MAX, "Expected SIZE_MAX for an empty view.");
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_ToString)
+{
+    PARCBufferView view;
+    parcBufferView_Init(&view, 11, (const uint8_t *) "Hello World");
+    parcBufferView_Skip(&view, 6);
+
+    char *actual = parcBufferView_ToString(&view);
+    assertTrue(strcmp(actual, "World") == 0, "Expected \"World\", actual \"%s\"", actual);
+    parcMemory_Deallocate(&actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_ToBuffer)
+{
+    uint8_t bytes[] = { 'a', 'b', 'c', 'd' };
+
+    PARCBufferView view;
+    parcBufferView_Init(&view, sizeof(bytes), bytes);
+    parcBufferView_Skip(&view, 1);
+
+    PARCBuffer *actual = parcBufferView_ToBuffer(&view);
+    bytes[1] = 'x';
+
+    PARCBuffer *expected = parcBuffer_WrapCString("bcd");
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the buffer to hold a copy of the remaining bytes.");
+    assertTrue(parcBuffer_Position(actual) == 0, "Expected position 0, actual %zd", parcBuffer_Position(actual));
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcBufferView_ToBuffer_Empty)
+{
+    PARCBufferView view;
+    parcBufferView_Init(&view, 0, NULL);
+
+    PARCBuffer *actual = parcBufferView_ToBuffer(&view);
+    assertTrue(parcBuffer_Remaining(actual) == 0, "Expected an empty buffer, actual %zd remaining", parcBuffer_Remaining(actual));
+    parcBuffer_Release(&actual);
+}
+
+LONGBOW_TEST_FIXTURE(Errors)
+{
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferView_GetUint32_Underflow);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferView_PeekByte_Empty);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferView_Slice_TooLong);
+    LONGBOW_RUN_TEST_CASE(Errors, parcBufferView_SetPosition_TooFar);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Errors)
+{
+    PARCBufferView *view = parcMemory_Allocate(sizeof(PARCBufferView));
+    parcBufferView_Init(view, 3, _bytes);
+    longBowTestCase_SetClipBoardData(testCase, view);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Errors)
+{
+    PARCBufferView *view = longBowTestCase_GetClipBoardData(testCase);
+    parcMemory_Deallocate(&view);
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferView_GetUint32_Underflow, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferView *view = longBowTestCase_GetClipBoardData(testCase);
+
+    parcBufferView_GetUint32(view);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferView_PeekByte_Empty, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferView *view = longBowTestCase_GetClipBoardData(testCase);
+
+    parcBufferView_Skip(view, 3);
+    parcBufferView_PeekByte(view);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferView_Slice_TooLong, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferView *view = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCBufferView slice;
+    parcBufferView_Slice(&slice, view, 4);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcBufferView_SetPosition_TooFar, .event = &LongBowTrapOutOfBounds)
+{
+    PARCBufferView *view = longBowTestCase_GetClipBoardData(testCase);
+
+    parcBufferView_SetPosition(view, 4);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, Tokenize);
+    LONGBOW_RUN_TEST_CASE(Performance, ParseJSON);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+#define _tokenCount 100000
+
+// A line of space separated words.
+static PARCBuffer *
+_createWords(void)
+{
+    PARCBuffer *result = parcBuffer_Allocate(_tokenCount * 8);
+    for (int i = 0; i < _tokenCount; i++) {
+        parcBuffer_PutArray(result, 8, (const uint8_t *) "abcdefg ");
+    }
+    return parcBuffer_Flip(result);
+}
+
+// Split the words of the buffer, and count those equal to "abcdefg".
+LONGBOW_TEST_CASE(Performance, Tokenize)
+{
+    PARCBuffer *words = _createWords();
+
+    double start = _seconds();
+    size_t slices = 0;
+    while (parcBuffer_Remaining(words) > 0) {
+        size_t end = parcBuffer_FindUint8(words, ' ');
+        PARCBuffer *word = parcBuffer_Slice(words);
+        parcBuffer_SetLimit(word, end - parcBuffer_Position(words));
+        if (parcBuffer_Remaining(word) == 7 && memcmp(parcBuffer_Overlay(word, 0), "abcdefg", 7) == 0) {
+            slices++;
+        }
+        parcBuffer_Release(&word);
+        parcBuffer_SetPosition(words, end + 1);
+    }
+    double sliceTime = _seconds() - start;
+
+    parcBuffer_Rewind(words);
+    PARCBufferView view;
+    parcBufferView_InitFromBuffer(&view, words);
+
+    start = _seconds();
+    size_t views = 0;
+    while (parcBufferView_Remaining(&view) > 0) {
+        size_t end = parcBufferView_FindUint8(&view, ' ');
+        PARCBufferView word;
+        parcBufferView_Slice(&word, &view, end - parcBufferView_Position(&view));
+        if (parcBufferView_EqualsCString(&word, "abcdefg")) {
+            views++;
+        }
+        parcBufferView_SetPosition(&view, end + 1);
+    }
+    double viewTime = _seconds() - start;
+
+    assertTrue(slices == _tokenCount && views == _tokenCount, "Expected %d words, actual %zd and %zd", _tokenCount, slices, views);
+    printf("parcBuffer_Slice     %8.2f ns/token\n", sliceTime * 1e9 / _tokenCount);
+    printf("parcBufferView_Slice %8.2f ns/token\n", viewTime * 1e9 / _tokenCount);
+
+    parcBuffer_Release(&words);
+}
+
+// An object with many string members and string array elements.
+LONGBOW_TEST_CASE(Performance, ParseJSON)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcBufferComposer_PutString(composer, "{ ");
+    for (int i = 0; i < 1000; i++) {
+        parcBufferComposer_Format(composer, "\"name%d\" : [ \"a longer string value %d\", \"another\" ], ", i, i);
+    }
+    parcBufferComposer_PutString(composer, "\"last\" : \"value\" }");
+    PARCBuffer *buffer = parcBufferComposer_ProduceBuffer(composer);
+    char *string = parcBuffer_ToString(buffer);
+
+    int iterations = 100;
+    double start = _seconds();
+    for (int i = 0; i < iterations; i++) {
+        PARCJSON *json = parcJSON_ParseString(string);
+        parcJSON_Release(&json);
+    }
+    double seconds = _seconds() - start;
+    printf("parcJSON_ParseString %8.2f MB/s\n", (double) strlen(string) * iterations / seconds / 1e6);
+
+    parcMemory_Deallocate(&string);
+    parcBuffer_Release(&buffer);
+    parcBufferComposer_Release(&composer);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_BufferView);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -72,6 +72,12 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Wrap_ZeroLength);
 
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Wrap);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_MapFile_ReadOnly);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_MapFile_CopyOnWrite);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_MapFile_Shared);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_MapFile_BadDescriptor);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Advise);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Advise_NotMapped);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Array);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_AddressOfIndex);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Capacity);
@@ -145,6 +151,114 @@ LONGBOW_TEST_CASE(Global, parcByteArray_Wrap_ZeroLength)
     parcByteArray_Release(&actual);
 }
 
+/**
+ * Create a temporary file of @p length bytes, each the low byte of its index, and return an open descriptor of it.
+ */
+static int
+_createMappableFile(char *pathName, size_t length)
+{
+    int fd = mkstemp(pathName);
+    assertTrue(fd >= 0, "mkstemp(%s) failed: %s", pathName, strerror(errno));
+
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = (uint8_t) i;
+        ssize_t written = write(fd, &byte, 1);
+        assertTrue(written == 1, "write failed: %s", strerror(errno));
+    }
+    return fd;
+}
+
+LONGBOW_TEST_CASE(Global, parcByteArray_MapFile_ReadOnly)
+{
+    char pathName[] = "/tmp/test_parc_ByteArray_XXXXXX";
+    int fd = _createMappableFile(pathName, 10000);
+
+    PARCByteArray *array = parcByteArray_MapFile(fd, 10000, PARCByteArrayMap_ReadOnly);
+    close(fd);
+    unlink(pathName);
+
+    assertNotNull(array, "Expected the file to be mapped.");
+    assertTrue(parcByteArray_IsMapped(array), "Expected the PARCByteArray to be mapped.");
+    assertTrue(parcByteArray_Capacity(array) == 10000, "Expected capacity 10000, actual %zd", parcByteArray_Capacity(array));
+    for (size_t i = 0; i < 10000; i++) {
+        assertTrue(parcByteArray_GetByte(array, i) == (uint8_t) i, "Expected the content of the file at %zd", i);
+    }
+
+    parcByteArray_Release(&array);
+}
+
+LONGBOW_TEST_CASE(Global, parcByteArray_MapFile_CopyOnWrite)
+{
+    char pathName[] = "/tmp/test_parc_ByteArray_XXXXXX";
+    int fd = _createMappableFile(pathName, 100);
+
+    PARCByteArray *array = parcByteArray_MapFile(fd, 100, PARCByteArrayMap_CopyOnWrite);
+    parcByteArray_PutByte(array, 0, 0xFF);
+    assertTrue(parcByteArray_GetByte(array, 0) == 0xFF, "Expected the change to be visible in the PARCByteArray.");
+    parcByteArray_Release(&array);
+
+    uint8_t byte = 0xFF;
+    pread(fd, &byte, 1, 0);
+    assertTrue(byte == 0, "Expected the file to be unchanged, actual 0x%02x", byte);
+
+    close(fd);
+    unlink(pathName);
+}
+
+LONGBOW_TEST_CASE(Global, parcByteArray_MapFile_Shared)
+{
+    char pathName[] = "/tmp/test_parc_ByteArray_XXXXXX";
+    int fd = _createMappableFile(pathName, 100);
+
+    PARCByteArray *array = parcByteArray_MapFile(fd, 100, PARCByteArrayMap_Shared);
+    parcByteArray_PutByte(array, 0, 0xFF);
+    parcByteArray_Release(&array);
+
+    uint8_t byte = 0;
+    pread(fd, &byte, 1, 0);
+    assertTrue(byte == 0xFF, "Expected the change to be written to the file, actual 0x%02x", byte);
+
+    close(fd);
+    unlink(pathName);
+}
+
+LONGBOW_TEST_CASE(Global, parcByteArray_MapFile_BadDescriptor)
+{
+    PARCByteArray *array = parcByteArray_MapFile(-1, 100, PARCByteArrayMap_ReadOnly);
+    assertNull(array, "Expected NULL for a bad file descriptor.");
+}
+
+LONGBOW_TEST_CASE(Global, parcByteArray_Advise)
+{
+    char pathName[] = "/tmp/test_parc_ByteArray_XXXXXX";
+    int fd = _createMappableFile(pathName, 10000);
+
+    PARCByteArray *array = parcByteArray_MapFile(fd, 10000, PARCByteArrayMap_ReadOnly);
+    close(fd);
+    unlink(pathName);
+
+    assertTrue(parcByteArray_Advise(array, 0, 10000, PARCByteArrayAdvice_Sequential), "Expected sequential advice to be accepted.");
+    assertTrue(parcByteArray_Advise(array, 5000, 100, PARCByteArrayAdvice_Random), "Expected advice within a page to be accepted.");
+    assertTrue(parcByteArray_Advise(array, 1, 9999, PARCByteArrayAdvice_WillNeed), "Expected will-need advice to be accepted.");
+    assertTrue(parcByteArray_Advise(array, 0, 10000, PARCByteArrayAdvice_DontNeed), "Expected dont-need advice to be accepted.");
+    assertTrue(parcByteArray_Advise(array, 0, 10000, PARCByteArrayAdvice_Normal), "Expected normal advice to be accepted.");
+    assertFalse(parcByteArray_Advise(array, 10000, 0, PARCByteArrayAdvice_Normal), "Expected no advice for no bytes.");
+
+    assertTrue(parcByteArray_GetByte(array, 9999) == (uint8_t) 9999, "Expected the content to be read again after dont-need.");
+
+    parcByteArray_Release(&array);
+}
+
+LONGBOW_TEST_CASE(Global, parcByteArray_Advise_NotMapped)
+{
+    PARCByteArray *array = parcByteArray_Allocate(100);
+
+    assertFalse(parcByteArray_IsMapped(array), "Expected an allocated PARCByteArray not to be mapped.");
+    assertFalse(parcByteArray_Advise(array, 0, 100, PARCByteArrayAdvice_DontNeed), "Expected no advice for memory that is not mapped.");
+
+    parcByteArray_Release(&array);
+}
+
 LONGBOW_TEST_CASE(Global, parcByteArray_Array)
 {
     uint8_t buffer[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
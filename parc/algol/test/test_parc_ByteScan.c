@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_ByteScan.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/testing/parc_MemoryTesting.h>
+
+static const PARCByteScanLevel _levels[] = { PARCByteScanLevel_Scalar, PARCByteScanLevel_SSE2, PARCByteScanLevel_AVX2 };
+
+#define _levelCount (sizeof(_levels) / sizeof(_levels[0]))
+
+static size_t
+_referenceFindAny(size_t length, const uint8_t *array, size_t setLength, const uint8_t *set, bool inSet)
+{
+    for (size_t i = 0; i < length; i++) {
+        if ((memchr(set, array[i], setLength) != NULL) == inSet) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+static size_t
+_referenceFindBytes(size_t length, const uint8_t *array, size_t patternLength, const uint8_t *pattern)
+{
+    for (size_t i = 0; i + patternLength <= length; i++) {
+        if (memcmp(&array[i], pattern, patternLength) == 0) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+LONGBOW_TEST_RUNNER(parc_ByteScan)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ByteScan)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ByteScan)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_GetLevel);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_SetLevel);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_FindByte);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_FindAny);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_FindAny_EmptySet);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_FindAny_LargeSet);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_FindNotAny);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_FindBytes);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_FindBytes_Overlapping);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteScan_Random);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    PARCByteScanLevel *level = parcMemory_Allocate(sizeof(PARCByteScanLevel));
+    *level = parcByteScan_GetLevel();
+    longBowTestCase_SetClipBoardData(testCase, level);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    PARCByteScanLevel *level = longBowTestCase_GetClipBoardData(testCase);
+    parcByteScan_SetLevel(*level);
+    parcMemory_Deallocate(&level);
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_GetLevel)
+{
+    PARCByteScanLevel level = parcByteScan_GetLevel();
+    assertTrue(level == _parcByteScan_Supported,
+               "Expected the highest supported level %d by default, actual %d", _parcByteScan_Supported, level);
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_SetLevel)
+{
+    PARCByteScanLevel supported = parcByteScan_GetLevel();
+
+    PARCByteScanLevel previous = parcByteScan_SetLevel(PARCByteScanLevel_Scalar);
+    assertTrue(previous == supported, "Expected the previous level %d, actual %d", supported, previous);
+    assertTrue(parcByteScan_GetLevel() == PARCByteScanLevel_Scalar, "Expected the scalar level.");
+
+    parcByteScan_SetLevel(PARCByteScanLevel_AVX2);
+    assertTrue(parcByteScan_GetLevel() == supported,
+               "Expected a level above the supported level to be lowered to %d, actual %d", supported, parcByteScan_GetLevel());
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_FindByte)
+{
+    const uint8_t *array = (uint8_t *) "Hello World";
+
+    assertTrue(parcByteScan_FindByte(11, array, 'o') == 4, "Expected 4");
+    assertTrue(parcByteScan_FindByte(11, array, 'd') == 10, "Expected 10");
+    assertTrue(parcByteScan_FindByte(11, array, 'x') == SIZE_MAX, "Expected SIZE_MAX");
+    assertTrue(parcByteScan_FindByte(0, array, 'H') == SIZE_MAX, "Expected SIZE_MAX for an empty array");
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_FindAny)
+{
+    // Long enough for both the vector loop and the scalar tail.
+    const uint8_t *array = (uint8_t *) "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    size_t length = strlen((char *) array);
+
+    for (size_t i = 0; i < _levelCount; i++) {
+        parcByteScan_SetLevel(_levels[i]);
+
+        assertTrue(parcByteScan_FindAny(length, array, 3, (uint8_t *) "9Zz") == 25, "Expected 25 at level %d", _levels[i]);
+        assertTrue(parcByteScan_FindAny(length, array, 2, (uint8_t *) "89") == 60, "Expected 60 at level %d", _levels[i]);
+        assertTrue(parcByteScan_FindAny(length, array, 1, (uint8_t *) "a") == 0, "Expected 0 at level %d", _levels[i]);
+        assertTrue(parcByteScan_FindAny(length, array, 3, (uint8_t *) " !?") == SIZE_MAX, "Expected SIZE_MAX at level %d", _levels[i]);
+        assertTrue(parcByteScan_FindAny(0, array, 1, (uint8_t *) "a") == SIZE_MAX, "Expected SIZE_MAX for an empty array at level %d", _levels[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_FindAny_EmptySet)
+{
+    const uint8_t *array = (uint8_t *) "Hello World";
+
+    for (size_t i = 0; i < _levelCount; i++) {
+        parcByteScan_SetLevel(_levels[i]);
+
+        assertTrue(parcByteScan_FindAny(11, array, 0, NULL) == SIZE_MAX, "Expected nothing to be in an empty set at level %d", _levels[i]);
+        assertTrue(parcByteScan_FindNotAny(11, array, 0, NULL) == 0, "Expected everything to be outside an empty set at level %d", _levels[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_FindAny_LargeSet)
+{
+    uint8_t array[100];
+    memset(array, 'a', sizeof(array));
+    array[77] = '}';
+
+    const uint8_t *set = (uint8_t *) "{}[]()<>,;:\"'`~!@#$%^&*";
+    size_t setLength = strlen((char *) set);
+
+    for (size_t i = 0; i < _levelCount; i++) {
+        parcByteScan_SetLevel(_levels[i]);
+
+        size_t actual = parcByteScan_FindAny(sizeof(array), array, setLength, set);
+        assertTrue(actual == 77, "Expected 77 at level %d, actual %zd", _levels[i], actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_FindNotAny)
+{
+    uint8_t array[100];
+    memset(array, ' ', sizeof(array));
+    array[3] = '\t';
+    array[40] = '\n';
+    array[70] = '{';
+
+    for (size_t i = 0; i < _levelCount; i++) {
+        parcByteScan_SetLevel(_levels[i]);
+
+        size_t actual = parcByteScan_FindNotAny(sizeof(array), array, 4, (uint8_t *) " \t\r\n");
+        assertTrue(actual == 70, "Expected 70 at level %d, actual %zd", _levels[i], actual);
+
+        actual = parcByteScan_FindNotAny(70, array, 4, (uint8_t *) " \t\r\n");
+        assertTrue(actual == SIZE_MAX, "Expected SIZE_MAX at level %d, actual %zd", _levels[i], actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_FindBytes)
+{
+    const uint8_t *array = (uint8_t *) "GET / HTTP/1.1\r\nHost: parc.com\r\nAccept: */*\r\n\r\n";
+    size_t length = strlen((char *) array);
+
+    for (size_t i = 0; i < _levelCount; i++) {
+        parcByteScan_SetLevel(_levels[i]);
+
+        size_t actual = parcByteScan_FindBytes(length, array, 4, (uint8_t *) "\r\n\r\n");
+        assertTrue(actual == 43, "Expected 43 at level %d, actual %zd", _levels[i], actual);
+
+        actual = parcByteScan_FindBytes(length, array, 4, (uint8_t *) "Host");
+        assertTrue(actual == 16, "Expected 16 at level %d, actual %zd", _levels[i], actual);
+
+        actual = parcByteScan_FindBytes(length, array, 1, (uint8_t *) "/");
+        assertTrue(actual == 4, "Expected 4 at level %d, actual %zd", _levels[i], actual);
+
+        actual = parcByteScan_FindBytes(length, array, 5, (uint8_t *) "HTTP2");
+        assertTrue(actual == SIZE_MAX, "Expected SIZE_MAX at level %d, actual %zd", _levels[i], actual);
+
+        actual = parcByteScan_FindBytes(length, array, 0, (uint8_t *) "");
+        assertTrue(actual == 0, "Expected an empty pattern at 0 at level %d, actual %zd", _levels[i], actual);
+
+        actual = parcByteScan_FindBytes(3, array, 4, (uint8_t *) "GET ");
+        assertTrue(actual == SIZE_MAX, "Expected SIZE_MAX for a pattern longer than the array at level %d, actual %zd", _levels[i], actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcByteScan_FindBytes_Overlapping)
+{
+    uint8_t array[80];
+    memset(array, 'a', sizeof(array));
+    array[sizeof(array) - 1] = 'b';
+
+    for (size_t i = 0; i < _levelCount; i++) {
+        parcByteScan_SetLevel(_levels[i]);
+
+        size_t actual = parcByteScan_FindBytes(sizeof(array), array, 3, (uint8_t *) "aab");
+        assertTrue(actual == 77, "Expected 77 at level %d, actual %zd", _levels[i], actual);
+    }
+}
+
+/*
+ * Compare every level with a simple reference implementation,
+ * over arrays of every length up to 100 bytes of a small alphabet, so that there are many partial matches.
+ */
+LONGBOW_TEST_CASE(Global, parcByteScan_Random)
+{
+    uint8_t array[100];
+    uint8_t pattern[5];
+    srandom(1);
+
+    for (int trial = 0; trial < 200; trial++) {
+        for (size_t i = 0; i < sizeof(array); i++) {
+            array[i] = (uint8_t) ('a' + random() % 3);
+        }
+        for (size_t i = 0; i < sizeof(pattern); i++) {
+            pattern[i] = (uint8_t) ('a' + random() % 3);
+        }
+        size_t patternLength = 1 + (size_t) random() % sizeof(pattern);
+        size_t setLength = 1 + (size_t) random() % 2;
+
+        for (size_t length = 0; length <= sizeof(array); length++) {
+            size_t expectedFindAny = _referenceFindAny(length, array, setLength, pattern, true);
+            size_t expectedFindNotAny = _referenceFindAny(length, array, setLength, pattern, false);
+            size_t expectedFindBytes = _referenceFindBytes(length, array, patternLength, pattern);
+
+            for (size_t i = 0; i < _levelCount; i++) {
+                parcByteScan_SetLevel(_levels[i]);
+
+                assertTrue(parcByteScan_FindAny(length, array, setLength, pattern) == expectedFindAny,
+                           "FindAny differs at level %d, length %zd", _levels[i], length);
+                assertTrue(parcByteScan_FindNotAny(length, array, setLength, pattern) == expectedFindNotAny,
+                           "FindNotAny differs at level %d, length %zd", _levels[i], length);
+                assertTrue(parcByteScan_FindBytes(length, array, patternLength, pattern) == expectedFindBytes,
+                           "FindBytes differs at level %d, length %zd", _levels[i], length);
+            }
+        }
+    }
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, FindUint8);
+    LONGBOW_RUN_TEST_CASE(Performance, SkipOver);
+    LONGBOW_RUN_TEST_CASE(Performance, FindBytes);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static const size_t _sizes[] = { 64, 1024, 64 * 1024, 1024 * 1024 };
+
+// Search this many bytes in total for each size.
+#define _bytesPerMeasurement (64 * 1024 * 1024)
+
+static double
+_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+static void
+_report(const char *name, size_t size, double seconds)
+{
+    printf("%-24s %8zd bytes %8.3f GB/s\n", name, size, _bytesPerMeasurement / seconds / 1e9);
+}
+
+// The implementation of parcBuffer_FindUint8 before it used parcByteScan_FindByte.
+static size_t
+_previousFindUint8(const PARCBuffer *buffer, uint8_t byte)
+{
+    for (size_t i = parcBuffer_Position(buffer); i < parcBuffer_Limit(buffer); i++) {
+        if (parcBuffer_GetAtIndex(buffer, i) == byte) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+// The implementation of parcBuffer_SkipOver before it used parcByteScan_FindNotAny.
+static bool
+_previousSkipOver(PARCBuffer *buffer, size_t length, const uint8_t bytesToSkipOver[length])
+{
+    while (parcBuffer_Remaining(buffer) > 0) {
+        uint8_t character = parcBuffer_GetUint8(buffer);
+        if (memchr(bytesToSkipOver, character, length) == NULL) {
+            parcBuffer_SetPosition(buffer, parcBuffer_Position(buffer) - 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+LONGBOW_TEST_CASE(Performance, FindUint8)
+{
+    for (size_t s = 0; s < sizeof(_sizes) / sizeof(_sizes[0]); s++) {
+        size_t size = _sizes[s];
+        size_t iterations = _bytesPerMeasurement / size;
+
+        PARCBuffer *buffer = parcBuffer_Allocate(size);
+        parcBuffer_PutAtIndex(buffer, size - 1, '\n');
+
+        size_t found = 0;
+        double start = _seconds();
+        for (size_t i = 0; i < iterations; i++) {
+            found += _previousFindUint8(buffer, '\n');
+        }
+        _report("FindUint8 previous", size, _seconds() - start);
+
+        start = _seconds();
+        for (size_t i = 0; i < iterations; i++) {
+            found -= parcBuffer_FindUint8(buffer, '\n');
+        }
+        _report("FindUint8", size, _seconds() - start);
+
+        assertTrue(found == 0, "Expected both implementations to find the same byte.");
+        parcBuffer_Release(&buffer);
+    }
+}
+
+LONGBOW_TEST_CASE(Performance, SkipOver)
+{
+    const uint8_t *whitespace = (uint8_t *) " \t\r\n";
+
+    for (size_t s = 0; s < sizeof(_sizes) / sizeof(_sizes[0]); s++) {
+        size_t size = _sizes[s];
+        size_t iterations = _bytesPerMeasurement / size;
+
+        PARCBuffer *buffer = parcBuffer_Allocate(size);
+        for (size_t i = 0; i < size; i++) {
+            parcBuffer_PutAtIndex(buffer, i, whitespace[i % 4]);
+        }
+        parcBuffer_PutAtIndex(buffer, size - 1, '{');
+
+        double start = _seconds();
+        for (size_t i = 0; i < iterations; i++) {
+            parcBuffer_Rewind(buffer);
+            _previousSkipOver(buffer, 4, whitespace);
+        }
+        _report("SkipOver previous", size, _seconds() - start);
+
+        for (size_t level = 0; level < _levelCount; level++) {
+            PARCByteScanLevel previous = parcByteScan_SetLevel(_levels[level]);
+            start = _seconds();
+            for (size_t i = 0; i < iterations; i++) {
+                parcBuffer_Rewind(buffer);
+                parcBuffer_SkipOver(buffer, 4, whitespace);
+            }
+            double seconds = _seconds() - start;
+            char name[32];
+            snprintf(name, sizeof(name), "SkipOver level %d", parcByteScan_GetLevel());
+            _report(name, size, seconds);
+            parcByteScan_SetLevel(previous);
+        }
+
+        assertTrue(parcBuffer_Position(buffer) == size - 1, "Expected to skip to the last byte.");
+        parcBuffer_Release(&buffer);
+    }
+}
+
+LONGBOW_TEST_CASE(Performance, FindBytes)
+{
+    const uint8_t *pattern = (uint8_t *) "\r\n\r\n";
+
+    for (size_t s = 0; s < sizeof(_sizes) / sizeof(_sizes[0]); s++) {
+        size_t size = _sizes[s];
+        size_t iterations = _bytesPerMeasurement / size;
+
+        // Headers with a line ending every 32 bytes, and the end of the headers at the end.
+        uint8_t *array = parcMemory_Allocate(size);
+        memset(array, 'x', size);
+        for (size_t i = 30; i + 2 <= size; i += 32) {
+            memcpy(&array[i], "\r\n", 2);
+        }
+        memcpy(&array[size - 4], pattern, 4);
+
+        size_t found = 0;
+        double start = _seconds();
+        for (size_t i = 0; i < iterations; i++) {
+            found += _referenceFindBytes(size, array, 4, pattern);
+        }
+        _report("FindBytes memcmp loop", size, _seconds() - start);
+
+        for (size_t level = 0; level < _levelCount; level++) {
+            PARCByteScanLevel previous = parcByteScan_SetLevel(_levels[level]);
+            start = _seconds();
+            for (size_t i = 0; i < iterations; i++) {
+                found -= parcByteScan_FindBytes(size, array, 4, pattern);
+            }
+            double seconds = _seconds() - start;
+            char name[32];
+            snprintf(name, sizeof(name), "FindBytes level %d", parcByteScan_GetLevel());
+            _report(name, size, seconds);
+            parcByteScan_SetLevel(previous);
+            found += iterations * (size - 4);
+        }
+
+        assertTrue(found == iterations * (size - 4), "Expected every implementation to find the same bytes.");
+        parcMemory_Deallocate(&array);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ByteScan);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -27,6 +27,8 @@
 #include <config.h>
 #include <LongBow/unit-test.h>
 #include <fcntl.h>
+#include <inttypes.h>
+#include <sys/time.h>
 
 // Include the file(s) containing the functions to be tested.
 // This permits internal static functions to be visible to this Test Framework.
@@ -43,6 +45,7 @@ LONGBOW_TEST_RUNNER(parc_FileOutputStream)
     LONGBOW_RUN_TEST_FIXTURE(Local);
     LONGBOW_RUN_TEST_FIXTURE(AcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -118,6 +121,11 @@ LONGBOW_TEST_CASE(AcquireRelease, parcFileOutputStream_AcquireRelease)
 LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, parcFileOutputStream_Write);
+    LONGBOW_RUN_TEST_CASE(Global, parcFileOutputStream_WriteVector);
+    LONGBOW_RUN_TEST_CASE(Global, parcFileOutputStream_WriteVector_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcFileOutputStream_WriteVector_ManyBuffers);
+    LONGBOW_RUN_TEST_CASE(Global, parcFileOutputStream_WriteVector_ShortWrite);
+    LONGBOW_RUN_TEST_CASE(Global, parcOutputStream_WriteVector);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -154,6 +162,167 @@ LONGBOW_TEST_CASE(Global, parcFileOutputStream_Write)
     unlink("/tmp/test_parc_FileOutputStream");
 }
 
+static PARCBuffer *
+_readFile(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    assertTrue(fd != -1, "Cannot open %s", path);
+
+    PARCBuffer *result = parcBuffer_Allocate(4096);
+    ssize_t nread = read(fd, parcBuffer_Overlay(result, 0), parcBuffer_Remaining(result));
+    close(fd);
+    assertTrue(nread >= 0, "Cannot read %s", path);
+
+    parcBuffer_SetLimit(result, (size_t) nread);
+    return result;
+}
+
+LONGBOW_TEST_CASE(Global, parcFileOutputStream_WriteVector)
+{
+    PARCFileOutputStream *stream =
+        parcFileOutputStream_Create(open("/tmp/test_parc_FileOutputStream", O_CREAT | O_WRONLY | O_TRUNC, 0600));
+
+    PARCBuffer *header = parcBuffer_WrapCString("header ");
+    PARCBuffer *payload = parcBuffer_WrapCString("0123payload");
+    parcBuffer_SetPosition(payload, 4);
+    PARCBuffer *trailer = parcBuffer_WrapCString(" trailer\n");
+
+    PARCBuffer *buffers[3] = { header, payload, trailer };
+    bool result = parcFileOutputStream_WriteVector(stream, 3, buffers);
+    assertTrue(result, "Expected parcFileOutputStream_WriteVector to write every buffer");
+
+    for (int i = 0; i < 3; i++) {
+        assertFalse(parcBuffer_HasRemaining(buffers[i]), "Expected buffer %d to be empty", i);
+    }
+    parcFileOutputStream_Release(&stream);
+
+    PARCBuffer *actual = _readFile("/tmp/test_parc_FileOutputStream");
+    PARCBuffer *expected = parcBuffer_WrapCString("header payload trailer\n");
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the file to contain the buffers in order");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&actual);
+    parcBuffer_Release(&header);
+    parcBuffer_Release(&payload);
+    parcBuffer_Release(&trailer);
+}
+
+LONGBOW_TEST_CASE(Global, parcFileOutputStream_WriteVector_Empty)
+{
+    PARCFileOutputStream *stream =
+        parcFileOutputStream_Create(open("/tmp/test_parc_FileOutputStream", O_CREAT | O_WRONLY | O_TRUNC, 0600));
+
+    assertTrue(parcFileOutputStream_WriteVector(stream, 0, NULL), "Expected writing no buffers to succeed");
+
+    PARCBuffer *empty = parcBuffer_Allocate(0);
+    PARCBuffer *data = parcBuffer_WrapCString("data");
+    PARCBuffer *buffers[3] = { empty, data, empty };
+    assertTrue(parcFileOutputStream_WriteVector(stream, 3, buffers), "Expected empty buffers to be skipped");
+    assertFalse(parcBuffer_HasRemaining(data), "Expected the buffer to be empty");
+
+    parcFileOutputStream_Release(&stream);
+
+    PARCBuffer *actual = _readFile("/tmp/test_parc_FileOutputStream");
+    assertTrue(parcBuffer_Remaining(actual) == 4, "Expected 4 bytes, actual %zu", parcBuffer_Remaining(actual));
+
+    parcBuffer_Release(&actual);
+    parcBuffer_Release(&empty);
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_CASE(Global, parcFileOutputStream_WriteVector_ManyBuffers)
+{
+    PARCFileOutputStream *stream =
+        parcFileOutputStream_Create(open("/tmp/test_parc_FileOutputStream", O_CREAT | O_WRONLY | O_TRUNC, 0600));
+
+    // More buffers than a single writev(2) accepts.
+    const size_t count = IOV_MAX * 2 + 3;
+    PARCBuffer **buffers = parcMemory_AllocateAndClear(count * sizeof(PARCBuffer *));
+    for (size_t i = 0; i < count; i++) {
+        buffers[i] = parcBuffer_Allocate(1);
+        parcBuffer_PutUint8(buffers[i], (uint8_t) ('a' + (i % 26)));
+        parcBuffer_Flip(buffers[i]);
+    }
+
+    assertTrue(parcFileOutputStream_WriteVector(stream, count, buffers), "Expected every buffer to be written");
+    parcFileOutputStream_Release(&stream);
+
+    int fd = open("/tmp/test_parc_FileOutputStream", O_RDONLY);
+    PARCBuffer *actual = parcBuffer_Allocate(count);
+    ssize_t nread = read(fd, parcBuffer_Overlay(actual, 0), count);
+    close(fd);
+    assertTrue(nread == (ssize_t) count, "Expected %zu bytes, actual %zd", count, nread);
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t byte = parcBuffer_GetUint8(actual);
+        assertTrue(byte == (uint8_t) ('a' + (i % 26)), "Byte %zu out of order", i);
+        parcBuffer_Release(&buffers[i]);
+    }
+
+    parcBuffer_Release(&actual);
+    parcMemory_Deallocate((void **) &buffers);
+}
+
+LONGBOW_TEST_CASE(Global, parcFileOutputStream_WriteVector_ShortWrite)
+{
+    // A non-blocking pipe accepts only part of the data, leaving the rest in the buffers.
+    int fds[2];
+    assertTrue(pipe(fds) == 0, "pipe(2) failed");
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+
+    PARCFileOutputStream *stream = parcFileOutputStream_Create(fds[1]);
+
+    const size_t length = 1024 * 1024;
+    PARCBuffer *header = parcBuffer_WrapCString("header");
+    PARCBuffer *payload = parcBuffer_Allocate(length);
+    PARCBuffer *buffers[2] = { header, payload };
+
+    bool result = parcFileOutputStream_WriteVector(stream, 2, buffers);
+    assertFalse(result, "Expected a short write on a full pipe");
+    assertFalse(parcBuffer_HasRemaining(header), "Expected the header to be written");
+
+    size_t written = 6 + parcBuffer_Position(payload);
+    size_t drained = 0;
+    char scratch[4096];
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    for (ssize_t nread; (nread = read(fds[0], scratch, sizeof(scratch))) > 0; ) {
+        drained += (size_t) nread;
+    }
+    assertTrue(drained == written,
+               "Expected the buffer positions to account for the bytes written: positions %zu, pipe %zu", written, drained);
+
+    parcFileOutputStream_Release(&stream);
+    close(fds[0]);
+    parcBuffer_Release(&header);
+    parcBuffer_Release(&payload);
+}
+
+LONGBOW_TEST_CASE(Global, parcOutputStream_WriteVector)
+{
+    PARCFileOutputStream *fileStream =
+        parcFileOutputStream_Create(open("/tmp/test_parc_FileOutputStream", O_CREAT | O_WRONLY | O_TRUNC, 0600));
+    PARCOutputStream *stream = parcFileOutputStream_AsOutputStream(fileStream);
+    parcFileOutputStream_Release(&fileStream);
+
+    PARCBuffer *header = parcBuffer_WrapCString("Hello");
+    PARCBuffer *payload = parcBuffer_WrapCString(" ");
+    PARCBuffer *trailer = parcBuffer_WrapCString("World");
+    PARCBuffer *buffers[3] = { header, payload, trailer };
+
+    assertTrue(parcOutputStream_WriteVector(stream, 3, buffers), "Expected parcOutputStream_WriteVector to succeed");
+    parcOutputStream_Release(&stream);
+
+    PARCBuffer *actual = _readFile("/tmp/test_parc_FileOutputStream");
+    PARCBuffer *expected = parcBuffer_WrapCString("Hello World");
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected the file to contain the buffers in order");
+
+    parcBuffer_Release(&expected);
+    parcBuffer_Release(&actual);
+    parcBuffer_Release(&header);
+    parcBuffer_Release(&payload);
+    parcBuffer_Release(&trailer);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
 }
@@ -168,6 +337,67 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, WriteVersusWriteVector);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static uint64_t
+_elapsedMicroseconds(struct timeval *start)
+{
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    return (uint64_t) (end.tv_sec - start->tv_sec) * 1000000 + (uint64_t) (end.tv_usec - start->tv_usec);
+}
+
+LONGBOW_TEST_CASE(Performance, WriteVersusWriteVector)
+{
+    const int messages = 200000;
+
+    PARCFileOutputStream *stream = parcFileOutputStream_Create(open("/dev/null", O_WRONLY));
+
+    PARCBuffer *header = parcBuffer_Allocate(24);
+    PARCBuffer *payload = parcBuffer_Allocate(200);
+    PARCBuffer *trailer = parcBuffer_Allocate(3);
+    PARCBuffer *buffers[3] = { header, payload, trailer };
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < messages; i++) {
+        for (int j = 0; j < 3; j++) {
+            parcFileOutputStream_Write(stream, parcBuffer_Rewind(buffers[j]));
+        }
+    }
+    uint64_t writeTime = _elapsedMicroseconds(&start);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < messages; i++) {
+        for (int j = 0; j < 3; j++) {
+            parcBuffer_Rewind(buffers[j]);
+        }
+        parcFileOutputStream_WriteVector(stream, 3, buffers);
+    }
+    uint64_t writeVectorTime = _elapsedMicroseconds(&start);
+
+    printf("%d messages of header + payload + trailer: Write x3 %" PRIu64 " us, WriteVector %" PRIu64 " us\n",
+           messages, writeTime, writeVectorTime);
+
+    parcBuffer_Release(&header);
+    parcBuffer_Release(&payload);
+    parcBuffer_Release(&trailer);
+    parcFileOutputStream_Release(&stream);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -0,0 +1,556 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_HugePageMemory.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+#define _Threshold ((size_t) 1024 * 1024)
+
+LONGBOW_TEST_RUNNER(parc_HugePageMemory)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Configuration);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_HugePageMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_HugePageMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Allocate_Small);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Allocate_Large);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Allocate_Zero);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_AllocateAndClear);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_MemAlign);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_MemAlign_BadAlignment);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Reallocate_Large);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Reallocate_SmallToLarge);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Reallocate_NULL);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_ReallocateInPlace);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_GoodSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_UsableSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_ForgedTag);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Mode_Off);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_Mode_HugeTLB);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_NUMA_Local);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_NUMA_Interleave);
+    LONGBOW_RUN_TEST_CASE(Global, parcHugePageMemory_AsPARCMemory);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    PARCHugePageMemoryConfiguration *original = malloc(sizeof(PARCHugePageMemoryConfiguration));
+    *original = parcHugePageMemory_GetConfiguration();
+    longBowTestCase_SetClipBoardData(testCase, original);
+
+    PARCHugePageMemoryConfiguration configuration = {
+        .mode      = PARCHugePageMemoryMode_Transparent,
+        .numa      = PARCHugePageMemoryNUMA_Off,
+        .threshold = _Threshold
+    };
+    parcHugePageMemory_Configure(&configuration);
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    PARCHugePageMemoryConfiguration *original = longBowTestCase_GetClipBoardData(testCase);
+    parcHugePageMemory_Configure(original);
+    free(original);
+
+    PARCHugePageMemoryStatistics statistics = parcHugePageMemory_GetStatistics();
+    if (statistics.mappings != 0 || statistics.mappedBytes != 0) {
+        printf("%s leaks %zd mappings of %zd bytes.\n", longBowTestCase_GetFullName(testCase), statistics.mappings, statistics.mappedBytes);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Allocate_Small)
+{
+    void *memory = parcHugePageMemory_Allocate(100);
+
+    assertNotNull(memory, "parcHugePageMemory_Allocate failed: NULL result.");
+    assertFalse(_isLarge(memory), "Expected a small allocation to come from the standard library.");
+    assertTrue(parcHugePageMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %u", parcHugePageMemory_Outstanding());
+
+    parcHugePageMemory_Deallocate(&memory);
+    assertNull(memory, "Expected the pointer to be set to NULL.");
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Allocate_Large)
+{
+    size_t size = _Threshold;
+    unsigned char *memory = parcHugePageMemory_Allocate(size);
+
+    assertNotNull(memory, "parcHugePageMemory_Allocate failed: NULL result.");
+    assertTrue(_isLarge(memory), "Expected a large allocation to be mapped.");
+    assertTrue(((uintptr_t) _header(memory) & (parcHugePageMemory_PageSize - 1)) == 0,
+               "Expected the mapping to be aligned on a huge page.");
+    assertTrue(((uintptr_t) memory & 63) == 0, "Expected %p to be aligned on a cache line.", (void *) memory);
+
+    PARCHugePageMemoryStatistics statistics = parcHugePageMemory_GetStatistics();
+    assertTrue(statistics.mappings == 1, "Expected 1 mapping, actual %zd", statistics.mappings);
+    assertTrue(statistics.mappedBytes == parcHugePageMemory_PageSize,
+               "Expected %zd mapped bytes, actual %zd", parcHugePageMemory_PageSize, statistics.mappedBytes);
+    assertTrue(parcHugePageMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %u", parcHugePageMemory_Outstanding());
+
+    memset(memory, 0xff, size);
+    parcHugePageMemory_Deallocate((void **) &memory);
+    assertNull(memory, "Expected the pointer to be set to NULL.");
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Allocate_Zero)
+{
+    assertNull(parcHugePageMemory_Allocate(0), "Expected NULL for a zero length allocation.");
+    assertNull(parcHugePageMemory_AllocateAndClear(0), "Expected NULL for a zero length allocation.");
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_AllocateAndClear)
+{
+    size_t sizes[] = { 100, _Threshold * 3 };
+
+    for (int s = 0; s < 2; s++) {
+        unsigned char *memory = parcHugePageMemory_AllocateAndClear(sizes[s]);
+        for (size_t i = 0; i < sizes[s]; i++) {
+            assertTrue(memory[i] == 0, "Expected byte %zd of %zd to be cleared.", i, sizes[s]);
+        }
+        parcHugePageMemory_Deallocate((void **) &memory);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_MemAlign)
+{
+    size_t alignments[] = { sizeof(void *), 4096, parcHugePageMemory_PageSize, 2 * parcHugePageMemory_PageSize };
+    size_t sizes[] = { 100, _Threshold };
+
+    for (int a = 0; a < sizeof(alignments) / sizeof(alignments[0]); a++) {
+        for (int s = 0; s < 2; s++) {
+            void *memory;
+            int failure = parcHugePageMemory_MemAlign(&memory, alignments[a], sizes[s]);
+            assertTrue(failure == 0, "parcHugePageMemory_MemAlign failed: %d", failure);
+            assertTrue(((uintptr_t) memory & (alignments[a] - 1)) == 0,
+                       "Expected %p to be aligned on %zd bytes", memory, alignments[a]);
+
+            memset(memory, 0xff, sizes[s]);
+            parcHugePageMemory_Deallocate(&memory);
+        }
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_MemAlign_BadAlignment)
+{
+    void *memory;
+    int failure = parcHugePageMemory_MemAlign(&memory, 3, _Threshold);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a bad alignment, actual %d", failure);
+
+    failure = parcHugePageMemory_MemAlign(&memory, sizeof(void *), 0);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a zero size, actual %d", failure);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Reallocate_Large)
+{
+    size_t sizes[] = { _Threshold, _Threshold + 100, 5 * _Threshold, 100 };
+
+    unsigned char *memory = parcHugePageMemory_Allocate(sizes[0]);
+    for (size_t i = 0; i < sizes[0]; i++) {
+        memory[i] = (unsigned char) i;
+    }
+
+    size_t preserved = sizes[0];
+    for (int s = 1; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        memory = parcHugePageMemory_Reallocate(memory, sizes[s]);
+        assertTrue(_isLarge(memory), "Expected the allocation to remain large.");
+
+        preserved = (sizes[s] < preserved) ? sizes[s] : preserved;
+        for (size_t i = 0; i < preserved; i++) {
+            assertTrue(memory[i] == (unsigned char) i, "Expected byte %zd to be preserved reallocating to %zd bytes.", i, sizes[s]);
+        }
+    }
+
+    parcHugePageMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Reallocate_SmallToLarge)
+{
+    unsigned char *memory = parcHugePageMemory_Allocate(100);
+    for (size_t i = 0; i < 100; i++) {
+        memory[i] = (unsigned char) i;
+    }
+
+    memory = parcHugePageMemory_Reallocate(memory, 2 * _Threshold);
+#if defined(__APPLE__) || defined(__GLIBC__)
+    assertTrue(_isLarge(memory), "Expected the allocation to move to huge pages.");
+#endif
+    for (size_t i = 0; i < 100; i++) {
+        assertTrue(memory[i] == (unsigned char) i, "Expected byte %zd to be preserved.", i);
+    }
+    assertTrue(parcHugePageMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %u", parcHugePageMemory_Outstanding());
+
+    parcHugePageMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Reallocate_NULL)
+{
+    void *memory = parcHugePageMemory_Reallocate(NULL, _Threshold);
+    assertTrue(_isLarge(memory), "Expected a large allocation.");
+    parcHugePageMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_ReallocateInPlace)
+{
+    void *memory = parcHugePageMemory_Allocate(_Threshold);
+
+    assertTrue(parcHugePageMemory_ReallocateInPlace(memory, parcHugePageMemory_PageSize - _parcHugePageMemory_MinimumOffset),
+               "Expected the allocation to grow to the end of its mapping.");
+    assertFalse(parcHugePageMemory_ReallocateInPlace(memory, parcHugePageMemory_PageSize),
+                "Expected the allocation not to grow beyond its mapping.");
+    assertTrue(_header(memory)->length == parcHugePageMemory_PageSize - _parcHugePageMemory_MinimumOffset,
+               "Expected the length to be updated.");
+
+    parcHugePageMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_GoodSize)
+{
+    size_t expected = parcHugePageMemory_PageSize - _parcHugePageMemory_MinimumOffset;
+    size_t actual = parcHugePageMemory_GoodSize(_Threshold);
+    assertTrue(actual == expected, "Expected %zd, actual %zd", expected, actual);
+
+    actual = parcHugePageMemory_GoodSize(100);
+    assertTrue(actual == parcStdlibMemory_GoodSize(100), "Expected the standard library's good size, actual %zd", actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_UsableSize)
+{
+    void *memory = parcHugePageMemory_Allocate(_Threshold);
+    size_t expected = parcHugePageMemory_GoodSize(_Threshold);
+    size_t actual = parcHugePageMemory_UsableSize(memory);
+    assertTrue(actual == expected, "Expected %zd, actual %zd", expected, actual);
+    parcHugePageMemory_Deallocate(&memory);
+
+    memory = parcHugePageMemory_Allocate(100);
+    actual = parcHugePageMemory_UsableSize(memory);
+    assertTrue(actual == parcStdlibMemory_UsableSize(memory), "Expected the standard library's size, actual %zd", actual);
+    parcHugePageMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_ForgedTag)
+{
+    // A live mapping, so that membership cannot be decided by an empty registry.
+    void *large = parcHugePageMemory_Allocate(_Threshold);
+
+    unsigned char *a = parcHugePageMemory_Allocate(24);
+    void *b = parcHugePageMemory_Allocate(24);
+
+    // The end of a's usable memory may be the 16 bytes before b, where a tag used to mark a large allocation.
+    uint64_t tag = 0x4A6E9A6E4A6E9A6EULL;
+    memcpy(&a[parcStdlibMemory_UsableSize(a) - sizeof(tag)], &tag, sizeof(tag));
+
+    assertFalse(_isLarge(b), "Expected a small allocation not to be taken for a large one.");
+    size_t actual = parcHugePageMemory_UsableSize(b);
+    assertTrue(actual == parcStdlibMemory_UsableSize(b), "Expected the standard library's size %zd, actual %zd",
+               parcStdlibMemory_UsableSize(b), actual);
+
+    parcHugePageMemory_Deallocate(&b);
+    assertNull(b, "Expected the pointer to be set to NULL.");
+
+    PARCHugePageMemoryStatistics statistics = parcHugePageMemory_GetStatistics();
+    assertTrue(statistics.mappings == 1, "Expected 1 mapping, actual %zd", statistics.mappings);
+
+    parcHugePageMemory_Deallocate((void **) &a);
+    parcHugePageMemory_Deallocate(&large);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_StringDuplicate)
+{
+    char *actual = parcHugePageMemory_StringDuplicate("Hello World", 5);
+    assertTrue(strcmp(actual, "Hello") == 0, "Expected %s, actual %s", "Hello", actual);
+    parcHugePageMemory_Deallocate((void **) &actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Mode_Off)
+{
+    PARCHugePageMemoryConfiguration configuration = parcHugePageMemory_GetConfiguration();
+    configuration.mode = PARCHugePageMemoryMode_Off;
+    parcHugePageMemory_Configure(&configuration);
+
+    void *memory = parcHugePageMemory_Allocate(_Threshold);
+    assertFalse(_isLarge(memory), "Expected every allocation to come from the standard library.");
+    parcHugePageMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_Mode_HugeTLB)
+{
+    PARCHugePageMemoryConfiguration configuration = parcHugePageMemory_GetConfiguration();
+    configuration.mode = PARCHugePageMemoryMode_HugeTLB;
+    parcHugePageMemory_Configure(&configuration);
+
+    // Without reserved huge pages, this falls back to transparent huge pages.
+    unsigned char *memory = parcHugePageMemory_Allocate(_Threshold);
+    assertNotNull(memory, "Expected an allocation whether or not the kernel reserved huge pages.");
+    assertTrue(_isLarge(memory), "Expected a large allocation.");
+    memset(memory, 0xff, _Threshold);
+
+    PARCHugePageMemoryStatistics statistics = parcHugePageMemory_GetStatistics();
+    assertTrue(statistics.hugeTLBMappings == (_header(memory)->hugeTLB ? 1 : 0),
+               "Expected the statistics to count the huge page pool mapping.");
+
+    parcHugePageMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_NUMA_Local)
+{
+    PARCHugePageMemoryConfiguration configuration = parcHugePageMemory_GetConfiguration();
+    configuration.numa = PARCHugePageMemoryNUMA_Local;
+    parcHugePageMemory_Configure(&configuration);
+
+    // Binding may be refused, for example in a container, but the allocation must succeed.
+    unsigned char *memory = parcHugePageMemory_Allocate(_Threshold);
+    assertNotNull(memory, "Expected an allocation whether or not it could be bound.");
+    memset(memory, 0xff, _Threshold);
+    parcHugePageMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_NUMA_Interleave)
+{
+    PARCHugePageMemoryConfiguration configuration = parcHugePageMemory_GetConfiguration();
+    configuration.numa = PARCHugePageMemoryNUMA_Interleave;
+    parcHugePageMemory_Configure(&configuration);
+
+    unsigned char *memory = parcHugePageMemory_Allocate(_Threshold);
+    assertNotNull(memory, "Expected an allocation whether or not it could be bound.");
+    memset(memory, 0xff, _Threshold);
+    parcHugePageMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcHugePageMemory_AsPARCMemory)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCHugePageMemoryAsPARCMemory);
+
+    PARCBuffer *buffer = parcBuffer_Allocate(2 * _Threshold);
+    parcBuffer_SetPosition(buffer, _Threshold);
+    parcBuffer_PutUint64(buffer, 42);
+    assertTrue(parcHugePageMemory_GetStatistics().mappings == 1, "Expected the buffer's array to be mapped.");
+    parcBuffer_Release(&buffer);
+
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_FIXTURE(Configuration)
+{
+    LONGBOW_RUN_TEST_CASE(Configuration, parcHugePageMemory_ReadEnvironment);
+    LONGBOW_RUN_TEST_CASE(Configuration, parcHugePageMemory_ReadEnvironment_Defaults);
+    LONGBOW_RUN_TEST_CASE(Configuration, parcHugePageMemory_ReadEnvironment_Invalid);
+    LONGBOW_RUN_TEST_CASE(Configuration, _parseSize);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Configuration)
+{
+    unsetenv("PARC_HUGEPAGE_MODE");
+    unsetenv("PARC_HUGEPAGE_THRESHOLD");
+    unsetenv("PARC_HUGEPAGE_NUMA");
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Configuration)
+{
+    unsetenv("PARC_HUGEPAGE_MODE");
+    unsetenv("PARC_HUGEPAGE_THRESHOLD");
+    unsetenv("PARC_HUGEPAGE_NUMA");
+    parcHugePageMemory_ReadEnvironment();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Configuration, parcHugePageMemory_ReadEnvironment)
+{
+    setenv("PARC_HUGEPAGE_MODE", "hugetlb", 1);
+    setenv("PARC_HUGEPAGE_THRESHOLD", "16M", 1);
+    setenv("PARC_HUGEPAGE_NUMA", "interleave", 1);
+    parcHugePageMemory_ReadEnvironment();
+
+    PARCHugePageMemoryConfiguration actual = parcHugePageMemory_GetConfiguration();
+    assertTrue(actual.mode == PARCHugePageMemoryMode_HugeTLB, "Expected the hugetlb mode, actual %d", actual.mode);
+    assertTrue(actual.threshold == 16 * 1024 * 1024, "Expected a threshold of 16M, actual %zd", actual.threshold);
+    assertTrue(actual.numa == PARCHugePageMemoryNUMA_Interleave, "Expected the interleave policy, actual %d", actual.numa);
+
+    setenv("PARC_HUGEPAGE_MODE", "OFF", 1);
+    setenv("PARC_HUGEPAGE_NUMA", "local", 1);
+    parcHugePageMemory_ReadEnvironment();
+
+    actual = parcHugePageMemory_GetConfiguration();
+    assertTrue(actual.mode == PARCHugePageMemoryMode_Off, "Expected the mode to be off, actual %d", actual.mode);
+    assertTrue(actual.numa == PARCHugePageMemoryNUMA_Local, "Expected the local policy, actual %d", actual.numa);
+}
+
+LONGBOW_TEST_CASE(Configuration, parcHugePageMemory_ReadEnvironment_Defaults)
+{
+    parcHugePageMemory_ReadEnvironment();
+
+    PARCHugePageMemoryConfiguration actual = parcHugePageMemory_GetConfiguration();
+    assertTrue(actual.mode == PARCHugePageMemoryMode_Transparent, "Expected the transparent mode, actual %d", actual.mode);
+    assertTrue(actual.threshold == parcHugePageMemory_DefaultThreshold, "Expected the default threshold, actual %zd", actual.threshold);
+    assertTrue(actual.numa == PARCHugePageMemoryNUMA_Off, "Expected no NUMA policy, actual %d", actual.numa);
+}
+
+LONGBOW_TEST_CASE(Configuration, parcHugePageMemory_ReadEnvironment_Invalid)
+{
+    setenv("PARC_HUGEPAGE_MODE", "sometimes", 1);
+    setenv("PARC_HUGEPAGE_THRESHOLD", "lots", 1);
+    setenv("PARC_HUGEPAGE_NUMA", "remote", 1);
+    parcHugePageMemory_ReadEnvironment();
+
+    PARCHugePageMemoryConfiguration actual = parcHugePageMemory_GetConfiguration();
+    assertTrue(actual.mode == PARCHugePageMemoryMode_Transparent, "Expected the transparent mode, actual %d", actual.mode);
+    assertTrue(actual.threshold == parcHugePageMemory_DefaultThreshold, "Expected the default threshold, actual %zd", actual.threshold);
+    assertTrue(actual.numa == PARCHugePageMemoryNUMA_Off, "Expected no NUMA policy, actual %d", actual.numa);
+}
+
+LONGBOW_TEST_CASE(Configuration, _parseSize)
+{
+    struct {
+        const char *string;
+        bool valid;
+        size_t size;
+    } cases[] = {
+        { "4096", true,  4096                       },
+        { "64k",  true,  64 * 1024                  },
+        { "2M",   true,  2 * 1024 * 1024            },
+        { "1G",   true,  (size_t) 1024 * 1024 * 1024 },
+        { "0",    false, 0                          },
+        { "",     false, 0                          },
+        { "12Q",  false, 0                          },
+        { "4KB",  false, 0                          },
+    };
+
+    for (int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        size_t actual = 0;
+        bool valid = _parseSize(cases[i].string, &actual);
+        assertTrue(valid == cases[i].valid, "Expected '%s' to be %s", cases[i].string, cases[i].valid ? "valid" : "invalid");
+        if (valid) {
+            assertTrue(actual == cases[i].size, "Expected '%s' to be %zd, actual %zd", cases[i].string, cases[i].size, actual);
+        }
+    }
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, RandomLookup_1GB);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/**
+ * Fill a table of 2^27 64-bit slots (1 GiB), then time a dependent chain of random lookups,
+ * each of which is likely to miss both the cache and the TLB.
+ */
+static double
+_randomLookupTime(const PARCMemoryInterface *memory, uint64_t *checksum)
+{
+    const size_t slots = (size_t) 1 << 27;
+    const size_t lookups = 20000000;
+
+    uint64_t *table = ((PARCMemoryAllocate *) memory->Allocate)(slots * sizeof(uint64_t));
+    assertNotNull(table, "Cannot allocate a 1 GiB table.");
+
+    for (size_t i = 0; i < slots; i++) {
+        table[i] = i * 0x9E3779B97F4A7C15ULL;
+    }
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    uint64_t key = 1;
+    for (size_t i = 0; i < lookups; i++) {
+        key = table[(key ^ (key >> 29)) & (slots - 1)] + i;
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    *checksum = key;
+    ((PARCMemoryDeallocate *) memory->Deallocate)((void **) &table);
+
+    return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, RandomLookup_1GB)
+{
+    uint64_t stdlibChecksum;
+    double stdlibTime = _randomLookupTime(&PARCStdlibMemoryAsPARCMemory, &stdlibChecksum);
+
+    uint64_t hugePageChecksum;
+    double hugePageTime = _randomLookupTime(&PARCHugePageMemoryAsPARCMemory, &hugePageChecksum);
+
+    assertTrue(stdlibChecksum == hugePageChecksum, "Expected the same lookups.");
+    printf("20000000 random lookups in a 1 GiB table: stdlib %.3fs, huge pages %.3fs (%.2fx)\n",
+           stdlibTime, hugePageTime, stdlibTime / hugePageTime);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_HugePageMemory);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -129,6 +129,8 @@ LONGBOW_TEST_FIXTURE(JSONParse)
     LONGBOW_RUN_TEST_CASE(JSONParse, parcJSONString_Parser);
     LONGBOW_RUN_TEST_CASE(JSONParse, parcJSONParser_RequireString_Fail);
     LONGBOW_RUN_TEST_CASE(JSONParse, parcJSONString_Parser_Quoted);
+    LONGBOW_RUN_TEST_CASE(JSONParse, parcJSONString_Parser_Plain);
+    LONGBOW_RUN_TEST_CASE(JSONParse, parcJSONString_Parser_Unterminated);
     LONGBOW_RUN_TEST_CASE(JSONParse, parcJSON_Parse);
 
     LONGBOW_RUN_TEST_CASE(JSONParse, parcJSON_ParseFile);
@@ -204,6 +206,41 @@ LONGBOW_TEST_CASE(JSONParse, parcJSONString_Parser_Quoted)
     parcBuffer_Release(&buffer);
 }
 
+LONGBOW_TEST_CASE(JSONParse, parcJSONString_Parser_Plain)
+{
+    char *string = "\"string\" : 1";
+
+    PARCBuffer *buffer = parcBuffer_WrapCString(string);
+
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+
+    PARCBuffer *expected = parcBuffer_WrapCString("string");
+    PARCBuffer *actual = parcJSONParser_ParseString(parser);
+
+    assertTrue(parcBuffer_Equals(expected, actual), "Expected string");
+    assertTrue(parcBuffer_Position(buffer) == 8, "Expected the parser to be just past the string, actual %zd", parcBuffer_Position(buffer));
+
+    parcBuffer_Release(&actual);
+    parcBuffer_Release(&expected);
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(JSONParse, parcJSONString_Parser_Unterminated)
+{
+    char *string = "\"string";
+
+    PARCBuffer *buffer = parcBuffer_WrapCString(string);
+
+    PARCJSONParser *parser = parcJSONParser_Create(buffer);
+
+    PARCBuffer *actual = parcJSONParser_ParseString(parser);
+    assertNull(actual, "Expected an unterminated string to be a syntax error.");
+
+    parcJSONParser_Release(&parser);
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(JSONParse, parcJSON_Parse)
 {
     char *expected = "{ \"string\" : \"string\", \"null\" : null, \"true\" : true, \"false\" : false, \"integer\" : 31415, \"float\" : 3.141500, \"array\" : [ null, false, true, 31415, \"string\", [ null, false, true, 31415, \"string\" ], {  } ] }";
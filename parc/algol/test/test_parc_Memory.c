@@ -64,9 +64,27 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_AllocateAndClear);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_MemAlign);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_Reallocate);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_DeallocateSized);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_DeallocateSized_Unsupported);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_GoodSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_GoodSize_Unsupported);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_ReallocateInPlace);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_ReallocateInPlace_Unsupported);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_UsableSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_UsableSize_Unsupported);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_SetSoftLimit);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_GetUsage);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_GetUsage_NoLimit);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_GetUsage_OtherThread);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_AddPressureCallback);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_AddPressureCallback_Evict);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_RemovePressureCallback);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_StringDuplicate);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_Outstanding);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_SetInterface);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_GetInterface);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_SetThreadInterface);
+    LONGBOW_RUN_TEST_CASE(Global, parcMemory_SetThreadInterface_OtherThread);
     LONGBOW_RUN_TEST_CASE(Global, parcMemory_Format);
 }
 
@@ -148,6 +166,279 @@ LONGBOW_TEST_CASE(Global, parcMemory_Reallocate)
     assertNull(pointer, "Expected pointer to not be NULL");
 }
 
+LONGBOW_TEST_CASE(Global, parcMemory_DeallocateSized)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    void *pointer = parcMemory_Allocate(100);
+    parcMemory_DeallocateSized(&pointer, 100);
+    assertNull(pointer, "Expected pointer to be NULL");
+
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_DeallocateSized_Unsupported)
+{
+    // The standard library provider has no sized deallocation, so this falls back to Deallocate.
+    void *pointer = parcMemory_Allocate(100);
+    parcMemory_DeallocateSized(&pointer, 100);
+    assertNull(pointer, "Expected pointer to be NULL");
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_GoodSize)
+{
+    for (size_t size = 1; size < 1000; size++) {
+        size_t actual = parcMemory_GoodSize(size);
+        assertTrue(actual >= size, "Expected at least %zd, actual %zd", size, actual);
+        assertTrue(parcMemory_GoodSize(actual) == actual, "Expected a good size to be its own good size: %zd", actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_GoodSize_Unsupported)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    size_t actual = parcMemory_GoodSize(100);
+    assertTrue(actual == 100, "Expected 100, actual %zd", actual);
+
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_ReallocateInPlace)
+{
+    void *pointer = parcMemory_Allocate(100);
+
+    assertTrue(parcMemory_ReallocateInPlace(pointer, 50), "Expected an allocation to shrink in place.");
+    assertFalse(parcMemory_ReallocateInPlace(NULL, 50), "Expected NULL not to be resized.");
+
+    parcMemory_Deallocate(&pointer);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_ReallocateInPlace_Unsupported)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    void *pointer = parcMemory_Allocate(100);
+    assertFalse(parcMemory_ReallocateInPlace(pointer, 50), "Expected parcSafeMemory to never resize in place.");
+    parcMemory_Deallocate(&pointer);
+
+    parcMemory_SetInterface(original);
+}
+
+static uint32_t _threadOutstandingCalls;
+
+static uint32_t
+_threadOutstanding(void)
+{
+    _threadOutstandingCalls++;
+    return 0;
+}
+
+static PARCMemoryInterface _threadInterface = {
+    .Allocate         = (uintptr_t) parcSafeMemory_Allocate,
+    .AllocateAndClear = (uintptr_t) parcSafeMemory_AllocateAndClear,
+    .MemAlign         = (uintptr_t) parcSafeMemory_MemAlign,
+    .Deallocate       = (uintptr_t) parcSafeMemory_Deallocate,
+    .Reallocate       = (uintptr_t) parcSafeMemory_Reallocate,
+    .StringDuplicate  = (uintptr_t) parcSafeMemory_StringDuplicate,
+    .Outstanding      = (uintptr_t) _threadOutstanding
+};
+
+LONGBOW_TEST_CASE(Global, parcMemory_UsableSize)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    void *pointer = parcMemory_Allocate(100);
+    size_t actual = parcMemory_UsableSize(pointer);
+    assertTrue(actual == 100, "Expected 100, actual %zd", actual);
+    parcMemory_Deallocate(&pointer);
+
+    assertTrue(parcMemory_UsableSize(NULL) == 0, "Expected NULL to have no size.");
+
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_UsableSize_Unsupported)
+{
+    parcMemory_SetThreadInterface(&_threadInterface);
+
+    void *pointer = parcMemory_Allocate(100);
+    size_t actual = parcMemory_UsableSize(pointer);
+    assertTrue(actual == 0, "Expected 0, actual %zd", actual);
+    parcMemory_Deallocate(&pointer);
+
+    parcMemory_SetThreadInterface(NULL);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_SetSoftLimit)
+{
+    assertTrue(parcMemory_GetSoftLimit() == 0, "Expected no soft limit by default.");
+
+    size_t previous = parcMemory_SetSoftLimit(1024 * 1024);
+    assertTrue(previous == 0, "Expected no previous soft limit, actual %zd", previous);
+    assertTrue(parcMemory_GetSoftLimit() == 1024 * 1024, "Expected the soft limit that was set.");
+
+    previous = parcMemory_SetSoftLimit(0);
+    assertTrue(previous == 1024 * 1024, "Expected the previous soft limit, actual %zd", previous);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_GetUsage)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    parcMemory_SetSoftLimit(1024 * 1024);
+
+    void *pointer = parcMemory_Allocate(1000);
+    size_t actual = parcMemory_GetUsage();
+    assertTrue(actual == 1000, "Expected 1000, actual %zd", actual);
+
+    pointer = parcMemory_Reallocate(pointer, 3000);
+    actual = parcMemory_GetUsage();
+    assertTrue(actual == 3000, "Expected 3000, actual %zd", actual);
+
+    char *string = parcMemory_StringDuplicate("Hello World", 100);
+    actual = parcMemory_GetUsage();
+    assertTrue(actual == 3012, "Expected 3012, actual %zd", actual);
+
+    parcMemory_Deallocate(&string);
+    parcMemory_DeallocateSized(&pointer, 3000);
+    actual = parcMemory_GetUsage();
+    assertTrue(actual == 0, "Expected 0, actual %zd", actual);
+
+    parcMemory_SetSoftLimit(0);
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_GetUsage_NoLimit)
+{
+    void *pointer = parcMemory_Allocate(1000);
+    size_t actual = parcMemory_GetUsage();
+    assertTrue(actual == 0, "Expected nothing to be counted without a soft limit, actual %zd", actual);
+    parcMemory_Deallocate(&pointer);
+}
+
+static void *
+_allocateAndExit(void *pointer)
+{
+    *(void **) pointer = parcMemory_Allocate(1000);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_GetUsage_OtherThread)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    parcMemory_SetSoftLimit(1024 * 1024);
+
+    void *pointer = NULL;
+    pthread_t thread;
+    pthread_create(&thread, NULL, _allocateAndExit, &pointer);
+    pthread_join(thread, NULL);
+
+    // The count of the thread was added to the shared count when it exited.
+    size_t actual = parcMemory_GetUsage();
+    assertTrue(actual == 1000, "Expected 1000, actual %zd", actual);
+
+    parcMemory_Deallocate(&pointer);
+    actual = parcMemory_GetUsage();
+    assertTrue(actual == 0, "Expected 0, actual %zd", actual);
+
+    parcMemory_SetSoftLimit(0);
+    parcMemory_SetInterface(original);
+}
+
+typedef struct {
+    unsigned int calls;
+    size_t usage;
+    size_t softLimit;
+    void *evict;
+} _PressureState;
+
+static void
+_pressure(void *context, size_t usage, size_t softLimit)
+{
+    _PressureState *state = context;
+    state->calls++;
+    state->usage = usage;
+    state->softLimit = softLimit;
+    if (state->evict != NULL) {
+        parcMemory_Deallocate(&state->evict);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_AddPressureCallback)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    parcMemory_SetSoftLimit(1024 * 1024);
+
+    _PressureState state = { 0 };
+    parcMemory_AddPressureCallback(50, _pressure, &state);
+
+    void *small = parcMemory_Allocate(256 * 1024);
+    assertTrue(state.calls == 0, "Expected no callback below the threshold, actual %u", state.calls);
+
+    void *large = parcMemory_Allocate(512 * 1024);
+    assertTrue(state.calls == 1, "Expected one callback above the threshold, actual %u", state.calls);
+    assertTrue(state.usage == 768 * 1024, "Expected the usage %d, actual %zd", 768 * 1024, state.usage);
+    assertTrue(state.softLimit == 1024 * 1024, "Expected the soft limit, actual %zd", state.softLimit);
+
+    void *more = parcMemory_Allocate(128 * 1024);
+    assertTrue(state.calls == 1, "Expected no callback until the usage falls below the threshold, actual %u", state.calls);
+
+    parcMemory_Deallocate(&more);
+    parcMemory_Deallocate(&large);
+    large = parcMemory_Allocate(512 * 1024);
+    assertTrue(state.calls == 2, "Expected the callback again after the usage fell, actual %u", state.calls);
+
+    parcMemory_Deallocate(&large);
+    parcMemory_Deallocate(&small);
+
+    assertTrue(parcMemory_RemovePressureCallback(_pressure, &state), "Expected the callback to be removed.");
+    parcMemory_SetSoftLimit(0);
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_AddPressureCallback_Evict)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    parcMemory_SetSoftLimit(1024 * 1024);
+
+    _PressureState state = { 0 };
+    state.evict = parcMemory_Allocate(512 * 1024);
+    parcMemory_AddPressureCallback(90, _pressure, &state);
+
+    void *pointer = parcMemory_Allocate(512 * 1024);
+    assertTrue(state.calls == 1, "Expected one callback, actual %u", state.calls);
+    assertNull(state.evict, "Expected the callback to have deallocated its memory.");
+
+    size_t actual = parcMemory_GetUsage();
+    assertTrue(actual == 512 * 1024, "Expected %d, actual %zd", 512 * 1024, actual);
+
+    parcMemory_Deallocate(&pointer);
+
+    parcMemory_RemovePressureCallback(_pressure, &state);
+    parcMemory_SetSoftLimit(0);
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_RemovePressureCallback)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    parcMemory_SetSoftLimit(1024 * 1024);
+
+    _PressureState state = { 0 };
+    parcMemory_AddPressureCallback(10, _pressure, &state);
+    parcMemory_AddPressureCallback(20, _pressure, &state);
+
+    assertTrue(parcMemory_RemovePressureCallback(_pressure, &state), "Expected the callbacks to be removed.");
+    assertFalse(parcMemory_RemovePressureCallback(_pressure, &state), "Expected no callback to remain.");
+
+    void *pointer = parcMemory_Allocate(512 * 1024);
+    assertTrue(state.calls == 0, "Expected no callback after it was removed, actual %u", state.calls);
+    parcMemory_Deallocate(&pointer);
+
+    parcMemory_SetSoftLimit(0);
+    parcMemory_SetInterface(original);
+}
+
 LONGBOW_TEST_CASE(Global, parcMemory_AllocateAndClear)
 {
     void *pointer;
@@ -196,6 +487,58 @@ LONGBOW_TEST_CASE(Global, parcMemory_SetInterface)
     parcMemory_SetInterface(old);
 }
 
+LONGBOW_TEST_CASE(Global, parcMemory_GetInterface)
+{
+    const PARCMemoryInterface *old = parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+
+    assertTrue(parcMemory_GetInterface() == &PARCSafeMemoryAsPARCMemory, "Expected the interface that was set.");
+
+    parcMemory_SetInterface(old);
+}
+
+static void *
+_callOutstanding(void *unused)
+{
+    parcMemory_Outstanding();
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_SetThreadInterface)
+{
+    _threadOutstandingCalls = 0;
+
+    assertNull(parcMemory_GetThreadInterface(), "Expected no thread interface.");
+
+    const PARCMemoryInterface *previous = parcMemory_SetThreadInterface(&_threadInterface);
+    assertNull(previous, "Expected no previous thread interface.");
+    assertTrue(parcMemory_GetThreadInterface() == &_threadInterface, "Expected the thread interface to be set.");
+
+    parcMemory_Outstanding();
+    assertTrue(_threadOutstandingCalls == 1, "Expected the thread interface to be used.");
+
+    previous = parcMemory_SetThreadInterface(NULL);
+    assertTrue(previous == &_threadInterface, "Expected the previous thread interface to be returned.");
+    assertNull(parcMemory_GetThreadInterface(), "Expected the thread interface to be cleared.");
+
+    parcMemory_Outstanding();
+    assertTrue(_threadOutstandingCalls == 1, "Expected the global interface to be used.");
+}
+
+LONGBOW_TEST_CASE(Global, parcMemory_SetThreadInterface_OtherThread)
+{
+    _threadOutstandingCalls = 0;
+
+    parcMemory_SetThreadInterface(&_threadInterface);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _callOutstanding, NULL);
+    pthread_join(thread, NULL);
+
+    parcMemory_SetThreadInterface(NULL);
+
+    assertTrue(_threadOutstandingCalls == 0, "Expected another thread to use the global interface.");
+}
+
 LONGBOW_TEST_CASE(Global, parcMemory_Format)
 {
     char *expected = "Hello World";
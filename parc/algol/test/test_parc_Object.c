@@ -114,6 +114,8 @@ _dummy_Copy(const _DummyObject *obj)
     return newDummy;
 }
 
+parcObject_DeclareImmortal(_DummyObject, _immortalDummy, { .calledCount = 0, .val = 42 });
+
 typedef _dummy_object _DummyObjectNoHash;
 parcObject_ExtendPARCObject(_DummyObjectNoHash,
                             _dummy_Destroy,
@@ -124,6 +126,18 @@ parcObject_ExtendPARCObject(_DummyObjectNoHash,
                             NULL,
                             _dummy_ToJSON);
 
+typedef _dummy_object _DummyObjectChild;
+parcObject_Override(_DummyObjectChild, _DummyObject,
+                    .display = NULL);
+
+typedef _dummy_object _DummyObjectGrandchild;
+parcObject_Override(_DummyObjectGrandchild, _DummyObjectChild,
+                    .display = NULL);
+
+typedef _dummy_object _DummyObjectAligned;
+parcObject_Override(_DummyObjectAligned, _DummyObject,
+                    .alignment = 64);
+
 static bool
 _meta_destructor_true(PARCObject **objPtr)
 {
@@ -312,6 +326,8 @@ LONGBOW_TEST_FIXTURE(AcquireRelease)
 {
     LONGBOW_RUN_TEST_CASE(AcquireRelease, parcObject_Acquire);
     LONGBOW_RUN_TEST_CASE(AcquireRelease, parcObject_Release);
+    LONGBOW_RUN_TEST_CASE(AcquireRelease, parcObject_MakeImmortal);
+    LONGBOW_RUN_TEST_CASE(AcquireRelease, parcObject_DeclareImmortal);
 //    LONGBOW_RUN_TEST_CASE(AcquireRelease, parcObject_Acquire_Invalid);
 }
 
@@ -350,16 +366,68 @@ LONGBOW_TEST_CASE(AcquireRelease, parcObject_Release)
     assertTrue(time == 0, "Expected memory pointer to be NULL after destroy.");
 }
 
+LONGBOW_TEST_CASE(AcquireRelease, parcObject_MakeImmortal)
+{
+    _DummyObject *object = parcObject_CreateAndClearInstance(_DummyObject);
+    assertFalse(parcObject_IsImmortal(object), "Expected a new instance to be mortal.");
+
+    _DummyObject *immortal = parcObject_MakeImmortal(object);
+    assertTrue(immortal == object, "Expected parcObject_MakeImmortal to return its argument.");
+    assertTrue(parcObject_IsImmortal(object), "Expected the instance to be immortal.");
+
+    _DummyObject *reference = parcObject_Acquire(object);
+    assertTrue(parcObject_GetReferenceCount(object) == parcObject_ImmortalReferenceCount,
+               "Expected parcObject_Acquire to leave the reference count unchanged.");
+
+    PARCReferenceCount count = parcObject_Release((PARCObject **) &reference);
+    assertNull(reference, "Expected the pointer to be set to NULL.");
+    assertTrue(count == parcObject_ImmortalReferenceCount, "Expected the immortal reference count, actual %" PRIu64, count);
+
+    reference = immortal;
+    parcObject_Release((PARCObject **) &reference);
+    assertTrue(object->calledCount == 0 && parcObject_IsValid(object), "Expected the instance to survive its last release.");
+
+    // Restore the reference count so the memory is not reported as leaked.
+    _parcObject_Header(object)->references = 1;
+    parcObject_Release((PARCObject **) &object);
+}
+
+LONGBOW_TEST_CASE(AcquireRelease, parcObject_DeclareImmortal)
+{
+    assertTrue(parcObject_IsValid(_immortalDummy), "Expected a valid statically declared instance.");
+    assertTrue(parcObject_IsImmortal(_immortalDummy), "Expected a statically declared instance to be immortal.");
+    assertTrue(parcObject_IsInstanceOf(_immortalDummy, &_DummyObject_Descriptor), "Expected an instance of _DummyObject");
+    assertTrue(_immortalDummy->val == 42, "Expected the instance to be initialized.");
+
+    _DummyObject *reference = parcObject_Acquire(_immortalDummy);
+    assertTrue(reference == _immortalDummy, "Expected parcObject_Acquire to return its argument.");
+
+    parcObject_Release((PARCObject **) &reference);
+    assertNull(reference, "Expected the pointer to be set to NULL.");
+    assertTrue(parcObject_GetReferenceCount(_immortalDummy) == parcObject_ImmortalReferenceCount,
+               "Expected the reference count to be unchanged.");
+
+    _DummyObject *copy = parcObject_Copy(_immortalDummy);
+    assertTrue(parcObject_Equals(copy, _immortalDummy), "Expected the copy to be equal to the instance.");
+    parcObject_Release((PARCObject **) &copy);
+}
+
 LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, parcObject_Create);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_CreateAndClear);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_CreateAlignedInstance);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_CreateAlignedInstance_Invalid);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_CreateAndClearAlignedInstance);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_CreateAndClearAlignedInstance_Equals);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_CreateInstance_DescriptorAlignment);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_IsValid);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_IsValid_NotValid);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_IsInstanceOf);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_Copy_Default);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_Copy);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_Release);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_Resurrect);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_Compare_Default);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_Compare_NoOverride);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_Compare);
@@ -369,6 +437,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcObject_HashCode_Default);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_HashCode_NoOverride);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_HashCode);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_HashCode_Frozen);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_InvalidateHashCode);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_ToString_Default);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_ToString_NoOverride);
     LONGBOW_RUN_TEST_CASE(Global, parcObject_ToString);
@@ -414,6 +484,37 @@ LONGBOW_TEST_CASE(Global, parcObject_Release)
     assertTrue(time == 0, "Expected memory pointer to be NULL after destroy.");
 }
 
+static PARCObject *_resurrected = NULL;
+
+static bool
+_resurrectingDestructor(PARCObject **objectPointer)
+{
+    _resurrected = parcObject_Resurrect(*objectPointer);
+    *objectPointer = NULL;
+    return false;
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_Resurrect)
+{
+    PARCObjectDescriptor *descriptor =
+        parcObjectDescriptor_Create("Resurrect", _resurrectingDestructor, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &PARCObject_Descriptor);
+
+    struct timeval *time = parcObject_CreateInstanceImpl(sizeof(struct timeval), descriptor);
+    struct timeval *original = time;
+
+    PARCReferenceCount count = parcObject_Release((PARCObject **) &time);
+    assertTrue(count == 0, "Expected reference count to be zero");
+    assertNull(time, "Expected memory pointer to be NULL after release.");
+    assertTrue(_resurrected == original, "Expected the destructor to have kept the object.");
+    parcObject_AssertValid(_resurrected);
+    assertTrue(parcObject_GetReferenceCount(_resurrected) == 1,
+               "Expected 1 reference, actual %" PRIu64, parcObject_GetReferenceCount(_resurrected));
+
+    parcObject_SetDescriptor(_resurrected, &PARCObject_Descriptor);
+    parcObject_Release(&_resurrected);
+    parcObjectDescriptor_Destroy(&descriptor);
+}
+
 LONGBOW_TEST_CASE(Global, parcObject_Create)
 {
     struct timeval *time = parcObject_Create(struct timeval);
@@ -440,6 +541,74 @@ LONGBOW_TEST_CASE(Global, parcObject_CreateAndClear)
     assertTrue(time == 0, "Expected memory pointer to be NULL after destroy.");
 }
 
+LONGBOW_TEST_CASE(Global, parcObject_CreateAlignedInstance)
+{
+    for (size_t alignment = sizeof(void *); alignment <= parcObject_MaximumAlignment; alignment <<= 1) {
+        _DummyObject *dummy = parcObject_CreateAlignedInstance(_DummyObject, alignment);
+        parcObject_AssertValid(dummy);
+
+        assertTrue(((uintptr_t) dummy & (alignment - 1)) == 0, "Expected %p to be aligned on %zd bytes", (void *) dummy, alignment);
+
+        _PARCObjectHeader *header = _parcObject_Header(dummy);
+        assertTrue(header->objectAlignment == alignment, "Expected alignment %zd, actual %d", alignment, header->objectAlignment);
+        assertTrue(header->objectLength == sizeof(_DummyObject),
+                   "Expected the object length %zd to be the requested length %zd", header->objectLength, sizeof(_DummyObject));
+        assertTrue(parcObject_IsInstanceOf(dummy, &_DummyObject_Descriptor), "Expected an instance of _DummyObject");
+
+        parcObject_Release((PARCObject **) &dummy);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_CreateAlignedInstance_Invalid)
+{
+    size_t invalid[] = { 0, 1, sizeof(void *) / 2, sizeof(void *) + 1, 48, parcObject_MaximumAlignment * 2 };
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        PARCObject *object = parcObject_CreateAlignedInstance(_DummyObject, invalid[i]);
+        assertNull(object, "Expected NULL for alignment %zd", invalid[i]);
+        assertTrue(errno == EINVAL, "Expected errno to be EINVAL for alignment %zd", invalid[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_CreateAndClearAlignedInstance)
+{
+    _DummyObject *dummy = parcObject_CreateAndClearAlignedInstance(_DummyObject, 64);
+
+    assertTrue(((uintptr_t) dummy & 63) == 0, "Expected %p to be aligned on 64 bytes", (void *) dummy);
+    assertTrue(dummy->calledCount == 0 && dummy->val == 0, "Expected the instance to be cleared.");
+
+    parcObject_Release((PARCObject **) &dummy);
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_CreateAndClearAlignedInstance_Equals)
+{
+    struct timeval *x = parcObject_CreateAndClearAlignedInstanceImpl(sizeof(struct timeval), 64, &PARCObject_Descriptor);
+    struct timeval *y = parcObject_CreateAndClearAlignedInstanceImpl(sizeof(struct timeval), 64, &PARCObject_Descriptor);
+
+    // The padding up to the alignment is not part of the object, so its contents must not matter.
+    memset((char *) x + sizeof(struct timeval), 0xA5, 64 - sizeof(struct timeval));
+    memset((char *) y + sizeof(struct timeval), 0x5A, 64 - sizeof(struct timeval));
+
+    assertTrue(parcObject_Equals(x, y), "Expected two cleared aligned instances to be equal.");
+    assertTrue(parcObject_Compare(x, y) == 0, "Expected two cleared aligned instances to compare equal.");
+    assertTrue(parcObject_HashCode(x) == parcObject_HashCode(y), "Expected two cleared aligned instances to have the same hash code.");
+
+    parcObject_Release((PARCObject **) &x);
+    parcObject_Release((PARCObject **) &y);
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_CreateInstance_DescriptorAlignment)
+{
+    _DummyObjectAligned *dummy = parcObject_CreateAndClearInstance(_DummyObjectAligned);
+
+    assertTrue(((uintptr_t) dummy & 63) == 0, "Expected %p to be aligned on 64 bytes", (void *) dummy);
+    assertTrue(_parcObject_Header(dummy)->objectAlignment == 64, "Expected the descriptor's alignment.");
+
+    assertTrue(parcObject_IsInstanceOf(dummy, &_DummyObject_Descriptor), "Expected an instance of the supertype.");
+
+    parcObject_Release((PARCObject **) &dummy);
+}
+
 LONGBOW_TEST_CASE(Global, parcObject_IsValid)
 {
     PARCObject *object = parcObject_CreateInstanceImpl(sizeof(struct timeval), &PARCObject_Descriptor);
@@ -726,6 +895,42 @@ LONGBOW_TEST_CASE(Global, parcObject_HashCode)
     parcObject_Release((PARCObject **) &dummy);
 }
 
+LONGBOW_TEST_CASE(Global, parcObject_HashCode_Frozen)
+{
+    _DummyObject *dummy = parcObject_CreateAndClearInstance(_DummyObject);
+    assertFalse(parcObject_IsFrozen(dummy), "Expected a new object to not be frozen.");
+
+    parcObject_HashCode(dummy);
+    parcObject_HashCode(dummy);
+    assertTrue(dummy->calledCount == 2, "Expected the hashcode of an object that is not frozen to be computed each time.");
+
+    parcObject_Freeze(dummy);
+    assertTrue(parcObject_IsFrozen(dummy), "Expected the object to be frozen.");
+
+    parcObject_HashCode(dummy);
+    PARCHashCode hashCode = parcObject_HashCode(dummy);
+    assertTrue(hashCode == 1337, "Expected hashcode to be 1337, got %" PRIPARCHashCode, hashCode);
+    assertTrue(dummy->calledCount == 3, "Expected the hashcode of a frozen object to be computed once.");
+
+    parcObject_Release((PARCObject **) &dummy);
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_InvalidateHashCode)
+{
+    _DummyObject *dummy = parcObject_CreateAndClearInstance(_DummyObject);
+    parcObject_Freeze(dummy);
+
+    parcObject_HashCode(dummy);
+    parcObject_InvalidateHashCode(dummy);
+    parcObject_HashCode(dummy);
+    parcObject_HashCode(dummy);
+
+    assertTrue(dummy->calledCount == 2, "Expected the hashcode to be computed again after it was invalidated.");
+    assertTrue(parcObject_IsFrozen(dummy), "Expected the object to remain frozen.");
+
+    parcObject_Release((PARCObject **) &dummy);
+}
+
 LONGBOW_TEST_CASE(Global, parcObject_ToString)
 {
     _DummyObject *dummy = parcObject_CreateInstance(_DummyObject);
@@ -860,6 +1065,8 @@ LONGBOW_TEST_CASE(Global, parcObject_Display)
 LONGBOW_TEST_FIXTURE(Subclasses)
 {
     LONGBOW_RUN_TEST_CASE(Subclasses, parcObject_Copy);
+    LONGBOW_RUN_TEST_CASE(Subclasses, parcObject_Override_Inherited);
+    LONGBOW_RUN_TEST_CASE(Subclasses, parcObjectDescriptor_Create_Inherited);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Subclasses)
@@ -901,12 +1108,50 @@ LONGBOW_TEST_CASE(Subclasses, parcObject_Copy)
     parcMemory_Deallocate((void **) &objectType);
 }
 
+LONGBOW_TEST_CASE(Subclasses, parcObject_Override_Inherited)
+{
+    _DummyObjectGrandchild *x = parcObject_CreateInstance(_DummyObjectGrandchild);
+    _DummyObjectGrandchild *y = parcObject_CreateInstance(_DummyObjectGrandchild);
+    x->calledCount = 0;
+    y->calledCount = 0;
+
+    assertTrue(parcObject_Equals(x, y), "Expected the inherited equals function to be used.");
+    assertTrue(parcObject_HashCode(x) == 1337, "Expected the inherited hashCode function to be used.");
+
+    const _PARCObjectVTable *vtable = _DummyObjectGrandchild_Descriptor.vtable;
+    assertTrue(vtable->resolved, "Expected the vtable to be resolved on first use.");
+    assertTrue(vtable->equals == _DummyObject_Descriptor.equals, "Expected the vtable to hold the inherited equals function.");
+    assertTrue(vtable->hashCode == _DummyObject_Descriptor.hashCode, "Expected the vtable to hold the inherited hashCode function.");
+    assertTrue(vtable->display == PARCObject_Descriptor.display, "Expected the vtable to hold the inherited display function.");
+
+    parcObject_Release((PARCObject **) &x);
+    parcObject_Release((PARCObject **) &y);
+}
+
+LONGBOW_TEST_CASE(Subclasses, parcObjectDescriptor_Create_Inherited)
+{
+    PARCObjectDescriptor *objectType =
+        parcObjectDescriptor_Create("Dummy", NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, (PARCObjectDescriptor *) &_DummyObject_Descriptor);
+
+    _DummyObject *dummy = parcObject_CreateInstance(_DummyObject);
+    parcObject_SetDescriptor(dummy, objectType);
+
+    assertTrue(parcObject_HashCode(dummy) == 1337, "Expected the inherited hashCode function to be used.");
+    assertTrue(objectType->vtable->resolved, "Expected the vtable to be resolved on first use.");
+    assertTrue(objectType->vtable->hashCode == _DummyObject_Descriptor.hashCode,
+               "Expected the vtable to hold the inherited hashCode function.");
+
+    parcObject_Release((PARCObject **) &dummy);
+    parcObjectDescriptor_Destroy(&objectType);
+}
+
 
 LONGBOW_TEST_FIXTURE(Locking)
 {
     LONGBOW_RUN_TEST_CASE(Locking, parcObject_TryLock_Unlock);
     LONGBOW_RUN_TEST_CASE(Locking, parcObject_TryLock_AlreadyLockedSameThread);
     LONGBOW_RUN_TEST_CASE(Locking, parcObject_Lock_Unlock);
+    LONGBOW_RUN_TEST_CASE(Locking, parcObject_Locking_Lazy);
 }
 static uint32_t initialAllocations;
 
@@ -974,6 +1219,22 @@ LONGBOW_TEST_CASE(Locking, parcObject_Lock_Unlock)
     assertFalse(actual, "Expected parcObject_IsLocked to be false.");
 }
 
+LONGBOW_TEST_CASE(Locking, parcObject_Locking_Lazy)
+{
+    _DummyObject *dummy = longBowTestCase_GetClipBoardData(testCase);
+    _PARCObjectHeader *header = _parcObject_Header(dummy);
+
+    assertNull(header->locking, "Expected a new object to have no locking state.");
+
+    assertFalse(parcObject_IsLocked(dummy), "Expected parcObject_IsLocked to be false.");
+    assertFalse(parcObject_Unlock(dummy), "Expected parcObject_Unlock of a never locked object to fail.");
+    assertNull(header->locking, "Expected parcObject_IsLocked and parcObject_Unlock to not create the locking state.");
+
+    assertTrue(parcObject_Lock(dummy), "Expected parcObject_Lock to succeed.");
+    assertNotNull(header->locking, "Expected parcObject_Lock to create the locking state.");
+    assertTrue(parcObject_Unlock(dummy), "Expected parcObject_Unlock to succeed.");
+}
+
 LONGBOW_TEST_CASE_EXPECTS(Locking, parcObject_TryLock_AlreadyLockedSameThread, .event = &LongBowTrapCannotObtainLockEvent)
 {
     _DummyObject *dummy = longBowTestCase_GetClipBoardData(testCase);
@@ -1206,6 +1467,11 @@ LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
     LONGBOW_RUN_TEST_CASE(Performance, parcObject_CreateRelease);
     LONGBOW_RUN_TEST_CASE(Performance, parcObject_Create);
     LONGBOW_RUN_TEST_CASE(Performance, parcObject_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_HeaderLength);
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_CreateRelease_Rate);
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_EqualsHashCode_Rate);
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_AcquireRelease_Immortal_Threads);
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_CreateAlignedInstance_FalseSharing);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -1284,6 +1550,48 @@ LONGBOW_TEST_CASE(Performance, parcObject_Create)
     }
 }
 
+static double
+_elapsedSeconds(const struct timeval *start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - start->tv_sec) + (now.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_HeaderLength)
+{
+    // The header with the locking state embedded, as it was before the locking state was created on demand.
+    size_t embeddedLength = sizeof(_PARCObjectHeader) - sizeof(_PARCObjectLocking *) + sizeof(_PARCObjectLocking);
+
+    printf("PARCObject prefix bytes per object: %zd (with embedded locking %zd)\n",
+           _parcObject_PrefixLength(sizeof(void *)), (embeddedLength + (sizeof(void *) - 1)) & -sizeof(void *));
+    printf("Locking state bytes, allocated only for objects that are locked: %zd\n", sizeof(_PARCObjectLocking));
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_CreateRelease_Rate)
+{
+    struct timeval start;
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        PARCObject *object = parcObject_CreateInstanceImpl(sizeof(_DummyObject), &PARCObject_Descriptor);
+        parcObject_Release(&object);
+    }
+    double unlocked = _elapsedSeconds(&start);
+
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        PARCObject *object = parcObject_CreateInstanceImpl(sizeof(_DummyObject), &PARCObject_Descriptor);
+        parcObject_Lock(object);
+        parcObject_Unlock(object);
+        parcObject_Release(&object);
+    }
+    double locked = _elapsedSeconds(&start);
+
+    printf("Create/Release: %.0f objects/s never locked, %.0f objects/s locked once\n",
+           OBJECT_COUNT / unlocked, OBJECT_COUNT / locked);
+}
+
 LONGBOW_TEST_FIXTURE(Meta)
 {
     LONGBOW_RUN_TEST_CASE(Meta, _metaDestructor_True);
@@ -1364,6 +1672,143 @@ LONGBOW_TEST_CASE(Meta, _metaDestructor_None)
     parcMemory_Deallocate((void **) &interface);
 }
 
+LONGBOW_TEST_CASE(Performance, parcObject_EqualsHashCode_Rate)
+{
+    // The same three levels of overrides, dispatched through the resolved vtable and by searching the supertypes.
+    PARCObjectDescriptor unresolved = _DummyObjectGrandchild_Descriptor;
+    unresolved.vtable = NULL;
+
+    const PARCObjectDescriptor *descriptors[] = { &_DummyObjectGrandchild_Descriptor, &unresolved };
+    double rate[2];
+
+    for (int d = 0; d < 2; d++) {
+        _DummyObject *x = parcObject_CreateAndClearInstanceImpl(sizeof(_DummyObject), descriptors[d]);
+        _DummyObject *y = parcObject_CreateAndClearInstanceImpl(sizeof(_DummyObject), descriptors[d]);
+
+        struct timeval start;
+        gettimeofday(&start, NULL);
+        for (int i = 0; i < OBJECT_COUNT * 10; i++) {
+            parcObject_HashCode(x);
+            parcObject_HashCode(y);
+            parcObject_Equals(x, y);
+        }
+        rate[d] = OBJECT_COUNT * 10 / _elapsedSeconds(&start);
+
+        parcObject_Release((PARCObject **) &x);
+        parcObject_Release((PARCObject **) &y);
+    }
+
+    printf("Equals+HashCode through 3 levels of overrides: %.0f calls/s resolved, %.0f calls/s searching the supertypes\n",
+           rate[0], rate[1]);
+}
+
+static void *
+_acquireRelease(void *object)
+{
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        PARCObject *reference = parcObject_Acquire(object);
+        parcObject_Release(&reference);
+    }
+    return NULL;
+}
+
+static double
+_acquireReleaseRate(PARCObject *object, int threadCount)
+{
+    pthread_t threads[threadCount];
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int t = 0; t < threadCount; t++) {
+        pthread_create(&threads[t], NULL, _acquireRelease, object);
+    }
+    for (int t = 0; t < threadCount; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    return (double) OBJECT_COUNT * threadCount / _elapsedSeconds(&start);
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_AcquireRelease_Immortal_Threads)
+{
+    PARCObject *object = parcObject_CreateAndClearInstanceImpl(sizeof(_DummyObject), &PARCObject_Descriptor);
+
+    for (int threadCount = 1; threadCount <= 8; threadCount *= 2) {
+        printf("Acquire/Release of a shared object by %d threads: %.0f pairs/s reference counted, %.0f pairs/s immortal\n",
+               threadCount, _acquireReleaseRate(object, threadCount), _acquireReleaseRate(_immortalDummy, threadCount));
+    }
+
+    parcObject_Release(&object);
+}
+
+typedef struct {
+    uint64_t value;
+} _Counter;
+
+parcObject_ExtendPARCObject(_Counter, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static void *
+_incrementCounter(void *counter)
+{
+    uint64_t *value = counter;
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        parcAtomicUint64_Increment(value);
+    }
+    return NULL;
+}
+
+static double
+_incrementRate(uint64_t *values[], int threadCount)
+{
+    pthread_t threads[threadCount];
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int t = 0; t < threadCount; t++) {
+        pthread_create(&threads[t], NULL, _incrementCounter, values[t]);
+    }
+    for (int t = 0; t < threadCount; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    return (double) OBJECT_COUNT * threadCount / _elapsedSeconds(&start);
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_CreateAlignedInstance_FalseSharing)
+{
+    const int threadCount = 4;
+    uint64_t *values[threadCount];
+
+    // Every thread's counter in the same instance, and so in the same cache line.
+    uint64_t *shared = parcObject_CreateAndClearInstanceImpl(threadCount * sizeof(uint64_t), &PARCObject_Descriptor);
+    for (int t = 0; t < threadCount; t++) {
+        values[t] = &shared[t];
+    }
+    double sharedRate = _incrementRate(values, threadCount);
+    parcObject_Release((PARCObject **) &shared);
+
+    _Counter *counters[threadCount];
+    for (int t = 0; t < threadCount; t++) {
+        counters[t] = parcObject_CreateAndClearInstance(_Counter);
+        values[t] = &counters[t]->value;
+    }
+    double defaultRate = _incrementRate(values, threadCount);
+    for (int t = 0; t < threadCount; t++) {
+        parcObject_Release((PARCObject **) &counters[t]);
+    }
+
+    size_t cacheLine = parcMemory_RoundUpToCacheLine(1);
+    for (int t = 0; t < threadCount; t++) {
+        counters[t] = parcObject_CreateAndClearAlignedInstance(_Counter, cacheLine);
+        values[t] = &counters[t]->value;
+    }
+    double alignedRate = _incrementRate(values, threadCount);
+    for (int t = 0; t < threadCount; t++) {
+        parcObject_Release((PARCObject **) &counters[t]);
+    }
+
+    printf("parcAtomicUint64_Increment by %d threads: %.0f/s one instance, %.0f/s an instance each, %.0f/s an instance each aligned on %zd bytes\n",
+           threadCount, sharedRate, defaultRate, alignedRate, cacheLine);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -1372,4 +1817,3 @@ main(int argc, char *argv[argc])
     longBowTestRunner_Destroy(&testRunner);
     exit(exitStatus);
 }
-
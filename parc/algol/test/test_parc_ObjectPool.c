@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_ObjectPool.c"
+
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Buffer.h>
+
+typedef struct {
+    int value;
+    char payload[200];
+} _PooledObject;
+
+parcObject_ExtendPARCObjectPooled(_PooledObject, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static parcObject_ImplementRelease(_pooledObject, _PooledObject);
+
+typedef struct {
+    int value;
+} _UnpooledObject;
+
+parcObject_ExtendPARCObject(_UnpooledObject, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static parcObject_ImplementRelease(_unpooledObject, _UnpooledObject);
+
+static void *
+_createAndRelease(void *count)
+{
+    size_t n = (size_t) count;
+    _PooledObject *objects[n];
+
+    for (size_t i = 0; i < n; i++) {
+        objects[i] = parcObject_CreateInstance(_PooledObject);
+    }
+    for (size_t i = 0; i < n; i++) {
+        _pooledObject_Release(&objects[i]);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_RUNNER(parc_ObjectPool)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ObjectPool)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ObjectPool)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_IsEnabled);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_SetEnabled);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_Disabled);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_Recycle);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_Recycle_Unpooled);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_Recycle_Depot);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_Recycle_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_Recycle_PARCBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectPool_Flush);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcObjectPool_SetEnabled(false);
+
+    bool leaked = parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase)) != true;
+    if (leaked) {
+        parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_IsEnabled)
+{
+    assertFalse(parcObjectPool_IsEnabled(), "Expected pooling to be disabled by default.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_SetEnabled)
+{
+    bool previous = parcObjectPool_SetEnabled(true);
+    assertFalse(previous, "Expected the previous setting to be false.");
+    assertTrue(parcObjectPool_IsEnabled(), "Expected pooling to be enabled.");
+
+    previous = parcObjectPool_SetEnabled(false);
+    assertTrue(previous, "Expected the previous setting to be true.");
+    assertFalse(parcObjectPool_IsEnabled(), "Expected pooling to be disabled.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_Disabled)
+{
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    _PooledObject *object = parcObject_CreateInstance(_PooledObject);
+    _pooledObject_Release(&object);
+
+    assertTrue(parcMemory_Outstanding() == outstanding,
+               "Expected a disabled pool to return memory immediately.");
+
+    PARCObjectPoolStatistics statistics;
+    if (parcObjectPool_GetStatistics(&parcObject_DescriptorName(_PooledObject), &statistics)) {
+        assertTrue(statistics.hits == 0 && statistics.recycled == 0,
+                   "Expected no activity when pooling is disabled.");
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_Recycle)
+{
+    parcObjectPool_SetEnabled(true);
+
+    _PooledObject *object = parcObject_CreateInstance(_PooledObject);
+    void *expected = object;
+    _pooledObject_Release(&object);
+
+    object = parcObject_CreateInstance(_PooledObject);
+    assertTrue(object == expected, "Expected the released memory to be reused, %p != %p", (void *) object, expected);
+    assertTrue(parcObject_GetReferenceCount(object) == 1, "Expected a recycled object to have a reference count of 1.");
+    _pooledObject_Release(&object);
+
+    PARCObjectPoolStatistics statistics;
+    assertTrue(parcObjectPool_GetThreadStatistics(&parcObject_DescriptorName(_PooledObject), &statistics),
+               "Expected statistics for a pooled type.");
+    assertTrue(statistics.misses == 1, "Expected 1 miss, actual %" PRIu64, statistics.misses);
+    assertTrue(statistics.hits == 1, "Expected 1 hit, actual %" PRIu64, statistics.hits);
+    assertTrue(statistics.recycled == 2, "Expected 2 recycled, actual %" PRIu64, statistics.recycled);
+    assertTrue(statistics.returned == 0, "Expected 0 returned, actual %" PRIu64, statistics.returned);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_Recycle_Unpooled)
+{
+    parcObjectPool_SetEnabled(true);
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    _UnpooledObject *object = parcObject_CreateInstance(_UnpooledObject);
+    _unpooledObject_Release(&object);
+
+    assertTrue(parcMemory_Outstanding() == outstanding,
+               "Expected an unpooled type to return memory immediately.");
+
+    PARCObjectPoolStatistics statistics;
+    assertFalse(parcObjectPool_GetStatistics(&parcObject_DescriptorName(_UnpooledObject), &statistics),
+                "Expected no statistics for an unpooled type.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_Recycle_Depot)
+{
+    parcObjectPool_SetEnabled(true);
+
+    // More than fits in one magazine, so full magazines go to the depot and come back.
+    size_t count = PARCObjectPool_MagazineCapacity * 3;
+    _createAndRelease((void *) count);
+    _createAndRelease((void *) count);
+
+    PARCObjectPoolStatistics statistics;
+    parcObjectPool_GetThreadStatistics(&parcObject_DescriptorName(_PooledObject), &statistics);
+    assertTrue(statistics.hits == count, "Expected %zu hits, actual %" PRIu64, count, statistics.hits);
+    assertTrue(statistics.misses == count, "Expected %zu misses, actual %" PRIu64, count, statistics.misses);
+    assertTrue(statistics.recycled == 2 * count, "Expected %zu recycled, actual %" PRIu64, 2 * count, statistics.recycled);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_Recycle_Threads)
+{
+    parcObjectPool_SetEnabled(true);
+
+    PARCObjectPoolStatistics before = { 0 };
+    parcObjectPool_GetStatistics(&parcObject_DescriptorName(_PooledObject), &before);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _createAndRelease, (void *) (size_t) 10);
+    pthread_join(thread, NULL);
+
+    // The exiting thread gave its magazine to the depot.
+    _PooledObject *object = parcObject_CreateInstance(_PooledObject);
+    _pooledObject_Release(&object);
+
+    PARCObjectPoolStatistics statistics;
+    parcObjectPool_GetThreadStatistics(&parcObject_DescriptorName(_PooledObject), &statistics);
+    assertTrue(statistics.hits == 1, "Expected 1 hit, actual %" PRIu64, statistics.hits);
+
+    parcObjectPool_GetStatistics(&parcObject_DescriptorName(_PooledObject), &statistics);
+    assertTrue(statistics.hits - before.hits == 1, "Expected 1 hit, actual %" PRIu64, statistics.hits - before.hits);
+    assertTrue(statistics.misses - before.misses == 10, "Expected 10 misses, actual %" PRIu64, statistics.misses - before.misses);
+    assertTrue(statistics.recycled - before.recycled == 11, "Expected 11 recycled, actual %" PRIu64, statistics.recycled - before.recycled);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_Recycle_PARCBuffer)
+{
+    parcObjectPool_SetEnabled(true);
+
+    PARCBuffer *buffer = parcBuffer_Allocate(10);
+    const PARCObjectDescriptor *descriptor = parcObject_GetDescriptor(buffer);
+    parcBuffer_Release(&buffer);
+    buffer = parcBuffer_Allocate(20);
+    parcBuffer_Release(&buffer);
+
+    PARCObjectPoolStatistics statistics;
+    assertTrue(parcObjectPool_GetThreadStatistics(descriptor, &statistics),
+               "Expected PARCBuffer to be pooled.");
+    assertTrue(statistics.hits > 0, "Expected PARCBuffer memory to be reused.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectPool_Flush)
+{
+    parcObjectPool_SetEnabled(true);
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    _createAndRelease((void *) (size_t) (PARCObjectPool_MagazineCapacity * 2));
+    assertTrue(parcMemory_Outstanding() > outstanding, "Expected the pool to hold memory.");
+
+    parcObjectPool_Flush();
+    assertTrue(parcMemory_Outstanding() == outstanding,
+               "Expected flushing to return all memory, %u outstanding.", parcMemory_Outstanding() - outstanding);
+    assertTrue(parcObjectPool_IsEnabled(), "Expected flushing to leave pooling enabled.");
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcObjectPool_CreateRelease_Rate);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcObjectPool_SetEnabled(false);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_elapsedSeconds(const struct timeval *start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - start->tv_sec) + (now.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcObjectPool_CreateRelease_Rate)
+{
+    const int count = 10000000;
+
+    for (int enabled = 0; enabled < 2; enabled++) {
+        parcObjectPool_SetEnabled(enabled);
+
+        struct timeval start;
+        gettimeofday(&start, NULL);
+        for (int i = 0; i < count; i++) {
+            PARCBuffer *buffer = parcBuffer_Allocate(64);
+            parcBuffer_Release(&buffer);
+        }
+        double seconds = _elapsedSeconds(&start);
+
+        printf("PARCBuffer create/release, pooling %s: %.2f M/s\n", enabled ? "enabled " : "disabled", count / seconds / 1000000.0);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ObjectPool);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
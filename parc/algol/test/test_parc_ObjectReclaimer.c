@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_ObjectReclaimer.c"
+
+#include <inttypes.h>
+#include <unistd.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_HashMap.h>
+#include <parc/algol/parc_LinkedList.h>
+#include <parc/algol/parc_Buffer.h>
+
+typedef struct {
+    int value;
+} _Counted;
+
+static int _finalized = 0;
+
+static void
+_counted_Finalize(_Counted **instancePtr)
+{
+    _finalized++;
+}
+
+parcObject_ExtendPARCObject(_Counted, _counted_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static void *
+_reclaim(void *unused)
+{
+    return (void *) parcObjectReclaimer_Reclaim();
+}
+
+/**
+ * Call parcObjectReclaimer_Reclaim on a thread that is not registered.
+ */
+static size_t
+_reclaimOnAnotherThread(void)
+{
+    pthread_t thread;
+    void *result;
+    pthread_create(&thread, NULL, _reclaim, NULL);
+    pthread_join(thread, &result);
+    return (size_t) result;
+}
+
+LONGBOW_TEST_RUNNER(parc_ObjectReclaimer)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ObjectReclaimer)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ObjectReclaimer)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_ReleaseDeferred_NotLast);
+    LONGBOW_RUN_TEST_CASE(Global, parcObject_ReleaseDeferred_Last);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectReclaimer_Reclaim_Statistics);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectReclaimer_Reclaim_WaitsForQuiescent);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectReclaimer_Reclaim_Nested);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectReclaimer_Start_Stop);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    _finalized = 0;
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcObjectReclaimer_UnregisterThread();
+    parcObjectReclaimer_Reclaim();
+
+    bool leaked = parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase)) != true;
+    if (leaked) {
+        parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_ReleaseDeferred_NotLast)
+{
+    _Counted *object = parcObject_CreateInstance(_Counted);
+    _Counted *reference = parcObject_Acquire(object);
+
+    PARCReferenceCount remaining = parcObject_ReleaseDeferred((PARCObject **) &reference);
+
+    assertNull(reference, "Expected the pointer to be set to NULL.");
+    assertTrue(remaining == 1, "Expected 1 remaining reference, actual %" PRIu64, remaining);
+
+    PARCObjectReclaimerStatistics statistics;
+    parcObjectReclaimer_GetStatistics(&statistics);
+    assertTrue(statistics.pending == 0, "Expected nothing to be retired, actual %" PRIu64, statistics.pending);
+
+    parcObject_Release((PARCObject **) &object);
+    assertTrue(_finalized == 1, "Expected the object to be finalized.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObject_ReleaseDeferred_Last)
+{
+    _Counted *object = parcObject_CreateInstance(_Counted);
+
+    PARCReferenceCount remaining = parcObject_ReleaseDeferred((PARCObject **) &object);
+
+    assertNull(object, "Expected the pointer to be set to NULL.");
+    assertTrue(remaining == 0, "Expected 0 remaining references, actual %" PRIu64, remaining);
+    assertTrue(_finalized == 0, "Expected the finalizer to be deferred.");
+
+    size_t released = parcObjectReclaimer_Reclaim();
+    assertTrue(released == 1, "Expected 1 object to be released, actual %zu", released);
+    assertTrue(_finalized == 1, "Expected the object to be finalized.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectReclaimer_Reclaim_Statistics)
+{
+    PARCObjectReclaimerStatistics before;
+    parcObjectReclaimer_GetStatistics(&before);
+
+    for (int i = 0; i < 3; i++) {
+        _Counted *object = parcObject_CreateInstance(_Counted);
+        parcObject_ReleaseDeferred((PARCObject **) &object);
+    }
+
+    PARCObjectReclaimerStatistics statistics;
+    parcObjectReclaimer_GetStatistics(&statistics);
+    assertTrue(statistics.pending == 3, "Expected 3 pending, actual %" PRIu64, statistics.pending);
+    assertTrue(statistics.pendingBytes >= 3 * sizeof(_Counted), "Expected the pending bytes to include the objects.");
+    uint64_t pendingBytes = statistics.pendingBytes;
+
+    parcObjectReclaimer_Reclaim();
+
+    parcObjectReclaimer_GetStatistics(&statistics);
+    assertTrue(statistics.pending == 0, "Expected 0 pending, actual %" PRIu64, statistics.pending);
+    assertTrue(statistics.pendingBytes == 0, "Expected 0 pending bytes, actual %" PRIu64, statistics.pendingBytes);
+    assertTrue(statistics.lastReclaimed == 3, "Expected 3 reclaimed, actual %" PRIu64, statistics.lastReclaimed);
+    assertTrue(statistics.lastReclaimedBytes == pendingBytes,
+               "Expected %" PRIu64 " bytes reclaimed, actual %" PRIu64, pendingBytes, statistics.lastReclaimedBytes);
+    assertTrue(statistics.reclaimed - before.reclaimed == 3, "Expected the total to include the reclaimed objects.");
+    assertTrue(statistics.epoch > statistics.lastEpoch, "Expected a new epoch to begin.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectReclaimer_Reclaim_WaitsForQuiescent)
+{
+    parcObjectReclaimer_RegisterThread();
+
+    _Counted *object = parcObject_CreateInstance(_Counted);
+    parcObject_ReleaseDeferred((PARCObject **) &object);
+
+    size_t released = _reclaimOnAnotherThread();
+    assertTrue(released == 0, "Expected nothing to be released before the registered thread is quiescent.");
+    assertTrue(_finalized == 0, "Expected the object to not be finalized.");
+
+    parcObjectReclaimer_Quiescent();
+
+    released = _reclaimOnAnotherThread();
+    assertTrue(released == 1, "Expected the object to be released after the registered thread is quiescent.");
+    assertTrue(_finalized == 1, "Expected the object to be finalized.");
+
+    parcObjectReclaimer_UnregisterThread();
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectReclaimer_Reclaim_Nested)
+{
+    PARCHashMap *map = parcHashMap_Create();
+    for (int i = 0; i < 10; i++) {
+        PARCBuffer *key = parcBuffer_Allocate(sizeof(int));
+        parcBuffer_Flip(parcBuffer_PutUint32(key, i));
+        PARCLinkedList *list = parcLinkedList_Create();
+        parcLinkedList_Append(list, key);
+        parcHashMap_Put(map, key, list);
+        parcLinkedList_Release(&list);
+        parcBuffer_Release(&key);
+    }
+
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    parcObject_ReleaseDeferred((PARCObject **) &map);
+    // The retire entry is bookkeeping allocated with malloc, so the outstanding count is unchanged.
+    assertTrue(parcMemory_Outstanding() == outstanding, "Expected nothing to be deallocated by a deferred release.");
+
+    parcObjectReclaimer_Reclaim();
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectReclaimer_Start_Stop)
+{
+    assertTrue(parcObjectReclaimer_Start(1000), "Expected the reclaimer thread to start.");
+    assertFalse(parcObjectReclaimer_Start(1000), "Expected the reclaimer thread to be running already.");
+
+    _Counted *object = parcObject_CreateInstance(_Counted);
+    parcObject_ReleaseDeferred((PARCObject **) &object);
+
+    for (int i = 0; i < 1000 && _finalized == 0; i++) {
+        usleep(1000);
+    }
+
+    assertTrue(parcObjectReclaimer_Stop(), "Expected the reclaimer thread to stop.");
+    assertFalse(parcObjectReclaimer_Stop(), "Expected the reclaimer thread to be stopped already.");
+    assertTrue(_finalized == 1, "Expected the reclaimer thread to finalize the object.");
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_ReleaseDeferred_Latency);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCHashMap *
+_createMapOfLists(int count)
+{
+    PARCHashMap *map = parcHashMap_Create();
+    for (int i = 0; i < count; i++) {
+        PARCBuffer *key = parcBuffer_Allocate(sizeof(int));
+        parcBuffer_Flip(parcBuffer_PutUint32(key, i));
+        PARCLinkedList *list = parcLinkedList_Create();
+        for (int j = 0; j < 10; j++) {
+            parcLinkedList_Append(list, key);
+        }
+        parcHashMap_Put(map, key, list);
+        parcLinkedList_Release(&list);
+        parcBuffer_Release(&key);
+    }
+    return map;
+}
+
+static double
+_elapsedMicroseconds(const struct timeval *start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - start->tv_sec) * 1000000.0 + (now.tv_usec - start->tv_usec);
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_ReleaseDeferred_Latency)
+{
+    const int maps = 100;
+    double immediate = 0;
+    double deferred = 0;
+
+    for (int i = 0; i < maps; i++) {
+        PARCHashMap *map = _createMapOfLists(1000);
+        struct timeval start;
+        gettimeofday(&start, NULL);
+        parcHashMap_Release(&map);
+        immediate += _elapsedMicroseconds(&start);
+    }
+
+    for (int i = 0; i < maps; i++) {
+        PARCHashMap *map = _createMapOfLists(1000);
+        struct timeval start;
+        gettimeofday(&start, NULL);
+        parcObject_ReleaseDeferred((PARCObject **) &map);
+        deferred += _elapsedMicroseconds(&start);
+    }
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    parcObjectReclaimer_Reclaim();
+    double reclaim = _elapsedMicroseconds(&start);
+
+    printf("Releasing a PARCHashMap of 1000 PARCLinkedLists: %.1f us immediately, %.3f us deferred (%.1f us each to reclaim)\n",
+           immediate / maps, deferred / maps, reclaim / maps);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ObjectReclaimer);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
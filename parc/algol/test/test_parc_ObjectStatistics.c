@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_ObjectStatistics.c"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/logging/parc_LogReporterTextStdout.h>
+
+typedef struct {
+    uint64_t value;
+} _Counted;
+
+parcObject_ExtendPARCObject(_Counted, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+static void *
+_createAndRelease(void *unused)
+{
+    _Counted *object = parcObject_CreateInstance(_Counted);
+    parcObject_Release((PARCObject **) &object);
+    return NULL;
+}
+
+LONGBOW_TEST_RUNNER(parc_ObjectStatistics)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ObjectStatistics)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ObjectStatistics)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_SetEnabled);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_Get);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_Get_Unknown);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_Get_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_ManyDescriptors);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_RecycledDescriptor);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_ToJSON);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_Log);
+    LONGBOW_RUN_TEST_CASE(Global, parcObjectStatistics_StartLogging_StopLogging);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcObjectStatistics_SetEnabled(false);
+
+    bool leaked = parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase)) != true;
+    if (leaked) {
+        parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_SetEnabled)
+{
+    assertFalse(parcObjectStatistics_IsEnabled(), "Expected statistics to be disabled by default.");
+
+    bool previous = parcObjectStatistics_SetEnabled(true);
+    assertFalse(previous, "Expected the previous setting to be false.");
+    assertTrue(parcObjectStatistics_IsEnabled(), "Expected statistics to be enabled.");
+
+    previous = parcObjectStatistics_SetEnabled(false);
+    assertTrue(previous, "Expected the previous setting to be true.");
+    assertFalse(parcObjectStatistics_IsEnabled(), "Expected statistics to be disabled.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_Get)
+{
+    PARCObjectTypeStatistics before = { 0 };
+    parcObjectStatistics_Get("_Counted", &before);
+
+    parcObjectStatistics_SetEnabled(true);
+
+    _Counted *a = parcObject_CreateInstance(_Counted);
+    _Counted *b = parcObject_CreateInstance(_Counted);
+
+    PARCObjectTypeStatistics statistics;
+    bool found = parcObjectStatistics_Get("_Counted", &statistics);
+    assertTrue(found, "Expected statistics for _Counted");
+    assertTrue(statistics.created - before.created == 2, "Expected 2 created, actual %" PRIu64, statistics.created - before.created);
+    assertTrue(statistics.live - before.live == 2, "Expected 2 live, actual %" PRIu64, statistics.live - before.live);
+    assertTrue(statistics.liveBytes - before.liveBytes >= 2 * sizeof(_Counted),
+               "Expected at least %zu live bytes, actual %" PRIu64, 2 * sizeof(_Counted), statistics.liveBytes - before.liveBytes);
+    assertTrue(statistics.liveBytes == statistics.createdBytes - (before.createdBytes - before.liveBytes),
+               "Expected every created byte to be live.");
+
+    parcObject_Release((PARCObject **) &a);
+    parcObject_Release((PARCObject **) &b);
+
+    parcObjectStatistics_Get("_Counted", &statistics);
+    assertTrue(statistics.created - before.created == 2, "Expected 2 created, actual %" PRIu64, statistics.created - before.created);
+    assertTrue(statistics.live == before.live, "Expected no live instances, actual %" PRIu64, statistics.live - before.live);
+    assertTrue(statistics.liveBytes == before.liveBytes, "Expected no live bytes.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_Get_Unknown)
+{
+    PARCObjectTypeStatistics statistics;
+    bool found = parcObjectStatistics_Get("NoSuchType", &statistics);
+    assertFalse(found, "Expected no statistics for an unknown type.");
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_Get_Threads)
+{
+    PARCObjectTypeStatistics before = { 0 };
+    parcObjectStatistics_Get("_Counted", &before);
+
+    parcObjectStatistics_SetEnabled(true);
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, _createAndRelease, NULL);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // The counters of each exited thread are retained.
+    PARCObjectTypeStatistics statistics;
+    parcObjectStatistics_Get("_Counted", &statistics);
+    assertTrue(statistics.created - before.created == 4, "Expected 4 created, actual %" PRIu64, statistics.created - before.created);
+    assertTrue(statistics.live == before.live, "Expected no live instances, actual %" PRIu64, statistics.live - before.live);
+}
+
+// More descriptors of one type than the table caches must neither hang nor lose counts.
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_ManyDescriptors)
+{
+    const size_t count = PARCObjectStatistics_MaxTypes * 3;
+
+    PARCObjectTypeStatistics before = { 0 };
+    parcObjectStatistics_Get("_Dynamic", &before);
+
+    parcObjectStatistics_SetEnabled(true);
+
+    PARCObjectDescriptor **descriptors = parcMemory_Allocate(count * sizeof(PARCObjectDescriptor *));
+    for (size_t i = 0; i < count; i++) {
+        descriptors[i] =
+            parcObjectDescriptor_Create("_Dynamic", NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &PARCObject_Descriptor);
+        PARCObject *instance = parcObject_CreateInstanceImpl(sizeof(int), descriptors[i]);
+        parcObject_Release(&instance);
+    }
+
+    PARCObjectTypeStatistics statistics;
+    assertTrue(parcObjectStatistics_Get("_Dynamic", &statistics), "Expected statistics for _Dynamic");
+    assertTrue(statistics.created - before.created == count,
+               "Expected %zu created, actual %" PRIu64, count, statistics.created - before.created);
+    assertTrue(statistics.live == before.live, "Expected no live instances");
+
+    for (size_t i = 0; i < count; i++) {
+        parcObjectDescriptor_Destroy(&descriptors[i]);
+    }
+    parcMemory_Deallocate((void **) &descriptors);
+}
+
+// A descriptor allocated where a destroyed descriptor was must be counted under its own name.
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_RecycledDescriptor)
+{
+    PARCObjectTypeStatistics beforeFirst = { 0 };
+    PARCObjectTypeStatistics beforeSecond = { 0 };
+    parcObjectStatistics_Get("_First", &beforeFirst);
+    parcObjectStatistics_Get("_Second", &beforeSecond);
+
+    parcObjectStatistics_SetEnabled(true);
+
+    for (int i = 0; i < 2; i++) {
+        PARCObjectDescriptor *descriptor =
+            parcObjectDescriptor_Create((i == 0) ? "_First" : "_Second", NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &PARCObject_Descriptor);
+        PARCObject *instance = parcObject_CreateInstanceImpl(sizeof(int), descriptor);
+        parcObject_Release(&instance);
+        parcObjectDescriptor_Destroy(&descriptor);
+    }
+
+    PARCObjectTypeStatistics first;
+    PARCObjectTypeStatistics second;
+    assertTrue(parcObjectStatistics_Get("_First", &first), "Expected statistics for _First");
+    assertTrue(parcObjectStatistics_Get("_Second", &second), "Expected statistics for _Second");
+    assertTrue(first.created - beforeFirst.created == 1, "Expected 1 _First, actual %" PRIu64, first.created - beforeFirst.created);
+    assertTrue(second.created - beforeSecond.created == 1, "Expected 1 _Second, actual %" PRIu64, second.created - beforeSecond.created);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_ToJSON)
+{
+    parcObjectStatistics_SetEnabled(true);
+
+    _Counted *object = parcObject_CreateInstance(_Counted);
+
+    PARCJSON *json = parcObjectStatistics_ToJSON();
+    PARCJSONValue *value = parcJSON_GetValueByName(json, "_Counted");
+    assertNotNull(value, "Expected the JSON to contain _Counted");
+
+    PARCJSON *type = parcJSONValue_GetJSON(value);
+    PARCJSONValue *live = parcJSON_GetValueByName(type, "live");
+    assertNotNull(live, "Expected a live member.");
+    assertTrue(parcJSONValue_GetInteger(live) >= 1, "Expected at least 1 live instance.");
+    assertNotNull(parcJSON_GetValueByName(type, "created"), "Expected a created member.");
+    assertNotNull(parcJSON_GetValueByName(type, "liveBytes"), "Expected a liveBytes member.");
+    assertNotNull(parcJSON_GetValueByName(type, "createdBytes"), "Expected a createdBytes member.");
+
+    parcJSON_Release(&json);
+    parcObject_Release((PARCObject **) &object);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_Log)
+{
+    parcObjectStatistics_SetEnabled(true);
+
+    PARCLogReporter *reporter = parcLogReporterTextStdout_Create();
+    PARCLog *log = parcLog_Create("localhost", "test_parc_ObjectStatistics", NULL, reporter);
+    parcLogReporter_Release(&reporter);
+    parcLog_SetLevel(log, PARCLogLevel_All);
+
+    bool logged = parcObjectStatistics_Log(log);
+    assertTrue(logged, "Expected the statistics to be logged.");
+
+    parcLog_Release(&log);
+}
+
+LONGBOW_TEST_CASE(Global, parcObjectStatistics_StartLogging_StopLogging)
+{
+    parcObjectStatistics_SetEnabled(true);
+
+    PARCLogReporter *reporter = parcLogReporterTextStdout_Create();
+    PARCLog *log = parcLog_Create("localhost", "test_parc_ObjectStatistics", NULL, reporter);
+    parcLogReporter_Release(&reporter);
+    parcLog_SetLevel(log, PARCLogLevel_All);
+
+    assertFalse(parcObjectStatistics_StopLogging(), "Expected StopLogging to fail when not logging.");
+
+    assertTrue(parcObjectStatistics_StartLogging(log, 1), "Expected StartLogging to succeed.");
+    assertFalse(parcObjectStatistics_StartLogging(log, 1), "Expected a second StartLogging to fail.");
+    sleep(2);
+    assertTrue(parcObjectStatistics_StopLogging(), "Expected StopLogging to succeed.");
+
+    parcLog_Release(&log);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcObject_CreateRelease_Rate);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcObjectStatistics_SetEnabled(false);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_createReleaseRate(size_t iterations)
+{
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < iterations; i++) {
+        _Counted *object = parcObject_CreateInstance(_Counted);
+        parcObject_Release((PARCObject **) &object);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    return iterations / elapsed;
+}
+
+LONGBOW_TEST_CASE(Performance, parcObject_CreateRelease_Rate)
+{
+    size_t iterations = 1000000;
+
+    parcObjectStatistics_SetEnabled(false);
+    double disabled = _createReleaseRate(iterations);
+
+    parcObjectStatistics_SetEnabled(true);
+    double enabled = _createReleaseRate(iterations);
+
+    printf("parcObject_CreateInstance/Release: %.0f/s without statistics, %.0f/s with statistics (%.1f%%)\n",
+           disabled, enabled, 100.0 * (disabled - enabled) / disabled);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ObjectStatistics);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
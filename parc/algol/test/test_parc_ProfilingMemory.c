@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_ProfilingMemory.c"
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+// Not static, so that its name is visible to backtrace_symbols.
+void *
+testParcProfilingMemory_AllocateHere(size_t size)
+{
+    return parcProfilingMemory_Allocate(size);
+}
+
+static char *
+_readFile(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *result = malloc(length + 1);
+    size_t actual = fread(result, 1, length, file);
+    result[actual] = 0;
+    fclose(file);
+    return result;
+}
+
+static char *
+_writeProfile(PARCProfilingMemoryFormat format)
+{
+    char path[] = "/tmp/test_parc_ProfilingMemoryXXXXXX";
+    int fd = mkstemp(path);
+    bool written = parcProfilingMemory_WriteProfile(fd, format);
+    close(fd);
+    assertTrue(written, "Expected the profile to be written.");
+
+    char *result = _readFile(path);
+    unlink(path);
+    return result;
+}
+
+LONGBOW_TEST_RUNNER(parc_ProfilingMemory)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Profile);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ProfilingMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ProfilingMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_Allocate);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_Allocate_Zero);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_AllocateAndClear);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_MemAlign);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_MemAlign_BadAlignment);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_Reallocate);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_Reallocate_NULL);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_SetSampleInterval);
+    LONGBOW_RUN_TEST_CASE(Global, parcProfilingMemory_AsPARCMemory);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcProfilingMemory_SetSampleInterval(parcProfilingMemory_DefaultSampleInterval);
+
+    uint32_t outstanding = parcProfilingMemory_Outstanding();
+    if (outstanding != 0) {
+        printf("%s leaks %u allocations.\n", longBowTestCase_GetFullName(testCase), outstanding);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks memory \n", longBowTestCase_GetName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_Allocate)
+{
+    void *result = parcProfilingMemory_Allocate(100);
+
+    assertNotNull(result, "parcProfilingMemory_Allocate failed: NULL result.");
+    assertTrue(((uintptr_t) result & 15) == 0, "Expected %p to be aligned on 16 bytes.", result);
+    assertTrue(_prefix(result)->tag == _parcProfilingMemory_Tag, "Expected a valid prefix.");
+    assertTrue(parcProfilingMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %u", parcProfilingMemory_Outstanding());
+
+    memset(result, 0xff, 100);
+    parcProfilingMemory_Deallocate(&result);
+
+    assertNull(result, "Expected the pointer to be set to NULL.");
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_Allocate_Zero)
+{
+    void *result = parcProfilingMemory_Allocate(0);
+    assertNull(result, "Expected NULL for a zero length allocation.");
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_AllocateAndClear)
+{
+    unsigned char *result = parcProfilingMemory_AllocateAndClear(100);
+    for (int i = 0; i < 100; i++) {
+        assertTrue(result[i] == 0, "Expected byte %d to be cleared.", i);
+    }
+    parcProfilingMemory_Deallocate((void **) &result);
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_MemAlign)
+{
+    for (size_t alignment = sizeof(void *); alignment <= 4096; alignment <<= 1) {
+        void *result;
+        int failure = parcProfilingMemory_MemAlign(&result, alignment, 100);
+        assertTrue(failure == 0, "parcProfilingMemory_MemAlign failed: %d", failure);
+        assertTrue(((uintptr_t) result & (alignment - 1)) == 0, "Expected %p to be aligned on %zd bytes", result, alignment);
+
+        memset(result, 0xff, 100);
+        parcProfilingMemory_Deallocate(&result);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_MemAlign_BadAlignment)
+{
+    void *result;
+    int failure = parcProfilingMemory_MemAlign(&result, 3, 100);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a bad alignment, actual %d", failure);
+
+    failure = parcProfilingMemory_MemAlign(&result, sizeof(void *), 0);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a zero size, actual %d", failure);
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_Reallocate)
+{
+    size_t sizes[] = { 10, 12, 100, 5000, 40000, 50 };
+
+    // Alternate between sampling every allocation and sampling few, to cover both ways of reallocating.
+    for (int sampled = 0; sampled < 2; sampled++) {
+        parcProfilingMemory_SetSampleInterval(sampled ? 1 : ((size_t) 1 << 60));
+
+        unsigned char *memory = parcProfilingMemory_Allocate(sizes[0]);
+        for (size_t i = 0; i < sizes[0]; i++) {
+            memory[i] = (unsigned char) i;
+        }
+
+        size_t preserved = sizes[0];
+        for (size_t s = 1; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            memory = parcProfilingMemory_Reallocate(memory, sizes[s]);
+            assertNotNull(memory, "Expected non-NULL result reallocating to %zd bytes.", sizes[s]);
+            assertTrue((_prefix(memory)->site != NULL) == sampled, "Expected the reallocated memory to be sampled: %d", sampled);
+
+            preserved = (sizes[s] < preserved) ? sizes[s] : preserved;
+            for (size_t i = 0; i < preserved; i++) {
+                assertTrue(memory[i] == (unsigned char) i, "Expected byte %zd to be preserved reallocating to %zd bytes.", i, sizes[s]);
+            }
+            memset(&memory[preserved], 0xff, sizes[s] - preserved);
+        }
+
+        parcProfilingMemory_Deallocate((void **) &memory);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_Reallocate_NULL)
+{
+    void *result = parcProfilingMemory_Reallocate(NULL, 100);
+    assertNotNull(result, "Expected non-NULL result.");
+    parcProfilingMemory_Deallocate(&result);
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_StringDuplicate)
+{
+    char *expected = "Hello World";
+
+    char *actual = parcProfilingMemory_StringDuplicate(expected, 5);
+    assertTrue(strcmp(actual, "Hello") == 0, "Expected %s, actual %s", "Hello", actual);
+    parcProfilingMemory_Deallocate((void **) &actual);
+
+    actual = parcProfilingMemory_StringDuplicate(expected, 100);
+    assertTrue(strcmp(actual, expected) == 0, "Expected %s, actual %s", expected, actual);
+    parcProfilingMemory_Deallocate((void **) &actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_SetSampleInterval)
+{
+    size_t previous = parcProfilingMemory_SetSampleInterval(1024);
+    assertTrue(previous == parcProfilingMemory_DefaultSampleInterval,
+               "Expected the default sample interval, actual %zd", previous);
+    assertTrue(parcProfilingMemory_GetSampleInterval() == 1024,
+               "Expected 1024, actual %zd", parcProfilingMemory_GetSampleInterval());
+}
+
+LONGBOW_TEST_CASE(Global, parcProfilingMemory_AsPARCMemory)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCProfilingMemoryAsPARCMemory);
+
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+    assertTrue(parcMemory_Outstanding() > 0, "Expected outstanding allocations.");
+    parcBuffer_Release(&buffer);
+
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_FIXTURE(Profile)
+{
+    LONGBOW_RUN_TEST_CASE(Profile, parcProfilingMemory_Sample_Every);
+    LONGBOW_RUN_TEST_CASE(Profile, parcProfilingMemory_Sample_Rate);
+    LONGBOW_RUN_TEST_CASE(Profile, parcProfilingMemory_WriteProfile_Pprof);
+    LONGBOW_RUN_TEST_CASE(Profile, parcProfilingMemory_WriteProfile_FlameGraph);
+    LONGBOW_RUN_TEST_CASE(Profile, parcProfilingMemory_WriteProfileToFile);
+    LONGBOW_RUN_TEST_CASE(Profile, parcProfilingMemory_StartSignalDump);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Profile)
+{
+    parcProfilingMemory_SetSampleInterval(1);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Profile)
+{
+    parcProfilingMemory_SetSampleInterval(parcProfilingMemory_DefaultSampleInterval);
+
+    uint32_t outstanding = parcProfilingMemory_Outstanding();
+    if (outstanding != 0) {
+        printf("%s leaks %u allocations.\n", longBowTestCase_GetFullName(testCase), outstanding);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Profile, parcProfilingMemory_Sample_Every)
+{
+    void *memory[10];
+    for (int i = 0; i < 10; i++) {
+        memory[i] = testParcProfilingMemory_AllocateHere(100);
+    }
+
+    _PARCProfilingMemorySite *site = _prefix(memory[0])->site;
+    assertNotNull(site, "Expected every allocation to be sampled.");
+    for (int i = 1; i < 10; i++) {
+        assertTrue(_prefix(memory[i])->site == site, "Expected the allocations to share a call stack.");
+    }
+    uint64_t allocations = site->allocations;
+    uint64_t frees = site->frees;
+    assertTrue(allocations - frees == 10, "Expected 10 live allocations, actual %" PRIu64, allocations - frees);
+    assertTrue(site->allocatedBytes - site->freedBytes == 1000,
+               "Expected 1000 live bytes, actual %" PRIu64, site->allocatedBytes - site->freedBytes);
+
+    for (int i = 0; i < 4; i++) {
+        parcProfilingMemory_Deallocate(&memory[i]);
+    }
+    assertTrue(site->frees == frees + 4, "Expected 4 more frees, actual %" PRIu64, site->frees - frees);
+    assertTrue(site->allocations == allocations, "Expected the total allocations to be unchanged.");
+
+    for (int i = 4; i < 10; i++) {
+        parcProfilingMemory_Deallocate(&memory[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Profile, parcProfilingMemory_Sample_Rate)
+{
+    parcProfilingMemory_SetSampleInterval(4096);
+
+    size_t count = 10000;
+    void **memory = malloc(count * sizeof(void *));
+    size_t sampled = 0;
+    for (size_t i = 0; i < count; i++) {
+        memory[i] = parcProfilingMemory_Allocate(100);
+        if (_prefix(memory[i])->site != NULL) {
+            sampled++;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        parcProfilingMemory_Deallocate(&memory[i]);
+    }
+    free(memory);
+
+    // About 244 of the allocations are expected to be sampled.
+    assertTrue(sampled > 100 && sampled < 500, "Expected about 244 sampled allocations, actual %zd", sampled);
+    double estimate = sampled * 100 * _parcProfilingMemory_Scale(sampled, sampled * 100, 4096);
+    assertTrue(fabs(estimate - count * 100) / (count * 100) < 0.25,
+               "Expected an estimate near %zd bytes, actual %.0f", count * 100, estimate);
+}
+
+LONGBOW_TEST_CASE(Profile, parcProfilingMemory_WriteProfile_Pprof)
+{
+    void *memory = testParcProfilingMemory_AllocateHere(100);
+
+    char *profile = _writeProfile(PARCProfilingMemoryFormat_Pprof);
+    assertTrue(strncmp(profile, "heap profile: ", 14) == 0, "Expected a heap profile header: %.60s", profile);
+    assertNotNull(strstr(profile, "@ heap_v2/1\n"), "Expected the sample interval in the header.");
+    assertNotNull(strstr(profile, "] @ 0x"), "Expected a call stack.");
+    assertNotNull(strstr(profile, "\nMAPPED_LIBRARIES:\n"), "Expected the mapped libraries.");
+    free(profile);
+
+    parcProfilingMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Profile, parcProfilingMemory_WriteProfile_FlameGraph)
+{
+    void *memory = testParcProfilingMemory_AllocateHere(100);
+
+    char *profile = _writeProfile(PARCProfilingMemoryFormat_FlameGraphLive);
+    assertNotNull(strstr(profile, ";testParcProfilingMemory_AllocateHere "),
+                  "Expected the allocating function to be the last frame of a stack:\n%s", profile);
+    free(profile);
+
+    parcProfilingMemory_Deallocate(&memory);
+
+    profile = _writeProfile(PARCProfilingMemoryFormat_FlameGraphAllocated);
+    assertNotNull(strstr(profile, ";testParcProfilingMemory_AllocateHere "),
+                  "Expected freed allocations to remain in the allocated profile:\n%s", profile);
+    free(profile);
+}
+
+LONGBOW_TEST_CASE(Profile, parcProfilingMemory_WriteProfileToFile)
+{
+    char path[] = "/tmp/test_parc_ProfilingMemory.heap";
+
+    bool written = parcProfilingMemory_WriteProfileToFile(path, PARCProfilingMemoryFormat_Pprof);
+    assertTrue(written, "Expected the profile to be written to %s", path);
+
+    char *profile = _readFile(path);
+    assertTrue(strncmp(profile, "heap profile: ", 14) == 0, "Expected a heap profile header.");
+    free(profile);
+    unlink(path);
+
+    written = parcProfilingMemory_WriteProfileToFile("/nonexistent/directory/profile", PARCProfilingMemoryFormat_Pprof);
+    assertFalse(written, "Expected a failure writing to a nonexistent directory.");
+}
+
+LONGBOW_TEST_CASE(Profile, parcProfilingMemory_StartSignalDump)
+{
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "/tmp/test_parc_ProfilingMemory_%d", (int) getpid());
+
+    bool started = parcProfilingMemory_StartSignalDump(SIGUSR2, prefix);
+    assertTrue(started, "Expected the signal dump to start.");
+    assertFalse(parcProfilingMemory_StartSignalDump(SIGUSR1, prefix), "Expected only one signal at a time.");
+
+    raise(SIGUSR2);
+
+    char path[128];
+    snprintf(path, sizeof(path), "%s.%d.0000.heap", prefix, (int) getpid());
+
+    // Wait for the thread to write the profile.
+    struct stat status;
+    for (int i = 0; i < 100 && (stat(path, &status) != 0 || status.st_size == 0); i++) {
+        usleep(10000);
+    }
+    parcProfilingMemory_StopSignalDump();
+
+    char *profile = _readFile(path);
+    assertNotNull(profile, "Expected the profile %s to be written.", path);
+    assertTrue(strncmp(profile, "heap profile: ", 14) == 0, "Expected a heap profile header.");
+    free(profile);
+    unlink(path);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, AllocateDeallocate);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcProfilingMemory_SetSampleInterval(parcProfilingMemory_DefaultSampleInterval);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_churnTime(PARCMemoryAllocate *allocate, PARCMemoryDeallocate *deallocate)
+{
+    static const size_t sizes[] = { 16, 48, 100, 200, 512, 1500 };
+
+    // Keep a window of 64 live allocations, replacing the oldest with each new one.
+    void *live[64] = { NULL };
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < 5000000; i++) {
+        void **slot = &live[i % 64];
+        if (*slot != NULL) {
+            deallocate(slot);
+        }
+        *slot = allocate(sizes[i % (sizeof(sizes) / sizeof(sizes[0]))]);
+    }
+    for (int i = 0; i < 64; i++) {
+        deallocate(&live[i]);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, AllocateDeallocate)
+{
+    double stdlibTime = _churnTime(parcStdlibMemory_Allocate, parcStdlibMemory_Deallocate);
+
+    parcProfilingMemory_SetSampleInterval(parcProfilingMemory_DefaultSampleInterval);
+    double profiledTime = _churnTime(parcProfilingMemory_Allocate, parcProfilingMemory_Deallocate);
+
+    parcProfilingMemory_SetSampleInterval(1);
+    double everyTime = _churnTime(parcProfilingMemory_Allocate, parcProfilingMemory_Deallocate);
+
+    printf("5000000 allocations and deallocations: stdlib %.3fs, sampled every %dKiB %.3fs, every allocation %.3fs\n",
+           stdlibTime, parcProfilingMemory_DefaultSampleInterval / 1024, profiledTime, everyTime);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ProfilingMemory);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
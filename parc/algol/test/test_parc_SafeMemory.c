@@ -33,12 +33,14 @@
 #include <LongBow/unit-test.h>
 
 #include <fcntl.h>
+#include <sys/time.h>
 
 LONGBOW_TEST_RUNNER(safetyMemory)
 {
     LONGBOW_RUN_TEST_FIXTURE(Static);
     LONGBOW_RUN_TEST_FIXTURE(ReportAllocation);
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Sampling);
     LONGBOW_RUN_TEST_FIXTURE(Errors);
 
     LONGBOW_RUN_TEST_FIXTURE(Performance);
@@ -166,6 +168,7 @@ LONGBOW_TEST_FIXTURE(ReportAllocation)
     LONGBOW_RUN_TEST_CASE(ReportAllocation, parcSafeMemory_ReportAllocation_Empty);
     LONGBOW_RUN_TEST_CASE(ReportAllocation, parcSafeMemory_ReportAllocation_One);
     LONGBOW_RUN_TEST_CASE(ReportAllocation, parcSafeMemory_ReportAllocation_Deallocated);
+    LONGBOW_RUN_TEST_CASE(ReportAllocation, parcSafeMemory_ReportAllocation_Many);
 }
 
 LONGBOW_TEST_CASE(ReportAllocation, parcSafeMemory_ReportAllocation_Empty)
@@ -208,6 +211,47 @@ LONGBOW_TEST_CASE(ReportAllocation, parcSafeMemory_ReportAllocation_Deallocated)
     assertTrue(result == 0, "Expected 0, was %zd", result);
 }
 
+static size_t
+_countLines(const char *path)
+{
+    size_t result = 0;
+    FILE *file = fopen(path, "r");
+    char line[1024];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strstr(line, "SafeMemory@") != NULL) {
+            result++;
+        }
+    }
+    fclose(file);
+    return result;
+}
+
+LONGBOW_TEST_CASE(ReportAllocation, parcSafeMemory_ReportAllocation_Many)
+{
+    void *allocations[1000];
+    for (int i = 0; i < 1000; i++) {
+        allocations[i] = parcSafeMemory_Allocate(i + 1);
+    }
+    // Remove every other one, so that allocations are removed from the middle of the lists.
+    for (int i = 0; i < 1000; i += 2) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+
+    char path[] = "/tmp/test_parc_SafeMemoryXXXXXX";
+    int fd = mkstemp(path);
+    size_t result = parcSafeMemory_ReportAllocation(fd);
+    close(fd);
+    size_t reported = _countLines(path);
+    unlink(path);
+
+    for (int i = 1; i < 1000; i += 2) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+
+    assertTrue(result == 500, "Expected 500, was %zd", result);
+    assertTrue(reported == 500, "Expected 500 allocations to be reported, was %zd", reported);
+}
+
 LONGBOW_TEST_FIXTURE_SETUP(ReportAllocation)
 {
     return LONGBOW_STATUS_SUCCEEDED;
@@ -222,6 +266,7 @@ LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_Allocate);
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_MemAlign);
+    LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_MemAlign_CacheLine);
 
     LONGBOW_RUN_TEST_CASE(Global, PARCSafeMemory_Realloc_Larger);
     LONGBOW_RUN_TEST_CASE(Global, PARCSafeMemory_Realloc_Smaller);
@@ -234,6 +279,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_Reallocate);
 
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_Deallocate_NothingAllocated);
+    LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_DeallocateSized);
+    LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_UsableSize);
 
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_IsValid_True);
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_IsValid_False);
@@ -251,6 +298,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_StringDuplicate_Long);
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_StringDuplicate_Short);
     LONGBOW_RUN_TEST_CASE(Global, validateAlignment);
+    LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_Allocate_Threads);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -400,6 +448,24 @@ LONGBOW_TEST_CASE(Global, parcSafeMemory_MemAlign)
     parcSafeMemory_Deallocate(&memory);
 }
 
+LONGBOW_TEST_CASE(Global, parcSafeMemory_MemAlign_CacheLine)
+{
+    void *memory;
+    size_t size = 100;
+
+    int failure = parcSafeMemory_MemAlign(&memory, 64, size);
+    assertTrue(failure == 0,
+               "parcSafeMemory_MemAlign failed: %d", failure);
+
+    assertTrue(((uintptr_t) memory & 63) == 0,
+               "Expected %p to be aligned on 64 bytes.", memory);
+
+    assertTrue((_parcSafeMemory_GetPrefixState(memory)) == PARCSafeMemoryState_OK,
+               "Prefix did not validate.");
+    parcSafeMemory_Deallocate(&memory);
+    assertNull(memory, "Expected the pointer to be set to NULL.");
+}
+
 LONGBOW_TEST_CASE(Global, parcSafeMemory_ReportAllocation)
 {
     void *memory;
@@ -654,6 +720,30 @@ LONGBOW_TEST_CASE(Global, parcSafeMemory_Deallocate_NothingAllocated)
     parcSafeMemory_Deallocate(&result);
 }
 
+LONGBOW_TEST_CASE(Global, parcSafeMemory_DeallocateSized)
+{
+    void *memory = parcSafeMemory_Allocate(100);
+    memory = parcSafeMemory_Reallocate(memory, 200);
+
+    parcSafeMemory_DeallocateSized(&memory, 200);
+    assertNull(memory, "Expected the pointer to be set to NULL.");
+
+    parcSafeMemory_DeallocateSized(&memory, 200);
+}
+
+LONGBOW_TEST_CASE(Global, parcSafeMemory_UsableSize)
+{
+    void *memory = parcSafeMemory_Allocate(100);
+    size_t actual = parcSafeMemory_UsableSize(memory);
+    assertTrue(actual == 100, "Expected 100, actual %zd", actual);
+
+    memory = parcSafeMemory_Reallocate(memory, 200);
+    actual = parcSafeMemory_UsableSize(memory);
+    assertTrue(actual == 200, "Expected 200, actual %zd", actual);
+
+    parcSafeMemory_Deallocate(&memory);
+}
+
 LONGBOW_TEST_CASE(Global, parcSafeMemory_IsValid_True)
 {
     void *result = parcSafeMemory_AllocateAndClear(5);
@@ -683,11 +773,218 @@ LONGBOW_TEST_CASE(Global, parcSafeMemory_Display_NULL)
     parcSafeMemory_Display(NULL, 0);
 }
 
+static void *
+_allocateAndDeallocate(void *unused)
+{
+    void *allocations[1000];
+    for (int i = 0; i < 1000; i++) {
+        allocations[i] = parcSafeMemory_Allocate(i + 1);
+    }
+    for (int i = 0; i < 1000; i++) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcSafeMemory_Allocate_Threads)
+{
+    pthread_t threads[8];
+    for (int i = 0; i < 8; i++) {
+        pthread_create(&threads[i], NULL, _allocateAndDeallocate, NULL);
+    }
+    for (int i = 0; i < 8; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    assertTrue(parcSafeMemory_Outstanding() == 0,
+               "Expected 0 outstanding allocations, actual %d", parcSafeMemory_Outstanding());
+    assertTrue(parcSafeMemory_ReportAllocation(-1) == 0, "Expected no allocations to be reported.");
+}
+
+LONGBOW_TEST_FIXTURE(Sampling)
+{
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_SetSampleInterval);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Allocate_Untracked);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_MemAlign_Untracked);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Reallocate_Untracked);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Display_Untracked);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_Sampling_Estimate);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_ReportProfile);
+    LONGBOW_RUN_TEST_CASE(Sampling, parcSafeMemory_ReportProfile_Empty);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Sampling)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Sampling)
+{
+    parcSafeMemory_SetSampleInterval(0);
+
+    uint32_t outstandingAllocations = parcSafeMemory_Outstanding();
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// Large enough that no allocation in these tests is sampled.
+#define _NeverSampled ((size_t) 1 << 60)
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_SetSampleInterval)
+{
+    size_t previous = parcSafeMemory_SetSampleInterval(1024);
+    assertTrue(previous == 0, "Expected the default sample interval to be 0, actual %zd", previous);
+    assertTrue(parcSafeMemory_GetSampleInterval() == 1024,
+               "Expected 1024, actual %zd", parcSafeMemory_GetSampleInterval());
+
+    previous = parcSafeMemory_SetSampleInterval(0);
+    assertTrue(previous == 1024, "Expected the previous sample interval to be 1024, actual %zd", previous);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Allocate_Untracked)
+{
+    parcSafeMemory_SetSampleInterval(_NeverSampled);
+
+    unsigned char *memory = parcSafeMemory_Allocate(100);
+    assertTrue(_parcSafeMemory_IsUntracked((void *) memory), "Expected the allocation not to be tracked.");
+    assertTrue(((uintptr_t) memory & 15) == 0, "Expected %p to be aligned on 16 bytes.", (void *) memory);
+    assertTrue(parcSafeMemory_IsValid(memory), "Expected untracked memory to be valid.");
+    assertTrue(parcSafeMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %d", parcSafeMemory_Outstanding());
+    assertTrue(parcSafeMemory_ReportProfile(-1) == 0, "Expected no tracked allocations in the profile.");
+
+    memset(memory, 0xff, 100);
+    parcSafeMemory_Deallocate((void **) &memory);
+    assertNull(memory, "Expected the pointer to be set to NULL.");
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_MemAlign_Untracked)
+{
+    parcSafeMemory_SetSampleInterval(_NeverSampled);
+
+    void *memory;
+    int failure = parcSafeMemory_MemAlign(&memory, 64, 100);
+    assertTrue(failure == 0, "parcSafeMemory_MemAlign failed: %d", failure);
+    assertTrue(_parcSafeMemory_IsUntracked((void *) memory), "Expected the allocation not to be tracked.");
+    assertTrue(((uintptr_t) memory & 63) == 0, "Expected %p to be aligned on 64 bytes.", memory);
+
+    memset(memory, 0xff, 100);
+    parcSafeMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Reallocate_Untracked)
+{
+    parcSafeMemory_SetSampleInterval(_NeverSampled);
+
+    char *memory = parcSafeMemory_StringDuplicate("Hello World", 11);
+    memory = parcSafeMemory_Reallocate(memory, 100);
+    assertTrue(strcmp(memory, "Hello World") == 0, "Expected the content to be preserved, actual '%s'", memory);
+
+    memory = parcSafeMemory_Reallocate(memory, 5);
+    assertTrue(memcmp(memory, "Hello", 5) == 0, "Expected the content to be preserved.");
+    parcSafeMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Display_Untracked)
+{
+    parcSafeMemory_SetSampleInterval(_NeverSampled);
+
+    void *memory = parcSafeMemory_Allocate(10);
+    parcSafeMemory_Display(memory, 0);
+    parcSafeMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_Sampling_Estimate)
+{
+    size_t count = 10000;
+    size_t size = 100;
+    void **allocations = malloc(count * sizeof(void *));
+
+    parcSafeMemory_SetSampleInterval(4096);
+    for (size_t i = 0; i < count; i++) {
+        allocations[i] = parcSafeMemory_Allocate(size);
+    }
+
+    _Profile profile;
+    _parcSafeMemory_CollectProfile(&profile);
+    size_t tracked = 0;
+    double estimatedBytes = 0;
+    for (size_t i = 0; i < profile.count; i++) {
+        tracked += profile.entries[i].allocations;
+        estimatedBytes += profile.entries[i].estimatedBytes;
+    }
+    free(profile.entries);
+
+    for (size_t i = 0; i < count; i++) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+    free(allocations);
+
+    // About 244 of the allocations are expected to be tracked.
+    assertTrue(tracked > 100 && tracked < 500, "Expected about 244 tracked allocations, actual %zd", tracked);
+    double error = fabs(estimatedBytes - (double) (count * size)) / (count * size);
+    assertTrue(error < 0.25, "Expected an estimate near %zd bytes, actual %.0f", count * size, estimatedBytes);
+}
+
+static void *
+_profileAllocateFive(void)
+{
+    return parcSafeMemory_Allocate(5);
+}
+
+static void *
+_profileAllocateTen(void)
+{
+    return parcSafeMemory_Allocate(10);
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_ReportProfile)
+{
+    void *allocations[5];
+    for (int i = 0; i < 4; i++) {
+        allocations[i] = _profileAllocateFive();
+    }
+    allocations[4] = _profileAllocateTen();
+
+    _Profile profile;
+    _parcSafeMemory_CollectProfile(&profile);
+    assertTrue(profile.count == 2, "Expected 2 call stacks, actual %zd", profile.count);
+    assertTrue(profile.entries[0].allocations == 4 && profile.entries[0].bytes == 20,
+               "Expected the first call stack to have 4 allocations of 20 bytes, actual %zd of %zd",
+               profile.entries[0].allocations, profile.entries[0].bytes);
+    assertTrue(profile.entries[1].allocations == 1 && profile.entries[1].bytes == 10,
+               "Expected the second call stack to have 1 allocation of 10 bytes, actual %zd of %zd",
+               profile.entries[1].allocations, profile.entries[1].bytes);
+    assertTrue(profile.entries[0].estimatedBytes == 20.0, "Expected exact estimates without sampling.");
+    free(profile.entries);
+
+    int fd = open("/dev/null", O_WRONLY);
+    uint32_t callstacks = parcSafeMemory_ReportProfile(fd);
+    close(fd);
+    assertTrue(callstacks == 2, "Expected 2 call stacks, actual %u", callstacks);
+
+    for (int i = 0; i < 5; i++) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Sampling, parcSafeMemory_ReportProfile_Empty)
+{
+    uint32_t callstacks = parcSafeMemory_ReportProfile(-1);
+    assertTrue(callstacks == 0, "Expected 0 call stacks, actual %u", callstacks);
+}
+
 LONGBOW_TEST_FIXTURE(Errors)
 {
     LONGBOW_RUN_TEST_CASE(Errors, parcSafeMemory_Reallocate_NULL);
     LONGBOW_RUN_TEST_CASE(Errors, PARCSafeMemory_Deallocate_Overrun);
     LONGBOW_RUN_TEST_CASE(Errors, PARCSafeMemory_Deallocate_Underrun);
+    LONGBOW_RUN_TEST_CASE(Errors, PARCSafeMemory_Deallocate_Underrun_Untracked);
+    LONGBOW_RUN_TEST_CASE(Errors, parcSafeMemory_DeallocateSized_WrongSize);
+    LONGBOW_RUN_TEST_CASE(Errors, parcSafeMemory_DeallocateSized_WrongSize_Untracked);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Errors)
@@ -700,6 +997,7 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Errors)
     // The tests purposefully wreck the various per-allocation accounting structures for the allocated memory in order to test for
     // properly catching the overrun, underrun or other damage.
     // As a result any cleanup of allocated memory is not possible, so these tests leak allocated memory.
+    parcSafeMemory_SetSampleInterval(0);
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
@@ -740,6 +1038,35 @@ LONGBOW_TEST_CASE_EXPECTS(Errors, PARCSafeMemory_Deallocate_Underrun, .event = &
                "Expected memory to be underrun");
 }
 
+LONGBOW_TEST_CASE_EXPECTS(Errors, PARCSafeMemory_Deallocate_Underrun_Untracked, .event = &LongBowTrapUnexpectedStateEvent)
+{
+    parcSafeMemory_SetSampleInterval(_NeverSampled);
+
+    unsigned char *memory = parcSafeMemory_Allocate(16);
+    assertTrue(_parcSafeMemory_IsUntracked((void *) memory), "Expected the allocation not to be tracked.");
+
+    memory[-1] = 0;
+    assertFalse(parcSafeMemory_IsValid(memory), "Expected the underrun to be detected.");
+
+    parcSafeMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcSafeMemory_DeallocateSized_WrongSize, .event = &LongBowTrapIllegalValue)
+{
+    void *memory = parcSafeMemory_Allocate(100);
+
+    parcSafeMemory_DeallocateSized(&memory, 99);
+}
+
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcSafeMemory_DeallocateSized_WrongSize_Untracked, .event = &LongBowTrapIllegalValue)
+{
+    parcSafeMemory_SetSampleInterval(_NeverSampled);
+
+    void *memory = parcSafeMemory_Allocate(100);
+
+    parcSafeMemory_DeallocateSized(&memory, 101);
+}
+
 LONGBOW_TEST_CASE_EXPECTS(Errors, PARCSafeMemory_Deallocate_Overrun, .event = &LongBowTrapUnexpectedStateEvent)
 {
     size_t expectedSize = 100;
@@ -763,6 +1090,8 @@ LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
 {
     LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_1000000_WorstCase);
     LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_1000000_BestCase);
+    LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_Deallocate_1000000_Live);
+    LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_Sampling);
 
     LONGBOW_RUN_TEST_CASE(Performance, _computeUsableMemoryLength);
 }
@@ -806,6 +1135,74 @@ LONGBOW_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_1000000_BestCas
     } while (i > 0);
 }
 
+LONGBOW_TEST_CASE(Performance, parcSafeMemory_Deallocate_1000000_Live)
+{
+    size_t size = 100;
+    size_t count = sizeof(memory) / sizeof(memory[0]);
+
+    for (int i = 0; i < count; i++) {
+        memory[i] = parcSafeMemory_Allocate(size);
+    }
+
+    // Churn 100000 allocations while a million are live.
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < 100000; i++) {
+        int index = (int) ((i * 7919L) % count);
+        parcSafeMemory_Deallocate(&memory[index]);
+        memory[index] = parcSafeMemory_Allocate(size);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    printf("100000 deallocations and allocations with %zd live allocations: %.3fs\n", count, elapsed);
+
+    for (int i = 0; i < count; i++) {
+        parcSafeMemory_Deallocate(&memory[i]);
+    }
+}
+
+static double
+_allocateDeallocateTime(PARCMemoryAllocate *allocate, PARCMemoryDeallocate *deallocate)
+{
+    static const size_t sizes[] = { 16, 48, 100, 200, 512, 1500 };
+    size_t count = sizeof(memory) / sizeof(memory[0]);
+
+    // Keep a window of 64 live allocations, replacing the oldest with each new one.
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (size_t i = 0; i < count; i++) {
+        void **slot = &memory[i % 64];
+        if (*slot != NULL) {
+            deallocate(slot);
+        }
+        *slot = allocate(sizes[i % (sizeof(sizes) / sizeof(sizes[0]))]);
+    }
+    for (size_t i = 0; i < 64; i++) {
+        deallocate(&memory[i]);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    return (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+LONGBOW_TEST_CASE(Performance, parcSafeMemory_Sampling)
+{
+    double stdlibTime = _allocateDeallocateTime(parcStdlibMemory_Allocate, parcStdlibMemory_Deallocate);
+
+    parcSafeMemory_SetSampleInterval(0);
+    double trackedTime = _allocateDeallocateTime(parcSafeMemory_Allocate, parcSafeMemory_Deallocate);
+
+    parcSafeMemory_SetSampleInterval(512 * 1024);
+    double sampledTime = _allocateDeallocateTime(parcSafeMemory_Allocate, parcSafeMemory_Deallocate);
+    parcSafeMemory_SetSampleInterval(0);
+
+    printf("1000000 allocations and deallocations: stdlib %.3fs, every allocation tracked %.3fs, sampled every 512KiB %.3fs\n",
+           stdlibTime, trackedTime, sampledTime);
+}
+
 LONGBOW_TEST_CASE(Performance, _computeUsableMemoryLength)
 {
     for (int i = 0; i < 100000000; i++) {
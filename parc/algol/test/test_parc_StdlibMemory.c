@@ -69,6 +69,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_Reallocate);
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_Reallocate_NULL);
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_GoodSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_ReallocateInPlace);
+    LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_UsableSize);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -192,6 +195,47 @@ LONGBOW_TEST_CASE(Global, parcStdlibMemory_Reallocate)
                "Expected 0 outstanding allocations, actual %d", parcStdlibMemory_Outstanding());
 }
 
+LONGBOW_TEST_CASE(Global, parcStdlibMemory_GoodSize)
+{
+    for (size_t size = 1; size <= 4096; size++) {
+        size_t goodSize = parcStdlibMemory_GoodSize(size);
+        assertTrue(goodSize >= size, "Expected at least %zd, actual %zd", size, goodSize);
+
+#if defined(__GLIBC__)
+        void *memory = parcStdlibMemory_Allocate(size);
+        size_t usable = malloc_usable_size(memory);
+        parcStdlibMemory_Deallocate(&memory);
+        assertTrue(goodSize == usable, "Expected the good size of %zd to be the usable size %zd, actual %zd", size, usable, goodSize);
+#endif
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcStdlibMemory_ReallocateInPlace)
+{
+    void *memory = parcStdlibMemory_Allocate(100);
+
+    assertTrue(parcStdlibMemory_ReallocateInPlace(memory, 100), "Expected the allocation to hold its own size.");
+    assertTrue(parcStdlibMemory_ReallocateInPlace(memory, 10), "Expected the allocation to shrink in place.");
+    assertFalse(parcStdlibMemory_ReallocateInPlace(memory, 100000), "Expected the allocation not to grow by 100000 bytes.");
+
+    parcStdlibMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcStdlibMemory_UsableSize)
+{
+    void *memory = parcStdlibMemory_Allocate(100);
+
+    size_t actual = parcStdlibMemory_UsableSize(memory);
+#if defined(__APPLE__) || defined(__GLIBC__)
+    assertTrue(actual >= 100, "Expected at least 100, actual %zd", actual);
+    assertTrue(parcStdlibMemory_ReallocateInPlace(memory, actual), "Expected the allocation to hold its usable size.");
+#else
+    assertTrue(actual == 0, "Expected 0, actual %zd", actual);
+#endif
+
+    parcStdlibMemory_Deallocate(&memory);
+}
+
 LONGBOW_TEST_CASE(Global, parcStdlibMemory_Reallocate_NULL)
 {
     void *result = NULL;
@@ -0,0 +1,467 @@
+/*
+ * Copyright (c) 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Palo Alto Research Center (Xerox PARC)
+ * @copyright 2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include "../parc_ThreadCachingMemory.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <LongBow/unit-test.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+static void *
+_allocateAndDeallocate(void *unused)
+{
+    void *memory[100];
+    for (int i = 0; i < 100; i++) {
+        memory[i] = parcThreadCachingMemory_Allocate(i * 50 + 1);
+    }
+    for (int i = 0; i < 100; i++) {
+        parcThreadCachingMemory_Deallocate(&memory[i]);
+    }
+    return NULL;
+}
+
+static void *
+_deallocate(void *memory)
+{
+    parcThreadCachingMemory_Deallocate(&memory);
+    return NULL;
+}
+
+LONGBOW_TEST_RUNNER(parc_ThreadCachingMemory)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Static);
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ThreadCachingMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ThreadCachingMemory)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Static)
+{
+    LONGBOW_RUN_TEST_CASE(Static, _sizeClass);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Static)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Static)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Static, _sizeClass)
+{
+    for (size_t size = 1; size <= parcThreadCachingMemory_MaximumCachedSize; size++) {
+        unsigned int sizeClass = _sizeClass(size);
+        assertTrue(sizeClass < _parcThreadCachingMemory_SizeClasses, "Size %zd has an invalid class %u", size, sizeClass);
+        assertTrue(_sizeClass_Length(sizeClass) >= size,
+                   "Size %zd is larger than its class length %zd", size, _sizeClass_Length(sizeClass));
+        if (sizeClass > 0) {
+            assertTrue(_sizeClass_Length(sizeClass - 1) < size,
+                       "Size %zd fits in the smaller class length %zd", size, _sizeClass_Length(sizeClass - 1));
+        }
+    }
+    assertTrue(_sizeClass(parcThreadCachingMemory_MaximumCachedSize) == _parcThreadCachingMemory_SizeClasses - 1,
+               "Expected the maximum cached size to be in the last class.");
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Allocate);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Allocate_Zero);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Allocate_Uncached);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Allocate_Reuse);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_AllocateAndClear);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_MemAlign);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_MemAlign_BadAlignment);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_MemAlign_BadSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Reallocate);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Reallocate_NULL);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_ReallocateInPlace);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_GoodSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_UsableSize);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Deallocate_OtherThread);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_Outstanding_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, parcThreadCachingMemory_AsPARCMemory);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcThreadCachingMemory_Flush();
+
+    uint32_t outstanding = parcThreadCachingMemory_Outstanding();
+    if (outstanding != 0) {
+        printf("%s leaks %u allocations.\n", longBowTestCase_GetFullName(testCase), outstanding);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaks allocations.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Allocate)
+{
+    void *result = parcThreadCachingMemory_Allocate(100);
+
+    assertNotNull(result, "parcThreadCachingMemory_Allocate failed: NULL result.");
+    assertTrue(((uintptr_t) result & 15) == 0, "Expected %p to be aligned on 16 bytes.", result);
+    assertTrue(parcThreadCachingMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %u", parcThreadCachingMemory_Outstanding());
+
+    memset(result, 0xff, 100);
+    parcThreadCachingMemory_Deallocate(&result);
+
+    assertNull(result, "Expected the pointer to be set to NULL.");
+    assertTrue(parcThreadCachingMemory_Outstanding() == 0,
+               "Expected 0 outstanding allocations, actual %u", parcThreadCachingMemory_Outstanding());
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Allocate_Zero)
+{
+    void *result = parcThreadCachingMemory_Allocate(0);
+    assertNull(result, "Expected NULL for a zero length allocation.");
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Allocate_Uncached)
+{
+    size_t size = parcThreadCachingMemory_MaximumCachedSize + 1;
+    char *result = parcThreadCachingMemory_Allocate(size);
+
+    assertNotNull(result, "parcThreadCachingMemory_Allocate failed: NULL result.");
+    assertTrue(_prefix(result)->sizeClass == _parcThreadCachingMemory_Uncached, "Expected an uncached allocation.");
+    assertTrue(parcThreadCachingMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %u", parcThreadCachingMemory_Outstanding());
+
+    memset(result, 0xff, size);
+    parcThreadCachingMemory_Deallocate((void **) &result);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Allocate_Reuse)
+{
+    void *first = parcThreadCachingMemory_Allocate(100);
+    void *expected = first;
+    parcThreadCachingMemory_Deallocate(&first);
+
+    void *second = parcThreadCachingMemory_Allocate(110);
+    assertTrue(second == expected, "Expected the most recently freed block of the same class to be reused.");
+    parcThreadCachingMemory_Deallocate(&second);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_AllocateAndClear)
+{
+    // Dirty a block first, so that the cleared allocation reuses it.
+    unsigned char *dirty = parcThreadCachingMemory_Allocate(100);
+    memset(dirty, 0xff, 100);
+    parcThreadCachingMemory_Deallocate((void **) &dirty);
+
+    unsigned char *result = parcThreadCachingMemory_AllocateAndClear(100);
+    for (int i = 0; i < 100; i++) {
+        assertTrue(result[i] == 0, "Expected byte %d to be cleared.", i);
+    }
+    parcThreadCachingMemory_Deallocate((void **) &result);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_MemAlign)
+{
+    for (size_t alignment = sizeof(void *); alignment <= 4096; alignment <<= 1) {
+        void *result;
+        int failure = parcThreadCachingMemory_MemAlign(&result, alignment, 100);
+        assertTrue(failure == 0, "parcThreadCachingMemory_MemAlign failed: %d", failure);
+        assertTrue(((uintptr_t) result & (alignment - 1)) == 0, "Expected %p to be aligned on %zd bytes", result, alignment);
+
+        memset(result, 0xff, 100);
+        parcThreadCachingMemory_Deallocate(&result);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_MemAlign_BadAlignment)
+{
+    void *result;
+    int failure = parcThreadCachingMemory_MemAlign(&result, 3, 1200);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a bad alignment, actual %d", failure);
+    assertTrue(parcThreadCachingMemory_Outstanding() == 0,
+               "Expected 0 outstanding allocations, actual %u", parcThreadCachingMemory_Outstanding());
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_MemAlign_BadSize)
+{
+    void *result;
+    int failure = parcThreadCachingMemory_MemAlign(&result, sizeof(void *), 0);
+    assertTrue(failure == EINVAL, "Expected EINVAL for a zero size, actual %d", failure);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Reallocate)
+{
+    size_t sizes[] = { 10, 12, 100, 5000, 40000, 80000, 50 };
+
+    unsigned char *memory = parcThreadCachingMemory_Allocate(sizes[0]);
+    for (size_t i = 0; i < sizes[0]; i++) {
+        memory[i] = (unsigned char) i;
+    }
+
+    size_t preserved = sizes[0];
+    for (size_t s = 1; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        memory = parcThreadCachingMemory_Reallocate(memory, sizes[s]);
+        assertNotNull(memory, "Expected non-NULL result reallocating to %zd bytes.", sizes[s]);
+
+        preserved = (sizes[s] < preserved) ? sizes[s] : preserved;
+        for (size_t i = 0; i < preserved; i++) {
+            assertTrue(memory[i] == (unsigned char) i, "Expected byte %zd to be preserved reallocating to %zd bytes.", i, sizes[s]);
+        }
+        memset(&memory[preserved], 0xff, sizes[s] - preserved);
+
+        assertTrue(parcThreadCachingMemory_Outstanding() == 1,
+                   "Expected 1 outstanding allocation, actual %u", parcThreadCachingMemory_Outstanding());
+    }
+
+    parcThreadCachingMemory_Deallocate((void **) &memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Reallocate_NULL)
+{
+    void *result = parcThreadCachingMemory_Reallocate(NULL, 100);
+    assertNotNull(result, "Expected non-NULL result.");
+    assertTrue(parcThreadCachingMemory_Outstanding() == 1,
+               "Expected 1 outstanding allocation, actual %u", parcThreadCachingMemory_Outstanding());
+    parcThreadCachingMemory_Deallocate(&result);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_ReallocateInPlace)
+{
+    void *memory = parcThreadCachingMemory_Allocate(100);
+    assertTrue(parcThreadCachingMemory_ReallocateInPlace(memory, 112), "Expected a 100 byte allocation to hold 112 bytes.");
+    assertTrue(parcThreadCachingMemory_ReallocateInPlace(memory, 10), "Expected a 100 byte allocation to shrink in place.");
+    assertFalse(parcThreadCachingMemory_ReallocateInPlace(memory, 113), "Expected a 100 byte allocation not to hold 113 bytes.");
+    parcThreadCachingMemory_Deallocate(&memory);
+
+    size_t size = parcThreadCachingMemory_MaximumCachedSize + 1;
+    memory = parcThreadCachingMemory_Allocate(size);
+    assertTrue(parcThreadCachingMemory_ReallocateInPlace(memory, size), "Expected an uncached allocation to hold its own size.");
+    assertFalse(parcThreadCachingMemory_ReallocateInPlace(memory, size + 1), "Expected an uncached allocation not to grow.");
+    parcThreadCachingMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_UsableSize)
+{
+    void *memory = parcThreadCachingMemory_Allocate(100);
+    size_t actual = parcThreadCachingMemory_UsableSize(memory);
+    assertTrue(actual == 112, "Expected 112, actual %zd", actual);
+    parcThreadCachingMemory_Deallocate(&memory);
+
+    size_t size = parcThreadCachingMemory_MaximumCachedSize + 1;
+    memory = parcThreadCachingMemory_Allocate(size);
+    actual = parcThreadCachingMemory_UsableSize(memory);
+    assertTrue(actual == size, "Expected %zd, actual %zd", size, actual);
+    parcThreadCachingMemory_Deallocate(&memory);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_GoodSize)
+{
+    for (size_t size = 1; size <= parcThreadCachingMemory_MaximumCachedSize; size++) {
+        size_t goodSize = parcThreadCachingMemory_GoodSize(size);
+        assertTrue(goodSize >= size, "Expected at least %zd, actual %zd", size, goodSize);
+        assertTrue(_sizeClass(goodSize) == _sizeClass(size),
+                   "Expected the good size %zd to be in the same size class as %zd", goodSize, size);
+        assertTrue(_sizeClass(goodSize + 1) != _sizeClass(size) || goodSize == parcThreadCachingMemory_MaximumCachedSize,
+                   "Expected the good size %zd of %zd to be the largest of its size class", goodSize, size);
+    }
+
+    size_t size = parcThreadCachingMemory_MaximumCachedSize + 1;
+    assertTrue(parcThreadCachingMemory_GoodSize(size) == size, "Expected an uncached size to be unchanged.");
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_StringDuplicate)
+{
+    char *expected = "Hello World";
+
+    char *actual = parcThreadCachingMemory_StringDuplicate(expected, 5);
+    assertTrue(strcmp(actual, "Hello") == 0, "Expected %s, actual %s", "Hello", actual);
+    parcThreadCachingMemory_Deallocate((void **) &actual);
+
+    actual = parcThreadCachingMemory_StringDuplicate(expected, 100);
+    assertTrue(strcmp(actual, expected) == 0, "Expected %s, actual %s", expected, actual);
+    parcThreadCachingMemory_Deallocate((void **) &actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Deallocate_OtherThread)
+{
+    void *memory = parcThreadCachingMemory_Allocate(100);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _deallocate, memory);
+    pthread_join(thread, NULL);
+
+    assertTrue(parcThreadCachingMemory_Outstanding() == 0,
+               "Expected 0 outstanding allocations, actual %u", parcThreadCachingMemory_Outstanding());
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_Outstanding_Threads)
+{
+    pthread_t threads[8];
+    for (int i = 0; i < 8; i++) {
+        pthread_create(&threads[i], NULL, _allocateAndDeallocate, NULL);
+    }
+    for (int i = 0; i < 8; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    assertTrue(parcThreadCachingMemory_Outstanding() == 0,
+               "Expected 0 outstanding allocations, actual %u", parcThreadCachingMemory_Outstanding());
+
+    // The exited threads returned their free blocks to the central heap.
+    size_t cached = 0;
+    for (unsigned int i = 0; i < _parcThreadCachingMemory_SizeClasses; i++) {
+        cached += _parcThreadCachingMemory_Heap[i].count;
+    }
+    assertTrue(cached >= 100, "Expected the central heap to hold the freed blocks, actual %zd", cached);
+}
+
+LONGBOW_TEST_CASE(Global, parcThreadCachingMemory_AsPARCMemory)
+{
+    const PARCMemoryInterface *original = parcMemory_SetInterface(&PARCThreadCachingMemoryAsPARCMemory);
+
+    PARCBuffer *buffer = parcBuffer_WrapCString("Hello World");
+    assertTrue(parcMemory_Outstanding() > 0, "Expected outstanding allocations.");
+    parcBuffer_Release(&buffer);
+
+    parcMemory_SetInterface(original);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, AllocateDeallocate_Threads);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcThreadCachingMemory_Flush();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _Iterations 1000000
+#define _Window 64
+
+typedef struct {
+    PARCMemoryAllocate *allocate;
+    PARCMemoryDeallocate *deallocate;
+} _Provider;
+
+static void *
+_churn(void *argument)
+{
+    const _Provider *provider = argument;
+    static const size_t sizes[] = { 16, 48, 64, 100, 200, 512, 1500, 4096 };
+
+    // Keep a window of live allocations, replacing the oldest with each new one.
+    void *live[_Window] = { NULL };
+    for (int i = 0; i < _Iterations; i++) {
+        void **slot = &live[i % _Window];
+        if (*slot != NULL) {
+            provider->deallocate(slot);
+        }
+        *slot = provider->allocate(sizes[i % (sizeof(sizes) / sizeof(sizes[0]))]);
+    }
+    for (int i = 0; i < _Window; i++) {
+        if (live[i] != NULL) {
+            provider->deallocate(&live[i]);
+        }
+    }
+    return NULL;
+}
+
+static double
+_churnRate(const _Provider *provider, int threadCount)
+{
+    pthread_t threads[threadCount];
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    for (int t = 0; t < threadCount; t++) {
+        pthread_create(&threads[t], NULL, _churn, (void *) provider);
+    }
+    for (int t = 0; t < threadCount; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    struct timeval end;
+    gettimeofday(&end, NULL);
+
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    return (double) _Iterations * threadCount / elapsed;
+}
+
+LONGBOW_TEST_CASE(Performance, AllocateDeallocate_Threads)
+{
+    _Provider stdlib = { parcStdlibMemory_Allocate, parcStdlibMemory_Deallocate };
+    _Provider threadCaching = { parcThreadCachingMemory_Allocate, parcThreadCachingMemory_Deallocate };
+
+    for (int threadCount = 1; threadCount <= 16; threadCount *= 2) {
+        printf("Allocate/Deallocate by %2d threads: %.0f/s parcStdlibMemory, %.0f/s parcThreadCachingMemory\n",
+               threadCount, _churnRate(&stdlib, threadCount), _churnRate(&threadCaching, threadCount));
+    }
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ThreadCachingMemory);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
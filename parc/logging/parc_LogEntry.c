@@ -89,7 +89,7 @@ _toString(const PARCLogEntry *entry)
     return result;
 }
 
-parcObject_ExtendPARCObject(PARCLogEntry, _parcLogEntry_Destroy, NULL, _toString, NULL, NULL, NULL, NULL);
+parcObject_ExtendPARCObjectPooled(PARCLogEntry, _parcLogEntry_Destroy, NULL, _toString, NULL, NULL, NULL, NULL);
 
 PARCLogEntry *
 parcLogEntry_Create(PARCLogLevel level,